@@ -43,6 +43,12 @@ for f in $sources; do
     # example/imageviewer is unusual in that needs additional libraries.
     echo "Building gen/bin/example-$f"
     $CC -O3 example/$f/*.c -lxcb -lxcb-image -o gen/bin/example-$f
+  elif [ $f = bgzfcat ] || [ $f = bmpbands ] || [ $f = ndjsoncat ] ||
+    [ $f = pzcat ]; then
+    # example/bgzfcat, example/bmpbands, example/ndjsoncat and example/pzcat
+    # are unusual in that they need to link with pthreads.
+    echo "Building gen/bin/example-$f"
+    $CC -O3 example/$f/*.c -lpthread -o gen/bin/example-$f
   elif [ $f = library ]; then
     # example/library is unusual in that it uses separately compiled libraries
     # (built by "wuffs genlib", e.g. by running build-all.sh) instead of
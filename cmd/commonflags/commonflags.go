@@ -50,6 +50,11 @@ const (
 	RepsMax     = 1000000
 	RepsUsage   = `the number of repetitions per benchmark`
 
+	ThreadsDefault = 4
+	ThreadsMin     = 1
+	ThreadsMax     = 64
+	ThreadsUsage   = `the number of threads per multi-threaded benchmark`
+
 	VersionDefault = "0.0.0"
 	VersionUsage   = `version string, e.g. "1.2.3-beta.4"`
 )
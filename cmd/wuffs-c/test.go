@@ -39,6 +39,7 @@ func doBenchTest(args []string, bench bool) error {
 	iterscaleFlag := flags.Int("iterscale", cf.IterscaleDefault, cf.IterscaleUsage)
 	mimicFlag := flags.Bool("mimic", cf.MimicDefault, cf.MimicUsage)
 	repsFlag := flags.Int("reps", cf.RepsDefault, cf.RepsUsage)
+	threadsFlag := flags.Int("threads", cf.ThreadsDefault, cf.ThreadsUsage)
 
 	if err := flags.Parse(args); err != nil {
 		return err
@@ -58,13 +59,18 @@ func doBenchTest(args []string, bench bool) error {
 		return fmt.Errorf("bad -reps flag value %d, outside the range [%d ..= %d]",
 			*repsFlag, cf.RepsMin, cf.RepsMax)
 	}
+	if *threadsFlag < cf.ThreadsMin || cf.ThreadsMax < *threadsFlag {
+		return fmt.Errorf("bad -threads flag value %d, outside the range [%d ..= %d]",
+			*threadsFlag, cf.ThreadsMin, cf.ThreadsMax)
+	}
 
 	args = flags.Args()
 
 	failed := false
 	for _, arg := range args {
 		f, err := doBenchTest1(arg, bench,
-			*ccompilersFlag, *focusFlag, *iterscaleFlag, *mimicFlag, *repsFlag)
+			*ccompilersFlag, *focusFlag, *iterscaleFlag, *mimicFlag, *repsFlag,
+			*threadsFlag)
 		if err != nil {
 			return err
 		}
@@ -81,7 +87,7 @@ func doBenchTest(args []string, bench bool) error {
 }
 
 func doBenchTest1(filename string, bench bool, ccompilers string, focus string,
-	iterscale int, mimic bool, reps int) (failed bool, err error) {
+	iterscale int, mimic bool, reps int, threads int) (failed bool, err error) {
 
 	workDir, err := ioutil.TempDir("", "wuffs-c")
 	if err != nil {
@@ -96,7 +102,8 @@ func doBenchTest1(filename string, bench bool, ccompilers string, focus string,
 	if bench {
 		ccArgs = append(ccArgs, "-O3")
 	}
-	ccArgs = append(ccArgs, "-Wall", "-std=c99", "-o", out, in)
+	// The -lpthread is for testlib.c's run_in_parallel.
+	ccArgs = append(ccArgs, "-Wall", "-std=c99", "-o", out, in, "-lpthread")
 	if mimic {
 		extra, err := findWuffsMimicCflags(in)
 		if err != nil {
@@ -123,6 +130,7 @@ func doBenchTest1(filename string, bench bool, ccompilers string, focus string,
 			outArgs = append(outArgs, "-bench",
 				fmt.Sprintf("-iterscale=%d", iterscale),
 				fmt.Sprintf("-reps=%d", reps),
+				fmt.Sprintf("-threads=%d", threads),
 			)
 		}
 		if focus != "" {
@@ -39,6 +39,7 @@ func doBenchTest(wuffsRoot string, args []string, bench bool) error {
 	repsFlag := flags.Int("reps", cf.RepsDefault, cf.RepsUsage)
 	skipgenFlag := flags.Bool("skipgen", skipgenDefault, skipgenUsage)
 	skipgendepsFlag := flags.Bool("skipgendeps", skipgendepsDefault, skipgendepsUsage)
+	threadsFlag := flags.Int("threads", cf.ThreadsDefault, cf.ThreadsUsage)
 
 	if err := flags.Parse(args); err != nil {
 		return err
@@ -65,6 +66,10 @@ func doBenchTest(wuffsRoot string, args []string, bench bool) error {
 		return fmt.Errorf("bad -reps flag value %d, outside the range [%d ..= %d]",
 			*repsFlag, cf.RepsMin, cf.RepsMax)
 	}
+	if *threadsFlag < cf.ThreadsMin || cf.ThreadsMax < *threadsFlag {
+		return fmt.Errorf("bad -threads flag value %d, outside the range [%d ..= %d]",
+			*threadsFlag, cf.ThreadsMin, cf.ThreadsMax)
+	}
 
 	args = flags.Args()
 	if len(args) == 0 {
@@ -76,6 +81,7 @@ func doBenchTest(wuffsRoot string, args []string, bench bool) error {
 		cmdArgs = append(cmdArgs, "bench",
 			fmt.Sprintf("-iterscale=%d", *iterscaleFlag),
 			fmt.Sprintf("-reps=%d", *repsFlag),
+			fmt.Sprintf("-threads=%d", *threadsFlag),
 		)
 	} else {
 		cmdArgs = append(cmdArgs, "test")
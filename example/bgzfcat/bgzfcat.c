@@ -0,0 +1,713 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+bgzfcat decodes BGZF (Blocked GNU Zip Format) data to stdout, using multiple
+threads. It reads from the named file, or from stdin if no file is named. To
+run:
+
+$CC -O3 bgzfcat.c -lpthread && ./a.out foo.bgz; rm -f a.out
+
+for a C compiler $CC, such as clang or gcc.
+
+BGZF, as written by htslib's bgzip tool and used by the BAM, VCF and tabix
+file formats, is a multi-member gzip file where each member (a block) holds at
+most 64 KiB of decompressed data. Each block's gzip header has an FEXTRA field
+with a "BC" subfield that gives the block's compressed size. Unlike the general
+case (see example/pzcat), finding every block boundary is cheap, as it does not
+require decoding anything. Each block is also independent of the others: no
+back-reference reaches into a previous block.
+
+bgzfcat first walks the block headers to build an index: each block's
+compressed (file) offset and decompressed offset. It then decodes in rounds of
+up to -threads spans, each span being BLOCKS_PER_SPAN consecutive blocks. Each
+thread decodes its span into its part of the round's output buffer with a
+single std/gzip transform_io call, enabling QUIRK_MULTIPLE_MEMBERS (so that the
+gzip decoder verifies every block's CRC-32 and size) and QUIRK_CONTIGUOUS_DST.
+The round's output is then written to stdout, in order.
+
+BGZF addresses decompressed data by a 64-bit virtual offset: the block's
+compressed offset shifted left by 16, plus the offset within that block's
+decompressed data. Random access, keyed by virtual offset, prints a range of
+the decompressed data without decoding the blocks before it:
+
+./a.out -voffset=123456789 -length=100 foo.bgz
+
+The -index flag prints the index, one block per line: the compressed offset
+and size and then the decompressed offset and size.
+
+The -bench flag decodes everything (without writing it) and prints the
+throughput, both single-threaded and with -threads threads.
+
+Like example/pzcat, bgzfcat does not self-impose a SECCOMP_MODE_STRICT
+sandbox, as that would disallow threads.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GZIP
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+// BLOCKS_PER_SPAN is the number of consecutive blocks that a thread decodes
+// in one go. At up to 64 KiB per block, the default is up to 4 MiB per span.
+#ifndef BLOCKS_PER_SPAN
+#define BLOCKS_PER_SPAN 64
+#endif
+
+// BENCH_REPS is the number of times that -bench decodes everything, for each
+// thread count. The fastest time is reported.
+#ifndef BENCH_REPS
+#define BENCH_REPS 3
+#endif
+
+#define MAX_THREADS 256
+
+#define MAX_BLOCK_DST_LEN 65536
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+// ----
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  bool bench;
+  bool index;
+  uint64_t length;
+  uint32_t threads;
+  uint64_t voffset;
+  bool voffset_set;
+} g_flags = {0};
+
+static const char*  //
+parse_u64(const char* s, uint64_t* x) {
+  char* end = NULL;
+  errno = 0;
+  unsigned long long u = strtoull(s, &end, 10);
+  if ((*s < '0') || ('9' < *s) || (*end != '\x00') || errno) {
+    return "main: bad flag value";
+  }
+  *x = u;
+  return NULL;
+}
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  g_flags.threads = (n < 1) ? 1 : (n > MAX_THREADS) ? MAX_THREADS : n;
+  g_flags.length = UINT64_MAX;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strcmp(arg, "bench")) {
+      g_flags.bench = true;
+      continue;
+    }
+    if (!strcmp(arg, "index")) {
+      g_flags.index = true;
+      continue;
+    }
+    if (!strncmp(arg, "length=", 7)) {
+      const char* z = parse_u64(arg + 7, &g_flags.length);
+      if (z) {
+        return z;
+      }
+      continue;
+    }
+    if (!strncmp(arg, "threads=", 8)) {
+      char* end = NULL;
+      long t = strtol(arg + 8, &end, 10);
+      if ((*end != '\x00') || (t < 1) || (MAX_THREADS < t)) {
+        return "main: bad -threads flag value";
+      }
+      g_flags.threads = t;
+      continue;
+    }
+    if (!strncmp(arg, "voffset=", 8)) {
+      const char* z = parse_u64(arg + 8, &g_flags.voffset);
+      if (z) {
+        return z;
+      }
+      g_flags.voffset_set = true;
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+static const char*  //
+write_to_stdout(const uint8_t* ptr, size_t len) {
+  while (len > 0) {
+    const int stdout_fd = 1;
+    ssize_t n = write(stdout_fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return NULL;
+}
+
+// ---- The index.
+
+// block_index holds n blocks' compressed and decompressed offsets. Both arrays
+// have n+1 elements: the final element holds the total compressed and
+// decompressed lengths, so that block i's sizes are the differences between
+// elements i+1 and i.
+typedef struct {
+  uint64_t* coffsets;
+  uint64_t* uoffsets;
+  size_t n;
+} block_index;
+
+// parse_bgzf_block_len returns the length of the BGZF block at the start of
+// data, or zero if it is invalid. A BGZF block is a gzip member whose header
+// has an FEXTRA field containing a "BC" subfield. That subfield's 2 byte
+// payload is BSIZE, the total block length minus 1.
+static size_t  //
+parse_bgzf_block_len(const uint8_t* data, size_t data_len) {
+  if ((data_len < 18) || (data[0] != 0x1F) || (data[1] != 0x8B) ||
+      (data[2] != 0x08) || ((data[3] & 0xE4) != 0x04)) {
+    return 0;
+  }
+  size_t xlen = data[10] | (data[11] << 8);
+  if ((data_len - 12) < xlen) {
+    return 0;
+  }
+  const uint8_t* p = data + 12;
+  const uint8_t* q = p + xlen;
+  while ((q - p) >= 4) {
+    size_t slen = p[2] | (p[3] << 8);
+    if ((size_t)(q - p - 4) < slen) {
+      return 0;
+    } else if ((p[0] == 'B') && (p[1] == 'C') && (slen == 2)) {
+      size_t n = 1 + (p[4] | (p[5] << 8));
+      // The block has to hold the header, the FEXTRA field and the 8 byte
+      // trailer.
+      return ((n < (12 + xlen + 8)) || (data_len < n)) ? 0 : n;
+    }
+    p += 4 + slen;
+  }
+  return 0;
+}
+
+static const char*  //
+build_index(block_index* idx, const uint8_t* data, size_t data_len) {
+  idx->coffsets = NULL;
+  idx->uoffsets = NULL;
+  idx->n = 0;
+  size_t cap = 0;
+  size_t coffset = 0;
+  uint64_t uoffset = 0;
+  while (true) {
+    if (idx->n == cap) {
+      cap = cap ? (2 * cap) : 1024;
+      uint64_t* c = realloc(idx->coffsets, (cap + 1) * sizeof(uint64_t));
+      if (!c) {
+        return "main: out of memory";
+      }
+      idx->coffsets = c;
+      uint64_t* u = realloc(idx->uoffsets, (cap + 1) * sizeof(uint64_t));
+      if (!u) {
+        return "main: out of memory";
+      }
+      idx->uoffsets = u;
+    }
+    idx->coffsets[idx->n] = coffset;
+    idx->uoffsets[idx->n] = uoffset;
+    if (coffset == data_len) {
+      break;
+    }
+
+    size_t n = parse_bgzf_block_len(data + coffset, data_len - coffset);
+    if (n == 0) {
+      return (coffset == 0) ? "main: not a BGZF file" : "main: bad BGZF block";
+    }
+    coffset += n;
+    // ISIZE, the last 4 bytes of the block, is the decompressed size. The
+    // gzip decoder verifies it, but it also has to fit in 16 bits of a
+    // virtual offset.
+    uint32_t isize =
+        wuffs_base__load_u32le__no_bounds_check((uint8_t*)data + coffset - 4);
+    if (isize > MAX_BLOCK_DST_LEN) {
+      return "main: bad BGZF block";
+    }
+    uoffset += isize;
+    idx->n++;
+  }
+  if (idx->n == 0) {
+    return "main: not a BGZF file";
+  }
+  return NULL;
+}
+
+// find_block returns the index of the block that starts at the given
+// compressed offset, or idx->n if there is no such block.
+static size_t  //
+find_block(const block_index* idx, uint64_t coffset) {
+  size_t lo = 0;
+  size_t hi = idx->n;
+  while (lo < hi) {
+    size_t mid = lo + ((hi - lo) / 2);
+    if (idx->coffsets[mid] < coffset) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return ((lo < idx->n) && (idx->coffsets[lo] == coffset)) ? lo : idx->n;
+}
+
+// ---- Spans and threads.
+
+typedef struct {
+  // Inputs.
+  const uint8_t* src_ptr;
+  size_t src_len;
+  uint8_t* dst_ptr;
+  size_t dst_len;
+
+  // Outputs.
+  const char* status_msg;
+} span;
+
+// decode_thread_func decodes a span's consecutive blocks, which together form
+// a multi-member gzip file, with a single gzip decoder.
+static void*  //
+decode_thread_func(void* arg) {
+  span* s = (span*)arg;
+  wuffs_gzip__decoder* dec = malloc(sizeof__wuffs_gzip__decoder());
+  if (!dec) {
+    s->status_msg = "main: out of memory";
+    return NULL;
+  }
+  wuffs_base__status status = wuffs_gzip__decoder__initialize(
+      dec, sizeof__wuffs_gzip__decoder(), WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    free(dec);
+    s->status_msg = wuffs_base__status__message(&status);
+    return NULL;
+  }
+  wuffs_gzip__decoder__set_quirk_enabled(
+      dec, WUFFS_GZIP__QUIRK_MULTIPLE_MEMBERS, true);
+  // The span's dst buffer holds all of its decoded output, so the decoder
+  // doesn't need to copy any of it into its own history buffer.
+  wuffs_gzip__decoder__set_quirk_enabled(
+      dec, WUFFS_DEFLATE__QUIRK_CONTIGUOUS_DST, true);
+
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(s->dst_ptr, s->dst_len),
+      wuffs_base__empty_io_buffer_meta());
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8((uint8_t*)s->src_ptr, s->src_len),
+      wuffs_base__make_io_buffer_meta(s->src_len, 0, 0, true));
+#if WORK_BUFFER_ARRAY_SIZE > 0
+  uint8_t work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+#else
+  // Not all C/C++ compilers support 0-length arrays.
+  uint8_t work_buffer_array[1];
+#endif
+
+  status = wuffs_gzip__decoder__transform_io(
+      dec, &dst, &src,
+      wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+  if (status.repr == wuffs_base__suspension__short_write) {
+    // The blocks' ISIZE fields said that dst would be big enough.
+    s->status_msg = "main: bad BGZF block";
+  } else if (!wuffs_base__status__is_ok(&status)) {
+    s->status_msg = wuffs_base__status__message(&status);
+  } else if ((dst.meta.wi != s->dst_len) || (src.meta.ri != s->src_len)) {
+    s->status_msg = "main: bad BGZF block";
+  }
+  free(dec);
+  return NULL;
+}
+
+// run_in_parallel runs f over the n spans, one thread per span.
+static const char*  //
+run_in_parallel(void* (*f)(void*), span* spans, size_t n) {
+  if (n == 1) {
+    f(&spans[0]);
+    return NULL;
+  }
+  pthread_t threads[MAX_THREADS];
+  size_t i;
+  for (i = 0; i < n; i++) {
+    if (pthread_create(&threads[i], NULL, f, &spans[i])) {
+      while (i > 0) {
+        pthread_join(threads[--i], NULL);
+      }
+      return "main: pthread_create failed";
+    }
+  }
+  for (i = 0; i < n; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  return NULL;
+}
+
+// decode_range decodes, in parallel, length bytes of decompressed output,
+// starting skip bytes into block b. If write is true, that output is written
+// to stdout. The length is clamped at the end of the decompressed data.
+static const char*  //
+decode_range(const block_index* idx,
+             const uint8_t* data,
+             size_t b,
+             uint64_t skip,
+             uint64_t length,
+             uint32_t threads,
+             bool write) {
+  uint64_t lo = idx->uoffsets[b] + skip;
+  uint64_t hi = idx->uoffsets[idx->n];
+  if ((lo > hi) || ((hi - lo) < length)) {
+    length = (lo > hi) ? 0 : (hi - lo);
+  }
+  hi = lo + length;
+
+  span spans[MAX_THREADS];
+  uint8_t* buf = NULL;
+  size_t buf_cap = 0;
+  const char* ret = NULL;
+  while ((b < idx->n) && (idx->uoffsets[b] < hi)) {
+    // Split the next (up to) threads * BLOCKS_PER_SPAN blocks into spans.
+    // Don't decode past the block that contains hi.
+    size_t b_begin = b;
+    size_t n = 0;
+    for (; (n < threads) && (b < idx->n) && (idx->uoffsets[b] < hi); n++) {
+      size_t b_end = b + BLOCKS_PER_SPAN;
+      if (b_end > idx->n) {
+        b_end = idx->n;
+      }
+      while ((b_end > (b + 1)) && (idx->uoffsets[b_end - 1] >= hi)) {
+        b_end--;
+      }
+      spans[n].src_ptr = data + idx->coffsets[b];
+      spans[n].src_len = idx->coffsets[b_end] - idx->coffsets[b];
+      spans[n].dst_len = idx->uoffsets[b_end] - idx->uoffsets[b];
+      spans[n].status_msg = NULL;
+      b = b_end;
+    }
+
+    size_t buf_len = idx->uoffsets[b] - idx->uoffsets[b_begin];
+    if (buf_cap < buf_len) {
+      free(buf);
+      buf = malloc(buf_len);
+      buf_cap = buf ? buf_len : 0;
+      if (!buf) {
+        ret = "main: out of memory";
+        goto cleanup;
+      }
+    }
+    uint8_t* p = buf;
+    size_t i;
+    for (i = 0; i < n; i++) {
+      spans[i].dst_ptr = p;
+      p += spans[i].dst_len;
+    }
+
+    ret = run_in_parallel(decode_thread_func, spans, n);
+    if (ret) {
+      goto cleanup;
+    }
+    for (i = 0; i < n; i++) {
+      if (spans[i].status_msg) {
+        ret = spans[i].status_msg;
+        goto cleanup;
+      }
+    }
+
+    if (write) {
+      uint64_t u0 = idx->uoffsets[b_begin];
+      uint64_t u1 = idx->uoffsets[b];
+      uint64_t w0 = (lo > u0) ? lo : u0;
+      uint64_t w1 = (hi < u1) ? hi : u1;
+      if (w0 < w1) {
+        ret = write_to_stdout(buf + (w0 - u0), w1 - w0);
+        if (ret) {
+          goto cleanup;
+        }
+      }
+    }
+  }
+
+cleanup:
+  free(buf);
+  return ret;
+}
+
+// read_at_virtual_offset writes length bytes of decompressed output, starting
+// at the given BGZF virtual offset, to stdout. The high 48 bits of voffset are
+// a block's compressed offset and the low 16 bits are an offset into that
+// block's decompressed data.
+static const char*  //
+read_at_virtual_offset(const block_index* idx,
+                       const uint8_t* data,
+                       uint64_t voffset,
+                       uint64_t length,
+                       uint32_t threads) {
+  uint64_t coffset = voffset >> 16;
+  uint64_t skip = voffset & 0xFFFF;
+  size_t b = find_block(idx, coffset);
+  if ((b >= idx->n) || (skip > (idx->uoffsets[b + 1] - idx->uoffsets[b]))) {
+    return "main: bad -voffset flag value";
+  }
+  return decode_range(idx, data, b, skip, length, threads, true);
+}
+
+static const char*  //
+print_index(const block_index* idx) {
+  char buf[128];
+  size_t i;
+  for (i = 0; i < idx->n; i++) {
+    int n = snprintf(buf, sizeof(buf), "%llu %llu %llu %llu\n",
+                     (unsigned long long)(idx->coffsets[i]),
+                     (unsigned long long)(idx->coffsets[i + 1] -
+                                          idx->coffsets[i]),
+                     (unsigned long long)(idx->uoffsets[i]),
+                     (unsigned long long)(idx->uoffsets[i + 1] -
+                                          idx->uoffsets[i]));
+    const char* z = write_to_stdout((const uint8_t*)buf, n);
+    if (z) {
+      return z;
+    }
+  }
+  return NULL;
+}
+
+static double  //
+now_in_seconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+// bench prints the throughput (in decompressed MB/s) of decoding everything,
+// first on a single thread and then on the -threads number of threads.
+static const char*  //
+bench(const block_index* idx, const uint8_t* data) {
+  uint32_t thread_counts[2] = {1, g_flags.threads};
+  double mbs[2] = {0};
+  int t;
+  for (t = 0; t < 2; t++) {
+    double best = 0;
+    int r;
+    for (r = 0; r < BENCH_REPS; r++) {
+      double start = now_in_seconds();
+      const char* z = decode_range(idx, data, 0, 0, UINT64_MAX,
+                                   thread_counts[t], false);
+      if (z) {
+        return z;
+      }
+      double elapsed = now_in_seconds() - start;
+      if ((r == 0) || (best > elapsed)) {
+        best = elapsed;
+      }
+    }
+    mbs[t] = (best > 0) ? (idx->uoffsets[idx->n] / best / 1e6) : 0;
+
+    char buf[128];
+    int n = snprintf(buf, sizeof(buf), "threads=%-4u %10.2f MB/s\n",
+                     thread_counts[t], mbs[t]);
+    const char* z = write_to_stdout((const uint8_t*)buf, n);
+    if (z) {
+      return z;
+    }
+  }
+  if (mbs[0] > 0) {
+    char buf[128];
+    int n = snprintf(buf, sizeof(buf), "speedup     %10.2fx\n",
+                     mbs[1] / mbs[0]);
+    return write_to_stdout((const uint8_t*)buf, n);
+  }
+  return NULL;
+}
+
+// ----
+
+static const char*  //
+read_all(int fd, uint8_t** ptr, size_t* len) {
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      *ptr = p;
+      *len = st.st_size;
+      return NULL;
+    }
+  }
+
+  size_t cap = 0;
+  *ptr = NULL;
+  *len = 0;
+  while (true) {
+    if (*len == cap) {
+      cap = cap ? (2 * cap) : (1024 * 1024);
+      uint8_t* p = realloc(*ptr, cap);
+      if (!p) {
+        return "main: out of memory";
+      }
+      *ptr = p;
+    }
+    ssize_t n = read(fd, *ptr + *len, cap - *len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      return NULL;
+    }
+    *len += n;
+  }
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  }
+
+  int fd = 0;
+  if (g_flags.remaining_argc > 0) {
+    fd = open(g_flags.remaining_argv[0], O_RDONLY);
+    if (fd < 0) {
+      return strerror(errno);
+    }
+  }
+  // The input and index are deliberately not freed or unmapped. The process
+  // is about to exit.
+  uint8_t* data = NULL;
+  size_t data_len = 0;
+  z = read_all(fd, &data, &data_len);
+  if (z) {
+    return z;
+  }
+  block_index idx;
+  z = build_index(&idx, data, data_len);
+  if (z) {
+    return z;
+  }
+
+  if (g_flags.index) {
+    return print_index(&idx);
+  } else if (g_flags.bench) {
+    return bench(&idx, data);
+  } else if (g_flags.voffset_set) {
+    return read_at_virtual_offset(&idx, data, g_flags.voffset,
+                                  g_flags.length, g_flags.threads);
+  }
+  return decode_range(&idx, data, 0, 0, g_flags.length, g_flags.threads,
+                      true);
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
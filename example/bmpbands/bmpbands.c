@@ -0,0 +1,414 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+bmpbands decodes a BMP image, using multiple threads, and writes it to stdout
+as a PAM (Portable Arbitrary Map) image, RGBA with non-premultiplied alpha. It
+reads from the named file, or from stdin if no file is named. To run:
+
+$CC -O3 bmpbands.c -lpthread
+./a.out ../../test/data/hippopotamus.bmp > hippo.pam; rm -f a.out
+
+for a C compiler $CC, such as clang or gcc.
+
+The destination pixel buffer is split into up to -threads row bands. Each
+thread decodes the whole source with its own decoder, but passes its band as
+the decode_frame_options' dst_clip_rect, so that the decoder only writes (and
+converts) the pixels in that band. Uncompressed BMP rows are at fixed offsets
+in the file, so each decoder skips straight to its band's first row without
+reading the rows before it. The bands are disjoint, so the threads never write
+to the same pixels.
+
+The same technique works for any Wuffs image decoder that honors the clip
+rectangle, but it only saves work when the decoder can cheaply skip the source
+data for rows outside of the clip. For example, the GIF decoder would still
+have to decompress all of the LZW data before a band's rows.
+
+Unlike example/imageviewer, bmpbands needs the entire source in memory (it is
+memory-mapped, if possible), as each thread reads the source independently.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__BMP
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+// MAX_PIXBUF_LEN is the maximum size, in bytes, of the destination pixel
+// buffer.
+#ifndef MAX_PIXBUF_LEN
+#define MAX_PIXBUF_LEN (1024 * 1024 * 1024)
+#endif
+
+#define MAX_THREADS 256
+
+// ----
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  uint32_t threads;
+} g_flags = {0};
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  g_flags.threads = (n < 1) ? 1 : (n > MAX_THREADS) ? MAX_THREADS : n;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "threads=", 8)) {
+      char* end = NULL;
+      long t = strtol(arg + 8, &end, 10);
+      if ((*end != '\x00') || (t < 1) || (MAX_THREADS < t)) {
+        return "main: bad -threads flag value";
+      }
+      g_flags.threads = t;
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+static const char*  //
+write_to_stdout(const uint8_t* ptr, size_t len) {
+  while (len > 0) {
+    const int stdout_fd = 1;
+    ssize_t n = write(stdout_fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return NULL;
+}
+
+// ----
+
+typedef struct {
+  // Inputs.
+  const uint8_t* data;
+  size_t data_len;
+  wuffs_base__pixel_buffer* pixbuf;
+  wuffs_base__rect_ie_u32 band;
+
+  // Outputs.
+  const char* status_msg;
+} band;
+
+// decode_band_thread_func decodes one band of the image, from the start of the
+// source, with its own decoder.
+static void*  //
+decode_band_thread_func(void* arg) {
+  band* b = (band*)arg;
+  wuffs_base__io_buffer src = wuffs_base__slice_u8__reader(
+      wuffs_base__make_slice_u8((uint8_t*)b->data, b->data_len), true);
+
+  wuffs_bmp__decoder* dec = malloc(sizeof__wuffs_bmp__decoder());
+  if (!dec) {
+    b->status_msg = "main: out of memory";
+    return NULL;
+  }
+  wuffs_base__status status = wuffs_bmp__decoder__initialize(
+      dec, sizeof__wuffs_bmp__decoder(), WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (wuffs_base__status__is_ok(&status)) {
+    status = wuffs_bmp__decoder__decode_image_config(dec, NULL, &src);
+  }
+  if (wuffs_base__status__is_ok(&status)) {
+    wuffs_base__decode_frame_options opts =
+        wuffs_base__null_decode_frame_options();
+    wuffs_base__decode_frame_options__set_dst_clip_rect(&opts, b->band);
+    status = wuffs_bmp__decoder__decode_frame(
+        dec, b->pixbuf, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+        wuffs_base__empty_slice_u8(), &opts);
+  }
+  b->status_msg = wuffs_base__status__message(&status);
+  free(dec);
+  return NULL;
+}
+
+// decode_in_parallel decodes the image into pb, splitting it into num_bands
+// row bands and decoding each band on its own thread.
+static const char*  //
+decode_in_parallel(const uint8_t* data,
+                   size_t data_len,
+                   wuffs_base__pixel_buffer* pb,
+                   uint32_t num_bands) {
+  band bands[MAX_THREADS];
+  pthread_t threads[MAX_THREADS];
+  wuffs_base__rect_ie_u32 bounds =
+      wuffs_base__pixel_config__bounds(&pb->pixcfg);
+  uint64_t height = bounds.max_excl_y;
+  uint32_t i;
+  for (i = 0; i < num_bands; i++) {
+    bands[i].data = data;
+    bands[i].data_len = data_len;
+    bands[i].pixbuf = pb;
+    bands[i].band = wuffs_base__make_rect_ie_u32(
+        0, (uint32_t)((height * i) / num_bands), bounds.max_excl_x,
+        (uint32_t)((height * (i + 1)) / num_bands));
+    bands[i].status_msg = NULL;
+  }
+
+  if (num_bands == 1) {
+    decode_band_thread_func(&bands[0]);
+    return bands[0].status_msg;
+  }
+  for (i = 0; i < num_bands; i++) {
+    if (pthread_create(&threads[i], NULL, decode_band_thread_func, &bands[i])) {
+      while (i > 0) {
+        pthread_join(threads[--i], NULL);
+      }
+      return "main: pthread_create failed";
+    }
+  }
+  for (i = 0; i < num_bands; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  for (i = 0; i < num_bands; i++) {
+    if (bands[i].status_msg) {
+      return bands[i].status_msg;
+    }
+  }
+  return NULL;
+}
+
+// write_pam writes the RGBA_NONPREMUL pixel buffer pb to stdout.
+static const char*  //
+write_pam(wuffs_base__pixel_buffer* pb) {
+  uint32_t width = wuffs_base__pixel_config__width(&pb->pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&pb->pixcfg);
+  char header[256];
+  int n = snprintf(header, sizeof(header),
+                   "P7\nWIDTH %" PRIu32 "\nHEIGHT %" PRIu32
+                   "\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n",
+                   width, height);
+  if ((n < 0) || (n >= (int)sizeof(header))) {
+    return "main: internal error: PAM header is too long";
+  }
+  const char* z = write_to_stdout((const uint8_t*)header, n);
+  if (z) {
+    return z;
+  }
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(pb, 0);
+  return write_to_stdout(tab.ptr, tab.stride * tab.height);
+}
+
+static const char*  //
+read_all(int fd, uint8_t** ptr, size_t* len) {
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      *ptr = p;
+      *len = st.st_size;
+      return NULL;
+    }
+  }
+
+  size_t cap = 0;
+  *ptr = NULL;
+  *len = 0;
+  while (true) {
+    if (*len == cap) {
+      cap = cap ? (2 * cap) : (1024 * 1024);
+      uint8_t* p = realloc(*ptr, cap);
+      if (!p) {
+        return "main: out of memory";
+      }
+      *ptr = p;
+    }
+    ssize_t n = read(fd, *ptr + *len, cap - *len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      return NULL;
+    }
+    *len += n;
+  }
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  }
+
+  int fd = 0;
+  if (g_flags.remaining_argc > 0) {
+    fd = open(g_flags.remaining_argv[0], O_RDONLY);
+    if (fd < 0) {
+      return strerror(errno);
+    }
+  }
+  // The input and the pixel buffer are deliberately not freed or unmapped.
+  // The process is about to exit.
+  uint8_t* data = NULL;
+  size_t data_len = 0;
+  z = read_all(fd, &data, &data_len);
+  if (z) {
+    return z;
+  }
+
+  // Decode the image config on this thread, to size the pixel buffer.
+  wuffs_bmp__decoder* dec = malloc(sizeof__wuffs_bmp__decoder());
+  if (!dec) {
+    return "main: out of memory";
+  }
+  wuffs_base__status status = wuffs_bmp__decoder__initialize(
+      dec, sizeof__wuffs_bmp__decoder(), WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  wuffs_base__image_config ic = {0};
+  if (wuffs_base__status__is_ok(&status)) {
+    wuffs_base__io_buffer src = wuffs_base__slice_u8__reader(
+        wuffs_base__make_slice_u8(data, data_len), true);
+    status = wuffs_bmp__decoder__decode_image_config(dec, &ic, &src);
+  }
+  free(dec);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  if (((uint64_t)width * (uint64_t)height) > (MAX_PIXBUF_LEN / 4)) {
+    return "main: image is too large";
+  }
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width, height);
+  uint64_t pixbuf_len = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+  uint8_t* pixbuf_ptr = malloc(pixbuf_len ? pixbuf_len : 1);
+  if (!pixbuf_ptr) {
+    return "main: out of memory";
+  }
+  wuffs_base__pixel_buffer pb;
+  status = wuffs_base__pixel_buffer__set_from_slice(
+      &pb, &ic.pixcfg, wuffs_base__make_slice_u8(pixbuf_ptr, pixbuf_len));
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+
+  // There's no point having more bands than rows.
+  uint32_t num_bands = g_flags.threads;
+  if (num_bands > height) {
+    num_bands = height ? height : 1;
+  }
+  z = decode_in_parallel(data, data_len, &pb, num_bands);
+  if (z) {
+    return z;
+  }
+  return write_pam(&pb);
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
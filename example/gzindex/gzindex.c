@@ -0,0 +1,647 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+gzindex provides random access to gzip'ed (or zlib'ed) data, in the style of
+zlib's examples/zran.c. It has two modes. The first builds an index, a sidecar
+file of checkpoints into the compressed data:
+
+$CC -O3 gzindex.c -o gzindex
+./gzindex build foo.gz foo.gz.idx
+
+The second uses that index to print a range of the decompressed data, without
+decoding everything before it:
+
+./gzindex -offset=1000000 -length=100 extract foo.gz foo.gz.idx
+
+for a C compiler $CC, such as clang or gcc.
+
+A checkpoint is taken at the first deflate block that starts at least -span
+MiB (of decompressed output) after the previous checkpoint. Each checkpoint
+records:
+
+  - the decompressed (dst) position that the block starts at,
+  - the compressed (src) position of the block's first whole byte,
+  - the bits and n_bits of the block's first, partial byte (if any),
+  - the (up to 32 KiB of) decompressed output before the block.
+
+Extracting from a checkpoint calls the deflate decoder's add_history method
+with the saved output and its prime method with the saved bits.
+
+The index file is a sequence of little-endian integers and bytes: an 8 byte
+magic identifier, "gzindex1", then a u64 checkpoint count and then that many
+checkpoints. Each checkpoint is a u64 dst position, a u64 src position, a u32
+bits, a u32 n_bits, a u32 window length and then that many window bytes.
+
+Only the first gzip member (or zlib stream) is indexed. Extracting does not
+verify the checksum in the gzip or zlib trailer, as it would have to decode
+everything anyway.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__DEFLATE
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+#ifndef DST_BUFFER_ARRAY_SIZE
+#define DST_BUFFER_ARRAY_SIZE (128 * 1024)
+#endif
+
+#ifndef SRC_BUFFER_ARRAY_SIZE
+#define SRC_BUFFER_ARRAY_SIZE (128 * 1024)
+#endif
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+#define WINDOW_SIZE 32768
+
+#define MAGIC "gzindex1"
+#define MAGIC_LEN 8
+
+uint8_t g_dst_buffer_array[DST_BUFFER_ARRAY_SIZE];
+uint8_t g_src_buffer_array[SRC_BUFFER_ARRAY_SIZE];
+#if WORK_BUFFER_ARRAY_SIZE > 0
+uint8_t g_work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+#else
+// Not all C/C++ compilers support 0-length arrays.
+uint8_t g_work_buffer_array[1];
+#endif
+
+// ----
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  uint64_t length;
+  uint64_t offset;
+  uint64_t span;
+} g_flags = {0};
+
+static const char*  //
+parse_u64(const char* s, uint64_t* x) {
+  char* end = NULL;
+  errno = 0;
+  unsigned long long u = strtoull(s, &end, 10);
+  if ((*s < '0') || ('9' < *s) || (*end != '\x00') || errno) {
+    return "main: bad flag value";
+  }
+  *x = u;
+  return NULL;
+}
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  g_flags.length = UINT64_MAX;
+  g_flags.span = 1;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "length=", 7)) {
+      const char* z = parse_u64(arg + 7, &g_flags.length);
+      if (z) {
+        return z;
+      }
+      continue;
+    }
+    if (!strncmp(arg, "offset=", 7)) {
+      const char* z = parse_u64(arg + 7, &g_flags.offset);
+      if (z) {
+        return z;
+      }
+      continue;
+    }
+    if (!strncmp(arg, "span=", 5)) {
+      const char* z = parse_u64(arg + 5, &g_flags.span);
+      if (z) {
+        return z;
+      } else if ((g_flags.span < 1) || (g_flags.span > 0xFFFF)) {
+        return "main: bad -span flag value";
+      }
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+static const char*  //
+write_all(int fd, const uint8_t* ptr, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return NULL;
+}
+
+static const char*  //
+read_all(int fd, uint8_t** ptr, size_t* len) {
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      *ptr = p;
+      *len = st.st_size;
+      return NULL;
+    }
+  }
+
+  size_t cap = 0;
+  *ptr = NULL;
+  *len = 0;
+  while (true) {
+    if (*len == cap) {
+      cap = cap ? (2 * cap) : (1024 * 1024);
+      uint8_t* p = realloc(*ptr, cap);
+      if (!p) {
+        return "main: out of memory";
+      }
+      *ptr = p;
+    }
+    ssize_t n = read(fd, *ptr + *len, cap - *len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      return NULL;
+    }
+    *len += n;
+  }
+}
+
+// parse_header returns the length of the gzip or zlib header at the start of
+// data, or zero if it is invalid.
+static size_t  //
+parse_header(const uint8_t* data, size_t data_len) {
+  if (data_len < 2) {
+    return 0;
+  } else if (((data[0] & 0x0F) == 0x08) && ((data[0] >> 4) <= 7) &&
+             !(data[1] & 0x20) &&  // FDICT is not supported.
+             ((((data[0] << 8) | data[1]) % 31) == 0)) {
+    return 2;
+  }
+
+  if ((data_len < 10) || (data[0] != 0x1F) || (data[1] != 0x8B) ||
+      (data[2] != 0x08) || (data[3] & 0xE0)) {
+    return 0;
+  }
+  uint8_t flags = data[3];
+  size_t i = 10;
+  if (flags & 0x04) {  // FEXTRA.
+    if ((data_len - i) < 2) {
+      return 0;
+    }
+    size_t n = data[i] | (data[i + 1] << 8);
+    i += 2;
+    if ((data_len - i) < n) {
+      return 0;
+    }
+    i += n;
+  }
+  int j;
+  for (j = 0; j < 2; j++) {
+    if (flags & (0x08 << j)) {  // FNAME or FCOMMENT.
+      while ((i < data_len) && data[i]) {
+        i++;
+      }
+      if (i >= data_len) {
+        return 0;
+      }
+      i++;
+    }
+  }
+  if (flags & 0x02) {  // FHCRC.
+    if ((data_len - i) < 2) {
+      return 0;
+    }
+    i += 2;
+  }
+  return i;
+}
+
+// ---- Building an index.
+
+// retained holds the decompressed output from position pos onwards. pos
+// trails the most recent block start by (up to) WINDOW_SIZE bytes, so that
+// when the decoder reports a new block start, its window is still available.
+typedef struct {
+  uint8_t* ptr;
+  size_t len;
+  size_t cap;
+  uint64_t pos;
+} retained;
+
+static const char*  //
+append_u64(int fd, uint64_t x) {
+  uint8_t b[8];
+  wuffs_base__store_u64le__no_bounds_check(b, x);
+  return write_all(fd, b, 8);
+}
+
+static const char*  //
+append_checkpoint(int fd,
+                  const uint8_t* data,
+                  uint64_t src_bit_pos,
+                  uint64_t dst_pos,
+                  const retained* r) {
+  uint32_t n_bits = (8 - (src_bit_pos & 7)) & 7;
+  uint32_t bits = n_bits ? (data[src_bit_pos / 8] >> (src_bit_pos & 7)) : 0;
+  uint64_t window_len = dst_pos - r->pos;
+  if (window_len > WINDOW_SIZE) {
+    window_len = WINDOW_SIZE;
+  }
+
+  uint8_t header[28];
+  wuffs_base__store_u64le__no_bounds_check(header + 0, dst_pos);
+  wuffs_base__store_u64le__no_bounds_check(header + 8, (src_bit_pos + 7) / 8);
+  wuffs_base__store_u32le__no_bounds_check(header + 16, bits);
+  wuffs_base__store_u32le__no_bounds_check(header + 20, n_bits);
+  wuffs_base__store_u32le__no_bounds_check(header + 24, (uint32_t)window_len);
+  const char* z = write_all(fd, header, 28);
+  if (z) {
+    return z;
+  }
+  return write_all(fd, r->ptr + (dst_pos - r->pos) - window_len, window_len);
+}
+
+static const char*  //
+build(const uint8_t* data, size_t data_len, int index_fd) {
+  size_t header_len = parse_header(data, data_len);
+  if (header_len == 0) {
+    return "main: bad gzip or zlib header";
+  }
+
+  wuffs_deflate__decoder dec;
+  wuffs_base__status status =
+      wuffs_deflate__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+
+  // The checkpoint count is patched in after decoding.
+  const char* z = write_all(index_fd, (const uint8_t*)(MAGIC), MAGIC_LEN);
+  if (z || (z = append_u64(index_fd, 0))) {
+    return z;
+  }
+
+  wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(
+      (uint8_t*)(data), data_len, true);
+  src.meta.ri = header_len;
+
+  // The first checkpoint is at the start of the deflate stream. The decoder
+  // only reports the most recent block start after each transform_io call, so
+  // limiting each call's dst to DST_BUFFER_ARRAY_SIZE bytes limits how many
+  // block starts can go unreported.
+  retained r = {0};
+  z = append_checkpoint(index_fd, data, 8 * (uint64_t)(header_len), 0, &r);
+  if (z) {
+    return z;
+  }
+  uint64_t count = 1;
+  uint64_t span = g_flags.span * 1024 * 1024;
+  uint64_t prev_block_src_bit_pos = 8 * (uint64_t)(header_len);
+  uint64_t next_checkpoint_dst_pos = span;
+  while (true) {
+    if ((r.cap - r.len) < DST_BUFFER_ARRAY_SIZE) {
+      size_t cap = r.cap ? (2 * r.cap) : (4 * DST_BUFFER_ARRAY_SIZE);
+      uint8_t* p = realloc(r.ptr, cap);
+      if (!p) {
+        z = "main: out of memory";
+        break;
+      }
+      r.ptr = p;
+      r.cap = cap;
+    }
+
+    wuffs_base__io_buffer dst =
+        wuffs_base__ptr_u8__writer(r.ptr, r.len + DST_BUFFER_ARRAY_SIZE);
+    dst.meta.wi = r.len;
+    dst.meta.ri = r.len;
+    dst.meta.pos = r.pos;
+    status = wuffs_deflate__decoder__transform_io(
+        &dec, &dst, &src,
+        wuffs_base__make_slice_u8(g_work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+    r.len = dst.meta.wi;
+
+    uint64_t b = wuffs_deflate__decoder__block_start_src_bit_position(&dec);
+    uint64_t d = wuffs_deflate__decoder__block_start_dst_position(&dec);
+    if (b != prev_block_src_bit_pos) {
+      prev_block_src_bit_pos = b;
+      if (d >= next_checkpoint_dst_pos) {
+        if ((z = append_checkpoint(index_fd, data, b, d, &r))) {
+          break;
+        }
+        count++;
+        next_checkpoint_dst_pos = d + span;
+      }
+
+      // Discard any output that no later block's window can refer to.
+      uint64_t keep = (d > WINDOW_SIZE) ? (d - WINDOW_SIZE) : 0;
+      if ((keep - r.pos) >= (r.cap / 2)) {
+        size_t n = keep - r.pos;
+        memmove(r.ptr, r.ptr + n, r.len - n);
+        r.len -= n;
+        r.pos = keep;
+      }
+    }
+
+    if (status.repr == wuffs_base__suspension__short_write) {
+      continue;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      z = "main: truncated input";
+    } else {
+      z = wuffs_base__status__message(&status);
+    }
+    break;
+  }
+  free(r.ptr);
+
+  if (!z) {
+    if (lseek(index_fd, MAGIC_LEN, SEEK_SET) < 0) {
+      return strerror(errno);
+    }
+    z = append_u64(index_fd, count);
+  }
+  return z;
+}
+
+// ---- Extracting from an index.
+
+static const char*  //
+extract(int src_fd, uint8_t* index, size_t index_len) {
+  if ((index_len < (MAGIC_LEN + 8)) || memcmp(index, MAGIC, MAGIC_LEN)) {
+    return "main: bad index";
+  }
+  uint64_t count = wuffs_base__load_u64le__no_bounds_check(index + MAGIC_LEN);
+  index += MAGIC_LEN + 8;
+  index_len -= MAGIC_LEN + 8;
+
+  // Find the last checkpoint at or before the requested offset.
+  uint8_t* c = NULL;
+  for (; count > 0; count--) {
+    if (index_len < 28) {
+      return "main: bad index";
+    }
+    uint64_t window_len = wuffs_base__load_u32le__no_bounds_check(index + 24);
+    if ((window_len > WINDOW_SIZE) || ((index_len - 28) < window_len)) {
+      return "main: bad index";
+    } else if (wuffs_base__load_u64le__no_bounds_check(index) >
+               g_flags.offset) {
+      break;
+    }
+    c = index;
+    index += 28 + window_len;
+    index_len -= 28 + window_len;
+  }
+  if (!c) {
+    return "main: bad index";
+  }
+  uint64_t dst_pos = wuffs_base__load_u64le__no_bounds_check(c + 0);
+  uint64_t src_pos = wuffs_base__load_u64le__no_bounds_check(c + 8);
+  uint32_t bits = wuffs_base__load_u32le__no_bounds_check(c + 16);
+  uint32_t n_bits = wuffs_base__load_u32le__no_bounds_check(c + 20);
+  uint32_t window_len = wuffs_base__load_u32le__no_bounds_check(c + 24);
+  if (n_bits > 7) {
+    return "main: bad index";
+  }
+
+  wuffs_deflate__decoder dec;
+  wuffs_base__status status =
+      wuffs_deflate__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  wuffs_deflate__decoder__add_history(
+      &dec, wuffs_base__make_slice_u8(c + 28, window_len));
+  wuffs_deflate__decoder__prime(&dec, bits, n_bits);
+
+  if (lseek(src_fd, src_pos, SEEK_SET) < 0) {
+    return strerror(errno);
+  }
+
+  wuffs_base__io_buffer dst =
+      wuffs_base__ptr_u8__writer(g_dst_buffer_array, DST_BUFFER_ARRAY_SIZE);
+  dst.meta.pos = dst_pos;
+  wuffs_base__io_buffer src =
+      wuffs_base__ptr_u8__writer(g_src_buffer_array, SRC_BUFFER_ARRAY_SIZE);
+  src.meta.pos = src_pos;
+
+  uint64_t remaining = g_flags.length;
+  while (remaining > 0) {
+    ssize_t n =
+        read(src_fd, src.data.ptr + src.meta.wi, src.data.len - src.meta.wi);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    src.meta.wi += n;
+    if (n == 0) {
+      src.meta.closed = true;
+    }
+
+    while (remaining > 0) {
+      status = wuffs_deflate__decoder__transform_io(
+          &dec, &dst, &src,
+          wuffs_base__make_slice_u8(g_work_buffer_array,
+                                    WORK_BUFFER_ARRAY_SIZE));
+
+      // Write the part of dst that is at or after the requested offset.
+      uint64_t p = dst.meta.pos;
+      if (p < g_flags.offset) {
+        uint64_t skip = g_flags.offset - p;
+        dst.meta.ri = (skip < dst.meta.wi) ? skip : dst.meta.wi;
+      }
+      uint64_t w = dst.meta.wi - dst.meta.ri;
+      if (w > remaining) {
+        w = remaining;
+      }
+      if (w > 0) {
+        const int stdout_fd = 1;
+        const char* z = write_all(stdout_fd, dst.data.ptr + dst.meta.ri, w);
+        if (z) {
+          return z;
+        }
+        remaining -= w;
+      }
+      dst.meta.ri = dst.meta.wi;
+      wuffs_base__io_buffer__compact(&dst);
+
+      if (status.repr == wuffs_base__suspension__short_read) {
+        break;
+      } else if (status.repr == wuffs_base__suspension__short_write) {
+        continue;
+      } else if (wuffs_base__status__is_ok(&status)) {
+        return NULL;
+      }
+      return wuffs_base__status__message(&status);
+    }
+
+    wuffs_base__io_buffer__compact(&src);
+    if (src.meta.wi == src.data.len) {
+      return "main: internal error: no I/O progress possible";
+    }
+  }
+  return NULL;
+}
+
+// ----
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  } else if (g_flags.remaining_argc != 3) {
+    return "main: usage: gzindex [flags] build|extract foo.gz foo.gz.idx";
+  }
+  const char* mode = g_flags.remaining_argv[0];
+  const char* src_filename = g_flags.remaining_argv[1];
+  const char* index_filename = g_flags.remaining_argv[2];
+
+  // Files are deliberately not closed, freed or unmapped. The process is
+  // about to exit.
+  int src_fd = open(src_filename, O_RDONLY);
+  if (src_fd < 0) {
+    return strerror(errno);
+  }
+
+  if (!strcmp(mode, "build")) {
+    uint8_t* data = NULL;
+    size_t data_len = 0;
+    z = read_all(src_fd, &data, &data_len);
+    if (z) {
+      return z;
+    }
+    int index_fd = open(index_filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (index_fd < 0) {
+      return strerror(errno);
+    }
+    return build(data, data_len, index_fd);
+
+  } else if (!strcmp(mode, "extract")) {
+    int index_fd = open(index_filename, O_RDONLY);
+    if (index_fd < 0) {
+      return strerror(errno);
+    }
+    uint8_t* index = NULL;
+    size_t index_len = 0;
+    z = read_all(index_fd, &index, &index_len);
+    if (z) {
+      return z;
+    }
+    return extract(src_fd, index, index_len);
+  }
+
+  return "main: unrecognized mode; want \"build\" or \"extract\"";
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
@@ -0,0 +1,983 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+jsonindex answers JSON Pointer (RFC 6901) queries against a JSON file without
+re-tokenizing the whole file for every query, unlike example/jsonptr. It has
+two modes. The first builds an index, a sidecar file that records every JSON
+container (every object and array):
+
+$CC -O3 jsonindex.c -o jsonindex
+./jsonindex build foo.json foo.json.idx
+
+The second uses that index to print the value that a JSON Pointer refers to:
+
+./jsonindex -query=/a/b/0 query foo.json foo.json.idx
+
+for a C compiler $CC, such as clang or gcc.
+
+script/run-jsonindex-tests.sh checks some queries' results.
+
+The value is printed verbatim (its source bytes, not re-formatted), followed
+by a '\n'. As per RFC 6901, "~0" and "~1" in the query mean "~" and "/".
+
+Each index node describes one container:
+
+  - the source position of its first byte, the '[' or '{',
+  - the source position just after its last byte, the ']' or '}',
+  - if its parent is an object, the source position of its key (of the '"'
+    that starts that string), otherwise UINT64_MAX,
+  - its key's hash (if its parent is an object) or its element index (if its
+    parent is an array),
+  - the node index of its first child container and
+  - its number of child containers.
+
+Each container's child containers are contiguous in the index, sorted by key
+hash (with ties in document order) or by element index, so that each query
+step is a binary search. The index file is mmap'ed, not parsed up front, so a
+query costs O(depth * log(fanout)) index lookups. Only when the query's final
+step names a string, number or literal (which are not indexed, keeping the
+index much smaller than the JSON) is the innermost container re-tokenized.
+
+Key hashes are of the unescaped key, so that "\u0041" and "A" are the same
+key. A hash match is confirmed by re-tokenizing just the key, as every JSON
+string is also a valid JSON document. If an object has duplicate keys (which
+RFC 8259 discourages), the first object or array value wins, or if there are
+none, the first other value.
+
+The index file is a sequence of little-endian integers: an 8 byte magic
+identifier, "jsonidx1", then a u64 JSON file length, a u64 node count, a u64
+root node index (or UINT64_MAX if the top-level value is not a container) and
+then that many nodes. Each node is six u64 values, in the order listed above.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__JSON
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+#ifndef OUT_BUFFER_ARRAY_SIZE
+#define OUT_BUFFER_ARRAY_SIZE (64 * 1024)
+#endif
+
+#ifndef TOKEN_BUFFER_ARRAY_SIZE
+#define TOKEN_BUFFER_ARRAY_SIZE (4 * 1024)
+#endif
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_JSON__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+#define MAGIC "jsonidx1"
+#define MAGIC_LEN 8
+#define HEADER_LEN (MAGIC_LEN + 24)
+#define NODE_LEN 48
+
+uint8_t g_out_buffer_array[OUT_BUFFER_ARRAY_SIZE];
+wuffs_base__token g_tok_buffer_array[TOKEN_BUFFER_ARRAY_SIZE];
+uint64_t g_pos_buffer_array[TOKEN_BUFFER_ARRAY_SIZE];
+#if WORK_BUFFER_ARRAY_SIZE > 0
+uint8_t g_work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+#else
+// Not all C/C++ compilers support 0-length arrays.
+uint8_t g_work_buffer_array[1];
+#endif
+
+// g_stop is a sentinel status message, returned by a handle_token function to
+// stop tokenizing early. It is not an error.
+const char g_stop[] = "main: internal error: unexpected g_stop";
+
+// ----
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  char* query;
+} g_flags = {0};
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "query=", 6)) {
+      g_flags.query = arg + 6;
+      if ((*g_flags.query != '\x00') && (*g_flags.query != '/')) {
+        return "main: bad -query flag value: it must be empty or start with /";
+      }
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+static const char*  //
+write_all(int fd, const uint8_t* ptr, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return NULL;
+}
+
+static const char*  //
+read_all(int fd, uint8_t** ptr, size_t* len) {
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      *ptr = p;
+      *len = st.st_size;
+      return NULL;
+    }
+  }
+
+  size_t cap = 0;
+  *ptr = NULL;
+  *len = 0;
+  while (true) {
+    if (*len == cap) {
+      cap = cap ? (2 * cap) : (1024 * 1024);
+      uint8_t* p = realloc(*ptr, cap);
+      if (!p) {
+        return "main: out of memory";
+      }
+      *ptr = p;
+    }
+    ssize_t n = read(fd, *ptr + *len, cap - *len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      return NULL;
+    }
+    *len += n;
+  }
+}
+
+// ---- Tokenizing.
+
+// tokenize runs the JSON decoder over data[start .. end], which should hold
+// one JSON value (and possibly trailing bytes, which are ignored), calling
+// handle_token for each token with that token's absolute source position.
+static const char*  //
+tokenize(const uint8_t* data,
+         uint64_t start,
+         uint64_t end,
+         const char* (*handle_token)(void* context,
+                                     const uint8_t* data,
+                                     wuffs_base__token t,
+                                     uint64_t pos),
+         void* context) {
+  wuffs_json__decoder dec;
+  wuffs_base__status status = wuffs_json__decoder__initialize(
+      &dec, sizeof dec, WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+
+  wuffs_base__io_buffer src =
+      wuffs_base__ptr_u8__reader((uint8_t*)(data + start), end - start, true);
+  src.meta.pos = start;
+  wuffs_base__token_buffer tok =
+      wuffs_base__slice_token__writer(wuffs_base__make_slice_token(
+          g_tok_buffer_array, TOKEN_BUFFER_ARRAY_SIZE));
+
+  uint64_t pos = wuffs_base__io_buffer__reader_io_position(&src);
+  while (true) {
+    status = wuffs_json__decoder__decode_tokens(
+        &dec, &tok, &src,
+        wuffs_base__make_slice_u8(g_work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+
+    wuffs_base__slice_token s =
+        wuffs_base__make_slice_token(tok.data.ptr, tok.meta.wi);
+    pos = wuffs_base__slice_token__source_positions(
+        wuffs_base__make_slice_u64(g_pos_buffer_array, TOKEN_BUFFER_ARRAY_SIZE),
+        s, pos);
+    size_t i;
+    for (i = 0; i < s.len; i++) {
+      const char* z =
+          (*handle_token)(context, data, s.ptr[i], g_pos_buffer_array[i]);
+      if (z == g_stop) {
+        return NULL;
+      } else if (z) {
+        return z;
+      }
+    }
+    tok.meta.ri = tok.meta.wi;
+    wuffs_base__token_buffer__compact(&tok);
+
+    if (status.repr == NULL) {
+      return NULL;
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      continue;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      return "main: truncated input";
+    }
+    return wuffs_base__status__message(&status);
+  }
+}
+
+// string_token_bytes returns the unescaped bytes of a string or Unicode code
+// point token t, starting at source position pos. buf must have room for a
+// UTF-8 encoded code point.
+static wuffs_base__slice_u8  //
+string_token_bytes(const uint8_t* data,
+                   wuffs_base__token t,
+                   uint64_t pos,
+                   uint8_t* buf) {
+  uint64_t vbd = wuffs_base__token__value_base_detail(&t);
+  switch (wuffs_base__token__value_base_category(&t)) {
+    case WUFFS_BASE__TOKEN__VBC__STRING:
+      if (vbd & WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY) {
+        return wuffs_base__make_slice_u8((uint8_t*)(data + pos),
+                                         wuffs_base__token__length(&t));
+      }
+      break;
+    case WUFFS_BASE__TOKEN__VBC__UNICODE_CODE_POINT:
+      return wuffs_base__make_slice_u8(
+          buf, wuffs_base__utf_8__encode(
+                   wuffs_base__make_slice_u8(
+                       buf, WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL),
+                   (uint32_t)vbd));
+  }
+  return wuffs_base__make_slice_u8(NULL, 0);
+}
+
+// hash_bytes is the 64-bit FNV-1a hash function.
+static uint64_t  //
+hash_bytes(uint64_t h, wuffs_base__slice_u8 s) {
+  size_t i;
+  for (i = 0; i < s.len; i++) {
+    h ^= s.ptr[i];
+    h *= 0x00000100000001B3;
+  }
+  return h;
+}
+
+#define HASH_INITIAL_VALUE 0xCBF29CE484222325
+
+// ---- Building an index.
+
+typedef struct {
+  uint64_t start;
+  uint64_t end;
+  uint64_t key_start;
+  uint64_t key;
+  uint64_t first_child;
+  uint64_t num_children;
+} node;
+
+typedef struct {
+  node* ptr;
+  size_t len;
+  size_t cap;
+} node_list;
+
+// frame is the state for one level of JSON container nesting. The depth 0
+// frame is the top level, which is treated as an array of exactly one value.
+typedef struct {
+  node self;
+  bool is_object;
+  bool expecting_key;
+  uint64_t num_values;
+  uint64_t key_start;
+  uint64_t key_hash;
+  node_list children;
+} frame;
+
+typedef struct {
+  int index_fd;
+  size_t out_len;
+  uint64_t num_nodes;
+  bool prev_continued;
+  bool in_key;
+  uint32_t depth;
+  frame frames[WUFFS_JSON__DECODER_DEPTH_MAX_INCL + 1];
+} builder;
+
+static int  //
+compare_nodes(const void* x, const void* y) {
+  const node* nx = (const node*)x;
+  const node* ny = (const node*)y;
+  if (nx->key != ny->key) {
+    return (nx->key < ny->key) ? -1 : +1;
+  } else if (nx->start != ny->start) {
+    return (nx->start < ny->start) ? -1 : +1;
+  }
+  return 0;
+}
+
+static const char*  //
+flush_nodes(builder* b) {
+  const char* z = write_all(b->index_fd, g_out_buffer_array, b->out_len);
+  b->out_len = 0;
+  return z;
+}
+
+// append_nodes writes the children of a container (or, for depth 0, the root
+// node) to the index file.
+static const char*  //
+append_nodes(builder* b, node_list* l) {
+  size_t i;
+  for (i = 0; i < l->len; i++) {
+    if ((OUT_BUFFER_ARRAY_SIZE - b->out_len) < NODE_LEN) {
+      const char* z = flush_nodes(b);
+      if (z) {
+        return z;
+      }
+    }
+    uint8_t* p = g_out_buffer_array + b->out_len;
+    wuffs_base__store_u64le__no_bounds_check(p + 0x00, l->ptr[i].start);
+    wuffs_base__store_u64le__no_bounds_check(p + 0x08, l->ptr[i].end);
+    wuffs_base__store_u64le__no_bounds_check(p + 0x10, l->ptr[i].key_start);
+    wuffs_base__store_u64le__no_bounds_check(p + 0x18, l->ptr[i].key);
+    wuffs_base__store_u64le__no_bounds_check(p + 0x20, l->ptr[i].first_child);
+    wuffs_base__store_u64le__no_bounds_check(p + 0x28, l->ptr[i].num_children);
+    b->out_len += NODE_LEN;
+  }
+  b->num_nodes += l->len;
+  l->len = 0;
+  return NULL;
+}
+
+// begin_value notes that a new value (of the f container) starts at pos, and
+// returns its (partially filled in) node.
+static node  //
+begin_value(frame* f, uint64_t pos) {
+  node n = {0};
+  n.start = pos;
+  if (f->is_object) {
+    n.key_start = f->key_start;
+    n.key = f->key_hash;
+    f->expecting_key = true;
+  } else {
+    n.key_start = UINT64_MAX;
+    n.key = f->num_values++;
+  }
+  return n;
+}
+
+static const char*  //
+build_handle_token(void* context,
+                   const uint8_t* data,
+                   wuffs_base__token t,
+                   uint64_t pos) {
+  builder* b = (builder*)context;
+  frame* f = &b->frames[b->depth];
+  bool start_of_token_chain = !b->prev_continued;
+  b->prev_continued = wuffs_base__token__continued(&t);
+
+  uint64_t vbd = wuffs_base__token__value_base_detail(&t);
+  switch (wuffs_base__token__value_base_category(&t)) {
+    case WUFFS_BASE__TOKEN__VBC__STRUCTURE:
+      if (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__PUSH) {
+        if (b->depth >= WUFFS_JSON__DECODER_DEPTH_MAX_INCL) {
+          return "main: internal error: inconsistent depth";
+        }
+        node n = begin_value(f, pos);
+        f = &b->frames[++b->depth];
+        f->self = n;
+        f->is_object = vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT;
+        f->expecting_key = f->is_object;
+        f->num_values = 0;
+
+      } else if (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__POP) {
+        if (b->depth == 0) {
+          return "main: internal error: inconsistent depth";
+        }
+        if (f->is_object) {
+          qsort(f->children.ptr, f->children.len, sizeof(node), compare_nodes);
+        }
+        f->self.end = pos + wuffs_base__token__length(&t);
+        f->self.first_child = b->num_nodes;
+        f->self.num_children = f->children.len;
+        const char* z = append_nodes(b, &f->children);
+        if (z) {
+          return z;
+        }
+
+        node n = f->self;
+        f = &b->frames[--b->depth];
+        node_list* l = &f->children;
+        if (l->len == l->cap) {
+          size_t cap = l->cap ? (2 * l->cap) : 16;
+          node* p = realloc(l->ptr, cap * sizeof(node));
+          if (!p) {
+            return "main: out of memory";
+          }
+          l->ptr = p;
+          l->cap = cap;
+        }
+        l->ptr[l->len++] = n;
+      }
+      return NULL;
+
+    case WUFFS_BASE__TOKEN__VBC__STRING:
+    case WUFFS_BASE__TOKEN__VBC__UNICODE_CODE_POINT:
+      if (start_of_token_chain) {
+        b->in_key = f->is_object && f->expecting_key;
+        if (b->in_key) {
+          f->key_start = pos;
+          f->key_hash = HASH_INITIAL_VALUE;
+        } else {
+          begin_value(f, pos);
+        }
+      }
+      if (b->in_key) {
+        uint8_t buf[WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL];
+        f->key_hash =
+            hash_bytes(f->key_hash, string_token_bytes(data, t, pos, buf));
+        if (!b->prev_continued) {
+          f->expecting_key = false;
+          b->in_key = false;
+        }
+      }
+      return NULL;
+
+    case WUFFS_BASE__TOKEN__VBC__LITERAL:
+    case WUFFS_BASE__TOKEN__VBC__NUMBER:
+      begin_value(f, pos);
+      return NULL;
+  }
+  return NULL;
+}
+
+static const char*  //
+build(const uint8_t* data, size_t data_len, int index_fd) {
+  builder* b = calloc(1, sizeof(builder));
+  if (!b) {
+    return "main: out of memory";
+  }
+  b->index_fd = index_fd;
+
+  // The node count and root node index are patched in after tokenizing.
+  uint8_t header[HEADER_LEN] = {0};
+  memcpy(header, MAGIC, MAGIC_LEN);
+  const char* z = write_all(index_fd, header, HEADER_LEN);
+  if (!z) {
+    z = tokenize(data, 0, data_len, build_handle_token, b);
+  }
+
+  // The root node (if the top-level value is a container) is the last one.
+  uint64_t root = UINT64_MAX;
+  if (!z && (b->depth != 0)) {
+    z = "main: internal error: inconsistent depth";
+  }
+  if (!z && (b->frames[0].children.len > 0)) {
+    root = b->num_nodes;
+    z = append_nodes(b, &b->frames[0].children);
+  }
+  if (!z) {
+    z = flush_nodes(b);
+  }
+  if (!z) {
+    wuffs_base__store_u64le__no_bounds_check(header + MAGIC_LEN + 0, data_len);
+    wuffs_base__store_u64le__no_bounds_check(header + MAGIC_LEN + 8,
+                                             b->num_nodes);
+    wuffs_base__store_u64le__no_bounds_check(header + MAGIC_LEN + 16, root);
+    if (lseek(index_fd, 0, SEEK_SET) < 0) {
+      z = strerror(errno);
+    } else {
+      z = write_all(index_fd, header, HEADER_LEN);
+    }
+  }
+
+  uint32_t i;
+  for (i = 0; i <= WUFFS_JSON__DECODER_DEPTH_MAX_INCL; i++) {
+    free(b->frames[i].children.ptr);
+  }
+  free(b);
+  return z;
+}
+
+// ---- Querying an index.
+
+// load_node loads the i'th node, checking that it is consistent with the rest
+// of the index and with the parent node's source range.
+static bool  //
+load_node(uint8_t* index,
+          uint64_t num_nodes,
+          uint64_t i,
+          uint64_t parent_start,
+          uint64_t parent_end,
+          node* n) {
+  if (i >= num_nodes) {
+    return false;
+  }
+  uint8_t* p = index + HEADER_LEN + (i * NODE_LEN);
+  n->start = wuffs_base__load_u64le__no_bounds_check(p + 0x00);
+  n->end = wuffs_base__load_u64le__no_bounds_check(p + 0x08);
+  n->key_start = wuffs_base__load_u64le__no_bounds_check(p + 0x10);
+  n->key = wuffs_base__load_u64le__no_bounds_check(p + 0x18);
+  n->first_child = wuffs_base__load_u64le__no_bounds_check(p + 0x20);
+  n->num_children = wuffs_base__load_u64le__no_bounds_check(p + 0x28);
+  return (parent_start <= n->start) && (n->start < n->end) &&
+         (n->end <= parent_end) && (n->first_child <= num_nodes) &&
+         (n->num_children <= (num_nodes - n->first_child));
+}
+
+// unescape_fragment converts, in place, a JSON Pointer fragment's "~0" and
+// "~1" to "~" and "/". It returns the new length, or SIZE_MAX if the fragment
+// has any other '~'.
+static size_t  //
+unescape_fragment(char* frag, size_t len) {
+  size_t i = 0;
+  size_t j = 0;
+  while (i < len) {
+    char c = frag[i++];
+    if (c == '~') {
+      if ((i >= len) || ((frag[i] != '0') && (frag[i] != '1'))) {
+        return SIZE_MAX;
+      }
+      c = (frag[i++] == '0') ? '~' : '/';
+    }
+    frag[j++] = c;
+  }
+  return j;
+}
+
+// parse_array_index parses a JSON Pointer array index: decimal digits without
+// leading zeroes. It returns UINT64_MAX if the fragment is not such an index.
+static uint64_t  //
+parse_array_index(const char* frag, size_t len) {
+  if ((len == 0) || ((len > 1) && (frag[0] == '0'))) {
+    return UINT64_MAX;
+  }
+  size_t i;
+  for (i = 0; i < len; i++) {
+    if ((frag[i] < '0') || ('9' < frag[i])) {
+      return UINT64_MAX;
+    }
+  }
+  wuffs_base__result_u64 r = wuffs_base__parse_number_u64(
+      wuffs_base__make_slice_u8((uint8_t*)frag, len));
+  return r.status.repr ? UINT64_MAX : r.value;
+}
+
+// matcher finds, by re-tokenizing a container, which of its items matches a
+// JSON Pointer fragment. For depth 0 (the top level value), it finds the
+// whole value. It can also just compare a JSON string to the fragment.
+typedef struct {
+  const char* frag;
+  size_t frag_len;
+  uint64_t want_index;
+  bool string_only;
+
+  bool prev_continued;
+  bool in_key;
+  bool key_ok;
+  size_t key_len;
+  bool key_matched;
+  uint32_t depth;
+  uint32_t item_depth;
+  bool is_object;
+  bool expecting_key;
+  uint64_t num_values;
+
+  bool found;
+  uint64_t found_start;
+  uint64_t found_end;
+} matcher;
+
+static void  //
+match_string_token(matcher* m,
+                   const uint8_t* data,
+                   wuffs_base__token t,
+                   uint64_t pos) {
+  uint8_t buf[WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL];
+  wuffs_base__slice_u8 s = string_token_bytes(data, t, pos, buf);
+  if (m->key_ok && (s.len <= (m->frag_len - m->key_len)) &&
+      !memcmp(m->frag + m->key_len, s.ptr, s.len)) {
+    m->key_len += s.len;
+  } else {
+    m->key_ok = false;
+  }
+}
+
+static const char*  //
+match_handle_token(void* context,
+                   const uint8_t* data,
+                   wuffs_base__token t,
+                   uint64_t pos) {
+  matcher* m = (matcher*)context;
+  bool start_of_token_chain = !m->prev_continued;
+  m->prev_continued = wuffs_base__token__continued(&t);
+
+  int64_t vbc = wuffs_base__token__value_base_category(&t);
+  uint64_t vbd = wuffs_base__token__value_base_detail(&t);
+  if (vbc == WUFFS_BASE__TOKEN__VBC__FILLER) {
+    return NULL;
+  }
+
+  // Matching just a string is for confirming an index node's key.
+  if (m->string_only) {
+    if ((vbc != WUFFS_BASE__TOKEN__VBC__STRING) &&
+        (vbc != WUFFS_BASE__TOKEN__VBC__UNICODE_CODE_POINT)) {
+      return "main: bad index";
+    }
+    match_string_token(m, data, t, pos);
+    if (m->prev_continued) {
+      return NULL;
+    }
+    m->found = m->key_ok && (m->key_len == m->frag_len);
+    return g_stop;
+  }
+
+  bool is_string = (vbc == WUFFS_BASE__TOKEN__VBC__STRING) ||
+                   (vbc == WUFFS_BASE__TOKEN__VBC__UNICODE_CODE_POINT);
+  bool is_pop = (vbc == WUFFS_BASE__TOKEN__VBC__STRUCTURE) &&
+                (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__POP);
+
+  // Is this the start of an item (a key or a value) of the container?
+  if ((m->depth == m->item_depth) && start_of_token_chain && !is_pop) {
+    if (m->is_object && m->expecting_key) {
+      if (!is_string) {
+        return "main: internal error: inconsistent matcher state";
+      }
+      m->in_key = true;
+      m->key_ok = true;
+      m->key_len = 0;
+      m->expecting_key = false;
+    } else if (m->found) {
+      return "main: internal error: inconsistent matcher state";
+    } else if (m->is_object) {
+      m->found = m->key_matched;
+      m->key_matched = false;
+      m->expecting_key = true;
+    } else {
+      m->found = m->num_values++ == m->want_index;
+    }
+    if (m->found) {
+      m->found_start = pos;
+    }
+  }
+
+  if (m->in_key) {
+    match_string_token(m, data, t, pos);
+    if (!m->prev_continued) {
+      m->in_key = false;
+      m->key_matched = m->key_ok && (m->key_len == m->frag_len);
+    }
+    return NULL;
+  }
+
+  if (vbc == WUFFS_BASE__TOKEN__VBC__STRUCTURE) {
+    if (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__PUSH) {
+      if (m->depth++ == (m->item_depth - 1)) {
+        m->is_object = vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_DICT;
+        m->expecting_key = m->is_object;
+      }
+    } else if (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__POP) {
+      if (m->depth-- == m->item_depth) {
+        return g_stop;  // End of the container; no match.
+      }
+    }
+  }
+
+  // Is this the end of the found value?
+  if (m->found && (m->depth == m->item_depth) && !m->prev_continued) {
+    m->found_end = pos + wuffs_base__token__length(&t);
+    return g_stop;
+  }
+  return NULL;
+}
+
+static const char*  //
+query(const uint8_t* data, size_t data_len, uint8_t* index, size_t index_len) {
+  if ((index_len < HEADER_LEN) || memcmp(index, MAGIC, MAGIC_LEN)) {
+    return "main: bad index";
+  } else if (wuffs_base__load_u64le__no_bounds_check(index + MAGIC_LEN + 0) !=
+             data_len) {
+    return "main: index does not match the JSON file (its length changed)";
+  }
+  uint64_t num_nodes =
+      wuffs_base__load_u64le__no_bounds_check(index + MAGIC_LEN + 8);
+  uint64_t root =
+      wuffs_base__load_u64le__no_bounds_check(index + MAGIC_LEN + 16);
+  if (num_nodes > ((index_len - HEADER_LEN) / NODE_LEN)) {
+    return "main: bad index";
+  }
+
+  // cur is the current container. has_cur is false if the top-level value
+  // is not a container.
+  node cur = {0};
+  bool has_cur = root != UINT64_MAX;
+  if (has_cur && !load_node(index, num_nodes, root, 0, data_len, &cur)) {
+    return "main: bad index";
+  }
+
+  matcher m = {0};
+  char* q = g_flags.query ? g_flags.query : "";
+  while (*q) {
+    // Split off the next fragment.
+    char* frag = ++q;
+    while ((*q != '\x00') && (*q != '/')) {
+      q++;
+    }
+    size_t frag_len = unescape_fragment(frag, q - frag);
+    if (frag_len == SIZE_MAX) {
+      return "main: bad -query flag value";
+    } else if (!has_cur) {
+      return "main: no match for query";
+    }
+
+    // Binary search for the first child container whose key is at least
+    // want, where want is the key hash or the array index.
+    bool is_object = data[cur.start] == '{';
+    uint64_t want =
+        is_object
+            ? hash_bytes(HASH_INITIAL_VALUE,
+                         wuffs_base__make_slice_u8((uint8_t*)frag, frag_len))
+            : parse_array_index(frag, frag_len);
+    uint64_t lo = cur.first_child;
+    uint64_t hi = cur.first_child + cur.num_children;
+    while (lo < hi) {
+      uint64_t mid = lo + ((hi - lo) / 2);
+      node n;
+      if (!load_node(index, num_nodes, mid, cur.start, cur.end, &n)) {
+        return "main: bad index";
+      } else if (n.key < want) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+
+    // Check the candidates. For objects, hashes can collide, so confirm the
+    // key itself.
+    bool found = false;
+    for (; lo < cur.first_child + cur.num_children; lo++) {
+      node n;
+      if (!load_node(index, num_nodes, lo, cur.start, cur.end, &n)) {
+        return "main: bad index";
+      } else if (n.key != want) {
+        break;
+      } else if (is_object) {
+        if ((n.key_start < cur.start) || (n.start <= n.key_start)) {
+          return "main: bad index";
+        }
+        memset(&m, 0, sizeof m);
+        m.frag = frag;
+        m.frag_len = frag_len;
+        m.string_only = true;
+        m.key_ok = true;
+        const char* z =
+            tokenize(data, n.key_start, n.start, match_handle_token, &m);
+        if (z) {
+          return z;
+        } else if (!m.found) {
+          continue;
+        }
+      }
+      cur = n;
+      found = true;
+      break;
+    }
+    if (found) {
+      continue;
+    }
+
+    // The fragment doesn't name a child container. It might name a string,
+    // number or literal, but only as the query's final fragment.
+    if (*q != '\x00') {
+      return "main: no match for query";
+    }
+    memset(&m, 0, sizeof m);
+    m.frag = frag;
+    m.frag_len = frag_len;
+    m.want_index = is_object ? 0 : want;
+    m.item_depth = 1;
+    const char* z = tokenize(data, cur.start, cur.end, match_handle_token, &m);
+    if (z) {
+      return z;
+    } else if (!m.found) {
+      return "main: no match for query";
+    }
+    cur.start = m.found_start;
+    cur.end = m.found_end;
+    has_cur = true;
+  }
+
+  // For an empty query and a top-level value that isn't a container, find
+  // that value's extent.
+  if (!has_cur) {
+    memset(&m, 0, sizeof m);
+    m.item_depth = 0;
+    const char* z = tokenize(data, 0, data_len, match_handle_token, &m);
+    if (z) {
+      return z;
+    } else if (!m.found) {
+      return "main: internal error: no top-level value";
+    }
+    cur.start = m.found_start;
+    cur.end = m.found_end;
+  }
+
+  const int stdout_fd = 1;
+  const char* z = write_all(stdout_fd, data + cur.start, cur.end - cur.start);
+  if (!z) {
+    z = write_all(stdout_fd, (const uint8_t*)"\n", 1);
+  }
+  return z;
+}
+
+// ----
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  } else if (g_flags.remaining_argc != 3) {
+    return "main: usage: jsonindex [flags] build|query foo.json foo.json.idx";
+  }
+  const char* mode = g_flags.remaining_argv[0];
+  const char* src_filename = g_flags.remaining_argv[1];
+  const char* index_filename = g_flags.remaining_argv[2];
+
+  // Files are deliberately not closed, freed or unmapped. The process is
+  // about to exit.
+  int src_fd = open(src_filename, O_RDONLY);
+  if (src_fd < 0) {
+    return strerror(errno);
+  }
+  uint8_t* data = NULL;
+  size_t data_len = 0;
+  z = read_all(src_fd, &data, &data_len);
+  if (z) {
+    return z;
+  }
+
+  if (!strcmp(mode, "build")) {
+    int index_fd = open(index_filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (index_fd < 0) {
+      return strerror(errno);
+    }
+    return build(data, data_len, index_fd);
+
+  } else if (!strcmp(mode, "query")) {
+    int index_fd = open(index_filename, O_RDONLY);
+    if (index_fd < 0) {
+      return strerror(errno);
+    }
+    uint8_t* index = NULL;
+    size_t index_len = 0;
+    z = read_all(index_fd, &index, &index_len);
+    if (z) {
+      return z;
+    }
+    return query(data, data_len, index, index_len);
+  }
+
+  return "main: unrecognized mode; want \"build\" or \"query\"";
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
@@ -0,0 +1,537 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+ndjsoncat decodes JSON Lines data (also known as NDJSON, newline-delimited
+JSON), where each line holds one top-level JSON value, and writes each value
+to stdout, compacted (with insignificant whitespace removed), one per line. It
+uses multiple threads to decode a single file. It reads from the named file, or
+from stdin if no file is named. To run:
+
+$CC -O3 ndjsoncat.c -lpthread
+./a.out ../../test/data/nobel-prizes.jsonl; rm -f a.out
+
+for a C compiler $CC, such as clang or gcc.
+
+std/json's decoder handles one top-level value at a time, on one thread. As a
+'\n' byte can only occur between JSON tokens (JSON strings cannot contain raw
+control characters), the input can be split at '\n' bytes and each part can be
+decoded independently. ndjsoncat processes the input in rounds of up to
+-threads chunks, each chunk being roughly CHUNK_SIZE bytes and ending just
+after a '\n' byte. For each round:
+
+1. In parallel, each chunk is decoded into that chunk's own token buffer. Each
+   line gets a freshly initialized decoder, with QUIRK_ALLOW_TRAILING_NEW_LINE
+   enabled, and each chunk records where each line's tokens start and end.
+
+2. Sequentially, in input order, each record (a line's source bytes and its
+   slice of tokens) is passed to handle_record. Other programs could replace
+   handle_record, which here just writes the compacted JSON value.
+
+Blank lines are skipped. A JSON value that spans multiple lines is rejected,
+as that isn't JSON Lines. Errors are reported with their (1-based) line
+number, after writing any valid records before that line.
+
+Unlike example/jsonptr, ndjsoncat does not self-impose a SECCOMP_MODE_STRICT
+sandbox, as that would disallow threads.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__JSON
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+// CHUNK_SIZE is the nominal number of input bytes per chunk.
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE (4 * 1024 * 1024)
+#endif
+
+#ifndef DST_BUFFER_ARRAY_SIZE
+#define DST_BUFFER_ARRAY_SIZE (64 * 1024)
+#endif
+
+#define MAX_THREADS 256
+
+uint8_t g_dst_buffer_array[DST_BUFFER_ARRAY_SIZE];
+size_t g_dst_len = 0;
+
+char g_error_msg[256];
+
+// ----
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  uint32_t threads;
+} g_flags = {0};
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  g_flags.threads = (n < 1) ? 1 : (n > MAX_THREADS) ? MAX_THREADS : n;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "threads=", 8)) {
+      char* end = NULL;
+      long t = strtol(arg + 8, &end, 10);
+      if ((*end != '\x00') || (t < 1) || (MAX_THREADS < t)) {
+        return "main: bad -threads flag value";
+      }
+      g_flags.threads = t;
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+static const char*  //
+write_to_stdout(const uint8_t* ptr, size_t len) {
+  while (len > 0) {
+    const int stdout_fd = 1;
+    ssize_t n = write(stdout_fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return NULL;
+}
+
+static const char*  //
+flush_dst() {
+  const char* z = write_to_stdout(g_dst_buffer_array, g_dst_len);
+  g_dst_len = 0;
+  return z;
+}
+
+static const char*  //
+write_dst(const uint8_t* ptr, size_t len) {
+  if (len > (DST_BUFFER_ARRAY_SIZE - g_dst_len)) {
+    const char* z = flush_dst();
+    if (z) {
+      return z;
+    } else if (len > DST_BUFFER_ARRAY_SIZE) {
+      return write_to_stdout(ptr, len);
+    }
+  }
+  memcpy(g_dst_buffer_array + g_dst_len, ptr, len);
+  g_dst_len += len;
+  return NULL;
+}
+
+// ---- Handling records.
+
+// handle_record is called once per line, in input order. The tokens cover
+// exactly the record's source bytes, which start at src.
+static const char*  //
+handle_record(const uint8_t* src,
+              const wuffs_base__token* tokens,
+              size_t num_tokens) {
+  // Filler tokens are whitespace, but also the ',' and ':' punctuation.
+  size_t i;
+  for (i = 0; i < num_tokens; i++) {
+    size_t len = wuffs_base__token__length(&tokens[i]);
+    if ((wuffs_base__token__value_base_category(&tokens[i]) !=
+         WUFFS_BASE__TOKEN__VBC__FILLER) ||
+        ((len == 1) && ((*src == ',') || (*src == ':')))) {
+      const char* z = write_dst(src, len);
+      if (z) {
+        return z;
+      }
+    }
+    src += len;
+  }
+  return write_dst((const uint8_t*)"\n", 1);
+}
+
+// ---- Decoding chunks.
+
+typedef struct {
+  uint64_t src_start;
+  uint64_t src_end;
+  size_t tok_end;
+} record;
+
+typedef struct {
+  // Input.
+  const uint8_t* data;
+  size_t data_len;
+
+  // Output. The records' src_start and src_end are relative to data.
+  wuffs_base__token* tokens;
+  size_t tokens_cap;
+  size_t num_tokens;
+  record* records;
+  size_t records_cap;
+  size_t num_records;
+
+  // On failure, status is non-NULL and error_pos is relative to data.
+  const char* status;
+  uint64_t error_pos;
+} chunk;
+
+chunk g_chunks[MAX_THREADS];
+
+static inline bool  //
+is_json_whitespace(uint8_t c) {
+  return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t');
+}
+
+static bool  //
+grow(void** ptr, size_t* cap, size_t elem_size) {
+  size_t n = *cap ? (2 * *cap) : (64 * 1024);
+  void* p = realloc(*ptr, n * elem_size);
+  if (!p) {
+    return false;
+  }
+  *ptr = p;
+  *cap = n;
+  return true;
+}
+
+static const char*  //
+decode_record(chunk* c, wuffs_base__io_buffer* src) {
+  wuffs_json__decoder dec;
+  wuffs_base__status status = wuffs_json__decoder__initialize(
+      &dec, sizeof dec, WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  wuffs_json__decoder__set_quirk_enabled(
+      &dec, WUFFS_JSON__QUIRK_ALLOW_TRAILING_NEW_LINE, true);
+
+  while (true) {
+    wuffs_base__token_buffer tok = ((wuffs_base__token_buffer){
+        .data = wuffs_base__make_slice_token(c->tokens, c->tokens_cap),
+        .meta = wuffs_base__make_token_buffer_meta(c->num_tokens, c->num_tokens,
+                                                   0, false),
+    });
+    status = wuffs_json__decoder__decode_tokens(&dec, &tok, src,
+                                                wuffs_base__empty_slice_u8());
+    c->num_tokens = tok.meta.wi;
+    if (status.repr != wuffs_base__suspension__short_write) {
+      break;
+    } else if (!grow((void**)&c->tokens, &c->tokens_cap,
+                     sizeof(wuffs_base__token))) {
+      return "out of memory";
+    }
+  }
+  return wuffs_base__status__message(&status);
+}
+
+static void*  //
+decode_thread_func(void* arg) {
+  chunk* c = (chunk*)arg;
+  c->num_tokens = 0;
+  c->num_records = 0;
+  c->status = NULL;
+  c->error_pos = 0;
+
+  wuffs_base__io_buffer src =
+      wuffs_base__ptr_u8__reader((uint8_t*)(c->data), c->data_len, true);
+  while (true) {
+    while ((src.meta.ri < src.meta.wi) &&
+           is_json_whitespace(src.data.ptr[src.meta.ri])) {
+      src.meta.ri++;
+    }
+    if (src.meta.ri >= src.meta.wi) {
+      break;
+    }
+    if ((c->num_records == c->records_cap) &&
+        !grow((void**)&c->records, &c->records_cap, sizeof(record))) {
+      c->status = "out of memory";
+      return NULL;
+    }
+
+    uint64_t src_start = src.meta.ri;
+    c->status = decode_record(c, &src);
+    if (c->status) {
+      c->error_pos = src.meta.ri;
+      return NULL;
+    }
+
+    // Apart from the trailing '\n', a record may not contain a '\n'.
+    uint64_t src_end = src.meta.ri;
+    size_t n = src_end - src_start;
+    if (c->data[src_end - 1] == '\n') {
+      n--;
+    }
+    if (memchr(c->data + src_start, '\n', n)) {
+      c->status = "JSON value spans multiple lines";
+      c->error_pos = src_start;
+      return NULL;
+    }
+
+    record* r = &c->records[c->num_records++];
+    r->src_start = src_start;
+    r->src_end = src_end;
+    r->tok_end = c->num_tokens;
+  }
+  return NULL;
+}
+
+// run_in_parallel runs f over the n chunks, one thread per chunk.
+static const char*  //
+run_in_parallel(void* (*f)(void*), chunk* chunks, size_t n) {
+  if (n == 1) {
+    f(&chunks[0]);
+    return NULL;
+  }
+  pthread_t threads[MAX_THREADS];
+  size_t i;
+  for (i = 0; i < n; i++) {
+    if (pthread_create(&threads[i], NULL, f, &chunks[i])) {
+      while (i > 0) {
+        pthread_join(threads[--i], NULL);
+      }
+      return "main: pthread_create failed";
+    }
+  }
+  for (i = 0; i < n; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  return NULL;
+}
+
+// count_lines returns the 1-based line number of data[pos].
+static size_t  //
+count_lines(const uint8_t* data, size_t pos) {
+  size_t line = 1;
+  const uint8_t* end = data + pos;
+  while (data < end) {
+    const uint8_t* p = memchr(data, '\n', end - data);
+    if (!p) {
+      break;
+    }
+    line++;
+    data = p + 1;
+  }
+  return line;
+}
+
+static const char*  //
+decode_lines_in_parallel(const uint8_t* data, size_t data_len) {
+  size_t pos = 0;
+  while (pos < data_len) {
+    // Split the next round's input into chunks that end just after a '\n'.
+    size_t n;
+    for (n = 0; (n < g_flags.threads) && (pos < data_len); n++) {
+      size_t end = data_len;
+      if ((data_len - pos) > CHUNK_SIZE) {
+        const uint8_t* p = memchr(data + pos + CHUNK_SIZE - 1, '\n',
+                                  data_len - (pos + CHUNK_SIZE - 1));
+        if (p) {
+          end = (p + 1) - data;
+        }
+      }
+      g_chunks[n].data = data + pos;
+      g_chunks[n].data_len = end - pos;
+      pos = end;
+    }
+
+    const char* z = run_in_parallel(decode_thread_func, g_chunks, n);
+    if (z) {
+      return z;
+    }
+
+    size_t i;
+    for (i = 0; i < n; i++) {
+      chunk* c = &g_chunks[i];
+      size_t tok_start = 0;
+      size_t j;
+      for (j = 0; j < c->num_records; j++) {
+        record* r = &c->records[j];
+        z = handle_record(c->data + r->src_start, c->tokens + tok_start,
+                          r->tok_end - tok_start);
+        if (z) {
+          return z;
+        }
+        tok_start = r->tok_end;
+      }
+
+      if (c->status) {
+        z = flush_dst();
+        if (z) {
+          return z;
+        }
+        snprintf(g_error_msg, sizeof g_error_msg, "main: line %zu: %s",
+                 count_lines(data, (c->data - data) + c->error_pos), c->status);
+        return g_error_msg;
+      }
+    }
+  }
+  return flush_dst();
+}
+
+// ----
+
+static const char*  //
+read_all(int fd, uint8_t** ptr, size_t* len) {
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      *ptr = p;
+      *len = st.st_size;
+      return NULL;
+    }
+  }
+
+  size_t cap = 0;
+  *ptr = NULL;
+  *len = 0;
+  while (true) {
+    if (*len == cap) {
+      cap = cap ? (2 * cap) : (1024 * 1024);
+      uint8_t* p = realloc(*ptr, cap);
+      if (!p) {
+        return "main: out of memory";
+      }
+      *ptr = p;
+    }
+    ssize_t n = read(fd, *ptr + *len, cap - *len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      return NULL;
+    }
+    *len += n;
+  }
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  }
+
+  int fd = 0;
+  if (g_flags.remaining_argc > 0) {
+    fd = open(g_flags.remaining_argv[0], O_RDONLY);
+    if (fd < 0) {
+      return strerror(errno);
+    }
+  }
+  // The input is deliberately not freed or unmapped. The process is about to
+  // exit.
+  uint8_t* data = NULL;
+  size_t data_len = 0;
+  z = read_all(fd, &data, &data_len);
+  if (z) {
+    return z;
+  }
+  return decode_lines_in_parallel(data, data_len);
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
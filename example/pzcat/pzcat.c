@@ -0,0 +1,1437 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+pzcat decodes gzip'ed data to stdout, like example/zcat, but uses multiple
+threads to decode a single gzip member. It reads from the named file, or from
+stdin if no file is named. To run:
+
+$CC -O3 pzcat.c -lpthread && ./a.out ../../test/data/romeo.txt.gz; rm -f a.out
+
+for a C compiler $CC, such as clang or gcc.
+
+The deflate format is inherently sequential: finding where a block starts
+requires decoding every block before it, and back-references can reach 32 KiB
+into previously decoded output. pzcat works around both, in the style of pugz
+and rapidgzip. The compressed input is processed in rounds of up to -threads
+chunks, each chunk being roughly CHUNK_SIZE compressed bytes. For each round:
+
+1. In parallel, each chunk (other than the first) scans for a candidate
+   dynamic Huffman block header near its nominal start. A candidate has to
+   pass a full parse of the header's code lengths and then decode a trial run
+   of compressed bytes without error.
+
+2. In parallel, each chunk is decoded from its (block-aligned) start bit to
+   the next chunk's start bit. The first chunk knows its preceding 32 KiB
+   window, seeded via the deflate decoder's add_history method, so it decodes
+   normally. Every other chunk doesn't know its window yet, so it decodes
+   speculatively, twice, seeded with two synthetic windows. An output byte that
+   is equal in both decodes is a literal (or a copy of one). An output byte
+   that differs is an unresolved back-reference into the unknown window, and
+   the pair of bytes encodes which window position it refers to.
+
+3. Sequentially, each chunk's final 32 KiB are patched, giving the next
+   chunk's window.
+
+4. Each boundary is validated: decoding each chunk continues a little past its
+   end, and that continuation has to match the start of the next chunk. A
+   false positive boundary is rejected, and remembered so that it is never a
+   candidate again. Only the chunk that it started is re-scanned for its next
+   candidate (or, if there is none, merged into the chunk before it), and only
+   the chunks either side of that boundary are decoded again.
+
+5. In parallel, each chunk's full output is patched and its CRC-32 checksum is
+   computed. Those checksums are combined (via the crc32 hasher's combine_u32
+   method) and checked against the gzip trailer.
+
+The last chunk of a round is followed by a short probe chunk, the start of the
+next round's first chunk, so that the round's final boundary is validated too.
+
+A round's buffered output is roughly capped at ROUND_OUTPUT_MAX bytes. The
+first chunk writes out its output as it goes, since its window is known. A
+speculative chunk whose output would exceed its share of the cap ends the round
+early, becoming the probe chunk.
+
+Only single-member gzip files are supported. Unlike example/zcat, pzcat does
+not self-impose a SECCOMP_MODE_STRICT sandbox, as that would disallow threads.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+// CHUNK_SIZE is the nominal number of compressed bytes per chunk.
+#ifndef CHUNK_SIZE
+#define CHUNK_SIZE (4 * 1024 * 1024)
+#endif
+
+// TRIAL_SIZE is the number of compressed bytes that a candidate block boundary
+// has to decode without error.
+#ifndef TRIAL_SIZE
+#define TRIAL_SIZE (8 * 1024)
+#endif
+
+// ROUND_OUTPUT_MAX is roughly the maximum number of decoded bytes that a round
+// buffers, shared between its chunks.
+#ifndef ROUND_OUTPUT_MAX
+#define ROUND_OUTPUT_MAX (512 * 1024 * 1024)
+#endif
+
+#define MAX_THREADS 256
+
+#define WINDOW_SIZE 32768
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+#define NO_BOUNDARY UINT64_MAX
+
+// g_window_a and g_window_b are the synthetic windows for speculative decoding.
+// For every i in 0 ..= 32767, the two bytes differ, and the pair (a, b)
+// uniquely determines i. See resolve_markers.
+uint8_t g_window_a[WINDOW_SIZE];
+uint8_t g_window_b[WINDOW_SIZE];
+
+// ----
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  uint32_t threads;
+} g_flags = {0};
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  g_flags.threads = (n < 1) ? 1 : (n > MAX_THREADS) ? MAX_THREADS : n;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "threads=", 8)) {
+      char* end = NULL;
+      long t = strtol(arg + 8, &end, 10);
+      if ((*end != '\x00') || (t < 1) || (MAX_THREADS < t)) {
+        return "main: bad -threads flag value";
+      }
+      g_flags.threads = t;
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  g_flags.remaining_argc = argc - c;
+  g_flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+static const char*  //
+write_to_stdout(const uint8_t* ptr, size_t len) {
+  while (len > 0) {
+    const int stdout_fd = 1;
+    ssize_t n = write(stdout_fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return NULL;
+}
+
+// ---- Finding block boundaries.
+
+// The bit_reader and huffman code below is a minimal, deliberately simple
+// deflate header parser (in the style of zlib's contrib/puff). It only has to
+// reject almost all of the bit offsets that aren't the start of a dynamic
+// Huffman block, quickly. Wuffs' std/deflate decoder does the real decoding.
+
+typedef struct {
+  const uint8_t* ptr;
+  uint64_t len_in_bits;
+  uint64_t pos_in_bits;
+} bit_reader;
+
+// read_bits reads n bits, for n <= 24, or returns -1 at the end of input.
+static inline int32_t  //
+read_bits(bit_reader* br, uint32_t n) {
+  if ((br->len_in_bits - br->pos_in_bits) < n) {
+    return -1;
+  }
+  uint64_t i = br->pos_in_bits >> 3;
+  uint64_t i_end = (br->len_in_bits + 7) >> 3;
+  uint32_t x = 0;
+  uint32_t j;
+  for (j = 0; (j < 4) && ((i + j) < i_end); j++) {
+    x |= ((uint32_t)(br->ptr[i + j])) << (8 * j);
+  }
+  x >>= br->pos_in_bits & 7;
+  br->pos_in_bits += n;
+  return (int32_t)(x & ((1u << n) - 1));
+}
+
+typedef struct {
+  uint16_t counts[16];
+  uint16_t symbols[320];
+} huffman;
+
+// build_huffman returns 0 for a complete code, a positive number for an
+// incomplete code and a negative number for an over-subscribed code.
+static int32_t  //
+build_huffman(huffman* h, const uint8_t* lengths, uint32_t n) {
+  uint16_t offsets[16];
+  uint32_t i;
+  memset(h->counts, 0, sizeof(h->counts));
+  for (i = 0; i < n; i++) {
+    h->counts[lengths[i]]++;
+  }
+  int32_t left = 1;
+  for (i = 1; i < 16; i++) {
+    left <<= 1;
+    left -= h->counts[i];
+    if (left < 0) {
+      return left;
+    }
+  }
+  offsets[1] = 0;
+  for (i = 1; i < 15; i++) {
+    offsets[i + 1] = offsets[i] + h->counts[i];
+  }
+  for (i = 0; i < n; i++) {
+    if (lengths[i] != 0) {
+      h->symbols[offsets[lengths[i]]++] = i;
+    }
+  }
+  return left;
+}
+
+static int32_t  //
+decode_symbol(bit_reader* br, const huffman* h) {
+  int32_t code = 0;
+  int32_t first = 0;
+  int32_t index = 0;
+  uint32_t len;
+  for (len = 1; len < 16; len++) {
+    int32_t bit = read_bits(br, 1);
+    if (bit < 0) {
+      return -1;
+    }
+    code |= bit;
+    int32_t count = h->counts[len];
+    if ((code - count) < first) {
+      return h->symbols[index + (code - first)];
+    }
+    index += count;
+    first += count;
+    first <<= 1;
+    code <<= 1;
+  }
+  return -1;
+}
+
+static const uint8_t g_code_length_code_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+};
+
+// is_dynamic_block_header returns whether the bits starting at br's position
+// form a valid dynamic Huffman block header: the code length code and the
+// literal/length and distance code lengths all have to be well-formed.
+static bool  //
+is_dynamic_block_header(bit_reader* br) {
+  int32_t x = read_bits(br, 17);
+  if ((x < 0) || (((x >> 1) & 3) != 2)) {
+    return false;
+  }
+  uint32_t n_lit = 257 + ((x >> 3) & 31);
+  uint32_t n_dist = 1 + ((x >> 8) & 31);
+  uint32_t n_clen = 4 + ((x >> 13) & 15);
+  if ((n_lit > 286) || (n_dist > 30)) {
+    return false;
+  }
+
+  uint8_t lengths[320] = {0};
+  uint32_t i;
+  for (i = 0; i < n_clen; i++) {
+    int32_t cl = read_bits(br, 3);
+    if (cl < 0) {
+      return false;
+    }
+    lengths[g_code_length_code_order[i]] = cl;
+  }
+  huffman h;
+  if (build_huffman(&h, lengths, 19) != 0) {
+    return false;
+  }
+
+  uint32_t n = n_lit + n_dist;
+  for (i = 0; i < n;) {
+    int32_t sym = decode_symbol(br, &h);
+    if (sym < 0) {
+      return false;
+    } else if (sym < 16) {
+      lengths[i++] = sym;
+      continue;
+    }
+    uint8_t value = 0;
+    int32_t rep;
+    if (sym == 16) {
+      if (i == 0) {
+        return false;
+      }
+      value = lengths[i - 1];
+      rep = read_bits(br, 2);
+      rep = (rep < 0) ? -1 : (rep + 3);
+    } else if (sym == 17) {
+      rep = read_bits(br, 3);
+      rep = (rep < 0) ? -1 : (rep + 3);
+    } else {
+      rep = read_bits(br, 7);
+      rep = (rep < 0) ? -1 : (rep + 11);
+    }
+    if ((rep < 0) || ((n - i) < (uint32_t)rep)) {
+      return false;
+    }
+    memset(lengths + i, value, rep);
+    i += rep;
+  }
+
+  // The end-of-block code must be present and the literal/length code must
+  // be complete. The distance code may be incomplete only if it has at most
+  // one code.
+  if ((lengths[256] == 0) || (build_huffman(&h, lengths, n_lit) != 0)) {
+    return false;
+  }
+  int32_t left = build_huffman(&h, lengths + n_lit, n_dist);
+  if ((left < 0) || ((left > 0) && ((n_dist - h.counts[0]) > 1))) {
+    return false;
+  }
+  return true;
+}
+
+// ---- Decoding.
+
+// Deflate's stored blocks are aligned to byte boundaries, so a decoder can't
+// simply be given a bit-shifted copy of the input to start decoding at an
+// arbitrary bit offset. Instead, the decoder is first given a prefix of empty
+// (non-final) blocks, whose length in bits is congruent (modulo 8) to the
+// starting bit offset, so that the remaining input lines up with the original
+// bytes.
+//
+// An empty fixed Huffman block is 10 bits long. The empty dynamic Huffman
+// block below is 92 bits long, or 95 bits when its code length code has one
+// more (zero) entry. A combination of those can reach any length modulo 8.
+
+typedef struct {
+  uint8_t* ptr;
+  uint32_t n_bits;
+} bit_writer;
+
+static void  //
+write_bits(bit_writer* bw, uint32_t x, uint32_t n) {
+  for (; n > 0; n--) {
+    uint32_t p = bw->n_bits++;
+    bw->ptr[p >> 3] |= (x & 1) << (p & 7);
+    x >>= 1;
+  }
+}
+
+static void  //
+write_empty_dynamic_block(bit_writer* bw, bool extra_entry) {
+  write_bits(bw, 4, 3);  // BFINAL = 0, BTYPE = 2 (dynamic Huffman).
+  write_bits(bw, 0, 5);  // HLIT = 0: there are 257 literal/length codes.
+  write_bits(bw, 1, 5);  // HDIST = 1: there are 2 distance codes.
+  uint32_t n_clen = extra_entry ? 19 : 18;
+  write_bits(bw, n_clen - 4, 4);
+  // The code length code gives 1-bit codes to symbols 1 and 18, which are
+  // at positions 17 and 2 in the code length code order.
+  uint32_t i;
+  for (i = 0; i < n_clen; i++) {
+    write_bits(bw, ((i == 2) || (i == 17)) ? 1 : 0, 3);
+  }
+  // Literal 0 and end-of-block have 1-bit codes, all other literal/length
+  // codes are unused and both distance codes have 1-bit codes.
+  write_bits(bw, 0, 1);         // Literal 0: length 1.
+  write_bits(bw, 1, 1);         // Literals 1 ..= 138: length 0, as a 138-long
+  write_bits(bw, 138 - 11, 7);  // repeat of symbol 18.
+  write_bits(bw, 1, 1);         // Literals 139 ..= 255: length 0, as a
+  write_bits(bw, 117 - 11, 7);  // 117-long repeat of symbol 18.
+  write_bits(bw, 0, 1);         // End-of-block: length 1.
+  write_bits(bw, 0, 1);         // Distance 0: length 1.
+  write_bits(bw, 0, 1);         // Distance 1: length 1.
+  write_bits(bw, 1, 1);         // The block's only code: end-of-block.
+}
+
+static void  //
+write_empty_fixed_block(bit_writer* bw) {
+  write_bits(bw, 2, 3);  // BFINAL = 0, BTYPE = 1 (fixed Huffman).
+  write_bits(bw, 0, 7);  // End-of-block.
+}
+
+typedef struct {
+  // head holds the prefix of empty blocks followed by the rest of the byte
+  // holding the starting bit offset.
+  uint8_t head[24];
+  size_t head_len;
+
+  // ptr and len are the original data, from the byte after head.
+  const uint8_t* ptr;
+  size_t len;
+  size_t boundary;
+  bool is_final;
+} decode_source;
+
+// make_decode_source prepares to decode the data's bits from bit_lo, up to
+// boundary_hi and then continuing up to cont_hi. Bit offsets past
+// data_len_in_bits are clamped.
+static void  //
+make_decode_source(decode_source* s,
+                   const uint8_t* data,
+                   uint64_t data_len_in_bits,
+                   uint64_t bit_lo,
+                   uint64_t boundary_hi,
+                   uint64_t cont_hi) {
+  memset(s, 0, sizeof(*s));
+  if (cont_hi > data_len_in_bits) {
+    cont_hi = data_len_in_bits;
+  }
+  if (boundary_hi > cont_hi) {
+    boundary_hi = cont_hi;
+  }
+  uint64_t i = bit_lo >> 3;
+  uint32_t k = bit_lo & 7;
+  if (k != 0) {
+    bit_writer bw = {s->head, 0};
+    bool extra_entry = (k & 1) != 0;
+    write_empty_dynamic_block(&bw, extra_entry);
+    uint32_t n = (k - (extra_entry ? 7 : 4)) & 7;
+    for (; n > 0; n -= 2) {
+      write_empty_fixed_block(&bw);
+    }
+    write_bits(&bw, data[i] >> k, 8 - k);
+    s->head_len = bw.n_bits >> 3;
+    i++;
+  }
+  s->ptr = data + i;
+  s->len = ((cont_hi + 7) >> 3) - i;
+  s->boundary = ((boundary_hi + 7) >> 3) - i;
+  s->is_final = cont_hi == data_len_in_bits;
+}
+
+typedef struct {
+  uint8_t* ptr;
+  size_t len;
+  size_t cap;
+} growable_buffer;
+
+// g_too_large_msg is the decode error for output exceeding its dst_max.
+static const char* g_too_large_msg = "main: chunk output is too large";
+
+// output_sink lets the first chunk of a round, whose window is known, write
+// out and checksum its output as it is decoded, instead of buffering all of
+// it. Only the last WINDOW_SIZE bytes (and the continuation) stay buffered.
+//
+// If the boundary after the first chunk is rejected, the first chunk is
+// decoded again, further, and the bytes that were already written out are
+// skipped.
+typedef struct {
+  wuffs_crc32__ieee_hasher hasher;
+  // base is the offset, in the chunk's output, of the dst buffer's first byte.
+  size_t base;
+  // flushed is the number of the chunk's output bytes already written out.
+  size_t flushed;
+  const char* write_msg;
+} output_sink;
+
+// flush_output writes out all but the last WINDOW_SIZE bytes of dst, other
+// than those written by a previous decoding, and then moves those last bytes
+// to the start of dst. The remaining WINDOW_SIZE bytes of dst history mean
+// that the deflate decoder never needs its own history ringbuffer.
+static const char*  //
+flush_output(output_sink* sink, growable_buffer* dst) {
+  size_t n = dst->len - WINDOW_SIZE;
+  size_t end = sink->base + n;
+  if (end > sink->flushed) {
+    size_t skip = sink->flushed - sink->base;
+    wuffs_crc32__ieee_hasher__update_u32(
+        &sink->hasher, wuffs_base__make_slice_u8(dst->ptr + skip, n - skip));
+    sink->write_msg = write_to_stdout(dst->ptr + skip, n - skip);
+    if (sink->write_msg) {
+      return sink->write_msg;
+    }
+    sink->flushed = end;
+  }
+  memmove(dst->ptr, dst->ptr + n, WINDOW_SIZE);
+  dst->len = WINDOW_SIZE;
+  sink->base = end;
+  return NULL;
+}
+
+// decode runs a deflate decoder, seeded with the given window, in two phases
+// (after decoding any head).
+//
+// The first phase decodes src's bytes up to src->boundary. Unless that is all
+// of a final src, it has to stop there without reaching the end of the deflate
+// stream. Its output length (relative to the start of dst) is stored in
+// *boundary_dst_len. Its output may not exceed dst_max bytes: with a sink,
+// earlier output is flushed to the sink, otherwise decode fails with
+// g_too_large_msg.
+//
+// The second phase, the continuation, decodes the rest of src, stopping early
+// once dst holds cont_max further bytes. It has to succeed, other than for
+// running out of src. Whether decode failed during the continuation is stored
+// in *failed_in_cont.
+static const char*  //
+decode(growable_buffer* dst,
+       size_t* boundary_dst_len,
+       bool* failed_in_cont,
+       const decode_source* s,
+       size_t cont_max,
+       const uint8_t* window_ptr,
+       size_t window_len,
+       size_t dst_max,
+       output_sink* sink) {
+  *boundary_dst_len = 0;
+  *failed_in_cont = false;
+  wuffs_deflate__decoder* dec = malloc(sizeof__wuffs_deflate__decoder());
+  if (!dec) {
+    return "main: out of memory";
+  }
+  wuffs_base__status status = wuffs_deflate__decoder__initialize(
+      dec, sizeof__wuffs_deflate__decoder(), WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    free(dec);
+    return wuffs_base__status__message(&status);
+  }
+  if (window_len > 0) {
+    wuffs_deflate__decoder__add_history(
+        dec, wuffs_base__make_slice_u8((uint8_t*)window_ptr, window_len));
+  }
+
+  // The phases are 0 (the head), 1 (up to the boundary) and 2 (the
+  // continuation).
+  int phase = 1;
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8((uint8_t*)s->ptr, s->len),
+      wuffs_base__make_io_buffer_meta(s->boundary, 0, 0,
+                                      s->is_final && (s->boundary == s->len)));
+  wuffs_base__io_buffer head = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8((uint8_t*)s->head, s->head_len),
+      wuffs_base__make_io_buffer_meta(s->head_len, 0, 0, false));
+  if (s->head_len > 0) {
+    phase = 0;
+  }
+  uint8_t work_buffer_array[WORK_BUFFER_ARRAY_SIZE > 0 ? WORK_BUFFER_ARRAY_SIZE
+                                                       : 1];
+
+  const char* ret = NULL;
+  bool grow = false;
+  dst->len = 0;
+  while (true) {
+    if (grow || (dst->len == dst->cap)) {
+      grow = false;
+      if ((phase < 2) && (dst->cap >= dst_max)) {
+        if (!sink) {
+          ret = g_too_large_msg;
+          break;
+        }
+        ret = flush_output(sink, dst);
+        if (ret) {
+          break;
+        }
+      } else {
+        size_t new_cap = dst->cap ? (2 * dst->cap) : (1024 * 1024);
+        size_t max_cap = (phase < 2) ? dst_max : (*boundary_dst_len + cont_max);
+        if ((new_cap > max_cap) && (max_cap > dst->cap)) {
+          new_cap = max_cap;
+        }
+        uint8_t* new_ptr = realloc(dst->ptr, new_cap);
+        if (!new_ptr) {
+          ret = "main: out of memory";
+          break;
+        }
+        dst->ptr = new_ptr;
+        dst->cap = new_cap;
+      }
+    }
+    size_t dst_end = dst->cap;
+    if ((phase == 2) && (dst_end > (*boundary_dst_len + cont_max))) {
+      dst_end = *boundary_dst_len + cont_max;
+    }
+    wuffs_base__io_buffer w = wuffs_base__make_io_buffer(
+        wuffs_base__make_slice_u8(dst->ptr, dst_end),
+        wuffs_base__make_io_buffer_meta(dst->len, 0, 0, false));
+    wuffs_base__io_buffer* r = (phase == 0) ? &head : &src;
+    status = wuffs_deflate__decoder__transform_io(
+        dec, &w, r,
+        wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+    dst->len = w.meta.wi;
+
+    if (status.repr == wuffs_base__suspension__short_write) {
+      if (dst_end < dst->cap) {
+        break;
+      }
+      grow = true;
+      continue;
+    } else if (phase == 2) {
+      if ((status.repr != wuffs_base__suspension__short_read) &&
+          (status.repr != NULL)) {
+        ret = wuffs_base__status__message(&status);
+        *failed_in_cont = true;
+      }
+      break;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      if (r->meta.closed) {
+        ret = "main: truncated input";
+        break;
+      } else if (phase == 0) {
+        phase = 1;
+        continue;
+      }
+      *boundary_dst_len = dst->len;
+      if (s->boundary == s->len) {
+        break;
+      }
+      phase = 2;
+      src.meta.wi = s->len;
+      src.meta.closed = s->is_final;
+      continue;
+    } else if (status.repr == NULL) {
+      if (!r->meta.closed) {
+        ret = "main: unexpected end of deflate stream";
+      }
+      *boundary_dst_len = dst->len;
+    } else {
+      ret = wuffs_base__status__message(&status);
+    }
+    break;
+  }
+
+  free(dec);
+  return ret;
+}
+
+// resolve_markers patches a speculatively decoded chunk. Its two decodings, a
+// and b, were seeded with g_window_a and g_window_b. Where they differ, the
+// byte is a reference to the real window, which is the window_len bytes of
+// output immediately before the chunk. The result is written to dst, which
+// may alias a.
+static const char*  //
+resolve_markers(uint8_t* dst,
+                const uint8_t* a,
+                const uint8_t* b,
+                size_t n,
+                const uint8_t* window_ptr,
+                size_t window_len) {
+  const uint8_t* w = window_ptr + window_len - WINDOW_SIZE;
+  size_t i;
+  for (i = 0; i < n; i++) {
+    uint32_t x = a[i] ^ b[i];
+    if (x == 0) {
+      dst[i] = a[i];
+      continue;
+    }
+    uint32_t j = a[i] | ((x - 1) << 8);
+    if (j < (WINDOW_SIZE - window_len)) {
+      return "main: bad back-reference distance";
+    }
+    dst[i] = w[j];
+  }
+  return NULL;
+}
+
+// ---- Rejected boundaries.
+
+// rejected_set is a sorted set of the bit offsets of false positive block
+// boundaries.
+typedef struct {
+  uint64_t* ptr;
+  size_t len;
+  size_t cap;
+} rejected_set;
+
+// rejected_set_lower_bound returns the index of the first element of s that is
+// not less than b.
+static size_t  //
+rejected_set_lower_bound(const rejected_set* s, uint64_t b) {
+  size_t lo = 0;
+  size_t hi = s->len;
+  while (lo < hi) {
+    size_t mid = lo + ((hi - lo) / 2);
+    if (s->ptr[mid] < b) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+static bool  //
+is_rejected(const rejected_set* s, uint64_t b) {
+  size_t i = rejected_set_lower_bound(s, b);
+  return (i < s->len) && (s->ptr[i] == b);
+}
+
+static const char*  //
+insert_rejected(rejected_set* s, uint64_t b) {
+  size_t i = rejected_set_lower_bound(s, b);
+  if ((i < s->len) && (s->ptr[i] == b)) {
+    return NULL;
+  }
+  if (s->len == s->cap) {
+    size_t new_cap = s->cap ? (2 * s->cap) : 64;
+    uint64_t* new_ptr = realloc(s->ptr, new_cap * sizeof(uint64_t));
+    if (!new_ptr) {
+      return "main: out of memory";
+    }
+    s->ptr = new_ptr;
+    s->cap = new_cap;
+  }
+  memmove(s->ptr + i + 1, s->ptr + i, (s->len - i) * sizeof(uint64_t));
+  s->ptr[i] = b;
+  s->len++;
+  return NULL;
+}
+
+// ---- Chunks and threads.
+
+typedef struct {
+  // Inputs.
+  const uint8_t* data;
+  uint64_t data_len;
+  uint64_t scan_lo;
+  uint64_t scan_hi;
+  const rejected_set* rejected;
+  uint64_t bit_lo;
+  uint64_t bit_hi;
+  bool is_first;
+  bool is_last;
+  bool is_probe;
+  const uint8_t* window_ptr;
+  size_t window_len;
+  size_t dst_max;
+
+  // Outputs. The decoded chunk is the first len bytes of dst_a (and, for
+  // speculative decoding, dst_b), less any bytes that the first chunk's sink
+  // has already moved on from. The rest of dst_a and dst_b is the
+  // continuation past bit_hi.
+  growable_buffer dst_a;
+  growable_buffer dst_b;
+  output_sink sink;
+  size_t len;
+  uint32_t checksum;
+  const char* status_msg;
+  bool failed_in_cont;
+} chunk;
+
+// find_boundary_thread_func looks for a candidate block boundary in the bit
+// offsets from scan_lo up to scan_hi.
+static void*  //
+find_boundary_thread_func(void* arg) {
+  chunk* c = (chunk*)arg;
+  c->bit_lo = NO_BOUNDARY;
+  uint64_t data_len_in_bits = c->data_len * 8;
+  uint64_t b_end = c->scan_hi;
+  if (b_end > data_len_in_bits) {
+    b_end = data_len_in_bits;
+  }
+  growable_buffer trial = {0};
+
+  uint64_t b;
+  for (b = c->scan_lo; b < b_end; b++) {
+    // Quickly skip the bit offsets that don't start with the 3 bits for a
+    // dynamic Huffman block and then in-range HLIT and HDIST values.
+    uint64_t i = b >> 3;
+    if ((i + 3) <= c->data_len) {
+      uint32_t x = ((uint32_t)(c->data[i + 0]) << 0) |
+                   ((uint32_t)(c->data[i + 1]) << 8) |
+                   ((uint32_t)(c->data[i + 2]) << 16);
+      x >>= b & 7;
+      if ((((x >> 1) & 3) != 2) || (((x >> 3) & 31) > 29) ||
+          (((x >> 8) & 31) > 29)) {
+        continue;
+      }
+    }
+    bit_reader br = {c->data, data_len_in_bits, b};
+    if (!is_dynamic_block_header(&br) || is_rejected(c->rejected, b)) {
+      continue;
+    }
+
+    decode_source s;
+    make_decode_source(&s, c->data, data_len_in_bits, b, b,
+                       b + (8 * (uint64_t)TRIAL_SIZE));
+    size_t n = 0;
+    bool failed_in_cont = false;
+    const char* z = decode(&trial, &n, &failed_in_cont, &s, 256 * 1024,
+                           g_window_a, WINDOW_SIZE, SIZE_MAX, NULL);
+    if (!z) {
+      c->bit_lo = b;
+      break;
+    }
+  }
+
+  free(trial.ptr);
+  return NULL;
+}
+
+// decode_thread_func decodes a chunk. A probe chunk is a short, speculative
+// decoding of the start of the next round's first chunk.
+static void*  //
+decode_thread_func(void* arg) {
+  chunk* c = (chunk*)arg;
+  uint64_t data_len_in_bits = c->data_len * 8;
+  uint64_t bit_hi = c->is_last ? data_len_in_bits : c->bit_hi;
+  if (c->is_probe) {
+    bit_hi = c->bit_lo;
+  }
+  decode_source s;
+  make_decode_source(&s, c->data, data_len_in_bits, c->bit_lo, bit_hi,
+                     bit_hi + (8 * (uint64_t)TRIAL_SIZE));
+
+  size_t cont_max = 64 * 1024;
+  if (c->is_first) {
+    c->sink.base = 0;
+    c->status_msg = decode(&c->dst_a, &c->len, &c->failed_in_cont, &s, cont_max,
+                           c->window_ptr, c->window_len, c->dst_max, &c->sink);
+    c->len += c->sink.base;
+  } else {
+    c->status_msg = decode(&c->dst_a, &c->len, &c->failed_in_cont, &s, cont_max,
+                           g_window_a, WINDOW_SIZE, c->dst_max, NULL);
+    if (!c->status_msg) {
+      size_t len_b = 0;
+      c->status_msg =
+          decode(&c->dst_b, &len_b, &c->failed_in_cont, &s, cont_max,
+                 g_window_b, WINDOW_SIZE, c->dst_max, NULL);
+      if (!c->status_msg &&
+          ((c->len != len_b) || (c->dst_a.len != c->dst_b.len))) {
+        c->status_msg = "main: inconsistent speculative decoding";
+      }
+    }
+  }
+  if (c->is_probe) {
+    c->len = c->dst_a.len;
+  }
+  return NULL;
+}
+
+// resolve_thread_func patches a chunk and checksums it. The first chunk's
+// sink has already checksummed the output that it wrote out.
+static void*  //
+resolve_thread_func(void* arg) {
+  chunk* c = (chunk*)arg;
+  if (!c->is_first) {
+    c->status_msg = resolve_markers(c->dst_a.ptr, c->dst_a.ptr, c->dst_b.ptr,
+                                    c->len, c->window_ptr, c->window_len);
+    if (c->status_msg) {
+      return NULL;
+    }
+    wuffs_base__status status = wuffs_crc32__ieee_hasher__initialize(
+        &c->sink.hasher, sizeof c->sink.hasher, WUFFS_VERSION,
+        WUFFS_INITIALIZE__DEFAULT_OPTIONS);
+    if (!wuffs_base__status__is_ok(&status)) {
+      c->status_msg = wuffs_base__status__message(&status);
+      return NULL;
+    }
+  }
+  c->checksum = wuffs_crc32__ieee_hasher__update_u32(
+      &c->sink.hasher,
+      wuffs_base__make_slice_u8(c->dst_a.ptr + c->sink.flushed - c->sink.base,
+                                c->len - c->sink.flushed));
+  return NULL;
+}
+
+// run_in_parallel runs f over the n chunks, one thread per chunk.
+static const char*  //
+run_in_parallel(void* (*f)(void*), chunk** chunks, size_t n) {
+  if (n == 1) {
+    f(chunks[0]);
+    return NULL;
+  }
+  pthread_t threads[MAX_THREADS + 1];
+  size_t i;
+  for (i = 0; i < n; i++) {
+    if (pthread_create(&threads[i], NULL, f, chunks[i])) {
+      while (i > 0) {
+        pthread_join(threads[--i], NULL);
+      }
+      return "main: pthread_create failed";
+    }
+  }
+  for (i = 0; i < n; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  return NULL;
+}
+
+// resolve_range writes n bytes of chunk c's output (including any
+// continuation), starting at the given offset, to dst, resolving any markers.
+static const char*  //
+resolve_range(uint8_t* dst, const chunk* c, size_t offset, size_t n) {
+  if (c->is_first) {
+    memcpy(dst, c->dst_a.ptr + offset - c->sink.base, n);
+    return NULL;
+  }
+  return resolve_markers(dst, c->dst_a.ptr + offset, c->dst_b.ptr + offset, n,
+                         c->window_ptr, c->window_len);
+}
+
+// validate_boundary checks that the continuation of chunk c, decoding past
+// its end, matches the start of the following chunk d, decoded from what was
+// assumed to be a block boundary.
+static const char*  //
+validate_boundary(const chunk* c, const chunk* d, bool* ok) {
+  size_t n = c->sink.base + c->dst_a.len - c->len;
+  if (n > d->len) {
+    n = d->len;
+  }
+  *ok = (n > 0) || (d->len == 0);
+  if (!*ok) {
+    return NULL;
+  }
+  uint8_t* buf = malloc(2 * n);
+  if (!buf) {
+    return "main: out of memory";
+  }
+  const char* z = resolve_range(buf, c, c->len, n);
+  if (!z) {
+    z = resolve_range(buf + n, d, 0, n);
+  }
+  *ok = !z && !memcmp(buf, buf + n, n);
+  free(buf);
+  return NULL;
+}
+
+// set_chunk_ends sets the is_last, is_probe and bit_hi fields of a round's
+// n_this_round chunks and of any probe chunk after them.
+static void  //
+set_chunk_ends(chunk* chunks, size_t n_this_round, bool has_probe) {
+  size_t n_decode = n_this_round + (has_probe ? 1 : 0);
+  size_t i;
+  for (i = 0; i < n_decode; i++) {
+    chunks[i].is_last = !has_probe && ((i + 1) == n_this_round);
+    chunks[i].is_probe = has_probe && ((i + 1) == n_decode);
+    chunks[i].bit_hi = (chunks[i].is_last || chunks[i].is_probe)
+                           ? NO_BOUNDARY
+                           : chunks[i + 1].bit_lo;
+  }
+}
+
+// ----
+
+static const char*  //
+decode_deflate_in_parallel(const uint8_t* data,
+                           uint64_t data_len,
+                           uint32_t* checksum,
+                           uint64_t* length) {
+  wuffs_crc32__ieee_hasher h;
+  wuffs_base__status status = wuffs_crc32__ieee_hasher__initialize(
+      &h, sizeof h, WUFFS_VERSION, WUFFS_INITIALIZE__DEFAULT_OPTIONS);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  *checksum = 0;
+
+  // Each chunk has up to two output buffers, so that each buffer's share of
+  // ROUND_OUTPUT_MAX is dst_max.
+  size_t dst_max = ROUND_OUTPUT_MAX / (2 * (size_t)g_flags.threads);
+  if (dst_max < (1024 * 1024)) {
+    dst_max = 1024 * 1024;
+  }
+
+  // The window buffer holds up to 32 KiB of output plus up to another 32 KiB
+  // being appended. The windows buffer holds one window per chunk (plus one for
+  // a probe chunk), as each chunk's window is needed after the window buffer
+  // moves on.
+  uint8_t* window = malloc(2 * WINDOW_SIZE);
+  uint8_t* windows = malloc((MAX_THREADS + 1) * (size_t)WINDOW_SIZE);
+  chunk* chunks = calloc(MAX_THREADS + 1, sizeof(chunk));
+  if (!window || !windows || !chunks) {
+    free(window);
+    free(windows);
+    free(chunks);
+    return "main: out of memory";
+  }
+  chunk* ptrs[MAX_THREADS + 1];
+  bool needs_decode[MAX_THREADS + 1];
+  rejected_set rejected = {0};
+  uint64_t data_len_in_bits = data_len * 8;
+  size_t window_len = 0;
+  const char* ret = NULL;
+  uint64_t bit = 0;
+  bool done = false;
+
+  while (!done && !ret) {
+    // Step 1: find the block boundaries that start the second and subsequent
+    // chunks of this round. After the chunks of this round, unless this round
+    // reaches the end of the data, the next chunk is a probe chunk.
+    memset(chunks, 0, (MAX_THREADS + 1) * sizeof(chunk));
+    chunks[0].bit_lo = bit;
+    chunks[0].is_first = true;
+    size_t m = 1;
+    uint64_t nominal = bit + (8 * (uint64_t)CHUNK_SIZE);
+    while ((m <= g_flags.threads) && (nominal < data_len_in_bits)) {
+      size_t n = m;
+      while ((n <= g_flags.threads) && (nominal < data_len_in_bits)) {
+        chunks[n].data = data;
+        chunks[n].data_len = data_len;
+        chunks[n].scan_lo = nominal;
+        chunks[n].scan_hi = nominal + (8 * (uint64_t)CHUNK_SIZE);
+        chunks[n].rejected = &rejected;
+        ptrs[n - m] = &chunks[n];
+        nominal += 8 * (uint64_t)CHUNK_SIZE;
+        n++;
+      }
+      ret = run_in_parallel(find_boundary_thread_func, ptrs, n - m);
+      // Drop the chunks where no boundary was found, merging them into their
+      // predecessors.
+      size_t i;
+      for (i = m; !ret && (i < n); i++) {
+        if (chunks[i].status_msg) {
+          ret = chunks[i].status_msg;
+        } else if (chunks[i].bit_lo != NO_BOUNDARY) {
+          chunks[m++] = chunks[i];
+        }
+      }
+      if (ret) {
+        break;
+      }
+    }
+    if (ret) {
+      break;
+    }
+
+    size_t n_this_round = (m > g_flags.threads) ? (m - 1) : m;
+    bool has_probe = n_this_round < m;
+    size_t n_decode = n_this_round + (has_probe ? 1 : 0);
+    size_t i;
+    for (i = 0; i < n_decode; i++) {
+      chunks[i].data = data;
+      chunks[i].data_len = data_len;
+      chunks[i].rejected = &rejected;
+      chunks[i].dst_max = dst_max;
+      needs_decode[i] = true;
+    }
+    set_chunk_ends(chunks, n_this_round, has_probe);
+    memcpy(windows, window, window_len);
+    chunks[0].window_ptr = windows;
+    chunks[0].window_len = window_len;
+    status = wuffs_crc32__ieee_hasher__initialize(
+        &chunks[0].sink.hasher, sizeof chunks[0].sink.hasher, WUFFS_VERSION,
+        WUFFS_INITIALIZE__DEFAULT_OPTIONS);
+    if (!wuffs_base__status__is_ok(&status)) {
+      ret = wuffs_base__status__message(&status);
+    }
+
+    // Steps 2, 3 and 4 repeat until every boundary is validated. Each
+    // repetition only decodes the chunks next to a rejected boundary.
+    while (!ret) {
+      // Step 2: decode each chunk, speculatively for all but the first.
+      size_t n_ptrs = 0;
+      for (i = 0; i < n_decode; i++) {
+        if (needs_decode[i]) {
+          needs_decode[i] = false;
+          ptrs[n_ptrs++] = &chunks[i];
+        }
+      }
+      ret = run_in_parallel(decode_thread_func, ptrs, n_ptrs);
+
+      // A failure may mean that a boundary was a false positive. If so, reject
+      // it. A chunk whose output is too large instead ends the round early,
+      // becoming the probe chunk.
+      size_t reject = 0;
+      bool truncated = false;
+      for (i = 0; !ret && (i < n_decode); i++) {
+        const char* z = chunks[i].status_msg;
+        if (!z) {
+          continue;
+        } else if (z == g_too_large_msg) {
+          size_t j;
+          for (j = i + 1; j < n_decode; j++) {
+            free(chunks[j].dst_a.ptr);
+            free(chunks[j].dst_b.ptr);
+          }
+          n_this_round = i;
+          has_probe = true;
+          n_decode = i + 1;
+          set_chunk_ends(chunks, n_this_round, has_probe);
+          needs_decode[i] = true;
+          truncated = true;
+        } else if (chunks[i].is_first && chunks[i].sink.write_msg) {
+          ret = z;
+        } else if (chunks[i].is_probe) {
+          reject = i;
+        } else if (chunks[i].failed_in_cont ||
+                   !strcmp(z, "main: unexpected end of deflate stream")) {
+          reject = i + 1;
+        } else if (i > 0) {
+          reject = i;
+        } else if (n_decode > 1) {
+          // The first chunk's decoding failed. Retry without the boundary
+          // after it, until the first chunk's failure is definitely genuine.
+          reject = 1;
+        } else {
+          ret = z;
+        }
+        break;
+      }
+      if (ret) {
+        break;
+      } else if (truncated) {
+        continue;
+      }
+
+      // Step 3: resolve the windows sequentially, starting from the window at
+      // the start of the round.
+      window_len = chunks[0].window_len;
+      memcpy(window, windows, window_len);
+      for (i = 0; !reject && (i < n_this_round); i++) {
+        if (i > 0) {
+          uint8_t* w = windows + (i * WINDOW_SIZE);
+          memcpy(w, window, window_len);
+          chunks[i].window_ptr = w;
+          chunks[i].window_len = window_len;
+        }
+
+        // Patch this chunk's tail and append it to the window.
+        size_t tail_len = chunks[i].len;
+        if (tail_len > WINDOW_SIZE) {
+          tail_len = WINDOW_SIZE;
+        }
+        ret = resolve_range(window + window_len, &chunks[i],
+                            chunks[i].len - tail_len, tail_len);
+        if (ret) {
+          break;
+        }
+        window_len += tail_len;
+        if (window_len > WINDOW_SIZE) {
+          memmove(window, window + window_len - WINDOW_SIZE, WINDOW_SIZE);
+          window_len = WINDOW_SIZE;
+        }
+      }
+      if (!ret && !reject && has_probe) {
+        uint8_t* w = windows + (n_this_round * WINDOW_SIZE);
+        memcpy(w, window, window_len);
+        chunks[n_this_round].window_ptr = w;
+        chunks[n_this_round].window_len = window_len;
+      }
+
+      // Step 4: check that each boundary is a true boundary.
+      for (i = 0; !ret && !reject && ((i + 1) < n_decode); i++) {
+        bool ok = false;
+        ret = validate_boundary(&chunks[i], &chunks[i + 1], &ok);
+        if (!ok) {
+          reject = i + 1;
+        }
+      }
+      if (ret || !reject) {
+        break;
+      }
+
+      // Look for the rejected chunk's next candidate boundary, after the
+      // rejected one. A probe chunk keeps looking until the end of the data.
+      chunk* c = &chunks[reject];
+      ret = insert_rejected(&rejected, c->bit_lo);
+      if (ret) {
+        break;
+      }
+      c->scan_lo = c->bit_lo + 1;
+      while (true) {
+        find_boundary_thread_func(c);
+        if ((c->bit_lo != NO_BOUNDARY) || !c->is_probe ||
+            (c->scan_hi >= data_len_in_bits)) {
+          break;
+        }
+        c->scan_lo = c->scan_hi;
+        c->scan_hi += 8 * (uint64_t)CHUNK_SIZE;
+      }
+
+      if (c->bit_lo != NO_BOUNDARY) {
+        needs_decode[reject] = true;
+      } else {
+        // Drop the rejected chunk, merging it into its predecessor.
+        free(c->dst_a.ptr);
+        free(c->dst_b.ptr);
+        memmove(c, c + 1, (n_decode - reject - 1) * sizeof(chunk));
+        memmove(needs_decode + reject, needs_decode + reject + 1,
+                (n_decode - reject - 1) * sizeof(bool));
+        if (reject == n_this_round) {
+          has_probe = false;
+        } else {
+          n_this_round--;
+        }
+        n_decode--;
+      }
+      set_chunk_ends(chunks, n_this_round, has_probe);
+      needs_decode[reject - 1] = true;
+    }
+
+    // Step 5: resolve the full chunks in parallel and write them out. The
+    // first chunk's sink has already written out some of its output.
+    for (i = 0; !ret && (i < n_this_round); i++) {
+      ptrs[i] = &chunks[i];
+    }
+    if (!ret) {
+      ret = run_in_parallel(resolve_thread_func, ptrs, n_this_round);
+    }
+    for (i = 0; !ret && (i < n_this_round); i++) {
+      chunk* c = &chunks[i];
+      ret = c->status_msg;
+      if (!ret) {
+        *checksum =
+            wuffs_crc32__ieee_hasher__combine_u32(&h, c->checksum, c->len);
+        *length += c->len;
+        ret = write_to_stdout(c->dst_a.ptr + c->sink.flushed - c->sink.base,
+                              c->len - c->sink.flushed);
+      }
+    }
+
+    if (has_probe) {
+      bit = chunks[n_this_round].bit_lo;
+    } else {
+      done = true;
+    }
+
+    for (i = 0; i < n_decode; i++) {
+      free(chunks[i].dst_a.ptr);
+      free(chunks[i].dst_b.ptr);
+    }
+  }
+
+  free(rejected.ptr);
+  free(chunks);
+  free(windows);
+  free(window);
+  return ret;
+}
+
+// parse_gzip_header returns the length of the gzip header at the start of
+// data, or zero if it is invalid.
+static size_t  //
+parse_gzip_header(const uint8_t* data, size_t data_len) {
+  if ((data_len < 10) || (data[0] != 0x1F) || (data[1] != 0x8B) ||
+      (data[2] != 0x08) || (data[3] & 0xE0)) {
+    return 0;
+  }
+  uint8_t flags = data[3];
+  size_t i = 10;
+  if (flags & 0x04) {  // FEXTRA.
+    if ((data_len - i) < 2) {
+      return 0;
+    }
+    size_t n = data[i] | (data[i + 1] << 8);
+    i += 2;
+    if ((data_len - i) < n) {
+      return 0;
+    }
+    i += n;
+  }
+  int j;
+  for (j = 0; j < 2; j++) {
+    if (flags & (0x08 << j)) {  // FNAME or FCOMMENT.
+      while ((i < data_len) && data[i]) {
+        i++;
+      }
+      if (i >= data_len) {
+        return 0;
+      }
+      i++;
+    }
+  }
+  if (flags & 0x02) {  // FHCRC.
+    if ((data_len - i) < 2) {
+      return 0;
+    }
+    i += 2;
+  }
+  return i;
+}
+
+static const char*  //
+read_all(int fd, uint8_t** ptr, size_t* len) {
+  struct stat st;
+  if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+    void* p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED) {
+      *ptr = p;
+      *len = st.st_size;
+      return NULL;
+    }
+  }
+
+  size_t cap = 0;
+  *ptr = NULL;
+  *len = 0;
+  while (true) {
+    if (*len == cap) {
+      cap = cap ? (2 * cap) : (1024 * 1024);
+      uint8_t* p = realloc(*ptr, cap);
+      if (!p) {
+        return "main: out of memory";
+      }
+      *ptr = p;
+    }
+    ssize_t n = read(fd, *ptr + *len, cap - *len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      return NULL;
+    }
+    *len += n;
+  }
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  }
+
+  int fd = 0;
+  if (g_flags.remaining_argc > 0) {
+    fd = open(g_flags.remaining_argv[0], O_RDONLY);
+    if (fd < 0) {
+      return strerror(errno);
+    }
+  }
+  // The input is deliberately not freed or unmapped. The process is about to
+  // exit.
+  uint8_t* data = NULL;
+  size_t data_len = 0;
+  z = read_all(fd, &data, &data_len);
+  if (z) {
+    return z;
+  }
+
+  size_t header_len = parse_gzip_header(data, data_len);
+  if ((header_len == 0) || ((data_len - header_len) < 8)) {
+    return "main: bad gzip header";
+  }
+  uint8_t* trailer = data + data_len - 8;
+
+  uint32_t i;
+  for (i = 0; i < WINDOW_SIZE; i++) {
+    g_window_a[i] = (uint8_t)i;
+    g_window_b[i] = (uint8_t)(i ^ ((i >> 8) + 1));
+  }
+
+  uint32_t checksum = 0;
+  uint64_t length = 0;
+  z = decode_deflate_in_parallel(data + header_len, data_len - header_len - 8,
+                                 &checksum, &length);
+  if (z) {
+    return z;
+  }
+  if (checksum != wuffs_base__load_u32le__no_bounds_check(trailer)) {
+    return "main: bad checksum";
+  } else if ((uint32_t)length !=
+             wuffs_base__load_u32le__no_bounds_check(trailer + 4)) {
+    return "main: bad length";
+  }
+  return NULL;
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
@@ -149,6 +149,9 @@ main1(int argc, char** argv) {
   if (!wuffs_base__status__is_ok(&status)) {
     return wuffs_base__status__message(&status);
   }
+  // Like gzip's zcat, decode every member of a multi-member gzip file.
+  wuffs_gzip__decoder__set_quirk_enabled(
+      &dec, WUFFS_GZIP__QUIRK_MULTIPLE_MEMBERS, true);
 
   wuffs_base__io_buffer dst;
   dst.data.ptr = g_dst_buffer_array;
@@ -0,0 +1,1925 @@
+#ifndef WUFFS_INCLUDE_GUARD__BMP
+#define WUFFS_INCLUDE_GUARD__BMP
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BMP
+#endif
+
+#include "./wuffs-base.c"
+
+// !! WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Status Codes
+
+extern const char* wuffs_bmp__error__bad_header;
+extern const char* wuffs_bmp__error__unsupported_bmp_file;
+
+// ---------------- Public Consts
+
+#define WUFFS_BMP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_bmp__decoder__struct wuffs_bmp__decoder;
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for initialize_flags.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_bmp__decoder__initialize(wuffs_bmp__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_bmp__decoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_bmp__decoder*  //
+wuffs_bmp__decoder__alloc();
+
+static inline wuffs_base__image_decoder*  //
+wuffs_bmp__decoder__alloc_as__wuffs_base__image_decoder() {
+  return (wuffs_base__image_decoder*)(wuffs_bmp__decoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__image_decoder*  //
+wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(
+    wuffs_bmp__decoder* p) {
+  return (wuffs_base__image_decoder*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_bmp__decoder__set_quirk_enabled(wuffs_bmp__decoder* self,
+                                      uint32_t a_quirk,
+                                      bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__decode_image_config(wuffs_bmp__decoder* self,
+                                        wuffs_base__image_config* a_dst,
+                                        wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__decode_frame_config(wuffs_bmp__decoder* self,
+                                        wuffs_base__frame_config* a_dst,
+                                        wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
+                                 wuffs_base__pixel_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__pixel_blend a_blend,
+                                 wuffs_base__slice_u8 a_workbuf,
+                                 wuffs_base__decode_frame_options* a_opts);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__ack_metadata_chunk(wuffs_bmp__decoder* self,
+                                       wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_bmp__decoder__frame_dirty_rect(const wuffs_bmp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_bmp__decoder__metadata_chunk_length(const wuffs_bmp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_bmp__decoder__metadata_fourcc(const wuffs_bmp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_bmp__decoder__num_animation_loops(const wuffs_bmp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_bmp__decoder__num_decoded_frame_configs(const wuffs_bmp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_bmp__decoder__num_decoded_frames(const wuffs_bmp__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__restart_frame(wuffs_bmp__decoder* self,
+                                  uint64_t a_index,
+                                  uint64_t a_io_position);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_bmp__decoder__set_report_metadata(wuffs_bmp__decoder* self,
+                                        uint32_t a_fourcc,
+                                        bool a_report);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_bmp__decoder__workbuf_len(const wuffs_bmp__decoder* self);
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_bmp__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__image_decoder;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_width;
+    uint32_t f_height;
+    uint8_t f_call_sequence;
+    bool f_top_down;
+    uint8_t f_bits_per_pixel;
+    uint32_t f_pad_per_row;
+    uint64_t f_bytes_per_row;
+    uint64_t f_bytes_total;
+    wuffs_base__pixel_format f_pixfmt;
+    uint32_t f_padding;
+    uint32_t f_mask_r;
+    uint32_t f_mask_g;
+    uint32_t f_mask_b;
+    uint32_t f_mask_a;
+    uint64_t f_frame_config_io_position;
+    uint32_t f_dst_x;
+    uint32_t f_dst_y;
+    uint32_t f_dst_y_end;
+    uint32_t f_dst_y_inc;
+    uint32_t f_scale_log2;
+    uint32_t f_clip_rect_x0;
+    uint32_t f_clip_rect_y0;
+    uint32_t f_clip_rect_x1;
+    uint32_t f_clip_rect_y1;
+    uint64_t f_row_lead_skip;
+    uint64_t f_row_trail_skip;
+    uint64_t f_pending_skip;
+    uint8_t f_stash[4];
+    uint8_t f_num_stashed;
+    wuffs_base__pixel_swizzler f_swizzler;
+
+    uint32_t p_decode_image_config[1];
+    uint32_t p_decode_frame_config[1];
+    uint32_t p_decode_frame[1];
+    uint32_t p_skip_frame[1];
+  } private_impl;
+
+  struct {
+    struct {
+      uint32_t v_bitmap_info_len;
+      uint32_t v_compression;
+      uint64_t scratch;
+    } s_decode_image_config[1];
+    struct {
+      uint64_t v_bytes_remaining;
+      uint64_t scratch;
+    } s_decode_frame[1];
+    struct {
+      uint64_t scratch;
+    } s_skip_frame[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_bmp__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_bmp__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__image_decoder::unique_ptr  //
+  alloc_as__wuffs_base__image_decoder() {
+    return wuffs_base__image_decoder::unique_ptr(
+        wuffs_bmp__decoder__alloc_as__wuffs_base__image_decoder(), &free);
+  }
+#endif  // __cplusplus >= 201103L
+
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_bmp__decoder__struct() = delete;
+  wuffs_bmp__decoder__struct(const wuffs_bmp__decoder__struct&) = delete;
+  wuffs_bmp__decoder__struct& operator=(const wuffs_bmp__decoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_bmp__decoder__initialize(this, sizeof_star_self, wuffs_version,
+                                          initialize_flags);
+  }
+
+  inline wuffs_base__image_decoder*  //
+  upcast_as__wuffs_base__image_decoder() {
+    return (wuffs_base__image_decoder*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_bmp__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__status  //
+  decode_image_config(wuffs_base__image_config* a_dst,
+                      wuffs_base__io_buffer* a_src) {
+    return wuffs_bmp__decoder__decode_image_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status  //
+  decode_frame_config(wuffs_base__frame_config* a_dst,
+                      wuffs_base__io_buffer* a_src) {
+    return wuffs_bmp__decoder__decode_frame_config(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status  //
+  decode_frame(wuffs_base__pixel_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__pixel_blend a_blend,
+               wuffs_base__slice_u8 a_workbuf,
+               wuffs_base__decode_frame_options* a_opts) {
+    return wuffs_bmp__decoder__decode_frame(this, a_dst, a_src, a_blend,
+                                            a_workbuf, a_opts);
+  }
+
+  inline wuffs_base__status  //
+  ack_metadata_chunk(wuffs_base__io_buffer* a_src) {
+    return wuffs_bmp__decoder__ack_metadata_chunk(this, a_src);
+  }
+
+  inline wuffs_base__rect_ie_u32  //
+  frame_dirty_rect() const {
+    return wuffs_bmp__decoder__frame_dirty_rect(this);
+  }
+
+  inline uint64_t  //
+  metadata_chunk_length() const {
+    return wuffs_bmp__decoder__metadata_chunk_length(this);
+  }
+
+  inline uint32_t  //
+  metadata_fourcc() const {
+    return wuffs_bmp__decoder__metadata_fourcc(this);
+  }
+
+  inline uint32_t  //
+  num_animation_loops() const {
+    return wuffs_bmp__decoder__num_animation_loops(this);
+  }
+
+  inline uint64_t  //
+  num_decoded_frame_configs() const {
+    return wuffs_bmp__decoder__num_decoded_frame_configs(this);
+  }
+
+  inline uint64_t  //
+  num_decoded_frames() const {
+    return wuffs_bmp__decoder__num_decoded_frames(this);
+  }
+
+  inline wuffs_base__status  //
+  restart_frame(uint64_t a_index, uint64_t a_io_position) {
+    return wuffs_bmp__decoder__restart_frame(this, a_index, a_io_position);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_report_metadata(uint32_t a_fourcc, bool a_report) {
+    return wuffs_bmp__decoder__set_report_metadata(this, a_fourcc, a_report);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_bmp__decoder__workbuf_len(this);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_bmp__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__BMP)
+
+// ---------------- Status Codes Implementations
+
+const char* wuffs_bmp__error__bad_header = "#bmp: bad header";
+const char* wuffs_bmp__error__unsupported_bmp_file =
+    "#bmp: unsupported BMP file";
+const char* wuffs_bmp__error__internal_error_inconsistent_swizzle_count =
+    "#bmp: internal error: inconsistent swizzle count";
+
+// ---------------- Private Consts
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status  //
+wuffs_bmp__decoder__swizzle(wuffs_bmp__decoder* self,
+                            wuffs_base__pixel_buffer* a_dst,
+                            wuffs_base__slice_u8 a_src);
+
+static wuffs_base__status  //
+wuffs_bmp__decoder__skip_frame(wuffs_bmp__decoder* self,
+                               wuffs_base__io_buffer* a_src);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+    wuffs_bmp__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
+            &wuffs_bmp__decoder__ack_metadata_chunk),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__pixel_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__pixel_blend,
+                               wuffs_base__slice_u8,
+                               wuffs_base__decode_frame_options*))(
+            &wuffs_bmp__decoder__decode_frame),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__frame_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_bmp__decoder__decode_frame_config),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__image_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_bmp__decoder__decode_image_config),
+        (wuffs_base__rect_ie_u32(*)(const void*))(
+            &wuffs_bmp__decoder__frame_dirty_rect),
+        (uint64_t(*)(const void*))(&wuffs_bmp__decoder__metadata_chunk_length),
+        (uint32_t(*)(const void*))(&wuffs_bmp__decoder__metadata_fourcc),
+        (uint32_t(*)(const void*))(&wuffs_bmp__decoder__num_animation_loops),
+        (uint64_t(*)(const void*))(
+            &wuffs_bmp__decoder__num_decoded_frame_configs),
+        (uint64_t(*)(const void*))(&wuffs_bmp__decoder__num_decoded_frames),
+        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
+            &wuffs_bmp__decoder__restart_frame),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_bmp__decoder__set_quirk_enabled),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_bmp__decoder__set_report_metadata),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_bmp__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_bmp__decoder__initialize(wuffs_bmp__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_bmp__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_bmp__decoder*  //
+wuffs_bmp__decoder__alloc() {
+  wuffs_bmp__decoder* x =
+      (wuffs_bmp__decoder*)(calloc(sizeof(wuffs_bmp__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_bmp__decoder__initialize(x, sizeof(wuffs_bmp__decoder),
+                                     WUFFS_VERSION,
+                                     WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_bmp__decoder() {
+  return sizeof(wuffs_bmp__decoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func bmp.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_bmp__decoder__set_quirk_enabled(wuffs_bmp__decoder* self,
+                                      uint32_t a_quirk,
+                                      bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func bmp.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__decode_image_config(wuffs_bmp__decoder* self,
+                                        wuffs_base__image_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_magic = 0;
+  uint32_t v_bitmap_info_len = 0;
+  uint32_t v_width = 0;
+  uint32_t v_height = 0;
+  uint32_t v_planes = 0;
+  uint32_t v_bits_per_pixel = 0;
+  uint32_t v_compression = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  if (coro_susp_point) {
+    v_bitmap_info_len =
+        self->private_data.s_decode_image_config[0].v_bitmap_info_len;
+    v_compression = self->private_data.s_decode_image_config[0].v_compression;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 0) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_magic = t_0;
+    }
+    if (v_magic != 19778) {
+      status = wuffs_base__make_status(wuffs_bmp__error__bad_header);
+      goto exit;
+    }
+    self->private_data.s_decode_image_config[0].scratch = 8;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    if (self->private_data.s_decode_image_config[0].scratch >
+        ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_decode_image_config[0].scratch -=
+          ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_decode_image_config[0].scratch;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_1 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 24) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      self->private_impl.f_padding = t_1;
+    }
+    if (self->private_impl.f_padding < 14) {
+      status = wuffs_base__make_status(wuffs_bmp__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_padding -= 14;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_2 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 24) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      v_bitmap_info_len = t_2;
+    }
+    if ((v_bitmap_info_len != 40) && (v_bitmap_info_len != 108) &&
+        (v_bitmap_info_len != 124)) {
+      status = wuffs_base__make_status(wuffs_bmp__error__unsupported_bmp_file);
+      goto exit;
+    }
+    if (self->private_impl.f_padding < v_bitmap_info_len) {
+      status = wuffs_base__make_status(wuffs_bmp__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_padding -= v_bitmap_info_len;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_3 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+          if (num_bits_3 == 24) {
+            t_3 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3)) << 56;
+        }
+      }
+      v_width = t_3;
+    }
+    if (v_width >= 2147483648) {
+      status = wuffs_base__make_status(wuffs_bmp__error__bad_header);
+      goto exit;
+    }
+    self->private_impl.f_width = v_width;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+      uint32_t t_4;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_4 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+          if (num_bits_4 == 24) {
+            t_4 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_4 += 8;
+          *scratch |= ((uint64_t)(num_bits_4)) << 56;
+        }
+      }
+      v_height = t_4;
+    }
+    if (v_height == 2147483648) {
+      status = wuffs_base__make_status(wuffs_bmp__error__bad_header);
+      goto exit;
+    } else if (v_height >= 2147483648) {
+      self->private_impl.f_height = ((0 - v_height) & 2147483647);
+      self->private_impl.f_top_down = true;
+    } else {
+      self->private_impl.f_height = v_height;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+      uint32_t t_5;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_5 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_5 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_5;
+          if (num_bits_5 == 8) {
+            t_5 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_5 += 8;
+          *scratch |= ((uint64_t)(num_bits_5)) << 56;
+        }
+      }
+      v_planes = t_5;
+    }
+    if (v_planes != 1) {
+      status = wuffs_base__make_status(wuffs_bmp__error__unsupported_bmp_file);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+      uint32_t t_6;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_6 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_6 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_6;
+          if (num_bits_6 == 8) {
+            t_6 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_6 += 8;
+          *scratch |= ((uint64_t)(num_bits_6)) << 56;
+        }
+      }
+      v_bits_per_pixel = t_6;
+    }
+    if (v_bits_per_pixel == 24) {
+      self->private_impl.f_bits_per_pixel = 24;
+      self->private_impl.f_bytes_per_row =
+          ((((((uint64_t)(self->private_impl.f_width)) * 3) + 3) >> 2) << 2);
+      self->private_impl.f_pad_per_row = (self->private_impl.f_width & 3);
+      self->private_impl.f_pixfmt =
+          wuffs_base__utility__make_pixel_format(1073744008);
+    } else if (v_bits_per_pixel == 32) {
+      self->private_impl.f_bits_per_pixel = 32;
+      self->private_impl.f_bytes_per_row =
+          (((uint64_t)(self->private_impl.f_width)) * 4);
+      self->private_impl.f_pad_per_row = 0;
+      self->private_impl.f_pixfmt =
+          wuffs_base__utility__make_pixel_format(1157662856);
+    } else {
+      status = wuffs_base__make_status(wuffs_bmp__error__unsupported_bmp_file);
+      goto exit;
+    }
+    self->private_impl.f_bytes_total =
+        (self->private_impl.f_bytes_per_row *
+         ((uint64_t)(self->private_impl.f_height)));
+    self->private_impl.f_clip_rect_x1 = self->private_impl.f_width;
+    self->private_impl.f_clip_rect_y1 = self->private_impl.f_height;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+      uint32_t t_7;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_7 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_image_config[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_image_config[0].scratch;
+          uint32_t num_bits_7 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_7;
+          if (num_bits_7 == 24) {
+            t_7 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_7 += 8;
+          *scratch |= ((uint64_t)(num_bits_7)) << 56;
+        }
+      }
+      v_compression = t_7;
+    }
+    self->private_data.s_decode_image_config[0].scratch = 20;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+    if (self->private_data.s_decode_image_config[0].scratch >
+        ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_decode_image_config[0].scratch -=
+          ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_decode_image_config[0].scratch;
+    if (v_bitmap_info_len >= 108) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(19);
+        uint32_t t_8;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_8 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(20);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch =
+                &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
+            if (num_bits_8 == 24) {
+              t_8 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_8 += 8;
+            *scratch |= ((uint64_t)(num_bits_8)) << 56;
+          }
+        }
+        self->private_impl.f_mask_r = t_8;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(21);
+        uint32_t t_9;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_9 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(22);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch =
+                &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_9 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_9;
+            if (num_bits_9 == 24) {
+              t_9 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_9 += 8;
+            *scratch |= ((uint64_t)(num_bits_9)) << 56;
+          }
+        }
+        self->private_impl.f_mask_g = t_9;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(23);
+        uint32_t t_10;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_10 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(24);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch =
+                &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_10 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_10;
+            if (num_bits_10 == 24) {
+              t_10 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_10 += 8;
+            *scratch |= ((uint64_t)(num_bits_10)) << 56;
+          }
+        }
+        self->private_impl.f_mask_b = t_10;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(25);
+        uint32_t t_11;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_11 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_decode_image_config[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(26);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch =
+                &self->private_data.s_decode_image_config[0].scratch;
+            uint32_t num_bits_11 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_11;
+            if (num_bits_11 == 24) {
+              t_11 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_11 += 8;
+            *scratch |= ((uint64_t)(num_bits_11)) << 56;
+          }
+        }
+        self->private_impl.f_mask_a = t_11;
+      }
+      if ((v_compression == 3) && (self->private_impl.f_mask_r == 16711680) &&
+          (self->private_impl.f_mask_g == 65280) &&
+          (self->private_impl.f_mask_b == 255) &&
+          (self->private_impl.f_mask_a == 4278190080)) {
+        v_compression = 0;
+      }
+      self->private_data.s_decode_image_config[0].scratch =
+          (v_bitmap_info_len - 56);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(27);
+      if (self->private_data.s_decode_image_config[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_image_config[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_image_config[0].scratch;
+    }
+    if (v_compression != 0) {
+      status = wuffs_base__make_status(wuffs_bmp__error__unsupported_bmp_file);
+      goto exit;
+    }
+    self->private_impl.f_frame_config_io_position = wuffs_base__u64__sat_add(
+        a_src->meta.pos, ((uint64_t)(iop_a_src - io0_a_src)));
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst, 1157662856, 0, self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position, true);
+    }
+    self->private_impl.f_call_sequence = 1;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_image_config[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_decode_image_config[0].v_bitmap_info_len =
+      v_bitmap_info_len;
+  self->private_data.s_decode_image_config[0].v_compression = v_compression;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func bmp.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__decode_frame_config(wuffs_bmp__decoder* self,
+                                        wuffs_base__frame_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 1) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_bmp__decoder__decode_image_config(self, NULL, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 1) {
+      if (self->private_impl.f_frame_config_io_position !=
+          wuffs_base__u64__sat_add(a_src->meta.pos,
+                                   ((uint64_t)(iop_a_src - io0_a_src)))) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+        goto exit;
+      }
+    } else if (self->private_impl.f_call_sequence == 2) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_bmp__decoder__skip_frame(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__update(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+              0, 0, self->private_impl.f_width, self->private_impl.f_height),
+          ((wuffs_base__flicks)(0)), 0,
+          self->private_impl.f_frame_config_io_position, 0, true, false,
+          4278190080);
+    }
+    self->private_impl.f_call_sequence = 2;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_frame_config[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_frame_config[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func bmp.decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
+                                 wuffs_base__pixel_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__pixel_blend a_blend,
+                                 wuffs_base__slice_u8 a_workbuf,
+                                 wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__rect_ie_u32 v_clip = {0};
+  uint64_t v_src_bytes_per_pixel = 0;
+  uint64_t v_bytes_remaining = 0;
+  uint64_t v_n = 0;
+  wuffs_base__slice_u8 v_src = {0};
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  if (coro_susp_point) {
+    v_bytes_remaining = self->private_data.s_decode_frame[0].v_bytes_remaining;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence < 2) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_bmp__decoder__decode_frame_config(self, NULL, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence == 2) {
+    } else {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    self->private_impl.f_scale_log2 = 0;
+    if (a_opts != NULL) {
+      v_clip = wuffs_base__decode_frame_options__dst_clip_rect(a_opts);
+      self->private_impl.f_scale_log2 =
+          wuffs_base__decode_frame_options__scale_log2(a_opts);
+    } else {
+      v_clip =
+          wuffs_base__utility__make_rect_ie_u32(0, 0, 4294967295, 4294967295);
+    }
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_width)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_height)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_clip_rect_x1)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_clip_rect_y1)))));
+    self->private_data.s_decode_frame[0].scratch = self->private_impl.f_padding;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (self->private_data.s_decode_frame[0].scratch >
+        ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_decode_frame[0].scratch -=
+          ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_decode_frame[0].scratch;
+    if ((self->private_impl.f_clip_rect_x0 <
+         self->private_impl.f_clip_rect_x1) &&
+        (self->private_impl.f_clip_rect_y0 <
+         self->private_impl.f_clip_rect_y1)) {
+      if (self->private_impl.f_top_down) {
+        self->private_impl.f_dst_y = self->private_impl.f_clip_rect_y0;
+        self->private_impl.f_dst_y_end = self->private_impl.f_clip_rect_y1;
+        self->private_impl.f_dst_y_inc = 1;
+        v_n = ((uint64_t)(self->private_impl.f_clip_rect_y0));
+      } else {
+        self->private_impl.f_dst_y = (self->private_impl.f_clip_rect_y1 - 1);
+        self->private_impl.f_dst_y_end =
+            (self->private_impl.f_clip_rect_y0 - 1);
+        self->private_impl.f_dst_y_inc = 4294967295;
+        v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+            self->private_impl.f_height, self->private_impl.f_clip_rect_y1)));
+      }
+      self->private_data.s_decode_frame[0].scratch =
+          (self->private_impl.f_bytes_per_row * v_n);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (self->private_data.s_decode_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_frame[0].scratch;
+      v_src_bytes_per_pixel =
+          ((uint64_t)((self->private_impl.f_bits_per_pixel / 8)));
+      self->private_impl.f_row_lead_skip =
+          (((uint64_t)(self->private_impl.f_clip_rect_x0)) *
+           v_src_bytes_per_pixel);
+      self->private_impl.f_row_trail_skip =
+          ((((uint64_t)(wuffs_base__u32__sat_sub(
+                self->private_impl.f_width,
+                self->private_impl.f_clip_rect_x1))) *
+            v_src_bytes_per_pixel) +
+           ((uint64_t)(self->private_impl.f_pad_per_row)));
+      self->private_impl.f_dst_x = self->private_impl.f_clip_rect_x0;
+      self->private_impl.f_pending_skip = self->private_impl.f_row_lead_skip;
+      self->private_impl.f_num_stashed = 0;
+      v_status = wuffs_base__pixel_swizzler__prepare(
+          &self->private_impl.f_swizzler,
+          wuffs_base__pixel_buffer__pixel_format(a_dst),
+          wuffs_base__pixel_buffer__palette(a_dst), self->private_impl.f_pixfmt,
+          wuffs_base__utility__empty_slice_u8(), a_blend);
+      if (!wuffs_base__status__is_ok(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      v_bytes_remaining = (self->private_impl.f_bytes_per_row *
+                           ((uint64_t)(wuffs_base__u32__sat_sub(
+                               self->private_impl.f_clip_rect_y1,
+                               self->private_impl.f_clip_rect_y0))));
+      while (true) {
+        v_n = ((uint64_t)(io2_a_src - iop_a_src));
+        if (v_bytes_remaining >= v_n) {
+          v_bytes_remaining -= v_n;
+        } else {
+          v_n = v_bytes_remaining;
+          v_bytes_remaining = 0;
+        }
+        v_src = wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_n);
+        v_status = wuffs_bmp__decoder__swizzle(self, a_dst, v_src);
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__0__break;
+        } else if (wuffs_base__status__is_suspension(&v_status)) {
+          status = v_status;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        } else {
+          status = v_status;
+          if (wuffs_base__status__is_error(&status)) {
+            goto exit;
+          } else if (wuffs_base__status__is_suspension(&status)) {
+            status = wuffs_base__make_status(
+                wuffs_base__error__cannot_return_a_suspension);
+            goto exit;
+          }
+          goto ok;
+        }
+      }
+    label__0__break:;
+      if (self->private_impl.f_top_down) {
+        v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+            self->private_impl.f_height, self->private_impl.f_clip_rect_y1)));
+      } else {
+        v_n = ((uint64_t)(self->private_impl.f_clip_rect_y0));
+      }
+      self->private_data.s_decode_frame[0].scratch =
+          (self->private_impl.f_bytes_per_row * v_n);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_decode_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_frame[0].scratch;
+    } else {
+      self->private_data.s_decode_frame[0].scratch =
+          self->private_impl.f_bytes_total;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (self->private_data.s_decode_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_frame[0].scratch;
+    }
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_frame[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame[0].v_bytes_remaining = v_bytes_remaining;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func bmp.decoder.swizzle
+
+static wuffs_base__status  //
+wuffs_bmp__decoder__swizzle(wuffs_bmp__decoder* self,
+                            wuffs_base__pixel_buffer* a_dst,
+                            wuffs_base__slice_u8 a_src) {
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  uint64_t v_dst_bytes_per_row = 0;
+  uint8_t v_src_bytes_per_pixel = 0;
+  uint32_t v_scale_mask = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  uint64_t v_i = 0;
+  uint64_t v_n = 0;
+
+  v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+  v_dst_bits_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+  if ((v_dst_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+  v_scale_mask = ((((uint32_t)(1)) << self->private_impl.f_scale_log2) - 1);
+  v_dst_bytes_per_row = (((((uint64_t)(self->private_impl.f_clip_rect_x1)) +
+                           ((uint64_t)(v_scale_mask))) >>
+                          self->private_impl.f_scale_log2) *
+                         v_dst_bytes_per_pixel);
+  v_src_bytes_per_pixel =
+      ((uint8_t)((self->private_impl.f_bits_per_pixel / 8)));
+  v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+  if (self->private_impl.f_pending_skip > 0) {
+    v_n = self->private_impl.f_pending_skip;
+    if (v_n <= ((uint64_t)(a_src.len))) {
+      a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
+      self->private_impl.f_pending_skip = 0;
+    } else {
+      self->private_impl.f_pending_skip = (v_n - ((uint64_t)(a_src.len)));
+      return wuffs_base__make_status(wuffs_base__suspension__short_read);
+    }
+  }
+  if (self->private_impl.f_num_stashed != 0) {
+    while (self->private_impl.f_num_stashed < v_src_bytes_per_pixel) {
+      if (((uint64_t)(a_src.len)) <= 0) {
+        return wuffs_base__make_status(wuffs_base__suspension__short_read);
+      }
+      self->private_impl.f_stash[self->private_impl.f_num_stashed] =
+          a_src.ptr[0];
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+      self->private_impl.f_num_stashed += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      a_src = wuffs_base__slice_u8__subslice_i(a_src, 1);
+    }
+    if (((self->private_impl.f_dst_x & v_scale_mask) == 0) &&
+        ((self->private_impl.f_dst_y & v_scale_mask) == 0)) {
+      v_dst = wuffs_base__table_u8__row(
+          v_tab,
+          (self->private_impl.f_dst_y >> self->private_impl.f_scale_log2));
+      if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
+        v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
+      }
+      v_i = (((uint64_t)((self->private_impl.f_dst_x >>
+                          self->private_impl.f_scale_log2))) *
+             v_dst_bytes_per_pixel);
+      if (v_i < ((uint64_t)(v_dst.len))) {
+        wuffs_base__pixel_swizzler__swizzle_interleaved(
+            &self->private_impl.f_swizzler,
+            wuffs_base__slice_u8__subslice_i(v_dst, v_i),
+            wuffs_base__utility__empty_slice_u8(),
+            wuffs_base__slice_u8__subslice_j(
+                wuffs_base__make_slice_u8(self->private_impl.f_stash, 4),
+                self->private_impl.f_num_stashed));
+      }
+    }
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x, 1);
+    self->private_impl.f_num_stashed = 0;
+  }
+label__0__continue:;
+  while (true) {
+    if (self->private_impl.f_dst_x >= self->private_impl.f_clip_rect_x1) {
+      self->private_impl.f_dst_x = self->private_impl.f_clip_rect_x0;
+      self->private_impl.f_dst_y += self->private_impl.f_dst_y_inc;
+      v_n = self->private_impl.f_row_trail_skip;
+      if (self->private_impl.f_dst_y != self->private_impl.f_dst_y_end) {
+        v_n += self->private_impl.f_row_lead_skip;
+      }
+      if (v_n <= ((uint64_t)(a_src.len))) {
+        a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
+      } else {
+        self->private_impl.f_pending_skip = (v_n - ((uint64_t)(a_src.len)));
+        return wuffs_base__make_status(wuffs_base__suspension__short_read);
+      }
+    }
+    if (self->private_impl.f_dst_y == self->private_impl.f_dst_y_end) {
+      goto label__0__break;
+    }
+    v_dst = wuffs_base__table_u8__row(
+        v_tab, (self->private_impl.f_dst_y >> self->private_impl.f_scale_log2));
+    if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
+    }
+    v_i = (((uint64_t)((self->private_impl.f_dst_x >>
+                        self->private_impl.f_scale_log2))) *
+           v_dst_bytes_per_pixel);
+    if (v_i <= ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
+    } else {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
+    }
+    if (((self->private_impl.f_dst_y & v_scale_mask) != 0) ||
+        (((uint64_t)(v_dst.len)) < v_dst_bytes_per_pixel)) {
+      v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+          self->private_impl.f_clip_rect_x1, self->private_impl.f_dst_x)));
+    } else if ((self->private_impl.f_dst_x & v_scale_mask) != 0) {
+      v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+          wuffs_base__u32__sat_add((self->private_impl.f_dst_x | v_scale_mask),
+                                   1),
+          self->private_impl.f_dst_x)));
+      v_n = wuffs_base__u64__min(
+          v_n,
+          ((uint64_t)(wuffs_base__u32__sat_sub(
+              self->private_impl.f_clip_rect_x1, self->private_impl.f_dst_x))));
+    } else {
+      v_n = 0;
+    }
+    if (v_n > 0) {
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
+                                        ((uint32_t)((v_n & 4294967295))));
+      v_n = ((v_n & 4294967295) * ((uint64_t)(v_src_bytes_per_pixel)));
+      if (v_n <= ((uint64_t)(a_src.len))) {
+        a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
+      } else {
+        self->private_impl.f_pending_skip = (v_n - ((uint64_t)(a_src.len)));
+        return wuffs_base__make_status(wuffs_base__suspension__short_read);
+      }
+      goto label__0__continue;
+    }
+    v_src = a_src;
+    v_n =
+        (((uint64_t)(wuffs_base__u32__sat_sub(self->private_impl.f_clip_rect_x1,
+                                              self->private_impl.f_dst_x))) *
+         ((uint64_t)(v_src_bytes_per_pixel)));
+    if (v_n < ((uint64_t)(v_src.len))) {
+      v_src = wuffs_base__slice_u8__subslice_j(v_src, v_n);
+    }
+    v_n = wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+        &self->private_impl.f_swizzler, v_dst,
+        wuffs_base__utility__empty_slice_u8(), v_src, (v_scale_mask + 1));
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
+                                      ((uint32_t)((v_n & 4294967295))));
+    v_n = ((v_n & 4294967295) * ((uint64_t)(v_src_bytes_per_pixel)));
+    if (v_n <= ((uint64_t)(a_src.len))) {
+      a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
+    } else {
+      return wuffs_base__make_status(
+          wuffs_bmp__error__internal_error_inconsistent_swizzle_count);
+    }
+    if (self->private_impl.f_dst_x < self->private_impl.f_clip_rect_x1) {
+      if (((uint64_t)(a_src.len)) >= ((uint64_t)(v_src_bytes_per_pixel))) {
+        if (v_n == 0) {
+          return wuffs_base__make_status(
+              wuffs_bmp__error__internal_error_inconsistent_swizzle_count);
+        }
+        goto label__0__continue;
+      }
+      while ((self->private_impl.f_num_stashed < v_src_bytes_per_pixel) &&
+             (((uint64_t)(a_src.len)) > 0)) {
+        self->private_impl.f_stash[self->private_impl.f_num_stashed] =
+            a_src.ptr[0];
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        self->private_impl.f_num_stashed += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        a_src = wuffs_base__slice_u8__subslice_i(a_src, 1);
+      }
+      return wuffs_base__make_status(wuffs_base__suspension__short_read);
+    }
+  }
+label__0__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func bmp.decoder.skip_frame
+
+static wuffs_base__status  //
+wuffs_bmp__decoder__skip_frame(wuffs_bmp__decoder* self,
+                               wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_data.s_skip_frame[0].scratch = self->private_impl.f_padding;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (self->private_data.s_skip_frame[0].scratch >
+        ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_skip_frame[0].scratch -=
+          ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    self->private_data.s_skip_frame[0].scratch =
+        self->private_impl.f_bytes_total;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (self->private_data.s_skip_frame[0].scratch >
+        ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_skip_frame[0].scratch -=
+          ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    self->private_impl.f_call_sequence = 3;
+
+    goto ok;
+  ok:
+    self->private_impl.p_skip_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_skip_frame[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func bmp.decoder.ack_metadata_chunk
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__ack_metadata_chunk(wuffs_bmp__decoder* self,
+                                       wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  status = wuffs_base__make_status(NULL);
+  goto ok;
+  goto ok;
+ok:
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func bmp.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_bmp__decoder__frame_dirty_rect(const wuffs_bmp__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  uint64_t v_scale_mask = 0;
+
+  v_scale_mask = ((((uint64_t)(1)) << self->private_impl.f_scale_log2) - 1);
+  return wuffs_base__utility__make_rect_ie_u32(
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_x0)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_y0)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_x1)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_y1)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))));
+}
+
+// -------- func bmp.decoder.metadata_chunk_length
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_bmp__decoder__metadata_chunk_length(const wuffs_bmp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return 0;
+}
+
+// -------- func bmp.decoder.metadata_fourcc
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_bmp__decoder__metadata_fourcc(const wuffs_bmp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return 0;
+}
+
+// -------- func bmp.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_bmp__decoder__num_animation_loops(const wuffs_bmp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return 0;
+}
+
+// -------- func bmp.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_bmp__decoder__num_decoded_frame_configs(const wuffs_bmp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 1) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func bmp.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_bmp__decoder__num_decoded_frames(const wuffs_bmp__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_call_sequence > 2) {
+    return 1;
+  }
+  return 0;
+}
+
+// -------- func bmp.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_bmp__decoder__restart_frame(wuffs_bmp__decoder* self,
+                                  uint64_t a_index,
+                                  uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  if (a_index != 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  self->private_impl.f_call_sequence = 1;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func bmp.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_bmp__decoder__set_report_metadata(wuffs_bmp__decoder* self,
+                                        uint32_t a_fourcc,
+                                        bool a_report) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func bmp.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_bmp__decoder__workbuf_len(const wuffs_bmp__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__BMP)
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// !! WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__BMP
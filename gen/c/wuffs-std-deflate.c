@@ -0,0 +1,4537 @@
+#ifndef WUFFS_INCLUDE_GUARD__DEFLATE
+#define WUFFS_INCLUDE_GUARD__DEFLATE
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#endif
+
+#include "./wuffs-base.c"
+
+// !! WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Status Codes
+
+extern const char* wuffs_deflate__error__bad_huffman_code_over_subscribed;
+extern const char* wuffs_deflate__error__bad_huffman_code_under_subscribed;
+extern const char* wuffs_deflate__error__bad_huffman_code_length_count;
+extern const char* wuffs_deflate__error__bad_huffman_code_length_repetition;
+extern const char* wuffs_deflate__error__bad_huffman_code;
+extern const char* wuffs_deflate__error__bad_huffman_minimum_code_length;
+extern const char* wuffs_deflate__error__bad_block;
+extern const char* wuffs_deflate__error__bad_distance;
+extern const char* wuffs_deflate__error__bad_distance_code_count;
+extern const char* wuffs_deflate__error__bad_literal_length_code_count;
+extern const char* wuffs_deflate__error__inconsistent_stored_block_length;
+extern const char* wuffs_deflate__error__missing_end_of_block_code;
+extern const char* wuffs_deflate__error__no_huffman_codes;
+
+// ---------------- Public Consts
+
+#define WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
+
+#define WUFFS_DEFLATE__QUIRK_CONTIGUOUS_DST 867177472
+
+#define WUFFS_DEFLATE__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_DEFLATE__ENCODER_DEFAULT_LEVEL 6
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_deflate__decoder__struct wuffs_deflate__decoder;
+
+typedef struct wuffs_deflate__encoder__struct wuffs_deflate__encoder;
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for initialize_flags.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_deflate__decoder();
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_deflate__encoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_deflate__decoder*  //
+wuffs_deflate__decoder__alloc();
+
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__decoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_deflate__decoder__alloc());
+}
+
+wuffs_deflate__encoder*  //
+wuffs_deflate__encoder__alloc();
+
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__encoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_deflate__encoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__decoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__decoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
+                                    wuffs_base__slice_u8 a_hist);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_quirk_enabled(wuffs_deflate__decoder* self,
+                                          uint32_t a_quirk,
+                                          bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__prime(wuffs_deflate__decoder* self,
+                              uint32_t a_bits,
+                              uint32_t a_n_bits);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_src_bit_position(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_dst_position(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__decoder__workbuf_len(const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_quirk_enabled(wuffs_deflate__encoder* self,
+                                          uint32_t a_quirk,
+                                          bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self,
+                                  uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf);
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_deflate__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_history_index;
+    uint32_t f_n_huffs_bits[2];
+    bool f_end_of_block;
+    uint64_t f_block_start_src_bit_pos;
+    uint64_t f_block_start_dst_pos;
+    bool f_quirks[1];
+
+    uint32_t p_transform_io[1];
+    uint32_t p_decode_blocks[1];
+    uint32_t p_decode_uncompressed[1];
+    uint32_t p_init_dynamic_huffman[1];
+    uint32_t p_decode_huffman_slow[1];
+  } private_impl;
+
+  struct {
+    uint32_t f_huffs[2][2048];
+    uint8_t f_history[33025];
+    uint8_t f_code_lengths[320];
+
+    struct {
+      uint32_t v_final;
+    } s_decode_blocks[1];
+    struct {
+      uint32_t v_length;
+      uint64_t scratch;
+    } s_decode_uncompressed[1];
+    struct {
+      uint32_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_n_lit;
+      uint32_t v_n_dist;
+      uint32_t v_n_clen;
+      uint32_t v_i;
+      uint32_t v_mask;
+      uint32_t v_table_entry;
+      uint32_t v_n_extra_bits;
+      uint8_t v_rep_symbol;
+      uint32_t v_rep_count;
+    } s_init_dynamic_huffman[1];
+    struct {
+      uint32_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_table_entry;
+      uint32_t v_table_entry_n_bits;
+      uint32_t v_lmask;
+      uint32_t v_dmask;
+      uint32_t v_redir_top;
+      uint32_t v_redir_mask;
+      uint32_t v_length;
+      uint32_t v_dist_minus_1;
+      uint32_t v_hlen;
+      uint32_t v_hdist;
+      uint64_t scratch;
+    } s_decode_huffman_slow[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_deflate__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_deflate__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr  //
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_deflate__decoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // __cplusplus >= 201103L
+
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__decoder__struct() = delete;
+  wuffs_deflate__decoder__struct(const wuffs_deflate__decoder__struct&) =
+      delete;
+  wuffs_deflate__decoder__struct& operator=(
+      const wuffs_deflate__decoder__struct&) = delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_deflate__decoder__initialize(this, sizeof_star_self,
+                                              wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  add_history(wuffs_base__slice_u8 a_hist) {
+    return wuffs_deflate__decoder__add_history(this, a_hist);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_deflate__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct  //
+  prime(uint32_t a_bits, uint32_t a_n_bits) {
+    return wuffs_deflate__decoder__prime(this, a_bits, a_n_bits);
+  }
+
+  inline uint64_t  //
+  block_start_src_bit_position() const {
+    return wuffs_deflate__decoder__block_start_src_bit_position(this);
+  }
+
+  inline uint64_t  //
+  block_start_dst_position() const {
+    return wuffs_deflate__decoder__block_start_dst_position(this);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_deflate__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_deflate__decoder__struct
+
+struct wuffs_deflate__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_set_level_arg;
+    uint32_t f_level;
+    uint32_t f_good_length;
+    uint32_t f_max_lazy;
+    uint32_t f_nice_length;
+    uint32_t f_max_chain;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_strstart;
+    uint32_t f_w_end;
+    uint32_t f_match_length;
+    uint32_t f_match_distance;
+    bool f_match_available;
+    uint32_t f_n_syms;
+    uint32_t f_block_len;
+    uint32_t f_hlit_minus_257;
+    uint32_t f_hdist_minus_1;
+    uint32_t f_hclen_minus_4;
+    uint32_t f_n_cl_syms;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_write_bits[1];
+    uint32_t p_write_block[1];
+    uint32_t p_write_syms[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_window[65808];
+    uint16_t f_head[32768];
+    uint16_t f_prev[32768];
+    uint32_t f_syms[16384];
+    uint32_t f_freqs[512];
+    uint8_t f_lens[512];
+    uint16_t f_codes[512];
+    uint16_t f_cl_syms[320];
+    uint32_t f_h_keys[512];
+    uint32_t f_h_depths[512];
+    uint32_t f_h_counts[16];
+    uint32_t f_h_next_codes[16];
+
+    struct {
+      uint64_t scratch;
+    } s_write_bits[1];
+    struct {
+      uint32_t v_block_end;
+      uint32_t v_block_start;
+      uint32_t v_type;
+      uint32_t v_header;
+      uint32_t v_i;
+      uint32_t v_x;
+      uint64_t scratch;
+    } s_write_block[1];
+    struct {
+      uint64_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_i;
+      uint32_t v_x;
+      uint64_t scratch;
+    } s_write_syms[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_deflate__encoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_deflate__encoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr  //
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_deflate__encoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // __cplusplus >= 201103L
+
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__encoder__struct() = delete;
+  wuffs_deflate__encoder__struct(const wuffs_deflate__encoder__struct&) =
+      delete;
+  wuffs_deflate__encoder__struct& operator=(
+      const wuffs_deflate__encoder__struct&) = delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_deflate__encoder__initialize(this, sizeof_star_self,
+                                              wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_deflate__encoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_level) {
+    return wuffs_deflate__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_deflate__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_deflate__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__DEFLATE)
+
+// ---------------- Status Codes Implementations
+
+const char* wuffs_deflate__error__bad_huffman_code_over_subscribed =
+    "#deflate: bad Huffman code (over-subscribed)";
+const char* wuffs_deflate__error__bad_huffman_code_under_subscribed =
+    "#deflate: bad Huffman code (under-subscribed)";
+const char* wuffs_deflate__error__bad_huffman_code_length_count =
+    "#deflate: bad Huffman code length count";
+const char* wuffs_deflate__error__bad_huffman_code_length_repetition =
+    "#deflate: bad Huffman code length repetition";
+const char* wuffs_deflate__error__bad_huffman_code =
+    "#deflate: bad Huffman code";
+const char* wuffs_deflate__error__bad_huffman_minimum_code_length =
+    "#deflate: bad Huffman minimum code length";
+const char* wuffs_deflate__error__bad_block = "#deflate: bad block";
+const char* wuffs_deflate__error__bad_distance = "#deflate: bad distance";
+const char* wuffs_deflate__error__bad_distance_code_count =
+    "#deflate: bad distance code count";
+const char* wuffs_deflate__error__bad_literal_length_code_count =
+    "#deflate: bad literal/length code count";
+const char* wuffs_deflate__error__inconsistent_stored_block_length =
+    "#deflate: inconsistent stored block length";
+const char* wuffs_deflate__error__missing_end_of_block_code =
+    "#deflate: missing end-of-block code";
+const char* wuffs_deflate__error__no_huffman_codes =
+    "#deflate: no Huffman codes";
+const char*
+    wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state =
+        "#deflate: internal error: inconsistent Huffman decoder state";
+const char* wuffs_deflate__error__internal_error_inconsistent_i_o =
+    "#deflate: internal error: inconsistent I/O";
+const char* wuffs_deflate__error__internal_error_inconsistent_distance =
+    "#deflate: internal error: inconsistent distance";
+const char* wuffs_deflate__error__internal_error_inconsistent_n_bits =
+    "#deflate: internal error: inconsistent n_bits";
+const char* wuffs_deflate__error__internal_error_inconsistent_encoder_state =
+    "#deflate: internal error: inconsistent encoder state";
+
+// ---------------- Private Consts
+
+static const uint8_t               //
+    WUFFS_DEFLATE__CODE_ORDER[19]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+};
+
+static const uint8_t              //
+    WUFFS_DEFLATE__REVERSE8[256]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,   128, 64,  192, 32,  160, 96,  224, 16,  144, 80,  208, 48,  176,
+        112, 240, 8,   136, 72,  200, 40,  168, 104, 232, 24,  152, 88,  216,
+        56,  184, 120, 248, 4,   132, 68,  196, 36,  164, 100, 228, 20,  148,
+        84,  212, 52,  180, 116, 244, 12,  140, 76,  204, 44,  172, 108, 236,
+        28,  156, 92,  220, 60,  188, 124, 252, 2,   130, 66,  194, 34,  162,
+        98,  226, 18,  146, 82,  210, 50,  178, 114, 242, 10,  138, 74,  202,
+        42,  170, 106, 234, 26,  154, 90,  218, 58,  186, 122, 250, 6,   134,
+        70,  198, 38,  166, 102, 230, 22,  150, 86,  214, 54,  182, 118, 246,
+        14,  142, 78,  206, 46,  174, 110, 238, 30,  158, 94,  222, 62,  190,
+        126, 254, 1,   129, 65,  193, 33,  161, 97,  225, 17,  145, 81,  209,
+        49,  177, 113, 241, 9,   137, 73,  201, 41,  169, 105, 233, 25,  153,
+        89,  217, 57,  185, 121, 249, 5,   133, 69,  197, 37,  165, 101, 229,
+        21,  149, 85,  213, 53,  181, 117, 245, 13,  141, 77,  205, 45,  173,
+        109, 237, 29,  157, 93,  221, 61,  189, 125, 253, 3,   131, 67,  195,
+        35,  163, 99,  227, 19,  147, 83,  211, 51,  179, 115, 243, 11,  139,
+        75,  203, 43,  171, 107, 235, 27,  155, 91,  219, 59,  187, 123, 251,
+        7,   135, 71,  199, 39,  167, 103, 231, 23,  151, 87,  215, 55,  183,
+        119, 247, 15,  143, 79,  207, 47,  175, 111, 239, 31,  159, 95,  223,
+        63,  191, 127, 255,
+};
+
+static const uint32_t                       //
+    WUFFS_DEFLATE__LCODE_MAGIC_NUMBERS[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1073741824, 1073742080, 1073742336, 1073742592, 1073742848, 1073743104,
+        1073743360, 1073743616, 1073743888, 1073744400, 1073744912, 1073745424,
+        1073745952, 1073746976, 1073748000, 1073749024, 1073750064, 1073752112,
+        1073754160, 1073756208, 1073758272, 1073762368, 1073766464, 1073770560,
+        1073774672, 1073782864, 1073791056, 1073799248, 1073807104, 134217728,
+        134217728,  134217728,
+};
+
+static const uint32_t                       //
+    WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1073741824, 1073742080, 1073742336, 1073742592, 1073742864, 1073743376,
+        1073743904, 1073744928, 1073745968, 1073748016, 1073750080, 1073754176,
+        1073758288, 1073766480, 1073774688, 1073791072, 1073807472, 1073840240,
+        1073873024, 1073938560, 1074004112, 1074135184, 1074266272, 1074528416,
+        1074790576, 1075314864, 1075839168, 1076887744, 1077936336, 1080033488,
+        134217728,  134217728,
+};
+
+#define WUFFS_DEFLATE__HUFFS_TABLE_SIZE 2048
+
+#define WUFFS_DEFLATE__HUFFS_TABLE_MASK 2047
+
+#define WUFFS_DEFLATE__QUIRKS_BASE 867177472
+
+#define WUFFS_DEFLATE__QUIRKS_COUNT 1
+
+#define WUFFS_DEFLATE__SYMS_SIZE 16384
+
+#define WUFFS_DEFLATE__MIN_LOOKAHEAD 262
+
+#define WUFFS_DEFLATE__SLIDE_THRESHOLD 65274
+
+#define WUFFS_DEFLATE__TOO_FAR 4096
+
+static const uint32_t                      //
+    WUFFS_DEFLATE__LEVEL_GOOD_LENGTHS[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 4, 8, 8, 8, 32, 32,
+};
+
+static const uint32_t                  //
+    WUFFS_DEFLATE__LEVEL_MAX_LAZY[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 16, 258, 4, 16, 16, 32, 128, 258,
+};
+
+static const uint32_t                      //
+    WUFFS_DEFLATE__LEVEL_NICE_LENGTHS[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 16, 32, 128, 128, 258, 258,
+};
+
+static const uint32_t                    //
+    WUFFS_DEFLATE__LEVEL_MAX_CHAINS[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 16, 32, 128, 256, 1024, 4096,
+};
+
+static const uint8_t                  //
+    WUFFS_DEFLATE__LENGTH_CODES[256]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  5,  6,  7,  8,  8,  9,  9,  10, 10, 11, 11, 12, 12,
+        12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16,
+        16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18,
+        18, 18, 19, 19, 19, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20,
+        20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+        21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+        22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+        23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 28,
+};
+
+static const uint8_t                         //
+    WUFFS_DEFLATE__LENGTH_BASES_MINUS_3[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  5,  6,  7,   8,   10,  12,  14,  16,  20, 24, 28,
+        32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 255, 0,  0,  0,
+};
+
+static const uint8_t                  //
+    WUFFS_DEFLATE__LENGTH_EXTRAS[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0, 0, 0, 0,
+};
+
+static const uint8_t                    //
+    WUFFS_DEFLATE__DISTANCE_CODES[512]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  4,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,  8,  8,
+        8,  8,  8,  8,  8,  8,  9,  9,  9,  9,  9,  9,  9,  9,  10, 10, 10, 10,
+        10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 0,  0,  16, 17, 18, 18, 19, 19, 20, 20, 20, 20, 21, 21,
+        21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29,
+};
+
+static const uint16_t                          //
+    WUFFS_DEFLATE__DISTANCE_BASES_MINUS_1[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,    1,    2,    3,    4,    6,     8,     12,    16,  24,   32,
+        48,   64,   96,   128,  192,  256,   384,   512,   768, 1024, 1536,
+        2048, 3072, 4096, 6144, 8192, 12288, 16384, 24576, 0,   0,
+};
+
+static const uint8_t                    //
+    WUFFS_DEFLATE__DISTANCE_EXTRAS[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,  6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 0, 0,
+};
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
+                                      wuffs_base__io_buffer* a_dst,
+                                      wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_uncompressed(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__init_fixed_huffman(wuffs_deflate__decoder* self);
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__init_dynamic_huffman(wuffs_deflate__decoder* self,
+                                             wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
+                                  uint32_t a_which,
+                                  uint32_t a_n_codes0,
+                                  uint32_t a_n_codes1,
+                                  uint32_t a_base_symbol);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__decoder__init_double_literals(wuffs_deflate__decoder* self);
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__start_stream(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__fill(wuffs_deflate__encoder* self,
+                             wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_literal(wuffs_deflate__encoder* self,
+                                    uint8_t a_lit);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_match(wuffs_deflate__encoder* self,
+                                  uint32_t a_length,
+                                  uint32_t a_distance);
+
+static uint32_t  //
+wuffs_deflate__encoder__count_matching(wuffs_deflate__encoder* self,
+                                       uint32_t a_a,
+                                       uint32_t a_b,
+                                       uint32_t a_max);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_none(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_fast(wuffs_deflate__encoder* self,
+                                      bool a_flush);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_lazy(wuffs_deflate__encoder* self,
+                                      bool a_flush);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_pos,
+                                      uint32_t a_cand,
+                                      uint32_t a_max,
+                                      uint32_t a_prev_length);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst,
+                                   uint32_t a_x,
+                                   uint32_t a_n);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_syms(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst);
+
+static uint32_t  //
+wuffs_deflate__encoder__choose_block_type(wuffs_deflate__encoder* self,
+                                          bool a_stored_ok);
+
+static uint32_t  //
+wuffs_deflate__encoder__lit_dist_len(const wuffs_deflate__encoder* self,
+                                     uint32_t a_k);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_cl_syms(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_cl_sym(wuffs_deflate__encoder* self,
+                                   uint32_t a_sym,
+                                   uint32_t a_extra);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_offset,
+                                      uint32_t a_n,
+                                      uint32_t a_max_len);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_offset,
+                                     uint32_t a_n);
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_deflate__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_deflate__decoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_deflate__decoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_deflate__decoder__workbuf_len),
+};
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_deflate__encoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_deflate__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_deflate__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_deflate__decoder*  //
+wuffs_deflate__decoder__alloc() {
+  wuffs_deflate__decoder* x =
+      (wuffs_deflate__decoder*)(calloc(sizeof(wuffs_deflate__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_deflate__decoder__initialize(x, sizeof(wuffs_deflate__decoder),
+                                         WUFFS_VERSION,
+                                         WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_deflate__decoder() {
+  return sizeof(wuffs_deflate__decoder);
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_deflate__encoder*  //
+wuffs_deflate__encoder__alloc() {
+  wuffs_deflate__encoder* x =
+      (wuffs_deflate__encoder*)(calloc(sizeof(wuffs_deflate__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_deflate__encoder__initialize(x, sizeof(wuffs_deflate__encoder),
+                                         WUFFS_VERSION,
+                                         WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_deflate__encoder() {
+  return sizeof(wuffs_deflate__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func deflate.decoder.add_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
+                                    wuffs_base__slice_u8 a_hist) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n_copied = 0;
+  uint32_t v_already_full = 0;
+
+  v_s = a_hist;
+  if (((uint64_t)(v_s.len)) >= 32768) {
+    v_s = wuffs_base__slice_u8__suffix(v_s, 32768);
+    wuffs_base__slice_u8__copy_from_slice(
+        wuffs_base__slice_u8__subslice_j(
+            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+            32768),
+        v_s);
+    self->private_impl.f_history_index = 32768;
+  } else {
+    v_n_copied = wuffs_base__slice_u8__copy_from_slice(
+        wuffs_base__slice_u8__subslice_ij(
+            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+            (self->private_impl.f_history_index & 32767), 32768),
+        v_s);
+    if (v_n_copied < ((uint64_t)(v_s.len))) {
+      v_s = wuffs_base__slice_u8__subslice_i(v_s, v_n_copied);
+      v_n_copied = wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__slice_u8__subslice_j(
+              wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+              32768),
+          v_s);
+      self->private_impl.f_history_index =
+          (((uint32_t)((v_n_copied & 32767))) + 32768);
+    } else {
+      v_already_full = 0;
+      if (self->private_impl.f_history_index >= 32768) {
+        v_already_full = 32768;
+      }
+      self->private_impl.f_history_index =
+          ((self->private_impl.f_history_index & 32767) +
+           ((uint32_t)((v_n_copied & 32767))) + v_already_full);
+    }
+  }
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_i(
+          wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+          32768),
+      wuffs_base__make_slice_u8(self->private_data.f_history, 33025));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_quirk_enabled(wuffs_deflate__decoder* self,
+                                          uint32_t a_quirk,
+                                          bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_quirk >= 867177472) {
+    a_quirk -= 867177472;
+    if (a_quirk < 1) {
+      self->private_impl.f_quirks[a_quirk] = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.prime
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__prime(wuffs_deflate__decoder* self,
+                              uint32_t a_bits,
+                              uint32_t a_n_bits) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_n_bits > 7) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_bits =
+      ((a_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(a_n_bits));
+  self->private_impl.f_n_bits = a_n_bits;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.block_start_src_bit_position
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_src_bit_position(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_block_start_src_bit_pos;
+}
+
+// -------- func deflate.decoder.block_start_dst_position
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_dst_position(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_block_start_dst_pos;
+}
+
+// -------- func deflate.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__decoder__workbuf_len(const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(1, 1);
+}
+
+// -------- func deflate.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_mark = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        wuffs_base__status t_0 =
+            wuffs_deflate__decoder__decode_blocks(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        v_status = t_0;
+      }
+      if (!wuffs_base__status__is_suspension(&v_status)) {
+        if (wuffs_base__status__is_ok(&v_status)) {
+          self->private_impl.f_bits = 0;
+          self->private_impl.f_n_bits = 0;
+          self->private_impl.f_history_index = 0;
+        }
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
+        }
+        goto ok;
+      }
+      if (!self->private_impl.f_quirks[0]) {
+        wuffs_deflate__decoder__add_history(
+            self, wuffs_base__io__since(
+                      v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
+      }
+      status = v_status;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func deflate.decoder.decode_blocks
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
+                                      wuffs_base__io_buffer* a_dst,
+                                      wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_final = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_type = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_blocks[0];
+  if (coro_susp_point) {
+    v_final = self->private_data.s_decode_blocks[0].v_final;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+  label__outer__continue:;
+    while (v_final == 0) {
+      self->private_impl.f_block_start_src_bit_pos =
+          ((wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))) *
+            8) -
+           ((uint64_t)(self->private_impl.f_n_bits)));
+      self->private_impl.f_block_start_dst_pos = wuffs_base__u64__sat_add(
+          a_dst->meta.pos, ((uint64_t)(iop_a_dst - io0_a_dst)));
+      while (self->private_impl.f_n_bits < 3) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_0 = *iop_a_src++;
+          v_b0 = t_0;
+        }
+        self->private_impl.f_bits |= (v_b0 << self->private_impl.f_n_bits);
+        self->private_impl.f_n_bits += 8;
+      }
+      v_final = (self->private_impl.f_bits & 1);
+      v_type = ((self->private_impl.f_bits >> 1) & 3);
+      self->private_impl.f_bits >>= 3;
+      self->private_impl.f_n_bits -= 3;
+      if (v_type == 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status =
+            wuffs_deflate__decoder__decode_uncompressed(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__outer__continue;
+      } else if (v_type == 1) {
+        v_status = wuffs_deflate__decoder__init_fixed_huffman(self);
+        if (!wuffs_base__status__is_ok(&v_status)) {
+          status = v_status;
+          if (wuffs_base__status__is_error(&status)) {
+            goto exit;
+          } else if (wuffs_base__status__is_suspension(&status)) {
+            status = wuffs_base__make_status(
+                wuffs_base__error__cannot_return_a_suspension);
+            goto exit;
+          }
+          goto ok;
+        }
+      } else if (v_type == 2) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_deflate__decoder__init_dynamic_huffman(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_block);
+        goto exit;
+      }
+      self->private_impl.f_end_of_block = false;
+      while (true) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        v_status =
+            wuffs_deflate__decoder__decode_huffman_fast(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (wuffs_base__status__is_error(&v_status)) {
+          status = v_status;
+          goto exit;
+        }
+        if (self->private_impl.f_end_of_block) {
+          goto label__outer__continue;
+        }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        status =
+            wuffs_deflate__decoder__decode_huffman_slow(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (self->private_impl.f_end_of_block) {
+          goto label__outer__continue;
+        }
+      }
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_blocks[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_blocks[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_blocks[0].v_final = v_final;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.decode_uncompressed
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_uncompressed(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_length = 0;
+  uint32_t v_n_copied = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_uncompressed[0];
+  if (coro_susp_point) {
+    v_length = self->private_data.s_decode_uncompressed[0].v_length;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_n_bits >= 8) ||
+        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
+         0)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_bits = 0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_uncompressed[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch =
+              &self->private_data.s_decode_uncompressed[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      v_length = t_0;
+    }
+    if ((((v_length)&0xFFFF) + ((v_length) >> (32 - (16)))) != 65535) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__inconsistent_stored_block_length);
+      goto exit;
+    }
+    v_length = ((v_length)&0xFFFF);
+    while (true) {
+      v_n_copied = wuffs_base__io_writer__copy_n32_from_reader(
+          &iop_a_dst, io2_a_dst, v_length, &iop_a_src, io2_a_src);
+      if (v_length <= v_n_copied) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      v_length -= v_n_copied;
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) == 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+      } else {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+      }
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_uncompressed[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_uncompressed[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_uncompressed[0].v_length = v_length;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.init_fixed_huffman
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__init_fixed_huffman(wuffs_deflate__decoder* self) {
+  uint32_t v_i = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  while (v_i < 144) {
+    self->private_data.f_code_lengths[v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 256) {
+    self->private_data.f_code_lengths[v_i] = 9;
+    v_i += 1;
+  }
+  while (v_i < 280) {
+    self->private_data.f_code_lengths[v_i] = 7;
+    v_i += 1;
+  }
+  while (v_i < 288) {
+    self->private_data.f_code_lengths[v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 320) {
+    self->private_data.f_code_lengths[v_i] = 5;
+    v_i += 1;
+  }
+  v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, 288, 257);
+  if (wuffs_base__status__is_error(&v_status)) {
+    return v_status;
+  }
+  v_status = wuffs_deflate__decoder__init_huff(self, 1, 288, 320, 0);
+  if (wuffs_base__status__is_error(&v_status)) {
+    return v_status;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func deflate.decoder.init_dynamic_huffman
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__init_dynamic_huffman(wuffs_deflate__decoder* self,
+                                             wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_n_lit = 0;
+  uint32_t v_n_dist = 0;
+  uint32_t v_n_clen = 0;
+  uint32_t v_i = 0;
+  uint32_t v_b1 = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_mask = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_n_extra_bits = 0;
+  uint8_t v_rep_symbol = 0;
+  uint32_t v_rep_count = 0;
+  uint32_t v_b3 = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_init_dynamic_huffman[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_init_dynamic_huffman[0].v_bits;
+    v_n_bits = self->private_data.s_init_dynamic_huffman[0].v_n_bits;
+    v_n_lit = self->private_data.s_init_dynamic_huffman[0].v_n_lit;
+    v_n_dist = self->private_data.s_init_dynamic_huffman[0].v_n_dist;
+    v_n_clen = self->private_data.s_init_dynamic_huffman[0].v_n_clen;
+    v_i = self->private_data.s_init_dynamic_huffman[0].v_i;
+    v_mask = self->private_data.s_init_dynamic_huffman[0].v_mask;
+    v_table_entry = self->private_data.s_init_dynamic_huffman[0].v_table_entry;
+    v_n_extra_bits =
+        self->private_data.s_init_dynamic_huffman[0].v_n_extra_bits;
+    v_rep_symbol = self->private_data.s_init_dynamic_huffman[0].v_rep_symbol;
+    v_rep_count = self->private_data.s_init_dynamic_huffman[0].v_rep_count;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    while (v_n_bits < 14) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint32_t t_0 = *iop_a_src++;
+        v_b0 = t_0;
+      }
+      v_bits |= (v_b0 << v_n_bits);
+      v_n_bits += 8;
+    }
+    v_n_lit = (((v_bits)&0x1F) + 257);
+    if (v_n_lit > 286) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__bad_literal_length_code_count);
+      goto exit;
+    }
+    v_bits >>= 5;
+    v_n_dist = (((v_bits)&0x1F) + 1);
+    if (v_n_dist > 30) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__bad_distance_code_count);
+      goto exit;
+    }
+    v_bits >>= 5;
+    v_n_clen = (((v_bits)&0xF) + 4);
+    v_bits >>= 4;
+    v_n_bits -= 14;
+    v_i = 0;
+    while (v_i < v_n_clen) {
+      while (v_n_bits < 3) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_1 = *iop_a_src++;
+          v_b1 = t_1;
+        }
+        v_bits |= (v_b1 << v_n_bits);
+        v_n_bits += 8;
+      }
+      self->private_data.f_code_lengths[WUFFS_DEFLATE__CODE_ORDER[v_i]] =
+          ((uint8_t)((v_bits & 7)));
+      v_bits >>= 3;
+      v_n_bits -= 3;
+      v_i += 1;
+    }
+    while (v_i < 19) {
+      self->private_data.f_code_lengths[WUFFS_DEFLATE__CODE_ORDER[v_i]] = 0;
+      v_i += 1;
+    }
+    v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, 19, 4095);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    v_mask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+    v_i = 0;
+  label__0__continue:;
+    while (v_i < (v_n_lit + v_n_dist)) {
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_mask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__1__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_2 = *iop_a_src++;
+          v_b2 = t_2;
+        }
+        v_bits |= (v_b2 << v_n_bits);
+        v_n_bits += 8;
+      }
+    label__1__break:;
+      if ((v_table_entry >> 24) != 128) {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_table_entry = ((v_table_entry >> 8) & 255);
+      if (v_table_entry < 16) {
+        self->private_data.f_code_lengths[v_i] = ((uint8_t)(v_table_entry));
+        v_i += 1;
+        goto label__0__continue;
+      }
+      v_n_extra_bits = 0;
+      v_rep_symbol = 0;
+      v_rep_count = 0;
+      if (v_table_entry == 16) {
+        v_n_extra_bits = 2;
+        if (v_i <= 0) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__bad_huffman_code_length_repetition);
+          goto exit;
+        }
+        v_rep_symbol = (self->private_data.f_code_lengths[(v_i - 1)] & 15);
+        v_rep_count = 3;
+      } else if (v_table_entry == 17) {
+        v_n_extra_bits = 3;
+        v_rep_symbol = 0;
+        v_rep_count = 3;
+      } else if (v_table_entry == 18) {
+        v_n_extra_bits = 7;
+        v_rep_symbol = 0;
+        v_rep_count = 11;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      while (v_n_bits < v_n_extra_bits) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_3 = *iop_a_src++;
+          v_b3 = t_3;
+        }
+        v_bits |= (v_b3 << v_n_bits);
+        v_n_bits += 8;
+      }
+      v_rep_count += ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_n_extra_bits));
+      v_bits >>= v_n_extra_bits;
+      v_n_bits -= v_n_extra_bits;
+      while (v_rep_count > 0) {
+        if (v_i >= (v_n_lit + v_n_dist)) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__bad_huffman_code_length_count);
+          goto exit;
+        }
+        self->private_data.f_code_lengths[v_i] = v_rep_symbol;
+        v_i += 1;
+        v_rep_count -= 1;
+      }
+    }
+    if (v_i != (v_n_lit + v_n_dist)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__bad_huffman_code_length_count);
+      goto exit;
+    }
+    if (self->private_data.f_code_lengths[256] == 0) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__missing_end_of_block_code);
+      goto exit;
+    }
+    v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, v_n_lit, 257);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    wuffs_deflate__decoder__init_double_literals(self);
+    v_status = wuffs_deflate__decoder__init_huff(self, 1, v_n_lit,
+                                                 (v_n_lit + v_n_dist), 0);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+
+    goto ok;
+  ok:
+    self->private_impl.p_init_dynamic_huffman[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_init_dynamic_huffman[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_init_dynamic_huffman[0].v_bits = v_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_n_bits = v_n_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_n_lit = v_n_lit;
+  self->private_data.s_init_dynamic_huffman[0].v_n_dist = v_n_dist;
+  self->private_data.s_init_dynamic_huffman[0].v_n_clen = v_n_clen;
+  self->private_data.s_init_dynamic_huffman[0].v_i = v_i;
+  self->private_data.s_init_dynamic_huffman[0].v_mask = v_mask;
+  self->private_data.s_init_dynamic_huffman[0].v_table_entry = v_table_entry;
+  self->private_data.s_init_dynamic_huffman[0].v_n_extra_bits = v_n_extra_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_rep_symbol = v_rep_symbol;
+  self->private_data.s_init_dynamic_huffman[0].v_rep_count = v_rep_count;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.init_huff
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
+                                  uint32_t a_which,
+                                  uint32_t a_n_codes0,
+                                  uint32_t a_n_codes1,
+                                  uint32_t a_base_symbol) {
+  uint16_t v_counts[16] = {0};
+  uint32_t v_i = 0;
+  uint32_t v_remaining = 0;
+  uint16_t v_offsets[16] = {0};
+  uint32_t v_n_symbols = 0;
+  uint32_t v_count = 0;
+  uint16_t v_symbols[320] = {0};
+  uint32_t v_min_cl = 0;
+  uint32_t v_max_cl = 0;
+  uint32_t v_initial_high_bits = 0;
+  uint32_t v_prev_cl = 0;
+  uint32_t v_prev_redirect_key = 0;
+  uint32_t v_top = 0;
+  uint32_t v_next_top = 0;
+  uint32_t v_code = 0;
+  uint32_t v_key = 0;
+  uint32_t v_value = 0;
+  uint32_t v_cl = 0;
+  uint32_t v_redirect_key = 0;
+  uint32_t v_j = 0;
+  uint32_t v_reversed_key = 0;
+  uint32_t v_symbol = 0;
+  uint32_t v_high_bits = 0;
+  uint32_t v_delta = 0;
+
+  v_i = a_n_codes0;
+  while (v_i < a_n_codes1) {
+    if (v_counts[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+    v_counts[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    v_i += 1;
+  }
+  if ((((uint32_t)(v_counts[0])) + a_n_codes0) == a_n_codes1) {
+    return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
+  }
+  v_remaining = 1;
+  v_i = 1;
+  while (v_i <= 15) {
+    if (v_remaining > 1073741824) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_remaining <<= 1;
+    if (v_remaining < ((uint32_t)(v_counts[v_i]))) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__bad_huffman_code_over_subscribed);
+    }
+    v_remaining -= ((uint32_t)(v_counts[v_i]));
+    v_i += 1;
+  }
+  if (v_remaining != 0) {
+    if ((a_which == 1) && (v_counts[1] == 1) &&
+        (self->private_data.f_code_lengths[a_n_codes0] == 1) &&
+        ((((uint32_t)(v_counts[0])) + a_n_codes0 + 1) == a_n_codes1)) {
+      self->private_impl.f_n_huffs_bits[1] = 1;
+      self->private_data.f_huffs[1][0] =
+          (WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[0] | 1);
+      self->private_data.f_huffs[1][1] =
+          (WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[31] | 1);
+      return wuffs_base__make_status(NULL);
+    }
+    return wuffs_base__make_status(
+        wuffs_deflate__error__bad_huffman_code_under_subscribed);
+  }
+  v_i = 1;
+  while (v_i <= 15) {
+    v_offsets[v_i] = ((uint16_t)(v_n_symbols));
+    v_count = ((uint32_t)(v_counts[v_i]));
+    if (v_n_symbols > (320 - v_count)) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_n_symbols = (v_n_symbols + v_count);
+    v_i += 1;
+  }
+  if (v_n_symbols > 288) {
+    return wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+  }
+  v_i = a_n_codes0;
+  while (v_i < a_n_codes1) {
+    if (v_i < a_n_codes0) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    if (self->private_data.f_code_lengths[v_i] != 0) {
+      if (v_offsets[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+      v_symbols[v_offsets[(self->private_data.f_code_lengths[v_i] & 15)]] =
+          ((uint16_t)((v_i - a_n_codes0)));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+      v_offsets[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    }
+    v_i += 1;
+  }
+  v_min_cl = 1;
+  while (true) {
+    if (v_counts[v_min_cl] != 0) {
+      goto label__0__break;
+    }
+    if (v_min_cl >= 9) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__bad_huffman_minimum_code_length);
+    }
+    v_min_cl += 1;
+  }
+label__0__break:;
+  v_max_cl = 15;
+  while (true) {
+    if (v_counts[v_max_cl] != 0) {
+      goto label__1__break;
+    }
+    if (v_max_cl <= 1) {
+      return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
+    }
+    v_max_cl -= 1;
+  }
+label__1__break:;
+  if (v_max_cl <= 10) {
+    self->private_impl.f_n_huffs_bits[a_which] = v_max_cl;
+  } else {
+    self->private_impl.f_n_huffs_bits[a_which] = 10;
+  }
+  v_i = 0;
+  if ((v_n_symbols != ((uint32_t)(v_offsets[v_max_cl]))) ||
+      (v_n_symbols != ((uint32_t)(v_offsets[15])))) {
+    return wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+  }
+  if ((a_n_codes0 + ((uint32_t)(v_symbols[0]))) >= 320) {
+    return wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+  }
+  v_initial_high_bits = 1024;
+  if (v_max_cl < 10) {
+    v_initial_high_bits = (((uint32_t)(1)) << v_max_cl);
+  }
+  v_prev_cl = ((uint32_t)((self->private_data.f_code_lengths[(
+                               a_n_codes0 + ((uint32_t)(v_symbols[0])))] &
+                           15)));
+  v_prev_redirect_key = 4294967295;
+  v_top = 0;
+  v_next_top = 1024;
+  v_code = 0;
+  v_key = 0;
+  v_value = 0;
+  while (true) {
+    if ((a_n_codes0 + ((uint32_t)(v_symbols[v_i]))) >= 320) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_cl = ((uint32_t)((self->private_data.f_code_lengths[(
+                            a_n_codes0 + ((uint32_t)(v_symbols[v_i])))] &
+                        15)));
+    if (v_cl > v_prev_cl) {
+      v_code <<= (v_cl - v_prev_cl);
+      if (v_code >= 32768) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+    }
+    v_prev_cl = v_cl;
+    v_key = v_code;
+    if (v_cl > 10) {
+      v_cl -= 10;
+      v_redirect_key = ((v_key >> v_cl) & 1023);
+      v_key = ((v_key)&WUFFS_BASE__LOW_BITS_MASK__U32(v_cl));
+      if (v_prev_redirect_key != v_redirect_key) {
+        v_prev_redirect_key = v_redirect_key;
+        v_remaining = (((uint32_t)(1)) << v_cl);
+        v_j = v_prev_cl;
+        while (v_j <= 15) {
+          if (v_remaining <= ((uint32_t)(v_counts[v_j]))) {
+            goto label__2__break;
+          }
+          v_remaining -= ((uint32_t)(v_counts[v_j]));
+          if (v_remaining > 1073741824) {
+            return wuffs_base__make_status(
+                wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          }
+          v_remaining <<= 1;
+          v_j += 1;
+        }
+      label__2__break:;
+        if ((v_j <= 10) || (15 < v_j)) {
+          return wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        }
+        v_j -= 10;
+        v_initial_high_bits = (((uint32_t)(1)) << v_j);
+        v_top = v_next_top;
+        if ((v_top + (((uint32_t)(1)) << v_j)) > 2048) {
+          return wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        }
+        v_next_top = (v_top + (((uint32_t)(1)) << v_j));
+        v_redirect_key =
+            (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_redirect_key >> 2)])) |
+             (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_redirect_key & 3)]))
+              << 2));
+        self->private_data.f_huffs[a_which][v_redirect_key] =
+            (268435466 | (v_top << 8) | (v_j << 4));
+      }
+    }
+    if ((v_key >= 1024) || (v_counts[v_prev_cl] <= 0)) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+    v_counts[v_prev_cl] -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    v_reversed_key =
+        (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_key >> 2)])) |
+         (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_key & 3)])) << 2));
+    v_reversed_key >>= (10 - v_cl);
+    v_symbol = ((uint32_t)(v_symbols[v_i]));
+    if (v_symbol == 256) {
+      v_value = (536870912 | v_cl);
+    } else if ((v_symbol < 256) && (a_which == 0)) {
+      v_value = (2147483648 | (v_symbol << 8) | v_cl);
+    } else if (v_symbol >= a_base_symbol) {
+      v_symbol -= a_base_symbol;
+      if (a_which == 0) {
+        v_value = (WUFFS_DEFLATE__LCODE_MAGIC_NUMBERS[(v_symbol & 31)] | v_cl);
+      } else {
+        v_value = (WUFFS_DEFLATE__DCODE_MAGIC_NUMBERS[(v_symbol & 31)] | v_cl);
+      }
+    } else {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_high_bits = v_initial_high_bits;
+    v_delta = (((uint32_t)(1)) << v_cl);
+    while (v_high_bits >= v_delta) {
+      v_high_bits -= v_delta;
+      if ((v_top + ((v_high_bits | v_reversed_key) & 1023)) >= 2048) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+      self->private_data
+          .f_huffs[a_which][(v_top + ((v_high_bits | v_reversed_key) & 1023))] =
+          v_value;
+    }
+    v_i += 1;
+    if (v_i >= v_n_symbols) {
+      goto label__3__break;
+    }
+    v_code += 1;
+    if (v_code >= 32768) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+  }
+label__3__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func deflate.decoder.init_double_literals
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__decoder__init_double_literals(wuffs_deflate__decoder* self) {
+  uint32_t v_n_bits = 0;
+  uint32_t v_mask = 0;
+  uint32_t v_i = 0;
+  uint32_t v_first = 0;
+  uint32_t v_second = 0;
+  uint32_t v_n0 = 0;
+  uint32_t v_n1 = 0;
+
+  v_n_bits = self->private_impl.f_n_huffs_bits[0];
+  v_mask = ((((uint32_t)(1)) << v_n_bits) - 1);
+  if (v_n_bits < 10) {
+    v_i = (v_mask + 1);
+    while (v_i < 1024) {
+      self->private_data.f_huffs[0][v_i] =
+          self->private_data.f_huffs[0][(v_i & v_mask)];
+      v_i += 1;
+    }
+    v_n_bits = 10;
+    v_mask = 1023;
+    self->private_impl.f_n_huffs_bits[0] = 10;
+  }
+  v_i = (v_mask + 1);
+label__0__continue:;
+  while (v_i > 0) {
+    v_i -= 1;
+    v_first = self->private_data.f_huffs[0][v_i];
+    if ((v_first >> 24) != 128) {
+      goto label__0__continue;
+    }
+    v_n0 = (v_first & 15);
+    v_second = self->private_data.f_huffs[0][((v_i >> v_n0) & v_mask)];
+    if ((v_second >> 24) != 128) {
+      goto label__0__continue;
+    }
+    v_n1 = (v_second & 15);
+    if ((v_n0 + v_n1) > v_n_bits) {
+      goto label__0__continue;
+    }
+    self->private_data.f_huffs[0][v_i] =
+        ((v_first & 2147548928) | ((v_second & 65280) << 8) | (v_n0 << 4) |
+         (v_n0 + v_n1));
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.decode_huffman_fast
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
+  v_n_bits = self->private_impl.f_n_bits;
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+label__loop__continue:;
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 266) &&
+         (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_bits |=
+        (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << (v_n_bits & 63));
+    (iop_a_src += ((63 - (v_n_bits & 63)) >> 3),
+     wuffs_base__make_empty_struct());
+    v_n_bits = ((v_n_bits & 63) | 56);
+    v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 31) != 0) {
+      if ((v_table_entry & 240) == 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+      } else {
+        (wuffs_base__store_u16le__no_bounds_check(
+             iop_a_dst, ((uint16_t)(((v_table_entry >> 8) & 65535)))),
+         iop_a_dst += 2, wuffs_base__make_empty_struct());
+      }
+      v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+      if (((v_table_entry >> 31) == 0) ||
+          (((uint64_t)(io2_a_dst - iop_a_dst)) < 2)) {
+        goto label__loop__continue;
+      }
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry & 240) == 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+      } else {
+        (wuffs_base__store_u16le__no_bounds_check(
+             iop_a_dst, ((uint16_t)(((v_table_entry >> 8) & 65535)))),
+         iop_a_dst += 2, wuffs_base__make_empty_struct());
+      }
+      goto label__loop__continue;
+    } else if ((v_table_entry >> 30) != 0) {
+    } else if ((v_table_entry >> 29) != 0) {
+      self->private_impl.f_end_of_block = true;
+      goto label__loop__break;
+    } else if ((v_table_entry >> 28) != 0) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          2047)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry >> 31) != 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      } else if ((v_table_entry >> 27) != 0) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+    } else if ((v_table_entry >> 27) != 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_length = (((v_table_entry >> 8) & 255) + 3);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_table_entry_n_bits > 0) {
+      v_length = (((v_length + 253 +
+                    ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                        v_table_entry_n_bits))))) &
+                   255) +
+                  3);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 28) == 1) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          2047)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    if ((v_table_entry >> 24) != 64) {
+      if ((v_table_entry >> 24) == 8) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      }
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    v_dist_minus_1 =
+        ((v_dist_minus_1 + ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                               v_table_entry_n_bits))))) &
+         32767);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    while (true) {
+      if (((uint64_t)((v_dist_minus_1 + 1))) >
+          ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        v_hlen = 0;
+        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
+                               ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        if (v_length > v_hdist) {
+          v_length -= v_hdist;
+          v_hlen = v_hdist;
+        } else {
+          v_hlen = v_length;
+          v_length = 0;
+        }
+        if (self->private_impl.f_history_index < v_hdist) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+          goto exit;
+        }
+        v_hdist = (self->private_impl.f_history_index - v_hdist);
+        wuffs_base__io_writer__copy_n32_from_slice(
+            &iop_a_dst, io2_a_dst, v_hlen,
+            wuffs_base__slice_u8__subslice_i(
+                wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+                (v_hdist & 32767)));
+        if (v_length == 0) {
+          goto label__loop__continue;
+        }
+        if (((uint64_t)((v_dist_minus_1 + 1))) >
+            ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_distance);
+          goto exit;
+        }
+      }
+      wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(
+          &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      goto label__0__break;
+    }
+  label__0__break:;
+  }
+label__loop__break:;
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    if (iop_a_src > io1_a_src) {
+      (iop_a_src--, wuffs_base__make_empty_struct());
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+  }
+  self->private_impl.f_bits =
+      ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
+  self->private_impl.f_n_bits = v_n_bits;
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.decoder.decode_huffman_slow
+
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_lmask = 0;
+  uint32_t v_dmask = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_b1 = 0;
+  uint32_t v_length = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_b3 = 0;
+  uint32_t v_b4 = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_b5 = 0;
+  uint32_t v_n_copied = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_huffman_slow[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_decode_huffman_slow[0].v_bits;
+    v_n_bits = self->private_data.s_decode_huffman_slow[0].v_n_bits;
+    v_table_entry = self->private_data.s_decode_huffman_slow[0].v_table_entry;
+    v_table_entry_n_bits =
+        self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits;
+    v_lmask = self->private_data.s_decode_huffman_slow[0].v_lmask;
+    v_dmask = self->private_data.s_decode_huffman_slow[0].v_dmask;
+    v_redir_top = self->private_data.s_decode_huffman_slow[0].v_redir_top;
+    v_redir_mask = self->private_data.s_decode_huffman_slow[0].v_redir_mask;
+    v_length = self->private_data.s_decode_huffman_slow[0].v_length;
+    v_dist_minus_1 = self->private_data.s_decode_huffman_slow[0].v_dist_minus_1;
+    v_hlen = self->private_data.s_decode_huffman_slow[0].v_hlen;
+    v_hdist = self->private_data.s_decode_huffman_slow[0].v_hdist;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_n_bits >= 8) ||
+        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
+         0)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+    v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  label__loop__continue:;
+    while (!(self->private_impl.p_decode_huffman_slow[0] != 0)) {
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+        if (((v_table_entry >> 31) != 0) && ((v_table_entry & 240) != 0)) {
+          v_table_entry =
+              ((v_table_entry & 2147548928) | ((v_table_entry >> 4) & 15));
+        }
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__0__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_0 = *iop_a_src++;
+          v_b0 = t_0;
+        }
+        v_bits |= (v_b0 << v_n_bits);
+        v_n_bits += 8;
+      }
+    label__0__break:;
+      if ((v_table_entry >> 31) != 0) {
+        self->private_data.s_decode_huffman_slow[0].scratch =
+            ((uint8_t)(((v_table_entry >> 8) & 255)));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry =
+              self->private_data
+                  .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 2047)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__1__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_1 = *iop_a_src++;
+            v_b1 = t_1;
+          }
+          v_bits |= (v_b1 << v_n_bits);
+          v_n_bits += 8;
+        }
+      label__1__break:;
+        if ((v_table_entry >> 31) != 0) {
+          self->private_data.s_decode_huffman_slow[0].scratch =
+              ((uint8_t)(((v_table_entry >> 8) & 255)));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (iop_a_dst == io2_a_dst) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            goto suspend;
+          }
+          *iop_a_dst++ =
+              ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+          goto label__loop__continue;
+        } else if ((v_table_entry >> 30) != 0) {
+        } else if ((v_table_entry >> 29) != 0) {
+          self->private_impl.f_end_of_block = true;
+          goto label__loop__break;
+        } else if ((v_table_entry >> 28) != 0) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        } else if ((v_table_entry >> 27) != 0) {
+          status =
+              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        } else {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        }
+      } else if ((v_table_entry >> 27) != 0) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_length = (((v_table_entry >> 8) & 255) + 3);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_2 = *iop_a_src++;
+            v_b2 = t_2;
+          }
+          v_bits |= (v_b2 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_length = (((v_length + 253 +
+                      ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(
+                          v_table_entry_n_bits))) &
+                     255) +
+                    3);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__2__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_3 = *iop_a_src++;
+          v_b3 = t_3;
+        }
+        v_bits |= (v_b3 << v_n_bits);
+        v_n_bits += 8;
+      }
+    label__2__break:;
+      if ((v_table_entry >> 28) == 1) {
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry =
+              self->private_data
+                  .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 2047)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__3__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_4 = *iop_a_src++;
+            v_b4 = t_4;
+          }
+          v_bits |= (v_b4 << v_n_bits);
+          v_n_bits += 8;
+        }
+      label__3__break:;
+      }
+      if ((v_table_entry >> 24) != 64) {
+        if ((v_table_entry >> 24) == 8) {
+          status =
+              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        }
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_5 = *iop_a_src++;
+            v_b5 = t_5;
+          }
+          v_bits |= (v_b5 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_dist_minus_1 =
+            ((v_dist_minus_1 +
+              ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
+             32767);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      while (true) {
+        if (((uint64_t)((v_dist_minus_1 + 1))) >
+            ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
+                                 ((uint64_t)(iop_a_dst - io0_a_dst)))));
+          if (v_length > v_hdist) {
+            v_length -= v_hdist;
+            v_hlen = v_hdist;
+          } else {
+            v_hlen = v_length;
+            v_length = 0;
+          }
+          if (self->private_impl.f_history_index < v_hdist) {
+            status =
+                wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+            goto exit;
+          }
+          v_hdist = (self->private_impl.f_history_index - v_hdist);
+          while (true) {
+            v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
+                &iop_a_dst, io2_a_dst, v_hlen,
+                wuffs_base__slice_u8__subslice_ij(
+                    wuffs_base__make_slice_u8(self->private_data.f_history,
+                                              33025),
+                    (v_hdist & 32767), 32768));
+            if (v_hlen <= v_n_copied) {
+              v_hlen = 0;
+              goto label__4__break;
+            }
+            if (v_n_copied > 0) {
+              v_hlen -= v_n_copied;
+              v_hdist = ((v_hdist + v_n_copied) & 32767);
+              if (v_hdist == 0) {
+                goto label__4__break;
+              }
+            }
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+          }
+        label__4__break:;
+          if (v_hlen > 0) {
+            while (true) {
+              v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
+                  &iop_a_dst, io2_a_dst, v_hlen,
+                  wuffs_base__slice_u8__subslice_ij(
+                      wuffs_base__make_slice_u8(self->private_data.f_history,
+                                                33025),
+                      (v_hdist & 32767), 32768));
+              if (v_hlen <= v_n_copied) {
+                v_hlen = 0;
+                goto label__5__break;
+              }
+              v_hlen -= v_n_copied;
+              v_hdist += v_n_copied;
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+            }
+          label__5__break:;
+          }
+          if (v_length == 0) {
+            goto label__loop__continue;
+          }
+        }
+        v_n_copied = wuffs_base__io_writer__copy_n32_from_history(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+        if (v_length <= v_n_copied) {
+          v_length = 0;
+          goto label__6__break;
+        }
+        v_length -= v_n_copied;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+      }
+    label__6__break:;
+    }
+  label__loop__break:;
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+    if ((self->private_impl.f_n_bits >= 8) ||
+        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
+         0)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_huffman_slow[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_huffman_slow[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_huffman_slow[0].v_bits = v_bits;
+  self->private_data.s_decode_huffman_slow[0].v_n_bits = v_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry = v_table_entry;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits =
+      v_table_entry_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_lmask = v_lmask;
+  self->private_data.s_decode_huffman_slow[0].v_dmask = v_dmask;
+  self->private_data.s_decode_huffman_slow[0].v_redir_top = v_redir_top;
+  self->private_data.s_decode_huffman_slow[0].v_redir_mask = v_redir_mask;
+  self->private_data.s_decode_huffman_slow[0].v_length = v_length;
+  self->private_data.s_decode_huffman_slow[0].v_dist_minus_1 = v_dist_minus_1;
+  self->private_data.s_decode_huffman_slow[0].v_hlen = v_hlen;
+  self->private_data.s_decode_huffman_slow[0].v_hdist = v_hdist;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_quirk_enabled(wuffs_deflate__encoder* self,
+                                          uint32_t a_quirk,
+                                          bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.set_level
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self,
+                                  uint32_t a_level) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_level > 9) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_set_level_arg = (a_level + 1);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func deflate.encoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  bool v_flush = false;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    wuffs_deflate__encoder__start_stream(self);
+    while (true) {
+      if (self->private_impl.f_strstart >= 65274) {
+        wuffs_deflate__encoder__slide(self);
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      wuffs_deflate__encoder__fill(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      v_flush = ((a_src && a_src->meta.closed) &&
+                 (((uint64_t)(io2_a_src - iop_a_src)) == 0));
+      if (self->private_impl.f_level == 0) {
+        wuffs_deflate__encoder__compress_none(self);
+      } else if (self->private_impl.f_level <= 3) {
+        wuffs_deflate__encoder__compress_fast(self, v_flush);
+      } else {
+        wuffs_deflate__encoder__compress_lazy(self, v_flush);
+      }
+      if (self->private_impl.f_n_syms >= 16384) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_deflate__encoder__write_block(self, a_dst, false);
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_flush &&
+                 (self->private_impl.f_strstart >=
+                  self->private_impl.f_w_end) &&
+                 !self->private_impl.f_match_available) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__write_block(self, a_dst, true);
+        if (status.repr) {
+          goto suspend;
+        }
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if (self->private_impl.f_w_end < 65536) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+      }
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func deflate.encoder.start_stream
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__start_stream(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  self->private_impl.f_level = 6;
+  if (self->private_impl.f_set_level_arg > 0) {
+    self->private_impl.f_level = (self->private_impl.f_set_level_arg - 1);
+  }
+  self->private_impl.f_good_length =
+      WUFFS_DEFLATE__LEVEL_GOOD_LENGTHS[self->private_impl.f_level];
+  self->private_impl.f_max_lazy =
+      WUFFS_DEFLATE__LEVEL_MAX_LAZY[self->private_impl.f_level];
+  self->private_impl.f_nice_length =
+      WUFFS_DEFLATE__LEVEL_NICE_LENGTHS[self->private_impl.f_level];
+  self->private_impl.f_max_chain =
+      WUFFS_DEFLATE__LEVEL_MAX_CHAINS[self->private_impl.f_level];
+  self->private_impl.f_bits = 0;
+  self->private_impl.f_n_bits = 0;
+  self->private_impl.f_strstart = 0;
+  self->private_impl.f_w_end = 0;
+  self->private_impl.f_match_length = 0;
+  self->private_impl.f_match_distance = 0;
+  self->private_impl.f_match_available = false;
+  self->private_impl.f_n_syms = 0;
+  self->private_impl.f_block_len = 0;
+  v_i = 0;
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 512) {
+    self->private_data.f_freqs[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.slide
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  if ((self->private_impl.f_strstart < 32768) ||
+      (self->private_impl.f_w_end < 32768)) {
+    return wuffs_base__make_empty_struct();
+  }
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_j(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65808), 32768),
+      wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65808), 32768,
+          self->private_impl.f_w_end));
+  self->private_impl.f_strstart -= 32768;
+  self->private_impl.f_w_end -= 32768;
+  v_i = 0;
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] =
+        wuffs_base__u16__sat_sub(self->private_data.f_head[v_i], 32768);
+    self->private_data.f_prev[v_i] =
+        wuffs_base__u16__sat_sub(self->private_data.f_prev[v_i], 32768);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.fill
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__fill(wuffs_deflate__encoder* self,
+                             wuffs_base__io_buffer* a_src) {
+  uint64_t v_room = 0;
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_room = ((uint64_t)((65536 - self->private_impl.f_w_end)));
+  v_s = wuffs_base__io_reader__take(
+      &iop_a_src, io2_a_src,
+      wuffs_base__u64__min(v_room, ((uint64_t)(io2_a_src - iop_a_src))));
+  v_n = wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65808),
+          self->private_impl.f_w_end, 65536),
+      v_s);
+  v_n += ((uint64_t)(self->private_impl.f_w_end));
+  self->private_impl.f_w_end = ((uint32_t)(wuffs_base__u64__min(v_n, 65536)));
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_literal
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_literal(wuffs_deflate__encoder* self,
+                                    uint8_t a_lit) {
+  self->private_data.f_syms[(self->private_impl.f_n_syms & 16383)] =
+      ((uint32_t)(a_lit));
+  self->private_data.f_freqs[a_lit] += 1;
+  if (self->private_impl.f_n_syms < 16384) {
+    self->private_impl.f_n_syms += 1;
+  }
+  self->private_impl.f_block_len += 1;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_match
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_match(wuffs_deflate__encoder* self,
+                                  uint32_t a_length,
+                                  uint32_t a_distance) {
+  uint32_t v_l = 0;
+  uint32_t v_d = 0;
+
+  v_l = wuffs_base__u32__sat_sub(a_length, 3);
+  v_d = wuffs_base__u32__sat_sub(a_distance, 1);
+  self->private_data.f_syms[(self->private_impl.f_n_syms & 16383)] =
+      (2147483648 | (v_d << 8) | v_l);
+  self->private_data
+      .f_freqs[(257 + ((uint32_t)(WUFFS_DEFLATE__LENGTH_CODES[v_l])))] += 1;
+  if (v_d < 256) {
+    self->private_data
+        .f_freqs[(288 + ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[v_d])))] += 1;
+  } else {
+    self->private_data.f_freqs[(
+        288 +
+        ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[(256 + (v_d >> 7))])))] += 1;
+  }
+  if (self->private_impl.f_n_syms < 16384) {
+    self->private_impl.f_n_syms += 1;
+  }
+  self->private_impl.f_block_len += a_length;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.count_matching
+
+static uint32_t  //
+wuffs_deflate__encoder__count_matching(wuffs_deflate__encoder* self,
+                                       uint32_t a_a,
+                                       uint32_t a_b,
+                                       uint32_t a_max) {
+  uint32_t v_n = 0;
+  uint32_t v_m = 0;
+
+  v_m = wuffs_base__u32__sat_sub(a_max, 3);
+  while (v_n < v_m) {
+    if ((((uint32_t)(self->private_data.f_window[(a_a + v_n)])) |
+         (((uint32_t)(self->private_data.f_window[(a_a + v_n + 1)])) << 8) |
+         (((uint32_t)(self->private_data.f_window[(a_a + v_n + 2)])) << 16) |
+         (((uint32_t)(self->private_data.f_window[(a_a + v_n + 3)])) << 24)) !=
+        (((uint32_t)(self->private_data.f_window[(a_b + v_n)])) |
+         (((uint32_t)(self->private_data.f_window[(a_b + v_n + 1)])) << 8) |
+         (((uint32_t)(self->private_data.f_window[(a_b + v_n + 2)])) << 16) |
+         (((uint32_t)(self->private_data.f_window[(a_b + v_n + 3)])) << 24))) {
+      goto label__0__break;
+    }
+    v_n += 4;
+  }
+label__0__break:;
+  while (v_n < a_max) {
+    if (self->private_data.f_window[(a_a + v_n)] !=
+        self->private_data.f_window[(a_b + v_n)]) {
+      goto label__1__break;
+    }
+    v_n += 1;
+  }
+label__1__break:;
+  return v_n;
+}
+
+// -------- func deflate.encoder.compress_none
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_none(wuffs_deflate__encoder* self) {
+  uint32_t v_pos = 0;
+
+  while ((self->private_impl.f_strstart < self->private_impl.f_w_end) &&
+         (self->private_impl.f_n_syms < 16384)) {
+    v_pos = (self->private_impl.f_strstart & 65535);
+    wuffs_deflate__encoder__add_literal(self,
+                                        self->private_data.f_window[v_pos]);
+    self->private_impl.f_strstart = (v_pos + 1);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.compress_fast
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_fast(wuffs_deflate__encoder* self,
+                                      bool a_flush) {
+  uint32_t v_lookahead = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_x = 0;
+  uint32_t v_h = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_dist = 0;
+  uint32_t v_max = 0;
+  uint32_t v_length = 0;
+  uint32_t v_q = 0;
+  uint32_t v_q_end = 0;
+
+label__0__continue:;
+  while ((self->private_impl.f_strstart < self->private_impl.f_w_end) &&
+         (self->private_impl.f_n_syms < 16384)) {
+    v_lookahead = (self->private_impl.f_w_end - self->private_impl.f_strstart);
+    if ((v_lookahead < 262) && !a_flush) {
+      goto label__0__break;
+    }
+    v_pos = (self->private_impl.f_strstart & 65535);
+    if (v_lookahead < 4) {
+      wuffs_deflate__encoder__add_literal(self,
+                                          self->private_data.f_window[v_pos]);
+      self->private_impl.f_strstart = (v_pos + 1);
+      goto label__0__continue;
+    }
+    v_x = (((uint32_t)(self->private_data.f_window[v_pos])) |
+           (((uint32_t)(self->private_data.f_window[(v_pos + 1)])) << 8) |
+           (((uint32_t)(self->private_data.f_window[(v_pos + 2)])) << 16) |
+           (((uint32_t)(self->private_data.f_window[(v_pos + 3)])) << 24));
+    v_h = ((v_x * 506832829) >> 17);
+    v_cand = ((uint32_t)(self->private_data.f_head[v_h]));
+    self->private_data.f_head[v_h] = ((uint16_t)(v_pos));
+    v_length = 0;
+    v_dist = (v_pos - v_cand);
+    if ((v_cand < v_pos) && (v_dist <= 32768)) {
+      v_max = wuffs_base__u32__min(v_lookahead, 258);
+      v_length =
+          wuffs_deflate__encoder__count_matching(self, v_cand, v_pos, v_max);
+    }
+    if (v_length < 4) {
+      wuffs_deflate__encoder__add_literal(self,
+                                          self->private_data.f_window[v_pos]);
+      self->private_impl.f_strstart = (v_pos + 1);
+      goto label__0__continue;
+    }
+    wuffs_deflate__encoder__add_match(self, v_length,
+                                      wuffs_base__u32__min(v_dist, 32768));
+    if (v_length <= self->private_impl.f_max_lazy) {
+      v_q = v_pos;
+      v_q_end = (v_pos + v_length);
+      while ((v_q + 1) < v_q_end) {
+        if (v_q >= 65535) {
+          goto label__1__break;
+        }
+        v_q += 1;
+        if ((v_q + 3) >= self->private_impl.f_w_end) {
+          goto label__1__break;
+        }
+        v_x = (((uint32_t)(self->private_data.f_window[v_q])) |
+               (((uint32_t)(self->private_data.f_window[(v_q + 1)])) << 8) |
+               (((uint32_t)(self->private_data.f_window[(v_q + 2)])) << 16) |
+               (((uint32_t)(self->private_data.f_window[(v_q + 3)])) << 24));
+        self->private_data.f_head[((v_x * 506832829) >> 17)] =
+            ((uint16_t)(v_q));
+      }
+    label__1__break:;
+    }
+    v_q_end = (v_pos + v_length);
+    self->private_impl.f_strstart = wuffs_base__u32__min(v_q_end, 65536);
+  }
+label__0__break:;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.compress_lazy
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_lazy(wuffs_deflate__encoder* self,
+                                      bool a_flush) {
+  uint32_t v_lookahead = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_h = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_dist = 0;
+  uint32_t v_prev_length = 0;
+  uint32_t v_prev_dist = 0;
+  uint32_t v_max = 0;
+  uint32_t v_q = 0;
+  uint32_t v_q_end = 0;
+
+  while ((self->private_impl.f_strstart < self->private_impl.f_w_end) &&
+         (self->private_impl.f_n_syms < 16384)) {
+    v_lookahead = (self->private_impl.f_w_end - self->private_impl.f_strstart);
+    if ((v_lookahead < 262) && !a_flush) {
+      goto label__0__break;
+    }
+    v_pos = (self->private_impl.f_strstart & 65535);
+    v_cand = 0;
+    if (v_lookahead >= 3) {
+      v_h = (((((uint32_t)(self->private_data.f_window[v_pos])) |
+               (((uint32_t)(self->private_data.f_window[(v_pos + 1)])) << 8) |
+               (((uint32_t)(self->private_data.f_window[(v_pos + 2)])) << 16)) *
+              506832829) >>
+             17);
+      v_cand = ((uint32_t)(self->private_data.f_head[v_h]));
+      self->private_data.f_prev[(v_pos & 32767)] = ((uint16_t)(v_cand));
+      self->private_data.f_head[v_h] = ((uint16_t)(v_pos));
+    }
+    v_prev_length = self->private_impl.f_match_length;
+    v_prev_dist = self->private_impl.f_match_distance;
+    self->private_impl.f_match_length = 0;
+    v_dist = (v_pos - v_cand);
+    if ((v_lookahead >= 3) && (v_prev_length < self->private_impl.f_max_lazy) &&
+        (v_cand < v_pos) && (v_dist <= 32768)) {
+      v_max = wuffs_base__u32__min(v_lookahead, 258);
+      wuffs_deflate__encoder__longest_match(self, v_pos, v_cand, v_max,
+                                            v_prev_length);
+      if ((self->private_impl.f_match_length == 3) &&
+          (self->private_impl.f_match_distance > 4096)) {
+        self->private_impl.f_match_length = 0;
+      }
+    }
+    if ((v_prev_length >= 3) &&
+        (self->private_impl.f_match_length <= v_prev_length) &&
+        (v_prev_dist > 0)) {
+      wuffs_deflate__encoder__add_match(self, v_prev_length, v_prev_dist);
+      v_q = v_pos;
+      v_q_end = ((v_pos + v_prev_length) - 1);
+      while ((v_q + 1) < v_q_end) {
+        if (v_q >= 65535) {
+          goto label__1__break;
+        }
+        v_q += 1;
+        if ((v_q + 2) >= self->private_impl.f_w_end) {
+          goto label__1__break;
+        }
+        v_h = (((((uint32_t)(self->private_data.f_window[v_q])) |
+                 (((uint32_t)(self->private_data.f_window[(v_q + 1)])) << 8) |
+                 (((uint32_t)(self->private_data.f_window[(v_q + 2)])) << 16)) *
+                506832829) >>
+               17);
+        self->private_data.f_prev[(v_q & 32767)] =
+            self->private_data.f_head[v_h];
+        self->private_data.f_head[v_h] = ((uint16_t)(v_q));
+      }
+    label__1__break:;
+      self->private_impl.f_match_available = false;
+      self->private_impl.f_match_length = 0;
+      v_q_end = ((v_pos + v_prev_length) - 1);
+      self->private_impl.f_strstart = wuffs_base__u32__min(v_q_end, 65536);
+    } else if (self->private_impl.f_match_available) {
+      if (v_pos > 0) {
+        wuffs_deflate__encoder__add_literal(
+            self, self->private_data.f_window[(v_pos - 1)]);
+      }
+      self->private_impl.f_strstart = (v_pos + 1);
+    } else {
+      self->private_impl.f_match_available = true;
+      self->private_impl.f_strstart = (v_pos + 1);
+    }
+  }
+label__0__break:;
+  if (a_flush && self->private_impl.f_match_available &&
+      (self->private_impl.f_strstart >= self->private_impl.f_w_end) &&
+      (self->private_impl.f_n_syms < 16384) &&
+      (self->private_impl.f_strstart > 0)) {
+    wuffs_deflate__encoder__add_literal(
+        self, self->private_data
+                  .f_window[((self->private_impl.f_strstart - 1) & 65535)]);
+    self->private_impl.f_match_available = false;
+    self->private_impl.f_match_length = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.longest_match
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_pos,
+                                      uint32_t a_cand,
+                                      uint32_t a_max,
+                                      uint32_t a_prev_length) {
+  uint32_t v_chain = 0;
+  uint32_t v_limit = 0;
+  uint32_t v_nice = 0;
+  uint32_t v_best_len = 0;
+  uint32_t v_cur = 0;
+  uint32_t v_next = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist = 0;
+
+  v_chain = self->private_impl.f_max_chain;
+  if (a_prev_length >= self->private_impl.f_good_length) {
+    v_chain >>= 2;
+  }
+  v_limit = wuffs_base__u32__sat_sub(a_pos, 32768);
+  v_nice = wuffs_base__u32__min(self->private_impl.f_nice_length, a_max);
+  v_best_len = wuffs_base__u32__max(a_prev_length, 2);
+  v_cur = a_cand;
+  while (v_chain > 0) {
+    v_chain -= 1;
+    if ((v_best_len >= a_max) || (v_cur >= a_pos)) {
+      goto label__0__break;
+    }
+    if ((self->private_data.f_window[(v_cur + v_best_len)] ==
+         self->private_data.f_window[(a_pos + v_best_len)]) &&
+        (self->private_data.f_window[v_cur] ==
+         self->private_data.f_window[a_pos])) {
+      v_length =
+          wuffs_deflate__encoder__count_matching(self, v_cur, a_pos, a_max);
+      if (v_length > v_best_len) {
+        v_best_len = v_length;
+        self->private_impl.f_match_length = v_length;
+        v_dist = (a_pos - v_cur);
+        self->private_impl.f_match_distance =
+            wuffs_base__u32__min(v_dist, 32768);
+        if (v_length >= v_nice) {
+          goto label__0__break;
+        }
+      }
+    }
+    v_next = ((uint32_t)(self->private_data.f_prev[(v_cur & 32767)]));
+    if ((v_next >= v_cur) || (v_next <= v_limit)) {
+      goto label__0__break;
+    }
+    v_cur = v_next;
+  }
+label__0__break:;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.write_bits
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst,
+                                   uint32_t a_x,
+                                   uint32_t a_n) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_bits[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_write_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
+    }
+    self->private_impl.f_bits |=
+        (((uint64_t)((a_x & 65535))) << (self->private_impl.f_n_bits & 63));
+    self->private_impl.f_n_bits = ((self->private_impl.f_n_bits & 7) + a_n);
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_write_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_bits[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_bits[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.write_block
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_block_end = 0;
+  uint32_t v_block_start = 0;
+  bool v_stored_ok = false;
+  uint32_t v_type = 0;
+  uint32_t v_header = 0;
+  uint32_t v_i = 0;
+  uint32_t v_x = 0;
+  uint64_t v_n = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_block[0];
+  if (coro_susp_point) {
+    v_block_end = self->private_data.s_write_block[0].v_block_end;
+    v_block_start = self->private_data.s_write_block[0].v_block_start;
+    v_type = self->private_data.s_write_block[0].v_type;
+    v_header = self->private_data.s_write_block[0].v_header;
+    v_i = self->private_data.s_write_block[0].v_i;
+    v_x = self->private_data.s_write_block[0].v_x;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_block_end = self->private_impl.f_strstart;
+    if (self->private_impl.f_match_available) {
+      wuffs_base__u32__sat_sub_indirect(&v_block_end, 1);
+    }
+    v_block_start = (v_block_end - self->private_impl.f_block_len);
+    v_stored_ok = ((self->private_impl.f_block_len <= 65535) &&
+                   (self->private_impl.f_block_len <= v_block_end));
+    self->private_data.f_freqs[256] = 1;
+    v_type = wuffs_deflate__encoder__choose_block_type(self, v_stored_ok);
+    v_header = 0;
+    if (a_final) {
+      v_header = 1;
+    }
+    if (v_type == 0) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_deflate__encoder__write_bits(self, a_dst, v_header, 3);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (self->private_impl.f_n_bits > 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, 0, (8 - (self->private_impl.f_n_bits & 7)));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, (self->private_impl.f_block_len & 65535), 16);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, (65535 ^ (self->private_impl.f_block_len & 65535)), 16);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      while (v_block_start < v_block_end) {
+        if (v_block_end > 65536) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+          goto exit;
+        }
+        v_n = wuffs_base__io_writer__copy_from_slice(
+            &iop_a_dst, io2_a_dst,
+            wuffs_base__slice_u8__subslice_ij(
+                wuffs_base__make_slice_u8(self->private_data.f_window, 65808),
+                v_block_start, v_block_end));
+        v_block_start += ((uint32_t)((v_n & 65535)));
+        if (v_block_start < v_block_end) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+        }
+      }
+    } else {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, (v_header | (v_type << 1)), 3);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (v_type == 2) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, self->private_impl.f_hlit_minus_257, 5);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, self->private_impl.f_hdist_minus_1, 5);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, self->private_impl.f_hclen_minus_4, 4);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        v_i = 0;
+        while (v_i < (self->private_impl.f_hclen_minus_4 + 4)) {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+          status = wuffs_deflate__encoder__write_bits(
+              self, a_dst,
+              ((uint32_t)((
+                  self->private_data.f_lens[(
+                      320 + ((uint32_t)(WUFFS_DEFLATE__CODE_ORDER[v_i])))] &
+                  7))),
+              3);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          v_i += 1;
+        }
+        v_i = 0;
+        while (v_i < self->private_impl.f_n_cl_syms) {
+          v_x = ((uint32_t)(self->private_data.f_cl_syms[v_i]));
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+          status = wuffs_deflate__encoder__write_bits(
+              self, a_dst,
+              ((uint32_t)(self->private_data.f_codes[(320 + (v_x & 31))])),
+              ((uint32_t)((self->private_data.f_lens[(320 + (v_x & 31))] &
+                           15))));
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          if ((v_x & 31) == 16) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+            status =
+                wuffs_deflate__encoder__write_bits(self, a_dst, (v_x >> 5), 2);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          } else if ((v_x & 31) == 17) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+            status =
+                wuffs_deflate__encoder__write_bits(self, a_dst, (v_x >> 5), 3);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          } else if ((v_x & 31) == 18) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+            status =
+                wuffs_deflate__encoder__write_bits(self, a_dst, (v_x >> 5), 7);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+          v_i += 1;
+        }
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+      status = wuffs_deflate__encoder__write_syms(self, a_dst);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    if (a_final) {
+      if (self->private_impl.f_n_bits > 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, 0, (8 - (self->private_impl.f_n_bits & 7)));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      while (self->private_impl.f_n_bits > 0) {
+        self->private_data.s_write_block[0].scratch =
+            ((uint8_t)((self->private_impl.f_bits & 255)));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_block[0].scratch));
+        self->private_impl.f_bits >>= 8;
+        wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_n_bits, 8);
+      }
+    }
+    self->private_impl.f_n_syms = 0;
+    self->private_impl.f_block_len = 0;
+    v_i = 0;
+    while (v_i < 512) {
+      self->private_data.f_freqs[v_i] = 0;
+      v_i += 1;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_block[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_block[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_block[0].v_block_end = v_block_end;
+  self->private_data.s_write_block[0].v_block_start = v_block_start;
+  self->private_data.s_write_block[0].v_type = v_type;
+  self->private_data.s_write_block[0].v_header = v_header;
+  self->private_data.s_write_block[0].v_i = v_i;
+  self->private_data.s_write_block[0].v_x = v_x;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.write_syms
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_syms(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_i = 0;
+  uint32_t v_x = 0;
+  uint32_t v_l = 0;
+  uint32_t v_c = 0;
+  uint32_t v_d = 0;
+  uint32_t v_dc = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_syms[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_write_syms[0].v_bits;
+    v_n_bits = self->private_data.s_write_syms[0].v_n_bits;
+    v_i = self->private_data.s_write_syms[0].v_i;
+    v_x = self->private_data.s_write_syms[0].v_x;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+  label__0__continue:;
+    while (v_i < self->private_impl.f_n_syms) {
+      v_x = self->private_data.f_syms[v_i];
+      v_i += 1;
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) >= 8) {
+        if ((v_n_bits & 63) >= 32) {
+          (wuffs_base__store_u32le__no_bounds_check(
+               iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+           iop_a_dst += 4, wuffs_base__make_empty_struct());
+          v_bits >>= 32;
+          v_n_bits = ((v_n_bits & 63) - 32);
+        }
+      } else {
+        while (v_n_bits >= 8) {
+          self->private_data.s_write_syms[0].scratch =
+              ((uint8_t)((v_bits & 255)));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (iop_a_dst == io2_a_dst) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            goto suspend;
+          }
+          *iop_a_dst++ =
+              ((uint8_t)(self->private_data.s_write_syms[0].scratch));
+          v_bits >>= 8;
+          v_n_bits -= 8;
+        }
+      }
+      if ((v_x >> 31) == 0) {
+        v_bits |= (((uint64_t)(self->private_data.f_codes[(v_x & 255)]))
+                   << (v_n_bits & 63));
+        v_n_bits += ((uint32_t)((self->private_data.f_lens[(v_x & 255)] & 15)));
+        goto label__0__continue;
+      }
+      v_l = (v_x & 255);
+      v_c = ((uint32_t)(WUFFS_DEFLATE__LENGTH_CODES[v_l]));
+      v_bits |= (((uint64_t)(self->private_data.f_codes[(257 + v_c)]))
+                 << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)((self->private_data.f_lens[(257 + v_c)] & 15)));
+      v_bits |=
+          (((uint64_t)((
+               v_l - ((uint32_t)(WUFFS_DEFLATE__LENGTH_BASES_MINUS_3[v_c])))))
+           << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)(WUFFS_DEFLATE__LENGTH_EXTRAS[v_c]));
+      if (((v_n_bits & 63) >= 32) &&
+          (((uint64_t)(io2_a_dst - iop_a_dst)) >= 4)) {
+        (wuffs_base__store_u32le__no_bounds_check(
+             iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+         iop_a_dst += 4, wuffs_base__make_empty_struct());
+        v_bits >>= 32;
+        v_n_bits = ((v_n_bits & 63) - 32);
+      }
+      v_d = ((v_x >> 8) & 32767);
+      if (v_d < 256) {
+        v_dc = ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[v_d]));
+      } else {
+        v_dc = ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[(256 + (v_d >> 7))]));
+      }
+      v_bits |= (((uint64_t)(self->private_data.f_codes[(288 + v_dc)]))
+                 << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)((self->private_data.f_lens[(288 + v_dc)] & 15)));
+      v_bits |=
+          (((uint64_t)((
+               v_d -
+               ((uint32_t)(WUFFS_DEFLATE__DISTANCE_BASES_MINUS_1[v_dc])))))
+           << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)(WUFFS_DEFLATE__DISTANCE_EXTRAS[v_dc]));
+    }
+    while (v_n_bits >= 8) {
+      self->private_data.s_write_syms[0].scratch = ((uint8_t)((v_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_syms[0].scratch));
+      v_bits >>= 8;
+      v_n_bits -= 8;
+    }
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_deflate__encoder__write_bits(
+        self, a_dst, ((uint32_t)(self->private_data.f_codes[256])),
+        ((uint32_t)((self->private_data.f_lens[256] & 15))));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_syms[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_syms[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_syms[0].v_bits = v_bits;
+  self->private_data.s_write_syms[0].v_n_bits = v_n_bits;
+  self->private_data.s_write_syms[0].v_i = v_i;
+  self->private_data.s_write_syms[0].v_x = v_x;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.choose_block_type
+
+static uint32_t  //
+wuffs_deflate__encoder__choose_block_type(wuffs_deflate__encoder* self,
+                                          bool a_stored_ok) {
+  uint64_t v_dynamic_cost = 0;
+  uint64_t v_fixed_cost = 0;
+  uint64_t v_stored_cost = 0;
+  uint32_t v_i = 0;
+  uint64_t v_f = 0;
+  uint32_t v_x = 0;
+
+  if (self->private_impl.f_level == 0) {
+    if (a_stored_ok) {
+      return 0;
+    }
+  }
+  wuffs_deflate__encoder__build_huffman(self, 0, 288, 15);
+  wuffs_deflate__encoder__build_huffman(self, 288, 32, 15);
+  wuffs_deflate__encoder__build_cl_syms(self);
+  wuffs_deflate__encoder__build_huffman(self, 320, 19, 7);
+  self->private_impl.f_hclen_minus_4 = 15;
+  while (self->private_impl.f_hclen_minus_4 > 0) {
+    if (self->private_data
+            .f_lens[(320 + ((uint32_t)(WUFFS_DEFLATE__CODE_ORDER[(
+                               self->private_impl.f_hclen_minus_4 + 3)])))] !=
+        0) {
+      goto label__0__break;
+    }
+    self->private_impl.f_hclen_minus_4 -= 1;
+  }
+label__0__break:;
+  v_dynamic_cost =
+      (17 + (3 * ((uint64_t)((self->private_impl.f_hclen_minus_4 + 4)))));
+  v_fixed_cost = 3;
+  v_i = 0;
+  while (v_i < self->private_impl.f_n_cl_syms) {
+    v_x = (((uint32_t)(self->private_data.f_cl_syms[v_i])) & 31);
+    v_dynamic_cost += ((uint64_t)(self->private_data.f_lens[(320 + v_x)]));
+    if (v_x == 16) {
+      v_dynamic_cost += 2;
+    } else if (v_x == 17) {
+      v_dynamic_cost += 3;
+    } else if (v_x == 18) {
+      v_dynamic_cost += 7;
+    }
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 288) {
+    v_f = ((uint64_t)(self->private_data.f_freqs[v_i]));
+    v_dynamic_cost += (v_f * ((uint64_t)(self->private_data.f_lens[v_i])));
+    if (v_i < 144) {
+      v_fixed_cost += (v_f * 8);
+    } else if (v_i < 256) {
+      v_fixed_cost += (v_f * 9);
+    } else if (v_i < 280) {
+      v_fixed_cost += (v_f * 7);
+    } else {
+      v_fixed_cost += (v_f * 8);
+    }
+    if (v_i >= 257) {
+      v_f = (v_f *
+             ((uint64_t)(WUFFS_DEFLATE__LENGTH_EXTRAS[((v_i - 257) & 31)])));
+      v_dynamic_cost += v_f;
+      v_fixed_cost += v_f;
+    }
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 32) {
+    v_f = ((uint64_t)(self->private_data.f_freqs[(288 + v_i)]));
+    v_dynamic_cost +=
+        (v_f * (((uint64_t)(self->private_data.f_lens[(288 + v_i)])) +
+                ((uint64_t)(WUFFS_DEFLATE__DISTANCE_EXTRAS[v_i]))));
+    v_fixed_cost +=
+        (v_f * (5 + ((uint64_t)(WUFFS_DEFLATE__DISTANCE_EXTRAS[v_i]))));
+    v_i += 1;
+  }
+  if (a_stored_ok) {
+    v_stored_cost = (42 + (8 * ((uint64_t)(self->private_impl.f_block_len))));
+    if ((v_stored_cost <= v_dynamic_cost) && (v_stored_cost <= v_fixed_cost)) {
+      return 0;
+    }
+  }
+  if (v_dynamic_cost < v_fixed_cost) {
+    return 2;
+  }
+  v_i = 0;
+  while (v_i < 144) {
+    self->private_data.f_lens[v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 256) {
+    self->private_data.f_lens[v_i] = 9;
+    v_i += 1;
+  }
+  while (v_i < 280) {
+    self->private_data.f_lens[v_i] = 7;
+    v_i += 1;
+  }
+  while (v_i < 288) {
+    self->private_data.f_lens[v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 320) {
+    self->private_data.f_lens[v_i] = 5;
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__assign_codes(self, 0, 288);
+  wuffs_deflate__encoder__assign_codes(self, 288, 32);
+  return 1;
+}
+
+// -------- func deflate.encoder.lit_dist_len
+
+static uint32_t  //
+wuffs_deflate__encoder__lit_dist_len(const wuffs_deflate__encoder* self,
+                                     uint32_t a_k) {
+  if (a_k < (self->private_impl.f_hlit_minus_257 + 257)) {
+    return ((uint32_t)((self->private_data.f_lens[(a_k & 511)] & 15)));
+  }
+  return ((uint32_t)((
+      self->private_data
+          .f_lens[(((a_k + 31) - self->private_impl.f_hlit_minus_257) & 511)] &
+      15)));
+}
+
+// -------- func deflate.encoder.build_cl_syms
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_cl_syms(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+  uint32_t v_total = 0;
+  uint32_t v_k = 0;
+  uint32_t v_v = 0;
+  uint32_t v_run = 0;
+  uint32_t v_r = 0;
+  uint32_t v_step = 0;
+  uint32_t v_t = 0;
+
+  self->private_impl.f_hlit_minus_257 = 29;
+  while (self->private_impl.f_hlit_minus_257 > 0) {
+    if (self->private_data
+            .f_lens[(256 + self->private_impl.f_hlit_minus_257)] != 0) {
+      goto label__0__break;
+    }
+    self->private_impl.f_hlit_minus_257 -= 1;
+  }
+label__0__break:;
+  self->private_impl.f_hdist_minus_1 = 29;
+  while (self->private_impl.f_hdist_minus_1 > 0) {
+    if (self->private_data.f_lens[(288 + self->private_impl.f_hdist_minus_1)] !=
+        0) {
+      goto label__1__break;
+    }
+    self->private_impl.f_hdist_minus_1 -= 1;
+  }
+label__1__break:;
+  v_i = 0;
+  while (v_i < 19) {
+    self->private_data.f_freqs[(320 + v_i)] = 0;
+    v_i += 1;
+  }
+  self->private_impl.f_n_cl_syms = 0;
+  v_total = (self->private_impl.f_hlit_minus_257 + 257 +
+             self->private_impl.f_hdist_minus_1 + 1);
+  v_k = 0;
+  while (v_k < v_total) {
+    v_v = wuffs_deflate__encoder__lit_dist_len(self, v_k);
+    v_run = 1;
+    while (((v_k + v_run) < v_total) && (v_run < 138)) {
+      if (wuffs_deflate__encoder__lit_dist_len(self, (v_k + v_run)) != v_v) {
+        goto label__2__break;
+      }
+      v_run += 1;
+    }
+  label__2__break:;
+    if ((v_v == 0) && (v_run >= 3)) {
+      if (v_run <= 10) {
+        wuffs_deflate__encoder__add_cl_sym(self, 17, (v_run - 3));
+      } else {
+        wuffs_deflate__encoder__add_cl_sym(self, 18, (v_run - 11));
+      }
+      v_step = v_run;
+    } else if (v_run >= 4) {
+      wuffs_deflate__encoder__add_cl_sym(self, v_v, 0);
+      v_r = (v_run - 1);
+      v_r = wuffs_base__u32__min(v_r, 6);
+      wuffs_deflate__encoder__add_cl_sym(self, 16, (v_r - 3));
+      v_step = (1 + v_r);
+    } else {
+      wuffs_deflate__encoder__add_cl_sym(self, v_v, 0);
+      v_step = 1;
+    }
+    v_t = (v_k + v_step);
+    v_k = wuffs_base__u32__min(v_t, 320);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_cl_sym
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_cl_sym(wuffs_deflate__encoder* self,
+                                   uint32_t a_sym,
+                                   uint32_t a_extra) {
+  if (self->private_impl.f_n_cl_syms < 320) {
+    self->private_data.f_cl_syms[self->private_impl.f_n_cl_syms] =
+        ((uint16_t)(((a_extra << 5) | a_sym)));
+    self->private_impl.f_n_cl_syms += 1;
+  }
+  self->private_data.f_freqs[(320 + a_sym)] += 1;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_huffman
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_offset,
+                                      uint32_t a_n,
+                                      uint32_t a_max_len) {
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_m = 0;
+  uint32_t v_key = 0;
+  uint32_t v_root = 0;
+  uint32_t v_leaf = 0;
+  uint32_t v_next = 0;
+  uint32_t v_avbl = 0;
+  uint32_t v_used = 0;
+  uint32_t v_depth = 0;
+  uint32_t v_total = 0;
+  uint32_t v_len = 0;
+  uint8_t v_len_u8 = 0;
+  uint32_t v_c = 0;
+
+  v_i = 0;
+  while (v_i < a_n) {
+    self->private_data.f_lens[((a_offset + v_i) & 511)] = 0;
+    if (self->private_data.f_freqs[((a_offset + v_i) & 511)] != 0) {
+      v_m += 1;
+    }
+    v_i += 1;
+  }
+  if (v_m < 2) {
+    if (self->private_data.f_freqs[a_offset] == 0) {
+      self->private_data.f_freqs[a_offset] = 1;
+    }
+    if (self->private_data.f_freqs[(a_offset + 1)] == 0) {
+      self->private_data.f_freqs[(a_offset + 1)] = 1;
+    }
+  }
+  v_m = 0;
+  v_i = 0;
+  while (v_i < a_n) {
+    v_key = self->private_data.f_freqs[((a_offset + v_i) & 511)];
+    if (v_key != 0) {
+      v_key = ((wuffs_base__u32__min(v_key, 8388607) << 9) | v_i);
+      v_j = v_m;
+      while (v_j > 0) {
+        if (self->private_data.f_h_keys[((v_j - 1) & 511)] <= v_key) {
+          goto label__0__break;
+        }
+        self->private_data.f_h_keys[(v_j & 511)] =
+            self->private_data.f_h_keys[((v_j - 1) & 511)];
+        v_j -= 1;
+      }
+    label__0__break:;
+      self->private_data.f_h_keys[(v_j & 511)] = v_key;
+      v_m += 1;
+    }
+    v_i += 1;
+  }
+  if (v_m < 2) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_i = 0;
+  while (v_i < v_m) {
+    self->private_data.f_h_depths[(v_i & 511)] =
+        (self->private_data.f_h_keys[(v_i & 511)] >> 9);
+    v_i += 1;
+  }
+  self->private_data.f_h_depths[0] += self->private_data.f_h_depths[1];
+  v_root = 0;
+  v_leaf = 2;
+  v_next = 1;
+  while (v_next < (v_m - 1)) {
+    if ((v_leaf >= v_m) || (self->private_data.f_h_depths[(v_root & 511)] <
+                            self->private_data.f_h_depths[(v_leaf & 511)])) {
+      self->private_data.f_h_depths[(v_next & 511)] =
+          self->private_data.f_h_depths[(v_root & 511)];
+      self->private_data.f_h_depths[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_h_depths[(v_next & 511)] =
+          self->private_data.f_h_depths[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    if ((v_leaf >= v_m) || ((v_root < v_next) &&
+                            (self->private_data.f_h_depths[(v_root & 511)] <
+                             self->private_data.f_h_depths[(v_leaf & 511)]))) {
+      self->private_data.f_h_depths[(v_next & 511)] +=
+          self->private_data.f_h_depths[(v_root & 511)];
+      self->private_data.f_h_depths[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_h_depths[(v_next & 511)] +=
+          self->private_data.f_h_depths[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    v_next += 1;
+  }
+  v_next = (v_m - 2);
+  self->private_data.f_h_depths[(v_next & 511)] = 0;
+  while (v_next > 0) {
+    v_next -= 1;
+    self->private_data.f_h_depths[(v_next & 511)] =
+        (self->private_data.f_h_depths[(
+             self->private_data.f_h_depths[(v_next & 511)] & 511)] +
+         1);
+  }
+  v_avbl = 1;
+  v_used = 0;
+  v_depth = 0;
+  v_root = (v_m - 1);
+  v_next = v_m;
+  while ((v_avbl > 0) && (v_depth < 32)) {
+    while ((v_root > 0) &&
+           (self->private_data.f_h_depths[((v_root - 1) & 511)] == v_depth)) {
+      v_used += 1;
+      v_root -= 1;
+    }
+    while ((v_avbl > v_used) && (v_next > 0)) {
+      v_next -= 1;
+      self->private_data.f_h_depths[(v_next & 511)] = v_depth;
+      v_avbl -= 1;
+    }
+    v_avbl = (v_used * 2);
+    v_depth += 1;
+    v_used = 0;
+  }
+  v_i = 0;
+  while (v_i < 16) {
+    self->private_data.f_h_counts[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < v_m) {
+    self->private_data.f_h_counts[wuffs_base__u32__min(
+        self->private_data.f_h_depths[(v_i & 511)], a_max_len)] += 1;
+    v_i += 1;
+  }
+  v_total = 0;
+  v_i = a_max_len;
+  while (v_i > 0) {
+    v_total +=
+        (self->private_data.f_h_counts[(v_i & 15)] << ((a_max_len - v_i) & 31));
+    v_i -= 1;
+  }
+  while (v_total > (((uint32_t)(1)) << a_max_len)) {
+    self->private_data.f_h_counts[a_max_len] -= 1;
+    v_i = (a_max_len - 1);
+    while (v_i > 0) {
+      if (self->private_data.f_h_counts[(v_i & 15)] != 0) {
+        self->private_data.f_h_counts[(v_i & 15)] -= 1;
+        self->private_data.f_h_counts[((v_i + 1) & 15)] += 2;
+        goto label__1__break;
+      }
+      v_i -= 1;
+    }
+  label__1__break:;
+    v_total -= 1;
+  }
+  v_j = 0;
+  v_len = a_max_len;
+  while (v_len > 0) {
+    v_c = self->private_data.f_h_counts[v_len];
+    v_len_u8 = ((uint8_t)(v_len));
+    v_len -= 1;
+    while (v_c > 0) {
+      self->private_data.f_lens[(
+          (a_offset + (self->private_data.f_h_keys[(v_j & 511)] & 511)) &
+          511)] = v_len_u8;
+      v_j += 1;
+      v_c -= 1;
+    }
+  }
+  wuffs_deflate__encoder__assign_codes(self, a_offset, a_n);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.assign_codes
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_offset,
+                                     uint32_t a_n) {
+  uint32_t v_i = 0;
+  uint32_t v_code = 0;
+  uint32_t v_len = 0;
+
+  v_i = 0;
+  while (v_i < 16) {
+    self->private_data.f_h_counts[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n) {
+    self->private_data.f_h_counts[(
+        self->private_data.f_lens[((a_offset + v_i) & 511)] & 15)] += 1;
+    v_i += 1;
+  }
+  self->private_data.f_h_counts[0] = 0;
+  v_code = 0;
+  v_i = 1;
+  while (v_i < 16) {
+    v_code = ((v_code + self->private_data.f_h_counts[((v_i - 1) & 15)]) << 1);
+    self->private_data.f_h_next_codes[v_i] = v_code;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n) {
+    v_len = ((
+        uint32_t)((self->private_data.f_lens[((a_offset + v_i) & 511)] & 15)));
+    if (v_len != 0) {
+      v_code = self->private_data.f_h_next_codes[v_len];
+      self->private_data.f_h_next_codes[v_len] = (v_code + 1);
+      v_code = ((((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_code & 255)])) << 8) |
+                ((uint32_t)(WUFFS_DEFLATE__REVERSE8[((v_code >> 8) & 255)])));
+      self->private_data.f_codes[((a_offset + v_i) & 511)] =
+          ((uint16_t)(((v_code >> (16 - v_len)) & 65535)));
+    }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__DEFLATE)
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// !! WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__DEFLATE
@@ -0,0 +1,1380 @@
+#ifndef WUFFS_INCLUDE_GUARD__GZIP
+#define WUFFS_INCLUDE_GUARD__GZIP
+
+#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__GZIP
+#endif
+
+#include "./wuffs-base.c"
+#include "./wuffs-std-crc32.c"
+#include "./wuffs-std-deflate.c"
+
+// !! WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Status Codes
+
+extern const char* wuffs_gzip__error__bad_checksum;
+extern const char* wuffs_gzip__error__bad_compression_method;
+extern const char* wuffs_gzip__error__bad_encoding_flags;
+extern const char* wuffs_gzip__error__bad_header;
+
+// ---------------- Public Consts
+
+#define WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
+
+#define WUFFS_GZIP__QUIRK_MULTIPLE_MEMBERS 1066916864
+
+#define WUFFS_GZIP__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_gzip__decoder__struct wuffs_gzip__decoder;
+
+typedef struct wuffs_gzip__encoder__struct wuffs_gzip__encoder;
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for initialize_flags.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_gzip__decoder();
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__encoder__initialize(wuffs_gzip__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_gzip__encoder();
+
+// ---------------- Allocs
+
+// These functions allocate and initialize Wuffs structs. They return NULL if
+// memory allocation fails. If they return non-NULL, there is no need to call
+// wuffs_foo__bar__initialize, but the caller is responsible for eventually
+// calling free on the returned pointer. That pointer is effectively a C++
+// std::unique_ptr<T, decltype(&free)>.
+
+wuffs_gzip__decoder*  //
+wuffs_gzip__decoder__alloc();
+
+static inline wuffs_base__io_transformer*  //
+wuffs_gzip__decoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_gzip__decoder__alloc());
+}
+
+wuffs_gzip__encoder*  //
+wuffs_gzip__encoder__alloc();
+
+static inline wuffs_base__io_transformer*  //
+wuffs_gzip__encoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_gzip__encoder__alloc());
+}
+
+// ---------------- Upcasts
+
+static inline wuffs_base__io_transformer*  //
+wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_gzip__decoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+static inline wuffs_base__io_transformer*  //
+wuffs_gzip__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_gzip__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+// ---------------- Public Function Prototypes
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_quirk_enabled(wuffs_gzip__decoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_quirk_enabled(wuffs_gzip__encoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_level(wuffs_gzip__encoder* self, uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__encoder__workbuf_len(const wuffs_gzip__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__encoder__transform_io(wuffs_gzip__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf);
+
+// ---------------- Struct Definitions
+
+// These structs' fields, and the sizeof them, are private implementation
+// details that aren't guaranteed to be stable across Wuffs versions.
+//
+// See https://en.wikipedia.org/wiki/Opaque_pointer#C
+
+#if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+struct wuffs_gzip__decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    bool f_quirks[1];
+    bool f_ignore_checksum;
+
+    uint32_t p_transform_io[1];
+  } private_impl;
+
+  struct {
+    wuffs_crc32__ieee_hasher f_checksum;
+    wuffs_deflate__decoder f_flate;
+
+    struct {
+      uint8_t v_flags;
+      uint32_t v_checksum_got;
+      uint32_t v_decoded_length_got;
+      uint32_t v_checksum_want;
+      uint64_t scratch;
+    } s_transform_io[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_gzip__decoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_gzip__decoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr  //
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_gzip__decoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // __cplusplus >= 201103L
+
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gzip__decoder__struct() = delete;
+  wuffs_gzip__decoder__struct(const wuffs_gzip__decoder__struct&) = delete;
+  wuffs_gzip__decoder__struct& operator=(const wuffs_gzip__decoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_gzip__decoder__initialize(this, sizeof_star_self,
+                                           wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_ignore_checksum(bool a_ic) {
+    return wuffs_gzip__decoder__set_ignore_checksum(this, a_ic);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_gzip__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_gzip__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_gzip__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_gzip__decoder__struct
+
+struct wuffs_gzip__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_level_plus_1;
+
+    uint32_t p_transform_io[1];
+  } private_impl;
+
+  struct {
+    wuffs_crc32__ieee_hasher f_checksum;
+    wuffs_deflate__encoder f_flate;
+
+    struct {
+      uint8_t v_xfl;
+      uint32_t v_checksum_got;
+      uint32_t v_src_length;
+      uint64_t scratch;
+    } s_transform_io[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_gzip__encoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_gzip__encoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr  //
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_gzip__encoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // __cplusplus >= 201103L
+
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gzip__encoder__struct() = delete;
+  wuffs_gzip__encoder__struct(const wuffs_gzip__encoder__struct&) = delete;
+  wuffs_gzip__encoder__struct& operator=(const wuffs_gzip__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_gzip__encoder__initialize(this, sizeof_star_self,
+                                           wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_gzip__encoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_level) {
+    return wuffs_gzip__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_gzip__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_gzip__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_gzip__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GZIP)
+
+// ---------------- Status Codes Implementations
+
+const char* wuffs_gzip__error__bad_checksum = "#gzip: bad checksum";
+const char* wuffs_gzip__error__bad_compression_method =
+    "#gzip: bad compression method";
+const char* wuffs_gzip__error__bad_encoding_flags = "#gzip: bad encoding flags";
+const char* wuffs_gzip__error__bad_header = "#gzip: bad header";
+
+// ---------------- Private Consts
+
+#define WUFFS_GZIP__QUIRKS_BASE 1066916864
+
+#define WUFFS_GZIP__QUIRKS_COUNT 1
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gzip__decoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_gzip__decoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gzip__decoder__workbuf_len),
+};
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_gzip__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gzip__encoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_gzip__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gzip__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_gzip__decoder*  //
+wuffs_gzip__decoder__alloc() {
+  wuffs_gzip__decoder* x =
+      (wuffs_gzip__decoder*)(calloc(sizeof(wuffs_gzip__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gzip__decoder__initialize(x, sizeof(wuffs_gzip__decoder),
+                                      WUFFS_VERSION,
+                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_gzip__decoder() {
+  return sizeof(wuffs_gzip__decoder);
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__encoder__initialize(wuffs_gzip__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__encoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_gzip__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_gzip__encoder*  //
+wuffs_gzip__encoder__alloc() {
+  wuffs_gzip__encoder* x =
+      (wuffs_gzip__encoder*)(calloc(sizeof(wuffs_gzip__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gzip__encoder__initialize(x, sizeof(wuffs_gzip__encoder),
+                                      WUFFS_VERSION,
+                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_gzip__encoder() {
+  return sizeof(wuffs_gzip__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func gzip.decoder.set_ignore_checksum
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_ignore_checksum = a_ic;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_quirk_enabled(wuffs_gzip__decoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  uint32_t v_q = 0;
+
+  if (a_quirk >= 1066916864) {
+    v_q = (a_quirk - 1066916864);
+    if (v_q < 1) {
+      self->private_impl.f_quirks[v_q] = a_enabled;
+      return wuffs_base__make_empty_struct();
+    }
+  }
+  wuffs_deflate__decoder__set_quirk_enabled(&self->private_data.f_flate,
+                                            a_quirk, a_enabled);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(1, 1);
+}
+
+// -------- func gzip.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_flags = 0;
+  uint16_t v_xlen = 0;
+  uint64_t v_mark = 0;
+  uint32_t v_checksum_got = 0;
+  uint32_t v_decoded_length_got = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_want = 0;
+  uint32_t v_decoded_length_want = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_flags = self->private_data.s_transform_io[0].v_flags;
+    v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
+    v_decoded_length_got =
+        self->private_data.s_transform_io[0].v_decoded_length_got;
+    v_checksum_want = self->private_data.s_transform_io[0].v_checksum_want;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
+      }
+      if (v_c != 31) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_1 = *iop_a_src++;
+        v_c = t_1;
+      }
+      if (v_c != 139) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_2 = *iop_a_src++;
+        v_c = t_2;
+      }
+      if (v_c != 8) {
+        status =
+            wuffs_base__make_status(wuffs_gzip__error__bad_compression_method);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_3 = *iop_a_src++;
+        v_flags = t_3;
+      }
+      self->private_data.s_transform_io[0].scratch = 6;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_transform_io[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_transform_io[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_transform_io[0].scratch;
+      if ((v_flags & 4) != 0) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          uint16_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_transform_io[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint16_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          v_xlen = t_4;
+        }
+        self->private_data.s_transform_io[0].scratch = ((uint32_t)(v_xlen));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
+      }
+      if ((v_flags & 8) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_5 = *iop_a_src++;
+            v_c = t_5;
+          }
+          if (v_c == 0) {
+            goto label__0__break;
+          }
+        }
+      label__0__break:;
+      }
+      if ((v_flags & 16) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_6 = *iop_a_src++;
+            v_c = t_6;
+          }
+          if (v_c == 0) {
+            goto label__1__break;
+          }
+        }
+      label__1__break:;
+      }
+      if ((v_flags & 2) != 0) {
+        self->private_data.s_transform_io[0].scratch = 2;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
+      }
+      if ((v_flags & 224) != 0) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_encoding_flags);
+        goto exit;
+      }
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+        {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          wuffs_base__status t_7 = wuffs_deflate__decoder__transform_io(
+              &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          v_status = t_7;
+        }
+        if (!self->private_impl.f_ignore_checksum) {
+          v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
+              &self->private_data.f_checksum,
+              wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                    io0_a_dst));
+          v_decoded_length_got +=
+              ((uint32_t)((wuffs_base__io__count_since(
+                               v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))) &
+                           4294967295)));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__2__break;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(12);
+      }
+    label__2__break:;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+        uint32_t t_8;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_8 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
+            if (num_bits_8 == 24) {
+              t_8 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_8 += 8;
+            *scratch |= ((uint64_t)(num_bits_8)) << 56;
+          }
+        }
+        v_checksum_want = t_8;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+        uint32_t t_9;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_9 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_9 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_9;
+            if (num_bits_9 == 24) {
+              t_9 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_9 += 8;
+            *scratch |= ((uint64_t)(num_bits_9)) << 56;
+          }
+        }
+        v_decoded_length_want = t_9;
+      }
+      if (!self->private_impl.f_ignore_checksum &&
+          ((v_checksum_got != v_checksum_want) ||
+           (v_decoded_length_got != v_decoded_length_want))) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
+        goto exit;
+      }
+      v_decoded_length_got = 0;
+      wuffs_crc32__ieee_hasher__restart(&self->private_data.f_checksum);
+      if (!self->private_impl.f_quirks[0]) {
+        goto label__3__break;
+      }
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(NULL);
+          goto ok;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(17);
+      }
+    }
+  label__3__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_flags = v_flags;
+  self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
+  self->private_data.s_transform_io[0].v_decoded_length_got =
+      v_decoded_length_got;
+  self->private_data.s_transform_io[0].v_checksum_want = v_checksum_want;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gzip.encoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_quirk_enabled(wuffs_gzip__encoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.encoder.set_level
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_level(wuffs_gzip__encoder* self, uint32_t a_level) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_level > 9) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_level_plus_1 = (a_level + 1);
+  wuffs_deflate__encoder__set_level(&self->private_data.f_flate, a_level);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.encoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__encoder__workbuf_len(const wuffs_gzip__encoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func gzip.encoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__encoder__transform_io(wuffs_gzip__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_xfl = 0;
+  uint64_t v_mark = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_got = 0;
+  uint32_t v_src_length = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_xfl = self->private_data.s_transform_io[0].v_xfl;
+    v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
+    v_src_length = self->private_data.s_transform_io[0].v_src_length;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_xfl = 0;
+    if (self->private_impl.f_level_plus_1 == 10) {
+      v_xfl = 2;
+    } else if (self->private_impl.f_level_plus_1 == 2) {
+      v_xfl = 4;
+    }
+    self->private_data.s_transform_io[0].scratch = 31;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 139;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 8;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = v_xfl;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 255;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    while (true) {
+      v_mark = ((uint64_t)(iop_a_src - io0_a_src));
+      {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        wuffs_base__status t_0 = wuffs_deflate__encoder__transform_io(
+            &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        v_status = t_0;
+      }
+      v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
+          &self->private_data.f_checksum,
+          wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_src - io0_a_src)),
+                                io0_a_src));
+      v_src_length +=
+          ((uint32_t)((wuffs_base__io__count_since(
+                           v_mark, ((uint64_t)(iop_a_src - io0_a_src))) &
+                       4294967295)));
+      if (wuffs_base__status__is_ok(&v_status)) {
+        goto label__0__break;
+      }
+      status = v_status;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+    }
+  label__0__break:;
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)((v_checksum_got & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 8) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 16) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 24) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)((v_src_length & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_src_length >> 8) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_src_length >> 16) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_src_length >> 24) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(19);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_xfl = v_xfl;
+  self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
+  self->private_data.s_transform_io[0].v_src_length = v_src_length;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__GZIP)
+
+#endif  // WUFFS_IMPLEMENTATION
+
+// !! WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING BELOW.
+
+#endif  // WUFFS_INCLUDE_GUARD__GZIP
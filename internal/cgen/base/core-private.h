@@ -73,6 +73,43 @@ wuffs_base__ignore_status(wuffs_base__status z) {
 #define WUFFS_BASE__UNLIKELY(expr) (expr)
 #endif
 
+// ---------------- CPU Architecture
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__cpu_arch__have_x86_sse42 returns whether the CPU supports the
+// PCLMUL, POPCNT, SSE4.2 (and implied SSE4.1 and SSSE3) instructions. Functions
+// marked with the WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+// attribute can only be called when this returns true.
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_sse42() {
+#if defined(__PCLMUL__) && defined(__POPCNT__) && defined(__SSE4_2__)
+  // The compiler already assumes that the CPU has these features.
+  return true;
+#else
+  // __builtin_cpu_supports reads CPUID results that the compiler's run-time
+  // library caches at program start-up. Executing the CPUID instruction here
+  // instead can be surprisingly slow, especially under virtualization.
+  return __builtin_cpu_supports("pclmul") &&
+         __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+// wuffs_base__cpu_arch__have_x86_avx2 returns whether the CPU supports the
+// AVX2 instructions. Functions marked with the
+// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("avx2") attribute can only be called when
+// this returns true.
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_avx2() {
+#if defined(__AVX2__)
+  return true;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- Numeric Types
 
 extern const uint8_t wuffs_base__low_bits_mask__u8[9];
@@ -76,6 +76,32 @@
 #define WUFFS_BASE__WARN_UNUSED_RESULT
 #endif
 
+// --------
+
+// Define WUFFS_CONFIG__AVOID_CPU_ARCH to avoid any code tied to a specific CPU
+// architecture, such as SSE SIMD for the x86 CPU family.
+#if defined(WUFFS_CONFIG__AVOID_CPU_ARCH)
+// No-op.
+#else
+// Clang also defines "__GNUC__".
+#if defined(__GNUC__) && defined(__x86_64__)
+#define WUFFS_BASE__CPU_ARCH__X86_64
+#endif
+#endif
+
+// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET marks a function as being compiled for a
+// specific CPU feature set (such as "pclmul,popcnt,sse4.2"), even if the rest
+// of the program is not. Such functions are only called after a run-time check
+// that the CPU supports those features.
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+#include <immintrin.h>
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg) __attribute__((target(arg)))
+#else
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg)
+#endif
+
+// --------
+
 // Flags for wuffs_foo__bar__initialize functions.
 
 #define WUFFS_INITIALIZE__DEFAULT_OPTIONS ((uint32_t)0x00000000)
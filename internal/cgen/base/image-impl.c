@@ -59,6 +59,42 @@ wuffs_base__composite_premul_nonpremul_u32_axxx(uint32_t dst_premul,
   return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);
 }
 
+static inline uint32_t  //
+wuffs_base__composite_premul_premul_u32_axxx(uint32_t dst_premul,
+                                             uint32_t src_premul) {
+  // Convert from 8-bit color to 16-bit color.
+  uint32_t sa = 0x101 * (0xFF & (src_premul >> 24));
+  uint32_t sr = 0x101 * (0xFF & (src_premul >> 16));
+  uint32_t sg = 0x101 * (0xFF & (src_premul >> 8));
+  uint32_t sb = 0x101 * (0xFF & (src_premul >> 0));
+  uint32_t da = 0x101 * (0xFF & (dst_premul >> 24));
+  uint32_t dr = 0x101 * (0xFF & (dst_premul >> 16));
+  uint32_t dg = 0x101 * (0xFF & (dst_premul >> 8));
+  uint32_t db = 0x101 * (0xFF & (dst_premul >> 0));
+
+  // Calculate the inverse of the src-alpha: how much of the dst to keep.
+  uint32_t ia = 0xFFFF - sa;
+
+  // Composite src (premul) over dst (premul).
+  da = sa + ((da * ia) / 0xFFFF);
+  dr = sr + ((dr * ia) / 0xFFFF);
+  dg = sg + ((dg * ia) / 0xFFFF);
+  db = sb + ((db * ia) / 0xFFFF);
+
+  // Valid premul colors are no greater than their alpha, so these sums are
+  // at most 0xFFFF, but clamp them in case the src or dst is invalid.
+  dr = (dr < 0xFFFF) ? dr : 0xFFFF;
+  dg = (dg < 0xFFFF) ? dg : 0xFFFF;
+  db = (db < 0xFFFF) ? db : 0xFFFF;
+
+  // Convert from 16-bit color to 8-bit color and combine the components.
+  da >>= 8;
+  dr >>= 8;
+  dg >>= 8;
+  db >>= 8;
+  return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);
+}
+
 static inline uint32_t  //
 wuffs_base__premul_u32_axxx(uint32_t nonpremul) {
   // Multiplying by 0x101 (twice, once for alpha and once for color) converts
@@ -103,6 +139,27 @@ wuffs_base__nonpremul_u32_axxx(uint32_t premul) {
   return (a << 24) | (r << 16) | (g << 8) | (b << 0);
 }
 
+// wuffs_base__pixel_swizzler__convert_transparency converts the 0xAARRGGBB
+// color c from the src transparency to the dst transparency, where those are
+// the "(repr >> 24) & 7" bits of a wuffs_base__pixel_format. Binary alpha is
+// treated as premultiplied alpha. Opaque and X-padded dsts keep the color as
+// is, as the alpha will be dropped.
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__convert_transparency(uint32_t c,
+                                                 uint32_t dst_transparency,
+                                                 uint32_t src_transparency) {
+  if (src_transparency == 5) {
+    if (dst_transparency >= 6) {
+      return wuffs_base__premul_u32_axxx(c);
+    }
+  } else if (src_transparency >= 6) {
+    if (dst_transparency == 5) {
+      return wuffs_base__nonpremul_u32_axxx(c);
+    }
+  }
+  return c;
+}
+
 wuffs_base__color_u32_argb_premul  //
 wuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_buffer* pb,
                                        uint32_t x,
@@ -146,17 +203,9 @@ wuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_buffer* pb,
                                                   (4 * ((size_t)row[x]))));
     }
 
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565: {
-      uint16_t bgr =
-          wuffs_base__load_u16le__no_bounds_check(row + (2 * ((size_t)x)));
-      uint32_t b5 = 0x1F & (bgr >> 0);
-      uint32_t b = (b5 << 3) | (b5 >> 2);
-      uint32_t g6 = 0x3F & (bgr >> 5);
-      uint32_t g = (g6 << 2) | (g6 >> 4);
-      uint32_t r5 = 0x1F & (bgr >> 11);
-      uint32_t r = (r5 << 3) | (r5 >> 2);
-      return 0xFF000000 | (r << 16) | (g << 8) | (b << 0);
-    }
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      return wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
+          wuffs_base__load_u16le__no_bounds_check(row + (2 * ((size_t)x))));
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       return 0xFF000000 |
              wuffs_base__load_u24le__no_bounds_check(row + (3 * ((size_t)x)));
@@ -223,15 +272,11 @@ wuffs_base__pixel_buffer__set_color_u32_at(
 
       // Common formats above. Rarer formats below.
 
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565: {
-      uint32_t b5 = 0x1F & (color >> (8 - 5));
-      uint32_t g6 = 0x3F & (color >> (16 - 6));
-      uint32_t r5 = 0x1F & (color >> (24 - 5));
-      uint32_t bgr565 = (b5 << 0) | (g6 << 5) | (r5 << 11);
-      wuffs_base__store_u16le__no_bounds_check(row + (2 * ((size_t)x)),
-                                               (uint16_t)bgr565);
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      wuffs_base__store_u16le__no_bounds_check(
+          row + (2 * ((size_t)x)),
+          wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(color));
       break;
-    }
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       wuffs_base__store_u24le__no_bounds_check(row + (3 * ((size_t)x)), color);
       break;
@@ -321,6 +366,140 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over(
   return len;
 }
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42 maps each 16-bit
+// lane y, the sum of products of 8-bit values with y <= (0xFF * 0xFF), to the
+// 8-bit value that the scalar code's 16-bit color math produces. Widening the
+// 8-bit inputs (multiplying by 0x101), dividing by 0xFFFF and then shifting
+// right by 8 works out to exactly ((y * 0x101) / 0xFF00), which is also
+// exactly (y + ((y * 0x0202) >> 16)) >> 8 for all such y. The sum fits in 16
+// bits.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static inline __m128i  //
+wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(__m128i y) {
+  __m128i q = _mm_mulhi_epu16(y, _mm_set1_epi16(0x0202));
+  return _mm_srli_epi16(_mm_add_epi16(y, q), 8);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  // Each color channel is multiplied by its pixel's alpha. The alpha channel
+  // is multiplied by 0xFF, which the scale down maps back to itself.
+  const __m128i z = _mm_setzero_si128();
+  const __m128i alpha_lanes = _mm_setr_epi16(0, 0, 0, 0xFF, 0, 0, 0, 0xFF);
+  const __m128i shuffle_lo =
+      _mm_setr_epi8(3, -128, 3, -128, 3, -128, -128, -128, 7, -128, 7, -128, 7,
+                    -128, -128, -128);
+  const __m128i shuffle_hi =
+      _mm_setr_epi8(11, -128, 11, -128, 11, -128, -128, -128, 15, -128, 15,
+                    -128, 15, -128, -128, -128);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i a_lo = _mm_or_si128(_mm_shuffle_epi8(x, shuffle_lo), alpha_lanes);
+    __m128i a_hi = _mm_or_si128(_mm_shuffle_epi8(x, shuffle_hi), alpha_lanes);
+    __m128i y_lo = _mm_mullo_epi16(_mm_unpacklo_epi8(x, z), a_lo);
+    __m128i y_hi = _mm_mullo_epi16(_mm_unpackhi_epi8(x, z), a_hi);
+    _mm_storeu_si128(
+        (__m128i*)(void*)d,
+        _mm_packus_epi16(
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_lo),
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_hi)));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__premul_u32_axxx(
+        wuffs_base__load_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  // Each dst channel becomes (s * sa) + (d * (0xFF - sa)), scaled down, where
+  // the src alpha channel's s is replaced by 0xFF. This matches the scalar
+  // wuffs_base__composite_premul_nonpremul_u32_axxx.
+  const __m128i z = _mm_setzero_si128();
+  const __m128i ff = _mm_set1_epi16(0xFF);
+  const __m128i alpha_bytes = _mm_set1_epi32((int32_t)0xFF000000);
+  const __m128i shuffle_lo = _mm_setr_epi8(3, -128, 3, -128, 3, -128, 3, -128,
+                                           7, -128, 7, -128, 7, -128, 7, -128);
+  const __m128i shuffle_hi =
+      _mm_setr_epi8(11, -128, 11, -128, 11, -128, 11, -128, 15, -128, 15, -128,
+                    15, -128, 15, -128);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i w = _mm_lddqu_si128((const __m128i*)(const void*)d);
+    __m128i sa_lo = _mm_shuffle_epi8(x, shuffle_lo);
+    __m128i sa_hi = _mm_shuffle_epi8(x, shuffle_hi);
+    x = _mm_or_si128(x, alpha_bytes);
+    __m128i y_lo = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(x, z), sa_lo),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(w, z), _mm_sub_epi16(ff, sa_lo)));
+    __m128i y_hi = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(x, z), sa_hi),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(w, z), _mm_sub_epi16(ff, sa_hi)));
+    _mm_storeu_si128(
+        (__m128i*)(void*)d,
+        _mm_packus_epi16(
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_lo),
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_hi)));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__load_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__store_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__copy_1_1(wuffs_base__slice_u8 dst,
                                      wuffs_base__slice_u8 dst_palette,
@@ -328,6 +507,32 @@ wuffs_base__pixel_swizzler__copy_1_1(wuffs_base__slice_u8 dst,
   return wuffs_base__slice_u8__copy_from_slice(dst, src);
 }
 
+static uint64_t  //
+wuffs_base__pixel_swizzler__copy_2_2(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 dst_palette,
+                                     wuffs_base__slice_u8 src) {
+  size_t dst_len2 = dst.len / 2;
+  size_t src_len2 = src.len / 2;
+  size_t len = dst_len2 < src_len2 ? dst_len2 : src_len2;
+  if (len > 0) {
+    memmove(dst.ptr, src.ptr, len * 2);
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__copy_3_3(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 dst_palette,
+                                     wuffs_base__slice_u8 src) {
+  size_t dst_len3 = dst.len / 3;
+  size_t src_len3 = src.len / 3;
+  size_t len = dst_len3 < src_len3 ? dst_len3 : src_len3;
+  if (len > 0) {
+    memmove(dst.ptr, src.ptr, len * 3);
+  }
+  return len;
+}
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__copy_4_4(wuffs_base__slice_u8 dst,
                                      wuffs_base__slice_u8 dst_palette,
@@ -341,6 +546,107 @@ wuffs_base__pixel_swizzler__copy_4_4(wuffs_base__slice_u8 dst,
   return len;
 }
 
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgb_bgr(wuffs_base__slice_u8 dst,
+                                         wuffs_base__slice_u8 dst_palette,
+                                         wuffs_base__slice_u8 src) {
+  size_t dst_len3 = dst.len / 3;
+  size_t src_len3 = src.len / 3;
+  size_t len = dst_len3 < src_len3 ? dst_len3 : src_len3;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+
+    s += 1 * 3;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx(wuffs_base__slice_u8 dst,
+                                           wuffs_base__slice_u8 dst_palette,
+                                           wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    uint8_t b3 = s[3];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = b3;
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  const __m128i shuffle =
+      _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)d, _mm_shuffle_epi8(x, shuffle));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    uint8_t b3 = s[3];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = b3;
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__xx__index__src(wuffs_base__slice_u8 dst,
                                            wuffs_base__slice_u8 dst_palette,
@@ -463,22 +769,22 @@ wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(
     uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[0] * 4));
     if (s0) {
-      wuffs_base__store_u24le__no_bounds_check(d + (0 * 4), s0);
+      wuffs_base__store_u24le__no_bounds_check(d + (0 * 3), s0);
     }
     uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[1] * 4));
     if (s1) {
-      wuffs_base__store_u24le__no_bounds_check(d + (1 * 4), s1);
+      wuffs_base__store_u24le__no_bounds_check(d + (1 * 3), s1);
     }
     uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[2] * 4));
     if (s2) {
-      wuffs_base__store_u24le__no_bounds_check(d + (2 * 4), s2);
+      wuffs_base__store_u24le__no_bounds_check(d + (2 * 3), s2);
     }
     uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[3] * 4));
     if (s3) {
-      wuffs_base__store_u24le__no_bounds_check(d + (3 * 4), s3);
+      wuffs_base__store_u24le__no_bounds_check(d + (3 * 3), s3);
     }
 
     s += loop_unroll_count * 1;
@@ -490,7 +796,7 @@ wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(
     uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[0] * 4));
     if (s0) {
-      wuffs_base__store_u24le__no_bounds_check(d + (0 * 4), s0);
+      wuffs_base__store_u24le__no_bounds_check(d + (0 * 3), s0);
     }
 
     s += 1 * 1;
@@ -501,6 +807,30 @@ wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(
   return len;
 }
 
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxx__y(wuffs_base__slice_u8 dst,
+                                   wuffs_base__slice_u8 dst_palette,
+                                   wuffs_base__slice_u8 src) {
+  size_t dst_len3 = dst.len / 3;
+  size_t len = dst_len3 < src.len ? dst_len3 : src.len;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    d[0] = s0;
+    d[1] = s0;
+    d[2] = s0;
+
+    s += 1 * 1;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__xxxx__index__src(wuffs_base__slice_u8 dst,
                                              wuffs_base__slice_u8 dst_palette,
@@ -548,6 +878,49 @@ wuffs_base__pixel_swizzler__xxxx__index__src(wuffs_base__slice_u8 dst,
   return len;
 }
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__index__src__x86_avx2(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  if (dst_palette.len != 1024) {
+    return 0;
+  }
+  size_t dst_len4 = dst.len / 4;
+  size_t len = dst_len4 < src.len ? dst_len4 : src.len;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  const int* palette = (const int*)(const void*)(dst_palette.ptr);
+
+  while (n >= 8) {
+    __m256i indexes =
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(const void*)s));
+    _mm256_storeu_si256((__m256i*)(void*)d,
+                        _mm256_i32gather_epi32(palette, indexes, 4));
+
+    s += 8 * 1;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__store_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__load_u32le__no_bounds_check(
+                         dst_palette.ptr + ((size_t)s[0] * 4)));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over(
     wuffs_base__slice_u8 dst,
@@ -632,78 +1005,332 @@ wuffs_base__pixel_swizzler__xxxx__xxx(wuffs_base__slice_u8 dst,
   return len;
 }
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__xxxx__y(wuffs_base__slice_u8 dst,
-                                    wuffs_base__slice_u8 dst_palette,
-                                    wuffs_base__slice_u8 src) {
+wuffs_base__pixel_swizzler__xxxx__xxx__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
   size_t dst_len4 = dst.len / 4;
-  size_t len = dst_len4 < src.len ? dst_len4 : src.len;
+  size_t src_len3 = src.len / 3;
+  size_t len = dst_len4 < src_len3 ? dst_len4 : src_len3;
   uint8_t* d = dst.ptr;
   uint8_t* s = src.ptr;
   size_t n = len;
 
-  // TODO: unroll.
+  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8,
+                                        -128, 9, 10, 11, -128);
+  const __m128i alpha_bytes = _mm_set1_epi32((int32_t)0xFF000000);
+
+  // Each iteration loads 16 src bytes but only uses 12 of them (4 pixels). The
+  // loop condition is "n >= 6", not "n >= 4", so that the load stays within
+  // the src slice.
+  while (n >= 6) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)d,
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle), alpha_bytes));
+
+    s += 4 * 3;
+    d += 4 * 4;
+    n -= 4;
+  }
 
   while (n >= 1) {
     wuffs_base__store_u32le__no_bounds_check(
-        d + (0 * 4), 0xFF000000 | (0x010101 * (uint32_t)s[0]));
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s + (0 * 3)));
 
-    s += 1 * 1;
+    s += 1 * 3;
     d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
-
-// --------
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__squash_bgr_565_888(wuffs_base__slice_u8 dst,
-                                               wuffs_base__slice_u8 src) {
-  size_t len4 = (dst.len < src.len ? dst.len : src.len) / 4;
+wuffs_base__pixel_swizzler__xxxx__y(wuffs_base__slice_u8 dst,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t len = dst_len4 < src.len ? dst_len4 : src.len;
   uint8_t* d = dst.ptr;
   uint8_t* s = src.ptr;
+  size_t n = len;
 
-  size_t n = len4;
-  while (n--) {
-    uint32_t argb = wuffs_base__load_u32le__no_bounds_check(s);
-    uint32_t b5 = 0x1F & (argb >> (8 - 5));
-    uint32_t g6 = 0x3F & (argb >> (16 - 6));
-    uint32_t r5 = 0x1F & (argb >> (24 - 5));
+  // TODO: unroll.
+
+  while (n >= 1) {
     wuffs_base__store_u32le__no_bounds_check(
-        d, (b5 << 0) | (g6 << 5) | (r5 << 11));
-    s += 4;
-    d += 4;
+        d + (0 * 4), 0xFF000000 | (0x010101 * (uint32_t)s[0]));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__convert_palette converts the 256 entries of
+// src_palette, in one of the INDEXED__BGRA_* formats, to dst_palette entries
+// suitable for dst_repr. Each 4-byte dst entry holds a 4-byte color in the
+// dst's BGR or RGB order, keeping the alpha byte even for 3-byte or X-padded
+// dst formats, or for BGR_565, a 2-byte color followed by 2 zero bytes.
+//
+// It returns false if dst_repr is not an indexed, BGR_565, BGR[A|X]_* or
+// RGB[A|X]_* format.
+static bool  //
+wuffs_base__pixel_swizzler__convert_palette(wuffs_base__slice_u8 dst_palette,
+                                            uint32_t dst_repr,
+                                            wuffs_base__slice_u8 src_palette,
+                                            uint32_t src_repr) {
+  if ((dst_palette.len != 1024) || (src_palette.len != 1024)) {
+    return false;
+  }
+  bool swap = false;
+  switch (dst_repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      swap = true;
+      break;
+    default:
+      return false;
+  }
+
+  uint32_t dst_transparency = 0x07 & (dst_repr >> 24);
+  uint32_t src_transparency = 0x07 & (src_repr >> 24);
+  size_t i;
+  for (i = 0; i < 1024; i += 4) {
+    uint32_t c = wuffs_base__load_u32le__no_bounds_check(src_palette.ptr + i);
+    c = wuffs_base__pixel_swizzler__convert_transparency(c, dst_transparency,
+                                                         src_transparency);
+    if (dst_repr == WUFFS_BASE__PIXEL_FORMAT__BGR_565) {
+      c = wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(c);
+    } else if (swap) {
+      c = wuffs_base__swap_u32_argb_abgr(c);
+    }
+    wuffs_base__store_u32le__no_bounds_check(dst_palette.ptr + i, c);
+  }
+  return true;
+}
+
+// --------
+
+// The generic swizzler converts one pixel at a time, via a 0xAARRGGBB
+// intermediate value. It is slower than the specialized swizzlers above, but
+// it converts between any two of the Y, INDEXED__BGRA_*, BGR_565, BGR[A|X]_*
+// and RGB[A|X]_* pixel formats (except that the dst cannot be indexed), and
+// wuffs_base__pixel_swizzler__prepare falls back to it when there is no
+// specialized swizzler.
+//
+// As both a src and a dst, binary alpha is treated as premultiplied alpha.
+// With the SRC blend, converting to a dst without alpha (such as BGR or BGRX)
+// drops the alpha but otherwise keeps the color as is, like the copy_4_4
+// swizzler does for BGRA_NONPREMUL to BGRX.
+
+static bool  //
+wuffs_base__pixel_swizzler__generic__accepts(uint32_t repr) {
+  switch (repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      return true;
+  }
+  return false;
+}
+
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__generic__load(uint32_t repr,
+                                          uint8_t* s,
+                                          uint8_t* palette) {
+  switch (repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      return 0xFF000000 | (0x00010101 * ((uint32_t)(s[0])));
+
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+      return wuffs_base__load_u32le__no_bounds_check(palette +
+                                                     (4 * ((size_t)s[0])));
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      return wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
+          wuffs_base__load_u16le__no_bounds_check(s));
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      return 0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s);
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+      return 0xFF000000 | wuffs_base__load_u32le__no_bounds_check(s);
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      return wuffs_base__load_u32le__no_bounds_check(s);
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      return wuffs_base__swap_u32_argb_abgr(
+          0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s));
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+      return wuffs_base__swap_u32_argb_abgr(
+          0xFF000000 | wuffs_base__load_u32le__no_bounds_check(s));
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      return wuffs_base__swap_u32_argb_abgr(
+          wuffs_base__load_u32le__no_bounds_check(s));
+  }
+  return 0;
+}
+
+static inline void  //
+wuffs_base__pixel_swizzler__generic__store(uint32_t repr,
+                                           uint8_t* d,
+                                           uint32_t c) {
+  switch (repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      d[0] = wuffs_base__color_u32_argb_premul__as__color_u8_gray(c);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      wuffs_base__store_u16le__no_bounds_check(
+          d, wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(c));
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      wuffs_base__store_u24le__no_bounds_check(d, c);
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      wuffs_base__store_u32le__no_bounds_check(d, c);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      wuffs_base__store_u24le__no_bounds_check(
+          d, wuffs_base__swap_u32_argb_abgr(c));
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      wuffs_base__store_u32le__no_bounds_check(
+          d, wuffs_base__swap_u32_argb_abgr(c));
+      break;
   }
-  return len4 * 4;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__swap_rgbx_bgrx(wuffs_base__slice_u8 dst,
-                                           wuffs_base__slice_u8 src) {
-  size_t len4 = (dst.len < src.len ? dst.len : src.len) / 4;
+wuffs_base__pixel_swizzler__generic(const wuffs_base__pixel_swizzler* p,
+                                    wuffs_base__slice_u8 dst,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__slice_u8 src) {
+  wuffs_base__pixel_format dst_format =
+      wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);
+  wuffs_base__pixel_format src_format =
+      wuffs_base__make_pixel_format(p->private_impl.src_pixfmt_repr);
+  if (wuffs_base__pixel_format__is_indexed(&src_format) &&
+      (dst_palette.len != 1024)) {
+    return 0;
+  }
+  size_t dst_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&dst_format) / 8;
+  size_t src_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&src_format) / 8;
+  size_t dst_len = dst.len / dst_bytes_per_pixel;
+  size_t src_len = src.len / src_bytes_per_pixel;
+  size_t len = dst_len < src_len ? dst_len : src_len;
   uint8_t* d = dst.ptr;
   uint8_t* s = src.ptr;
+  size_t n = len;
 
-  size_t n = len4;
-  while (n--) {
-    uint8_t b0 = s[0];
-    uint8_t b1 = s[1];
-    uint8_t b2 = s[2];
-    uint8_t b3 = s[3];
-    d[0] = b2;
-    d[1] = b1;
-    d[2] = b0;
-    d[3] = b3;
-    s += 4;
-    d += 4;
+  uint32_t dst_transparency = 0x07 & (dst_format.repr >> 24);
+  uint32_t src_transparency = 0x07 & (src_format.repr >> 24);
+  bool src_over =
+      (p->private_impl.blend == WUFFS_BASE__PIXEL_BLEND__SRC_OVER) &&
+      (src_transparency >= 5);
+
+  while (n >= 1) {
+    uint32_t c = wuffs_base__pixel_swizzler__generic__load(src_format.repr, s,
+                                                           dst_palette.ptr);
+    uint32_t sa = c >> 24;
+    if (!src_over || (sa == 0xFF)) {
+      c = wuffs_base__pixel_swizzler__convert_transparency(c, dst_transparency,
+                                                           src_transparency);
+      wuffs_base__pixel_swizzler__generic__store(dst_format.repr, d, c);
+    } else if (sa != 0x00) {
+      // Composite src over dst in premultiplied alpha. A fully transparent src
+      // pixel leaves the dst as is, without a lossy premul round trip.
+      uint32_t d0 =
+          wuffs_base__pixel_swizzler__generic__load(dst_format.repr, d, NULL);
+      if (dst_transparency == 5) {
+        d0 = wuffs_base__premul_u32_axxx(d0);
+      }
+      if (src_transparency == 5) {
+        c = wuffs_base__composite_premul_nonpremul_u32_axxx(d0, c);
+      } else {
+        c = wuffs_base__composite_premul_premul_u32_axxx(d0, c);
+      }
+      if (dst_transparency == 5) {
+        c = wuffs_base__nonpremul_u32_axxx(c);
+      }
+      wuffs_base__pixel_swizzler__generic__store(dst_format.repr, d, c);
+    }
+
+    s += 1 * src_bytes_per_pixel;
+    d += 1 * dst_bytes_per_pixel;
+    n -= 1;
   }
-  return len4 * 4;
+
+  return len;
 }
 
 // --------
 
+// wuffs_base__pixel_swizzler__mirror_bgr_rgb returns the pixel format with
+// the BGR and RGB channel orders swapped (e.g. RGBX for BGRX). The specialized
+// swizzlers do not depend on the channel order, only on whether the src and
+// dst orders match, so an RGB-order src can re-use the prepare__bgr* function
+// for the corresponding BGR-order src, if passed a mirrored dst format. A
+// mirrored INDEXED__BGRA_* or BGR_565 format is not a valid format.
+static inline wuffs_base__pixel_format  //
+wuffs_base__pixel_swizzler__mirror_bgr_rgb(wuffs_base__pixel_format f) {
+  switch (f.repr >> 28) {
+    case 0x4:
+      return wuffs_base__make_pixel_format(f.repr + 0x10000000);
+    case 0x5:
+      return wuffs_base__make_pixel_format(f.repr - 0x10000000);
+  }
+  return f;
+}
+
 static wuffs_base__pixel_swizzler__func  //
 wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
                                        wuffs_base__pixel_format dst_format,
@@ -711,14 +1338,12 @@ wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
                                        wuffs_base__slice_u8 src_palette,
                                        wuffs_base__pixel_blend blend) {
   switch (dst_format.repr) {
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      // TODO.
-      break;
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      return wuffs_base__pixel_swizzler__copy_1_1;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      // TODO.
-      break;
+      return wuffs_base__pixel_swizzler__xxx__y;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
@@ -734,20 +1359,24 @@ wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
 }
 
 static wuffs_base__pixel_swizzler__func  //
-wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
+wuffs_base__pixel_swizzler__prepare__indexed(
     wuffs_base__pixel_swizzler* p,
     wuffs_base__pixel_format dst_format,
     wuffs_base__slice_u8 dst_palette,
+    wuffs_base__pixel_format src_format,
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
+  if (!wuffs_base__pixel_swizzler__convert_palette(
+          dst_palette, dst_format.repr, src_palette, src_format.repr)) {
+    return NULL;
+  }
+  bool binary =
+      src_format.repr == WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY;
+
   switch (dst_format.repr) {
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
-      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
-          1024) {
-        return NULL;
-      }
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__copy_1_1;
@@ -755,10 +1384,6 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
       return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      if (wuffs_base__pixel_swizzler__squash_bgr_565_888(dst_palette,
-                                                         src_palette) != 1024) {
-        return NULL;
-      }
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__xx__index__src;
@@ -766,64 +1391,59 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
       return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
-      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
-          1024) {
-        return NULL;
-      }
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__xxx__index__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
+          if (binary) {
+            return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
+          }
+          break;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
-      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
-          1024) {
-        return NULL;
-      }
-      switch (blend) {
-        case WUFFS_BASE__PIXEL_BLEND__SRC:
-          return wuffs_base__pixel_swizzler__xxxx__index__src;
-        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
-      }
-      return NULL;
-
-    case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(dst_palette,
-                                                     src_palette) != 1024) {
-        return NULL;
-      }
-      switch (blend) {
-        case WUFFS_BASE__PIXEL_BLEND__SRC:
-          return wuffs_base__pixel_swizzler__xxx__index__src;
-        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
-      }
-      return NULL;
-
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
-      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(dst_palette,
-                                                     src_palette) != 1024) {
-        return NULL;
-      }
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__xxxx__index__src__x86_avx2;
+          }
+#endif
           return wuffs_base__pixel_swizzler__xxxx__index__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
+          if (binary) {
+            return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
+          }
+          break;
       }
       return NULL;
   }
   return NULL;
 }
 
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__bgr_565(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_format,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend) {
+  switch (dst_format.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      return wuffs_base__pixel_swizzler__copy_2_2;
+  }
+  return NULL;
+}
+
 static wuffs_base__pixel_swizzler__func  //
 wuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,
                                          wuffs_base__pixel_format dst_format,
@@ -831,27 +1451,43 @@ wuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,
                                          wuffs_base__slice_u8 src_palette,
                                          wuffs_base__pixel_blend blend) {
   switch (dst_format.repr) {
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      // TODO.
-      break;
-
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
-    case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      // TODO.
-      break;
+      return wuffs_base__pixel_swizzler__copy_3_3;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__xxxx__xxx__x86_sse42;
+      }
+#endif
       return wuffs_base__pixel_swizzler__xxxx__xxx;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      return wuffs_base__pixel_swizzler__swap_rgb_bgr;
+  }
+  return NULL;
+}
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__bgrx(wuffs_base__pixel_swizzler* p,
+                                          wuffs_base__pixel_format dst_format,
+                                          wuffs_base__slice_u8 dst_palette,
+                                          wuffs_base__slice_u8 src_palette,
+                                          wuffs_base__pixel_blend blend) {
+  switch (dst_format.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+      return wuffs_base__pixel_swizzler__copy_4_4;
+
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
-      // TODO.
-      break;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
+      }
+#endif
+      return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
   }
   return NULL;
 }
@@ -864,15 +1500,6 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_format.repr) {
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      // TODO.
-      break;
-
-    case WUFFS_BASE__PIXEL_FORMAT__BGR:
-    case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      // TODO.
-      break;
-
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
@@ -882,28 +1509,110 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
       return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+      }
+      return NULL;
+  }
+  return NULL;
+}
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__bgra_premul(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_format,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend) {
+  switch (dst_format.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
-      // TODO.
-      break;
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__copy_4_4;
+      }
+      return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
-      // TODO.
-      break;
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+      }
+      return NULL;
   }
   return NULL;
 }
 
+static bool  //
+wuffs_base__pixel_swizzler__prepare__generic(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_format,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__pixel_format src_format,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend) {
+  if (!wuffs_base__pixel_swizzler__generic__accepts(dst_format.repr) ||
+      !wuffs_base__pixel_swizzler__generic__accepts(src_format.repr) ||
+      wuffs_base__pixel_format__is_indexed(&dst_format)) {
+    return false;
+  }
+  switch (blend) {
+    case WUFFS_BASE__PIXEL_BLEND__SRC:
+    case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+      break;
+    default:
+      return false;
+  }
+
+  // The generic swizzler looks up an indexed src's colors in the dst_palette,
+  // holding an unconverted copy of the src_palette.
+  if (wuffs_base__pixel_format__is_indexed(&src_format) &&
+      (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
+       1024)) {
+    return false;
+  }
+
+  p->private_impl.dst_pixfmt_repr = dst_format.repr;
+  p->private_impl.src_pixfmt_repr = src_format.repr;
+  p->private_impl.blend = blend;
+  return true;
+}
+
 // --------
 
 wuffs_base__status  //
@@ -916,8 +1625,12 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
   if (!p) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
+  p->private_impl.func = NULL;
+  p->private_impl.dst_pixfmt_repr = 0;
+  p->private_impl.src_pixfmt_repr = 0;
+  p->private_impl.blend = 0;
 
-  // TODO: support many more formats.
+  // TODO: support planar formats.
 
   wuffs_base__pixel_swizzler__func func = NULL;
 
@@ -927,8 +1640,15 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
                                                     src_palette, blend);
       break;
 
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
-      func = wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
+      func = wuffs_base__pixel_swizzler__prepare__indexed(
+          p, dst_format, dst_palette, src_format, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      func = wuffs_base__pixel_swizzler__prepare__bgr_565(
           p, dst_format, dst_palette, src_palette, blend);
       break;
 
@@ -937,15 +1657,59 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
           p, dst_format, dst_palette, src_palette, blend);
       break;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+      func = wuffs_base__pixel_swizzler__prepare__bgrx(
+          p, dst_format, dst_palette, src_palette, blend);
+      break;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
           p, dst_format, dst_palette, src_palette, blend);
       break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      func = wuffs_base__pixel_swizzler__prepare__bgra_premul(
+          p, dst_format, dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      func = wuffs_base__pixel_swizzler__prepare__bgr(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+      func = wuffs_base__pixel_swizzler__prepare__bgrx(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+      func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      func = wuffs_base__pixel_swizzler__prepare__bgra_premul(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
   }
 
-  p->private_impl.func = func;
-  return wuffs_base__make_status(
-      func ? NULL : wuffs_base__error__unsupported_pixel_swizzler_option);
+  if (func) {
+    p->private_impl.func = func;
+    p->private_impl.dst_pixfmt_repr = dst_format.repr;
+    p->private_impl.src_pixfmt_repr = src_format.repr;
+    p->private_impl.blend = blend;
+  } else if (!wuffs_base__pixel_swizzler__prepare__generic(
+                 p, dst_format, dst_palette, src_format, src_palette, blend)) {
+    return wuffs_base__make_status(
+        wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  return wuffs_base__make_status(NULL);
 }
 
 uint64_t  //
@@ -954,8 +1718,80 @@ wuffs_base__pixel_swizzler__swizzle_interleaved(
     wuffs_base__slice_u8 dst,
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src) {
-  if (p && p->private_impl.func) {
-    return (*p->private_impl.func)(dst, dst_palette, src);
+  if (p) {
+    if (p->private_impl.func) {
+      return (*p->private_impl.func)(dst, dst_palette, src);
+    } else if (p->private_impl.src_pixfmt_repr) {
+      return wuffs_base__pixel_swizzler__generic(p, dst, dst_palette, src);
+    }
   }
   return 0;
 }
+
+uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t x_step) {
+  if (x_step <= 1) {
+    return wuffs_base__pixel_swizzler__swizzle_interleaved(p, dst, dst_palette,
+                                                           src);
+  } else if (!p || !p->private_impl.src_pixfmt_repr) {
+    return 0;
+  }
+  wuffs_base__pixel_format dst_format =
+      wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);
+  wuffs_base__pixel_format src_format =
+      wuffs_base__make_pixel_format(p->private_impl.src_pixfmt_repr);
+  size_t dst_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&dst_format) / 8;
+  size_t src_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&src_format) / 8;
+  if ((dst_bytes_per_pixel == 0) || (src_bytes_per_pixel == 0) ||
+      (src_bytes_per_pixel > 8)) {
+    return 0;
+  }
+  size_t src_stride = src_bytes_per_pixel * x_step;
+  size_t src_len = src.len / src_bytes_per_pixel;
+  uint8_t* s = src.ptr;
+
+  // Gather the kept source pixels into a contiguous buffer, a batch at a
+  // time, and swizzle each batch with the regular (non-subsampled) func.
+  uint8_t batch[1024];
+  const size_t batch_cap = sizeof(batch) / src_bytes_per_pixel;
+
+  uint64_t num_src_consumed = 0;
+  while (num_src_consumed < src_len) {
+    size_t n = ((src_len - num_src_consumed) + (x_step - 1)) / x_step;
+    if (n > batch_cap) {
+      n = batch_cap;
+    }
+    size_t i;
+    for (i = 0; i < n; i++) {
+      memcpy(batch + (i * src_bytes_per_pixel), s + (i * src_stride),
+             src_bytes_per_pixel);
+    }
+
+    uint64_t num_dst_written = wuffs_base__pixel_swizzler__swizzle_interleaved(
+        p, dst, dst_palette,
+        wuffs_base__make_slice_u8(batch, n * src_bytes_per_pixel));
+    if (num_dst_written == 0) {
+      break;
+    }
+    uint64_t m = num_dst_written * x_step;
+    if (m > (src_len - num_src_consumed)) {
+      m = src_len - num_src_consumed;
+    }
+    num_src_consumed += m;
+    if (num_dst_written < n) {
+      break;
+    }
+
+    dst.ptr += n * dst_bytes_per_pixel;
+    dst.len -= n * dst_bytes_per_pixel;
+    s += n * src_stride;
+  }
+  return num_src_consumed;
+}
@@ -21,6 +21,40 @@
 // byte order: its value is always 0xAARRGGBB, regardless of endianness.
 typedef uint32_t wuffs_base__color_u32_argb_premul;
 
+static inline uint16_t  //
+wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(
+    wuffs_base__color_u32_argb_premul c) {
+  uint32_t r5 = 0xF800 & (c >> 8);
+  uint32_t g6 = 0x07E0 & (c >> 5);
+  uint32_t b5 = 0x001F & (c >> 3);
+  return (uint16_t)(r5 | g6 | b5);
+}
+
+static inline wuffs_base__color_u32_argb_premul  //
+wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(uint16_t rgb_565) {
+  uint32_t b5 = 0x1F & (rgb_565 >> 0);
+  uint32_t b = (b5 << 3) | (b5 >> 2);
+  uint32_t g6 = 0x3F & (rgb_565 >> 5);
+  uint32_t g = (g6 << 2) | (g6 >> 4);
+  uint32_t r5 = 0x1F & (rgb_565 >> 11);
+  uint32_t r = (r5 << 3) | (r5 >> 2);
+  return 0xFF000000 | (r << 16) | (g << 8) | (b << 0);
+}
+
+// wuffs_base__color_u32_argb_premul__as__color_u8_gray returns the luma (the
+// gray level) of c, using the JFIF (ITU-R BT.601) weights of 0.299, 0.587 and
+// 0.114 for red, green and blue. The alpha of c is ignored.
+static inline uint8_t  //
+wuffs_base__color_u32_argb_premul__as__color_u8_gray(
+    wuffs_base__color_u32_argb_premul c) {
+  // Work in 16-bit color. The weights sum to 0x10000 (65536).
+  uint32_t cr = 0x101 * (0xFF & (c >> 16));
+  uint32_t cg = 0x101 * (0xFF & (c >> 8));
+  uint32_t cb = 0x101 * (0xFF & (c >> 0));
+  uint32_t weighted_average = (19595 * cr) + (38470 * cg) + (7471 * cb) + 32768;
+  return (uint8_t)(weighted_average >> 24);
+}
+
 // --------
 
 typedef uint8_t wuffs_base__pixel_blend;
@@ -1129,20 +1163,137 @@ wuffs_base__pixel_buffer::set_color_u32_at(
 
 // --------
 
+// wuffs_base__decode_frame_options holds optional arguments to an image
+// decoder's decode_frame method. Passing a NULL pointer is equivalent to
+// passing a wuffs_base__null_decode_frame_options() value.
 typedef struct {
   // Do not access the private_impl's fields directly. There is no API/ABI
   // compatibility or safety guarantee if you do so.
   struct {
-    uint8_t TODO;
+    wuffs_base__rect_ie_u32 dst_clip_rect;
+    bool has_dst_clip_rect;
+    uint32_t scale_log2;
   } private_impl;
 
 #ifdef __cplusplus
+  inline wuffs_base__rect_ie_u32 dst_clip_rect() const;
+  inline uint32_t scale_denominator() const;
+  inline void set_dst_clip_rect(wuffs_base__rect_ie_u32 r);
+  inline void set_scale_denominator(uint32_t d);
 #endif  // __cplusplus
 
 } wuffs_base__decode_frame_options;
 
+static inline wuffs_base__decode_frame_options  //
+wuffs_base__null_decode_frame_options() {
+  wuffs_base__decode_frame_options ret;
+  ret.private_impl.dst_clip_rect = wuffs_base__make_rect_ie_u32(0, 0, 0, 0);
+  ret.private_impl.has_dst_clip_rect = false;
+  ret.private_impl.scale_log2 = 0;
+  return ret;
+}
+
+// wuffs_base__decode_frame_options__dst_clip_rect returns the region of
+// interest, in the destination pixel buffer's coordinate space. decode_frame
+// does not write any pixels outside of it, and image decoders can skip the
+// work (such as swizzling or, for some formats, reading) for the source
+// pixels that map to outside of it.
+//
+// If set_dst_clip_rect was never called (or o is NULL), it returns the entire
+// (0, 0) to (0xFFFFFFFF, 0xFFFFFFFF) plane, so that nothing is clipped.
+static inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options__dst_clip_rect(
+    const wuffs_base__decode_frame_options* o) {
+  if (o && o->private_impl.has_dst_clip_rect) {
+    return o->private_impl.dst_clip_rect;
+  }
+  return wuffs_base__make_rect_ie_u32(0, 0, 0xFFFFFFFF, 0xFFFFFFFF);
+}
+
+static inline void  //
+wuffs_base__decode_frame_options__set_dst_clip_rect(
+    wuffs_base__decode_frame_options* o,
+    wuffs_base__rect_ie_u32 r) {
+  if (o) {
+    o->private_impl.dst_clip_rect = r;
+    o->private_impl.has_dst_clip_rect = true;
+  }
+}
+
+// wuffs_base__decode_frame_options__scale_denominator returns the factor, 1,
+// 2, 4 or 8, by which decode_frame shrinks the frame in each dimension. A
+// source image of width W and height H is decoded to a destination of width
+// ((W + d - 1) / d) and height ((H + d - 1) / d), where d is the denominator.
+// Image decoders subsample: the source pixel at (x * d, y * d) becomes the
+// destination pixel at (x, y) and the other source pixels are skipped.
+//
+// The dst_clip_rect, frame_dirty_rect and the pixel buffer passed to
+// decode_frame are all in the destination's (scaled) coordinate space. The
+// image_config and frame_config bounds are not scaled.
+//
+// If set_scale_denominator was never called (or o is NULL), it returns 1.
+static inline uint32_t  //
+wuffs_base__decode_frame_options__scale_denominator(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? (((uint32_t)1) << (o->private_impl.scale_log2 & 3)) : 1;
+}
+
+// wuffs_base__decode_frame_options__scale_log2 returns the base-2 logarithm of
+// the scale_denominator: 0, 1, 2 or 3. Wuffs code relies on that range, so it
+// is enforced here even if the private_impl field was set directly.
+static inline uint32_t  //
+wuffs_base__decode_frame_options__scale_log2(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? (o->private_impl.scale_log2 & 3) : 0;
+}
+
+// wuffs_base__decode_frame_options__set_scale_denominator sets the scale
+// denominator. Valid values are 1, 2, 4 and 8. Other values are treated as 1.
+static inline void  //
+wuffs_base__decode_frame_options__set_scale_denominator(
+    wuffs_base__decode_frame_options* o,
+    uint32_t d) {
+  if (o) {
+    switch (d) {
+      case 2:
+        o->private_impl.scale_log2 = 1;
+        break;
+      case 4:
+        o->private_impl.scale_log2 = 2;
+        break;
+      case 8:
+        o->private_impl.scale_log2 = 3;
+        break;
+      default:
+        o->private_impl.scale_log2 = 0;
+        break;
+    }
+  }
+}
+
 #ifdef __cplusplus
 
+inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options::dst_clip_rect() const {
+  return wuffs_base__decode_frame_options__dst_clip_rect(this);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::scale_denominator() const {
+  return wuffs_base__decode_frame_options__scale_denominator(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_dst_clip_rect(
+    wuffs_base__rect_ie_u32 r) {
+  wuffs_base__decode_frame_options__set_dst_clip_rect(this, r);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_scale_denominator(uint32_t d) {
+  wuffs_base__decode_frame_options__set_scale_denominator(this, d);
+}
+
 #endif  // __cplusplus
 
 // --------
@@ -1158,6 +1309,14 @@ typedef struct {
   // compatibility or safety guarantee if you do so.
   struct {
     wuffs_base__pixel_swizzler__func func;
+
+    // When func is NULL but src_pixfmt_repr is non-zero, swizzling falls
+    // back to a slower, generic, one-pixel-at-a-time implementation that
+    // uses these three fields. A successful prepare always sets them, as
+    // swizzle_interleaved_subsampled also needs the pixel sizes.
+    uint32_t dst_pixfmt_repr;
+    uint32_t src_pixfmt_repr;
+    wuffs_base__pixel_blend blend;
   } private_impl;
 
 #ifdef __cplusplus
@@ -1169,6 +1328,11 @@ typedef struct {
   inline uint64_t swizzle_interleaved(wuffs_base__slice_u8 dst,
                                       wuffs_base__slice_u8 dst_palette,
                                       wuffs_base__slice_u8 src) const;
+  inline uint64_t swizzle_interleaved_subsampled(
+      wuffs_base__slice_u8 dst,
+      wuffs_base__slice_u8 dst_palette,
+      wuffs_base__slice_u8 src,
+      uint32_t x_step) const;
 #endif  // __cplusplus
 
 } wuffs_base__pixel_swizzler;
@@ -1188,6 +1352,22 @@ wuffs_base__pixel_swizzler__swizzle_interleaved(
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src);
 
+// wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled is like
+// wuffs_base__pixel_swizzler__swizzle_interleaved but only converts every
+// x_step'th source pixel: the source pixel (i * x_step) becomes the
+// destination pixel i. It returns the number of source pixels consumed, which
+// includes the skipped ones. It is at most (x_step * the number of
+// destination pixels written), and the src slice's length limits it too.
+//
+// An x_step of 0 or 1 is equivalent to calling swizzle_interleaved.
+uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t x_step);
+
 #ifdef __cplusplus
 
 inline wuffs_base__status  //
@@ -1209,4 +1389,14 @@ wuffs_base__pixel_swizzler::swizzle_interleaved(
                                                          src);
 }
 
+uint64_t  //
+wuffs_base__pixel_swizzler::swizzle_interleaved_subsampled(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t x_step) const {
+  return wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+      this, dst, dst_palette, src, x_step);
+}
+
 #endif  // __cplusplus
@@ -59,10 +59,9 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
   // argument, and the cgen can look if that argument is the constant
   // expression '3'.
   //
-  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.
-  //
-  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method
-  // that copies 8 bytes at a time, possibly writing more than length bytes?
+  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, and the
+  // _8_byte_chunks_fast variant after that, which copies 8 bytes at a time,
+  // possibly writing more than length bytes.
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -102,6 +101,73 @@ wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
   return length;
 }
 
+// wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast is like the
+// wuffs_base__io_writer__copy_n32_from_history_fast function above, but copies
+// 8 bytes at a time, so it can write up to 8 bytes more than the length bytes
+// it copies. Those excess bytes are not part of the output (*ptr_iop_w is
+// only advanced by length) and will be overwritten by later writes. The
+// caller needs to prove that:
+//  - distance >  0
+//  - distance <= (*ptr_iop_w - io1_w)
+//  - (length + 8) <= (io2_w - *ptr_iop_w)
+//
+// A distance of at least 8 means that each 8 byte chunk's source is entirely
+// before its destination. Distances of 1, 2 and 4 (runs of a repeated byte or
+// pattern) broadcast that pattern to 8 bytes and store it repeatedly. Other
+// distances copy one byte at a time.
+static inline uint32_t  //
+wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(
+    uint8_t** ptr_iop_w,
+    uint8_t* io1_w,
+    uint8_t* io2_w,
+    uint32_t length,
+    uint32_t distance) {
+  uint8_t* p = *ptr_iop_w;
+  uint8_t* q = p - distance;
+  uint32_t n = length;
+  if (distance >= 8) {
+    while (true) {
+      memcpy(p, q, 8);
+      if (n <= 8) {
+        break;
+      }
+      p += 8;
+      q += 8;
+      n -= 8;
+    }
+  } else if ((distance == 1) || (distance == 2) || (distance == 4)) {
+    uint64_t x;
+    if (distance == 1) {
+      x = 0x0101010101010101 * ((uint64_t)(q[0]));
+    } else if (distance == 2) {
+      x = 0x0001000100010001 *
+          ((uint64_t)(wuffs_base__load_u16le__no_bounds_check(q)));
+    } else {
+      x = 0x0000000100000001 *
+          ((uint64_t)(wuffs_base__load_u32le__no_bounds_check(q)));
+    }
+    while (true) {
+      wuffs_base__store_u64le__no_bounds_check(p, x);
+      if (n <= 8) {
+        break;
+      }
+      p += 8;
+      n -= 8;
+    }
+  } else {
+    for (; n >= 3; n -= 3) {
+      *p++ = *q++;
+      *p++ = *q++;
+      *p++ = *q++;
+    }
+    for (; n; n--) {
+      *p++ = *q++;
+    }
+  }
+  *ptr_iop_w += length;
+  return length;
+}
+
 static inline uint32_t  //
 wuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,
                                             uint8_t* io2_w,
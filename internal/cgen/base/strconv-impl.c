@@ -299,6 +299,96 @@ fail_out_of_bounds:
   } while (0);
 }
 
+// --------
+
+// wuffs_base__render_number__two_digits holds the ASCII encodings of "00",
+// "01", "02", ..., "99". Looking up two digits at a time halves the number of
+// (relatively slow) 64-bit divisions compared to one digit at a time.
+static const uint8_t wuffs_base__render_number__two_digits[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0',
+    '7', '0', '8', '0', '9', '1', '0', '1', '1', '1', '2', '1', '3', '1', '4',
+    '1', '5', '1', '6', '1', '7', '1', '8', '1', '9', '2', '0', '2', '1', '2',
+    '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3',
+    '7', '3', '8', '3', '9', '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',
+    '4', '5', '4', '6', '4', '7', '4', '8', '4', '9', '5', '0', '5', '1', '5',
+    '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6',
+    '7', '6', '8', '6', '9', '7', '0', '7', '1', '7', '2', '7', '3', '7', '4',
+    '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '8', '0', '8', '1', '8',
+    '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9',
+    '7', '9', '8', '9', '9',
+};
+
+static size_t  //
+wuffs_base__private_implementation__render_number_u64(wuffs_base__slice_u8 dst,
+                                                      uint64_t x,
+                                                      uint32_t options,
+                                                      bool neg) {
+  uint8_t buf[WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];
+  uint8_t* ptr = &buf[0] + sizeof(buf);
+
+  // Write the digits right to left, two at a time.
+  while (x >= 100) {
+    size_t index = ((size_t)(x % 100)) * 2;
+    x /= 100;
+    ptr -= 2;
+    ptr[0] = wuffs_base__render_number__two_digits[index + 0];
+    ptr[1] = wuffs_base__render_number__two_digits[index + 1];
+  }
+  if (x >= 10) {
+    size_t index = ((size_t)x) * 2;
+    ptr -= 2;
+    ptr[0] = wuffs_base__render_number__two_digits[index + 0];
+    ptr[1] = wuffs_base__render_number__two_digits[index + 1];
+  } else {
+    ptr -= 1;
+    ptr[0] = (uint8_t)('0' + x);
+  }
+
+  if (neg) {
+    ptr -= 1;
+    ptr[0] = '-';
+  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+    ptr -= 1;
+    ptr[0] = '+';
+  }
+
+  size_t n = (size_t)((&buf[0] + sizeof(buf)) - ptr);
+  if (n > dst.len) {
+    return 0;
+  }
+  memcpy(dst.ptr + ((options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                        ? (dst.len - n)
+                        : 0),
+         ptr, n);
+  return n;
+}
+
+size_t  //
+wuffs_base__render_number_i64(wuffs_base__slice_u8 dst,
+                              int64_t x,
+                              uint32_t options) {
+  uint64_t u = (uint64_t)x;
+  bool neg = x < 0;
+  if (neg) {
+    // Negate in uint64_t arithmetic, so that INT64_MIN is not undefined
+    // behavior.
+    u = 1 + ~u;
+  }
+  return wuffs_base__private_implementation__render_number_u64(dst, u, options,
+                                                               neg);
+}
+
+size_t  //
+wuffs_base__render_number_u64(wuffs_base__slice_u8 dst,
+                              uint64_t x,
+                              uint32_t options) {
+  return wuffs_base__private_implementation__render_number_u64(dst, x, options,
+                                                               false);
+}
+
   // ---------------- IEEE 754 Floating Point
 
 #define WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE 1023
@@ -862,6 +952,238 @@ wuffs_base__private_implementation__high_prec_dec__small_rshift(
   wuffs_base__private_implementation__high_prec_dec__trim(h);
 }
 
+// wuffs_base__private_implementation__high_prec_dec__shift multiplies h by
+// (2 ** shift), where shift may be negative and need not be "a small shift".
+//
+// The preconditions are the same as for the small_xshift functions, except
+// that shift may be zero or large. The caller is responsible for keeping
+// h->decimal_point "not extreme" throughout, which holds for any double.
+static void  //
+wuffs_base__private_implementation__high_prec_dec__shift(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t shift) {
+  while (shift > +WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL) {
+    wuffs_base__private_implementation__high_prec_dec__small_lshift(
+        h, WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL);
+    shift -= WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;
+  }
+  while (shift < -WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL) {
+    wuffs_base__private_implementation__high_prec_dec__small_rshift(
+        h, WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL);
+    shift += WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;
+  }
+  if (shift > 0) {
+    wuffs_base__private_implementation__high_prec_dec__small_lshift(
+        h, (uint32_t)(+shift));
+  } else if (shift < 0) {
+    wuffs_base__private_implementation__high_prec_dec__small_rshift(
+        h, (uint32_t)(-shift));
+  }
+}
+
+// wuffs_base__private_implementation__high_prec_dec__assign sets h to the
+// exact value of (x * (2 ** exp2)), negated if negative.
+static void  //
+wuffs_base__private_implementation__high_prec_dec__assign(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint64_t x,
+    int32_t exp2,
+    bool negative) {
+  uint8_t buf[20];
+  uint32_t n = 0;
+
+  // Set buf's digits, least significant first.
+  while (x > 0) {
+    uint64_t quo = x / 10;
+    buf[n++] = (uint8_t)(x - (10 * quo));
+    x = quo;
+  }
+
+  // Copy them to h, most significant first.
+  h->num_digits = n;
+  h->decimal_point = (int32_t)n;
+  h->negative = negative;
+  h->truncated = false;
+  uint32_t i = 0;
+  for (; i < n; i++) {
+    h->digits[i] = buf[n - 1 - i];
+  }
+  wuffs_base__private_implementation__high_prec_dec__trim(h);
+
+  wuffs_base__private_implementation__high_prec_dec__shift(h, exp2);
+}
+
+// --------
+
+// The wuffs_base__private_implementation__high_prec_dec__round_etc functions
+// round h's number to n digits, where n counts from the most significant digit
+// (h->digits[0]), not from the decimal point. They do nothing if n is
+// negative or if h already has n or fewer digits.
+//
+// round_down truncates, round_up rounds away from zero and round_nearest
+// rounds to nearest, ties to even (unless h->truncated, in which case an
+// apparent tie is really above halfway).
+
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_down(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t n) {
+  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {
+    return;
+  }
+  h->num_digits = (uint32_t)n;
+  wuffs_base__private_implementation__high_prec_dec__trim(h);
+}
+
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_up(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t n) {
+  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {
+    return;
+  }
+
+  for (n--; n >= 0; n--) {
+    if (h->digits[n] < 9) {
+      h->digits[n]++;
+      h->num_digits = (uint32_t)(n + 1);
+      return;
+    }
+  }
+
+  // The number is all 9s. Change to a single 1 and adjust the decimal point.
+  h->digits[0] = 1;
+  h->num_digits = 1;
+  h->decimal_point++;
+}
+
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_nearest(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t n) {
+  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {
+    return;
+  }
+  bool up = h->digits[n] >= 5;
+  if ((h->digits[n] == 5) && ((uint32_t)(n + 1) == h->num_digits)) {
+    up = h->truncated ||  //
+         ((n > 0) && (1 & h->digits[n - 1]));
+  }
+
+  if (up) {
+    wuffs_base__private_implementation__high_prec_dec__round_up(h, n);
+  } else {
+    wuffs_base__private_implementation__high_prec_dec__round_down(h, n);
+  }
+}
+
+// wuffs_base__private_implementation__high_prec_dec__round_just_enough rounds
+// h, which must hold the exact value of (mantissa * (2 ** exp2)), to the
+// fewest digits that still parse back to the same double. mantissa includes
+// the implicit 1<<52 bit (for normal numbers) and exp2 is -1074 for subnormal
+// numbers, as well as the smallest normal exponent.
+//
+// This is the exact (but relatively slow) algorithm. It considers the
+// halfway points between h and its two neighboring doubles, as in
+// https://github.com/golang/go/blob/go1.15/src/strconv/ftoa.go roundShortest.
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_just_enough(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t exp2,
+    uint64_t mantissa) {
+  // The magic numbers 52 and -1074 are IEEE 754 double precision's mantissa
+  // bit count and minimum exponent.
+  if ((h->num_digits == 0) ||
+      // If the number's exponent is not the minimum, and its trailing zeroes
+      // (in decimal) outweigh its trailing (binary) fraction bits, then it is
+      // already as short as possible: every neighboring double differs by
+      // more than one unit in h's last place.
+      ((exp2 > -1074) &&
+       ((332 * (h->decimal_point - (int32_t)(h->num_digits))) >=
+        (100 * exp2)))) {
+    return;
+  }
+
+  // Compute upper, halfway between h's number and its successor.
+  wuffs_base__private_implementation__high_prec_dec upper;
+  wuffs_base__private_implementation__high_prec_dec__assign(
+      &upper, (mantissa << 1) + 1, exp2 - 1, false);
+
+  // Compute lower, halfway between h's number and its predecessor. A power of
+  // 2 (other than the minimum exponent's) is closer to its predecessor.
+  uint64_t l_mantissa = mantissa - 1;
+  int32_t l_exp2 = exp2;
+  if ((mantissa <= 0x10000000000000) && (exp2 > -1074)) {
+    l_mantissa = (mantissa << 1) - 1;
+    l_exp2 = exp2 - 1;
+  }
+  wuffs_base__private_implementation__high_prec_dec lower;
+  wuffs_base__private_implementation__high_prec_dec__assign(
+      &lower, (l_mantissa << 1) + 1, l_exp2 - 1, false);
+
+  // The upper and lower bounds are possible outputs only if the original
+  // mantissa is even, so that IEEE round-to-even would round to the original
+  // mantissa and not the neighbors.
+  bool inclusive = (mantissa & 1) == 0;
+
+  // As we walk the digits, upper_delta tracks whether rounding up would stay
+  // within the upper bound. 0 means that h and upper have had the same digits
+  // so far. 1 means that they differed by 1 on a previous digit and since
+  // then h has had only 9s and upper only 0s (so rounding up might land on
+  // the bound). 2 means that they differ by more than that.
+  uint8_t upper_delta = 0;
+
+  // Walk along until h has distinguished itself from both upper and lower.
+  // upper has the largest decimal_point, so iterate over its digits and start
+  // li and mi at (possibly) -1.
+  int32_t ui = 0;
+  for (;; ui++) {
+    int32_t mi = ui - upper.decimal_point + h->decimal_point;
+    if (mi >= ((int32_t)(h->num_digits))) {
+      break;
+    }
+    int32_t li = ui - upper.decimal_point + lower.decimal_point;
+    uint8_t l = ((li >= 0) && (li < ((int32_t)(lower.num_digits))))
+                    ? lower.digits[li]
+                    : 0;
+    uint8_t m = (mi >= 0) ? h->digits[mi] : 0;
+    uint8_t u = (ui < ((int32_t)(upper.num_digits))) ? upper.digits[ui] : 0;
+
+    // It's OK to round down (truncate) if lower has a different digit, or if
+    // lower is inclusive and is exactly the result of rounding down (i.e. we
+    // have reached lower's final digit).
+    bool ok_down = (l != m) ||  //
+                   (inclusive && ((li + 1) == ((int32_t)(lower.num_digits))));
+
+    if ((upper_delta == 0) && ((m + 1) < u)) {
+      upper_delta = 2;
+    } else if ((upper_delta == 0) && (m != u)) {
+      upper_delta = 1;
+    } else if ((upper_delta == 1) && ((m != 9) || (u != 0))) {
+      upper_delta = 2;
+    }
+
+    // It's OK to round up if upper has a different digit and either upper is
+    // inclusive or upper is bigger than the result of rounding up.
+    bool ok_up = (upper_delta > 0) &&   //
+                 (inclusive ||          //
+                  (upper_delta > 1) ||  //
+                  ((ui + 1) < ((int32_t)(upper.num_digits))));
+
+    if (ok_down && ok_up) {
+      wuffs_base__private_implementation__high_prec_dec__round_nearest(h,
+                                                                       mi + 1);
+      return;
+    } else if (ok_down) {
+      wuffs_base__private_implementation__high_prec_dec__round_down(h, mi + 1);
+      return;
+    } else if (ok_up) {
+      wuffs_base__private_implementation__high_prec_dec__round_up(h, mi + 1);
+      return;
+    }
+  }
+}
+
 // --------
 
 // The wuffs_base__private_implementation__etc_powers_of_10 tables were printed
@@ -1262,6 +1584,12 @@ wuffs_base__private_implementation__medium_prec_bin__parse_number_f64(
     if (subnormal_exp2 >= m->exp2) {
       surplus_bits += 1 + ((uint32_t)(subnormal_exp2 - m->exp2));
     }
+    // Far enough below the smallest subnormal, every mantissa bit is a
+    // surplus bit. Leave that (round to zero or to the smallest subnormal)
+    // to the HPD code, instead of shifting a uint64_t by 64 or more.
+    if (surplus_bits > 63) {
+      goto fail;
+    }
 
     uint64_t surplus_mask =
         (((uint64_t)1) << surplus_bits) - 1;  // e.g. 0x07FF.
@@ -1296,6 +1624,734 @@ fail:
 
 // --------
 
+// The wuffs_base__private_implementation__powers_of_10 table was printed by
+// script/print-eisel-lemire-powers-of-10.go. That script has an optional
+// -comments flag, whose output is not copied here, which prints further
+// detail.
+//
+// This table is used in
+// wuffs_base__private_implementation__parse_number_f64_eisel_lemire.
+
+// wuffs_base__private_implementation__powers_of_10 contains truncated
+// approximations to the powers of 10, ranging from 1e-307 to 1e+288 inclusive,
+// as 596 pairs of uint64_t values (a 128-bit mantissa).
+//
+// Each pair is the (lo, hi) halves of a normalized (the 1<<127 bit is set)
+// 128-bit mantissa. The implied base-2 exponent is not stored, since it can be
+// calculated from the base-10 exponent: see the "217706" comment below.
+//
+// For example, the pair for 1e-1, (0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC),
+// means:
+//   1e-1 ≈ 0xCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC * (2 ** -131)
+// Similarly, the pair for 1e+1, (0x0000000000000000, 0xA000000000000000),
+// means:
+//   1e+1 ≈ 0xA0000000000000000000000000000000 * (2 ** -124)  // Exact.
+static const uint64_t
+    wuffs_base__private_implementation__powers_of_10[596][2] = {
+        {0xA5D3B6D479F8E056, 0x8FD0C16206306BAB},
+        {0x8F48A4899877186C, 0xB3C4F1BA87BC8696},
+        {0x331ACDABFE94DE87, 0xE0B62E2929ABA83C},
+        {0x9FF0C08B7F1D0B14, 0x8C71DCD9BA0B4925},
+        {0x07ECF0AE5EE44DD9, 0xAF8E5410288E1B6F},
+        {0xC9E82CD9F69D6150, 0xDB71E91432B1A24A},
+        {0xBE311C083A225CD2, 0x892731AC9FAF056E},
+        {0x6DBD630A48AAF406, 0xAB70FE17C79AC6CA},
+        {0x092CBBCCDAD5B108, 0xD64D3D9DB981787D},
+        {0x25BBF56008C58EA5, 0x85F0468293F0EB4E},
+        {0xAF2AF2B80AF6F24E, 0xA76C582338ED2621},
+        {0x1AF5AF660DB4AEE1, 0xD1476E2C07286FAA},
+        {0x50D98D9FC890ED4D, 0x82CCA4DB847945CA},
+        {0xE50FF107BAB528A0, 0xA37FCE126597973C},
+        {0x1E53ED49A96272C8, 0xCC5FC196FEFD7D0C},
+        {0x25E8E89C13BB0F7A, 0xFF77B1FCBEBCDC4F},
+        {0x77B191618C54E9AC, 0x9FAACF3DF73609B1},
+        {0xD59DF5B9EF6A2417, 0xC795830D75038C1D},
+        {0x4B0573286B44AD1D, 0xF97AE3D0D2446F25},
+        {0x4EE367F9430AEC32, 0x9BECCE62836AC577},
+        {0x229C41F793CDA73F, 0xC2E801FB244576D5},
+        {0x6B43527578C1110F, 0xF3A20279ED56D48A},
+        {0x830A13896B78AAA9, 0x9845418C345644D6},
+        {0x23CC986BC656D553, 0xBE5691EF416BD60C},
+        {0x2CBFBE86B7EC8AA8, 0xEDEC366B11C6CB8F},
+        {0x7BF7D71432F3D6A9, 0x94B3A202EB1C3F39},
+        {0xDAF5CCD93FB0CC53, 0xB9E08A83A5E34F07},
+        {0xD1B3400F8F9CFF68, 0xE858AD248F5C22C9},
+        {0x23100809B9C21FA1, 0x91376C36D99995BE},
+        {0xABD40A0C2832A78A, 0xB58547448FFFFB2D},
+        {0x16C90C8F323F516C, 0xE2E69915B3FFF9F9},
+        {0xAE3DA7D97F6792E3, 0x8DD01FAD907FFC3B},
+        {0x99CD11CFDF41779C, 0xB1442798F49FFB4A},
+        {0x40405643D711D583, 0xDD95317F31C7FA1D},
+        {0x482835EA666B2572, 0x8A7D3EEF7F1CFC52},
+        {0xDA3243650005EECF, 0xAD1C8EAB5EE43B66},
+        {0x90BED43E40076A82, 0xD863B256369D4A40},
+        {0x5A7744A6E804A291, 0x873E4F75E2224E68},
+        {0x711515D0A205CB36, 0xA90DE3535AAAE202},
+        {0x0D5A5B44CA873E03, 0xD3515C2831559A83},
+        {0xE858790AFE9486C2, 0x8412D9991ED58091},
+        {0x626E974DBE39A872, 0xA5178FFF668AE0B6},
+        {0xFB0A3D212DC8128F, 0xCE5D73FF402D98E3},
+        {0x7CE66634BC9D0B99, 0x80FA687F881C7F8E},
+        {0x1C1FFFC1EBC44E80, 0xA139029F6A239F72},
+        {0xA327FFB266B56220, 0xC987434744AC874E},
+        {0x4BF1FF9F0062BAA8, 0xFBE9141915D7A922},
+        {0x6F773FC3603DB4A9, 0x9D71AC8FADA6C9B5},
+        {0xCB550FB4384D21D3, 0xC4CE17B399107C22},
+        {0x7E2A53A146606A48, 0xF6019DA07F549B2B},
+        {0x2EDA7444CBFC426D, 0x99C102844F94E0FB},
+        {0xFA911155FEFB5308, 0xC0314325637A1939},
+        {0x793555AB7EBA27CA, 0xF03D93EEBC589F88},
+        {0x4BC1558B2F3458DE, 0x96267C7535B763B5},
+        {0x9EB1AAEDFB016F16, 0xBBB01B9283253CA2},
+        {0x465E15A979C1CADC, 0xEA9C227723EE8BCB},
+        {0x0BFACD89EC191EC9, 0x92A1958A7675175F},
+        {0xCEF980EC671F667B, 0xB749FAED14125D36},
+        {0x82B7E12780E7401A, 0xE51C79A85916F484},
+        {0xD1B2ECB8B0908810, 0x8F31CC0937AE58D2},
+        {0x861FA7E6DCB4AA15, 0xB2FE3F0B8599EF07},
+        {0x67A791E093E1D49A, 0xDFBDCECE67006AC9},
+        {0xE0C8BB2C5C6D24E0, 0x8BD6A141006042BD},
+        {0x58FAE9F773886E18, 0xAECC49914078536D},
+        {0xAF39A475506A899E, 0xDA7F5BF590966848},
+        {0x6D8406C952429603, 0x888F99797A5E012D},
+        {0xC8E5087BA6D33B83, 0xAAB37FD7D8F58178},
+        {0xFB1E4A9A90880A64, 0xD5605FCDCF32E1D6},
+        {0x5CF2EEA09A55067F, 0x855C3BE0A17FCD26},
+        {0xF42FAA48C0EA481E, 0xA6B34AD8C9DFC06F},
+        {0xF13B94DAF124DA26, 0xD0601D8EFC57B08B},
+        {0x76C53D08D6B70858, 0x823C12795DB6CE57},
+        {0x54768C4B0C64CA6E, 0xA2CB1717B52481ED},
+        {0xA9942F5DCF7DFD09, 0xCB7DDCDDA26DA268},
+        {0xD3F93B35435D7C4C, 0xFE5D54150B090B02},
+        {0xC47BC5014A1A6DAF, 0x9EFA548D26E5A6E1},
+        {0x359AB6419CA1091B, 0xC6B8E9B0709F109A},
+        {0xC30163D203C94B62, 0xF867241C8CC6D4C0},
+        {0x79E0DE63425DCF1D, 0x9B407691D7FC44F8},
+        {0x985915FC12F542E4, 0xC21094364DFB5636},
+        {0x3E6F5B7B17B2939D, 0xF294B943E17A2BC4},
+        {0xA705992CEECF9C42, 0x979CF3CA6CEC5B5A},
+        {0x50C6FF782A838353, 0xBD8430BD08277231},
+        {0xA4F8BF5635246428, 0xECE53CEC4A314EBD},
+        {0x871B7795E136BE99, 0x940F4613AE5ED136},
+        {0x28E2557B59846E3F, 0xB913179899F68584},
+        {0x331AEADA2FE589CF, 0xE757DD7EC07426E5},
+        {0x3FF0D2C85DEF7621, 0x9096EA6F3848984F},
+        {0x0FED077A756B53A9, 0xB4BCA50B065ABE63},
+        {0xD3E8495912C62894, 0xE1EBCE4DC7F16DFB},
+        {0x64712DD7ABBBD95C, 0x8D3360F09CF6E4BD},
+        {0xBD8D794D96AACFB3, 0xB080392CC4349DEC},
+        {0xECF0D7A0FC5583A0, 0xDCA04777F541C567},
+        {0xF41686C49DB57244, 0x89E42CAAF9491B60},
+        {0x311C2875C522CED5, 0xAC5D37D5B79B6239},
+        {0x7D633293366B828B, 0xD77485CB25823AC7},
+        {0xAE5DFF9C02033197, 0x86A8D39EF77164BC},
+        {0xD9F57F830283FDFC, 0xA8530886B54DBDEB},
+        {0xD072DF63C324FD7B, 0xD267CAA862A12D66},
+        {0x4247CB9E59F71E6D, 0x8380DEA93DA4BC60},
+        {0x52D9BE85F074E608, 0xA46116538D0DEB78},
+        {0x67902E276C921F8B, 0xCD795BE870516656},
+        {0x00BA1CD8A3DB53B6, 0x806BD9714632DFF6},
+        {0x80E8A40ECCD228A4, 0xA086CFCD97BF97F3},
+        {0x6122CD128006B2CD, 0xC8A883C0FDAF7DF0},
+        {0x796B805720085F81, 0xFAD2A4B13D1B5D6C},
+        {0xCBE3303674053BB0, 0x9CC3A6EEC6311A63},
+        {0xBEDBFC4411068A9C, 0xC3F490AA77BD60FC},
+        {0xEE92FB5515482D44, 0xF4F1B4D515ACB93B},
+        {0x751BDD152D4D1C4A, 0x991711052D8BF3C5},
+        {0xD262D45A78A0635D, 0xBF5CD54678EEF0B6},
+        {0x86FB897116C87C34, 0xEF340A98172AACE4},
+        {0xD45D35E6AE3D4DA0, 0x9580869F0E7AAC0E},
+        {0x8974836059CCA109, 0xBAE0A846D2195712},
+        {0x2BD1A438703FC94B, 0xE998D258869FACD7},
+        {0x7B6306A34627DDCF, 0x91FF83775423CC06},
+        {0x1A3BC84C17B1D542, 0xB67F6455292CBF08},
+        {0x20CABA5F1D9E4A93, 0xE41F3D6A7377EECA},
+        {0x547EB47B7282EE9C, 0x8E938662882AF53E},
+        {0xE99E619A4F23AA43, 0xB23867FB2A35B28D},
+        {0x6405FA00E2EC94D4, 0xDEC681F9F4C31F31},
+        {0xDE83BC408DD3DD04, 0x8B3C113C38F9F37E},
+        {0x9624AB50B148D445, 0xAE0B158B4738705E},
+        {0x3BADD624DD9B0957, 0xD98DDAEE19068C76},
+        {0xE54CA5D70A80E5D6, 0x87F8A8D4CFA417C9},
+        {0x5E9FCF4CCD211F4C, 0xA9F6D30A038D1DBC},
+        {0x7647C3200069671F, 0xD47487CC8470652B},
+        {0x29ECD9F40041E073, 0x84C8D4DFD2C63F3B},
+        {0xF468107100525890, 0xA5FB0A17C777CF09},
+        {0x7182148D4066EEB4, 0xCF79CC9DB955C2CC},
+        {0xC6F14CD848405530, 0x81AC1FE293D599BF},
+        {0xB8ADA00E5A506A7C, 0xA21727DB38CB002F},
+        {0xA6D90811F0E4851C, 0xCA9CF1D206FDC03B},
+        {0x908F4A166D1DA663, 0xFD442E4688BD304A},
+        {0x9A598E4E043287FE, 0x9E4A9CEC15763E2E},
+        {0x40EFF1E1853F29FD, 0xC5DD44271AD3CDBA},
+        {0xD12BEE59E68EF47C, 0xF7549530E188C128},
+        {0x82BB74F8301958CE, 0x9A94DD3E8CF578B9},
+        {0xE36A52363C1FAF01, 0xC13A148E3032D6E7},
+        {0xDC44E6C3CB279AC1, 0xF18899B1BC3F8CA1},
+        {0x29AB103A5EF8C0B9, 0x96F5600F15A7B7E5},
+        {0x7415D448F6B6F0E7, 0xBCB2B812DB11A5DE},
+        {0x111B495B3464AD21, 0xEBDF661791D60F56},
+        {0xCAB10DD900BEEC34, 0x936B9FCEBB25C995},
+        {0x3D5D514F40EEA742, 0xB84687C269EF3BFB},
+        {0x0CB4A5A3112A5112, 0xE65829B3046B0AFA},
+        {0x47F0E785EABA72AB, 0x8FF71A0FE2C2E6DC},
+        {0x59ED216765690F56, 0xB3F4E093DB73A093},
+        {0x306869C13EC3532C, 0xE0F218B8D25088B8},
+        {0x1E414218C73A13FB, 0x8C974F7383725573},
+        {0xE5D1929EF90898FA, 0xAFBD2350644EEACF},
+        {0xDF45F746B74ABF39, 0xDBAC6C247D62A583},
+        {0x6B8BBA8C328EB783, 0x894BC396CE5DA772},
+        {0x066EA92F3F326564, 0xAB9EB47C81F5114F},
+        {0xC80A537B0EFEFEBD, 0xD686619BA27255A2},
+        {0xBD06742CE95F5F36, 0x8613FD0145877585},
+        {0x2C48113823B73704, 0xA798FC4196E952E7},
+        {0xF75A15862CA504C5, 0xD17F3B51FCA3A7A0},
+        {0x9A984D73DBE722FB, 0x82EF85133DE648C4},
+        {0xC13E60D0D2E0EBBA, 0xA3AB66580D5FDAF5},
+        {0x318DF905079926A8, 0xCC963FEE10B7D1B3},
+        {0xFDF17746497F7052, 0xFFBBCFE994E5C61F},
+        {0xFEB6EA8BEDEFA633, 0x9FD561F1FD0F9BD3},
+        {0xFE64A52EE96B8FC0, 0xC7CABA6E7C5382C8},
+        {0x3DFDCE7AA3C673B0, 0xF9BD690A1B68637B},
+        {0x06BEA10CA65C084E, 0x9C1661A651213E2D},
+        {0x486E494FCFF30A62, 0xC31BFA0FE5698DB8},
+        {0x5A89DBA3C3EFCCFA, 0xF3E2F893DEC3F126},
+        {0xF89629465A75E01C, 0x986DDB5C6B3A76B7},
+        {0xF6BBB397F1135823, 0xBE89523386091465},
+        {0x746AA07DED582E2C, 0xEE2BA6C0678B597F},
+        {0xA8C2A44EB4571CDC, 0x94DB483840B717EF},
+        {0x92F34D62616CE413, 0xBA121A4650E4DDEB},
+        {0x77B020BAF9C81D17, 0xE896A0D7E51E1566},
+        {0x0ACE1474DC1D122E, 0x915E2486EF32CD60},
+        {0x0D819992132456BA, 0xB5B5ADA8AAFF80B8},
+        {0x10E1FFF697ED6C69, 0xE3231912D5BF60E6},
+        {0xCA8D3FFA1EF463C1, 0x8DF5EFABC5979C8F},
+        {0xBD308FF8A6B17CB2, 0xB1736B96B6FD83B3},
+        {0xAC7CB3F6D05DDBDE, 0xDDD0467C64BCE4A0},
+        {0x6BCDF07A423AA96B, 0x8AA22C0DBEF60EE4},
+        {0x86C16C98D2C953C6, 0xAD4AB7112EB3929D},
+        {0xE871C7BF077BA8B7, 0xD89D64D57A607744},
+        {0x11471CD764AD4972, 0x87625F056C7C4A8B},
+        {0xD598E40D3DD89BCF, 0xA93AF6C6C79B5D2D},
+        {0x4AFF1D108D4EC2C3, 0xD389B47879823479},
+        {0xCEDF722A585139BA, 0x843610CB4BF160CB},
+        {0xC2974EB4EE658828, 0xA54394FE1EEDB8FE},
+        {0x733D226229FEEA32, 0xCE947A3DA6A9273E},
+        {0x0806357D5A3F525F, 0x811CCC668829B887},
+        {0xCA07C2DCB0CF26F7, 0xA163FF802A3426A8},
+        {0xFC89B393DD02F0B5, 0xC9BCFF6034C13052},
+        {0xBBAC2078D443ACE2, 0xFC2C3F3841F17C67},
+        {0xD54B944B84AA4C0D, 0x9D9BA7832936EDC0},
+        {0x0A9E795E65D4DF11, 0xC5029163F384A931},
+        {0x4D4617B5FF4A16D5, 0xF64335BCF065D37D},
+        {0x504BCED1BF8E4E45, 0x99EA0196163FA42E},
+        {0xE45EC2862F71E1D6, 0xC06481FB9BCF8D39},
+        {0x5D767327BB4E5A4C, 0xF07DA27A82C37088},
+        {0x3A6A07F8D510F86F, 0x964E858C91BA2655},
+        {0x890489F70A55368B, 0xBBE226EFB628AFEA},
+        {0x2B45AC74CCEA842E, 0xEADAB0ABA3B2DBE5},
+        {0x3B0B8BC90012929D, 0x92C8AE6B464FC96F},
+        {0x09CE6EBB40173744, 0xB77ADA0617E3BBCB},
+        {0xCC420A6A101D0515, 0xE55990879DDCAABD},
+        {0x9FA946824A12232D, 0x8F57FA54C2A9EAB6},
+        {0x47939822DC96ABF9, 0xB32DF8E9F3546564},
+        {0x59787E2B93BC56F7, 0xDFF9772470297EBD},
+        {0x57EB4EDB3C55B65A, 0x8BFBEA76C619EF36},
+        {0xEDE622920B6B23F1, 0xAEFAE51477A06B03},
+        {0xE95FAB368E45ECED, 0xDAB99E59958885C4},
+        {0x11DBCB0218EBB414, 0x88B402F7FD75539B},
+        {0xD652BDC29F26A119, 0xAAE103B5FCD2A881},
+        {0x4BE76D3346F0495F, 0xD59944A37C0752A2},
+        {0x6F70A4400C562DDB, 0x857FCAE62D8493A5},
+        {0xCB4CCD500F6BB952, 0xA6DFBD9FB8E5B88E},
+        {0x7E2000A41346A7A7, 0xD097AD07A71F26B2},
+        {0x8ED400668C0C28C8, 0x825ECC24C873782F},
+        {0x728900802F0F32FA, 0xA2F67F2DFA90563B},
+        {0x4F2B40A03AD2FFB9, 0xCBB41EF979346BCA},
+        {0xE2F610C84987BFA8, 0xFEA126B7D78186BC},
+        {0x0DD9CA7D2DF4D7C9, 0x9F24B832E6B0F436},
+        {0x91503D1C79720DBB, 0xC6EDE63FA05D3143},
+        {0x75A44C6397CE912A, 0xF8A95FCF88747D94},
+        {0xC986AFBE3EE11ABA, 0x9B69DBE1B548CE7C},
+        {0xFBE85BADCE996168, 0xC24452DA229B021B},
+        {0xFAE27299423FB9C3, 0xF2D56790AB41C2A2},
+        {0xDCCD879FC967D41A, 0x97C560BA6B0919A5},
+        {0x5400E987BBC1C920, 0xBDB6B8E905CB600F},
+        {0x290123E9AAB23B68, 0xED246723473E3813},
+        {0xF9A0B6720AAF6521, 0x9436C0760C86E30B},
+        {0xF808E40E8D5B3E69, 0xB94470938FA89BCE},
+        {0xB60B1D1230B20E04, 0xE7958CB87392C2C2},
+        {0xB1C6F22B5E6F48C2, 0x90BD77F3483BB9B9},
+        {0x1E38AEB6360B1AF3, 0xB4ECD5F01A4AA828},
+        {0x25C6DA63C38DE1B0, 0xE2280B6C20DD5232},
+        {0x579C487E5A38AD0E, 0x8D590723948A535F},
+        {0x2D835A9DF0C6D851, 0xB0AF48EC79ACE837},
+        {0xF8E431456CF88E65, 0xDCDB1B2798182244},
+        {0x1B8E9ECB641B58FF, 0x8A08F0F8BF0F156B},
+        {0xE272467E3D222F3F, 0xAC8B2D36EED2DAC5},
+        {0x5B0ED81DCC6ABB0F, 0xD7ADF884AA879177},
+        {0x98E947129FC2B4E9, 0x86CCBB52EA94BAEA},
+        {0x3F2398D747B36224, 0xA87FEA27A539E9A5},
+        {0x8EEC7F0D19A03AAD, 0xD29FE4B18E88640E},
+        {0x1953CF68300424AC, 0x83A3EEEEF9153E89},
+        {0x5FA8C3423C052DD7, 0xA48CEAAAB75A8E2B},
+        {0x3792F412CB06794D, 0xCDB02555653131B6},
+        {0xE2BBD88BBEE40BD0, 0x808E17555F3EBF11},
+        {0x5B6ACEAEAE9D0EC4, 0xA0B19D2AB70E6ED6},
+        {0xF245825A5A445275, 0xC8DE047564D20A8B},
+        {0xEED6E2F0F0D56712, 0xFB158592BE068D2E},
+        {0x55464DD69685606B, 0x9CED737BB6C4183D},
+        {0xAA97E14C3C26B886, 0xC428D05AA4751E4C},
+        {0xD53DD99F4B3066A8, 0xF53304714D9265DF},
+        {0xE546A8038EFE4029, 0x993FE2C6D07B7FAB},
+        {0xDE98520472BDD033, 0xBF8FDB78849A5F96},
+        {0x963E66858F6D4440, 0xEF73D256A5C0F77C},
+        {0xDDE7001379A44AA8, 0x95A8637627989AAD},
+        {0x5560C018580D5D52, 0xBB127C53B17EC159},
+        {0xAAB8F01E6E10B4A6, 0xE9D71B689DDE71AF},
+        {0xCAB3961304CA70E8, 0x9226712162AB070D},
+        {0x3D607B97C5FD0D22, 0xB6B00D69BB55C8D1},
+        {0x8CB89A7DB77C506A, 0xE45C10C42A2B3B05},
+        {0x77F3608E92ADB242, 0x8EB98A7A9A5B04E3},
+        {0x55F038B237591ED3, 0xB267ED1940F1C61C},
+        {0x6B6C46DEC52F6688, 0xDF01E85F912E37A3},
+        {0x2323AC4B3B3DA015, 0x8B61313BBABCE2C6},
+        {0xABEC975E0A0D081A, 0xAE397D8AA96C1B77},
+        {0x96E7BD358C904A21, 0xD9C7DCED53C72255},
+        {0x7E50D64177DA2E54, 0x881CEA14545C7575},
+        {0xDDE50BD1D5D0B9E9, 0xAA242499697392D2},
+        {0x955E4EC64B44E864, 0xD4AD2DBFC3D07787},
+        {0xBD5AF13BEF0B113E, 0x84EC3C97DA624AB4},
+        {0xECB1AD8AEACDD58E, 0xA6274BBDD0FADD61},
+        {0x67DE18EDA5814AF2, 0xCFB11EAD453994BA},
+        {0x80EACF948770CED7, 0x81CEB32C4B43FCF4},
+        {0xA1258379A94D028D, 0xA2425FF75E14FC31},
+        {0x096EE45813A04330, 0xCAD2F7F5359A3B3E},
+        {0x8BCA9D6E188853FC, 0xFD87B5F28300CA0D},
+        {0x775EA264CF55347D, 0x9E74D1B791E07E48},
+        {0x95364AFE032A819D, 0xC612062576589DDA},
+        {0x3A83DDBD83F52204, 0xF79687AED3EEC551},
+        {0xC4926A9672793542, 0x9ABE14CD44753B52},
+        {0x75B7053C0F178293, 0xC16D9A0095928A27},
+        {0x5324C68B12DD6338, 0xF1C90080BAF72CB1},
+        {0xD3F6FC16EBCA5E03, 0x971DA05074DA7BEE},
+        {0x88F4BB1CA6BCF584, 0xBCE5086492111AEA},
+        {0x2B31E9E3D06C32E5, 0xEC1E4A7DB69561A5},
+        {0x3AFF322E62439FCF, 0x9392EE8E921D5D07},
+        {0x09BEFEB9FAD487C2, 0xB877AA3236A4B449},
+        {0x4C2EBE687989A9B3, 0xE69594BEC44DE15B},
+        {0x0F9D37014BF60A10, 0x901D7CF73AB0ACD9},
+        {0x538484C19EF38C94, 0xB424DC35095CD80F},
+        {0x2865A5F206B06FB9, 0xE12E13424BB40E13},
+        {0xF93F87B7442E45D3, 0x8CBCCC096F5088CB},
+        {0xF78F69A51539D748, 0xAFEBFF0BCB24AAFE},
+        {0xB573440E5A884D1B, 0xDBE6FECEBDEDD5BE},
+        {0x31680A88F8953030, 0x89705F4136B4A597},
+        {0xFDC20D2B36BA7C3D, 0xABCC77118461CEFC},
+        {0x3D32907604691B4C, 0xD6BF94D5E57A42BC},
+        {0xA63F9A49C2C1B10F, 0x8637BD05AF6C69B5},
+        {0x0FCF80DC33721D53, 0xA7C5AC471B478423},
+        {0xD3C36113404EA4A8, 0xD1B71758E219652B},
+        {0x645A1CAC083126E9, 0x83126E978D4FDF3B},
+        {0x3D70A3D70A3D70A3, 0xA3D70A3D70A3D70A},
+        {0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC},
+        {0x0000000000000000, 0x8000000000000000},
+        {0x0000000000000000, 0xA000000000000000},
+        {0x0000000000000000, 0xC800000000000000},
+        {0x0000000000000000, 0xFA00000000000000},
+        {0x0000000000000000, 0x9C40000000000000},
+        {0x0000000000000000, 0xC350000000000000},
+        {0x0000000000000000, 0xF424000000000000},
+        {0x0000000000000000, 0x9896800000000000},
+        {0x0000000000000000, 0xBEBC200000000000},
+        {0x0000000000000000, 0xEE6B280000000000},
+        {0x0000000000000000, 0x9502F90000000000},
+        {0x0000000000000000, 0xBA43B74000000000},
+        {0x0000000000000000, 0xE8D4A51000000000},
+        {0x0000000000000000, 0x9184E72A00000000},
+        {0x0000000000000000, 0xB5E620F480000000},
+        {0x0000000000000000, 0xE35FA931A0000000},
+        {0x0000000000000000, 0x8E1BC9BF04000000},
+        {0x0000000000000000, 0xB1A2BC2EC5000000},
+        {0x0000000000000000, 0xDE0B6B3A76400000},
+        {0x0000000000000000, 0x8AC7230489E80000},
+        {0x0000000000000000, 0xAD78EBC5AC620000},
+        {0x0000000000000000, 0xD8D726B7177A8000},
+        {0x0000000000000000, 0x878678326EAC9000},
+        {0x0000000000000000, 0xA968163F0A57B400},
+        {0x0000000000000000, 0xD3C21BCECCEDA100},
+        {0x0000000000000000, 0x84595161401484A0},
+        {0x0000000000000000, 0xA56FA5B99019A5C8},
+        {0x0000000000000000, 0xCECB8F27F4200F3A},
+        {0x4000000000000000, 0x813F3978F8940984},
+        {0x5000000000000000, 0xA18F07D736B90BE5},
+        {0xA400000000000000, 0xC9F2C9CD04674EDE},
+        {0x4D00000000000000, 0xFC6F7C4045812296},
+        {0xF020000000000000, 0x9DC5ADA82B70B59D},
+        {0x6C28000000000000, 0xC5371912364CE305},
+        {0xC732000000000000, 0xF684DF56C3E01BC6},
+        {0x3C7F400000000000, 0x9A130B963A6C115C},
+        {0x4B9F100000000000, 0xC097CE7BC90715B3},
+        {0x1E86D40000000000, 0xF0BDC21ABB48DB20},
+        {0x1314448000000000, 0x96769950B50D88F4},
+        {0x17D955A000000000, 0xBC143FA4E250EB31},
+        {0x5DCFAB0800000000, 0xEB194F8E1AE525FD},
+        {0x5AA1CAE500000000, 0x92EFD1B8D0CF37BE},
+        {0xF14A3D9E40000000, 0xB7ABC627050305AD},
+        {0x6D9CCD05D0000000, 0xE596B7B0C643C719},
+        {0xE4820023A2000000, 0x8F7E32CE7BEA5C6F},
+        {0xDDA2802C8A800000, 0xB35DBF821AE4F38B},
+        {0xD50B2037AD200000, 0xE0352F62A19E306E},
+        {0x4526F422CC340000, 0x8C213D9DA502DE45},
+        {0x9670B12B7F410000, 0xAF298D050E4395D6},
+        {0x3C0CDD765F114000, 0xDAF3F04651D47B4C},
+        {0xA5880A69FB6AC800, 0x88D8762BF324CD0F},
+        {0x8EEA0D047A457A00, 0xAB0E93B6EFEE0053},
+        {0x72A4904598D6D880, 0xD5D238A4ABE98068},
+        {0x47A6DA2B7F864750, 0x85A36366EB71F041},
+        {0x999090B65F67D924, 0xA70C3C40A64E6C51},
+        {0xFFF4B4E3F741CF6D, 0xD0CF4B50CFE20765},
+        {0xBFF8F10E7A8921A4, 0x82818F1281ED449F},
+        {0xAFF72D52192B6A0D, 0xA321F2D7226895C7},
+        {0x9BF4F8A69F764490, 0xCBEA6F8CEB02BB39},
+        {0x02F236D04753D5B4, 0xFEE50B7025C36A08},
+        {0x01D762422C946590, 0x9F4F2726179A2245},
+        {0x424D3AD2B7B97EF5, 0xC722F0EF9D80AAD6},
+        {0xD2E0898765A7DEB2, 0xF8EBAD2B84E0D58B},
+        {0x63CC55F49F88EB2F, 0x9B934C3B330C8577},
+        {0x3CBF6B71C76B25FB, 0xC2781F49FFCFA6D5},
+        {0x8BEF464E3945EF7A, 0xF316271C7FC3908A},
+        {0x97758BF0E3CBB5AC, 0x97EDD871CFDA3A56},
+        {0x3D52EEED1CBEA317, 0xBDE94E8E43D0C8EC},
+        {0x4CA7AAA863EE4BDD, 0xED63A231D4C4FB27},
+        {0x8FE8CAA93E74EF6A, 0x945E455F24FB1CF8},
+        {0xB3E2FD538E122B44, 0xB975D6B6EE39E436},
+        {0x60DBBCA87196B616, 0xE7D34C64A9C85D44},
+        {0xBC8955E946FE31CD, 0x90E40FBEEA1D3A4A},
+        {0x6BABAB6398BDBE41, 0xB51D13AEA4A488DD},
+        {0xC696963C7EED2DD1, 0xE264589A4DCDAB14},
+        {0xFC1E1DE5CF543CA2, 0x8D7EB76070A08AEC},
+        {0x3B25A55F43294BCB, 0xB0DE65388CC8ADA8},
+        {0x49EF0EB713F39EBE, 0xDD15FE86AFFAD912},
+        {0x6E3569326C784337, 0x8A2DBF142DFCC7AB},
+        {0x49C2C37F07965404, 0xACB92ED9397BF996},
+        {0xDC33745EC97BE906, 0xD7E77A8F87DAF7FB},
+        {0x69A028BB3DED71A3, 0x86F0AC99B4E8DAFD},
+        {0xC40832EA0D68CE0C, 0xA8ACD7C0222311BC},
+        {0xF50A3FA490C30190, 0xD2D80DB02AABD62B},
+        {0x792667C6DA79E0FA, 0x83C7088E1AAB65DB},
+        {0x577001B891185938, 0xA4B8CAB1A1563F52},
+        {0xED4C0226B55E6F86, 0xCDE6FD5E09ABCF26},
+        {0x544F8158315B05B4, 0x80B05E5AC60B6178},
+        {0x696361AE3DB1C721, 0xA0DC75F1778E39D6},
+        {0x03BC3A19CD1E38E9, 0xC913936DD571C84C},
+        {0x04AB48A04065C723, 0xFB5878494ACE3A5F},
+        {0x62EB0D64283F9C76, 0x9D174B2DCEC0E47B},
+        {0x3BA5D0BD324F8394, 0xC45D1DF942711D9A},
+        {0xCA8F44EC7EE36479, 0xF5746577930D6500},
+        {0x7E998B13CF4E1ECB, 0x9968BF6ABBE85F20},
+        {0x9E3FEDD8C321A67E, 0xBFC2EF456AE276E8},
+        {0xC5CFE94EF3EA101E, 0xEFB3AB16C59B14A2},
+        {0xBBA1F1D158724A12, 0x95D04AEE3B80ECE5},
+        {0x2A8A6E45AE8EDC97, 0xBB445DA9CA61281F},
+        {0xF52D09D71A3293BD, 0xEA1575143CF97226},
+        {0x593C2626705F9C56, 0x924D692CA61BE758},
+        {0x6F8B2FB00C77836C, 0xB6E0C377CFA2E12E},
+        {0x0B6DFB9C0F956447, 0xE498F455C38B997A},
+        {0x4724BD4189BD5EAC, 0x8EDF98B59A373FEC},
+        {0x58EDEC91EC2CB657, 0xB2977EE300C50FE7},
+        {0x2F2967B66737E3ED, 0xDF3D5E9BC0F653E1},
+        {0xBD79E0D20082EE74, 0x8B865B215899F46C},
+        {0xECD8590680A3AA11, 0xAE67F1E9AEC07187},
+        {0xE80E6F4820CC9495, 0xDA01EE641A708DE9},
+        {0x3109058D147FDCDD, 0x884134FE908658B2},
+        {0xBD4B46F0599FD415, 0xAA51823E34A7EEDE},
+        {0x6C9E18AC7007C91A, 0xD4E5E2CDC1D1EA96},
+        {0x03E2CF6BC604DDB0, 0x850FADC09923329E},
+        {0x84DB8346B786151C, 0xA6539930BF6BFF45},
+        {0xE612641865679A63, 0xCFE87F7CEF46FF16},
+        {0x4FCB7E8F3F60C07E, 0x81F14FAE158C5F6E},
+        {0xE3BE5E330F38F09D, 0xA26DA3999AEF7749},
+        {0x5CADF5BFD3072CC5, 0xCB090C8001AB551C},
+        {0x73D9732FC7C8F7F6, 0xFDCB4FA002162A63},
+        {0x2867E7FDDCDD9AFA, 0x9E9F11C4014DDA7E},
+        {0xB281E1FD541501B8, 0xC646D63501A1511D},
+        {0x1F225A7CA91A4226, 0xF7D88BC24209A565},
+        {0x3375788DE9B06958, 0x9AE757596946075F},
+        {0x0052D6B1641C83AE, 0xC1A12D2FC3978937},
+        {0xC0678C5DBD23A49A, 0xF209787BB47D6B84},
+        {0xF840B7BA963646E0, 0x9745EB4D50CE6332},
+        {0xB650E5A93BC3D898, 0xBD176620A501FBFF},
+        {0xA3E51F138AB4CEBE, 0xEC5D3FA8CE427AFF},
+        {0xC66F336C36B10137, 0x93BA47C980E98CDF},
+        {0xB80B0047445D4184, 0xB8A8D9BBE123F017},
+        {0xA60DC059157491E5, 0xE6D3102AD96CEC1D},
+        {0x87C89837AD68DB2F, 0x9043EA1AC7E41392},
+        {0x29BABE4598C311FB, 0xB454E4A179DD1877},
+        {0xF4296DD6FEF3D67A, 0xE16A1DC9D8545E94},
+        {0x1899E4A65F58660C, 0x8CE2529E2734BB1D},
+        {0x5EC05DCFF72E7F8F, 0xB01AE745B101E9E4},
+        {0x76707543F4FA1F73, 0xDC21A1171D42645D},
+        {0x6A06494A791C53A8, 0x899504AE72497EBA},
+        {0x0487DB9D17636892, 0xABFA45DA0EDBDE69},
+        {0x45A9D2845D3C42B6, 0xD6F8D7509292D603},
+        {0x0B8A2392BA45A9B2, 0x865B86925B9BC5C2},
+        {0x8E6CAC7768D7141E, 0xA7F26836F282B732},
+        {0x3207D795430CD926, 0xD1EF0244AF2364FF},
+        {0x7F44E6BD49E807B8, 0x8335616AED761F1F},
+        {0x5F16206C9C6209A6, 0xA402B9C5A8D3A6E7},
+        {0x36DBA887C37A8C0F, 0xCD036837130890A1},
+        {0xC2494954DA2C9789, 0x802221226BE55A64},
+        {0xF2DB9BAA10B7BD6C, 0xA02AA96B06DEB0FD},
+        {0x6F92829494E5ACC7, 0xC83553C5C8965D3D},
+        {0xCB772339BA1F17F9, 0xFA42A8B73ABBF48C},
+        {0xFF2A760414536EFB, 0x9C69A97284B578D7},
+        {0xFEF5138519684ABA, 0xC38413CF25E2D70D},
+        {0x7EB258665FC25D69, 0xF46518C2EF5B8CD1},
+        {0xEF2F773FFBD97A61, 0x98BF2F79D5993802},
+        {0xAAFB550FFACFD8FA, 0xBEEEFB584AFF8603},
+        {0x95BA2A53F983CF38, 0xEEAABA2E5DBF6784},
+        {0xDD945A747BF26183, 0x952AB45CFA97A0B2},
+        {0x94F971119AEEF9E4, 0xBA756174393D88DF},
+        {0x7A37CD5601AAB85D, 0xE912B9D1478CEB17},
+        {0xAC62E055C10AB33A, 0x91ABB422CCB812EE},
+        {0x577B986B314D6009, 0xB616A12B7FE617AA},
+        {0xED5A7E85FDA0B80B, 0xE39C49765FDF9D94},
+        {0x14588F13BE847307, 0x8E41ADE9FBEBC27D},
+        {0x596EB2D8AE258FC8, 0xB1D219647AE6B31C},
+        {0x6FCA5F8ED9AEF3BB, 0xDE469FBD99A05FE3},
+        {0x25DE7BB9480D5854, 0x8AEC23D680043BEE},
+        {0xAF561AA79A10AE6A, 0xADA72CCC20054AE9},
+        {0x1B2BA1518094DA04, 0xD910F7FF28069DA4},
+        {0x90FB44D2F05D0842, 0x87AA9AFF79042286},
+        {0x353A1607AC744A53, 0xA99541BF57452B28},
+        {0x42889B8997915CE8, 0xD3FA922F2D1675F2},
+        {0x69956135FEBADA11, 0x847C9B5D7C2E09B7},
+        {0x43FAB9837E699095, 0xA59BC234DB398C25},
+        {0x94F967E45E03F4BB, 0xCF02B2C21207EF2E},
+        {0x1D1BE0EEBAC278F5, 0x8161AFB94B44F57D},
+        {0x6462D92A69731732, 0xA1BA1BA79E1632DC},
+        {0x7D7B8F7503CFDCFE, 0xCA28A291859BBF93},
+        {0x5CDA735244C3D43E, 0xFCB2CB35E702AF78},
+        {0x3A0888136AFA64A7, 0x9DEFBF01B061ADAB},
+        {0x088AAA1845B8FDD0, 0xC56BAEC21C7A1916},
+        {0x8AAD549E57273D45, 0xF6C69A72A3989F5B},
+        {0x36AC54E2F678864B, 0x9A3C2087A63F6399},
+        {0x84576A1BB416A7DD, 0xC0CB28A98FCF3C7F},
+        {0x656D44A2A11C51D5, 0xF0FDF2D3F3C30B9F},
+        {0x9F644AE5A4B1B325, 0x969EB7C47859E743},
+        {0x873D5D9F0DDE1FEE, 0xBC4665B596706114},
+        {0xA90CB506D155A7EA, 0xEB57FF22FC0C7959},
+        {0x09A7F12442D588F2, 0x9316FF75DD87CBD8},
+        {0x0C11ED6D538AEB2F, 0xB7DCBF5354E9BECE},
+        {0x8F1668C8A86DA5FA, 0xE5D3EF282A242E81},
+        {0xF96E017D694487BC, 0x8FA475791A569D10},
+        {0x37C981DCC395A9AC, 0xB38D92D760EC4455},
+        {0x85BBE253F47B1417, 0xE070F78D3927556A},
+        {0x93956D7478CCEC8E, 0x8C469AB843B89562},
+        {0x387AC8D1970027B2, 0xAF58416654A6BABB},
+        {0x06997B05FCC0319E, 0xDB2E51BFE9D0696A},
+        {0x441FECE3BDF81F03, 0x88FCF317F22241E2},
+        {0xD527E81CAD7626C3, 0xAB3C2FDDEEAAD25A},
+        {0x8A71E223D8D3B074, 0xD60B3BD56A5586F1},
+        {0xF6872D5667844E49, 0x85C7056562757456},
+        {0xB428F8AC016561DB, 0xA738C6BEBB12D16C},
+        {0xE13336D701BEBA52, 0xD106F86E69D785C7},
+        {0xECC0024661173473, 0x82A45B450226B39C},
+        {0x27F002D7F95D0190, 0xA34D721642B06084},
+        {0x31EC038DF7B441F4, 0xCC20CE9BD35C78A5},
+        {0x7E67047175A15271, 0xFF290242C83396CE},
+        {0x0F0062C6E984D386, 0x9F79A169BD203E41},
+        {0x52C07B78A3E60868, 0xC75809C42C684DD1},
+        {0xA7709A56CCDF8A82, 0xF92E0C3537826145},
+        {0x88A66076400BB691, 0x9BBCC7A142B17CCB},
+        {0x6ACFF893D00EA435, 0xC2ABF989935DDBFE},
+        {0x0583F6B8C4124D43, 0xF356F7EBF83552FE},
+        {0xC3727A337A8B704A, 0x98165AF37B2153DE},
+        {0x744F18C0592E4C5C, 0xBE1BF1B059E9A8D6},
+        {0x1162DEF06F79DF73, 0xEDA2EE1C7064130C},
+        {0x8ADDCB5645AC2BA8, 0x9485D4D1C63E8BE7},
+        {0x6D953E2BD7173692, 0xB9A74A0637CE2EE1},
+        {0xC8FA8DB6CCDD0437, 0xE8111C87C5C1BA99},
+        {0x1D9C9892400A22A2, 0x910AB1D4DB9914A0},
+        {0x2503BEB6D00CAB4B, 0xB54D5E4A127F59C8},
+        {0x2E44AE64840FD61D, 0xE2A0B5DC971F303A},
+        {0x5CEAECFED289E5D2, 0x8DA471A9DE737E24},
+        {0x7425A83E872C5F47, 0xB10D8E1456105DAD},
+        {0xD12F124E28F77719, 0xDD50F1996B947518},
+        {0x82BD6B70D99AAA6F, 0x8A5296FFE33CC92F},
+        {0x636CC64D1001550B, 0xACE73CBFDC0BFB7B},
+        {0x3C47F7E05401AA4E, 0xD8210BEFD30EFA5A},
+        {0x65ACFAEC34810A71, 0x8714A775E3E95C78},
+        {0x7F1839A741A14D0D, 0xA8D9D1535CE3B396},
+        {0x1EDE48111209A050, 0xD31045A8341CA07C},
+        {0x934AED0AAB460432, 0x83EA2B892091E44D},
+        {0xF81DA84D5617853F, 0xA4E4B66B68B65D60},
+        {0x36251260AB9D668E, 0xCE1DE40642E3F4B9},
+        {0xC1D72B7C6B426019, 0x80D2AE83E9CE78F3},
+        {0xB24CF65B8612F81F, 0xA1075A24E4421730},
+        {0xDEE033F26797B627, 0xC94930AE1D529CFC},
+        {0x169840EF017DA3B1, 0xFB9B7CD9A4A7443C},
+        {0x8E1F289560EE864E, 0x9D412E0806E88AA5},
+        {0xF1A6F2BAB92A27E2, 0xC491798A08A2AD4E},
+        {0xAE10AF696774B1DB, 0xF5B5D7EC8ACB58A2},
+        {0xACCA6DA1E0A8EF29, 0x9991A6F3D6BF1765},
+        {0x17FD090A58D32AF3, 0xBFF610B0CC6EDD3F},
+        {0xDDFC4B4CEF07F5B0, 0xEFF394DCFF8A948E},
+        {0x4ABDAF101564F98E, 0x95F83D0A1FB69CD9},
+        {0x9D6D1AD41ABE37F1, 0xBB764C4CA7A4440F},
+        {0x84C86189216DC5ED, 0xEA53DF5FD18D5513},
+        {0x32FD3CF5B4E49BB4, 0x92746B9BE2F8552C},
+        {0x3FBC8C33221DC2A1, 0xB7118682DBB66A77},
+        {0x0FABAF3FEAA5334A, 0xE4D5E82392A40515},
+        {0x29CB4D87F2A7400E, 0x8F05B1163BA6832D},
+        {0x743E20E9EF511012, 0xB2C71D5BCA9023F8},
+        {0x914DA9246B255416, 0xDF78E4B2BD342CF6},
+        {0x1AD089B6C2F7548E, 0x8BAB8EEFB6409C1A},
+        {0xA184AC2473B529B1, 0xAE9672ABA3D0C320},
+        {0xC9E5D72D90A2741E, 0xDA3C0F568CC4F3E8},
+        {0x7E2FA67C7A658892, 0x8865899617FB1871},
+        {0xDDBB901B98FEEAB7, 0xAA7EEBFB9DF9DE8D},
+        {0x552A74227F3EA565, 0xD51EA6FA85785631},
+        {0xD53A88958F87275F, 0x8533285C936B35DE},
+        {0x8A892ABAF368F137, 0xA67FF273B8460356},
+        {0x2D2B7569B0432D85, 0xD01FEF10A657842C},
+        {0x9C3B29620E29FC73, 0x8213F56A67F6B29B},
+        {0x8349F3BA91B47B8F, 0xA298F2C501F45F42},
+        {0x241C70A936219A73, 0xCB3F2F7642717713},
+        {0xED238CD383AA0110, 0xFE0EFB53D30DD4D7},
+        {0xF4363804324A40AA, 0x9EC95D1463E8A506},
+        {0xB143C6053EDCD0D5, 0xC67BB4597CE2CE48},
+        {0xDD94B7868E94050A, 0xF81AA16FDC1B81DA},
+        {0xCA7CF2B4191C8326, 0x9B10A4E5E9913128},
+        {0xFD1C2F611F63A3F0, 0xC1D4CE1F63F57D72},
+        {0xBC633B39673C8CEC, 0xF24A01A73CF2DCCF},
+        {0xD5BE0503E085D813, 0x976E41088617CA01},
+        {0x4B2D8644D8A74E18, 0xBD49D14AA79DBC82},
+        {0xDDF8E7D60ED1219E, 0xEC9C459D51852BA2},
+        {0xCABB90E5C942B503, 0x93E1AB8252F33B45},
+        {0x3D6A751F3B936243, 0xB8DA1662E7B00A17},
+        {0x0CC512670A783AD4, 0xE7109BFBA19C0C9D},
+        {0x27FB2B80668B24C5, 0x906A617D450187E2},
+        {0xB1F9F660802DEDF6, 0xB484F9DC9641E9DA},
+        {0x5E7873F8A0396973, 0xE1A63853BBD26451},
+        {0xDB0B487B6423E1E8, 0x8D07E33455637EB2},
+        {0x91CE1A9A3D2CDA62, 0xB049DC016ABC5E5F},
+        {0x7641A140CC7810FB, 0xDC5C5301C56B75F7},
+        {0xA9E904C87FCB0A9D, 0x89B9B3E11B6329BA},
+        {0x546345FA9FBDCD44, 0xAC2820D9623BF429},
+        {0xA97C177947AD4095, 0xD732290FBACAF133},
+        {0x49ED8EABCCCC485D, 0x867F59A9D4BED6C0},
+        {0x5C68F256BFFF5A74, 0xA81F301449EE8C70},
+        {0x73832EEC6FFF3111, 0xD226FC195C6A2F8C},
+};
+
+// wuffs_base__private_implementation__parse_number_f64_eisel_lemire returns
+// the closest double-precision float64 to (man * (10 ** exp10)), as IEEE 754
+// bits, or -1 if it cannot determine that result unambiguously.
+//
+// This is the algorithm from Daniel Lemire, "Number Parsing at a Gigabyte per
+// Second" (https://arxiv.org/abs/2101.11408), which builds on an idea by
+// Michael Eisel. It multiplies the 64-bit man by a 64-bit (or, if that isn't
+// precise enough, 128-bit) approximation to (10 ** exp10) and gives up (for a
+// slower, arbitrary precision fallback) if the truncated product lies too
+// close to a rounding boundary. In practice, it very rarely gives up.
+//
+// The returned value never has its sign bit set.
+//
+// Preconditions:
+//  - man is non-zero.
+//  - exp10 is in the range -307 ..= 288, the same range (from 1e-307 to
+//    1e+288) as wuffs_base__private_implementation__powers_of_10.
+//
+// The range of exp10 means that, for any uint64_t man, the result is a normal
+// (not subnormal, not infinite) float64, ignoring rounding at the very ends.
+static int64_t  //
+wuffs_base__private_implementation__parse_number_f64_eisel_lemire(
+    uint64_t man,
+    int32_t exp10) {
+  // The table entry is already normalized. Normalize man too.
+  const uint64_t* po10 =
+      &wuffs_base__private_implementation__powers_of_10[exp10 + 307][0];
+  uint32_t clz = wuffs_base__count_leading_zeroes_u64(man);
+  man <<= clz;
+
+  // Estimate the result's biased base-2 exponent. ((217706 * exp10) >> 16) is
+  // floor(log2(10 ** exp10)) over the table's range (confirmed by the script
+  // that printed the table). 1087 is 1023 + 64: the f64 exponent bias plus
+  // the width of man. This estimate is refined by -1 (below), depending on
+  // the high bit of the product.
+  uint64_t ret_exp2 =
+      ((uint64_t)(((217706 * exp10) >> 16) + 1087)) - ((uint64_t)clz);
+
+  // Multiply by the high 64 bits of the table entry. Both factors have their
+  // high bit set, so the 128-bit product x is at least (1 << 126) and x_hi has
+  // either 0 or 1 leading zeroes.
+  wuffs_base__multiply_u64__output x = wuffs_base__multiply_u64(man, po10[1]);
+  uint64_t x_hi = x.hi;
+  uint64_t x_lo = x.lo;
+
+  // The table entry was truncated, so x is a lower bound. The upper bound adds
+  // up to man to x_lo. We keep at most the top 55 bits of x_hi, so unless the
+  // low 9 bits of x_hi are all on and that addition carries, the lower bound
+  // gives the same answer as the upper bound.
+  if (((x_hi & 0x1FF) == 0x1FF) && ((x_lo + man) < man)) {
+    // Refine, using the low 64 bits of the table entry too. y is man times
+    // those low bits, and merged is the high 128 bits of the 192-bit product
+    // of man and the full 128-bit table entry.
+    wuffs_base__multiply_u64__output y = wuffs_base__multiply_u64(man, po10[0]);
+    uint64_t merged_hi = x_hi;
+    uint64_t merged_lo = x_lo + y.hi;
+    if (merged_lo < x_lo) {
+      merged_hi++;
+    }
+
+    // merged is still a lower bound. If its upper bound could still carry
+    // into the bits we keep, give up instead of going to even more precision.
+    if (((merged_hi & 0x1FF) == 0x1FF) && ((merged_lo + 1) == 0) &&
+        ((y.lo + man) < man)) {
+      return -1;
+    }
+
+    x_hi = merged_hi;
+    x_lo = merged_lo;
+  }
+
+  // Shift x_hi right by 9 or 10 bits (depending on its high bit) so that
+  // ret_mantissa has exactly 54 bits: 53 for a float64 plus 1 rounding bit.
+  uint64_t msb = x_hi >> 63;
+  uint64_t ret_mantissa = x_hi >> (msb + 9);
+  ret_exp2 -= 1 ^ msb;
+
+  // IEEE 754 rounds to nearest, ties to even. If x is exactly halfway between
+  // two float64 values (the dropped bits are "1000...000"), give up instead of
+  // deciding which way the tie breaks. For simplicity, this check treats the
+  // low 73 bits as dropped, regardless of msb.
+  if ((x_lo == 0) && ((x_hi & 0x1FF) == 0) && ((ret_mantissa & 3) == 1)) {
+    return -1;
+  }
+
+  // Round to nearest, from 54 to 53 bits. If that overflows to 54 bits
+  // again, shift once more.
+  ret_mantissa += ret_mantissa & 1;
+  ret_mantissa >>= 1;
+  if ((ret_mantissa >> 53) > 0) {
+    ret_mantissa >>= 1;
+    ret_exp2++;
+  }
+
+  // Give up on subnormal or infinite results. ret_exp2 is unsigned, so this
+  // rejects both 0 and 0x7FF (and anything wrapped around).
+  if ((ret_exp2 - 1) >= (0x7FF - 1)) {
+    return -1;
+  }
+
+  // Drop the implicit mantissa bit, pack the bits and return.
+  return (int64_t)((ret_mantissa & 0x000FFFFFFFFFFFFF) | (ret_exp2 << 52));
+}
+
+// --------
+
 wuffs_base__result_f64  //
 wuffs_base__parse_number_f64_special(wuffs_base__slice_u8 s,
                                      const char* fallback_status_repr) {
@@ -1397,8 +2453,13 @@ fallback:
   } while (0);
 }
 
-wuffs_base__result_f64  //
-wuffs_base__parse_number_f64(wuffs_base__slice_u8 s) {
+// wuffs_base__private_implementation__parse_number_f64_slow handles the
+// general case of wuffs_base__parse_number_f64: any number of digits, '_'
+// separators, a leading '+', a ',' decimal separator and extreme exponents.
+// It converts via an HPD, trying an MPB approximation first.
+static wuffs_base__result_f64  //
+wuffs_base__private_implementation__parse_number_f64_slow(
+    wuffs_base__slice_u8 s) {
   wuffs_base__private_implementation__medium_prec_bin m;
   wuffs_base__private_implementation__high_prec_dec h;
 
@@ -1548,6 +2609,639 @@ infinity:
   } while (0);
 }
 
+wuffs_base__result_f64  //
+wuffs_base__parse_number_f64(wuffs_base__slice_u8 s) {
+  // Try a fast path for the common case: "-ddd.dddE±ddd" with no '_' or '+'.
+  // Such a number is approximately (man * (10 ** exp10)), where man is a
+  // uint64_t holding the first 19 significant digits and exp10 is an int32_t,
+  // and can usually be converted without an HPD. Anything else (including
+  // invalid input) falls back to the slow path, which gives the same result,
+  // just slower.
+  do {
+    uint8_t* p = s.ptr;
+    uint8_t* q = s.ptr + s.len;
+
+    bool negative = (p < q) && (*p == '-');
+    p += negative ? 1 : 0;
+
+    // truncated is whether any non-zero digits after the first 19 significant
+    // digits were dropped: the exact value is strictly between (man * (10 **
+    // exp10)) and ((man + 1) * (10 ** exp10)).
+    uint64_t man = 0;
+    int32_t exp10 = 0;
+    uint32_t num_significant_digits = 0;
+    bool truncated = false;
+
+    // Parse the integral digits. A leading '0' must be the only one.
+    if ((p >= q) || (*p < '0') || ('9' < *p)) {
+      break;
+    } else if (*p == '0') {
+      p++;
+      if ((p < q) && ('0' <= *p) && (*p <= '9')) {
+        break;
+      }
+    } else {
+      uint8_t* integral = p;
+      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {
+        if (num_significant_digits < 19) {
+          man = (10 * man) + ((uint64_t)(*p - '0'));
+          num_significant_digits++;
+        } else {
+          exp10++;
+          truncated |= *p != '0';
+        }
+      }
+      if ((p - integral) >= 0x10000) {
+        goto slow;
+      }
+    }
+
+    // Parse the fractional digits, if any.
+    if ((p < q) && (*p == '.')) {
+      p++;
+      if ((p >= q) || (*p < '0') || ('9' < *p)) {
+        break;
+      }
+      uint8_t* fraction = p;
+      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {
+        if (num_significant_digits < 19) {
+          man = (10 * man) + ((uint64_t)(*p - '0'));
+          num_significant_digits += (man != 0) ? 1 : 0;
+          exp10--;
+        } else {
+          truncated |= *p != '0';
+        }
+      }
+      if ((p - fraction) >= 0x10000) {
+        goto slow;
+      }
+    }
+
+    // Parse the explicit exponent, if any. 0x10000 is far beyond any f64.
+    if ((p < q) && ((*p == 'E') || (*p == 'e'))) {
+      p++;
+      bool exp_negative = (p < q) && (*p == '-');
+      p += ((p < q) && ((*p == '-') || (*p == '+'))) ? 1 : 0;
+      if ((p >= q) || (*p < '0') || ('9' < *p)) {
+        break;
+      }
+      int32_t exp = 0;
+      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {
+        if (exp >= 0x10000) {
+          goto slow;
+        }
+        exp = (10 * exp) + ((int32_t)(*p - '0'));
+      }
+      exp10 += exp_negative ? -exp : +exp;
+    }
+
+    if (p != q) {
+      break;
+    }
+
+    uint64_t bits = negative ? 0x8000000000000000 : 0;
+    if (man == 0) {
+      wuffs_base__result_f64 ret;
+      ret.status.repr = NULL;
+      ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);
+      return ret;
+    }
+
+    if (!truncated) {
+      // Converting a uint64_t to a double is correctly rounded (even when
+      // half-way between two float64 values, which Eisel-Lemire gives up on).
+      // If man and (10 ** exp10) are both exactly representable as a float64,
+      // a single float64 multiply or divide is too.
+      double d = (double)man;
+      if (exp10 != 0) {
+        if (((man >> 53) != 0) || (exp10 < -22) || (22 < exp10)) {
+          goto eisel_lemire;
+        } else if (exp10 > 0) {
+          d *= wuffs_base__private_implementation__f64_powers_of_10[+exp10];
+        } else {
+          d /= wuffs_base__private_implementation__f64_powers_of_10[-exp10];
+        }
+      }
+      wuffs_base__result_f64 ret;
+      ret.status.repr = NULL;
+      ret.value = negative ? -d : +d;
+      return ret;
+    }
+
+  eisel_lemire:
+    if ((-307 <= exp10) && (exp10 <= 288)) {
+      int64_t r =
+          wuffs_base__private_implementation__parse_number_f64_eisel_lemire(
+              man, exp10);
+      // If truncated, the exact value is between man and (man + 1). It
+      // converts to r only if (man + 1) also converts to r.
+      if (truncated && (r >= 0) &&
+          (r !=
+           wuffs_base__private_implementation__parse_number_f64_eisel_lemire(
+               man + 1, exp10))) {
+        r = -1;
+      }
+      if (r >= 0) {
+        wuffs_base__result_f64 ret;
+        ret.status.repr = NULL;
+        ret.value = wuffs_base__ieee_754_bit_representation__to_f64(
+            ((uint64_t)r) | bits);
+        return ret;
+      }
+    }
+  } while (0);
+
+slow:
+  return wuffs_base__private_implementation__parse_number_f64_slow(s);
+}
+
+// --------
+
+// wuffs_base__private_implementation__render_number_f64_grisu3_round_weed
+// adjusts the last of the num_digits digits (which are in the range [0 ..= 9],
+// not ['0' ..= '9']) so that the number they represent is as close as possible
+// to the exact value, and then returns whether that is provably the closest
+// shortest representation. If not, the caller should fall back to a slower,
+// exact algorithm.
+//
+// All of the uint64_t arguments are scaled so that one unit in the last
+// digit's place (ten_kappa) and the uncertainty of the approximations (unit)
+// are in the same fixed point representation. distance_too_high_w is the
+// distance from the (imprecise) upper bound to the (imprecise) value.
+static bool  //
+wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(
+    uint8_t* digits,
+    uint32_t num_digits,
+    uint64_t distance_too_high_w,
+    uint64_t unsafe_interval,
+    uint64_t rest,
+    uint64_t ten_kappa,
+    uint64_t unit) {
+  uint64_t small_distance = distance_too_high_w - unit;
+  uint64_t big_distance = distance_too_high_w + unit;
+
+  // Decrement the last digit while that brings us closer to small_distance
+  // (the closest possible location of the exact value) and stays within the
+  // unsafe interval.
+  while ((rest < small_distance) &&                  //
+         ((unsafe_interval - rest) >= ten_kappa) &&  //
+         (((rest + ten_kappa) < small_distance) ||
+          ((small_distance - rest) >= (rest + ten_kappa - small_distance)))) {
+    digits[num_digits - 1]--;
+    rest += ten_kappa;
+  }
+
+  // If decrementing once more would also bring us closer to big_distance (the
+  // farthest possible location of the exact value) then we cannot know which
+  // of the two candidates is the closest.
+  if ((rest < big_distance) &&                    //
+      ((unsafe_interval - rest) >= ten_kappa) &&  //
+      (((rest + ten_kappa) < big_distance) ||
+       ((big_distance - rest) > (rest + ten_kappa - big_distance)))) {
+    return false;
+  }
+
+  // The candidate must be safely inside the interval, accounting for the
+  // imprecision (of up to 2 units) in the approximations on both sides.
+  return ((2 * unit) <= rest) && (rest <= (unsafe_interval - (4 * unit)));
+}
+
+// wuffs_base__private_implementation__render_number_f64_grisu3 sets h to the
+// shortest decimal that parses back to the double (mantissa * (2 ** exp2)),
+// where mantissa is non-zero and includes the implicit 1<<52 bit for normal
+// numbers. Among equally short decimals it picks the closest one.
+//
+// It returns false (leaving h in an unspecified state) if it cannot guarantee
+// that, which happens for about 0.5% of all doubles. The caller should then
+// fall back to wuffs_base__private_implementation__high_prec_dec__assign and
+// wuffs_base__private_implementation__high_prec_dec__round_just_enough.
+//
+// This is the Grisu3 algorithm from Loitsch, "Printing Floating-Point Numbers
+// Quickly and Accurately with Integers" (see the medium_prec_bin type above),
+// as implemented in https://github.com/google/double-conversion's
+// fast-dtoa.cc. It re-uses the big_powers_of_10 table, which is exactly the
+// cached powers table from that paper.
+static bool  //
+wuffs_base__private_implementation__render_number_f64_grisu3(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint64_t mantissa,
+    int32_t exp2) {
+  // The boundaries m_minus and m_plus are halfway between the number and its
+  // two neighbors. A power of 2 (other than the minimum exponent's) is closer
+  // to its predecessor than to its successor. Both boundaries have the same
+  // exp2 as the normalized w.
+  wuffs_base__private_implementation__medium_prec_bin m_plus;
+  m_plus.mantissa = (mantissa << 1) + 1;
+  m_plus.exp2 = exp2 - 1;
+  wuffs_base__private_implementation__medium_prec_bin__normalize(&m_plus);
+
+  wuffs_base__private_implementation__medium_prec_bin m_minus;
+  if ((mantissa == 0x10000000000000) && (exp2 > -1074)) {
+    m_minus.mantissa = (mantissa << 2) - 1;
+    m_minus.exp2 = exp2 - 2;
+  } else {
+    m_minus.mantissa = (mantissa << 1) - 1;
+    m_minus.exp2 = exp2 - 1;
+  }
+  m_minus.mantissa <<= (uint32_t)(m_minus.exp2 - m_plus.exp2);
+  m_minus.exp2 = m_plus.exp2;
+
+  wuffs_base__private_implementation__medium_prec_bin w;
+  w.mantissa = mantissa;
+  w.exp2 = exp2;
+  wuffs_base__private_implementation__medium_prec_bin__normalize(&w);
+
+  // Pick the cached power of 10, 1e(k) ≈ p_mantissa * (2 ** p_exp2), such
+  // that multiplying w by it gives an exp2 in the range [-60 ..= -32]. The
+  // multiplication adds 64 to the exponent sum, so we want p_exp2 in the
+  // range [min_p_exp2 ..= (min_p_exp2 + 28)]. The cached powers step by about
+  // 26.6 (8 * log2(10)), so there is at least one.
+  //
+  // Since p_mantissa's high bit is set, 1e(k) is roughly 2 ** (p_exp2 + 63).
+  // 78913 / (1 << 18) is approximately log10(2).
+  int32_t min_p_exp2 = -124 - w.exp2;
+  int32_t k = ((min_p_exp2 + 63) * 78913) >> 18;
+  int32_t i = (k + 348 + 7) / 8;
+  if (i < 0) {
+    i = 0;
+  } else if (i > 86) {
+    i = 86;
+  }
+  const uint32_t* p = &wuffs_base__private_implementation__big_powers_of_10[0];
+  while ((i > 0) && (((int32_t)(p[(3 * i) - 1])) >= min_p_exp2)) {
+    i--;
+  }
+  while ((i < 86) && (((int32_t)(p[(3 * i) + 2])) < min_p_exp2)) {
+    i++;
+  }
+  int32_t p_exp2 = (int32_t)(p[(3 * i) + 2]);
+  if ((p_exp2 < min_p_exp2) || ((min_p_exp2 + 28) < p_exp2)) {
+    return false;
+  }
+  int32_t p_exp10 = -348 + (8 * i);
+
+  // Scale. The MPB multiplication's preconditions say that its argument is
+  // normalized, but m_minus (merely aligned to m_plus) does not need the
+  // extra precision: the error bound below is still at most 1 unit.
+  p = &wuffs_base__private_implementation__big_powers_of_10[3 * i];
+  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&w, p);
+  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&m_plus, p);
+  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&m_minus, p);
+
+  // The scaled values are approximations, each within 1 unit of the exact
+  // value. too_low and too_high are guaranteed to lie outside of the interval
+  // we want. unsafe_interval is the interval between them, and the exact
+  // boundaries are somewhere near its ends.
+  uint64_t unit = 1;
+  uint64_t too_low = m_minus.mantissa - unit;
+  uint64_t too_high = m_plus.mantissa + unit;
+  uint64_t unsafe_interval = too_high - too_low;
+
+  // Split too_high into integral and fractional parts, where "one" is
+  // (1 << shift). shift is in the range [32 ..= 60], so that integrals fits in
+  // a uint32_t and multiplying fractionals by 10 cannot overflow.
+  uint32_t shift = (uint32_t)(-w.exp2);
+  uint64_t one = ((uint64_t)1) << shift;
+  uint32_t integrals = (uint32_t)(too_high >> shift);
+  uint64_t fractionals = too_high & (one - 1);
+
+  // Find divisor, the largest power of 10 that is <= integrals, and kappa,
+  // one more than that power's exponent.
+  static const uint32_t powers[10] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+  };
+  int32_t kappa = 0;
+  while ((kappa < 10) && (integrals >= powers[kappa])) {
+    kappa++;
+  }
+  uint32_t divisor = (kappa > 0) ? powers[kappa - 1] : 0;
+
+  // Generate digits from the integral part, stopping as soon as the
+  // remainder is inside the unsafe interval.
+  uint32_t n = 0;
+  while (kappa > 0) {
+    uint32_t digit = integrals / divisor;
+    h->digits[n++] = (uint8_t)digit;
+    integrals -= digit * divisor;
+    kappa--;
+    uint64_t rest = (((uint64_t)integrals) << shift) + fractionals;
+    if (rest < unsafe_interval) {
+      if (!wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(
+              &h->digits[0], n, too_high - w.mantissa, unsafe_interval, rest,
+              ((uint64_t)divisor) << shift, unit)) {
+        return false;
+      }
+      goto done;
+    }
+    divisor /= 10;
+  }
+
+  // Generate digits from the fractional part. A double never needs more than
+  // 17 digits, so give up (instead of looping forever) if something went
+  // wrong.
+  while (n < 20) {
+    fractionals *= 10;
+    unit *= 10;
+    unsafe_interval *= 10;
+    h->digits[n++] = (uint8_t)(fractionals >> shift);
+    fractionals &= one - 1;
+    kappa--;
+    if (fractionals < unsafe_interval) {
+      if (!wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(
+              &h->digits[0], n, (too_high - w.mantissa) * unit, unsafe_interval,
+              fractionals, one, unit)) {
+        return false;
+      }
+      goto done;
+    }
+  }
+  return false;
+
+done:
+  h->num_digits = n;
+  h->decimal_point = ((int32_t)n) + kappa - p_exp10;
+  h->negative = false;
+  h->truncated = false;
+  wuffs_base__private_implementation__high_prec_dec__trim(h);
+  return true;
+}
+
+// --------
+
+static size_t  //
+wuffs_base__private_implementation__render_inf_nan(wuffs_base__slice_u8 dst,
+                                                   const char* s,
+                                                   size_t n,
+                                                   uint32_t options) {
+  if (n > dst.len) {
+    return 0;
+  }
+  memcpy(dst.ptr + ((options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                        ? (dst.len - n)
+                        : 0),
+         s, n);
+  return n;
+}
+
+static size_t  //
+wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint32_t precision,
+    uint32_t options) {
+  size_t n = (h->negative ||
+              (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN))
+                 ? 1
+                 : 0;
+  if (h->decimal_point <= 0) {
+    n += 1;
+  } else {
+    n += (size_t)(h->decimal_point);
+  }
+  if (precision > 0) {
+    n += precision + 1;  // +1 for the '.'.
+  }
+
+  // Don't modify dst if the formatted number won't fit.
+  if (n > dst.len) {
+    return 0;
+  }
+
+  // Align-left or align-right.
+  uint8_t* ptr = (options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                     ? &dst.ptr[dst.len - n]
+                     : &dst.ptr[0];
+
+  // Leading "±".
+  if (h->negative) {
+    *ptr++ = '-';
+  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+    *ptr++ = '+';
+  }
+
+  // Integral digits.
+  if (h->decimal_point <= 0) {
+    *ptr++ = '0';
+  } else {
+    uint32_t m =
+        wuffs_base__u32__min(h->num_digits, (uint32_t)(h->decimal_point));
+    uint32_t i = 0;
+    for (; i < m; i++) {
+      *ptr++ = (uint8_t)('0' | h->digits[i]);
+    }
+    for (; i < (uint32_t)(h->decimal_point); i++) {
+      *ptr++ = '0';
+    }
+  }
+
+  // Separator and then fractional digits.
+  if (precision > 0) {
+    *ptr++ =
+        (options & WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA)
+            ? ','
+            : '.';
+    uint32_t i = 0;
+    for (; i < precision; i++) {
+      int32_t j = h->decimal_point + ((int32_t)i);
+      *ptr++ = (uint8_t)('0' | (((0 <= j) && (j < ((int32_t)(h->num_digits))))
+                                    ? h->digits[j]
+                                    : 0));
+    }
+  }
+
+  return n;
+}
+
+static size_t  //
+wuffs_base__private_implementation__high_prec_dec__render_exponent_present(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint32_t precision,
+    uint32_t options) {
+  int32_t exp = 0;
+  if (h->num_digits > 0) {
+    exp = h->decimal_point - 1;
+  }
+  bool negative_exp = exp < 0;
+  if (negative_exp) {
+    exp = -exp;
+  }
+
+  size_t n = (h->negative ||
+              (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN))
+                 ? 4
+                 : 3;  // Minimum 3 bytes: first digit and then "e±".
+  if (precision > 0) {
+    n += precision + 1;  // +1 for the '.'.
+  }
+  n += (exp < 100) ? 2 : 3;
+
+  // Don't modify dst if the formatted number won't fit.
+  if (n > dst.len) {
+    return 0;
+  }
+
+  // Align-left or align-right.
+  uint8_t* ptr = (options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                     ? &dst.ptr[dst.len - n]
+                     : &dst.ptr[0];
+
+  // Leading "±".
+  if (h->negative) {
+    *ptr++ = '-';
+  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+    *ptr++ = '+';
+  }
+
+  // Integral digit.
+  if (h->num_digits > 0) {
+    *ptr++ = (uint8_t)('0' | h->digits[0]);
+  } else {
+    *ptr++ = '0';
+  }
+
+  // Separator and then fractional digits.
+  if (precision > 0) {
+    *ptr++ =
+        (options & WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA)
+            ? ','
+            : '.';
+    uint32_t i = 1;
+    uint32_t j = wuffs_base__u32__min(h->num_digits, precision + 1);
+    for (; i < j; i++) {
+      *ptr++ = (uint8_t)('0' | h->digits[i]);
+    }
+    for (; i <= precision; i++) {
+      *ptr++ = '0';
+    }
+  }
+
+  // Exponent: "e±" and then 2 or 3 digits.
+  *ptr++ = 'e';
+  *ptr++ = negative_exp ? '-' : '+';
+  if (exp >= 100) {
+    *ptr++ = (uint8_t)('0' + (exp / 100));
+    exp %= 100;
+  }
+  ptr[0] = wuffs_base__render_number__two_digits[(2 * exp) + 0];
+  ptr[1] = wuffs_base__render_number__two_digits[(2 * exp) + 1];
+
+  return n;
+}
+
+size_t  //
+wuffs_base__render_number_f64(wuffs_base__slice_u8 dst,
+                              double x,
+                              uint32_t precision,
+                              uint32_t options) {
+  // Decompose x (64 bits) into negativity (1 bit), base-2 exponent (11 bits
+  // with a -1023 bias) and mantissa (52 bits).
+  uint64_t bits = wuffs_base__ieee_754_bit_representation__from_f64(x);
+  bool neg = (bits >> 63) != 0;
+  int32_t exp2 = ((int32_t)(bits >> 52)) & 0x7FF;
+  uint64_t man = bits & 0x000FFFFFFFFFFFFFul;
+
+  // Apply the exponent bias and set the implicit top bit of the mantissa,
+  // unless x is subnormal. Also take care of Inf and NaN.
+  if (exp2 == 0x7FF) {
+    if (man != 0) {
+      return wuffs_base__private_implementation__render_inf_nan(dst, "NaN", 3,
+                                                                options);
+    } else if (neg) {
+      return wuffs_base__private_implementation__render_inf_nan(dst, "-Inf", 4,
+                                                                options);
+    } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+      return wuffs_base__private_implementation__render_inf_nan(dst, "+Inf", 4,
+                                                                options);
+    }
+    return wuffs_base__private_implementation__render_inf_nan(dst, "Inf", 3,
+                                                              options);
+  } else if (exp2 == 0) {
+    exp2 = -1074;
+  } else {
+    exp2 -= 1075;
+    man |= 0x0010000000000000ul;
+  }
+
+  // Convert from binary to decimal. x is now exactly (man * (2 ** exp2)).
+  wuffs_base__private_implementation__high_prec_dec h;
+  if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+    if (man == 0) {
+      wuffs_base__private_implementation__high_prec_dec__assign(&h, 0, 0,
+                                                                false);
+    } else if (!wuffs_base__private_implementation__render_number_f64_grisu3(
+                   &h, man, exp2)) {
+      wuffs_base__private_implementation__high_prec_dec__assign(&h, man, exp2,
+                                                                false);
+      wuffs_base__private_implementation__high_prec_dec__round_just_enough(
+          &h, exp2, man);
+    }
+  } else {
+    wuffs_base__private_implementation__high_prec_dec__assign(&h, man, exp2,
+                                                              false);
+    if (precision > 4095) {
+      precision = 4095;
+    }
+  }
+  h.negative = neg;
+
+  // Round and render, either explicitly with or without an exponent (like
+  // printf's "%e" or "%f"), or choosing whichever is appropriate ("%g").
+  int32_t nd = (int32_t)(h.num_digits);
+  switch (options & (WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT |
+                     WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT)) {
+    case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT:
+      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+        precision =
+            (nd > h.decimal_point) ? ((uint32_t)(nd - h.decimal_point)) : 0;
+      } else {
+        wuffs_base__private_implementation__high_prec_dec__round_nearest(
+            &h, h.decimal_point + ((int32_t)precision));
+      }
+      return wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(
+          dst, &h, precision, options);
+
+    case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT:
+      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+        precision = (nd > 0) ? ((uint32_t)(nd - 1)) : 0;
+      } else {
+        wuffs_base__private_implementation__high_prec_dec__round_nearest(
+            &h, 1 + ((int32_t)precision));
+      }
+      return wuffs_base__private_implementation__high_prec_dec__render_exponent_present(
+          dst, &h, precision, options);
+  }
+
+  // Like "%g", use the exponent notation only if the exponent is outside the
+  // range [e_min ..= e_max). For just enough precision, e_min and e_max are
+  // JavaScript's Number.prototype.toString thresholds.
+  int32_t e_min = -4;
+  int32_t e_max = 21;
+  if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+    e_min = -6;
+  } else {
+    if (precision == 0) {
+      precision = 1;
+    }
+    e_max = (int32_t)precision;
+    wuffs_base__private_implementation__high_prec_dec__round_nearest(
+        &h, (int32_t)precision);
+  }
+
+  // Rounding might have changed the number of digits or the exponent. Either
+  // way, like "%g", there are no trailing zeroes.
+  nd = (int32_t)(h.num_digits);
+  int32_t e = (nd > 0) ? (h.decimal_point - 1) : 0;
+  if ((e < e_min) || (e_max <= e)) {
+    precision = (nd > 0) ? ((uint32_t)(nd - 1)) : 0;
+    return wuffs_base__private_implementation__high_prec_dec__render_exponent_present(
+        dst, &h, precision, options);
+  }
+  precision = (nd > h.decimal_point) ? ((uint32_t)(nd - h.decimal_point)) : 0;
+  return wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(
+      dst, &h, precision, options);
+}
+
 // ---------------- Hexadecimal
 
 size_t  //
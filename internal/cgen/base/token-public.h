@@ -249,6 +249,34 @@ wuffs_base__make_slice_token(wuffs_base__token* ptr, size_t len) {
   return ret;
 }
 
+// wuffs_base__slice_token__source_positions fills a side table of absolute
+// source positions, for callers (such as indexers that later want to seek
+// straight to a JSON value) that would otherwise each keep their own running
+// sum of token lengths.
+//
+// A token stream's tokens are contiguous: each token starts where the previous
+// one ended. Given pos, the source position of tokens.ptr[0], it sets
+// dst.ptr[i] to the source position of tokens.ptr[i], for each i less than
+// both dst.len and tokens.len. It returns the source position just after the
+// last token processed.
+//
+// A typical pos is the wuffs_base__io_buffer__reader_io_position of the source
+// buffer before the first decode_tokens call. Passing each return value as the
+// next call's pos then keeps the positions correct across multiple
+// decode_tokens calls, even as the source and token buffers are compacted.
+static inline uint64_t  //
+wuffs_base__slice_token__source_positions(wuffs_base__slice_u64 dst,
+                                          wuffs_base__slice_token tokens,
+                                          uint64_t pos) {
+  size_t n = (dst.len < tokens.len) ? dst.len : tokens.len;
+  size_t i;
+  for (i = 0; i < n; i++) {
+    dst.ptr[i] = pos;
+    pos += wuffs_base__token__length(&tokens.ptr[i]);
+  }
+  return pos;
+}
+
 // --------
 
 // wuffs_base__token_buffer_meta is the metadata for a
@@ -96,6 +96,10 @@ func (g *gen) writeBuiltinCall(b *buffer, n *a.Expr, depth uint32) error {
 			return g.writeBuiltinIOWriter(b, recv, method.Ident(), n.Args(), depth)
 		case t.IDTokenWriter:
 			return g.writeBuiltinTokenWriter(b, recv, method.Ident(), n.Args(), depth)
+		case t.IDX86SSE42Utility:
+			return g.writeBuiltinX86SSE42Utility(b, method.Ident(), n.Args(), depth)
+		case t.IDX86M128I:
+			return g.writeBuiltinX86M128I(b, recv, method.Ident(), n.Args(), depth)
 		case t.IDUtility:
 			switch method.Ident() {
 			case t.IDEmptyIOReader, t.IDEmptyIOWriter:
@@ -241,10 +245,12 @@ func (g *gen) writeBuiltinIOWriter(b *buffer, recv *a.Expr, method t.ID, args []
 	}
 
 	switch method {
-	case t.IDCopyN32FromHistory, t.IDCopyN32FromHistoryFast:
+	case t.IDCopyN32FromHistory, t.IDCopyN32FromHistoryFast, t.IDCopyN32FromHistory8ByteChunksFast:
 		suffix := ""
 		if method == t.IDCopyN32FromHistoryFast {
 			suffix = "_fast"
+		} else if method == t.IDCopyN32FromHistory8ByteChunksFast {
+			suffix = "_8_byte_chunks_fast"
 		}
 		b.printf("wuffs_base__io_writer__copy_n32_from_history%s(&%s%s, %s%s, %s%s",
 			suffix, iopPrefix, name, io0Prefix, name, io2Prefix, name)
@@ -591,6 +597,84 @@ func (g *gen) writeBuiltinTable(b *buffer, recv *a.Expr, method t.ID, args []*a.
 	return errNoSuchBuiltin
 }
 
+// x86SSE42UtilityMethods maps x86_sse42_utility method names to their C
+// intrinsic and argument order. The Wuffs arguments are little-endian (a00 is
+// the lowest lane) but the _mm_set_etc intrinsics take the highest lane first.
+var x86SSE42UtilityMethods = map[string]struct {
+	intrinsic string
+	cast      string
+	argOrder  []int
+}{
+	"make_m128i_multiple_u32": {"_mm_set_epi32", "int32_t", []int{3, 2, 1, 0}},
+	"make_m128i_multiple_u64": {"_mm_set_epi64x", "int64_t", []int{1, 0}},
+	"make_m128i_multiple_u8": {"_mm_set_epi8", "int8_t",
+		[]int{15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0}},
+	"make_m128i_repeat_u16": {"_mm_set1_epi16", "int16_t", []int{0}},
+	"make_m128i_repeat_u8":  {"_mm_set1_epi8", "int8_t", []int{0}},
+	"make_m128i_single_u32": {"_mm_cvtsi32_si128", "int32_t", []int{0}},
+	"make_m128i_zeroes":     {"_mm_setzero_si128", "", nil},
+}
+
+func (g *gen) writeBuiltinX86SSE42Utility(b *buffer, method t.ID, args []*a.Node, depth uint32) error {
+	if method == t.IDMakeM128ISlice128 {
+		b.writes("_mm_lddqu_si128((const __m128i*)(const void*)(")
+		if err := g.writeExpr(b, args[0].AsArg().Value(), depth); err != nil {
+			return err
+		}
+		b.writes(".ptr))")
+		return nil
+	}
+
+	m, ok := x86SSE42UtilityMethods[method.Str(g.tm)]
+	if !ok {
+		return errNoSuchBuiltin
+	}
+	b.printf("%s(", m.intrinsic)
+	for i, j := range m.argOrder {
+		if i > 0 {
+			b.writeb(',')
+		}
+		b.printf("(%s)(", m.cast)
+		if err := g.writeExpr(b, args[j].AsArg().Value(), depth); err != nil {
+			return err
+		}
+		b.writeb(')')
+	}
+	b.writeb(')')
+	return nil
+}
+
+func (g *gen) writeBuiltinX86M128I(b *buffer, recv *a.Expr, method t.ID, args []*a.Node, depth uint32) error {
+	// The Wuffs method name is the C intrinsic name and the receiver is the
+	// intrinsic's first argument. Intrinsics that return a C int are cast to
+	// the unsigned Wuffs return type.
+	methodStr := method.Str(g.tm)
+	cast := x86M128IUnsignedReturns[methodStr]
+	if cast != "" {
+		b.printf("((%s)(", cast)
+	}
+	b.printf("%s(", methodStr)
+	if err := g.writeExpr(b, recv, depth); err != nil {
+		return err
+	}
+	for _, o := range args {
+		b.writeb(',')
+		if err := g.writeExpr(b, o.AsArg().Value(), depth); err != nil {
+			return err
+		}
+	}
+	b.writeb(')')
+	if cast != "" {
+		b.writes("))")
+	}
+	return nil
+}
+
+var x86M128IUnsignedReturns = map[string]string{
+	"_mm_cvtsi128_si32": "uint32_t",
+	"_mm_extract_epi32": "uint32_t",
+}
+
 func (g *gen) writeArgs(b *buffer, args []*a.Node, depth uint32) error {
 	for i, o := range args {
 		if i > 0 {
@@ -42,9 +42,12 @@ var (
 	eight     = big.NewInt(8)
 	sixtyFour = big.NewInt(64)
 
+	maxInt64 = big.NewInt((1 << 63) - 1)
+
 	mibi = big.NewInt(1 << 20)
 
-	typeExprUtility = a.NewTypeExpr(0, t.IDBase, t.IDUtility, nil, nil, nil)
+	typeExprUtility         = a.NewTypeExpr(0, t.IDBase, t.IDUtility, nil, nil, nil)
+	typeExprX86SSE42Utility = a.NewTypeExpr(0, t.IDBase, t.IDX86SSE42Utility, nil, nil, nil)
 )
 
 // Prefixes are prepended to names to form a namespace and to avoid e.g.
@@ -976,6 +979,38 @@ func (g *gen) writeConstList(b *buffer, n *a.Expr) error {
 	return nil
 }
 
+// findFunc returns this package's func with the given QQID, or nil.
+func (g *gen) findFunc(qqid t.QQID) *a.Func {
+	for _, file := range g.files {
+		for _, tld := range file.TopLevelDecls() {
+			if tld.Kind() != a.KFunc {
+				continue
+			}
+			if o := tld.AsFunc(); o.QQID() == qqid {
+				return o
+			}
+		}
+	}
+	return nil
+}
+
+// forEachChoosyFunc calls f for each choosy method of the struct n.
+func (g *gen) forEachChoosyFunc(n *a.Struct, f func(*a.Func) error) error {
+	for _, file := range g.files {
+		for _, tld := range file.TopLevelDecls() {
+			if tld.Kind() != a.KFunc {
+				continue
+			}
+			if o := tld.AsFunc(); (o.Receiver() == n.QID()) && o.Choosy() {
+				if err := f(o); err != nil {
+					return err
+				}
+			}
+		}
+	}
+	return nil
+}
+
 func (g *gen) writeStructPrivateImpl(b *buffer, n *a.Struct) error {
 	// TODO: allow max depth > 1 for recursive coroutines.
 	const maxDepth = 1
@@ -1011,6 +1046,16 @@ func (g *gen) writeStructPrivateImpl(b *buffer, n *a.Struct) error {
 		b.writes(";\n")
 	}
 
+	if err := g.forEachChoosyFunc(n, func(o *a.Func) error {
+		if err := g.writeFuncSignature(b, o, wfsCChoosyFuncPtrField); err != nil {
+			return err
+		}
+		b.writes(";\n")
+		return nil
+	}); err != nil {
+		return err
+	}
+
 	if n.Classy() {
 		b.writeb('\n')
 		for _, file := range g.files {
@@ -1359,6 +1404,14 @@ func (g *gen) writeInitializerImpl(b *buffer, n *a.Struct) error {
 		b.printf("}\n")
 	}
 
+	if err := g.forEachChoosyFunc(n, func(o *a.Func) error {
+		b.printf("self->private_impl.choosy_%s = &%s__choosy_default;\n",
+			o.FuncName().Str(g.tm), g.funcCName(o))
+		return nil
+	}); err != nil {
+		return err
+	}
+
 	b.writes("self->private_impl.magic = WUFFS_BASE__MAGIC;\n")
 	for _, impl := range n.Implements() {
 		qid := impl.AsTypeExpr().QID()
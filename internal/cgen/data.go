@@ -28,41 +28,74 @@ const baseAllImplC = "" +
 
 const baseImageImplC = "" +
 	"// ---------------- Images\n\nconst uint32_t wuffs_base__pixel_format__bits_per_channel[16] = {\n    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,\n    0x08, 0x0A, 0x0C, 0x10, 0x18, 0x20, 0x30, 0x40,\n};\n\nstatic inline uint32_t  //\nwuffs_base__swap_u32_argb_abgr(uint32_t u) {\n  uint32_t o = u & 0xFF00FF00;\n  uint32_t r = u & 0x00FF0000;\n  uint32_t b = u & 0x000000FF;\n  return o | (r >> 16) | (b << 16);\n}\n\nstatic inline uint32_t  //\nwuffs_base__composite_premul_nonpremul_u32_axxx(uint32_t dst_premul,\n                                                uint32_t src_nonpremul) {\n  // Convert from 8-bit color to 16-bit color.\n  uint32_t sa = 0x101 * (0xFF & (src_nonpremul >> 24));\n  uint32_t sr = 0x101 * (0xFF & (src_nonpremul >> 16));\n  uint32_t sg = 0x101 * (0xFF & (src_nonpremul >> 8));\n  uint32_t sb = 0x101 * (0xFF & (src_nonpremul >> 0));\n  uint32_t da = 0x101 * (0xFF & (dst_premul >> 24));\n  uint32_t dr = 0x101 * (0xFF & (dst_premul >> 16));\n  uint32_t dg = 0x101 * (0xFF & (dst_premul >> 8));\n  uint32_t db = 0x101" +
-	" * (0xFF & (dst_premul >> 0));\n\n  // Calculate the inverse of the src-alpha: how much of the dst to keep.\n  uint32_t ia = 0xFFFF - sa;\n\n  // Composite src (nonpremul) over dst (premul).\n  da = sa + ((da * ia) / 0xFFFF);\n  dr = ((sr * sa) + (dr * ia)) / 0xFFFF;\n  dg = ((sg * sa) + (dg * ia)) / 0xFFFF;\n  db = ((sb * sa) + (db * ia)) / 0xFFFF;\n\n  // Convert from 16-bit color to 8-bit color and combine the components.\n  da >>= 8;\n  dr >>= 8;\n  dg >>= 8;\n  db >>= 8;\n  return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);\n}\n\nstatic inline uint32_t  //\nwuffs_base__premul_u32_axxx(uint32_t nonpremul) {\n  // Multiplying by 0x101 (twice, once for alpha and once for color) converts\n  // from 8-bit to 16-bit color. Shifting right by 8 undoes that.\n  //\n  // Working in the higher bit depth can produce slightly different (and\n  // arguably slightly more accurate) results. For example, given 8-bit blue\n  // and alpha of 0x80 and 0x81:\n  //\n  //  - ((0x80   * 0x81  ) / 0xFF  )      = 0x40        = 0x40\n  //  - ((0x8080 * 0" +
-	"x8181) / 0xFFFF) >> 8 = 0x4101 >> 8 = 0x41\n  uint32_t a = 0xFF & (nonpremul >> 24);\n  uint32_t a16 = a * (0x101 * 0x101);\n\n  uint32_t r = 0xFF & (nonpremul >> 16);\n  r = ((r * a16) / 0xFFFF) >> 8;\n  uint32_t g = 0xFF & (nonpremul >> 8);\n  g = ((g * a16) / 0xFFFF) >> 8;\n  uint32_t b = 0xFF & (nonpremul >> 0);\n  b = ((b * a16) / 0xFFFF) >> 8;\n\n  return (a << 24) | (r << 16) | (g << 8) | (b << 0);\n}\n\nstatic inline uint32_t  //\nwuffs_base__nonpremul_u32_axxx(uint32_t premul) {\n  uint32_t a = 0xFF & (premul >> 24);\n  if (a == 0xFF) {\n    return premul;\n  } else if (a == 0) {\n    return 0;\n  }\n  uint32_t a16 = a * 0x101;\n\n  uint32_t r = 0xFF & (premul >> 16);\n  r = ((r * (0x101 * 0xFFFF)) / a16) >> 8;\n  uint32_t g = 0xFF & (premul >> 8);\n  g = ((g * (0x101 * 0xFFFF)) / a16) >> 8;\n  uint32_t b = 0xFF & (premul >> 0);\n  b = ((b * (0x101 * 0xFFFF)) / a16) >> 8;\n\n  return (a << 24) | (r << 16) | (g << 8) | (b << 0);\n}\n\nwuffs_base__color_u32_argb_premul  //\nwuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_" +
-	"buffer* pb,\n                                       uint32_t x,\n                                       uint32_t y) {\n  if (!pb || (x >= pb->pixcfg.private_impl.width) ||\n      (y >= pb->pixcfg.private_impl.height)) {\n    return 0;\n  }\n\n  if (wuffs_base__pixel_format__is_planar(&pb->pixcfg.private_impl.pixfmt)) {\n    // TODO: support planar formats.\n    return 0;\n  }\n\n  size_t stride = pb->private_impl.planes[0].stride;\n  uint8_t* row = pb->private_impl.planes[0].ptr + (stride * ((size_t)y));\n\n  switch (pb->pixcfg.private_impl.pixfmt.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      return wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x)));\n\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY: {\n      uint8_t* palette = pb->private_impl.planes[3].ptr;\n      return wuffs_base__load_u32le__no_bounds_check(palette +\n    " +
-	"                                                 (4 * ((size_t)row[x])));\n    }\n\n      // Common formats above. Rarer formats below.\n\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      return 0xFF000000 | (0x00010101 * ((uint32_t)(row[x])));\n\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL: {\n      uint8_t* palette = pb->private_impl.planes[3].ptr;\n      return wuffs_base__premul_u32_axxx(\n          wuffs_base__load_u32le__no_bounds_check(palette +\n                                                  (4 * ((size_t)row[x]))));\n    }\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565: {\n      uint16_t bgr =\n          wuffs_base__load_u16le__no_bounds_check(row + (2 * ((size_t)x)));\n      uint32_t b5 = 0x1F & (bgr >> 0);\n      uint32_t b = (b5 << 3) | (b5 >> 2);\n      uint32_t g6 = 0x3F & (bgr >> 5);\n      uint32_t g = (g6 << 2) | (g6 >> 4);\n      uint32_t r5 = 0x1F & (bgr >> 11);\n      uint32_t r = (r5 << 3) | (r5 >> 2);\n      return 0xFF000000 | (r << 16) | (g << 8) | (b << 0);\n    }\n    case WUFFS_BASE__PIXEL_FORMA" +
-	"T__BGR:\n      return 0xFF000000 |\n             wuffs_base__load_u24le__no_bounds_check(row + (3 * ((size_t)x)));\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n      return 0xFF000000 |\n             wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x)));\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      return wuffs_base__premul_u32_axxx(\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x))));\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      return wuffs_base__swap_u32_argb_abgr(\n          0xFF000000 |\n          wuffs_base__load_u24le__no_bounds_check(row + (3 * ((size_t)x))));\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n      return wuffs_base__swap_u32_argb_abgr(\n          0xFF000000 |\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x))));\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n      return wuffs_base__swap_u32_argb_abgr(wuffs_base__premul_u32_axxx(\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x)))));\n    case WUFFS_BASE__" +
-	"PIXEL_FORMAT__RGBA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      return wuffs_base__swap_u32_argb_abgr(\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x))));\n\n    default:\n      // TODO: support more formats.\n      break;\n  }\n\n  return 0;\n}\n\nwuffs_base__status  //\nwuffs_base__pixel_buffer__set_color_u32_at(\n    wuffs_base__pixel_buffer* pb,\n    uint32_t x,\n    uint32_t y,\n    wuffs_base__color_u32_argb_premul color) {\n  if (!pb) {\n    return wuffs_base__make_status(wuffs_base__error__bad_receiver);\n  }\n  if ((x >= pb->pixcfg.private_impl.width) ||\n      (y >= pb->pixcfg.private_impl.height)) {\n    return wuffs_base__make_status(wuffs_base__error__bad_argument);\n  }\n\n  if (wuffs_base__pixel_format__is_planar(&pb->pixcfg.private_impl.pixfmt)) {\n    // TODO: support planar formats.\n    return wuffs_base__make_status(wuffs_base__error__unsupported_option);\n  }\n\n  size_t stride = pb->private_impl.planes[0].stride;\n  uint8_t* row = pb->private_im" +
-	"pl.planes[0].ptr + (stride * ((size_t)y));\n\n  switch (pb->pixcfg.private_impl.pixfmt.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n      wuffs_base__store_u32le__no_bounds_check(row + (4 * ((size_t)x)), color);\n      break;\n\n      // Common formats above. Rarer formats below.\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565: {\n      uint32_t b5 = 0x1F & (color >> (8 - 5));\n      uint32_t g6 = 0x3F & (color >> (16 - 6));\n      uint32_t r5 = 0x1F & (color >> (24 - 5));\n      uint32_t bgr565 = (b5 << 0) | (g6 << 5) | (r5 << 11);\n      wuffs_base__store_u16le__no_bounds_check(row + (2 * ((size_t)x)),\n                                               (uint16_t)bgr565);\n      break;\n    }\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      wuffs_base__store_u24le__no_bounds_check(row + (3 * ((size_t)x)), color);\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      wuffs_base__store_u32le__no_bounds_check(\n          row + (4 * ((siz" +
-	"e_t)x)), wuffs_base__nonpremul_u32_axxx(color));\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      wuffs_base__store_u24le__no_bounds_check(\n          row + (3 * ((size_t)x)), wuffs_base__swap_u32_argb_abgr(color));\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n      wuffs_base__store_u32le__no_bounds_check(\n          row + (4 * ((size_t)x)), wuffs_base__nonpremul_u32_axxx(\n                                       wuffs_base__swap_u32_argb_abgr(color)));\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n      wuffs_base__store_u32le__no_bounds_check(\n          row + (4 * ((size_t)x)), wuffs_base__swap_u32_argb_abgr(color));\n      break;\n\n    default:\n      // TODO: support more formats.\n      return wuffs_base__make_status(wuffs_base__error__unsupported_option);\n  }\n\n  return wuffs_base__make_status(NULL);\n}\n\n" +
+	" * (0xFF & (dst_premul >> 0));\n\n  // Calculate the inverse of the src-alpha: how much of the dst to keep.\n  uint32_t ia = 0xFFFF - sa;\n\n  // Composite src (nonpremul) over dst (premul).\n  da = sa + ((da * ia) / 0xFFFF);\n  dr = ((sr * sa) + (dr * ia)) / 0xFFFF;\n  dg = ((sg * sa) + (dg * ia)) / 0xFFFF;\n  db = ((sb * sa) + (db * ia)) / 0xFFFF;\n\n  // Convert from 16-bit color to 8-bit color and combine the components.\n  da >>= 8;\n  dr >>= 8;\n  dg >>= 8;\n  db >>= 8;\n  return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);\n}\n\nstatic inline uint32_t  //\nwuffs_base__composite_premul_premul_u32_axxx(uint32_t dst_premul,\n                                             uint32_t src_premul) {\n  // Convert from 8-bit color to 16-bit color.\n  uint32_t sa = 0x101 * (0xFF & (src_premul >> 24));\n  uint32_t sr = 0x101 * (0xFF & (src_premul >> 16));\n  uint32_t sg = 0x101 * (0xFF & (src_premul >> 8));\n  uint32_t sb = 0x101 * (0xFF & (src_premul >> 0));\n  uint32_t da = 0x101 * (0xFF & (dst_premul >> 24));\n  uint32_t dr = 0x101 * (0" +
+	"xFF & (dst_premul >> 16));\n  uint32_t dg = 0x101 * (0xFF & (dst_premul >> 8));\n  uint32_t db = 0x101 * (0xFF & (dst_premul >> 0));\n\n  // Calculate the inverse of the src-alpha: how much of the dst to keep.\n  uint32_t ia = 0xFFFF - sa;\n\n  // Composite src (premul) over dst (premul).\n  da = sa + ((da * ia) / 0xFFFF);\n  dr = sr + ((dr * ia) / 0xFFFF);\n  dg = sg + ((dg * ia) / 0xFFFF);\n  db = sb + ((db * ia) / 0xFFFF);\n\n  // Valid premul colors are no greater than their alpha, so these sums are\n  // at most 0xFFFF, but clamp them in case the src or dst is invalid.\n  dr = (dr < 0xFFFF) ? dr : 0xFFFF;\n  dg = (dg < 0xFFFF) ? dg : 0xFFFF;\n  db = (db < 0xFFFF) ? db : 0xFFFF;\n\n  // Convert from 16-bit color to 8-bit color and combine the components.\n  da >>= 8;\n  dr >>= 8;\n  dg >>= 8;\n  db >>= 8;\n  return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);\n}\n\nstatic inline uint32_t  //\nwuffs_base__premul_u32_axxx(uint32_t nonpremul) {\n  // Multiplying by 0x101 (twice, once for alpha and once for color) converts\n  // from " +
+	"8-bit to 16-bit color. Shifting right by 8 undoes that.\n  //\n  // Working in the higher bit depth can produce slightly different (and\n  // arguably slightly more accurate) results. For example, given 8-bit blue\n  // and alpha of 0x80 and 0x81:\n  //\n  //  - ((0x80   * 0x81  ) / 0xFF  )      = 0x40        = 0x40\n  //  - ((0x8080 * 0x8181) / 0xFFFF) >> 8 = 0x4101 >> 8 = 0x41\n  uint32_t a = 0xFF & (nonpremul >> 24);\n  uint32_t a16 = a * (0x101 * 0x101);\n\n  uint32_t r = 0xFF & (nonpremul >> 16);\n  r = ((r * a16) / 0xFFFF) >> 8;\n  uint32_t g = 0xFF & (nonpremul >> 8);\n  g = ((g * a16) / 0xFFFF) >> 8;\n  uint32_t b = 0xFF & (nonpremul >> 0);\n  b = ((b * a16) / 0xFFFF) >> 8;\n\n  return (a << 24) | (r << 16) | (g << 8) | (b << 0);\n}\n\nstatic inline uint32_t  //\nwuffs_base__nonpremul_u32_axxx(uint32_t premul) {\n  uint32_t a = 0xFF & (premul >> 24);\n  if (a == 0xFF) {\n    return premul;\n  } else if (a == 0) {\n    return 0;\n  }\n  uint32_t a16 = a * 0x101;\n\n  uint32_t r = 0xFF & (premul >> 16);\n  r = ((r * (0x101 * 0xFFFF)) " +
+	"/ a16) >> 8;\n  uint32_t g = 0xFF & (premul >> 8);\n  g = ((g * (0x101 * 0xFFFF)) / a16) >> 8;\n  uint32_t b = 0xFF & (premul >> 0);\n  b = ((b * (0x101 * 0xFFFF)) / a16) >> 8;\n\n  return (a << 24) | (r << 16) | (g << 8) | (b << 0);\n}\n\n// wuffs_base__pixel_swizzler__convert_transparency converts the 0xAARRGGBB\n// color c from the src transparency to the dst transparency, where those are\n// the \"(repr >> 24) & 7\" bits of a wuffs_base__pixel_format. Binary alpha is\n// treated as premultiplied alpha. Opaque and X-padded dsts keep the color as\n// is, as the alpha will be dropped.\nstatic inline uint32_t  //\nwuffs_base__pixel_swizzler__convert_transparency(uint32_t c,\n                                                 uint32_t dst_transparency,\n                                                 uint32_t src_transparency) {\n  if (src_transparency == 5) {\n    if (dst_transparency >= 6) {\n      return wuffs_base__premul_u32_axxx(c);\n    }\n  } else if (src_transparency >= 6) {\n    if (dst_transparency == 5) {\n      return wuffs" +
+	"_base__nonpremul_u32_axxx(c);\n    }\n  }\n  return c;\n}\n\nwuffs_base__color_u32_argb_premul  //\nwuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_buffer* pb,\n                                       uint32_t x,\n                                       uint32_t y) {\n  if (!pb || (x >= pb->pixcfg.private_impl.width) ||\n      (y >= pb->pixcfg.private_impl.height)) {\n    return 0;\n  }\n\n  if (wuffs_base__pixel_format__is_planar(&pb->pixcfg.private_impl.pixfmt)) {\n    // TODO: support planar formats.\n    return 0;\n  }\n\n  size_t stride = pb->private_impl.planes[0].stride;\n  uint8_t* row = pb->private_impl.planes[0].ptr + (stride * ((size_t)y));\n\n  switch (pb->pixcfg.private_impl.pixfmt.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      return wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x)));\n\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_" +
+	"FORMAT__INDEXED__BGRA_BINARY: {\n      uint8_t* palette = pb->private_impl.planes[3].ptr;\n      return wuffs_base__load_u32le__no_bounds_check(palette +\n                                                     (4 * ((size_t)row[x])));\n    }\n\n      // Common formats above. Rarer formats below.\n\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      return 0xFF000000 | (0x00010101 * ((uint32_t)(row[x])));\n\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL: {\n      uint8_t* palette = pb->private_impl.planes[3].ptr;\n      return wuffs_base__premul_u32_axxx(\n          wuffs_base__load_u32le__no_bounds_check(palette +\n                                                  (4 * ((size_t)row[x]))));\n    }\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      return wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(\n          wuffs_base__load_u16le__no_bounds_check(row + (2 * ((size_t)x))));\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      return 0xFF000000 |\n             wuffs_base__load_u24le__no_bounds_check(row + (3 * ((size" +
+	"_t)x)));\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n      return 0xFF000000 |\n             wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x)));\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      return wuffs_base__premul_u32_axxx(\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x))));\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      return wuffs_base__swap_u32_argb_abgr(\n          0xFF000000 |\n          wuffs_base__load_u24le__no_bounds_check(row + (3 * ((size_t)x))));\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n      return wuffs_base__swap_u32_argb_abgr(\n          0xFF000000 |\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x))));\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n      return wuffs_base__swap_u32_argb_abgr(wuffs_base__premul_u32_axxx(\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x)))));\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY" +
+	":\n      return wuffs_base__swap_u32_argb_abgr(\n          wuffs_base__load_u32le__no_bounds_check(row + (4 * ((size_t)x))));\n\n    default:\n      // TODO: support more formats.\n      break;\n  }\n\n  return 0;\n}\n\nwuffs_base__status  //\nwuffs_base__pixel_buffer__set_color_u32_at(\n    wuffs_base__pixel_buffer* pb,\n    uint32_t x,\n    uint32_t y,\n    wuffs_base__color_u32_argb_premul color) {\n  if (!pb) {\n    return wuffs_base__make_status(wuffs_base__error__bad_receiver);\n  }\n  if ((x >= pb->pixcfg.private_impl.width) ||\n      (y >= pb->pixcfg.private_impl.height)) {\n    return wuffs_base__make_status(wuffs_base__error__bad_argument);\n  }\n\n  if (wuffs_base__pixel_format__is_planar(&pb->pixcfg.private_impl.pixfmt)) {\n    // TODO: support planar formats.\n    return wuffs_base__make_status(wuffs_base__error__unsupported_option);\n  }\n\n  size_t stride = pb->private_impl.planes[0].stride;\n  uint8_t* row = pb->private_impl.planes[0].ptr + (stride * ((size_t)y));\n\n  switch (pb->pixcfg.private_impl.pixfmt.repr) {\n    case WU" +
+	"FFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n      wuffs_base__store_u32le__no_bounds_check(row + (4 * ((size_t)x)), color);\n      break;\n\n      // Common formats above. Rarer formats below.\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      wuffs_base__store_u16le__no_bounds_check(\n          row + (2 * ((size_t)x)),\n          wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(color));\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      wuffs_base__store_u24le__no_bounds_check(row + (3 * ((size_t)x)), color);\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      wuffs_base__store_u32le__no_bounds_check(\n          row + (4 * ((size_t)x)), wuffs_base__nonpremul_u32_axxx(color));\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      wuffs_base__store_u24le__no_bounds_check(\n          row + (3 * ((size_t)x)), wuffs_base__swap_u32_argb_abgr(color));\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    " +
+	"  wuffs_base__store_u32le__no_bounds_check(\n          row + (4 * ((size_t)x)), wuffs_base__nonpremul_u32_axxx(\n                                       wuffs_base__swap_u32_argb_abgr(color)));\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n      WUFFS_BASE__FALLTHROUGH;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n      wuffs_base__store_u32le__no_bounds_check(\n          row + (4 * ((size_t)x)), wuffs_base__swap_u32_argb_abgr(color));\n      break;\n\n    default:\n      // TODO: support more formats.\n      return wuffs_base__make_status(wuffs_base__error__unsupported_option);\n  }\n\n  return wuffs_base__make_status(NULL);\n}\n\n" +
 	"" +
 	"// --------\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  // TODO: unroll.\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__premul_u32_axxx(\n        wuffs_base__load_u32le__no_bounds_check(s + (0 * 4)));\n    wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);\n\n    s += 1 * 4;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n" +
-	"  size_t n = len;\n\n  // TODO: unroll.\n\n  while (n >= 1) {\n    uint32_t d0 = wuffs_base__load_u32le__no_bounds_check(d + (0 * 4));\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(s + (0 * 4));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));\n\n    s += 1 * 4;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__copy_1_1(wuffs_base__slice_u8 dst,\n                                     wuffs_base__slice_u8 dst_palette,\n                                     wuffs_base__slice_u8 src) {\n  return wuffs_base__slice_u8__copy_from_slice(dst, src);\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__copy_4_4(wuffs_base__slice_u8 dst,\n                                     wuffs_base__slice_u8 dst_palette,\n                                     wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  if (l" +
-	"en > 0) {\n    memmove(dst.ptr, src.ptr, len * 4);\n  }\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xx__index__src(wuffs_base__slice_u8 dst,\n                                           wuffs_base__slice_u8 dst_palette,\n                                           wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len2 = dst.len / 2;\n  size_t len = dst_len2 < src.len ? dst_len2 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  while (n >= loop_unroll_count) {\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (1 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[1] * 4)));\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (2 * 2), wuffs_base__load_u16le" +
-	"__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[2] * 4)));\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (3 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[3] * 4)));\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 2;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n\n    s += 1 * 1;\n    d += 1 * 2;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxx__index__src(wuffs_base__slice_u8 dst,\n                                            wuffs_base__slice_u8 dst_palette,\n                                            wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len3 = dst.len / 3;\n  size_t len = dst_len3 < src.len ? dst_len3 : src.len;\n  uint8_t* d = dst.ptr;\n  uint" +
-	"8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  // The comparison in the while condition is \">\", not \">=\", because with \">=\",\n  // the last 4-byte store could write past the end of the dst slice.\n  //\n  // Each 4-byte store writes one too many bytes, but a subsequent store will\n  // overwrite that with the correct byte. There is always another store,\n  // whether a 4-byte store in this loop or a 1-byte store in the next loop.\n  while (n > loop_unroll_count) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (1 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[1] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (2 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[2] * 4)));\n    wuffs_b" +
-	"ase__store_u32le__no_bounds_check(\n        d + (3 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[3] * 4)));\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 3;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    d[0] = (uint8_t)(s0 >> 0);\n    d[1] = (uint8_t)(s0 >> 8);\n    d[2] = (uint8_t)(s0 >> 16);\n\n    s += 1 * 1;\n    d += 1 * 3;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len3 = dst.len / 3;\n  size_t len = dst_len3 < src.len ? dst_len3 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n" +
-	"  while (n >= loop_unroll_count) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u24le__no_bounds_check(d + (0 * 4), s0);\n    }\n    uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[1] * 4));\n    if (s1) {\n      wuffs_base__store_u24le__no_bounds_check(d + (1 * 4), s1);\n    }\n    uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[2] * 4));\n    if (s2) {\n      wuffs_base__store_u24le__no_bounds_check(d + (2 * 4), s2);\n    }\n    uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[3] * 4));\n    if (s3) {\n      wuffs_base__store_u24le__no_bounds_check(d + (3 * 4), s3);\n    }\n\n    s += loop_unroll_count *" +
-	" 1;\n    d += loop_unroll_count * 3;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u24le__no_bounds_check(d + (0 * 4), s0);\n    }\n\n    s += 1 * 1;\n    d += 1 * 3;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__index__src(wuffs_base__slice_u8 dst,\n                                             wuffs_base__slice_u8 dst_palette,\n                                             wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len4 = dst.len / 4;\n  size_t len = dst_len4 < src.len ? dst_len4 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  while (n >= loop_unroll_count) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__load_u32le__no_bounds_chec" +
-	"k(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (1 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[1] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (2 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[2] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (3 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[3] * 4)));\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 4;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n\n    s += 1 * 1;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_ov" +
-	"er(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len4 = dst.len / 4;\n  size_t len = dst_len4 < src.len ? dst_len4 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  while (n >= loop_unroll_count) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);\n    }\n    uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[1] * 4));\n    if (s1) {\n      wuffs_base__store_u32le__no_bounds_check(d + (1 * 4), s1);\n    }\n    uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[2] * 4));\n    " +
-	"if (s2) {\n      wuffs_base__store_u32le__no_bounds_check(d + (2 * 4), s2);\n    }\n    uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[3] * 4));\n    if (s3) {\n      wuffs_base__store_u32le__no_bounds_check(d + (3 * 4), s3);\n    }\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 4;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);\n    }\n\n    s += 1 * 1;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__xxx(wuffs_base__slice_u8 dst,\n                                      wuffs_base__slice_u8 dst_palette,\n                                      wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len3 = src." +
-	"len / 3;\n  size_t len = dst_len4 < src_len3 ? dst_len4 : src_len3;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  // TODO: unroll.\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4),\n        0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s + (0 * 3)));\n\n    s += 1 * 3;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__y(wuffs_base__slice_u8 dst,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t len = dst_len4 < src.len ? dst_len4 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  // TODO: unroll.\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), 0xFF000000 | (0x010101 * (uint32_t)s[0]));\n\n    s += 1 * 1;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\n" +
-	"" +
-	"// --------\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__squash_bgr_565_888(wuffs_base__slice_u8 dst,\n                                               wuffs_base__slice_u8 src) {\n  size_t len4 = (dst.len < src.len ? dst.len : src.len) / 4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n\n  size_t n = len4;\n  while (n--) {\n    uint32_t argb = wuffs_base__load_u32le__no_bounds_check(s);\n    uint32_t b5 = 0x1F & (argb >> (8 - 5));\n    uint32_t g6 = 0x3F & (argb >> (16 - 6));\n    uint32_t r5 = 0x1F & (argb >> (24 - 5));\n    wuffs_base__store_u32le__no_bounds_check(\n        d, (b5 << 0) | (g6 << 5) | (r5 << 11));\n    s += 4;\n    d += 4;\n  }\n  return len4 * 4;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__swap_rgbx_bgrx(wuffs_base__slice_u8 dst,\n                                           wuffs_base__slice_u8 src) {\n  size_t len4 = (dst.len < src.len ? dst.len : src.len) / 4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n\n  size_t n = len4;\n  while (n--) {\n    uint8_t b0 = s[0];\n    uint8_t b1 = s[1];\n    u" +
-	"int8_t b2 = s[2];\n    uint8_t b3 = s[3];\n    d[0] = b2;\n    d[1] = b1;\n    d[2] = b0;\n    d[3] = b3;\n    s += 4;\n    d += 4;\n  }\n  return len4 * 4;\n}\n\n" +
-	"" +
-	"// --------\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,\n                                       wuffs_base__pixel_format dst_format,\n                                       wuffs_base__slice_u8 dst_palette,\n                                       wuffs_base__slice_u8 src_palette,\n                                       wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      return wuf" +
-	"fs_base__pixel_swizzler__xxxx__y;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(\n    wuffs_base__pixel_swizzler* p,\n    wuffs_base__pixel_format dst_format,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src_palette,\n    wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=\n          1024) {\n        return NULL;\n      }\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__copy_1_1;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      if (wuffs_base__pixel_swizzler__squash_bgr_565_888(dst_palette,\n                                                         src_palette) != 1024) {\n     " +
-	"   return NULL;\n      }\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__xx__index__src;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=\n          1024) {\n        return NULL;\n      }\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__xxx__index__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=\n          1024) {\n        return NULL;\n      }\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__xxxx__index__sr" +
-	"c;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(dst_palette,\n                                                     src_palette) != 1024) {\n        return NULL;\n      }\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__xxx__index__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(dst_palette,\n                                                     src_palette) != 1024) {\n        return NULL;\n      }\n      switch (blend) {\n        case WUFFS_BASE__P" +
-	"IXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__xxxx__index__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;\n      }\n      return NULL;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,\n                                         wuffs_base__pixel_format dst_format,\n                                         wuffs_base__slice_u8 dst_palette,\n                                         wuffs_base__slice_u8 src_palette,\n                                         wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMU" +
-	"L:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      return wuffs_base__pixel_swizzler__xxxx__xxx;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      // TODO.\n      break;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__bgra_nonpremul(\n    wuffs_base__pixel_swizzler* p,\n    wuffs_base__pixel_format dst_format,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src_palette,\n    wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base" +
-	"__pixel_swizzler__copy_4_4;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      // TODO.\n      break;\n  }\n  return NULL;\n}\n\n" +
-	"" +
-	"// --------\n\nwuffs_base__status  //\nwuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,\n                                    wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend) {\n  if (!p) {\n    return wuffs_base__make_status(wuffs_base__error__bad_receiver);\n  }\n\n  // TODO: support many more formats.\n\n  wuffs_base__pixel_swizzler__func func = NULL;\n\n  switch (src_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      func = wuffs_base__pixel_swizzler__prepare__y(p, dst_format, dst_palette,\n                                                    src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n      func = wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(\n          p, dst_format, dst_" +
-	"palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      func = wuffs_base__pixel_swizzler__prepare__bgr(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n  }\n\n  p->private_impl.func = func;\n  return wuffs_base__make_status(\n      func ? NULL : wuffs_base__error__unsupported_pixel_swizzler_option);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (p && p->private_impl.func) {\n    return (*p->private_impl.func)(dst, dst_palette, src);\n  }\n  return 0;\n}\n" +
+	"  size_t n = len;\n\n  // TODO: unroll.\n\n  while (n >= 1) {\n    uint32_t d0 = wuffs_base__load_u32le__no_bounds_check(d + (0 * 4));\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(s + (0 * 4));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));\n\n    s += 1 * 4;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\n// wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42 maps each 16-bit\n// lane y, the sum of products of 8-bit values with y <= (0xFF * 0xFF), to the\n// 8-bit value that the scalar code's 16-bit color math produces. Widening the\n// 8-bit inputs (multiplying by 0x101), dividing by 0xFFFF and then shifting\n// right by 8 works out to exactly ((y * 0x101) / 0xFF00), which is also\n// exactly (y + ((y * 0x0202) >> 16)) >> 8 for all such y. The sum fits in 16\n// bits.\nWUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2\")\nstatic inline __m128i  //\nwuffs_base__pixel_swizzler__u16" +
+	"x8_scale_down__x86_sse42(__m128i y) {\n  __m128i q = _mm_mulhi_epu16(y, _mm_set1_epi16(0x0202));\n  return _mm_srli_epi16(_mm_add_epi16(y, q), 8);\n}\n\nWUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2\")\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_sse42(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  // Each color channel is multiplied by its pixel's alpha. The alpha channel\n  // is multiplied by 0xFF, which the scale down maps back to itself.\n  const __m128i z = _mm_setzero_si128();\n  const __m128i alpha_lanes = _mm_setr_epi16(0, 0, 0, 0xFF, 0, 0, 0, 0xFF);\n  const __m128i shuffle_lo =\n      _mm_setr_epi8(3, -128, 3, -128, 3, -128, -128, -128, 7, -128, 7, -128, 7,\n                    -128, -128, -128);\n  const __m128i shuf" +
+	"fle_hi =\n      _mm_setr_epi8(11, -128, 11, -128, 11, -128, -128, -128, 15, -128, 15,\n                    -128, 15, -128, -128, -128);\n\n  while (n >= 4) {\n    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);\n    __m128i a_lo = _mm_or_si128(_mm_shuffle_epi8(x, shuffle_lo), alpha_lanes);\n    __m128i a_hi = _mm_or_si128(_mm_shuffle_epi8(x, shuffle_hi), alpha_lanes);\n    __m128i y_lo = _mm_mullo_epi16(_mm_unpacklo_epi8(x, z), a_lo);\n    __m128i y_hi = _mm_mullo_epi16(_mm_unpackhi_epi8(x, z), a_hi);\n    _mm_storeu_si128(\n        (__m128i*)(void*)d,\n        _mm_packus_epi16(\n            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_lo),\n            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_hi)));\n\n    s += 4 * 4;\n    d += 4 * 4;\n    n -= 4;\n  }\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__premul_u32_axxx(\n        wuffs_base__load_u32le__no_bounds_check(s + (0 * 4)));\n    wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);\n\n    s += 1 * 4;\n    d += 1 * 4;\n    n -= 1" +
+	";\n  }\n\n  return len;\n}\n\nWUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2\")\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_sse42(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  // Each dst channel becomes (s * sa) + (d * (0xFF - sa)), scaled down, where\n  // the src alpha channel's s is replaced by 0xFF. This matches the scalar\n  // wuffs_base__composite_premul_nonpremul_u32_axxx.\n  const __m128i z = _mm_setzero_si128();\n  const __m128i ff = _mm_set1_epi16(0xFF);\n  const __m128i alpha_bytes = _mm_set1_epi32((int32_t)0xFF000000);\n  const __m128i shuffle_lo = _mm_setr_epi8(3, -128, 3, -128, 3, -128, 3, -128,\n                                           7, -128, 7, -128, 7, -128, 7, -128);\n  const __m128i shuffle_hi =\n    " +
+	"  _mm_setr_epi8(11, -128, 11, -128, 11, -128, 11, -128, 15, -128, 15, -128,\n                    15, -128, 15, -128);\n\n  while (n >= 4) {\n    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);\n    __m128i w = _mm_lddqu_si128((const __m128i*)(const void*)d);\n    __m128i sa_lo = _mm_shuffle_epi8(x, shuffle_lo);\n    __m128i sa_hi = _mm_shuffle_epi8(x, shuffle_hi);\n    x = _mm_or_si128(x, alpha_bytes);\n    __m128i y_lo = _mm_add_epi16(\n        _mm_mullo_epi16(_mm_unpacklo_epi8(x, z), sa_lo),\n        _mm_mullo_epi16(_mm_unpacklo_epi8(w, z), _mm_sub_epi16(ff, sa_lo)));\n    __m128i y_hi = _mm_add_epi16(\n        _mm_mullo_epi16(_mm_unpackhi_epi8(x, z), sa_hi),\n        _mm_mullo_epi16(_mm_unpackhi_epi8(w, z), _mm_sub_epi16(ff, sa_hi)));\n    _mm_storeu_si128(\n        (__m128i*)(void*)d,\n        _mm_packus_epi16(\n            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_lo),\n            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_hi)));\n\n    s += 4 * 4;\n    d += 4 * 4;\n    n -= 4;\n  }\n" +
+	"\n  while (n >= 1) {\n    uint32_t d0 = wuffs_base__load_u32le__no_bounds_check(d + (0 * 4));\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(s + (0 * 4));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));\n\n    s += 1 * 4;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__copy_1_1(wuffs_base__slice_u8 dst,\n                                     wuffs_base__slice_u8 dst_palette,\n                                     wuffs_base__slice_u8 src) {\n  return wuffs_base__slice_u8__copy_from_slice(dst, src);\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__copy_2_2(wuffs_base__slice_u8 dst,\n                                     wuffs_base__slice_u8 dst_palette,\n                                     wuffs_base__slice_u8 src) {\n  size_t dst_len2 = dst.len / 2;\n  size_t src_len2 = src.len / 2;\n  size_t len = dst_len2 < src_len2 ? dst_len2 : src_l" +
+	"en2;\n  if (len > 0) {\n    memmove(dst.ptr, src.ptr, len * 2);\n  }\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__copy_3_3(wuffs_base__slice_u8 dst,\n                                     wuffs_base__slice_u8 dst_palette,\n                                     wuffs_base__slice_u8 src) {\n  size_t dst_len3 = dst.len / 3;\n  size_t src_len3 = src.len / 3;\n  size_t len = dst_len3 < src_len3 ? dst_len3 : src_len3;\n  if (len > 0) {\n    memmove(dst.ptr, src.ptr, len * 3);\n  }\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__copy_4_4(wuffs_base__slice_u8 dst,\n                                     wuffs_base__slice_u8 dst_palette,\n                                     wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  if (len > 0) {\n    memmove(dst.ptr, src.ptr, len * 4);\n  }\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__swap_rgb_bgr(wuffs_base__slice_u8 dst,\n            " +
+	"                             wuffs_base__slice_u8 dst_palette,\n                                         wuffs_base__slice_u8 src) {\n  size_t dst_len3 = dst.len / 3;\n  size_t src_len3 = src.len / 3;\n  size_t len = dst_len3 < src_len3 ? dst_len3 : src_len3;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  while (n >= 1) {\n    uint8_t b0 = s[0];\n    uint8_t b1 = s[1];\n    uint8_t b2 = s[2];\n    d[0] = b2;\n    d[1] = b1;\n    d[2] = b0;\n\n    s += 1 * 3;\n    d += 1 * 3;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__swap_rgbx_bgrx(wuffs_base__slice_u8 dst,\n                                           wuffs_base__slice_u8 dst_palette,\n                                           wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  while (n >= 1) {\n    uint8_t b0 = s[0];\n    uint8_t b1 = s[1];\n    uint" +
+	"8_t b2 = s[2];\n    uint8_t b3 = s[3];\n    d[0] = b2;\n    d[1] = b1;\n    d[2] = b0;\n    d[3] = b3;\n\n    s += 1 * 4;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\nWUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2\")\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len4 = src.len / 4;\n  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const __m128i shuffle =\n      _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);\n\n  while (n >= 4) {\n    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);\n    _mm_storeu_si128((__m128i*)(void*)d, _mm_shuffle_epi8(x, shuffle));\n\n    s += 4 * 4;\n    d += 4 * 4;\n    n -= 4;\n  }\n\n  while (n >= 1) {\n    uint8_t b0 = s[0];\n    uint8_t b1 = s[1];\n    uint8_t b2 = s[" +
+	"2];\n    uint8_t b3 = s[3];\n    d[0] = b2;\n    d[1] = b1;\n    d[2] = b0;\n    d[3] = b3;\n\n    s += 1 * 4;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xx__index__src(wuffs_base__slice_u8 dst,\n                                           wuffs_base__slice_u8 dst_palette,\n                                           wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len2 = dst.len / 2;\n  size_t len = dst_len2 < src.len ? dst_len2 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  while (n >= loop_unroll_count) {\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (1 * 2), wuffs_base__load_u16le__no_bounds_check(\n                      " +
+	"   dst_palette.ptr + ((size_t)s[1] * 4)));\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (2 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[2] * 4)));\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (3 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[3] * 4)));\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 2;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    wuffs_base__store_u16le__no_bounds_check(\n        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n\n    s += 1 * 1;\n    d += 1 * 2;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxx__index__src(wuffs_base__slice_u8 dst,\n                                            wuffs_base__slice_u8 dst_palette,\n                                            wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    r" +
+	"eturn 0;\n  }\n  size_t dst_len3 = dst.len / 3;\n  size_t len = dst_len3 < src.len ? dst_len3 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  // The comparison in the while condition is \">\", not \">=\", because with \">=\",\n  // the last 4-byte store could write past the end of the dst slice.\n  //\n  // Each 4-byte store writes one too many bytes, but a subsequent store will\n  // overwrite that with the correct byte. There is always another store,\n  // whether a 4-byte store in this loop or a 1-byte store in the next loop.\n  while (n > loop_unroll_count) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (1 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[1] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n      " +
+	"  d + (2 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[2] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (3 * 3), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[3] * 4)));\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 3;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    d[0] = (uint8_t)(s0 >> 0);\n    d[1] = (uint8_t)(s0 >> 8);\n    d[2] = (uint8_t)(s0 >> 16);\n\n    s += 1 * 1;\n    d += 1 * 3;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len3 = dst.len / 3;\n  size_t len = dst_len3 < src." +
+	"len ? dst_len3 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  while (n >= loop_unroll_count) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u24le__no_bounds_check(d + (0 * 3), s0);\n    }\n    uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[1] * 4));\n    if (s1) {\n      wuffs_base__store_u24le__no_bounds_check(d + (1 * 3), s1);\n    }\n    uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[2] * 4));\n    if (s2) {\n      wuffs_base__store_u24le__no_bounds_check(d + (2 * 3), s2);\n    }\n    uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((s" +
+	"ize_t)s[3] * 4));\n    if (s3) {\n      wuffs_base__store_u24le__no_bounds_check(d + (3 * 3), s3);\n    }\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 3;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u24le__no_bounds_check(d + (0 * 3), s0);\n    }\n\n    s += 1 * 1;\n    d += 1 * 3;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxx__y(wuffs_base__slice_u8 dst,\n                                   wuffs_base__slice_u8 dst_palette,\n                                   wuffs_base__slice_u8 src) {\n  size_t dst_len3 = dst.len / 3;\n  size_t len = dst_len3 < src.len ? dst_len3 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  while (n >= 1) {\n    uint8_t s0 = s[0];\n    d[0] = s0;\n    d[1] = s0;\n    d[2] = s0;\n\n    s += 1 * 1;\n    d += 1 * 3;\n    n -=" +
+	" 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__index__src(wuffs_base__slice_u8 dst,\n                                             wuffs_base__slice_u8 dst_palette,\n                                             wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len4 = dst.len / 4;\n  size_t len = dst_len4 < src.len ? dst_len4 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  while (n >= loop_unroll_count) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (1 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[1] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (2 * 4), wuffs_base__load_u32le__no_bounds_check(\n                    " +
+	"     dst_palette.ptr + ((size_t)s[2] * 4)));\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (3 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[3] * 4)));\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 4;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n\n    s += 1 * 1;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\nWUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"avx2\")\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__index__src__x86_avx2(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len4 = dst.len / 4;\n  size_t len = dst_len4 < src.len ? dst_len4 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n" +
+	"  size_t n = len;\n\n  const int* palette = (const int*)(const void*)(dst_palette.ptr);\n\n  while (n >= 8) {\n    __m256i indexes =\n        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(const void*)s));\n    _mm256_storeu_si256((__m256i*)(void*)d,\n                        _mm256_i32gather_epi32(palette, indexes, 4));\n\n    s += 8 * 1;\n    d += 8 * 4;\n    n -= 8;\n  }\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), wuffs_base__load_u32le__no_bounds_check(\n                         dst_palette.ptr + ((size_t)s[0] * 4)));\n\n    s += 1 * 1;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (dst_palette.len != 1024) {\n    return 0;\n  }\n  size_t dst_len4 = dst.len / 4;\n  size_t len = dst_len4 < src.len ? dst_len4 : src.len;\n  uint8_t* d = dst.pt" +
+	"r;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const size_t loop_unroll_count = 4;\n\n  while (n >= loop_unroll_count) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);\n    }\n    uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[1] * 4));\n    if (s1) {\n      wuffs_base__store_u32le__no_bounds_check(d + (1 * 4), s1);\n    }\n    uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[2] * 4));\n    if (s2) {\n      wuffs_base__store_u32le__no_bounds_check(d + (2 * 4), s2);\n    }\n    uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[3] * 4));\n    if (s3) {\n      wuffs_bas" +
+	"e__store_u32le__no_bounds_check(d + (3 * 4), s3);\n    }\n\n    s += loop_unroll_count * 1;\n    d += loop_unroll_count * 4;\n    n -= loop_unroll_count;\n  }\n\n  while (n >= 1) {\n    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +\n                                                          ((size_t)s[0] * 4));\n    if (s0) {\n      wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);\n    }\n\n    s += 1 * 1;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__xxx(wuffs_base__slice_u8 dst,\n                                      wuffs_base__slice_u8 dst_palette,\n                                      wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len3 = src.len / 3;\n  size_t len = dst_len4 < src_len3 ? dst_len4 : src_len3;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  // TODO: unroll.\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4),\n        0xFF000000 | wuff" +
+	"s_base__load_u24le__no_bounds_check(s + (0 * 3)));\n\n    s += 1 * 3;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\nWUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2\")\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__xxx__x86_sse42(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t src_len3 = src.len / 3;\n  size_t len = dst_len4 < src_len3 ? dst_len4 : src_len3;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8,\n                                        -128, 9, 10, 11, -128);\n  const __m128i alpha_bytes = _mm_set1_epi32((int32_t)0xFF000000);\n\n  // Each iteration loads 16 src bytes but only uses 12 of them (4 pixels). The\n  // loop condition is \"n >= 6\", not \"n >= 4\", so that the load stays within\n  // the src slice.\n  while (n >= 6) {\n    __m128i x = _mm_lddqu_si128((cons" +
+	"t __m128i*)(const void*)s);\n    _mm_storeu_si128((__m128i*)(void*)d,\n                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle), alpha_bytes));\n\n    s += 4 * 3;\n    d += 4 * 4;\n    n -= 4;\n  }\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4),\n        0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s + (0 * 3)));\n\n    s += 1 * 3;\n    d += 1 * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__xxxx__y(wuffs_base__slice_u8 dst,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__slice_u8 src) {\n  size_t dst_len4 = dst.len / 4;\n  size_t len = dst_len4 < src.len ? dst_len4 : src.len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  // TODO: unroll.\n\n  while (n >= 1) {\n    wuffs_base__store_u32le__no_bounds_check(\n        d + (0 * 4), 0xFF000000 | (0x010101 * (uint32_t)s[0]));\n\n    s += 1 * 1;\n    d += 1" +
+	" * 4;\n    n -= 1;\n  }\n\n  return len;\n}\n\n" +
+	"" +
+	"// --------\n\n// wuffs_base__pixel_swizzler__convert_palette converts the 256 entries of\n// src_palette, in one of the INDEXED__BGRA_* formats, to dst_palette entries\n// suitable for dst_repr. Each 4-byte dst entry holds a 4-byte color in the\n// dst's BGR or RGB order, keeping the alpha byte even for 3-byte or X-padded\n// dst formats, or for BGR_565, a 2-byte color followed by 2 zero bytes.\n//\n// It returns false if dst_repr is not an indexed, BGR_565, BGR[A|X]_* or\n// RGB[A|X]_* format.\nstatic bool  //\nwuffs_base__pixel_swizzler__convert_palette(wuffs_base__slice_u8 dst_palette,\n                                            uint32_t dst_repr,\n                                            wuffs_base__slice_u8 src_palette,\n                                            uint32_t src_repr) {\n  if ((dst_palette.len != 1024) || (src_palette.len != 1024)) {\n    return false;\n  }\n  bool swap = false;\n  switch (dst_repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED_" +
+	"_BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      swap = true;\n      break;\n    default:\n      return false;\n  }\n\n  uint32_t dst_transparency = 0x07 & (dst_repr >> 24);\n  uint32_t src_transparency = 0x07 & (src_repr >> 24);\n  size_t i;\n  for (i = 0; i < 1024; i += 4) {\n    uint32_t c = wuffs_base__load_u32le__no_bounds_check(src_palette.ptr + i);\n    c = wuffs_base__pixel_swizzler__convert_transparency(c, dst_transparency,\n                                                         " +
+	"src_transparency);\n    if (dst_repr == WUFFS_BASE__PIXEL_FORMAT__BGR_565) {\n      c = wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(c);\n    } else if (swap) {\n      c = wuffs_base__swap_u32_argb_abgr(c);\n    }\n    wuffs_base__store_u32le__no_bounds_check(dst_palette.ptr + i, c);\n  }\n  return true;\n}\n\n" +
+	"" +
+	"// --------\n\n// The generic swizzler converts one pixel at a time, via a 0xAARRGGBB\n// intermediate value. It is slower than the specialized swizzlers above, but\n// it converts between any two of the Y, INDEXED__BGRA_*, BGR_565, BGR[A|X]_*\n// and RGB[A|X]_* pixel formats (except that the dst cannot be indexed), and\n// wuffs_base__pixel_swizzler__prepare falls back to it when there is no\n// specialized swizzler.\n//\n// As both a src and a dst, binary alpha is treated as premultiplied alpha.\n// With the SRC blend, converting to a dst without alpha (such as BGR or BGRX)\n// drops the alpha but otherwise keeps the color as is, like the copy_4_4\n// swizzler does for BGRA_NONPREMUL to BGRX.\n\nstatic bool  //\nwuffs_base__pixel_swizzler__generic__accepts(uint32_t repr) {\n  switch (repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n    case WUFFS_BASE__PI" +
+	"XEL_FORMAT__BGR_565:\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      return true;\n  }\n  return false;\n}\n\nstatic inline uint32_t  //\nwuffs_base__pixel_swizzler__generic__load(uint32_t repr,\n                                          uint8_t* s,\n                                          uint8_t* palette) {\n  switch (repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      return 0xFF000000 | (0x00010101 * ((uint32_t)(s[0])));\n\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n      return " +
+	"wuffs_base__load_u32le__no_bounds_check(palette +\n                                                     (4 * ((size_t)s[0])));\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      return wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(\n          wuffs_base__load_u16le__no_bounds_check(s));\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      return 0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s);\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n      return 0xFF000000 | wuffs_base__load_u32le__no_bounds_check(s);\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      return wuffs_base__load_u32le__no_bounds_check(s);\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      return wuffs_base__swap_u32_argb_abgr(\n          0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s));\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n      return wuffs_base__swap_u32_argb_abgr(\n          0xFF000000 | wuffs_base__load_u32le__no_bounds_check" +
+	"(s));\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      return wuffs_base__swap_u32_argb_abgr(\n          wuffs_base__load_u32le__no_bounds_check(s));\n  }\n  return 0;\n}\n\nstatic inline void  //\nwuffs_base__pixel_swizzler__generic__store(uint32_t repr,\n                                           uint8_t* d,\n                                           uint32_t c) {\n  switch (repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      d[0] = wuffs_base__color_u32_argb_premul__as__color_u8_gray(c);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      wuffs_base__store_u16le__no_bounds_check(\n          d, wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(c));\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      wuffs_base__store_u24le__no_bounds_check(d, c);\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_" +
+	"PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      wuffs_base__store_u32le__no_bounds_check(d, c);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      wuffs_base__store_u24le__no_bounds_check(\n          d, wuffs_base__swap_u32_argb_abgr(c));\n      break;\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      wuffs_base__store_u32le__no_bounds_check(\n          d, wuffs_base__swap_u32_argb_abgr(c));\n      break;\n  }\n}\n\nstatic uint64_t  //\nwuffs_base__pixel_swizzler__generic(const wuffs_base__pixel_swizzler* p,\n                                    wuffs_base__slice_u8 dst,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__slice_u8 src) {\n  wuffs_base__pixel_format dst_format =\n      wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);\n  wuffs_base__pixel_format src_format =\n      " +
+	"wuffs_base__make_pixel_format(p->private_impl.src_pixfmt_repr);\n  if (wuffs_base__pixel_format__is_indexed(&src_format) &&\n      (dst_palette.len != 1024)) {\n    return 0;\n  }\n  size_t dst_bytes_per_pixel =\n      wuffs_base__pixel_format__bits_per_pixel(&dst_format) / 8;\n  size_t src_bytes_per_pixel =\n      wuffs_base__pixel_format__bits_per_pixel(&src_format) / 8;\n  size_t dst_len = dst.len / dst_bytes_per_pixel;\n  size_t src_len = src.len / src_bytes_per_pixel;\n  size_t len = dst_len < src_len ? dst_len : src_len;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  uint32_t dst_transparency = 0x07 & (dst_format.repr >> 24);\n  uint32_t src_transparency = 0x07 & (src_format.repr >> 24);\n  bool src_over =\n      (p->private_impl.blend == WUFFS_BASE__PIXEL_BLEND__SRC_OVER) &&\n      (src_transparency >= 5);\n\n  while (n >= 1) {\n    uint32_t c = wuffs_base__pixel_swizzler__generic__load(src_format.repr, s,\n                                                           dst_palette.ptr);\n    uint32_t sa " +
+	"= c >> 24;\n    if (!src_over || (sa == 0xFF)) {\n      c = wuffs_base__pixel_swizzler__convert_transparency(c, dst_transparency,\n                                                           src_transparency);\n      wuffs_base__pixel_swizzler__generic__store(dst_format.repr, d, c);\n    } else if (sa != 0x00) {\n      // Composite src over dst in premultiplied alpha. A fully transparent src\n      // pixel leaves the dst as is, without a lossy premul round trip.\n      uint32_t d0 =\n          wuffs_base__pixel_swizzler__generic__load(dst_format.repr, d, NULL);\n      if (dst_transparency == 5) {\n        d0 = wuffs_base__premul_u32_axxx(d0);\n      }\n      if (src_transparency == 5) {\n        c = wuffs_base__composite_premul_nonpremul_u32_axxx(d0, c);\n      } else {\n        c = wuffs_base__composite_premul_premul_u32_axxx(d0, c);\n      }\n      if (dst_transparency == 5) {\n        c = wuffs_base__nonpremul_u32_axxx(c);\n      }\n      wuffs_base__pixel_swizzler__generic__store(dst_format.repr, d, c);\n    }\n\n    s += 1 * sr" +
+	"c_bytes_per_pixel;\n    d += 1 * dst_bytes_per_pixel;\n    n -= 1;\n  }\n\n  return len;\n}\n\n" +
+	"" +
+	"// --------\n\n// wuffs_base__pixel_swizzler__mirror_bgr_rgb returns the pixel format with\n// the BGR and RGB channel orders swapped (e.g. RGBX for BGRX). The specialized\n// swizzlers do not depend on the channel order, only on whether the src and\n// dst orders match, so an RGB-order src can re-use the prepare__bgr* function\n// for the corresponding BGR-order src, if passed a mirrored dst format. A\n// mirrored INDEXED__BGRA_* or BGR_565 format is not a valid format.\nstatic inline wuffs_base__pixel_format  //\nwuffs_base__pixel_swizzler__mirror_bgr_rgb(wuffs_base__pixel_format f) {\n  switch (f.repr >> 28) {\n    case 0x4:\n      return wuffs_base__make_pixel_format(f.repr + 0x10000000);\n    case 0x5:\n      return wuffs_base__make_pixel_format(f.repr - 0x10000000);\n  }\n  return f;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,\n                                       wuffs_base__pixel_format dst_format,\n                                       wuffs_b" +
+	"ase__slice_u8 dst_palette,\n                                       wuffs_base__slice_u8 src_palette,\n                                       wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      return wuffs_base__pixel_swizzler__copy_1_1;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      return wuffs_base__pixel_swizzler__xxx__y;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      return wuffs_base__pixel_swizzler__xxxx__y;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__indexed(\n    wuffs_base__pixel_swizzler* p,\n    wuffs_base__pixel_format d" +
+	"st_format,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__pixel_format src_format,\n    wuffs_base__slice_u8 src_palette,\n    wuffs_base__pixel_blend blend) {\n  if (!wuffs_base__pixel_swizzler__convert_palette(\n          dst_palette, dst_format.repr, src_palette, src_format.repr)) {\n    return NULL;\n  }\n  bool binary =\n      src_format.repr == WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY;\n\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__copy_1_1;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__xx__index__src;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n    case WUFFS_BASE__PIXEL_FORMA" +
+	"T__RGB:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__xxx__index__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          if (binary) {\n            return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;\n          }\n          break;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n          if (wuffs_base__cpu_arch__have_x86_avx2()) {\n            return wuffs_base__pixel_swizzler__xxxx__index__src__x86_avx2;\n          }\n#endif\n          return wuffs_base__pixel_swizzler_" +
+	"_xxxx__index__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          if (binary) {\n            return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;\n          }\n          break;\n      }\n      return NULL;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__bgr_565(\n    wuffs_base__pixel_swizzler* p,\n    wuffs_base__pixel_format dst_format,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src_palette,\n    wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      return wuffs_base__pixel_swizzler__copy_2_2;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,\n                                         wuffs_base__pixel_format dst_format,\n                                         wuffs_base__slice_u8 dst_palette,\n                                         wuffs_base__slice_u8 src_palette,\n   " +
+	"                                      wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      return wuffs_base__pixel_swizzler__copy_3_3;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n      if (wuffs_base__cpu_arch__have_x86_sse42()) {\n        return wuffs_base__pixel_swizzler__xxxx__xxx__x86_sse42;\n      }\n#endif\n      return wuffs_base__pixel_swizzler__xxxx__xxx;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      return wuffs_base__pixel_swizzler__swap_rgb_bgr;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__bgrx(wuffs_base__pixel_swizzler* p,\n                                          wuffs_base__pixel_format dst_format,\n                                          wuffs_base__slice_u8 dst_palette,\n                            " +
+	"              wuffs_base__slice_u8 src_palette,\n                                          wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n      return wuffs_base__pixel_swizzler__copy_4_4;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n      if (wuffs_base__cpu_arch__have_x86_sse42()) {\n        return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;\n      }\n#endif\n      return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__bgra_nonpremul(\n    wuffs_base__pixel_swizzler* p,\n    wuffs_base__pixel_format dst_format,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src_palette,\n    wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n       " +
+	"   return wuffs_base__pixel_swizzler__copy_4_4;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n          if (wuffs_base__cpu_arch__have_x86_sse42()) {\n            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_sse42;\n          }\n#endif\n          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n          if (wuffs_base__cpu_arch__have_x86_sse42()) {\n            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_sse42;\n          }\n#endif\n          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n      switch (blend) {\n        c" +
+	"ase WUFFS_BASE__PIXEL_BLEND__SRC:\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n          if (wuffs_base__cpu_arch__have_x86_sse42()) {\n            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;\n          }\n#endif\n          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;\n      }\n      return NULL;\n  }\n  return NULL;\n}\n\nstatic wuffs_base__pixel_swizzler__func  //\nwuffs_base__pixel_swizzler__prepare__bgra_premul(\n    wuffs_base__pixel_swizzler* p,\n    wuffs_base__pixel_format dst_format,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src_palette,\n    wuffs_base__pixel_blend blend) {\n  switch (dst_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__copy_4_4;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n  " +
+	"  case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n          if (wuffs_base__cpu_arch__have_x86_sse42()) {\n            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;\n          }\n#endif\n          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;\n      }\n      return NULL;\n  }\n  return NULL;\n}\n\nstatic bool  //\nwuffs_base__pixel_swizzler__prepare__generic(\n    wuffs_base__pixel_swizzler* p,\n    wuffs_base__pixel_format dst_format,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__pixel_format src_format,\n    wuffs_base__slice_u8 src_palette,\n    wuffs_base__pixel_blend blend) {\n  if (!wuffs_base__pixel_swizzler__generic__accepts(dst_format.repr) ||\n      !wuffs_base__pixel_swizzler__generic__accepts(src_format.repr) ||\n      wuffs_base__pixel_format__is_indexed(&dst_format)) {\n    return false;\n  }\n  switch (blend) {\n    case WUFFS_BASE__PIXEL_BLEND__SRC:\n    case WUFFS_BASE__PIXEL_BLEND__SR" +
+	"C_OVER:\n      break;\n    default:\n      return false;\n  }\n\n  // The generic swizzler looks up an indexed src's colors in the dst_palette,\n  // holding an unconverted copy of the src_palette.\n  if (wuffs_base__pixel_format__is_indexed(&src_format) &&\n      (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=\n       1024)) {\n    return false;\n  }\n\n  p->private_impl.dst_pixfmt_repr = dst_format.repr;\n  p->private_impl.src_pixfmt_repr = src_format.repr;\n  p->private_impl.blend = blend;\n  return true;\n}\n\n" +
+	"" +
+	"// --------\n\nwuffs_base__status  //\nwuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,\n                                    wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend) {\n  if (!p) {\n    return wuffs_base__make_status(wuffs_base__error__bad_receiver);\n  }\n  p->private_impl.func = NULL;\n  p->private_impl.dst_pixfmt_repr = 0;\n  p->private_impl.src_pixfmt_repr = 0;\n  p->private_impl.blend = 0;\n\n  // TODO: support planar formats.\n\n  wuffs_base__pixel_swizzler__func func = NULL;\n\n  switch (src_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      func = wuffs_base__pixel_swizzler__prepare__y(p, dst_format, dst_palette,\n                                                    src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PI" +
+	"XEL_FORMAT__INDEXED__BGRA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n      func = wuffs_base__pixel_swizzler__prepare__indexed(\n          p, dst_format, dst_palette, src_format, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:\n      func = wuffs_base__pixel_swizzler__prepare__bgr_565(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      func = wuffs_base__pixel_swizzler__prepare__bgr(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRX:\n      func = wuffs_base__pixel_swizzler__prepare__bgrx(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXE" +
+	"L_FORMAT__BGRA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      func = wuffs_base__pixel_swizzler__prepare__bgra_premul(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGB:\n      func = wuffs_base__pixel_swizzler__prepare__bgr(\n          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),\n          dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n      func = wuffs_base__pixel_swizzler__prepare__bgrx(\n          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),\n          dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n      func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(\n          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),\n          dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      func = wuffs_base__pixel_" +
+	"swizzler__prepare__bgra_premul(\n          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),\n          dst_palette, src_palette, blend);\n      break;\n  }\n\n  if (func) {\n    p->private_impl.func = func;\n    p->private_impl.dst_pixfmt_repr = dst_format.repr;\n    p->private_impl.src_pixfmt_repr = src_format.repr;\n    p->private_impl.blend = blend;\n  } else if (!wuffs_base__pixel_swizzler__prepare__generic(\n                 p, dst_format, dst_palette, src_format, src_palette, blend)) {\n    return wuffs_base__make_status(\n        wuffs_base__error__unsupported_pixel_swizzler_option);\n  }\n  return wuffs_base__make_status(NULL);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (p) {\n    if (p->private_impl.func) {\n      return (*p->private_impl.func)(dst, dst_palette, src);\n    } else if (p->private_impl.src_pixfmt_repr) {\n      return wuffs_base__p" +
+	"ixel_swizzler__generic(p, dst, dst_palette, src);\n    }\n  }\n  return 0;\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src,\n    uint32_t x_step) {\n  if (x_step <= 1) {\n    return wuffs_base__pixel_swizzler__swizzle_interleaved(p, dst, dst_palette,\n                                                           src);\n  } else if (!p || !p->private_impl.src_pixfmt_repr) {\n    return 0;\n  }\n  wuffs_base__pixel_format dst_format =\n      wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);\n  wuffs_base__pixel_format src_format =\n      wuffs_base__make_pixel_format(p->private_impl.src_pixfmt_repr);\n  size_t dst_bytes_per_pixel =\n      wuffs_base__pixel_format__bits_per_pixel(&dst_format) / 8;\n  size_t src_bytes_per_pixel =\n      wuffs_base__pixel_format__bits_per_pixel(&src_format) / 8;\n  if ((dst_bytes_per_pixel == 0) || (src_bytes_per_pixel == 0) " +
+	"||\n      (src_bytes_per_pixel > 8)) {\n    return 0;\n  }\n  size_t src_stride = src_bytes_per_pixel * x_step;\n  size_t src_len = src.len / src_bytes_per_pixel;\n  uint8_t* s = src.ptr;\n\n  // Gather the kept source pixels into a contiguous buffer, a batch at a\n  // time, and swizzle each batch with the regular (non-subsampled) func.\n  uint8_t batch[1024];\n  const size_t batch_cap = sizeof(batch) / src_bytes_per_pixel;\n\n  uint64_t num_src_consumed = 0;\n  while (num_src_consumed < src_len) {\n    size_t n = ((src_len - num_src_consumed) + (x_step - 1)) / x_step;\n    if (n > batch_cap) {\n      n = batch_cap;\n    }\n    size_t i;\n    for (i = 0; i < n; i++) {\n      memcpy(batch + (i * src_bytes_per_pixel), s + (i * src_stride),\n             src_bytes_per_pixel);\n    }\n\n    uint64_t num_dst_written = wuffs_base__pixel_swizzler__swizzle_interleaved(\n        p, dst, dst_palette,\n        wuffs_base__make_slice_u8(batch, n * src_bytes_per_pixel));\n    if (num_dst_written == 0) {\n      break;\n    }\n    uint64_t m = num_dst_w" +
+	"ritten * x_step;\n    if (m > (src_len - num_src_consumed)) {\n      m = src_len - num_src_consumed;\n    }\n    num_src_consumed += m;\n    if (num_dst_written < n) {\n      break;\n    }\n\n    dst.ptr += n * dst_bytes_per_pixel;\n    dst.len -= n * dst_bytes_per_pixel;\n    s += n * src_stride;\n  }\n  return num_src_consumed;\n}\n" +
 	""
 
 const baseStrConvImplC = "" +
@@ -77,7 +110,12 @@ const baseStrConvImplC = "" +
 	"alue = +(int64_t)(r.value);\n      return ret;\n    }\n  } while (0);\n\nfail_bad_argument:\n  do {\n    wuffs_base__result_i64 ret;\n    ret.status.repr = wuffs_base__error__bad_argument;\n    ret.value = 0;\n    return ret;\n  } while (0);\n\nfail_out_of_bounds:\n  do {\n    wuffs_base__result_i64 ret;\n    ret.status.repr = wuffs_base__error__out_of_bounds;\n    ret.value = 0;\n    return ret;\n  } while (0);\n}\n\nwuffs_base__result_u64  //\nwuffs_base__parse_number_u64(wuffs_base__slice_u8 s) {\n  uint8_t* p = s.ptr;\n  uint8_t* q = s.ptr + s.len;\n\n  for (; (p < q) && (*p == '_'); p++) {\n  }\n\n  if (p >= q) {\n    goto fail_bad_argument;\n\n  } else if (*p == '0') {\n    p++;\n    if (p >= q) {\n      goto ok_zero;\n    }\n    if (*p == '_') {\n      p++;\n      for (; p < q; p++) {\n        if (*p != '_') {\n          goto fail_bad_argument;\n        }\n      }\n      goto ok_zero;\n    }\n\n    if ((*p == 'x') || (*p == 'X')) {\n      p++;\n      for (; (p < q) && (*p == '_'); p++) {\n      }\n      if (p < q) {\n        goto hexadecimal;\n      }\n\n  " +
 	"  } else if ((*p == 'd') || (*p == 'D')) {\n      p++;\n      for (; (p < q) && (*p == '_'); p++) {\n      }\n      if (p < q) {\n        goto decimal;\n      }\n    }\n\n    goto fail_bad_argument;\n  }\n\ndecimal:\n  do {\n    uint64_t v = wuffs_base__parse_number__decimal_digits[*p++];\n    if (v == 0) {\n      goto fail_bad_argument;\n    }\n    v &= 0x0F;\n\n    // UINT64_MAX is 18446744073709551615, which is ((10 * max10) + max1).\n    const uint64_t max10 = 1844674407370955161;\n    const uint8_t max1 = 5;\n\n    for (; p < q; p++) {\n      if (*p == '_') {\n        continue;\n      }\n      uint8_t digit = wuffs_base__parse_number__decimal_digits[*p];\n      if (digit == 0) {\n        goto fail_bad_argument;\n      }\n      digit &= 0x0F;\n      if ((v > max10) || ((v == max10) && (digit > max1))) {\n        goto fail_out_of_bounds;\n      }\n      v = (10 * v) + ((uint64_t)(digit));\n    }\n\n    wuffs_base__result_u64 ret;\n    ret.status.repr = NULL;\n    ret.value = v;\n    return ret;\n  } while (0);\n\nhexadecimal:\n  do {\n    uint64_t v = " +
 	"wuffs_base__parse_number__hexadecimal_digits[*p++];\n    if (v == 0) {\n      goto fail_bad_argument;\n    }\n    v &= 0x0F;\n\n    for (; p < q; p++) {\n      if (*p == '_') {\n        continue;\n      }\n      uint8_t digit = wuffs_base__parse_number__hexadecimal_digits[*p];\n      if (digit == 0) {\n        goto fail_bad_argument;\n      }\n      digit &= 0x0F;\n      if ((v >> 60) != 0) {\n        goto fail_out_of_bounds;\n      }\n      v = (v << 4) | ((uint64_t)(digit));\n    }\n\n    wuffs_base__result_u64 ret;\n    ret.status.repr = NULL;\n    ret.value = v;\n    return ret;\n  } while (0);\n\nok_zero:\n  do {\n    wuffs_base__result_u64 ret;\n    ret.status.repr = NULL;\n    ret.value = 0;\n    return ret;\n  } while (0);\n\nfail_bad_argument:\n  do {\n    wuffs_base__result_u64 ret;\n    ret.status.repr = wuffs_base__error__bad_argument;\n    ret.value = 0;\n    return ret;\n  } while (0);\n\nfail_out_of_bounds:\n  do {\n    wuffs_base__result_u64 ret;\n    ret.status.repr = wuffs_base__error__out_of_bounds;\n    ret.value = 0;\n    return ret;\n " +
-	" } while (0);\n}\n\n  " +
+	" } while (0);\n}\n\n" +
+	"" +
+	"// --------\n\n// wuffs_base__render_number__two_digits holds the ASCII encodings of \"00\",\n// \"01\", \"02\", ..., \"99\". Looking up two digits at a time halves the number of\n// (relatively slow) 64-bit divisions compared to one digit at a time.\nstatic const uint8_t wuffs_base__render_number__two_digits[200] = {\n    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0',\n    '7', '0', '8', '0', '9', '1', '0', '1', '1', '1', '2', '1', '3', '1', '4',\n    '1', '5', '1', '6', '1', '7', '1', '8', '1', '9', '2', '0', '2', '1', '2',\n    '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',\n    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3',\n    '7', '3', '8', '3', '9', '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',\n    '4', '5', '4', '6', '4', '7', '4', '8', '4', '9', '5', '0', '5', '1', '5',\n    '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',\n    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6',\n    '7" +
+	"', '6', '8', '6', '9', '7', '0', '7', '1', '7', '2', '7', '3', '7', '4',\n    '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '8', '0', '8', '1', '8',\n    '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',\n    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9',\n    '7', '9', '8', '9', '9',\n};\n\nstatic size_t  //\nwuffs_base__private_implementation__render_number_u64(wuffs_base__slice_u8 dst,\n                                                      uint64_t x,\n                                                      uint32_t options,\n                                                      bool neg) {\n  uint8_t buf[WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];\n  uint8_t* ptr = &buf[0] + sizeof(buf);\n\n  // Write the digits right to left, two at a time.\n  while (x >= 100) {\n    size_t index = ((size_t)(x % 100)) * 2;\n    x /= 100;\n    ptr -= 2;\n    ptr[0] = wuffs_base__render_number__two_digits[index + 0];\n    ptr[1] = wuffs_base__render_number__two_digits[index + 1];\n  }\n  if (x " +
+	">= 10) {\n    size_t index = ((size_t)x) * 2;\n    ptr -= 2;\n    ptr[0] = wuffs_base__render_number__two_digits[index + 0];\n    ptr[1] = wuffs_base__render_number__two_digits[index + 1];\n  } else {\n    ptr -= 1;\n    ptr[0] = (uint8_t)('0' + x);\n  }\n\n  if (neg) {\n    ptr -= 1;\n    ptr[0] = '-';\n  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {\n    ptr -= 1;\n    ptr[0] = '+';\n  }\n\n  size_t n = (size_t)((&buf[0] + sizeof(buf)) - ptr);\n  if (n > dst.len) {\n    return 0;\n  }\n  memcpy(dst.ptr + ((options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)\n                        ? (dst.len - n)\n                        : 0),\n         ptr, n);\n  return n;\n}\n\nsize_t  //\nwuffs_base__render_number_i64(wuffs_base__slice_u8 dst,\n                              int64_t x,\n                              uint32_t options) {\n  uint64_t u = (uint64_t)x;\n  bool neg = x < 0;\n  if (neg) {\n    // Negate in uint64_t arithmetic, so that INT64_MIN is not undefined\n    // behavior.\n    u = 1 + ~u;\n  }\n  return wuffs_base" +
+	"__private_implementation__render_number_u64(dst, u, options,\n                                                               neg);\n}\n\nsize_t  //\nwuffs_base__render_number_u64(wuffs_base__slice_u8 dst,\n                              uint64_t x,\n                              uint32_t options) {\n  return wuffs_base__private_implementation__render_number_u64(dst, x, options,\n                                                               false);\n}\n\n  " +
 	"" +
 	"// ---------------- IEEE 754 Floating Point\n\n#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE 1023\n#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION 500\n\n// WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL is the largest N\n// such that ((10 << N) < (1 << 64)).\n#define WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL 60\n\n// wuffs_base__private_implementation__high_prec_dec (abbreviated as HPD) is a\n// fixed precision floating point decimal number, augmented with ±infinity\n// values, but it cannot represent NaN (Not a Number).\n//\n// \"High precision\" means that the mantissa holds 500 decimal digits. 500 is\n// WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION.\n//\n// An HPD isn't for general purpose arithmetic, only for conversions to and\n// from IEEE 754 double-precision floating point, where the largest and\n// smallest positive, finite values are approximately 1.8e+308 and 4.9e-324.\n// HPD exponents above +1023 mean infinity, below -1023 mean zero. Th" +
 	"e ±1023\n// bounds are further away from zero than ±(324 + 500), where 500 and 1023 is\n// WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION and\n// WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE.\n//\n// digits[.. num_digits] are the number's digits in big-endian order. The\n// uint8_t values are in the range [0 ..= 9], not ['0' ..= '9'], where e.g. '7'\n// is the ASCII value 0x37.\n//\n// decimal_point is the index (within digits) of the decimal point. It may be\n// negative or be larger than num_digits, in which case the explicit digits are\n// padded with implicit zeroes.\n//\n// For example, if num_digits is 3 and digits is \"\\x07\\x08\\x09\":\n//   - A decimal_point of -2 means \".00789\"\n//   - A decimal_point of -1 means \".0789\"\n//   - A decimal_point of +0 means \".789\"\n//   - A decimal_point of +1 means \"7.89\"\n//   - A decimal_point of +2 means \"78.9\"\n//   - A decimal_point of +3 means \"789.\"\n//   - A decimal_point of +4 means \"7890.\"\n//   - A decimal_point of +5 means \"78900.\"\n//\n// As above, a" +
@@ -103,7 +141,17 @@ const baseStrConvImplC = "" +
 	"/ WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL.\n//\n// wuffs_base__private_implementation__high_prec_dec__rounded_integer and\n// wuffs_base__private_implementation__high_prec_dec__lshift_num_new_digits\n// have the same preconditions.\n\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__small_lshift(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    uint32_t shift) {\n  if (h->num_digits == 0) {\n    return;\n  }\n  uint32_t num_new_digits =\n      wuffs_base__private_implementation__high_prec_dec__lshift_num_new_digits(\n          h, shift);\n  uint32_t rx = h->num_digits - 1;                   // Read  index.\n  uint32_t wx = h->num_digits - 1 + num_new_digits;  // Write index.\n  uint64_t n = 0;\n\n  // Repeat: pick up a digit, put down a digit, right to left.\n  while (((int32_t)rx) >= 0) {\n    n += ((uint64_t)(h->digits[rx])) << shift;\n    uint64_t quo = n / 10;\n    uint64_t rem = n - (10 * quo);\n    if (wx < WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION) {\n      h->d" +
 	"igits[wx] = (uint8_t)rem;\n    } else if (rem > 0) {\n      h->truncated = true;\n    }\n    n = quo;\n    wx--;\n    rx--;\n  }\n\n  // Put down leading digits, right to left.\n  while (n > 0) {\n    uint64_t quo = n / 10;\n    uint64_t rem = n - (10 * quo);\n    if (wx < WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION) {\n      h->digits[wx] = (uint8_t)rem;\n    } else if (rem > 0) {\n      h->truncated = true;\n    }\n    n = quo;\n    wx--;\n  }\n\n  // Finish.\n  h->num_digits += num_new_digits;\n  if (h->num_digits >\n      WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION) {\n    h->num_digits = WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION;\n  }\n  h->decimal_point += (int32_t)num_new_digits;\n  wuffs_base__private_implementation__high_prec_dec__trim(h);\n}\n\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__small_rshift(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    uint32_t shift) {\n  uint32_t rx = 0;  // Read  index.\n  uint32_t wx = 0;  // Write index.\n  uint64_t n =" +
 	" 0;\n\n  // Pick up enough leading digits to cover the first shift.\n  while ((n >> shift) == 0) {\n    if (rx < h->num_digits) {\n      // Read a digit.\n      n = (10 * n) + h->digits[rx++];\n    } else if (n == 0) {\n      // h's number used to be zero and remains zero.\n      return;\n    } else {\n      // Read sufficient implicit trailing zeroes.\n      while ((n >> shift) == 0) {\n        n = 10 * n;\n        rx++;\n      }\n      break;\n    }\n  }\n  h->decimal_point -= ((int32_t)(rx - 1));\n  if (h->decimal_point <\n      -WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE) {\n    // After the shift, h's number is effectively zero.\n    h->num_digits = 0;\n    h->decimal_point = 0;\n    h->negative = false;\n    h->truncated = false;\n    return;\n  }\n\n  // Repeat: pick up a digit, put down a digit, left to right.\n  uint64_t mask = (((uint64_t)(1)) << shift) - 1;\n  while (rx < h->num_digits) {\n    uint8_t new_digit = ((uint8_t)(n >> shift));\n    n = (10 * (n & mask)) + h->digits[rx++];\n    h->digits[wx++] = new_digi" +
-	"t;\n  }\n\n  // Put down trailing digits, left to right.\n  while (n > 0) {\n    uint8_t new_digit = ((uint8_t)(n >> shift));\n    n = 10 * (n & mask);\n    if (wx < WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION) {\n      h->digits[wx++] = new_digit;\n    } else if (new_digit > 0) {\n      h->truncated = true;\n    }\n  }\n\n  // Finish.\n  h->num_digits = wx;\n  wuffs_base__private_implementation__high_prec_dec__trim(h);\n}\n\n" +
+	"t;\n  }\n\n  // Put down trailing digits, left to right.\n  while (n > 0) {\n    uint8_t new_digit = ((uint8_t)(n >> shift));\n    n = 10 * (n & mask);\n    if (wx < WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DIGITS_PRECISION) {\n      h->digits[wx++] = new_digit;\n    } else if (new_digit > 0) {\n      h->truncated = true;\n    }\n  }\n\n  // Finish.\n  h->num_digits = wx;\n  wuffs_base__private_implementation__high_prec_dec__trim(h);\n}\n\n// wuffs_base__private_implementation__high_prec_dec__shift multiplies h by\n// (2 ** shift), where shift may be negative and need not be \"a small shift\".\n//\n// The preconditions are the same as for the small_xshift functions, except\n// that shift may be zero or large. The caller is responsible for keeping\n// h->decimal_point \"not extreme\" throughout, which holds for any double.\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__shift(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    int32_t shift) {\n  while (shift > +WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT_" +
+	"_MAX_INCL) {\n    wuffs_base__private_implementation__high_prec_dec__small_lshift(\n        h, WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL);\n    shift -= WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n  }\n  while (shift < -WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL) {\n    wuffs_base__private_implementation__high_prec_dec__small_rshift(\n        h, WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL);\n    shift += WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n  }\n  if (shift > 0) {\n    wuffs_base__private_implementation__high_prec_dec__small_lshift(\n        h, (uint32_t)(+shift));\n  } else if (shift < 0) {\n    wuffs_base__private_implementation__high_prec_dec__small_rshift(\n        h, (uint32_t)(-shift));\n  }\n}\n\n// wuffs_base__private_implementation__high_prec_dec__assign sets h to the\n// exact value of (x * (2 ** exp2)), negated if negative.\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__assign(\n    wuffs_base__private_implementation__hig" +
+	"h_prec_dec* h,\n    uint64_t x,\n    int32_t exp2,\n    bool negative) {\n  uint8_t buf[20];\n  uint32_t n = 0;\n\n  // Set buf's digits, least significant first.\n  while (x > 0) {\n    uint64_t quo = x / 10;\n    buf[n++] = (uint8_t)(x - (10 * quo));\n    x = quo;\n  }\n\n  // Copy them to h, most significant first.\n  h->num_digits = n;\n  h->decimal_point = (int32_t)n;\n  h->negative = negative;\n  h->truncated = false;\n  uint32_t i = 0;\n  for (; i < n; i++) {\n    h->digits[i] = buf[n - 1 - i];\n  }\n  wuffs_base__private_implementation__high_prec_dec__trim(h);\n\n  wuffs_base__private_implementation__high_prec_dec__shift(h, exp2);\n}\n\n" +
+	"" +
+	"// --------\n\n// The wuffs_base__private_implementation__high_prec_dec__round_etc functions\n// round h's number to n digits, where n counts from the most significant digit\n// (h->digits[0]), not from the decimal point. They do nothing if n is\n// negative or if h already has n or fewer digits.\n//\n// round_down truncates, round_up rounds away from zero and round_nearest\n// rounds to nearest, ties to even (unless h->truncated, in which case an\n// apparent tie is really above halfway).\n\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__round_down(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    int32_t n) {\n  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {\n    return;\n  }\n  h->num_digits = (uint32_t)n;\n  wuffs_base__private_implementation__high_prec_dec__trim(h);\n}\n\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__round_up(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    int32_t n) {\n  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {\n    return;\n  }\n\n" +
+	"  for (n--; n >= 0; n--) {\n    if (h->digits[n] < 9) {\n      h->digits[n]++;\n      h->num_digits = (uint32_t)(n + 1);\n      return;\n    }\n  }\n\n  // The number is all 9s. Change to a single 1 and adjust the decimal point.\n  h->digits[0] = 1;\n  h->num_digits = 1;\n  h->decimal_point++;\n}\n\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__round_nearest(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    int32_t n) {\n  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {\n    return;\n  }\n  bool up = h->digits[n] >= 5;\n  if ((h->digits[n] == 5) && ((uint32_t)(n + 1) == h->num_digits)) {\n    up = h->truncated ||  //\n         ((n > 0) && (1 & h->digits[n - 1]));\n  }\n\n  if (up) {\n    wuffs_base__private_implementation__high_prec_dec__round_up(h, n);\n  } else {\n    wuffs_base__private_implementation__high_prec_dec__round_down(h, n);\n  }\n}\n\n// wuffs_base__private_implementation__high_prec_dec__round_just_enough rounds\n// h, which must hold the exact value of (mantissa * (2 ** exp2)), to the\n// few" +
+	"est digits that still parse back to the same double. mantissa includes\n// the implicit 1<<52 bit (for normal numbers) and exp2 is -1074 for subnormal\n// numbers, as well as the smallest normal exponent.\n//\n// This is the exact (but relatively slow) algorithm. It considers the\n// halfway points between h and its two neighboring doubles, as in\n// https://github.com/golang/go/blob/go1.15/src/strconv/ftoa.go roundShortest.\nstatic void  //\nwuffs_base__private_implementation__high_prec_dec__round_just_enough(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    int32_t exp2,\n    uint64_t mantissa) {\n  // The magic numbers 52 and -1074 are IEEE 754 double precision's mantissa\n  // bit count and minimum exponent.\n  if ((h->num_digits == 0) ||\n      // If the number's exponent is not the minimum, and its trailing zeroes\n      // (in decimal) outweigh its trailing (binary) fraction bits, then it is\n      // already as short as possible: every neighboring double differs by\n      // more than one unit in h's las" +
+	"t place.\n      ((exp2 > -1074) &&\n       ((332 * (h->decimal_point - (int32_t)(h->num_digits))) >=\n        (100 * exp2)))) {\n    return;\n  }\n\n  // Compute upper, halfway between h's number and its successor.\n  wuffs_base__private_implementation__high_prec_dec upper;\n  wuffs_base__private_implementation__high_prec_dec__assign(\n      &upper, (mantissa << 1) + 1, exp2 - 1, false);\n\n  // Compute lower, halfway between h's number and its predecessor. A power of\n  // 2 (other than the minimum exponent's) is closer to its predecessor.\n  uint64_t l_mantissa = mantissa - 1;\n  int32_t l_exp2 = exp2;\n  if ((mantissa <= 0x10000000000000) && (exp2 > -1074)) {\n    l_mantissa = (mantissa << 1) - 1;\n    l_exp2 = exp2 - 1;\n  }\n  wuffs_base__private_implementation__high_prec_dec lower;\n  wuffs_base__private_implementation__high_prec_dec__assign(\n      &lower, (l_mantissa << 1) + 1, l_exp2 - 1, false);\n\n  // The upper and lower bounds are possible outputs only if the original\n  // mantissa is even, so that IEEE round-to-even wo" +
+	"uld round to the original\n  // mantissa and not the neighbors.\n  bool inclusive = (mantissa & 1) == 0;\n\n  // As we walk the digits, upper_delta tracks whether rounding up would stay\n  // within the upper bound. 0 means that h and upper have had the same digits\n  // so far. 1 means that they differed by 1 on a previous digit and since\n  // then h has had only 9s and upper only 0s (so rounding up might land on\n  // the bound). 2 means that they differ by more than that.\n  uint8_t upper_delta = 0;\n\n  // Walk along until h has distinguished itself from both upper and lower.\n  // upper has the largest decimal_point, so iterate over its digits and start\n  // li and mi at (possibly) -1.\n  int32_t ui = 0;\n  for (;; ui++) {\n    int32_t mi = ui - upper.decimal_point + h->decimal_point;\n    if (mi >= ((int32_t)(h->num_digits))) {\n      break;\n    }\n    int32_t li = ui - upper.decimal_point + lower.decimal_point;\n    uint8_t l = ((li >= 0) && (li < ((int32_t)(lower.num_digits))))\n                    ? lower.digits[li]\n  " +
+	"                  : 0;\n    uint8_t m = (mi >= 0) ? h->digits[mi] : 0;\n    uint8_t u = (ui < ((int32_t)(upper.num_digits))) ? upper.digits[ui] : 0;\n\n    // It's OK to round down (truncate) if lower has a different digit, or if\n    // lower is inclusive and is exactly the result of rounding down (i.e. we\n    // have reached lower's final digit).\n    bool ok_down = (l != m) ||  //\n                   (inclusive && ((li + 1) == ((int32_t)(lower.num_digits))));\n\n    if ((upper_delta == 0) && ((m + 1) < u)) {\n      upper_delta = 2;\n    } else if ((upper_delta == 0) && (m != u)) {\n      upper_delta = 1;\n    } else if ((upper_delta == 1) && ((m != 9) || (u != 0))) {\n      upper_delta = 2;\n    }\n\n    // It's OK to round up if upper has a different digit and either upper is\n    // inclusive or upper is bigger than the result of rounding up.\n    bool ok_up = (upper_delta > 0) &&   //\n                 (inclusive ||          //\n                  (upper_delta > 1) ||  //\n                  ((ui + 1) < ((int32_t)(upper.num_di" +
+	"gits))));\n\n    if (ok_down && ok_up) {\n      wuffs_base__private_implementation__high_prec_dec__round_nearest(h,\n                                                                       mi + 1);\n      return;\n    } else if (ok_down) {\n      wuffs_base__private_implementation__high_prec_dec__round_down(h, mi + 1);\n      return;\n    } else if (ok_up) {\n      wuffs_base__private_implementation__high_prec_dec__round_up(h, mi + 1);\n      return;\n    }\n  }\n}\n\n" +
 	"" +
 	"// --------\n\n// The wuffs_base__private_implementation__etc_powers_of_10 tables were printed\n// by script/print-mpb-powers-of-10.go. That script has an optional -comments\n// flag, whose output is not copied here, which prints further detail.\n//\n// These tables are used in\n// wuffs_base__private_implementation__medium_prec_bin__assign_from_hpd.\n\n// wuffs_base__private_implementation__big_powers_of_10 contains approximations\n// to the powers of 10, ranging from 1e-348 to 1e+340, with the exponent\n// stepping by 8: -348, -340, -332, ..., -12, -4, +4, +12, ..., +340. Each step\n// consists of three uint32_t elements. There are 87 triples, 87 * 3 = 261.\n//\n// For example, the third approximation, for 1e-332, consists of the uint32_t\n// triple (0x3055AC76, 0x8B16FB20, 0xFFFFFB72). The first two of that triple\n// are a little-endian uint64_t value: 0x8B16FB203055AC76. The last one is an\n// int32_t value: -1166. Together, they represent the approximation:\n//   1e-332 ≈ 0x8B16FB203055AC76 * (2 ** -1166)\n// Similarly," +
 	" the (0x00000000, 0x9C400000, 0xFFFFFFCE) uint32_t triple means:\n//   1e+4   ≈ 0x9C40000000000000 * (2 **   -50)  // This approx'n is exact.\n// Similarly, the (0xD4C4FB27, 0xED63A231, 0x000000A2) uint32_t triple means:\n//   1e+68  ≈ 0xED63A231D4C4FB27 * (2 **   162)\nstatic const uint32_t\n    wuffs_base__private_implementation__big_powers_of_10[261] = {\n        0x081C0288, 0xFA8FD5A0, 0xFFFFFB3C, 0xA23EBF76, 0xBAAEE17F, 0xFFFFFB57,\n        0x3055AC76, 0x8B16FB20, 0xFFFFFB72, 0x5DCE35EA, 0xCF42894A, 0xFFFFFB8C,\n        0x55653B2D, 0x9A6BB0AA, 0xFFFFFBA7, 0x3D1A45DF, 0xE61ACF03, 0xFFFFFBC1,\n        0xC79AC6CA, 0xAB70FE17, 0xFFFFFBDC, 0xBEBCDC4F, 0xFF77B1FC, 0xFFFFFBF6,\n        0x416BD60C, 0xBE5691EF, 0xFFFFFC11, 0x907FFC3C, 0x8DD01FAD, 0xFFFFFC2C,\n        0x31559A83, 0xD3515C28, 0xFFFFFC46, 0xADA6C9B5, 0x9D71AC8F, 0xFFFFFC61,\n        0x23EE8BCB, 0xEA9C2277, 0xFFFFFC7B, 0x4078536D, 0xAECC4991, 0xFFFFFC96,\n        0x5DB6CE57, 0x823C1279, 0xFFFFFCB1, 0x4DFB5637, 0xC2109436, 0xFFFFFCCB,\n        0x3848984F, 0x909" +
@@ -124,17 +172,79 @@ const baseStrConvImplC = "" +
 	"xp10 > 0) {\n        if (exp10 > 22) {\n          if (exp10 > (15 + 22)) {\n            break;\n          }\n          // If exp10 is in the range 23 ..= 37, try moving a few of the zeroes\n          // from the exponent to the mantissa. If we're still under 1e15, we\n          // haven't truncated any mantissa bits.\n          if (exp10 > 22) {\n            d *= wuffs_base__private_implementation__f64_powers_of_10[exp10 -\n                                                                      22];\n            exp10 = 22;\n            if (d >= 1e15) {\n              break;\n            }\n          }\n        }\n        d *= wuffs_base__private_implementation__f64_powers_of_10[exp10];\n        wuffs_base__result_f64 ret;\n        ret.status.repr = NULL;\n        ret.value = h->negative ? -d : +d;\n        return ret;\n\n      } else {  // \"if (exp10 < 0)\" is effectively \"if (true)\" here.\n        if (exp10 < -22) {\n          break;\n        }\n        d /= wuffs_base__private_implementation__f64_powers_of_10[-exp10];\n        wuffs_bas" +
 	"e__result_f64 ret;\n        ret.status.repr = NULL;\n        ret.value = h->negative ? -d : +d;\n        return ret;\n      }\n    } while (0);\n\n    // Normalize (and scale the error).\n    error <<= wuffs_base__private_implementation__medium_prec_bin__normalize(m);\n\n    // Multiplying two MPB values nominally multiplies two mantissas, call them\n    // A and B, which are integer approximations to the precise values (A+a)\n    // and (B+b) for some error terms a and b.\n    //\n    // MPB multiplication calculates (((A+a) * (B+b)) >> 64) to be ((A*B) >>\n    // 64). Shifting (truncating) and rounding introduces further error. The\n    // difference between the calculated result:\n    //  ((A*B                  ) >> 64)\n    // and the true result:\n    //  ((A*B + A*b + a*B + a*b) >> 64)   + rounding_error\n    // is:\n    //  ((      A*b + a*B + a*b) >> 64)   + rounding_error\n    // which can be re-grouped as:\n    //  ((A*b) >> 64) + ((a*(B+b)) >> 64) + rounding_error\n    //\n    // Now, let A and a be \"m->mantissa\" and \"erro" +
 	"r\", and B and b be the\n    // pre-calculated power of 10. A and B are both less than (1 << 64), a is\n    // the \"error\" local variable and b is less than 1.\n    //\n    // An upper bound (in absolute value) on ((A*b) >> 64) is therefore 1.\n    //\n    // An upper bound on ((a*(B+b)) >> 64) is a, also known as error.\n    //\n    // Finally, the rounding_error is at most 1.\n    //\n    // In total, calling mpb__mul_pow_10 will raise the worst-case error by 2.\n    // The subsequent re-normalization can multiply that by a further factor.\n\n    // Multiply by small_powers_of_10[etc].\n    wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(\n        m, &wuffs_base__private_implementation__small_powers_of_10[3 * spo10]);\n    error += 2;\n    error <<= wuffs_base__private_implementation__medium_prec_bin__normalize(m);\n\n    // Multiply by big_powers_of_10[etc].\n    wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(\n        m, &wuffs_base__private_implementation__big_powers_of_10[3 * bpo10]);\n    err" +
-	"or += 2;\n    error <<= wuffs_base__private_implementation__medium_prec_bin__normalize(m);\n\n    // We have a good approximation of h, but we still have to check whether\n    // the error is small enough. Equivalently, whether the number of surplus\n    // mantissa bits (the bits dropped when going from m's 64 mantissa bits to\n    // the smaller number of double-precision mantissa bits) would always round\n    // up or down, even when perturbed by ±error. We start at 11 surplus bits\n    // (m has 64, double-precision has 1+52), but it can be higher for\n    // subnormals.\n    //\n    // In many cases, the error is small enough and we return true.\n    const int32_t f64_bias = -1023;\n    int32_t subnormal_exp2 = f64_bias - 63;\n    uint32_t surplus_bits = 11;\n    if (subnormal_exp2 >= m->exp2) {\n      surplus_bits += 1 + ((uint32_t)(subnormal_exp2 - m->exp2));\n    }\n\n    uint64_t surplus_mask =\n        (((uint64_t)1) << surplus_bits) - 1;  // e.g. 0x07FF.\n    uint64_t surplus = m->mantissa & surplus_mask;\n    uint64_t" +
-	" halfway = ((uint64_t)1) << (surplus_bits - 1);  // e.g. 0x0400.\n\n    // Do the final calculation in *signed* arithmetic.\n    int64_t i_surplus = (int64_t)surplus;\n    int64_t i_halfway = (int64_t)halfway;\n    int64_t i_error = (int64_t)error;\n\n    if ((i_surplus > (i_halfway - i_error)) &&\n        (i_surplus < (i_halfway + i_error))) {\n      goto fail;\n    }\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base__private_implementation__medium_prec_bin__as_f64(\n        m, h->negative);\n    return ret;\n  } while (0);\n\nfail:\n  do {\n    wuffs_base__result_f64 ret;\n    ret.status.repr = \"#base: mpb__parse_number_f64 failed\";\n    ret.value = 0;\n    return ret;\n  } while (0);\n}\n\n" +
+	"or += 2;\n    error <<= wuffs_base__private_implementation__medium_prec_bin__normalize(m);\n\n    // We have a good approximation of h, but we still have to check whether\n    // the error is small enough. Equivalently, whether the number of surplus\n    // mantissa bits (the bits dropped when going from m's 64 mantissa bits to\n    // the smaller number of double-precision mantissa bits) would always round\n    // up or down, even when perturbed by ±error. We start at 11 surplus bits\n    // (m has 64, double-precision has 1+52), but it can be higher for\n    // subnormals.\n    //\n    // In many cases, the error is small enough and we return true.\n    const int32_t f64_bias = -1023;\n    int32_t subnormal_exp2 = f64_bias - 63;\n    uint32_t surplus_bits = 11;\n    if (subnormal_exp2 >= m->exp2) {\n      surplus_bits += 1 + ((uint32_t)(subnormal_exp2 - m->exp2));\n    }\n    // Far enough below the smallest subnormal, every mantissa bit is a\n    // surplus bit. Leave that (round to zero or to the smallest subnormal)\n    //" +
+	" to the HPD code, instead of shifting a uint64_t by 64 or more.\n    if (surplus_bits > 63) {\n      goto fail;\n    }\n\n    uint64_t surplus_mask =\n        (((uint64_t)1) << surplus_bits) - 1;  // e.g. 0x07FF.\n    uint64_t surplus = m->mantissa & surplus_mask;\n    uint64_t halfway = ((uint64_t)1) << (surplus_bits - 1);  // e.g. 0x0400.\n\n    // Do the final calculation in *signed* arithmetic.\n    int64_t i_surplus = (int64_t)surplus;\n    int64_t i_halfway = (int64_t)halfway;\n    int64_t i_error = (int64_t)error;\n\n    if ((i_surplus > (i_halfway - i_error)) &&\n        (i_surplus < (i_halfway + i_error))) {\n      goto fail;\n    }\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base__private_implementation__medium_prec_bin__as_f64(\n        m, h->negative);\n    return ret;\n  } while (0);\n\nfail:\n  do {\n    wuffs_base__result_f64 ret;\n    ret.status.repr = \"#base: mpb__parse_number_f64 failed\";\n    ret.value = 0;\n    return ret;\n  } while (0);\n}\n\n" +
+	"" +
+	"// --------\n\n// The wuffs_base__private_implementation__powers_of_10 table was printed by\n// script/print-eisel-lemire-powers-of-10.go. That script has an optional\n// -comments flag, whose output is not copied here, which prints further\n// detail.\n//\n// This table is used in\n// wuffs_base__private_implementation__parse_number_f64_eisel_lemire.\n\n// wuffs_base__private_implementation__powers_of_10 contains truncated\n// approximations to the powers of 10, ranging from 1e-307 to 1e+288 inclusive,\n// as 596 pairs of uint64_t values (a 128-bit mantissa).\n//\n// Each pair is the (lo, hi) halves of a normalized (the 1<<127 bit is set)\n// 128-bit mantissa. The implied base-2 exponent is not stored, since it can be\n// calculated from the base-10 exponent: see the \"217706\" comment below.\n//\n// For example, the pair for 1e-1, (0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC),\n// means:\n//   1e-1 ≈ 0xCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC * (2 ** -131)\n// Similarly, the pair for 1e+1, (0x0000000000000000, 0xA000000000000000),\n// means:" +
+	"\n//   1e+1 ≈ 0xA0000000000000000000000000000000 * (2 ** -124)  // Exact.\nstatic const uint64_t\n    wuffs_base__private_implementation__powers_of_10[596][2] = {\n        {0xA5D3B6D479F8E056, 0x8FD0C16206306BAB},\n        {0x8F48A4899877186C, 0xB3C4F1BA87BC8696},\n        {0x331ACDABFE94DE87, 0xE0B62E2929ABA83C},\n        {0x9FF0C08B7F1D0B14, 0x8C71DCD9BA0B4925},\n        {0x07ECF0AE5EE44DD9, 0xAF8E5410288E1B6F},\n        {0xC9E82CD9F69D6150, 0xDB71E91432B1A24A},\n        {0xBE311C083A225CD2, 0x892731AC9FAF056E},\n        {0x6DBD630A48AAF406, 0xAB70FE17C79AC6CA},\n        {0x092CBBCCDAD5B108, 0xD64D3D9DB981787D},\n        {0x25BBF56008C58EA5, 0x85F0468293F0EB4E},\n        {0xAF2AF2B80AF6F24E, 0xA76C582338ED2621},\n        {0x1AF5AF660DB4AEE1, 0xD1476E2C07286FAA},\n        {0x50D98D9FC890ED4D, 0x82CCA4DB847945CA},\n        {0xE50FF107BAB528A0, 0xA37FCE126597973C},\n        {0x1E53ED49A96272C8, 0xCC5FC196FEFD7D0C},\n        {0x25E8E89C13BB0F7A, 0xFF77B1FCBEBCDC4F},\n        {0x77B191618C54E9AC, 0x9FAACF3DF73609B1},\n        {0xD" +
+	"59DF5B9EF6A2417, 0xC795830D75038C1D},\n        {0x4B0573286B44AD1D, 0xF97AE3D0D2446F25},\n        {0x4EE367F9430AEC32, 0x9BECCE62836AC577},\n        {0x229C41F793CDA73F, 0xC2E801FB244576D5},\n        {0x6B43527578C1110F, 0xF3A20279ED56D48A},\n        {0x830A13896B78AAA9, 0x9845418C345644D6},\n        {0x23CC986BC656D553, 0xBE5691EF416BD60C},\n        {0x2CBFBE86B7EC8AA8, 0xEDEC366B11C6CB8F},\n        {0x7BF7D71432F3D6A9, 0x94B3A202EB1C3F39},\n        {0xDAF5CCD93FB0CC53, 0xB9E08A83A5E34F07},\n        {0xD1B3400F8F9CFF68, 0xE858AD248F5C22C9},\n        {0x23100809B9C21FA1, 0x91376C36D99995BE},\n        {0xABD40A0C2832A78A, 0xB58547448FFFFB2D},\n        {0x16C90C8F323F516C, 0xE2E69915B3FFF9F9},\n        {0xAE3DA7D97F6792E3, 0x8DD01FAD907FFC3B},\n        {0x99CD11CFDF41779C, 0xB1442798F49FFB4A},\n        {0x40405643D711D583, 0xDD95317F31C7FA1D},\n        {0x482835EA666B2572, 0x8A7D3EEF7F1CFC52},\n        {0xDA3243650005EECF, 0xAD1C8EAB5EE43B66},\n        {0x90BED43E40076A82, 0xD863B256369D4A40},\n        {0x5A7744A6E804A291, 0x873E4" +
+	"F75E2224E68},\n        {0x711515D0A205CB36, 0xA90DE3535AAAE202},\n        {0x0D5A5B44CA873E03, 0xD3515C2831559A83},\n        {0xE858790AFE9486C2, 0x8412D9991ED58091},\n        {0x626E974DBE39A872, 0xA5178FFF668AE0B6},\n        {0xFB0A3D212DC8128F, 0xCE5D73FF402D98E3},\n        {0x7CE66634BC9D0B99, 0x80FA687F881C7F8E},\n        {0x1C1FFFC1EBC44E80, 0xA139029F6A239F72},\n        {0xA327FFB266B56220, 0xC987434744AC874E},\n        {0x4BF1FF9F0062BAA8, 0xFBE9141915D7A922},\n        {0x6F773FC3603DB4A9, 0x9D71AC8FADA6C9B5},\n        {0xCB550FB4384D21D3, 0xC4CE17B399107C22},\n        {0x7E2A53A146606A48, 0xF6019DA07F549B2B},\n        {0x2EDA7444CBFC426D, 0x99C102844F94E0FB},\n        {0xFA911155FEFB5308, 0xC0314325637A1939},\n        {0x793555AB7EBA27CA, 0xF03D93EEBC589F88},\n        {0x4BC1558B2F3458DE, 0x96267C7535B763B5},\n        {0x9EB1AAEDFB016F16, 0xBBB01B9283253CA2},\n        {0x465E15A979C1CADC, 0xEA9C227723EE8BCB},\n        {0x0BFACD89EC191EC9, 0x92A1958A7675175F},\n        {0xCEF980EC671F667B, 0xB749FAED14125D36},\n        {0" +
+	"x82B7E12780E7401A, 0xE51C79A85916F484},\n        {0xD1B2ECB8B0908810, 0x8F31CC0937AE58D2},\n        {0x861FA7E6DCB4AA15, 0xB2FE3F0B8599EF07},\n        {0x67A791E093E1D49A, 0xDFBDCECE67006AC9},\n        {0xE0C8BB2C5C6D24E0, 0x8BD6A141006042BD},\n        {0x58FAE9F773886E18, 0xAECC49914078536D},\n        {0xAF39A475506A899E, 0xDA7F5BF590966848},\n        {0x6D8406C952429603, 0x888F99797A5E012D},\n        {0xC8E5087BA6D33B83, 0xAAB37FD7D8F58178},\n        {0xFB1E4A9A90880A64, 0xD5605FCDCF32E1D6},\n        {0x5CF2EEA09A55067F, 0x855C3BE0A17FCD26},\n        {0xF42FAA48C0EA481E, 0xA6B34AD8C9DFC06F},\n        {0xF13B94DAF124DA26, 0xD0601D8EFC57B08B},\n        {0x76C53D08D6B70858, 0x823C12795DB6CE57},\n        {0x54768C4B0C64CA6E, 0xA2CB1717B52481ED},\n        {0xA9942F5DCF7DFD09, 0xCB7DDCDDA26DA268},\n        {0xD3F93B35435D7C4C, 0xFE5D54150B090B02},\n        {0xC47BC5014A1A6DAF, 0x9EFA548D26E5A6E1},\n        {0x359AB6419CA1091B, 0xC6B8E9B0709F109A},\n        {0xC30163D203C94B62, 0xF867241C8CC6D4C0},\n        {0x79E0DE63425DCF1D, 0x9B4" +
+	"07691D7FC44F8},\n        {0x985915FC12F542E4, 0xC21094364DFB5636},\n        {0x3E6F5B7B17B2939D, 0xF294B943E17A2BC4},\n        {0xA705992CEECF9C42, 0x979CF3CA6CEC5B5A},\n        {0x50C6FF782A838353, 0xBD8430BD08277231},\n        {0xA4F8BF5635246428, 0xECE53CEC4A314EBD},\n        {0x871B7795E136BE99, 0x940F4613AE5ED136},\n        {0x28E2557B59846E3F, 0xB913179899F68584},\n        {0x331AEADA2FE589CF, 0xE757DD7EC07426E5},\n        {0x3FF0D2C85DEF7621, 0x9096EA6F3848984F},\n        {0x0FED077A756B53A9, 0xB4BCA50B065ABE63},\n        {0xD3E8495912C62894, 0xE1EBCE4DC7F16DFB},\n        {0x64712DD7ABBBD95C, 0x8D3360F09CF6E4BD},\n        {0xBD8D794D96AACFB3, 0xB080392CC4349DEC},\n        {0xECF0D7A0FC5583A0, 0xDCA04777F541C567},\n        {0xF41686C49DB57244, 0x89E42CAAF9491B60},\n        {0x311C2875C522CED5, 0xAC5D37D5B79B6239},\n        {0x7D633293366B828B, 0xD77485CB25823AC7},\n        {0xAE5DFF9C02033197, 0x86A8D39EF77164BC},\n        {0xD9F57F830283FDFC, 0xA8530886B54DBDEB},\n        {0xD072DF63C324FD7B, 0xD267CAA862A12D66},\n        " +
+	"{0x4247CB9E59F71E6D, 0x8380DEA93DA4BC60},\n        {0x52D9BE85F074E608, 0xA46116538D0DEB78},\n        {0x67902E276C921F8B, 0xCD795BE870516656},\n        {0x00BA1CD8A3DB53B6, 0x806BD9714632DFF6},\n        {0x80E8A40ECCD228A4, 0xA086CFCD97BF97F3},\n        {0x6122CD128006B2CD, 0xC8A883C0FDAF7DF0},\n        {0x796B805720085F81, 0xFAD2A4B13D1B5D6C},\n        {0xCBE3303674053BB0, 0x9CC3A6EEC6311A63},\n        {0xBEDBFC4411068A9C, 0xC3F490AA77BD60FC},\n        {0xEE92FB5515482D44, 0xF4F1B4D515ACB93B},\n        {0x751BDD152D4D1C4A, 0x991711052D8BF3C5},\n        {0xD262D45A78A0635D, 0xBF5CD54678EEF0B6},\n        {0x86FB897116C87C34, 0xEF340A98172AACE4},\n        {0xD45D35E6AE3D4DA0, 0x9580869F0E7AAC0E},\n        {0x8974836059CCA109, 0xBAE0A846D2195712},\n        {0x2BD1A438703FC94B, 0xE998D258869FACD7},\n        {0x7B6306A34627DDCF, 0x91FF83775423CC06},\n        {0x1A3BC84C17B1D542, 0xB67F6455292CBF08},\n        {0x20CABA5F1D9E4A93, 0xE41F3D6A7377EECA},\n        {0x547EB47B7282EE9C, 0x8E938662882AF53E},\n        {0xE99E619A4F23AA43, 0xB" +
+	"23867FB2A35B28D},\n        {0x6405FA00E2EC94D4, 0xDEC681F9F4C31F31},\n        {0xDE83BC408DD3DD04, 0x8B3C113C38F9F37E},\n        {0x9624AB50B148D445, 0xAE0B158B4738705E},\n        {0x3BADD624DD9B0957, 0xD98DDAEE19068C76},\n        {0xE54CA5D70A80E5D6, 0x87F8A8D4CFA417C9},\n        {0x5E9FCF4CCD211F4C, 0xA9F6D30A038D1DBC},\n        {0x7647C3200069671F, 0xD47487CC8470652B},\n        {0x29ECD9F40041E073, 0x84C8D4DFD2C63F3B},\n        {0xF468107100525890, 0xA5FB0A17C777CF09},\n        {0x7182148D4066EEB4, 0xCF79CC9DB955C2CC},\n        {0xC6F14CD848405530, 0x81AC1FE293D599BF},\n        {0xB8ADA00E5A506A7C, 0xA21727DB38CB002F},\n        {0xA6D90811F0E4851C, 0xCA9CF1D206FDC03B},\n        {0x908F4A166D1DA663, 0xFD442E4688BD304A},\n        {0x9A598E4E043287FE, 0x9E4A9CEC15763E2E},\n        {0x40EFF1E1853F29FD, 0xC5DD44271AD3CDBA},\n        {0xD12BEE59E68EF47C, 0xF7549530E188C128},\n        {0x82BB74F8301958CE, 0x9A94DD3E8CF578B9},\n        {0xE36A52363C1FAF01, 0xC13A148E3032D6E7},\n        {0xDC44E6C3CB279AC1, 0xF18899B1BC3F8CA1},\n      " +
+	"  {0x29AB103A5EF8C0B9, 0x96F5600F15A7B7E5},\n        {0x7415D448F6B6F0E7, 0xBCB2B812DB11A5DE},\n        {0x111B495B3464AD21, 0xEBDF661791D60F56},\n        {0xCAB10DD900BEEC34, 0x936B9FCEBB25C995},\n        {0x3D5D514F40EEA742, 0xB84687C269EF3BFB},\n        {0x0CB4A5A3112A5112, 0xE65829B3046B0AFA},\n        {0x47F0E785EABA72AB, 0x8FF71A0FE2C2E6DC},\n        {0x59ED216765690F56, 0xB3F4E093DB73A093},\n        {0x306869C13EC3532C, 0xE0F218B8D25088B8},\n        {0x1E414218C73A13FB, 0x8C974F7383725573},\n        {0xE5D1929EF90898FA, 0xAFBD2350644EEACF},\n        {0xDF45F746B74ABF39, 0xDBAC6C247D62A583},\n        {0x6B8BBA8C328EB783, 0x894BC396CE5DA772},\n        {0x066EA92F3F326564, 0xAB9EB47C81F5114F},\n        {0xC80A537B0EFEFEBD, 0xD686619BA27255A2},\n        {0xBD06742CE95F5F36, 0x8613FD0145877585},\n        {0x2C48113823B73704, 0xA798FC4196E952E7},\n        {0xF75A15862CA504C5, 0xD17F3B51FCA3A7A0},\n        {0x9A984D73DBE722FB, 0x82EF85133DE648C4},\n        {0xC13E60D0D2E0EBBA, 0xA3AB66580D5FDAF5},\n        {0x318DF905079926A8, 0" +
+	"xCC963FEE10B7D1B3},\n        {0xFDF17746497F7052, 0xFFBBCFE994E5C61F},\n        {0xFEB6EA8BEDEFA633, 0x9FD561F1FD0F9BD3},\n        {0xFE64A52EE96B8FC0, 0xC7CABA6E7C5382C8},\n        {0x3DFDCE7AA3C673B0, 0xF9BD690A1B68637B},\n        {0x06BEA10CA65C084E, 0x9C1661A651213E2D},\n        {0x486E494FCFF30A62, 0xC31BFA0FE5698DB8},\n        {0x5A89DBA3C3EFCCFA, 0xF3E2F893DEC3F126},\n        {0xF89629465A75E01C, 0x986DDB5C6B3A76B7},\n        {0xF6BBB397F1135823, 0xBE89523386091465},\n        {0x746AA07DED582E2C, 0xEE2BA6C0678B597F},\n        {0xA8C2A44EB4571CDC, 0x94DB483840B717EF},\n        {0x92F34D62616CE413, 0xBA121A4650E4DDEB},\n        {0x77B020BAF9C81D17, 0xE896A0D7E51E1566},\n        {0x0ACE1474DC1D122E, 0x915E2486EF32CD60},\n        {0x0D819992132456BA, 0xB5B5ADA8AAFF80B8},\n        {0x10E1FFF697ED6C69, 0xE3231912D5BF60E6},\n        {0xCA8D3FFA1EF463C1, 0x8DF5EFABC5979C8F},\n        {0xBD308FF8A6B17CB2, 0xB1736B96B6FD83B3},\n        {0xAC7CB3F6D05DDBDE, 0xDDD0467C64BCE4A0},\n        {0x6BCDF07A423AA96B, 0x8AA22C0DBEF60EE4},\n    " +
+	"    {0x86C16C98D2C953C6, 0xAD4AB7112EB3929D},\n        {0xE871C7BF077BA8B7, 0xD89D64D57A607744},\n        {0x11471CD764AD4972, 0x87625F056C7C4A8B},\n        {0xD598E40D3DD89BCF, 0xA93AF6C6C79B5D2D},\n        {0x4AFF1D108D4EC2C3, 0xD389B47879823479},\n        {0xCEDF722A585139BA, 0x843610CB4BF160CB},\n        {0xC2974EB4EE658828, 0xA54394FE1EEDB8FE},\n        {0x733D226229FEEA32, 0xCE947A3DA6A9273E},\n        {0x0806357D5A3F525F, 0x811CCC668829B887},\n        {0xCA07C2DCB0CF26F7, 0xA163FF802A3426A8},\n        {0xFC89B393DD02F0B5, 0xC9BCFF6034C13052},\n        {0xBBAC2078D443ACE2, 0xFC2C3F3841F17C67},\n        {0xD54B944B84AA4C0D, 0x9D9BA7832936EDC0},\n        {0x0A9E795E65D4DF11, 0xC5029163F384A931},\n        {0x4D4617B5FF4A16D5, 0xF64335BCF065D37D},\n        {0x504BCED1BF8E4E45, 0x99EA0196163FA42E},\n        {0xE45EC2862F71E1D6, 0xC06481FB9BCF8D39},\n        {0x5D767327BB4E5A4C, 0xF07DA27A82C37088},\n        {0x3A6A07F8D510F86F, 0x964E858C91BA2655},\n        {0x890489F70A55368B, 0xBBE226EFB628AFEA},\n        {0x2B45AC74CCEA842E," +
+	" 0xEADAB0ABA3B2DBE5},\n        {0x3B0B8BC90012929D, 0x92C8AE6B464FC96F},\n        {0x09CE6EBB40173744, 0xB77ADA0617E3BBCB},\n        {0xCC420A6A101D0515, 0xE55990879DDCAABD},\n        {0x9FA946824A12232D, 0x8F57FA54C2A9EAB6},\n        {0x47939822DC96ABF9, 0xB32DF8E9F3546564},\n        {0x59787E2B93BC56F7, 0xDFF9772470297EBD},\n        {0x57EB4EDB3C55B65A, 0x8BFBEA76C619EF36},\n        {0xEDE622920B6B23F1, 0xAEFAE51477A06B03},\n        {0xE95FAB368E45ECED, 0xDAB99E59958885C4},\n        {0x11DBCB0218EBB414, 0x88B402F7FD75539B},\n        {0xD652BDC29F26A119, 0xAAE103B5FCD2A881},\n        {0x4BE76D3346F0495F, 0xD59944A37C0752A2},\n        {0x6F70A4400C562DDB, 0x857FCAE62D8493A5},\n        {0xCB4CCD500F6BB952, 0xA6DFBD9FB8E5B88E},\n        {0x7E2000A41346A7A7, 0xD097AD07A71F26B2},\n        {0x8ED400668C0C28C8, 0x825ECC24C873782F},\n        {0x728900802F0F32FA, 0xA2F67F2DFA90563B},\n        {0x4F2B40A03AD2FFB9, 0xCBB41EF979346BCA},\n        {0xE2F610C84987BFA8, 0xFEA126B7D78186BC},\n        {0x0DD9CA7D2DF4D7C9, 0x9F24B832E6B0F436},\n  " +
+	"      {0x91503D1C79720DBB, 0xC6EDE63FA05D3143},\n        {0x75A44C6397CE912A, 0xF8A95FCF88747D94},\n        {0xC986AFBE3EE11ABA, 0x9B69DBE1B548CE7C},\n        {0xFBE85BADCE996168, 0xC24452DA229B021B},\n        {0xFAE27299423FB9C3, 0xF2D56790AB41C2A2},\n        {0xDCCD879FC967D41A, 0x97C560BA6B0919A5},\n        {0x5400E987BBC1C920, 0xBDB6B8E905CB600F},\n        {0x290123E9AAB23B68, 0xED246723473E3813},\n        {0xF9A0B6720AAF6521, 0x9436C0760C86E30B},\n        {0xF808E40E8D5B3E69, 0xB94470938FA89BCE},\n        {0xB60B1D1230B20E04, 0xE7958CB87392C2C2},\n        {0xB1C6F22B5E6F48C2, 0x90BD77F3483BB9B9},\n        {0x1E38AEB6360B1AF3, 0xB4ECD5F01A4AA828},\n        {0x25C6DA63C38DE1B0, 0xE2280B6C20DD5232},\n        {0x579C487E5A38AD0E, 0x8D590723948A535F},\n        {0x2D835A9DF0C6D851, 0xB0AF48EC79ACE837},\n        {0xF8E431456CF88E65, 0xDCDB1B2798182244},\n        {0x1B8E9ECB641B58FF, 0x8A08F0F8BF0F156B},\n        {0xE272467E3D222F3F, 0xAC8B2D36EED2DAC5},\n        {0x5B0ED81DCC6ABB0F, 0xD7ADF884AA879177},\n        {0x98E947129FC2B4E" +
+	"9, 0x86CCBB52EA94BAEA},\n        {0x3F2398D747B36224, 0xA87FEA27A539E9A5},\n        {0x8EEC7F0D19A03AAD, 0xD29FE4B18E88640E},\n        {0x1953CF68300424AC, 0x83A3EEEEF9153E89},\n        {0x5FA8C3423C052DD7, 0xA48CEAAAB75A8E2B},\n        {0x3792F412CB06794D, 0xCDB02555653131B6},\n        {0xE2BBD88BBEE40BD0, 0x808E17555F3EBF11},\n        {0x5B6ACEAEAE9D0EC4, 0xA0B19D2AB70E6ED6},\n        {0xF245825A5A445275, 0xC8DE047564D20A8B},\n        {0xEED6E2F0F0D56712, 0xFB158592BE068D2E},\n        {0x55464DD69685606B, 0x9CED737BB6C4183D},\n        {0xAA97E14C3C26B886, 0xC428D05AA4751E4C},\n        {0xD53DD99F4B3066A8, 0xF53304714D9265DF},\n        {0xE546A8038EFE4029, 0x993FE2C6D07B7FAB},\n        {0xDE98520472BDD033, 0xBF8FDB78849A5F96},\n        {0x963E66858F6D4440, 0xEF73D256A5C0F77C},\n        {0xDDE7001379A44AA8, 0x95A8637627989AAD},\n        {0x5560C018580D5D52, 0xBB127C53B17EC159},\n        {0xAAB8F01E6E10B4A6, 0xE9D71B689DDE71AF},\n        {0xCAB3961304CA70E8, 0x9226712162AB070D},\n        {0x3D607B97C5FD0D22, 0xB6B00D69BB55C8D1},\n" +
+	"        {0x8CB89A7DB77C506A, 0xE45C10C42A2B3B05},\n        {0x77F3608E92ADB242, 0x8EB98A7A9A5B04E3},\n        {0x55F038B237591ED3, 0xB267ED1940F1C61C},\n        {0x6B6C46DEC52F6688, 0xDF01E85F912E37A3},\n        {0x2323AC4B3B3DA015, 0x8B61313BBABCE2C6},\n        {0xABEC975E0A0D081A, 0xAE397D8AA96C1B77},\n        {0x96E7BD358C904A21, 0xD9C7DCED53C72255},\n        {0x7E50D64177DA2E54, 0x881CEA14545C7575},\n        {0xDDE50BD1D5D0B9E9, 0xAA242499697392D2},\n        {0x955E4EC64B44E864, 0xD4AD2DBFC3D07787},\n        {0xBD5AF13BEF0B113E, 0x84EC3C97DA624AB4},\n        {0xECB1AD8AEACDD58E, 0xA6274BBDD0FADD61},\n        {0x67DE18EDA5814AF2, 0xCFB11EAD453994BA},\n        {0x80EACF948770CED7, 0x81CEB32C4B43FCF4},\n        {0xA1258379A94D028D, 0xA2425FF75E14FC31},\n        {0x096EE45813A04330, 0xCAD2F7F5359A3B3E},\n        {0x8BCA9D6E188853FC, 0xFD87B5F28300CA0D},\n        {0x775EA264CF55347D, 0x9E74D1B791E07E48},\n        {0x95364AFE032A819D, 0xC612062576589DDA},\n        {0x3A83DDBD83F52204, 0xF79687AED3EEC551},\n        {0xC4926A9672793" +
+	"542, 0x9ABE14CD44753B52},\n        {0x75B7053C0F178293, 0xC16D9A0095928A27},\n        {0x5324C68B12DD6338, 0xF1C90080BAF72CB1},\n        {0xD3F6FC16EBCA5E03, 0x971DA05074DA7BEE},\n        {0x88F4BB1CA6BCF584, 0xBCE5086492111AEA},\n        {0x2B31E9E3D06C32E5, 0xEC1E4A7DB69561A5},\n        {0x3AFF322E62439FCF, 0x9392EE8E921D5D07},\n        {0x09BEFEB9FAD487C2, 0xB877AA3236A4B449},\n        {0x4C2EBE687989A9B3, 0xE69594BEC44DE15B},\n        {0x0F9D37014BF60A10, 0x901D7CF73AB0ACD9},\n        {0x538484C19EF38C94, 0xB424DC35095CD80F},\n        {0x2865A5F206B06FB9, 0xE12E13424BB40E13},\n        {0xF93F87B7442E45D3, 0x8CBCCC096F5088CB},\n        {0xF78F69A51539D748, 0xAFEBFF0BCB24AAFE},\n        {0xB573440E5A884D1B, 0xDBE6FECEBDEDD5BE},\n        {0x31680A88F8953030, 0x89705F4136B4A597},\n        {0xFDC20D2B36BA7C3D, 0xABCC77118461CEFC},\n        {0x3D32907604691B4C, 0xD6BF94D5E57A42BC},\n        {0xA63F9A49C2C1B10F, 0x8637BD05AF6C69B5},\n        {0x0FCF80DC33721D53, 0xA7C5AC471B478423},\n        {0xD3C36113404EA4A8, 0xD1B71758E219652B}" +
+	",\n        {0x645A1CAC083126E9, 0x83126E978D4FDF3B},\n        {0x3D70A3D70A3D70A3, 0xA3D70A3D70A3D70A},\n        {0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC},\n        {0x0000000000000000, 0x8000000000000000},\n        {0x0000000000000000, 0xA000000000000000},\n        {0x0000000000000000, 0xC800000000000000},\n        {0x0000000000000000, 0xFA00000000000000},\n        {0x0000000000000000, 0x9C40000000000000},\n        {0x0000000000000000, 0xC350000000000000},\n        {0x0000000000000000, 0xF424000000000000},\n        {0x0000000000000000, 0x9896800000000000},\n        {0x0000000000000000, 0xBEBC200000000000},\n        {0x0000000000000000, 0xEE6B280000000000},\n        {0x0000000000000000, 0x9502F90000000000},\n        {0x0000000000000000, 0xBA43B74000000000},\n        {0x0000000000000000, 0xE8D4A51000000000},\n        {0x0000000000000000, 0x9184E72A00000000},\n        {0x0000000000000000, 0xB5E620F480000000},\n        {0x0000000000000000, 0xE35FA931A0000000},\n        {0x0000000000000000, 0x8E1BC9BF04000000},\n        {0x00000000000" +
+	"00000, 0xB1A2BC2EC5000000},\n        {0x0000000000000000, 0xDE0B6B3A76400000},\n        {0x0000000000000000, 0x8AC7230489E80000},\n        {0x0000000000000000, 0xAD78EBC5AC620000},\n        {0x0000000000000000, 0xD8D726B7177A8000},\n        {0x0000000000000000, 0x878678326EAC9000},\n        {0x0000000000000000, 0xA968163F0A57B400},\n        {0x0000000000000000, 0xD3C21BCECCEDA100},\n        {0x0000000000000000, 0x84595161401484A0},\n        {0x0000000000000000, 0xA56FA5B99019A5C8},\n        {0x0000000000000000, 0xCECB8F27F4200F3A},\n        {0x4000000000000000, 0x813F3978F8940984},\n        {0x5000000000000000, 0xA18F07D736B90BE5},\n        {0xA400000000000000, 0xC9F2C9CD04674EDE},\n        {0x4D00000000000000, 0xFC6F7C4045812296},\n        {0xF020000000000000, 0x9DC5ADA82B70B59D},\n        {0x6C28000000000000, 0xC5371912364CE305},\n        {0xC732000000000000, 0xF684DF56C3E01BC6},\n        {0x3C7F400000000000, 0x9A130B963A6C115C},\n        {0x4B9F100000000000, 0xC097CE7BC90715B3},\n        {0x1E86D40000000000, 0xF0BDC21ABB48DB2" +
+	"0},\n        {0x1314448000000000, 0x96769950B50D88F4},\n        {0x17D955A000000000, 0xBC143FA4E250EB31},\n        {0x5DCFAB0800000000, 0xEB194F8E1AE525FD},\n        {0x5AA1CAE500000000, 0x92EFD1B8D0CF37BE},\n        {0xF14A3D9E40000000, 0xB7ABC627050305AD},\n        {0x6D9CCD05D0000000, 0xE596B7B0C643C719},\n        {0xE4820023A2000000, 0x8F7E32CE7BEA5C6F},\n        {0xDDA2802C8A800000, 0xB35DBF821AE4F38B},\n        {0xD50B2037AD200000, 0xE0352F62A19E306E},\n        {0x4526F422CC340000, 0x8C213D9DA502DE45},\n        {0x9670B12B7F410000, 0xAF298D050E4395D6},\n        {0x3C0CDD765F114000, 0xDAF3F04651D47B4C},\n        {0xA5880A69FB6AC800, 0x88D8762BF324CD0F},\n        {0x8EEA0D047A457A00, 0xAB0E93B6EFEE0053},\n        {0x72A4904598D6D880, 0xD5D238A4ABE98068},\n        {0x47A6DA2B7F864750, 0x85A36366EB71F041},\n        {0x999090B65F67D924, 0xA70C3C40A64E6C51},\n        {0xFFF4B4E3F741CF6D, 0xD0CF4B50CFE20765},\n        {0xBFF8F10E7A8921A4, 0x82818F1281ED449F},\n        {0xAFF72D52192B6A0D, 0xA321F2D7226895C7},\n        {0x9BF4F8A69" +
+	"F764490, 0xCBEA6F8CEB02BB39},\n        {0x02F236D04753D5B4, 0xFEE50B7025C36A08},\n        {0x01D762422C946590, 0x9F4F2726179A2245},\n        {0x424D3AD2B7B97EF5, 0xC722F0EF9D80AAD6},\n        {0xD2E0898765A7DEB2, 0xF8EBAD2B84E0D58B},\n        {0x63CC55F49F88EB2F, 0x9B934C3B330C8577},\n        {0x3CBF6B71C76B25FB, 0xC2781F49FFCFA6D5},\n        {0x8BEF464E3945EF7A, 0xF316271C7FC3908A},\n        {0x97758BF0E3CBB5AC, 0x97EDD871CFDA3A56},\n        {0x3D52EEED1CBEA317, 0xBDE94E8E43D0C8EC},\n        {0x4CA7AAA863EE4BDD, 0xED63A231D4C4FB27},\n        {0x8FE8CAA93E74EF6A, 0x945E455F24FB1CF8},\n        {0xB3E2FD538E122B44, 0xB975D6B6EE39E436},\n        {0x60DBBCA87196B616, 0xE7D34C64A9C85D44},\n        {0xBC8955E946FE31CD, 0x90E40FBEEA1D3A4A},\n        {0x6BABAB6398BDBE41, 0xB51D13AEA4A488DD},\n        {0xC696963C7EED2DD1, 0xE264589A4DCDAB14},\n        {0xFC1E1DE5CF543CA2, 0x8D7EB76070A08AEC},\n        {0x3B25A55F43294BCB, 0xB0DE65388CC8ADA8},\n        {0x49EF0EB713F39EBE, 0xDD15FE86AFFAD912},\n        {0x6E3569326C784337, 0x8A2DBF142DFCC" +
+	"7AB},\n        {0x49C2C37F07965404, 0xACB92ED9397BF996},\n        {0xDC33745EC97BE906, 0xD7E77A8F87DAF7FB},\n        {0x69A028BB3DED71A3, 0x86F0AC99B4E8DAFD},\n        {0xC40832EA0D68CE0C, 0xA8ACD7C0222311BC},\n        {0xF50A3FA490C30190, 0xD2D80DB02AABD62B},\n        {0x792667C6DA79E0FA, 0x83C7088E1AAB65DB},\n        {0x577001B891185938, 0xA4B8CAB1A1563F52},\n        {0xED4C0226B55E6F86, 0xCDE6FD5E09ABCF26},\n        {0x544F8158315B05B4, 0x80B05E5AC60B6178},\n        {0x696361AE3DB1C721, 0xA0DC75F1778E39D6},\n        {0x03BC3A19CD1E38E9, 0xC913936DD571C84C},\n        {0x04AB48A04065C723, 0xFB5878494ACE3A5F},\n        {0x62EB0D64283F9C76, 0x9D174B2DCEC0E47B},\n        {0x3BA5D0BD324F8394, 0xC45D1DF942711D9A},\n        {0xCA8F44EC7EE36479, 0xF5746577930D6500},\n        {0x7E998B13CF4E1ECB, 0x9968BF6ABBE85F20},\n        {0x9E3FEDD8C321A67E, 0xBFC2EF456AE276E8},\n        {0xC5CFE94EF3EA101E, 0xEFB3AB16C59B14A2},\n        {0xBBA1F1D158724A12, 0x95D04AEE3B80ECE5},\n        {0x2A8A6E45AE8EDC97, 0xBB445DA9CA61281F},\n        {0xF52D09D" +
+	"71A3293BD, 0xEA1575143CF97226},\n        {0x593C2626705F9C56, 0x924D692CA61BE758},\n        {0x6F8B2FB00C77836C, 0xB6E0C377CFA2E12E},\n        {0x0B6DFB9C0F956447, 0xE498F455C38B997A},\n        {0x4724BD4189BD5EAC, 0x8EDF98B59A373FEC},\n        {0x58EDEC91EC2CB657, 0xB2977EE300C50FE7},\n        {0x2F2967B66737E3ED, 0xDF3D5E9BC0F653E1},\n        {0xBD79E0D20082EE74, 0x8B865B215899F46C},\n        {0xECD8590680A3AA11, 0xAE67F1E9AEC07187},\n        {0xE80E6F4820CC9495, 0xDA01EE641A708DE9},\n        {0x3109058D147FDCDD, 0x884134FE908658B2},\n        {0xBD4B46F0599FD415, 0xAA51823E34A7EEDE},\n        {0x6C9E18AC7007C91A, 0xD4E5E2CDC1D1EA96},\n        {0x03E2CF6BC604DDB0, 0x850FADC09923329E},\n        {0x84DB8346B786151C, 0xA6539930BF6BFF45},\n        {0xE612641865679A63, 0xCFE87F7CEF46FF16},\n        {0x4FCB7E8F3F60C07E, 0x81F14FAE158C5F6E},\n        {0xE3BE5E330F38F09D, 0xA26DA3999AEF7749},\n        {0x5CADF5BFD3072CC5, 0xCB090C8001AB551C},\n        {0x73D9732FC7C8F7F6, 0xFDCB4FA002162A63},\n        {0x2867E7FDDCDD9AFA, 0x9E9F11C4014" +
+	"DDA7E},\n        {0xB281E1FD541501B8, 0xC646D63501A1511D},\n        {0x1F225A7CA91A4226, 0xF7D88BC24209A565},\n        {0x3375788DE9B06958, 0x9AE757596946075F},\n        {0x0052D6B1641C83AE, 0xC1A12D2FC3978937},\n        {0xC0678C5DBD23A49A, 0xF209787BB47D6B84},\n        {0xF840B7BA963646E0, 0x9745EB4D50CE6332},\n        {0xB650E5A93BC3D898, 0xBD176620A501FBFF},\n        {0xA3E51F138AB4CEBE, 0xEC5D3FA8CE427AFF},\n        {0xC66F336C36B10137, 0x93BA47C980E98CDF},\n        {0xB80B0047445D4184, 0xB8A8D9BBE123F017},\n        {0xA60DC059157491E5, 0xE6D3102AD96CEC1D},\n        {0x87C89837AD68DB2F, 0x9043EA1AC7E41392},\n        {0x29BABE4598C311FB, 0xB454E4A179DD1877},\n        {0xF4296DD6FEF3D67A, 0xE16A1DC9D8545E94},\n        {0x1899E4A65F58660C, 0x8CE2529E2734BB1D},\n        {0x5EC05DCFF72E7F8F, 0xB01AE745B101E9E4},\n        {0x76707543F4FA1F73, 0xDC21A1171D42645D},\n        {0x6A06494A791C53A8, 0x899504AE72497EBA},\n        {0x0487DB9D17636892, 0xABFA45DA0EDBDE69},\n        {0x45A9D2845D3C42B6, 0xD6F8D7509292D603},\n        {0x0B8A2" +
+	"392BA45A9B2, 0x865B86925B9BC5C2},\n        {0x8E6CAC7768D7141E, 0xA7F26836F282B732},\n        {0x3207D795430CD926, 0xD1EF0244AF2364FF},\n        {0x7F44E6BD49E807B8, 0x8335616AED761F1F},\n        {0x5F16206C9C6209A6, 0xA402B9C5A8D3A6E7},\n        {0x36DBA887C37A8C0F, 0xCD036837130890A1},\n        {0xC2494954DA2C9789, 0x802221226BE55A64},\n        {0xF2DB9BAA10B7BD6C, 0xA02AA96B06DEB0FD},\n        {0x6F92829494E5ACC7, 0xC83553C5C8965D3D},\n        {0xCB772339BA1F17F9, 0xFA42A8B73ABBF48C},\n        {0xFF2A760414536EFB, 0x9C69A97284B578D7},\n        {0xFEF5138519684ABA, 0xC38413CF25E2D70D},\n        {0x7EB258665FC25D69, 0xF46518C2EF5B8CD1},\n        {0xEF2F773FFBD97A61, 0x98BF2F79D5993802},\n        {0xAAFB550FFACFD8FA, 0xBEEEFB584AFF8603},\n        {0x95BA2A53F983CF38, 0xEEAABA2E5DBF6784},\n        {0xDD945A747BF26183, 0x952AB45CFA97A0B2},\n        {0x94F971119AEEF9E4, 0xBA756174393D88DF},\n        {0x7A37CD5601AAB85D, 0xE912B9D1478CEB17},\n        {0xAC62E055C10AB33A, 0x91ABB422CCB812EE},\n        {0x577B986B314D6009, 0xB616A12B7" +
+	"FE617AA},\n        {0xED5A7E85FDA0B80B, 0xE39C49765FDF9D94},\n        {0x14588F13BE847307, 0x8E41ADE9FBEBC27D},\n        {0x596EB2D8AE258FC8, 0xB1D219647AE6B31C},\n        {0x6FCA5F8ED9AEF3BB, 0xDE469FBD99A05FE3},\n        {0x25DE7BB9480D5854, 0x8AEC23D680043BEE},\n        {0xAF561AA79A10AE6A, 0xADA72CCC20054AE9},\n        {0x1B2BA1518094DA04, 0xD910F7FF28069DA4},\n        {0x90FB44D2F05D0842, 0x87AA9AFF79042286},\n        {0x353A1607AC744A53, 0xA99541BF57452B28},\n        {0x42889B8997915CE8, 0xD3FA922F2D1675F2},\n        {0x69956135FEBADA11, 0x847C9B5D7C2E09B7},\n        {0x43FAB9837E699095, 0xA59BC234DB398C25},\n        {0x94F967E45E03F4BB, 0xCF02B2C21207EF2E},\n        {0x1D1BE0EEBAC278F5, 0x8161AFB94B44F57D},\n        {0x6462D92A69731732, 0xA1BA1BA79E1632DC},\n        {0x7D7B8F7503CFDCFE, 0xCA28A291859BBF93},\n        {0x5CDA735244C3D43E, 0xFCB2CB35E702AF78},\n        {0x3A0888136AFA64A7, 0x9DEFBF01B061ADAB},\n        {0x088AAA1845B8FDD0, 0xC56BAEC21C7A1916},\n        {0x8AAD549E57273D45, 0xF6C69A72A3989F5B},\n        {0x36A" +
+	"C54E2F678864B, 0x9A3C2087A63F6399},\n        {0x84576A1BB416A7DD, 0xC0CB28A98FCF3C7F},\n        {0x656D44A2A11C51D5, 0xF0FDF2D3F3C30B9F},\n        {0x9F644AE5A4B1B325, 0x969EB7C47859E743},\n        {0x873D5D9F0DDE1FEE, 0xBC4665B596706114},\n        {0xA90CB506D155A7EA, 0xEB57FF22FC0C7959},\n        {0x09A7F12442D588F2, 0x9316FF75DD87CBD8},\n        {0x0C11ED6D538AEB2F, 0xB7DCBF5354E9BECE},\n        {0x8F1668C8A86DA5FA, 0xE5D3EF282A242E81},\n        {0xF96E017D694487BC, 0x8FA475791A569D10},\n        {0x37C981DCC395A9AC, 0xB38D92D760EC4455},\n        {0x85BBE253F47B1417, 0xE070F78D3927556A},\n        {0x93956D7478CCEC8E, 0x8C469AB843B89562},\n        {0x387AC8D1970027B2, 0xAF58416654A6BABB},\n        {0x06997B05FCC0319E, 0xDB2E51BFE9D0696A},\n        {0x441FECE3BDF81F03, 0x88FCF317F22241E2},\n        {0xD527E81CAD7626C3, 0xAB3C2FDDEEAAD25A},\n        {0x8A71E223D8D3B074, 0xD60B3BD56A5586F1},\n        {0xF6872D5667844E49, 0x85C7056562757456},\n        {0xB428F8AC016561DB, 0xA738C6BEBB12D16C},\n        {0xE13336D701BEBA52, 0xD106F86" +
+	"E69D785C7},\n        {0xECC0024661173473, 0x82A45B450226B39C},\n        {0x27F002D7F95D0190, 0xA34D721642B06084},\n        {0x31EC038DF7B441F4, 0xCC20CE9BD35C78A5},\n        {0x7E67047175A15271, 0xFF290242C83396CE},\n        {0x0F0062C6E984D386, 0x9F79A169BD203E41},\n        {0x52C07B78A3E60868, 0xC75809C42C684DD1},\n        {0xA7709A56CCDF8A82, 0xF92E0C3537826145},\n        {0x88A66076400BB691, 0x9BBCC7A142B17CCB},\n        {0x6ACFF893D00EA435, 0xC2ABF989935DDBFE},\n        {0x0583F6B8C4124D43, 0xF356F7EBF83552FE},\n        {0xC3727A337A8B704A, 0x98165AF37B2153DE},\n        {0x744F18C0592E4C5C, 0xBE1BF1B059E9A8D6},\n        {0x1162DEF06F79DF73, 0xEDA2EE1C7064130C},\n        {0x8ADDCB5645AC2BA8, 0x9485D4D1C63E8BE7},\n        {0x6D953E2BD7173692, 0xB9A74A0637CE2EE1},\n        {0xC8FA8DB6CCDD0437, 0xE8111C87C5C1BA99},\n        {0x1D9C9892400A22A2, 0x910AB1D4DB9914A0},\n        {0x2503BEB6D00CAB4B, 0xB54D5E4A127F59C8},\n        {0x2E44AE64840FD61D, 0xE2A0B5DC971F303A},\n        {0x5CEAECFED289E5D2, 0x8DA471A9DE737E24},\n        {0x7" +
+	"425A83E872C5F47, 0xB10D8E1456105DAD},\n        {0xD12F124E28F77719, 0xDD50F1996B947518},\n        {0x82BD6B70D99AAA6F, 0x8A5296FFE33CC92F},\n        {0x636CC64D1001550B, 0xACE73CBFDC0BFB7B},\n        {0x3C47F7E05401AA4E, 0xD8210BEFD30EFA5A},\n        {0x65ACFAEC34810A71, 0x8714A775E3E95C78},\n        {0x7F1839A741A14D0D, 0xA8D9D1535CE3B396},\n        {0x1EDE48111209A050, 0xD31045A8341CA07C},\n        {0x934AED0AAB460432, 0x83EA2B892091E44D},\n        {0xF81DA84D5617853F, 0xA4E4B66B68B65D60},\n        {0x36251260AB9D668E, 0xCE1DE40642E3F4B9},\n        {0xC1D72B7C6B426019, 0x80D2AE83E9CE78F3},\n        {0xB24CF65B8612F81F, 0xA1075A24E4421730},\n        {0xDEE033F26797B627, 0xC94930AE1D529CFC},\n        {0x169840EF017DA3B1, 0xFB9B7CD9A4A7443C},\n        {0x8E1F289560EE864E, 0x9D412E0806E88AA5},\n        {0xF1A6F2BAB92A27E2, 0xC491798A08A2AD4E},\n        {0xAE10AF696774B1DB, 0xF5B5D7EC8ACB58A2},\n        {0xACCA6DA1E0A8EF29, 0x9991A6F3D6BF1765},\n        {0x17FD090A58D32AF3, 0xBFF610B0CC6EDD3F},\n        {0xDDFC4B4CEF07F5B0, 0xEFF39" +
+	"4DCFF8A948E},\n        {0x4ABDAF101564F98E, 0x95F83D0A1FB69CD9},\n        {0x9D6D1AD41ABE37F1, 0xBB764C4CA7A4440F},\n        {0x84C86189216DC5ED, 0xEA53DF5FD18D5513},\n        {0x32FD3CF5B4E49BB4, 0x92746B9BE2F8552C},\n        {0x3FBC8C33221DC2A1, 0xB7118682DBB66A77},\n        {0x0FABAF3FEAA5334A, 0xE4D5E82392A40515},\n        {0x29CB4D87F2A7400E, 0x8F05B1163BA6832D},\n        {0x743E20E9EF511012, 0xB2C71D5BCA9023F8},\n        {0x914DA9246B255416, 0xDF78E4B2BD342CF6},\n        {0x1AD089B6C2F7548E, 0x8BAB8EEFB6409C1A},\n        {0xA184AC2473B529B1, 0xAE9672ABA3D0C320},\n        {0xC9E5D72D90A2741E, 0xDA3C0F568CC4F3E8},\n        {0x7E2FA67C7A658892, 0x8865899617FB1871},\n        {0xDDBB901B98FEEAB7, 0xAA7EEBFB9DF9DE8D},\n        {0x552A74227F3EA565, 0xD51EA6FA85785631},\n        {0xD53A88958F87275F, 0x8533285C936B35DE},\n        {0x8A892ABAF368F137, 0xA67FF273B8460356},\n        {0x2D2B7569B0432D85, 0xD01FEF10A657842C},\n        {0x9C3B29620E29FC73, 0x8213F56A67F6B29B},\n        {0x8349F3BA91B47B8F, 0xA298F2C501F45F42},\n        {0" +
+	"x241C70A936219A73, 0xCB3F2F7642717713},\n        {0xED238CD383AA0110, 0xFE0EFB53D30DD4D7},\n        {0xF4363804324A40AA, 0x9EC95D1463E8A506},\n        {0xB143C6053EDCD0D5, 0xC67BB4597CE2CE48},\n        {0xDD94B7868E94050A, 0xF81AA16FDC1B81DA},\n        {0xCA7CF2B4191C8326, 0x9B10A4E5E9913128},\n        {0xFD1C2F611F63A3F0, 0xC1D4CE1F63F57D72},\n        {0xBC633B39673C8CEC, 0xF24A01A73CF2DCCF},\n        {0xD5BE0503E085D813, 0x976E41088617CA01},\n        {0x4B2D8644D8A74E18, 0xBD49D14AA79DBC82},\n        {0xDDF8E7D60ED1219E, 0xEC9C459D51852BA2},\n        {0xCABB90E5C942B503, 0x93E1AB8252F33B45},\n        {0x3D6A751F3B936243, 0xB8DA1662E7B00A17},\n        {0x0CC512670A783AD4, 0xE7109BFBA19C0C9D},\n        {0x27FB2B80668B24C5, 0x906A617D450187E2},\n        {0xB1F9F660802DEDF6, 0xB484F9DC9641E9DA},\n        {0x5E7873F8A0396973, 0xE1A63853BBD26451},\n        {0xDB0B487B6423E1E8, 0x8D07E33455637EB2},\n        {0x91CE1A9A3D2CDA62, 0xB049DC016ABC5E5F},\n        {0x7641A140CC7810FB, 0xDC5C5301C56B75F7},\n        {0xA9E904C87FCB0A9D, 0x89B" +
+	"9B3E11B6329BA},\n        {0x546345FA9FBDCD44, 0xAC2820D9623BF429},\n        {0xA97C177947AD4095, 0xD732290FBACAF133},\n        {0x49ED8EABCCCC485D, 0x867F59A9D4BED6C0},\n        {0x5C68F256BFFF5A74, 0xA81F301449EE8C70},\n        {0x73832EEC6FFF3111, 0xD226FC195C6A2F8C},\n};\n\n// wuffs_base__private_implementation__parse_number_f64_eisel_lemire returns\n// the closest double-precision float64 to (man * (10 ** exp10)), as IEEE 754\n// bits, or -1 if it cannot determine that result unambiguously.\n//\n// This is the algorithm from Daniel Lemire, \"Number Parsing at a Gigabyte per\n// Second\" (https://arxiv.org/abs/2101.11408), which builds on an idea by\n// Michael Eisel. It multiplies the 64-bit man by a 64-bit (or, if that isn't\n// precise enough, 128-bit) approximation to (10 ** exp10) and gives up (for a\n// slower, arbitrary precision fallback) if the truncated product lies too\n// close to a rounding boundary. In practice, it very rarely gives up.\n//\n// The returned value never has its sign bit set.\n//\n// Preconditions:\n/" +
+	"/  - man is non-zero.\n//  - exp10 is in the range -307 ..= 288, the same range (from 1e-307 to\n//    1e+288) as wuffs_base__private_implementation__powers_of_10.\n//\n// The range of exp10 means that, for any uint64_t man, the result is a normal\n// (not subnormal, not infinite) float64, ignoring rounding at the very ends.\nstatic int64_t  //\nwuffs_base__private_implementation__parse_number_f64_eisel_lemire(\n    uint64_t man,\n    int32_t exp10) {\n  // The table entry is already normalized. Normalize man too.\n  const uint64_t* po10 =\n      &wuffs_base__private_implementation__powers_of_10[exp10 + 307][0];\n  uint32_t clz = wuffs_base__count_leading_zeroes_u64(man);\n  man <<= clz;\n\n  // Estimate the result's biased base-2 exponent. ((217706 * exp10) >> 16) is\n  // floor(log2(10 ** exp10)) over the table's range (confirmed by the script\n  // that printed the table). 1087 is 1023 + 64: the f64 exponent bias plus\n  // the width of man. This estimate is refined by -1 (below), depending on\n  // the high bit of the produc" +
+	"t.\n  uint64_t ret_exp2 =\n      ((uint64_t)(((217706 * exp10) >> 16) + 1087)) - ((uint64_t)clz);\n\n  // Multiply by the high 64 bits of the table entry. Both factors have their\n  // high bit set, so the 128-bit product x is at least (1 << 126) and x_hi has\n  // either 0 or 1 leading zeroes.\n  wuffs_base__multiply_u64__output x = wuffs_base__multiply_u64(man, po10[1]);\n  uint64_t x_hi = x.hi;\n  uint64_t x_lo = x.lo;\n\n  // The table entry was truncated, so x is a lower bound. The upper bound adds\n  // up to man to x_lo. We keep at most the top 55 bits of x_hi, so unless the\n  // low 9 bits of x_hi are all on and that addition carries, the lower bound\n  // gives the same answer as the upper bound.\n  if (((x_hi & 0x1FF) == 0x1FF) && ((x_lo + man) < man)) {\n    // Refine, using the low 64 bits of the table entry too. y is man times\n    // those low bits, and merged is the high 128 bits of the 192-bit product\n    // of man and the full 128-bit table entry.\n    wuffs_base__multiply_u64__output y = wuffs_base__multiply" +
+	"_u64(man, po10[0]);\n    uint64_t merged_hi = x_hi;\n    uint64_t merged_lo = x_lo + y.hi;\n    if (merged_lo < x_lo) {\n      merged_hi++;\n    }\n\n    // merged is still a lower bound. If its upper bound could still carry\n    // into the bits we keep, give up instead of going to even more precision.\n    if (((merged_hi & 0x1FF) == 0x1FF) && ((merged_lo + 1) == 0) &&\n        ((y.lo + man) < man)) {\n      return -1;\n    }\n\n    x_hi = merged_hi;\n    x_lo = merged_lo;\n  }\n\n  // Shift x_hi right by 9 or 10 bits (depending on its high bit) so that\n  // ret_mantissa has exactly 54 bits: 53 for a float64 plus 1 rounding bit.\n  uint64_t msb = x_hi >> 63;\n  uint64_t ret_mantissa = x_hi >> (msb + 9);\n  ret_exp2 -= 1 ^ msb;\n\n  // IEEE 754 rounds to nearest, ties to even. If x is exactly halfway between\n  // two float64 values (the dropped bits are \"1000...000\"), give up instead of\n  // deciding which way the tie breaks. For simplicity, this check treats the\n  // low 73 bits as dropped, regardless of msb.\n  if ((x_lo == 0) &&" +
+	" ((x_hi & 0x1FF) == 0) && ((ret_mantissa & 3) == 1)) {\n    return -1;\n  }\n\n  // Round to nearest, from 54 to 53 bits. If that overflows to 54 bits\n  // again, shift once more.\n  ret_mantissa += ret_mantissa & 1;\n  ret_mantissa >>= 1;\n  if ((ret_mantissa >> 53) > 0) {\n    ret_mantissa >>= 1;\n    ret_exp2++;\n  }\n\n  // Give up on subnormal or infinite results. ret_exp2 is unsigned, so this\n  // rejects both 0 and 0x7FF (and anything wrapped around).\n  if ((ret_exp2 - 1) >= (0x7FF - 1)) {\n    return -1;\n  }\n\n  // Drop the implicit mantissa bit, pack the bits and return.\n  return (int64_t)((ret_mantissa & 0x000FFFFFFFFFFFFF) | (ret_exp2 << 52));\n}\n\n" +
 	"" +
 	"// --------\n\nwuffs_base__result_f64  //\nwuffs_base__parse_number_f64_special(wuffs_base__slice_u8 s,\n                                     const char* fallback_status_repr) {\n  do {\n    uint8_t* p = s.ptr;\n    uint8_t* q = s.ptr + s.len;\n\n    for (; (p < q) && (*p == '_'); p++) {\n    }\n    if (p >= q) {\n      goto fallback;\n    }\n\n    // Parse sign.\n    bool negative = false;\n    do {\n      if (*p == '+') {\n        p++;\n      } else if (*p == '-') {\n        negative = true;\n        p++;\n      } else {\n        break;\n      }\n      for (; (p < q) && (*p == '_'); p++) {\n      }\n    } while (0);\n    if (p >= q) {\n      goto fallback;\n    }\n\n    bool nan = false;\n    switch (p[0]) {\n      case 'I':\n      case 'i':\n        if (((q - p) < 3) ||                     //\n            ((p[1] != 'N') && (p[1] != 'n')) ||  //\n            ((p[2] != 'F') && (p[2] != 'f'))) {\n          goto fallback;\n        }\n        p += 3;\n\n        if ((p >= q) || (*p == '_')) {\n          break;\n        } else if (((q - p) < 5) ||           " +
 	"          //\n                   ((p[0] != 'I') && (p[0] != 'i')) ||  //\n                   ((p[1] != 'N') && (p[1] != 'n')) ||  //\n                   ((p[2] != 'I') && (p[2] != 'i')) ||  //\n                   ((p[3] != 'T') && (p[3] != 't')) ||  //\n                   ((p[4] != 'Y') && (p[4] != 'y'))) {\n          goto fallback;\n        }\n        p += 5;\n\n        if ((p >= q) || (*p == '_')) {\n          break;\n        }\n        goto fallback;\n\n      case 'N':\n      case 'n':\n        if (((q - p) < 3) ||                     //\n            ((p[1] != 'A') && (p[1] != 'a')) ||  //\n            ((p[2] != 'N') && (p[2] != 'n'))) {\n          goto fallback;\n        }\n        p += 3;\n\n        if ((p >= q) || (*p == '_')) {\n          nan = true;\n          break;\n        }\n        goto fallback;\n\n      default:\n        goto fallback;\n    }\n\n    // Finish.\n    for (; (p < q) && (*p == '_'); p++) {\n    }\n    if (p != q) {\n      goto fallback;\n    }\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = w" +
-	"uffs_base__ieee_754_bit_representation__to_f64(\n        (nan ? 0x7FFFFFFFFFFFFFFF : 0x7FF0000000000000) |\n        (negative ? 0x8000000000000000 : 0));\n    return ret;\n  } while (0);\n\nfallback:\n  do {\n    wuffs_base__result_f64 ret;\n    ret.status.repr = fallback_status_repr;\n    ret.value = 0;\n    return ret;\n  } while (0);\n}\n\nwuffs_base__result_f64  //\nwuffs_base__parse_number_f64(wuffs_base__slice_u8 s) {\n  wuffs_base__private_implementation__medium_prec_bin m;\n  wuffs_base__private_implementation__high_prec_dec h;\n\n  do {\n    // powers converts decimal powers of 10 to binary powers of 2. For example,\n    // (10000 >> 13) is 1. It stops before the elements exceed 60, also known\n    // as WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL.\n    static const uint32_t num_powers = 19;\n    static const uint8_t powers[19] = {\n        0,  3,  6,  9,  13, 16, 19, 23, 26, 29,  //\n        33, 36, 39, 43, 46, 49, 53, 56, 59,      //\n    };\n\n    wuffs_base__status status =\n        wuffs_base__private_implementat" +
-	"ion__high_prec_dec__parse(&h, s);\n    if (status.repr) {\n      return wuffs_base__parse_number_f64_special(s, status.repr);\n    }\n\n    // Handle zero and obvious extremes. The largest and smallest positive\n    // finite f64 values are approximately 1.8e+308 and 4.9e-324.\n    if ((h.num_digits == 0) || (h.decimal_point < -326)) {\n      goto zero;\n    } else if (h.decimal_point > 310) {\n      goto infinity;\n    }\n\n    wuffs_base__result_f64 mpb_result =\n        wuffs_base__private_implementation__medium_prec_bin__parse_number_f64(\n            &m, &h, false);\n    if (mpb_result.status.repr == NULL) {\n      return mpb_result;\n    }\n\n    // Scale by powers of 2 until we're in the range [½ .. 1], which gives us\n    // our exponent (in base-2). First we shift right, possibly a little too\n    // far, ending with a value certainly below 1 and possibly below ½...\n    const int32_t f64_bias = -1023;\n    int32_t exp2 = 0;\n    while (h.decimal_point > 0) {\n      uint32_t n = (uint32_t)(+h.decimal_point);\n      uint32_t " +
-	"shift =\n          (n < num_powers)\n              ? powers[n]\n              : WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n\n      wuffs_base__private_implementation__high_prec_dec__small_rshift(&h,\n                                                                      shift);\n      if (h.decimal_point <\n          -WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE) {\n        goto zero;\n      }\n      exp2 += (int32_t)shift;\n    }\n    // ...then we shift left, putting us in [½ .. 1].\n    while (h.decimal_point <= 0) {\n      uint32_t shift;\n      if (h.decimal_point == 0) {\n        if (h.digits[0] >= 5) {\n          break;\n        }\n        shift = (h.digits[0] <= 2) ? 2 : 1;\n      } else {\n        uint32_t n = (uint32_t)(-h.decimal_point);\n        shift = (n < num_powers)\n                    ? powers[n]\n                    : WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n      }\n\n      wuffs_base__private_implementation__high_prec_dec__small_lshift(&h,\n                          " +
-	"                                            shift);\n      if (h.decimal_point >\n          +WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE) {\n        goto infinity;\n      }\n      exp2 -= (int32_t)shift;\n    }\n\n    // We're in the range [½ .. 1] but f64 uses [1 .. 2].\n    exp2--;\n\n    // The minimum normal exponent is (f64_bias + 1).\n    while ((f64_bias + 1) > exp2) {\n      uint32_t n = (uint32_t)((f64_bias + 1) - exp2);\n      if (n > WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL) {\n        n = WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n      }\n      wuffs_base__private_implementation__high_prec_dec__small_rshift(&h, n);\n      exp2 += (int32_t)n;\n    }\n\n    // Check for overflow.\n    if ((exp2 - f64_bias) >= 0x07FF) {  // (1 << 11) - 1.\n      goto infinity;\n    }\n\n    // Extract 53 bits for the mantissa (in base-2).\n    wuffs_base__private_implementation__high_prec_dec__small_lshift(&h, 53);\n    uint64_t man2 =\n        wuffs_base__private_implementation__high_prec_dec_" +
-	"_rounded_integer(&h);\n\n    // Rounding might have added one bit. If so, shift and re-check overflow.\n    if ((man2 >> 53) != 0) {\n      man2 >>= 1;\n      exp2++;\n      if ((exp2 - f64_bias) >= 0x07FF) {  // (1 << 11) - 1.\n        goto infinity;\n      }\n    }\n\n    // Handle subnormal numbers.\n    if ((man2 >> 52) == 0) {\n      exp2 = f64_bias;\n    }\n\n    // Pack the bits and return.\n    uint64_t exp2_bits =\n        (uint64_t)((exp2 - f64_bias) & 0x07FF);             // (1 << 11) - 1.\n    uint64_t bits = (man2 & 0x000FFFFFFFFFFFFF) |           // (1 << 52) - 1.\n                    (exp2_bits << 52) |                     //\n                    (h.negative ? 0x8000000000000000 : 0);  // (1 << 63).\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);\n    return ret;\n  } while (0);\n\nzero:\n  do {\n    uint64_t bits = h.negative ? 0x8000000000000000 : 0;\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base" +
-	"__ieee_754_bit_representation__to_f64(bits);\n    return ret;\n  } while (0);\n\ninfinity:\n  do {\n    uint64_t bits = h.negative ? 0xFFF0000000000000 : 0x7FF0000000000000;\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);\n    return ret;\n  } while (0);\n}\n\n" +
+	"uffs_base__ieee_754_bit_representation__to_f64(\n        (nan ? 0x7FFFFFFFFFFFFFFF : 0x7FF0000000000000) |\n        (negative ? 0x8000000000000000 : 0));\n    return ret;\n  } while (0);\n\nfallback:\n  do {\n    wuffs_base__result_f64 ret;\n    ret.status.repr = fallback_status_repr;\n    ret.value = 0;\n    return ret;\n  } while (0);\n}\n\n// wuffs_base__private_implementation__parse_number_f64_slow handles the\n// general case of wuffs_base__parse_number_f64: any number of digits, '_'\n// separators, a leading '+', a ',' decimal separator and extreme exponents.\n// It converts via an HPD, trying an MPB approximation first.\nstatic wuffs_base__result_f64  //\nwuffs_base__private_implementation__parse_number_f64_slow(\n    wuffs_base__slice_u8 s) {\n  wuffs_base__private_implementation__medium_prec_bin m;\n  wuffs_base__private_implementation__high_prec_dec h;\n\n  do {\n    // powers converts decimal powers of 10 to binary powers of 2. For example,\n    // (10000 >> 13) is 1. It stops before the elements exceed 60, also known\n    //" +
+	" as WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL.\n    static const uint32_t num_powers = 19;\n    static const uint8_t powers[19] = {\n        0,  3,  6,  9,  13, 16, 19, 23, 26, 29,  //\n        33, 36, 39, 43, 46, 49, 53, 56, 59,      //\n    };\n\n    wuffs_base__status status =\n        wuffs_base__private_implementation__high_prec_dec__parse(&h, s);\n    if (status.repr) {\n      return wuffs_base__parse_number_f64_special(s, status.repr);\n    }\n\n    // Handle zero and obvious extremes. The largest and smallest positive\n    // finite f64 values are approximately 1.8e+308 and 4.9e-324.\n    if ((h.num_digits == 0) || (h.decimal_point < -326)) {\n      goto zero;\n    } else if (h.decimal_point > 310) {\n      goto infinity;\n    }\n\n    wuffs_base__result_f64 mpb_result =\n        wuffs_base__private_implementation__medium_prec_bin__parse_number_f64(\n            &m, &h, false);\n    if (mpb_result.status.repr == NULL) {\n      return mpb_result;\n    }\n\n    // Scale by powers of 2 until we're in the range [½ .." +
+	" 1], which gives us\n    // our exponent (in base-2). First we shift right, possibly a little too\n    // far, ending with a value certainly below 1 and possibly below ½...\n    const int32_t f64_bias = -1023;\n    int32_t exp2 = 0;\n    while (h.decimal_point > 0) {\n      uint32_t n = (uint32_t)(+h.decimal_point);\n      uint32_t shift =\n          (n < num_powers)\n              ? powers[n]\n              : WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n\n      wuffs_base__private_implementation__high_prec_dec__small_rshift(&h,\n                                                                      shift);\n      if (h.decimal_point <\n          -WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE) {\n        goto zero;\n      }\n      exp2 += (int32_t)shift;\n    }\n    // ...then we shift left, putting us in [½ .. 1].\n    while (h.decimal_point <= 0) {\n      uint32_t shift;\n      if (h.decimal_point == 0) {\n        if (h.digits[0] >= 5) {\n          break;\n        }\n        shift = (h.digits[0] <= 2) ?" +
+	" 2 : 1;\n      } else {\n        uint32_t n = (uint32_t)(-h.decimal_point);\n        shift = (n < num_powers)\n                    ? powers[n]\n                    : WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n      }\n\n      wuffs_base__private_implementation__high_prec_dec__small_lshift(&h,\n                                                                      shift);\n      if (h.decimal_point >\n          +WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE) {\n        goto infinity;\n      }\n      exp2 -= (int32_t)shift;\n    }\n\n    // We're in the range [½ .. 1] but f64 uses [1 .. 2].\n    exp2--;\n\n    // The minimum normal exponent is (f64_bias + 1).\n    while ((f64_bias + 1) > exp2) {\n      uint32_t n = (uint32_t)((f64_bias + 1) - exp2);\n      if (n > WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL) {\n        n = WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;\n      }\n      wuffs_base__private_implementation__high_prec_dec__small_rshift(&h, n);\n      exp2 += (int32_t)n;\n" +
+	"    }\n\n    // Check for overflow.\n    if ((exp2 - f64_bias) >= 0x07FF) {  // (1 << 11) - 1.\n      goto infinity;\n    }\n\n    // Extract 53 bits for the mantissa (in base-2).\n    wuffs_base__private_implementation__high_prec_dec__small_lshift(&h, 53);\n    uint64_t man2 =\n        wuffs_base__private_implementation__high_prec_dec__rounded_integer(&h);\n\n    // Rounding might have added one bit. If so, shift and re-check overflow.\n    if ((man2 >> 53) != 0) {\n      man2 >>= 1;\n      exp2++;\n      if ((exp2 - f64_bias) >= 0x07FF) {  // (1 << 11) - 1.\n        goto infinity;\n      }\n    }\n\n    // Handle subnormal numbers.\n    if ((man2 >> 52) == 0) {\n      exp2 = f64_bias;\n    }\n\n    // Pack the bits and return.\n    uint64_t exp2_bits =\n        (uint64_t)((exp2 - f64_bias) & 0x07FF);             // (1 << 11) - 1.\n    uint64_t bits = (man2 & 0x000FFFFFFFFFFFFF) |           // (1 << 52) - 1.\n                    (exp2_bits << 52) |                     //\n                    (h.negative ? 0x8000000000000000 : 0);  // (1 <" +
+	"< 63).\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);\n    return ret;\n  } while (0);\n\nzero:\n  do {\n    uint64_t bits = h.negative ? 0x8000000000000000 : 0;\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);\n    return ret;\n  } while (0);\n\ninfinity:\n  do {\n    uint64_t bits = h.negative ? 0xFFF0000000000000 : 0x7FF0000000000000;\n\n    wuffs_base__result_f64 ret;\n    ret.status.repr = NULL;\n    ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);\n    return ret;\n  } while (0);\n}\n\nwuffs_base__result_f64  //\nwuffs_base__parse_number_f64(wuffs_base__slice_u8 s) {\n  // Try a fast path for the common case: \"-ddd.dddE±ddd\" with no '_' or '+'.\n  // Such a number is approximately (man * (10 ** exp10)), where man is a\n  // uint64_t holding the first 19 significant digits and exp10 is an int32_t,\n  // and can usually be converted without an HPD" +
+	". Anything else (including\n  // invalid input) falls back to the slow path, which gives the same result,\n  // just slower.\n  do {\n    uint8_t* p = s.ptr;\n    uint8_t* q = s.ptr + s.len;\n\n    bool negative = (p < q) && (*p == '-');\n    p += negative ? 1 : 0;\n\n    // truncated is whether any non-zero digits after the first 19 significant\n    // digits were dropped: the exact value is strictly between (man * (10 **\n    // exp10)) and ((man + 1) * (10 ** exp10)).\n    uint64_t man = 0;\n    int32_t exp10 = 0;\n    uint32_t num_significant_digits = 0;\n    bool truncated = false;\n\n    // Parse the integral digits. A leading '0' must be the only one.\n    if ((p >= q) || (*p < '0') || ('9' < *p)) {\n      break;\n    } else if (*p == '0') {\n      p++;\n      if ((p < q) && ('0' <= *p) && (*p <= '9')) {\n        break;\n      }\n    } else {\n      uint8_t* integral = p;\n      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {\n        if (num_significant_digits < 19) {\n          man = (10 * man) + ((uint64_t)(*p - '0'));\n    " +
+	"      num_significant_digits++;\n        } else {\n          exp10++;\n          truncated |= *p != '0';\n        }\n      }\n      if ((p - integral) >= 0x10000) {\n        goto slow;\n      }\n    }\n\n    // Parse the fractional digits, if any.\n    if ((p < q) && (*p == '.')) {\n      p++;\n      if ((p >= q) || (*p < '0') || ('9' < *p)) {\n        break;\n      }\n      uint8_t* fraction = p;\n      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {\n        if (num_significant_digits < 19) {\n          man = (10 * man) + ((uint64_t)(*p - '0'));\n          num_significant_digits += (man != 0) ? 1 : 0;\n          exp10--;\n        } else {\n          truncated |= *p != '0';\n        }\n      }\n      if ((p - fraction) >= 0x10000) {\n        goto slow;\n      }\n    }\n\n    // Parse the explicit exponent, if any. 0x10000 is far beyond any f64.\n    if ((p < q) && ((*p == 'E') || (*p == 'e'))) {\n      p++;\n      bool exp_negative = (p < q) && (*p == '-');\n      p += ((p < q) && ((*p == '-') || (*p == '+'))) ? 1 : 0;\n      if ((p >= q) " +
+	"|| (*p < '0') || ('9' < *p)) {\n        break;\n      }\n      int32_t exp = 0;\n      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {\n        if (exp >= 0x10000) {\n          goto slow;\n        }\n        exp = (10 * exp) + ((int32_t)(*p - '0'));\n      }\n      exp10 += exp_negative ? -exp : +exp;\n    }\n\n    if (p != q) {\n      break;\n    }\n\n    uint64_t bits = negative ? 0x8000000000000000 : 0;\n    if (man == 0) {\n      wuffs_base__result_f64 ret;\n      ret.status.repr = NULL;\n      ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);\n      return ret;\n    }\n\n    if (!truncated) {\n      // Converting a uint64_t to a double is correctly rounded (even when\n      // half-way between two float64 values, which Eisel-Lemire gives up on).\n      // If man and (10 ** exp10) are both exactly representable as a float64,\n      // a single float64 multiply or divide is too.\n      double d = (double)man;\n      if (exp10 != 0) {\n        if (((man >> 53) != 0) || (exp10 < -22) || (22 < exp10)) {\n          goto " +
+	"eisel_lemire;\n        } else if (exp10 > 0) {\n          d *= wuffs_base__private_implementation__f64_powers_of_10[+exp10];\n        } else {\n          d /= wuffs_base__private_implementation__f64_powers_of_10[-exp10];\n        }\n      }\n      wuffs_base__result_f64 ret;\n      ret.status.repr = NULL;\n      ret.value = negative ? -d : +d;\n      return ret;\n    }\n\n  eisel_lemire:\n    if ((-307 <= exp10) && (exp10 <= 288)) {\n      int64_t r =\n          wuffs_base__private_implementation__parse_number_f64_eisel_lemire(\n              man, exp10);\n      // If truncated, the exact value is between man and (man + 1). It\n      // converts to r only if (man + 1) also converts to r.\n      if (truncated && (r >= 0) &&\n          (r !=\n           wuffs_base__private_implementation__parse_number_f64_eisel_lemire(\n               man + 1, exp10))) {\n        r = -1;\n      }\n      if (r >= 0) {\n        wuffs_base__result_f64 ret;\n        ret.status.repr = NULL;\n        ret.value = wuffs_base__ieee_754_bit_representation__to_f64(\n " +
+	"           ((uint64_t)r) | bits);\n        return ret;\n      }\n    }\n  } while (0);\n\nslow:\n  return wuffs_base__private_implementation__parse_number_f64_slow(s);\n}\n\n" +
+	"" +
+	"// --------\n\n// wuffs_base__private_implementation__render_number_f64_grisu3_round_weed\n// adjusts the last of the num_digits digits (which are in the range [0 ..= 9],\n// not ['0' ..= '9']) so that the number they represent is as close as possible\n// to the exact value, and then returns whether that is provably the closest\n// shortest representation. If not, the caller should fall back to a slower,\n// exact algorithm.\n//\n// All of the uint64_t arguments are scaled so that one unit in the last\n// digit's place (ten_kappa) and the uncertainty of the approximations (unit)\n// are in the same fixed point representation. distance_too_high_w is the\n// distance from the (imprecise) upper bound to the (imprecise) value.\nstatic bool  //\nwuffs_base__private_implementation__render_number_f64_grisu3_round_weed(\n    uint8_t* digits,\n    uint32_t num_digits,\n    uint64_t distance_too_high_w,\n    uint64_t unsafe_interval,\n    uint64_t rest,\n    uint64_t ten_kappa,\n    uint64_t unit) {\n  uint64_t small_distance = distance_too" +
+	"_high_w - unit;\n  uint64_t big_distance = distance_too_high_w + unit;\n\n  // Decrement the last digit while that brings us closer to small_distance\n  // (the closest possible location of the exact value) and stays within the\n  // unsafe interval.\n  while ((rest < small_distance) &&                  //\n         ((unsafe_interval - rest) >= ten_kappa) &&  //\n         (((rest + ten_kappa) < small_distance) ||\n          ((small_distance - rest) >= (rest + ten_kappa - small_distance)))) {\n    digits[num_digits - 1]--;\n    rest += ten_kappa;\n  }\n\n  // If decrementing once more would also bring us closer to big_distance (the\n  // farthest possible location of the exact value) then we cannot know which\n  // of the two candidates is the closest.\n  if ((rest < big_distance) &&                    //\n      ((unsafe_interval - rest) >= ten_kappa) &&  //\n      (((rest + ten_kappa) < big_distance) ||\n       ((big_distance - rest) > (rest + ten_kappa - big_distance)))) {\n    return false;\n  }\n\n  // The candidate must be safel" +
+	"y inside the interval, accounting for the\n  // imprecision (of up to 2 units) in the approximations on both sides.\n  return ((2 * unit) <= rest) && (rest <= (unsafe_interval - (4 * unit)));\n}\n\n// wuffs_base__private_implementation__render_number_f64_grisu3 sets h to the\n// shortest decimal that parses back to the double (mantissa * (2 ** exp2)),\n// where mantissa is non-zero and includes the implicit 1<<52 bit for normal\n// numbers. Among equally short decimals it picks the closest one.\n//\n// It returns false (leaving h in an unspecified state) if it cannot guarantee\n// that, which happens for about 0.5% of all doubles. The caller should then\n// fall back to wuffs_base__private_implementation__high_prec_dec__assign and\n// wuffs_base__private_implementation__high_prec_dec__round_just_enough.\n//\n// This is the Grisu3 algorithm from Loitsch, \"Printing Floating-Point Numbers\n// Quickly and Accurately with Integers\" (see the medium_prec_bin type above),\n// as implemented in https://github.com/google/double-convers" +
+	"ion's\n// fast-dtoa.cc. It re-uses the big_powers_of_10 table, which is exactly the\n// cached powers table from that paper.\nstatic bool  //\nwuffs_base__private_implementation__render_number_f64_grisu3(\n    wuffs_base__private_implementation__high_prec_dec* h,\n    uint64_t mantissa,\n    int32_t exp2) {\n  // The boundaries m_minus and m_plus are halfway between the number and its\n  // two neighbors. A power of 2 (other than the minimum exponent's) is closer\n  // to its predecessor than to its successor. Both boundaries have the same\n  // exp2 as the normalized w.\n  wuffs_base__private_implementation__medium_prec_bin m_plus;\n  m_plus.mantissa = (mantissa << 1) + 1;\n  m_plus.exp2 = exp2 - 1;\n  wuffs_base__private_implementation__medium_prec_bin__normalize(&m_plus);\n\n  wuffs_base__private_implementation__medium_prec_bin m_minus;\n  if ((mantissa == 0x10000000000000) && (exp2 > -1074)) {\n    m_minus.mantissa = (mantissa << 2) - 1;\n    m_minus.exp2 = exp2 - 2;\n  } else {\n    m_minus.mantissa = (mantissa << 1) - 1;\n   " +
+	" m_minus.exp2 = exp2 - 1;\n  }\n  m_minus.mantissa <<= (uint32_t)(m_minus.exp2 - m_plus.exp2);\n  m_minus.exp2 = m_plus.exp2;\n\n  wuffs_base__private_implementation__medium_prec_bin w;\n  w.mantissa = mantissa;\n  w.exp2 = exp2;\n  wuffs_base__private_implementation__medium_prec_bin__normalize(&w);\n\n  // Pick the cached power of 10, 1e(k) ≈ p_mantissa * (2 ** p_exp2), such\n  // that multiplying w by it gives an exp2 in the range [-60 ..= -32]. The\n  // multiplication adds 64 to the exponent sum, so we want p_exp2 in the\n  // range [min_p_exp2 ..= (min_p_exp2 + 28)]. The cached powers step by about\n  // 26.6 (8 * log2(10)), so there is at least one.\n  //\n  // Since p_mantissa's high bit is set, 1e(k) is roughly 2 ** (p_exp2 + 63).\n  // 78913 / (1 << 18) is approximately log10(2).\n  int32_t min_p_exp2 = -124 - w.exp2;\n  int32_t k = ((min_p_exp2 + 63) * 78913) >> 18;\n  int32_t i = (k + 348 + 7) / 8;\n  if (i < 0) {\n    i = 0;\n  } else if (i > 86) {\n    i = 86;\n  }\n  const uint32_t* p = &wuffs_base__private_implementat" +
+	"ion__big_powers_of_10[0];\n  while ((i > 0) && (((int32_t)(p[(3 * i) - 1])) >= min_p_exp2)) {\n    i--;\n  }\n  while ((i < 86) && (((int32_t)(p[(3 * i) + 2])) < min_p_exp2)) {\n    i++;\n  }\n  int32_t p_exp2 = (int32_t)(p[(3 * i) + 2]);\n  if ((p_exp2 < min_p_exp2) || ((min_p_exp2 + 28) < p_exp2)) {\n    return false;\n  }\n  int32_t p_exp10 = -348 + (8 * i);\n\n  // Scale. The MPB multiplication's preconditions say that its argument is\n  // normalized, but m_minus (merely aligned to m_plus) does not need the\n  // extra precision: the error bound below is still at most 1 unit.\n  p = &wuffs_base__private_implementation__big_powers_of_10[3 * i];\n  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&w, p);\n  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&m_plus, p);\n  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&m_minus, p);\n\n  // The scaled values are approximations, each within 1 unit of the exact\n  // value. too_low and too_high are guaranteed to lie outside of the inte" +
+	"rval\n  // we want. unsafe_interval is the interval between them, and the exact\n  // boundaries are somewhere near its ends.\n  uint64_t unit = 1;\n  uint64_t too_low = m_minus.mantissa - unit;\n  uint64_t too_high = m_plus.mantissa + unit;\n  uint64_t unsafe_interval = too_high - too_low;\n\n  // Split too_high into integral and fractional parts, where \"one\" is\n  // (1 << shift). shift is in the range [32 ..= 60], so that integrals fits in\n  // a uint32_t and multiplying fractionals by 10 cannot overflow.\n  uint32_t shift = (uint32_t)(-w.exp2);\n  uint64_t one = ((uint64_t)1) << shift;\n  uint32_t integrals = (uint32_t)(too_high >> shift);\n  uint64_t fractionals = too_high & (one - 1);\n\n  // Find divisor, the largest power of 10 that is <= integrals, and kappa,\n  // one more than that power's exponent.\n  static const uint32_t powers[10] = {\n      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,\n  };\n  int32_t kappa = 0;\n  while ((kappa < 10) && (integrals >= powers[kappa])) {\n    kappa++;\n  " +
+	"}\n  uint32_t divisor = (kappa > 0) ? powers[kappa - 1] : 0;\n\n  // Generate digits from the integral part, stopping as soon as the\n  // remainder is inside the unsafe interval.\n  uint32_t n = 0;\n  while (kappa > 0) {\n    uint32_t digit = integrals / divisor;\n    h->digits[n++] = (uint8_t)digit;\n    integrals -= digit * divisor;\n    kappa--;\n    uint64_t rest = (((uint64_t)integrals) << shift) + fractionals;\n    if (rest < unsafe_interval) {\n      if (!wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(\n              &h->digits[0], n, too_high - w.mantissa, unsafe_interval, rest,\n              ((uint64_t)divisor) << shift, unit)) {\n        return false;\n      }\n      goto done;\n    }\n    divisor /= 10;\n  }\n\n  // Generate digits from the fractional part. A double never needs more than\n  // 17 digits, so give up (instead of looping forever) if something went\n  // wrong.\n  while (n < 20) {\n    fractionals *= 10;\n    unit *= 10;\n    unsafe_interval *= 10;\n    h->digits[n++] = (uint8_t)(fraction" +
+	"als >> shift);\n    fractionals &= one - 1;\n    kappa--;\n    if (fractionals < unsafe_interval) {\n      if (!wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(\n              &h->digits[0], n, (too_high - w.mantissa) * unit, unsafe_interval,\n              fractionals, one, unit)) {\n        return false;\n      }\n      goto done;\n    }\n  }\n  return false;\n\ndone:\n  h->num_digits = n;\n  h->decimal_point = ((int32_t)n) + kappa - p_exp10;\n  h->negative = false;\n  h->truncated = false;\n  wuffs_base__private_implementation__high_prec_dec__trim(h);\n  return true;\n}\n\n" +
+	"" +
+	"// --------\n\nstatic size_t  //\nwuffs_base__private_implementation__render_inf_nan(wuffs_base__slice_u8 dst,\n                                                   const char* s,\n                                                   size_t n,\n                                                   uint32_t options) {\n  if (n > dst.len) {\n    return 0;\n  }\n  memcpy(dst.ptr + ((options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)\n                        ? (dst.len - n)\n                        : 0),\n         s, n);\n  return n;\n}\n\nstatic size_t  //\nwuffs_base__private_implementation__high_prec_dec__render_exponent_absent(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__private_implementation__high_prec_dec* h,\n    uint32_t precision,\n    uint32_t options) {\n  size_t n = (h->negative ||\n              (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN))\n                 ? 1\n                 : 0;\n  if (h->decimal_point <= 0) {\n    n += 1;\n  } else {\n    n += (size_t)(h->decimal_point);\n  }\n  if (precision > 0) {\n    n +=" +
+	" precision + 1;  // +1 for the '.'.\n  }\n\n  // Don't modify dst if the formatted number won't fit.\n  if (n > dst.len) {\n    return 0;\n  }\n\n  // Align-left or align-right.\n  uint8_t* ptr = (options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)\n                     ? &dst.ptr[dst.len - n]\n                     : &dst.ptr[0];\n\n  // Leading \"±\".\n  if (h->negative) {\n    *ptr++ = '-';\n  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {\n    *ptr++ = '+';\n  }\n\n  // Integral digits.\n  if (h->decimal_point <= 0) {\n    *ptr++ = '0';\n  } else {\n    uint32_t m =\n        wuffs_base__u32__min(h->num_digits, (uint32_t)(h->decimal_point));\n    uint32_t i = 0;\n    for (; i < m; i++) {\n      *ptr++ = (uint8_t)('0' | h->digits[i]);\n    }\n    for (; i < (uint32_t)(h->decimal_point); i++) {\n      *ptr++ = '0';\n    }\n  }\n\n  // Separator and then fractional digits.\n  if (precision > 0) {\n    *ptr++ =\n        (options & WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA)\n            ? ','\n            :" +
+	" '.';\n    uint32_t i = 0;\n    for (; i < precision; i++) {\n      int32_t j = h->decimal_point + ((int32_t)i);\n      *ptr++ = (uint8_t)('0' | (((0 <= j) && (j < ((int32_t)(h->num_digits))))\n                                    ? h->digits[j]\n                                    : 0));\n    }\n  }\n\n  return n;\n}\n\nstatic size_t  //\nwuffs_base__private_implementation__high_prec_dec__render_exponent_present(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__private_implementation__high_prec_dec* h,\n    uint32_t precision,\n    uint32_t options) {\n  int32_t exp = 0;\n  if (h->num_digits > 0) {\n    exp = h->decimal_point - 1;\n  }\n  bool negative_exp = exp < 0;\n  if (negative_exp) {\n    exp = -exp;\n  }\n\n  size_t n = (h->negative ||\n              (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN))\n                 ? 4\n                 : 3;  // Minimum 3 bytes: first digit and then \"e±\".\n  if (precision > 0) {\n    n += precision + 1;  // +1 for the '.'.\n  }\n  n += (exp < 100) ? 2 : 3;\n\n  // Don't modify dst if the for" +
+	"matted number won't fit.\n  if (n > dst.len) {\n    return 0;\n  }\n\n  // Align-left or align-right.\n  uint8_t* ptr = (options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)\n                     ? &dst.ptr[dst.len - n]\n                     : &dst.ptr[0];\n\n  // Leading \"±\".\n  if (h->negative) {\n    *ptr++ = '-';\n  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {\n    *ptr++ = '+';\n  }\n\n  // Integral digit.\n  if (h->num_digits > 0) {\n    *ptr++ = (uint8_t)('0' | h->digits[0]);\n  } else {\n    *ptr++ = '0';\n  }\n\n  // Separator and then fractional digits.\n  if (precision > 0) {\n    *ptr++ =\n        (options & WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA)\n            ? ','\n            : '.';\n    uint32_t i = 1;\n    uint32_t j = wuffs_base__u32__min(h->num_digits, precision + 1);\n    for (; i < j; i++) {\n      *ptr++ = (uint8_t)('0' | h->digits[i]);\n    }\n    for (; i <= precision; i++) {\n      *ptr++ = '0';\n    }\n  }\n\n  // Exponent: \"e±\" and then 2 or 3 digits.\n  *ptr++ = 'e';\n  *" +
+	"ptr++ = negative_exp ? '-' : '+';\n  if (exp >= 100) {\n    *ptr++ = (uint8_t)('0' + (exp / 100));\n    exp %= 100;\n  }\n  ptr[0] = wuffs_base__render_number__two_digits[(2 * exp) + 0];\n  ptr[1] = wuffs_base__render_number__two_digits[(2 * exp) + 1];\n\n  return n;\n}\n\nsize_t  //\nwuffs_base__render_number_f64(wuffs_base__slice_u8 dst,\n                              double x,\n                              uint32_t precision,\n                              uint32_t options) {\n  // Decompose x (64 bits) into negativity (1 bit), base-2 exponent (11 bits\n  // with a -1023 bias) and mantissa (52 bits).\n  uint64_t bits = wuffs_base__ieee_754_bit_representation__from_f64(x);\n  bool neg = (bits >> 63) != 0;\n  int32_t exp2 = ((int32_t)(bits >> 52)) & 0x7FF;\n  uint64_t man = bits & 0x000FFFFFFFFFFFFFul;\n\n  // Apply the exponent bias and set the implicit top bit of the mantissa,\n  // unless x is subnormal. Also take care of Inf and NaN.\n  if (exp2 == 0x7FF) {\n    if (man != 0) {\n      return wuffs_base__private_implementation__re" +
+	"nder_inf_nan(dst, \"NaN\", 3,\n                                                                options);\n    } else if (neg) {\n      return wuffs_base__private_implementation__render_inf_nan(dst, \"-Inf\", 4,\n                                                                options);\n    } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {\n      return wuffs_base__private_implementation__render_inf_nan(dst, \"+Inf\", 4,\n                                                                options);\n    }\n    return wuffs_base__private_implementation__render_inf_nan(dst, \"Inf\", 3,\n                                                              options);\n  } else if (exp2 == 0) {\n    exp2 = -1074;\n  } else {\n    exp2 -= 1075;\n    man |= 0x0010000000000000ul;\n  }\n\n  // Convert from binary to decimal. x is now exactly (man * (2 ** exp2)).\n  wuffs_base__private_implementation__high_prec_dec h;\n  if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {\n    if (man == 0) {\n      wuffs_base__private_i" +
+	"mplementation__high_prec_dec__assign(&h, 0, 0,\n                                                                false);\n    } else if (!wuffs_base__private_implementation__render_number_f64_grisu3(\n                   &h, man, exp2)) {\n      wuffs_base__private_implementation__high_prec_dec__assign(&h, man, exp2,\n                                                                false);\n      wuffs_base__private_implementation__high_prec_dec__round_just_enough(\n          &h, exp2, man);\n    }\n  } else {\n    wuffs_base__private_implementation__high_prec_dec__assign(&h, man, exp2,\n                                                              false);\n    if (precision > 4095) {\n      precision = 4095;\n    }\n  }\n  h.negative = neg;\n\n  // Round and render, either explicitly with or without an exponent (like\n  // printf's \"%e\" or \"%f\"), or choosing whichever is appropriate (\"%g\").\n  int32_t nd = (int32_t)(h.num_digits);\n  switch (options & (WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT |\n                     WUFFS_BASE" +
+	"__RENDER_NUMBER_FXX__EXPONENT_PRESENT)) {\n    case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT:\n      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {\n        precision =\n            (nd > h.decimal_point) ? ((uint32_t)(nd - h.decimal_point)) : 0;\n      } else {\n        wuffs_base__private_implementation__high_prec_dec__round_nearest(\n            &h, h.decimal_point + ((int32_t)precision));\n      }\n      return wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(\n          dst, &h, precision, options);\n\n    case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT:\n      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {\n        precision = (nd > 0) ? ((uint32_t)(nd - 1)) : 0;\n      } else {\n        wuffs_base__private_implementation__high_prec_dec__round_nearest(\n            &h, 1 + ((int32_t)precision));\n      }\n      return wuffs_base__private_implementation__high_prec_dec__render_exponent_present(\n          dst, &h, precision, options);\n  }\n\n  //" +
+	" Like \"%g\", use the exponent notation only if the exponent is outside the\n  // range [e_min ..= e_max). For just enough precision, e_min and e_max are\n  // JavaScript's Number.prototype.toString thresholds.\n  int32_t e_min = -4;\n  int32_t e_max = 21;\n  if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {\n    e_min = -6;\n  } else {\n    if (precision == 0) {\n      precision = 1;\n    }\n    e_max = (int32_t)precision;\n    wuffs_base__private_implementation__high_prec_dec__round_nearest(\n        &h, (int32_t)precision);\n  }\n\n  // Rounding might have changed the number of digits or the exponent. Either\n  // way, like \"%g\", there are no trailing zeroes.\n  nd = (int32_t)(h.num_digits);\n  int32_t e = (nd > 0) ? (h.decimal_point - 1) : 0;\n  if ((e < e_min) || (e_max <= e)) {\n    precision = (nd > 0) ? ((uint32_t)(nd - 1)) : 0;\n    return wuffs_base__private_implementation__high_prec_dec__render_exponent_present(\n        dst, &h, precision, options);\n  }\n  precision = (nd > h.decimal_point) ? ((uint32_t" +
+	")(nd - h.decimal_point)) : 0;\n  return wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(\n      dst, &h, precision, options);\n}\n\n" +
 	"" +
 	"// ---------------- Hexadecimal\n\nsize_t  //\nwuffs_base__hexadecimal__decode2(wuffs_base__slice_u8 dst,\n                                 wuffs_base__slice_u8 src) {\n  size_t src_len2 = src.len / 2;\n  size_t len = dst.len < src_len2 ? dst.len : src_len2;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  while (n--) {\n    *d = (uint8_t)((wuffs_base__parse_number__hexadecimal_digits[s[0]] << 4) |\n                   (wuffs_base__parse_number__hexadecimal_digits[s[1]] & 0x0F));\n    d += 1;\n    s += 2;\n  }\n\n  return len;\n}\n\nsize_t  //\nwuffs_base__hexadecimal__decode4(wuffs_base__slice_u8 dst,\n                                 wuffs_base__slice_u8 src) {\n  size_t src_len4 = src.len / 4;\n  size_t len = dst.len < src_len4 ? dst.len : src_len4;\n  uint8_t* d = dst.ptr;\n  uint8_t* s = src.ptr;\n  size_t n = len;\n\n  while (n--) {\n    *d = (uint8_t)((wuffs_base__parse_number__hexadecimal_digits[s[2]] << 4) |\n                   (wuffs_base__parse_number__hexadecimal_digits[s[3]] & 0x0F));\n    d += 1;\n    s +" +
 	"= 4;\n  }\n\n  return len;\n}\n\n" +
@@ -153,6 +263,9 @@ const baseCorePrivateH = "" +
 	"E__FALLTHROUGH __attribute__((fallthrough))\n#else\n#define WUFFS_BASE__FALLTHROUGH\n#endif\n\n// Use switch cases for coroutine suspension points, similar to the technique\n// in https://www.chiark.greenend.org.uk/~sgtatham/coroutines.html\n//\n// We use trivial macros instead of an explicit assignment and case statement\n// so that clang-format doesn't get confused by the unusual \"case\"s.\n#define WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0 case 0:;\n#define WUFFS_BASE__COROUTINE_SUSPENSION_POINT(n) \\\n  coro_susp_point = n;                            \\\n  WUFFS_BASE__FALLTHROUGH;                        \\\n  case n:;\n\n#define WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(n) \\\n  if (!status.repr) {                                           \\\n    goto ok;                                                    \\\n  } else if (*status.repr != '$') {                             \\\n    goto exit;                                                  \\\n  }                                                             \\\n  coro_susp_point" +
 	" = n;                                          \\\n  goto suspend;                                                 \\\n  case n:;\n\n// Clang also defines \"__GNUC__\".\n#if defined(__GNUC__)\n#define WUFFS_BASE__LIKELY(expr) (__builtin_expect(!!(expr), 1))\n#define WUFFS_BASE__UNLIKELY(expr) (__builtin_expect(!!(expr), 0))\n#else\n#define WUFFS_BASE__LIKELY(expr) (expr)\n#define WUFFS_BASE__UNLIKELY(expr) (expr)\n#endif\n\n" +
 	"" +
+	"// ---------------- CPU Architecture\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\n// wuffs_base__cpu_arch__have_x86_sse42 returns whether the CPU supports the\n// PCLMUL, POPCNT, SSE4.2 (and implied SSE4.1 and SSSE3) instructions. Functions\n// marked with the WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"pclmul,popcnt,sse4.2\")\n// attribute can only be called when this returns true.\nstatic inline bool  //\nwuffs_base__cpu_arch__have_x86_sse42() {\n#if defined(__PCLMUL__) && defined(__POPCNT__) && defined(__SSE4_2__)\n  // The compiler already assumes that the CPU has these features.\n  return true;\n#else\n  // __builtin_cpu_supports reads CPUID results that the compiler's run-time\n  // library caches at program start-up. Executing the CPUID instruction here\n  // instead can be surprisingly slow, especially under virtualization.\n  return __builtin_cpu_supports(\"pclmul\") &&\n         __builtin_cpu_supports(\"popcnt\") && __builtin_cpu_supports(\"sse4.2\");\n#endif\n}\n\n// wuffs_base__cpu_arch__have_x86_avx2 returns whether the CPU suppo" +
+	"rts the\n// AVX2 instructions. Functions marked with the\n// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"avx2\") attribute can only be called when\n// this returns true.\nstatic inline bool  //\nwuffs_base__cpu_arch__have_x86_avx2() {\n#if defined(__AVX2__)\n  return true;\n#else\n  return __builtin_cpu_supports(\"avx2\");\n#endif\n}\n\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\n" +
+	"" +
 	"// ---------------- Numeric Types\n\nextern const uint8_t wuffs_base__low_bits_mask__u8[9];\nextern const uint16_t wuffs_base__low_bits_mask__u16[17];\nextern const uint32_t wuffs_base__low_bits_mask__u32[33];\nextern const uint64_t wuffs_base__low_bits_mask__u64[65];\n\n#define WUFFS_BASE__LOW_BITS_MASK__U8(n) (wuffs_base__low_bits_mask__u8[n])\n#define WUFFS_BASE__LOW_BITS_MASK__U16(n) (wuffs_base__low_bits_mask__u16[n])\n#define WUFFS_BASE__LOW_BITS_MASK__U32(n) (wuffs_base__low_bits_mask__u32[n])\n#define WUFFS_BASE__LOW_BITS_MASK__U64(n) (wuffs_base__low_bits_mask__u64[n])\n\n" +
 	"" +
 	"// --------\n\nstatic inline void  //\nwuffs_base__u8__sat_add_indirect(uint8_t* x, uint8_t y) {\n  *x = wuffs_base__u8__sat_add(*x, y);\n}\n\nstatic inline void  //\nwuffs_base__u8__sat_sub_indirect(uint8_t* x, uint8_t y) {\n  *x = wuffs_base__u8__sat_sub(*x, y);\n}\n\nstatic inline void  //\nwuffs_base__u16__sat_add_indirect(uint16_t* x, uint16_t y) {\n  *x = wuffs_base__u16__sat_add(*x, y);\n}\n\nstatic inline void  //\nwuffs_base__u16__sat_sub_indirect(uint16_t* x, uint16_t y) {\n  *x = wuffs_base__u16__sat_sub(*x, y);\n}\n\nstatic inline void  //\nwuffs_base__u32__sat_add_indirect(uint32_t* x, uint32_t y) {\n  *x = wuffs_base__u32__sat_add(*x, y);\n}\n\nstatic inline void  //\nwuffs_base__u32__sat_sub_indirect(uint32_t* x, uint32_t y) {\n  *x = wuffs_base__u32__sat_sub(*x, y);\n}\n\nstatic inline void  //\nwuffs_base__u64__sat_add_indirect(uint64_t* x, uint64_t y) {\n  *x = wuffs_base__u64__sat_add(*x, y);\n}\n\nstatic inline void  //\nwuffs_base__u64__sat_sub_indirect(uint64_t* x, uint64_t y) {\n  *x = wuffs_base__u64__sat_sub(*x, y);\n}\n\n" +
@@ -169,8 +282,11 @@ const baseCorePublicH = "" +
 	"// ---------------- Fundamentals\n\n// WUFFS_VERSION is the major.minor.patch version, as per https://semver.org/,\n// as a uint64_t. The major number is the high 32 bits. The minor number is the\n// middle 16 bits. The patch number is the low 16 bits. The pre-release label\n// and build metadata are part of the string representation (such as\n// \"1.2.3-beta+456.20181231\") but not the uint64_t representation.\n//\n// WUFFS_VERSION_PRE_RELEASE_LABEL (such as \"\", \"beta\" or \"rc.1\") being\n// non-empty denotes a developer preview, not a release version, and has no\n// backwards or forwards compatibility guarantees.\n//\n// WUFFS_VERSION_BUILD_METADATA_XXX, if non-zero, are the number of commits and\n// the last commit date in the repository used to build this library. Within\n// each major.minor branch, the commit count should increase monotonically.\n//\n// !! Some code generation programs can override WUFFS_VERSION.\n#define WUFFS_VERSION ((uint64_t)0)\n#define WUFFS_VERSION_MAJOR ((uint64_t)0)\n#define WUFFS_VERSION_MINOR ((uint" +
 	"64_t)0)\n#define WUFFS_VERSION_PATCH ((uint64_t)0)\n#define WUFFS_VERSION_PRE_RELEASE_LABEL \"work.in.progress\"\n#define WUFFS_VERSION_BUILD_METADATA_COMMIT_COUNT 0\n#define WUFFS_VERSION_BUILD_METADATA_COMMIT_DATE 0\n#define WUFFS_VERSION_STRING \"0.0.0+0.00000000\"\n\n// Define WUFFS_CONFIG__STATIC_FUNCTIONS to make all of Wuffs' functions have\n// static storage. The motivation is discussed in the \"ALLOW STATIC\n// IMPLEMENTATION\" section of\n// https://raw.githubusercontent.com/nothings/stb/master/docs/stb_howto.txt\n#ifdef WUFFS_CONFIG__STATIC_FUNCTIONS\n#define WUFFS_BASE__MAYBE_STATIC static\n#else\n#define WUFFS_BASE__MAYBE_STATIC\n#endif\n\n" +
 	"" +
-	"// --------\n\n// Wuffs assumes that:\n//  - converting a uint32_t to a size_t will never overflow.\n//  - converting a size_t to a uint64_t will never overflow.\n#ifdef __WORDSIZE\n#if (__WORDSIZE != 32) && (__WORDSIZE != 64)\n#error \"Wuffs requires a word size of either 32 or 64 bits\"\n#endif\n#endif\n\n#if defined(__clang__)\n#define WUFFS_BASE__POTENTIALLY_UNUSED_FIELD __attribute__((unused))\n#else\n#define WUFFS_BASE__POTENTIALLY_UNUSED_FIELD\n#endif\n\n// Clang also defines \"__GNUC__\".\n#if defined(__GNUC__)\n#define WUFFS_BASE__POTENTIALLY_UNUSED __attribute__((unused))\n#define WUFFS_BASE__WARN_UNUSED_RESULT __attribute__((warn_unused_result))\n#else\n#define WUFFS_BASE__POTENTIALLY_UNUSED\n#define WUFFS_BASE__WARN_UNUSED_RESULT\n#endif\n\n// Flags for wuffs_foo__bar__initialize functions.\n\n#define WUFFS_INITIALIZE__DEFAULT_OPTIONS ((uint32_t)0x00000000)\n\n// WUFFS_INITIALIZE__ALREADY_ZEROED means that the \"self\" receiver struct value\n// has already been set to all zeroes.\n#define WUFFS_INITIALIZE__ALREADY_ZEROED ((uint32_t)0x" +
-	"00000001)\n\n// WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED means that, absent\n// WUFFS_INITIALIZE__ALREADY_ZEROED, only some of the \"self\" receiver struct\n// value will be set to all zeroes. Internal buffers, which tend to be a large\n// proportion of the struct's size, will be left uninitialized. Internal means\n// that the buffer is contained by the receiver struct, as opposed to being\n// passed as a separately allocated \"work buffer\".\n//\n// For more detail, see:\n// https://github.com/google/wuffs/blob/master/doc/note/initialization.md\n#define WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED \\\n  ((uint32_t)0x00000002)\n\n" +
+	"// --------\n\n// Wuffs assumes that:\n//  - converting a uint32_t to a size_t will never overflow.\n//  - converting a size_t to a uint64_t will never overflow.\n#ifdef __WORDSIZE\n#if (__WORDSIZE != 32) && (__WORDSIZE != 64)\n#error \"Wuffs requires a word size of either 32 or 64 bits\"\n#endif\n#endif\n\n#if defined(__clang__)\n#define WUFFS_BASE__POTENTIALLY_UNUSED_FIELD __attribute__((unused))\n#else\n#define WUFFS_BASE__POTENTIALLY_UNUSED_FIELD\n#endif\n\n// Clang also defines \"__GNUC__\".\n#if defined(__GNUC__)\n#define WUFFS_BASE__POTENTIALLY_UNUSED __attribute__((unused))\n#define WUFFS_BASE__WARN_UNUSED_RESULT __attribute__((warn_unused_result))\n#else\n#define WUFFS_BASE__POTENTIALLY_UNUSED\n#define WUFFS_BASE__WARN_UNUSED_RESULT\n#endif\n\n" +
+	"" +
+	"// --------\n\n// Define WUFFS_CONFIG__AVOID_CPU_ARCH to avoid any code tied to a specific CPU\n// architecture, such as SSE SIMD for the x86 CPU family.\n#if defined(WUFFS_CONFIG__AVOID_CPU_ARCH)\n// No-op.\n#else\n// Clang also defines \"__GNUC__\".\n#if defined(__GNUC__) && defined(__x86_64__)\n#define WUFFS_BASE__CPU_ARCH__X86_64\n#endif\n#endif\n\n// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET marks a function as being compiled for a\n// specific CPU feature set (such as \"pclmul,popcnt,sse4.2\"), even if the rest\n// of the program is not. Such functions are only called after a run-time check\n// that the CPU supports those features.\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n#include <immintrin.h>\n#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg) __attribute__((target(arg)))\n#else\n#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg)\n#endif\n\n" +
+	"" +
+	"// --------\n\n// Flags for wuffs_foo__bar__initialize functions.\n\n#define WUFFS_INITIALIZE__DEFAULT_OPTIONS ((uint32_t)0x00000000)\n\n// WUFFS_INITIALIZE__ALREADY_ZEROED means that the \"self\" receiver struct value\n// has already been set to all zeroes.\n#define WUFFS_INITIALIZE__ALREADY_ZEROED ((uint32_t)0x00000001)\n\n// WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED means that, absent\n// WUFFS_INITIALIZE__ALREADY_ZEROED, only some of the \"self\" receiver struct\n// value will be set to all zeroes. Internal buffers, which tend to be a large\n// proportion of the struct's size, will be left uninitialized. Internal means\n// that the buffer is contained by the receiver struct, as opposed to being\n// passed as a separately allocated \"work buffer\".\n//\n// For more detail, see:\n// https://github.com/google/wuffs/blob/master/doc/note/initialization.md\n#define WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED \\\n  ((uint32_t)0x00000002)\n\n" +
 	"" +
 	"// --------\n\n// wuffs_base__empty_struct is used when a Wuffs function returns an empty\n// struct. In C, if a function f returns void, you can't say \"x = f()\", but in\n// Wuffs, if a function g returns empty, you can say \"y = g()\".\ntypedef struct {\n  // private_impl is a placeholder field. It isn't explicitly used, except that\n  // without it, the sizeof a struct with no fields can differ across C/C++\n  // compilers, and it is undefined behavior in C99. For example, gcc says that\n  // the sizeof an empty struct is 0, and g++ says that it is 1. This leads to\n  // ABI incompatibility if a Wuffs .c file is processed by one compiler and\n  // its .h file with another compiler.\n  //\n  // Instead, we explicitly insert an otherwise unused field, so that the\n  // sizeof this struct is always 1.\n  uint8_t private_impl;\n} wuffs_base__empty_struct;\n\nstatic inline wuffs_base__empty_struct  //\nwuffs_base__make_empty_struct() {\n  wuffs_base__empty_struct ret;\n  ret.private_impl = 0;\n  return ret;\n}\n\n// wuffs_base__utility is" +
 	" a placeholder receiver type. It enables what Java\n// calls static methods, as opposed to regular methods.\ntypedef struct {\n  // private_impl is a placeholder field. It isn't explicitly used, except that\n  // without it, the sizeof a struct with no fields can differ across C/C++\n  // compilers, and it is undefined behavior in C99. For example, gcc says that\n  // the sizeof an empty struct is 0, and g++ says that it is 1. This leads to\n  // ABI incompatibility if a Wuffs .c file is processed by one compiler and\n  // its .h file with another compiler.\n  //\n  // Instead, we explicitly insert an otherwise unused field, so that the\n  // sizeof this struct is always 1.\n  uint8_t private_impl;\n} wuffs_base__utility;\n\ntypedef struct {\n  const char* vtable_name;\n  const void* function_pointers;\n} wuffs_base__vtable;\n\n" +
@@ -228,7 +344,8 @@ const baseImagePrivateH = "" +
 	""
 
 const baseImagePublicH = "" +
-	"// ---------------- Images\n\n// wuffs_base__color_u32_argb_premul is an 8 bit per channel premultiplied\n// Alpha, Red, Green, Blue color, as a uint32_t value. It is in word order, not\n// byte order: its value is always 0xAARRGGBB, regardless of endianness.\ntypedef uint32_t wuffs_base__color_u32_argb_premul;\n\n" +
+	"// ---------------- Images\n\n// wuffs_base__color_u32_argb_premul is an 8 bit per channel premultiplied\n// Alpha, Red, Green, Blue color, as a uint32_t value. It is in word order, not\n// byte order: its value is always 0xAARRGGBB, regardless of endianness.\ntypedef uint32_t wuffs_base__color_u32_argb_premul;\n\nstatic inline uint16_t  //\nwuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(\n    wuffs_base__color_u32_argb_premul c) {\n  uint32_t r5 = 0xF800 & (c >> 8);\n  uint32_t g6 = 0x07E0 & (c >> 5);\n  uint32_t b5 = 0x001F & (c >> 3);\n  return (uint16_t)(r5 | g6 | b5);\n}\n\nstatic inline wuffs_base__color_u32_argb_premul  //\nwuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(uint16_t rgb_565) {\n  uint32_t b5 = 0x1F & (rgb_565 >> 0);\n  uint32_t b = (b5 << 3) | (b5 >> 2);\n  uint32_t g6 = 0x3F & (rgb_565 >> 5);\n  uint32_t g = (g6 << 2) | (g6 >> 4);\n  uint32_t r5 = 0x1F & (rgb_565 >> 11);\n  uint32_t r = (r5 << 3) | (r5 >> 2);\n  return 0xFF000000 | (r << 16) | (g << 8) | (b << 0);\n}\n\n// wuffs_base__color_u32_" +
+	"argb_premul__as__color_u8_gray returns the luma (the\n// gray level) of c, using the JFIF (ITU-R BT.601) weights of 0.299, 0.587 and\n// 0.114 for red, green and blue. The alpha of c is ignored.\nstatic inline uint8_t  //\nwuffs_base__color_u32_argb_premul__as__color_u8_gray(\n    wuffs_base__color_u32_argb_premul c) {\n  // Work in 16-bit color. The weights sum to 0x10000 (65536).\n  uint32_t cr = 0x101 * (0xFF & (c >> 16));\n  uint32_t cg = 0x101 * (0xFF & (c >> 8));\n  uint32_t cb = 0x101 * (0xFF & (c >> 0));\n  uint32_t weighted_average = (19595 * cr) + (38470 * cg) + (7471 * cb) + 32768;\n  return (uint8_t)(weighted_average >> 24);\n}\n\n" +
 	"" +
 	"// --------\n\ntypedef uint8_t wuffs_base__pixel_blend;\n\n// wuffs_base__pixel_blend encodes how to blend source and destination pixels,\n// accounting for transparency. It encompasses the Porter-Duff compositing\n// operators as well as the other blending modes defined by PDF.\n//\n// TODO: implement the other modes.\n#define WUFFS_BASE__PIXEL_BLEND__SRC ((wuffs_base__pixel_blend)0)\n#define WUFFS_BASE__PIXEL_BLEND__SRC_OVER ((wuffs_base__pixel_blend)1)\n\n" +
 	"" +
@@ -277,21 +394,29 @@ const baseImagePublicH = "" +
 	"e__slice_u8 pixbuf_memory) {\n  return wuffs_base__pixel_buffer__set_from_slice(this, pixcfg_arg,\n                                                  pixbuf_memory);\n}\n\ninline wuffs_base__status  //\nwuffs_base__pixel_buffer::set_from_table(\n    const wuffs_base__pixel_config* pixcfg_arg,\n    wuffs_base__table_u8 pixbuf_memory) {\n  return wuffs_base__pixel_buffer__set_from_table(this, pixcfg_arg,\n                                                  pixbuf_memory);\n}\n\ninline wuffs_base__slice_u8  //\nwuffs_base__pixel_buffer::palette() {\n  return wuffs_base__pixel_buffer__palette(this);\n}\n\ninline wuffs_base__pixel_format  //\nwuffs_base__pixel_buffer::pixel_format() const {\n  return wuffs_base__pixel_buffer__pixel_format(this);\n}\n\ninline wuffs_base__table_u8  //\nwuffs_base__pixel_buffer::plane(uint32_t p) {\n  return wuffs_base__pixel_buffer__plane(this, p);\n}\n\ninline wuffs_base__color_u32_argb_premul  //\nwuffs_base__pixel_buffer::color_u32_at(uint32_t x, uint32_t y) const {\n  return wuffs_base__pixel_buffer__color_u32_" +
 	"at(this, x, y);\n}\n\ninline wuffs_base__status  //\nwuffs_base__pixel_buffer::set_color_u32_at(\n    uint32_t x,\n    uint32_t y,\n    wuffs_base__color_u32_argb_premul color) {\n  return wuffs_base__pixel_buffer__set_color_u32_at(this, x, y, color);\n}\n\n#endif  // __cplusplus\n\n" +
 	"" +
-	"// --------\n\ntypedef struct {\n  // Do not access the private_impl's fields directly. There is no API/ABI\n  // compatibility or safety guarantee if you do so.\n  struct {\n    uint8_t TODO;\n  } private_impl;\n\n#ifdef __cplusplus\n#endif  // __cplusplus\n\n} wuffs_base__decode_frame_options;\n\n#ifdef __cplusplus\n\n#endif  // __cplusplus\n\n" +
-	"" +
-	"// --------\n\n// TODO: should the func type take restrict pointers?\ntypedef uint64_t (*wuffs_base__pixel_swizzler__func)(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src);\n\ntypedef struct {\n  // Do not access the private_impl's fields directly. There is no API/ABI\n  // compatibility or safety guarantee if you do so.\n  struct {\n    wuffs_base__pixel_swizzler__func func;\n  } private_impl;\n\n#ifdef __cplusplus\n  inline wuffs_base__status prepare(wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend);\n  inline uint64_t swizzle_interleaved(wuffs_base__slice_u8 dst,\n                                      wuffs_base__slice_u8 dst_palette,\n                                      wuffs_base__slice_u8 src) const;\n#endi" +
-	"f  // __cplusplus\n\n} wuffs_base__pixel_swizzler;\n\nwuffs_base__status  //\nwuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,\n                                    wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend);\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src);\n\n#ifdef __cplusplus\n\ninline wuffs_base__status  //\nwuffs_base__pixel_swizzler::prepare(wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src" +
-	"_palette,\n                                    wuffs_base__pixel_blend blend) {\n  return wuffs_base__pixel_swizzler__prepare(this, dst_format, dst_palette,\n                                             src_format, src_palette, blend);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler::swizzle_interleaved(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) const {\n  return wuffs_base__pixel_swizzler__swizzle_interleaved(this, dst, dst_palette,\n                                                         src);\n}\n\n#endif  // __cplusplus\n" +
+	"// --------\n\n// wuffs_base__decode_frame_options holds optional arguments to an image\n// decoder's decode_frame method. Passing a NULL pointer is equivalent to\n// passing a wuffs_base__null_decode_frame_options() value.\ntypedef struct {\n  // Do not access the private_impl's fields directly. There is no API/ABI\n  // compatibility or safety guarantee if you do so.\n  struct {\n    wuffs_base__rect_ie_u32 dst_clip_rect;\n    bool has_dst_clip_rect;\n    uint32_t scale_log2;\n  } private_impl;\n\n#ifdef __cplusplus\n  inline wuffs_base__rect_ie_u32 dst_clip_rect() const;\n  inline uint32_t scale_denominator() const;\n  inline void set_dst_clip_rect(wuffs_base__rect_ie_u32 r);\n  inline void set_scale_denominator(uint32_t d);\n#endif  // __cplusplus\n\n} wuffs_base__decode_frame_options;\n\nstatic inline wuffs_base__decode_frame_options  //\nwuffs_base__null_decode_frame_options() {\n  wuffs_base__decode_frame_options ret;\n  ret.private_impl.dst_clip_rect = wuffs_base__make_rect_ie_u32(0, 0, 0, 0);\n  ret.private_impl.has_dst_clip_r" +
+	"ect = false;\n  ret.private_impl.scale_log2 = 0;\n  return ret;\n}\n\n// wuffs_base__decode_frame_options__dst_clip_rect returns the region of\n// interest, in the destination pixel buffer's coordinate space. decode_frame\n// does not write any pixels outside of it, and image decoders can skip the\n// work (such as swizzling or, for some formats, reading) for the source\n// pixels that map to outside of it.\n//\n// If set_dst_clip_rect was never called (or o is NULL), it returns the entire\n// (0, 0) to (0xFFFFFFFF, 0xFFFFFFFF) plane, so that nothing is clipped.\nstatic inline wuffs_base__rect_ie_u32  //\nwuffs_base__decode_frame_options__dst_clip_rect(\n    const wuffs_base__decode_frame_options* o) {\n  if (o && o->private_impl.has_dst_clip_rect) {\n    return o->private_impl.dst_clip_rect;\n  }\n  return wuffs_base__make_rect_ie_u32(0, 0, 0xFFFFFFFF, 0xFFFFFFFF);\n}\n\nstatic inline void  //\nwuffs_base__decode_frame_options__set_dst_clip_rect(\n    wuffs_base__decode_frame_options* o,\n    wuffs_base__rect_ie_u32 r) {\n  if (o) {\n" +
+	"    o->private_impl.dst_clip_rect = r;\n    o->private_impl.has_dst_clip_rect = true;\n  }\n}\n\n// wuffs_base__decode_frame_options__scale_denominator returns the factor, 1,\n// 2, 4 or 8, by which decode_frame shrinks the frame in each dimension. A\n// source image of width W and height H is decoded to a destination of width\n// ((W + d - 1) / d) and height ((H + d - 1) / d), where d is the denominator.\n// Image decoders subsample: the source pixel at (x * d, y * d) becomes the\n// destination pixel at (x, y) and the other source pixels are skipped.\n//\n// The dst_clip_rect, frame_dirty_rect and the pixel buffer passed to\n// decode_frame are all in the destination's (scaled) coordinate space. The\n// image_config and frame_config bounds are not scaled.\n//\n// If set_scale_denominator was never called (or o is NULL), it returns 1.\nstatic inline uint32_t  //\nwuffs_base__decode_frame_options__scale_denominator(\n    const wuffs_base__decode_frame_options* o) {\n  return o ? (((uint32_t)1) << (o->private_impl.scale_log2 & 3)" +
+	") : 1;\n}\n\n// wuffs_base__decode_frame_options__scale_log2 returns the base-2 logarithm of\n// the scale_denominator: 0, 1, 2 or 3. Wuffs code relies on that range, so it\n// is enforced here even if the private_impl field was set directly.\nstatic inline uint32_t  //\nwuffs_base__decode_frame_options__scale_log2(\n    const wuffs_base__decode_frame_options* o) {\n  return o ? (o->private_impl.scale_log2 & 3) : 0;\n}\n\n// wuffs_base__decode_frame_options__set_scale_denominator sets the scale\n// denominator. Valid values are 1, 2, 4 and 8. Other values are treated as 1.\nstatic inline void  //\nwuffs_base__decode_frame_options__set_scale_denominator(\n    wuffs_base__decode_frame_options* o,\n    uint32_t d) {\n  if (o) {\n    switch (d) {\n      case 2:\n        o->private_impl.scale_log2 = 1;\n        break;\n      case 4:\n        o->private_impl.scale_log2 = 2;\n        break;\n      case 8:\n        o->private_impl.scale_log2 = 3;\n        break;\n      default:\n        o->private_impl.scale_log2 = 0;\n        break;\n    }\n  }\n}\n\n" +
+	"#ifdef __cplusplus\n\ninline wuffs_base__rect_ie_u32  //\nwuffs_base__decode_frame_options::dst_clip_rect() const {\n  return wuffs_base__decode_frame_options__dst_clip_rect(this);\n}\n\ninline uint32_t  //\nwuffs_base__decode_frame_options::scale_denominator() const {\n  return wuffs_base__decode_frame_options__scale_denominator(this);\n}\n\ninline void  //\nwuffs_base__decode_frame_options::set_dst_clip_rect(\n    wuffs_base__rect_ie_u32 r) {\n  wuffs_base__decode_frame_options__set_dst_clip_rect(this, r);\n}\n\ninline void  //\nwuffs_base__decode_frame_options::set_scale_denominator(uint32_t d) {\n  wuffs_base__decode_frame_options__set_scale_denominator(this, d);\n}\n\n#endif  // __cplusplus\n\n" +
+	"" +
+	"// --------\n\n// TODO: should the func type take restrict pointers?\ntypedef uint64_t (*wuffs_base__pixel_swizzler__func)(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src);\n\ntypedef struct {\n  // Do not access the private_impl's fields directly. There is no API/ABI\n  // compatibility or safety guarantee if you do so.\n  struct {\n    wuffs_base__pixel_swizzler__func func;\n\n    // When func is NULL but src_pixfmt_repr is non-zero, swizzling falls\n    // back to a slower, generic, one-pixel-at-a-time implementation that\n    // uses these three fields. A successful prepare always sets them, as\n    // swizzle_interleaved_subsampled also needs the pixel sizes.\n    uint32_t dst_pixfmt_repr;\n    uint32_t src_pixfmt_repr;\n    wuffs_base__pixel_blend blend;\n  } private_impl;\n\n#ifdef __cplusplus\n  inline wuffs_base__status prepare(wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuf" +
+	"fs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend);\n  inline uint64_t swizzle_interleaved(wuffs_base__slice_u8 dst,\n                                      wuffs_base__slice_u8 dst_palette,\n                                      wuffs_base__slice_u8 src) const;\n  inline uint64_t swizzle_interleaved_subsampled(\n      wuffs_base__slice_u8 dst,\n      wuffs_base__slice_u8 dst_palette,\n      wuffs_base__slice_u8 src,\n      uint32_t x_step) const;\n#endif  // __cplusplus\n\n} wuffs_base__pixel_swizzler;\n\nwuffs_base__status  //\nwuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,\n                                    wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                              " +
+	"      wuffs_base__pixel_blend blend);\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src);\n\n// wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled is like\n// wuffs_base__pixel_swizzler__swizzle_interleaved but only converts every\n// x_step'th source pixel: the source pixel (i * x_step) becomes the\n// destination pixel i. It returns the number of source pixels consumed, which\n// includes the skipped ones. It is at most (x_step * the number of\n// destination pixels written), and the src slice's length limits it too.\n//\n// An x_step of 0 or 1 is equivalent to calling swizzle_interleaved.\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src,\n    uint32_t x_step);\n\n#ifdef __cplusplus\n\ninline wuffs_base__s" +
+	"tatus  //\nwuffs_base__pixel_swizzler::prepare(wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend) {\n  return wuffs_base__pixel_swizzler__prepare(this, dst_format, dst_palette,\n                                             src_format, src_palette, blend);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler::swizzle_interleaved(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) const {\n  return wuffs_base__pixel_swizzler__swizzle_interleaved(this, dst, dst_palette,\n                                                         src);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler::swizzle_interleaved_subsampled(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src,\n    uint32_t x_s" +
+	"tep) const {\n  return wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(\n      this, dst, dst_palette, src, x_step);\n}\n\n#endif  // __cplusplus\n" +
 	""
 
 const baseIOPrivateH = "" +
 	"// ---------------- I/O\n\nstatic inline uint64_t  //\nwuffs_base__io__count_since(uint64_t mark, uint64_t index) {\n  if (index >= mark) {\n    return index - mark;\n  }\n  return 0;\n}\n\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__io__since(uint64_t mark, uint64_t index, uint8_t* ptr) {\n  if (index >= mark) {\n    return wuffs_base__make_slice_u8(ptr + mark, index - mark);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,\n                                             uint8_t* io1_w,\n                                             uint8_t* io2_w,\n                                             uint32_t length,\n                                             uint32_t distance) {\n  if (!distance) {\n    return 0;\n  }\n  uint8_t* p = *ptr_iop_w;\n  if ((size_t)(p - io1_w) < (size_t)(distance)) {\n    return 0;\n  }\n  uint8_t* q = p - distance;\n  size_t n = (size_t)(io2_w - p);\n  if ((size_t)(length) > n) {\n    length = (uint32_t)(n);\n " +
-	" } else {\n    n = (size_t)(length);\n  }\n  // TODO: unrolling by 3 seems best for the std/deflate benchmarks, but that\n  // is mostly because 3 is the minimum length for the deflate format. This\n  // function implementation shouldn't overfit to that one format. Perhaps the\n  // copy_n32_from_history Wuffs method should also take an unroll hint\n  // argument, and the cgen can look if that argument is the constant\n  // expression '3'.\n  //\n  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.\n  //\n  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method\n  // that copies 8 bytes at a time, possibly writing more than length bytes?\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\n// wuffs_base__io_writer__copy_n32_from_history_fast is like the\n// wuffs_base__io_writer__copy_n32_from_history function above, but has\n// stronger pre-conditions. The caller needs to prove" +
-	" that:\n//  - distance >  0\n//  - distance <= (*ptr_iop_w - io1_w)\n//  - length   <= (io2_w      - *ptr_iop_w)\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,\n                                                  uint8_t* io1_w,\n                                                  uint8_t* io2_w,\n                                                  uint32_t length,\n                                                  uint32_t distance) {\n  uint8_t* p = *ptr_iop_w;\n  uint8_t* q = p - distance;\n  uint32_t n = length;\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,\n                                            uint8_t* io2_w,\n                                            uint32_t length,\n                                            uint8_t** ptr_iop_r,\n                             " +
-	"               uint8_t* io2_r) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = length;\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  uint8_t* iop_r = *ptr_iop_r;\n  if (n > ((size_t)(io2_r - iop_r))) {\n    n = (size_t)(io2_r - iop_r);\n  }\n  if (n > 0) {\n    memmove(iop_w, iop_r, n);\n    *ptr_iop_w += n;\n    *ptr_iop_r += n;\n  }\n  return (uint32_t)(n);\n}\n\nstatic inline uint64_t  //\nwuffs_base__io_writer__copy_from_slice(uint8_t** ptr_iop_w,\n                                       uint8_t* io2_w,\n                                       wuffs_base__slice_u8 src) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = src.len;\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint64_t)(n);\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_slice(uint8_t** ptr_iop_w,\n                                           uint8_t* io2_w,\n                                           uint32_t" +
-	" length,\n                                           wuffs_base__slice_u8 src) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = src.len;\n  if (n > length) {\n    n = length;\n  }\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint32_t)(n);\n}\n\n// wuffs_base__io_reader__match7 returns whether the io_reader's upcoming bytes\n// start with the given prefix (up to 7 bytes long). It is peek-like, not\n// read-like, in that there are no side-effects.\n//\n// The low 3 bits of a hold the prefix length, n.\n//\n// The high 56 bits of a hold the prefix itself, in little-endian order. The\n// first prefix byte is in bits 8..=15, the second prefix byte is in bits\n// 16..=23, etc. The high (8 * (7 - n)) bits are ignored.\n//\n// There are three possible return values:\n//  - 0 means success.\n//  - 1 means inconclusive, equivalent to \"$short read\".\n//  - 2 means failure.\nstatic inline uint32_t  //\nwuffs_base__io_reader__match7(ui" +
-	"nt8_t* iop_r,\n                              uint8_t* io2_r,\n                              wuffs_base__io_buffer* r,\n                              uint64_t a) {\n  uint32_t n = a & 7;\n  a >>= 8;\n  if ((io2_r - iop_r) >= 8) {\n    uint64_t x = wuffs_base__load_u64le__no_bounds_check(iop_r);\n    uint32_t shift = 8 * (8 - n);\n    return ((a << shift) == (x << shift)) ? 0 : 2;\n  }\n  for (; n > 0; n--) {\n    if (iop_r >= io2_r) {\n      return (r && r->meta.closed) ? 2 : 1;\n    } else if (*iop_r != ((uint8_t)(a))) {\n      return 2;\n    }\n    iop_r++;\n    a >>= 8;\n  }\n  return 0;\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_reader__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_r,\n                           uint8_t** ptr_io0_r,\n                           uint8_t** ptr_io1_r,\n                           uint8_t** ptr_io2_r,\n                           wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = data.len;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = fal" +
-	"se;\n\n  *ptr_iop_r = data.ptr;\n  *ptr_io0_r = data.ptr;\n  *ptr_io1_r = data.ptr;\n  *ptr_io2_r = data.ptr + data.len;\n\n  return b;\n}\n\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__io_reader__take(uint8_t** ptr_iop_r, uint8_t* io2_r, uint64_t n) {\n  if (n <= ((size_t)(io2_r - *ptr_iop_r))) {\n    uint8_t* p = *ptr_iop_r;\n    *ptr_iop_r += n;\n    return wuffs_base__make_slice_u8(p, n);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_writer__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_w,\n                           uint8_t** ptr_io0_w,\n                           uint8_t** ptr_io1_w,\n                           uint8_t** ptr_io2_w,\n                           wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = 0;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = false;\n\n  *ptr_iop_w = data.ptr;\n  *ptr_io0_w = data.ptr;\n  *ptr_io1_w = data.ptr;\n  *ptr_io2_w = data.ptr + data.len;\n\n  return b;\n}\n\n  " +
+	" } else {\n    n = (size_t)(length);\n  }\n  // TODO: unrolling by 3 seems best for the std/deflate benchmarks, but that\n  // is mostly because 3 is the minimum length for the deflate format. This\n  // function implementation shouldn't overfit to that one format. Perhaps the\n  // copy_n32_from_history Wuffs method should also take an unroll hint\n  // argument, and the cgen can look if that argument is the constant\n  // expression '3'.\n  //\n  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, and the\n  // _8_byte_chunks_fast variant after that, which copies 8 bytes at a time,\n  // possibly writing more than length bytes.\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\n// wuffs_base__io_writer__copy_n32_from_history_fast is like the\n// wuffs_base__io_writer__copy_n32_from_history function above, but has\n// stronger pre-conditions. The caller needs to prove that:\n//  - distance >  0\n//  " +
+	"- distance <= (*ptr_iop_w - io1_w)\n//  - length   <= (io2_w      - *ptr_iop_w)\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,\n                                                  uint8_t* io1_w,\n                                                  uint8_t* io2_w,\n                                                  uint32_t length,\n                                                  uint32_t distance) {\n  uint8_t* p = *ptr_iop_w;\n  uint8_t* q = p - distance;\n  uint32_t n = length;\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\n// wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast is like the\n// wuffs_base__io_writer__copy_n32_from_history_fast function above, but copies\n// 8 bytes at a time, so it can write up to 8 bytes more than the length bytes\n// it copies. Those excess bytes are not part of the output (*ptr_iop_w is\n// only advanced by lengt" +
+	"h) and will be overwritten by later writes. The\n// caller needs to prove that:\n//  - distance >  0\n//  - distance <= (*ptr_iop_w - io1_w)\n//  - (length + 8) <= (io2_w - *ptr_iop_w)\n//\n// A distance of at least 8 means that each 8 byte chunk's source is entirely\n// before its destination. Distances of 1, 2 and 4 (runs of a repeated byte or\n// pattern) broadcast that pattern to 8 bytes and store it repeatedly. Other\n// distances copy one byte at a time.\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(\n    uint8_t** ptr_iop_w,\n    uint8_t* io1_w,\n    uint8_t* io2_w,\n    uint32_t length,\n    uint32_t distance) {\n  uint8_t* p = *ptr_iop_w;\n  uint8_t* q = p - distance;\n  uint32_t n = length;\n  if (distance >= 8) {\n    while (true) {\n      memcpy(p, q, 8);\n      if (n <= 8) {\n        break;\n      }\n      p += 8;\n      q += 8;\n      n -= 8;\n    }\n  } else if ((distance == 1) || (distance == 2) || (distance == 4)) {\n    uint64_t x;\n    if (distance == 1) {\n      x = 0x0101010" +
+	"101010101 * ((uint64_t)(q[0]));\n    } else if (distance == 2) {\n      x = 0x0001000100010001 *\n          ((uint64_t)(wuffs_base__load_u16le__no_bounds_check(q)));\n    } else {\n      x = 0x0000000100000001 *\n          ((uint64_t)(wuffs_base__load_u32le__no_bounds_check(q)));\n    }\n    while (true) {\n      wuffs_base__store_u64le__no_bounds_check(p, x);\n      if (n <= 8) {\n        break;\n      }\n      p += 8;\n      n -= 8;\n    }\n  } else {\n    for (; n >= 3; n -= 3) {\n      *p++ = *q++;\n      *p++ = *q++;\n      *p++ = *q++;\n    }\n    for (; n; n--) {\n      *p++ = *q++;\n    }\n  }\n  *ptr_iop_w += length;\n  return length;\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,\n                                            uint8_t* io2_w,\n                                            uint32_t length,\n                                            uint8_t** ptr_iop_r,\n                                            uint8_t* io2_r) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = length;\n  if" +
+	" (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  uint8_t* iop_r = *ptr_iop_r;\n  if (n > ((size_t)(io2_r - iop_r))) {\n    n = (size_t)(io2_r - iop_r);\n  }\n  if (n > 0) {\n    memmove(iop_w, iop_r, n);\n    *ptr_iop_w += n;\n    *ptr_iop_r += n;\n  }\n  return (uint32_t)(n);\n}\n\nstatic inline uint64_t  //\nwuffs_base__io_writer__copy_from_slice(uint8_t** ptr_iop_w,\n                                       uint8_t* io2_w,\n                                       wuffs_base__slice_u8 src) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = src.len;\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint64_t)(n);\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_slice(uint8_t** ptr_iop_w,\n                                           uint8_t* io2_w,\n                                           uint32_t length,\n                                           wuffs_base__slice_u8 src) {\n  uint8_t" +
+	"* iop_w = *ptr_iop_w;\n  size_t n = src.len;\n  if (n > length) {\n    n = length;\n  }\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint32_t)(n);\n}\n\n// wuffs_base__io_reader__match7 returns whether the io_reader's upcoming bytes\n// start with the given prefix (up to 7 bytes long). It is peek-like, not\n// read-like, in that there are no side-effects.\n//\n// The low 3 bits of a hold the prefix length, n.\n//\n// The high 56 bits of a hold the prefix itself, in little-endian order. The\n// first prefix byte is in bits 8..=15, the second prefix byte is in bits\n// 16..=23, etc. The high (8 * (7 - n)) bits are ignored.\n//\n// There are three possible return values:\n//  - 0 means success.\n//  - 1 means inconclusive, equivalent to \"$short read\".\n//  - 2 means failure.\nstatic inline uint32_t  //\nwuffs_base__io_reader__match7(uint8_t* iop_r,\n                              uint8_t* io2_r,\n                             " +
+	" wuffs_base__io_buffer* r,\n                              uint64_t a) {\n  uint32_t n = a & 7;\n  a >>= 8;\n  if ((io2_r - iop_r) >= 8) {\n    uint64_t x = wuffs_base__load_u64le__no_bounds_check(iop_r);\n    uint32_t shift = 8 * (8 - n);\n    return ((a << shift) == (x << shift)) ? 0 : 2;\n  }\n  for (; n > 0; n--) {\n    if (iop_r >= io2_r) {\n      return (r && r->meta.closed) ? 2 : 1;\n    } else if (*iop_r != ((uint8_t)(a))) {\n      return 2;\n    }\n    iop_r++;\n    a >>= 8;\n  }\n  return 0;\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_reader__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_r,\n                           uint8_t** ptr_io0_r,\n                           uint8_t** ptr_io1_r,\n                           uint8_t** ptr_io2_r,\n                           wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = data.len;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = false;\n\n  *ptr_iop_r = data.ptr;\n  *ptr_io0_r = data.ptr;\n  *ptr_io1_r = data.ptr;\n  *ptr_io" +
+	"2_r = data.ptr + data.len;\n\n  return b;\n}\n\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__io_reader__take(uint8_t** ptr_iop_r, uint8_t* io2_r, uint64_t n) {\n  if (n <= ((size_t)(io2_r - *ptr_iop_r))) {\n    uint8_t* p = *ptr_iop_r;\n    *ptr_iop_r += n;\n    return wuffs_base__make_slice_u8(p, n);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_writer__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_w,\n                           uint8_t** ptr_io0_w,\n                           uint8_t** ptr_io1_w,\n                           uint8_t** ptr_io2_w,\n                           wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = 0;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = false;\n\n  *ptr_iop_w = data.ptr;\n  *ptr_io0_w = data.ptr;\n  *ptr_io1_w = data.ptr;\n  *ptr_io2_w = data.ptr + data.len;\n\n  return b;\n}\n\n  " +
 	"" +
 	"// ---------------- I/O (Utility)\n\n#define wuffs_base__utility__empty_io_reader wuffs_base__empty_io_reader\n#define wuffs_base__utility__empty_io_writer wuffs_base__empty_io_writer\n" +
 	""
@@ -307,7 +432,7 @@ const baseIOPublicH = "" +
 
 const baseRangePrivateH = "" +
 	"// ---------------- Ranges and Rects\n\nstatic inline uint32_t  //\nwuffs_base__range_ii_u32__get_min_incl(const wuffs_base__range_ii_u32* r) {\n  return r->min_incl;\n}\n\nstatic inline uint32_t  //\nwuffs_base__range_ii_u32__get_max_incl(const wuffs_base__range_ii_u32* r) {\n  return r->max_incl;\n}\n\nstatic inline uint32_t  //\nwuffs_base__range_ie_u32__get_min_incl(const wuffs_base__range_ie_u32* r) {\n  return r->min_incl;\n}\n\nstatic inline uint32_t  //\nwuffs_base__range_ie_u32__get_max_excl(const wuffs_base__range_ie_u32* r) {\n  return r->max_excl;\n}\n\nstatic inline uint64_t  //\nwuffs_base__range_ii_u64__get_min_incl(const wuffs_base__range_ii_u64* r) {\n  return r->min_incl;\n}\n\nstatic inline uint64_t  //\nwuffs_base__range_ii_u64__get_max_incl(const wuffs_base__range_ii_u64* r) {\n  return r->max_incl;\n}\n\nstatic inline uint64_t  //\nwuffs_base__range_ie_u64__get_min_incl(const wuffs_base__range_ie_u64* r) {\n  return r->min_incl;\n}\n\nstatic inline uint64_t  //\nwuffs_base__range_ie_u64__get_max_excl(const wuffs_base__range_" +
-	"ie_u64* r) {\n  return r->max_excl;\n}\n\n" +
+	"ie_u64* r) {\n  return r->max_excl;\n}\n\nstatic inline uint32_t  //\nwuffs_base__rect_ie_u32__get_min_incl_x(const wuffs_base__rect_ie_u32* r) {\n  return r->min_incl_x;\n}\n\nstatic inline uint32_t  //\nwuffs_base__rect_ie_u32__get_min_incl_y(const wuffs_base__rect_ie_u32* r) {\n  return r->min_incl_y;\n}\n\nstatic inline uint32_t  //\nwuffs_base__rect_ie_u32__get_max_excl_x(const wuffs_base__rect_ie_u32* r) {\n  return r->max_excl_x;\n}\n\nstatic inline uint32_t  //\nwuffs_base__rect_ie_u32__get_max_excl_y(const wuffs_base__rect_ie_u32* r) {\n  return r->max_excl_y;\n}\n\n" +
 	"" +
 	"// ---------------- Ranges and Rects (Utility)\n\n#define wuffs_base__utility__empty_range_ii_u32 wuffs_base__empty_range_ii_u32\n#define wuffs_base__utility__empty_range_ie_u32 wuffs_base__empty_range_ie_u32\n#define wuffs_base__utility__empty_range_ii_u64 wuffs_base__empty_range_ii_u64\n#define wuffs_base__utility__empty_range_ie_u64 wuffs_base__empty_range_ie_u64\n#define wuffs_base__utility__empty_rect_ii_u32 wuffs_base__empty_rect_ii_u32\n#define wuffs_base__utility__empty_rect_ie_u32 wuffs_base__empty_rect_ie_u32\n#define wuffs_base__utility__make_range_ii_u32 wuffs_base__make_range_ii_u32\n#define wuffs_base__utility__make_range_ie_u32 wuffs_base__make_range_ie_u32\n#define wuffs_base__utility__make_range_ii_u64 wuffs_base__make_range_ii_u64\n#define wuffs_base__utility__make_range_ie_u64 wuffs_base__make_range_ie_u64\n#define wuffs_base__utility__make_rect_ii_u32 wuffs_base__make_rect_ii_u32\n#define wuffs_base__utility__make_rect_ie_u32 wuffs_base__make_rect_ie_u32\n" +
 	""
@@ -357,9 +482,16 @@ const baseStrConvPublicH = "" +
 	"//  - It does not take an optional endptr argument. It does not allow a partial\n//    parse: it returns an error unless all of s is consumed.\n//  - It does not allow whitespace, leading or otherwise.\n//  - It does not allow a leading '+' or '-'.\n//  - It does not allow unnecessary leading zeroes (\"0\" is valid and its sole\n//    zero is necessary). All of \"00\", \"0644\" and \"007\" are invalid.\n//  - It does not take a base argument (e.g. base 10 vs base 16). Instead, it\n//    always accepts both decimal (e.g \"1234\", \"0d5678\") and hexadecimal (e.g.\n//    \"0x9aBC\"). The caller is responsible for prior filtering of e.g. hex\n//    numbers if they are unwanted. For example, Wuffs' JSON decoder will only\n//    produce a wuffs_base__token for decimal numbers, not hexadecimal.\n//  - It is not affected by i18n / l10n settings such as environment variables.\n//  - It does allow arbitrary underscores, except inside the optional 2-byte\n//    opening \"0d\" or \"0X\" that denotes base-10 or base-16. For example,\n//    \"__0D_1_002\"" +
 	" would successfully parse as \"one thousand and two\".\nwuffs_base__result_u64  //\nwuffs_base__parse_number_u64(wuffs_base__slice_u8 s);\n\n" +
 	"" +
+	"// --------\n\n// WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL is the maximum number of bytes that\n// wuffs_base__render_number_i64 writes: the 20 bytes of\n// \"-9223372036854775808\".\n#define WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL 20\n\n// WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL is the maximum number of bytes that\n// wuffs_base__render_number_u64 writes: the 21 bytes of\n// \"+18446744073709551615\", including the optional leading '+'.\n#define WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL 21\n\n// Options (bitwise or'ed together) for the wuffs_base__render_number_xxx\n// functions. The XXX options apply to both integer and floating point. The\n// FXX options apply only to floating point.\n\n#define WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS ((uint32_t)0x00000000)\n\n// WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT means to render to the right side\n// (higher indexes) of the destination slice, leaving any untouched bytes on\n// the left side (lower indexes). The default is vice versa: rendering on the\n// left with slack on the right.\n#defi" +
+	"ne WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT ((uint32_t)0x00000100)\n\n// WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN means to render the leading\n// \"+\" for non-negative numbers: \"+0\" and \"+12.3\" instead of \"0\" and \"12.3\".\n#define WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN ((uint32_t)0x00000200)\n\n// WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA means to render\n// one-and-a-half as \"1,5\" instead of \"1.5\".\n#define WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA \\\n  ((uint32_t)0x00001000)\n\n// WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ETC means whether to never\n// (EXPONENT_ABSENT, equivalent to printf's \"%f\") or to always\n// (EXPONENT_PRESENT, equivalent to printf's \"%e\") render a floating point\n// number as \"1.23e+05\" instead of \"123000\".\n//\n// Having both bits set is the same as having neither bit set, where the\n// notation used depends on whether the exponent is sufficiently large: \"0.5\"\n// is preferred over \"5e-01\" but \"5e-09\" is preferred over \"0.000000005\".\n#define WUFFS_B" +
+	"ASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT ((uint32_t)0x00002000)\n#define WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT ((uint32_t)0x00004000)\n\n// WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION means to render the\n// smallest number of digits so that parsing the resultant string will recover\n// the same double-precision floating point number.\n//\n// For example, double-precision cannot represent 0.3 exactly, but parsing\n// \"0.3\" will return the closest double-precision number, and so rendering\n// with this option will give \"0.3\" instead of \"0.299999999999999988898\".\n#define WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION \\\n  ((uint32_t)0x00008000)\n\n// wuffs_base__render_number_i64 writes the decimal encoding of x to dst and\n// returns the number of bytes written. If dst is shorter than the entire\n// encoding, it returns 0 (and no bytes are written).\n//\n// dst will never be too short if its length is at least 20, also known as\n// WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL.\n//\n// It is similar to the C sta" +
+	"ndard library's snprintf with \"%\" PRIi64, but it\n// does not write a terminating NUL byte and is not affected by i18n / l10n\n// settings such as environment variables.\nsize_t  //\nwuffs_base__render_number_i64(wuffs_base__slice_u8 dst,\n                              int64_t x,\n                              uint32_t options);\n\n// wuffs_base__render_number_u64 writes the decimal encoding of x to dst and\n// returns the number of bytes written. If dst is shorter than the entire\n// encoding, it returns 0 (and no bytes are written).\n//\n// dst will never be too short if its length is at least 21, also known as\n// WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL.\nsize_t  //\nwuffs_base__render_number_u64(wuffs_base__slice_u8 dst,\n                              uint64_t x,\n                              uint32_t options);\n\n" +
+	"" +
 	"// ---------------- IEEE 754 Floating Point\n\n// wuffs_base__parse_number_f64 parses the floating point number in s. For\n// example, if s contains the bytes \"1.5\" then it will return the double 1.5.\n//\n// It returns an error if s does not contain a floating point number.\n//\n// It does not necessarily return an error if the conversion is lossy, e.g. if\n// s is \"0.3\", which double-precision floating point cannot represent exactly.\n//\n// Similarly, the returned value may be infinite (and no error returned) even\n// if s was not \"inf\", when the input is nominally finite but sufficiently\n// larger than DBL_MAX, about 1.8e+308.\n//\n// It is similar to the C standard library's strtod function, but:\n//  - Errors are returned in-band (in a result type), not out-of-band (errno).\n//  - It takes a slice (a pointer and length), not a NUL-terminated C string.\n//  - It does not take an optional endptr argument. It does not allow a partial\n//    parse: it returns an error unless all of s is consumed.\n//  - It does not allow whi" +
 	"tespace, leading or otherwise.\n//  - It does not allow unnecessary leading zeroes (\"0\" is valid and its sole\n//    zero is necessary). All of \"00\", \"0644\" and \"00.7\" are invalid.\n//  - It is not affected by i18n / l10n settings such as environment variables.\n//  - Conversely, it always accepts either ',' or '.' as a decimal separator.\n//    In particular, \"3,141,592\" is always invalid but \"3,141\" is always valid\n//    (and approximately π). The caller is responsible for e.g. previously\n//    rejecting or filtering s if it contains a comma, if that is unacceptable\n//    to the caller. For example, JSON numbers always use a dot '.' and never a\n//    comma ',', regardless of the LOCALE environment variable.\n//  - It does allow arbitrary underscores. For example, \"_3.141_592\" would\n//    successfully parse, again approximately π.\n//  - It does allow \"inf\", \"+Infinity\" and \"-NAN\", case insensitive, but it\n//    does not permit \"nan\" to be followed by an integer mantissa.\n//  - It does not allow hexadecimal float" +
-	"ing point numbers.\nwuffs_base__result_f64  //\nwuffs_base__parse_number_f64(wuffs_base__slice_u8 s);\n\n// wuffs_base__ieee_754_bit_representation__etc converts between a double\n// precision numerical value and its IEEE 754 64-bit representation (1 sign\n// bit, 11 exponent bits, 52 explicit significand bits).\n//\n// For example, it converts between:\n//  - +1.0 and 0x3FF0_0000_0000_0000.\n//  - +5.5 and 0x4016_0000_0000_0000.\n//  - -inf and 0xFFF0_0000_0000_0000.\n//\n// See https://en.wikipedia.org/wiki/Double-precision_floating-point_format\n\nstatic inline uint64_t  //\nwuffs_base__ieee_754_bit_representation__from_f64(double f) {\n  uint64_t u = 0;\n  if (sizeof(uint64_t) == sizeof(double)) {\n    memcpy(&u, &f, sizeof(uint64_t));\n  }\n  return u;\n}\n\nstatic inline double  //\nwuffs_base__ieee_754_bit_representation__to_f64(uint64_t u) {\n  double f = 0;\n  if (sizeof(uint64_t) == sizeof(double)) {\n    memcpy(&f, &u, sizeof(uint64_t));\n  }\n  return f;\n}\n\n" +
+	"ing point numbers.\nwuffs_base__result_f64  //\nwuffs_base__parse_number_f64(wuffs_base__slice_u8 s);\n\n// wuffs_base__render_number_f64 writes the decimal encoding of x to dst and\n// returns the number of bytes written. If dst is shorter than the entire\n// encoding, it returns 0 (and no bytes are written).\n//\n// For those familiar with C's printf or Go's fmt.Printf functions:\n//  - \"%e\" means the WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT option.\n//  - \"%f\" means the WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT  option.\n//  - \"%g\" means neither or both bits are set.\n//\n// The precision argument controls the number of digits rendered, excluding\n// the exponent (the \"e+05\" in \"1.23e+05\"):\n//  - for \"%e\" and \"%f\" it is the number of digits after the decimal separator,\n//  - for \"%g\" it is the number of significant digits (and trailing zeroes are\n//    removed).\n//\n// A precision of 6 gives the same output as printf's defaults. A precision\n// greater than 4095 is equivalent to 4095. Digits after the first 50" +
+	"0\n// significant digits (which only matter for very large precisions) are\n// rendered as '0'.\n//\n// The precision argument is ignored when the\n// WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION option is set. This is\n// similar to Go's strconv.FormatFloat with a negative precision, but there is\n// no corresponding feature in C's printf. With that option, \"%g\" uses the\n// exponent notation when the decimal exponent is less than -6 or at least\n// 21, like JavaScript's Number.prototype.toString.\n//\n// Extreme values of x will be rendered as \"NaN\", \"Inf\" (or \"+Inf\" if the\n// WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN option is set) or \"-Inf\".\n//\n// Like wuffs_base__render_number_i64, it does not write a terminating NUL\n// byte and is not affected by i18n / l10n settings such as environment\n// variables.\nsize_t  //\nwuffs_base__render_number_f64(wuffs_base__slice_u8 dst,\n                              double x,\n                              uint32_t precision,\n                              uint32_t option" +
+	"s);\n\n// wuffs_base__ieee_754_bit_representation__etc converts between a double\n// precision numerical value and its IEEE 754 64-bit representation (1 sign\n// bit, 11 exponent bits, 52 explicit significand bits).\n//\n// For example, it converts between:\n//  - +1.0 and 0x3FF0_0000_0000_0000.\n//  - +5.5 and 0x4016_0000_0000_0000.\n//  - -inf and 0xFFF0_0000_0000_0000.\n//\n// See https://en.wikipedia.org/wiki/Double-precision_floating-point_format\n\nstatic inline uint64_t  //\nwuffs_base__ieee_754_bit_representation__from_f64(double f) {\n  uint64_t u = 0;\n  if (sizeof(uint64_t) == sizeof(double)) {\n    memcpy(&u, &f, sizeof(uint64_t));\n  }\n  return u;\n}\n\nstatic inline double  //\nwuffs_base__ieee_754_bit_representation__to_f64(uint64_t u) {\n  double f = 0;\n  if (sizeof(uint64_t) == sizeof(double)) {\n    memcpy(&f, &u, sizeof(uint64_t));\n  }\n  return f;\n}\n\n" +
 	"" +
 	"// ---------------- Hexadecimal\n\n// wuffs_base__hexadecimal__decode2 converts \"6A6b\" to \"jk\", where e.g. 'j' is\n// U+006A. There are 2 source bytes for every destination byte.\n//\n// It returns the number of dst bytes written: the minimum of dst.len and\n// (src.len / 2). Excess source bytes are ignored.\n//\n// It assumes that the src bytes are two hexadecimal digits (0-9, A-F, a-f),\n// repeated. It may write nonsense bytes if not, although it will not read or\n// write out of bounds.\nsize_t  //\nwuffs_base__hexadecimal__decode2(wuffs_base__slice_u8 dst,\n                                 wuffs_base__slice_u8 src);\n\n// wuffs_base__hexadecimal__decode4 converts \"\\\\x6A\\\\x6b\" to \"jk\", where e.g.\n// 'j' is U+006A. There are 4 source bytes for every destination byte.\n//\n// It returns the number of dst bytes written: the minimum of dst.len and\n// (src.len / 4). Excess source bytes are ignored.\n//\n// It assumes that the src bytes are two ignored bytes and then two hexadecimal\n// digits (0-9, A-F, a-f), repeated. It may wri" +
 	"te nonsense bytes if not,\n// although it will not read or write out of bounds.\nsize_t  //\nwuffs_base__hexadecimal__decode4(wuffs_base__slice_u8 dst,\n                                 wuffs_base__slice_u8 src);\n\n" +
@@ -404,7 +536,8 @@ const baseTokenPublicH = "" +
 	"egory(const wuffs_base__token* t) {\n  return ((int64_t)(t->repr)) >> WUFFS_BASE__TOKEN__VALUE_BASE_CATEGORY__SHIFT;\n}\n\nstatic inline uint64_t  //\nwuffs_base__token__value_minor(const wuffs_base__token* t) {\n  return (t->repr >> WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) & 0x1FFFFFF;\n}\n\nstatic inline uint64_t  //\nwuffs_base__token__value_base_detail(const wuffs_base__token* t) {\n  return (t->repr >> WUFFS_BASE__TOKEN__VALUE_BASE_DETAIL__SHIFT) & 0x1FFFFF;\n}\n\nstatic inline bool  //\nwuffs_base__token__continued(const wuffs_base__token* t) {\n  return t->repr & 0x10000;\n}\n\nstatic inline uint64_t  //\nwuffs_base__token__length(const wuffs_base__token* t) {\n  return (t->repr >> WUFFS_BASE__TOKEN__LENGTH__SHIFT) & 0xFFFF;\n}\n\n#ifdef __cplusplus\n\ninline int64_t  //\nwuffs_base__token::value() const {\n  return wuffs_base__token__value(this);\n}\n\ninline int64_t  //\nwuffs_base__token::value_extension() const {\n  return wuffs_base__token__value_extension(this);\n}\n\ninline int64_t  //\nwuffs_base__token::value_major() const {\n  retu" +
 	"rn wuffs_base__token__value_major(this);\n}\n\ninline int64_t  //\nwuffs_base__token::value_base_category() const {\n  return wuffs_base__token__value_base_category(this);\n}\n\ninline uint64_t  //\nwuffs_base__token::value_minor() const {\n  return wuffs_base__token__value_minor(this);\n}\n\ninline uint64_t  //\nwuffs_base__token::value_base_detail() const {\n  return wuffs_base__token__value_base_detail(this);\n}\n\ninline bool  //\nwuffs_base__token::continued() const {\n  return wuffs_base__token__continued(this);\n}\n\ninline uint64_t  //\nwuffs_base__token::length() const {\n  return wuffs_base__token__length(this);\n}\n\n#endif  // __cplusplus\n\n" +
 	"" +
-	"// --------\n\ntypedef WUFFS_BASE__SLICE(wuffs_base__token) wuffs_base__slice_token;\n\nstatic inline wuffs_base__slice_token  //\nwuffs_base__make_slice_token(wuffs_base__token* ptr, size_t len) {\n  wuffs_base__slice_token ret;\n  ret.ptr = ptr;\n  ret.len = len;\n  return ret;\n}\n\n" +
+	"// --------\n\ntypedef WUFFS_BASE__SLICE(wuffs_base__token) wuffs_base__slice_token;\n\nstatic inline wuffs_base__slice_token  //\nwuffs_base__make_slice_token(wuffs_base__token* ptr, size_t len) {\n  wuffs_base__slice_token ret;\n  ret.ptr = ptr;\n  ret.len = len;\n  return ret;\n}\n\n// wuffs_base__slice_token__source_positions fills a side table of absolute\n// source positions, for callers (such as indexers that later want to seek\n// straight to a JSON value) that would otherwise each keep their own running\n// sum of token lengths.\n//\n// A token stream's tokens are contiguous: each token starts where the previous\n// one ended. Given pos, the source position of tokens.ptr[0], it sets\n// dst.ptr[i] to the source position of tokens.ptr[i], for each i less than\n// both dst.len and tokens.len. It returns the source position just after the\n// last token processed.\n//\n// A typical pos is the wuffs_base__io_buffer__reader_io_position of the source\n// buffer before the first decode_tokens call. Passing each return value as the" +
+	"\n// next call's pos then keeps the positions correct across multiple\n// decode_tokens calls, even as the source and token buffers are compacted.\nstatic inline uint64_t  //\nwuffs_base__slice_token__source_positions(wuffs_base__slice_u64 dst,\n                                          wuffs_base__slice_token tokens,\n                                          uint64_t pos) {\n  size_t n = (dst.len < tokens.len) ? dst.len : tokens.len;\n  size_t i;\n  for (i = 0; i < n; i++) {\n    dst.ptr[i] = pos;\n    pos += wuffs_base__token__length(&tokens.ptr[i]);\n  }\n  return pos;\n}\n\n" +
 	"" +
 	"// --------\n\n// wuffs_base__token_buffer_meta is the metadata for a\n// wuffs_base__token_buffer's data.\ntypedef struct {\n  size_t wi;     // Write index. Invariant: wi <= len.\n  size_t ri;     // Read  index. Invariant: ri <= wi.\n  uint64_t pos;  // Position of the buffer start relative to the stream start.\n  bool closed;   // No further writes are expected.\n} wuffs_base__token_buffer_meta;\n\n// wuffs_base__token_buffer is a 1-dimensional buffer (a pointer and length)\n// plus additional metadata.\n//\n// A value with all fields zero is a valid, empty buffer.\ntypedef struct {\n  wuffs_base__slice_token data;\n  wuffs_base__token_buffer_meta meta;\n\n#ifdef __cplusplus\n  inline bool is_valid() const;\n  inline void compact();\n  inline uint64_t reader_available() const;\n  inline uint64_t reader_token_position() const;\n  inline uint64_t writer_available() const;\n  inline uint64_t writer_token_position() const;\n#endif  // __cplusplus\n\n} wuffs_base__token_buffer;\n\nstatic inline wuffs_base__token_buffer  //\nwuffs_base__make" +
 	"_token_buffer(wuffs_base__slice_token data,\n                              wuffs_base__token_buffer_meta meta) {\n  wuffs_base__token_buffer ret;\n  ret.data = data;\n  ret.meta = meta;\n  return ret;\n}\n\nstatic inline wuffs_base__token_buffer_meta  //\nwuffs_base__make_token_buffer_meta(size_t wi,\n                                   size_t ri,\n                                   uint64_t pos,\n                                   bool closed) {\n  wuffs_base__token_buffer_meta ret;\n  ret.wi = wi;\n  ret.ri = ri;\n  ret.pos = pos;\n  ret.closed = closed;\n  return ret;\n}\n\nstatic inline wuffs_base__token_buffer  //\nwuffs_base__slice_token__reader(wuffs_base__slice_token s, bool closed) {\n  wuffs_base__token_buffer ret;\n  ret.data.ptr = s.ptr;\n  ret.data.len = s.len;\n  ret.meta.wi = s.len;\n  ret.meta.ri = 0;\n  ret.meta.pos = 0;\n  ret.meta.closed = closed;\n  return ret;\n}\n\nstatic inline wuffs_base__token_buffer  //\nwuffs_base__slice_token__writer(wuffs_base__slice_token s) {\n  wuffs_base__token_buffer ret;\n  ret.data.ptr = s.ptr" +
@@ -30,6 +30,12 @@ func (g *gen) writeExpr(b *buffer, n *a.Expr, depth uint32) error {
 	if cv := n.ConstValue(); cv != nil {
 		if typ := n.MType(); typ.IsNumTypeOrIdeal() {
 			b.writes(cv.String())
+			// A decimal C integer constant that doesn't fit in an int64_t
+			// needs a suffix, lest the compiler warn that it is "so large
+			// that it is unsigned".
+			if cv.Cmp(maxInt64) > 0 {
+				b.writes("u")
+			}
 		} else if typ.IsNullptr() {
 			b.writes("NULL")
 		} else if typ.IsStatus() {
@@ -484,6 +490,8 @@ var cTypeNames = [...]string{
 	t.IDIOWriter:    "wuffs_base__io_buffer*",
 	t.IDTokenReader: "wuffs_base__token_buffer*",
 	t.IDTokenWriter: "wuffs_base__token_buffer*",
+
+	t.IDX86M128I: "__m128i",
 }
 
 const noSuchCOperator = " no_such_C_operator "
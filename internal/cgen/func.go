@@ -79,15 +79,47 @@ func (g *gen) funcCName(n *a.Func) string {
 
 // writeFunctionSignature modes.
 const (
-	wfsCDecl         = 0
-	wfsCppDecl       = 1
-	wfsCFuncPtrField = 2
-	wfsCFuncPtrType  = 3
+	wfsCDecl               = 0
+	wfsCppDecl             = 1
+	wfsCFuncPtrField       = 2
+	wfsCFuncPtrType        = 3
+	wfsCChoosyDefaultDecl  = 4
+	wfsCChoosyFuncPtrField = 5
 )
 
+// cpuArchCGuard returns the C preprocessor macro that guards code for the
+// given CPU architecture, such as t.IDX86SSE42.
+func cpuArchCGuard(cpuArch t.ID) string {
+	switch cpuArch {
+	case t.IDX86SSE42:
+		return "WUFFS_BASE__CPU_ARCH__X86_64"
+	}
+	return ""
+}
+
+// cpuArchCTarget returns the argument to WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET
+// for the given CPU architecture.
+func cpuArchCTarget(cpuArch t.ID) string {
+	switch cpuArch {
+	case t.IDX86SSE42:
+		return "pclmul,popcnt,sse4.2"
+	}
+	return ""
+}
+
+// cpuArchCHave returns the C function that checks, at run time, whether the
+// CPU supports the given CPU architecture.
+func cpuArchCHave(cpuArch t.ID) string {
+	switch cpuArch {
+	case t.IDX86SSE42:
+		return "wuffs_base__cpu_arch__have_x86_sse42"
+	}
+	return ""
+}
+
 func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 	switch wfs {
-	case wfsCDecl:
+	case wfsCDecl, wfsCChoosyDefaultDecl:
 		if n.Public() {
 			b.writes("WUFFS_BASE__MAYBE_STATIC ")
 		} else {
@@ -97,7 +129,7 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 	case wfsCppDecl:
 		b.writes("inline ")
 
-	case wfsCFuncPtrField, wfsCFuncPtrType:
+	case wfsCFuncPtrField, wfsCFuncPtrType, wfsCChoosyFuncPtrField:
 		// No-op.
 	}
 
@@ -113,15 +145,23 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 
 	// The empty // comment makes clang-format place the function name at the
 	// start of a line.
-	if (wfs != wfsCFuncPtrField) && (wfs != wfsCFuncPtrType) {
+	if (wfs != wfsCFuncPtrField) && (wfs != wfsCFuncPtrType) && (wfs != wfsCChoosyFuncPtrField) {
 		b.writes("//\n")
 	}
 
 	comma := false
 	switch wfs {
-	case wfsCDecl:
-		b.writes(g.funcCName(n))
-		b.writeb('(')
+	case wfsCDecl, wfsCChoosyDefaultDecl, wfsCChoosyFuncPtrField:
+		switch wfs {
+		case wfsCDecl:
+			b.writes(g.funcCName(n))
+			b.writeb('(')
+		case wfsCChoosyDefaultDecl:
+			b.writes(g.funcCName(n))
+			b.writes("__choosy_default(")
+		case wfsCChoosyFuncPtrField:
+			b.printf("(*choosy_%s)(", n.FuncName().Str(g.tm))
+		}
 		if r := n.Receiver(); !r.IsZero() {
 			if n.Effect().Pure() {
 				b.writes("const ")
@@ -173,10 +213,24 @@ func (g *gen) writeFuncSignature(b *buffer, n *a.Func, wfs uint32) error {
 }
 
 func (g *gen) writeFuncPrototype(b *buffer, n *a.Func) error {
+	guard := cpuArchCGuard(n.CPUArch())
+	if guard != "" {
+		b.printf("#if defined(%s)\n", guard)
+	}
+	if n.Choosy() {
+		if err := g.writeFuncSignature(b, n, wfsCChoosyDefaultDecl); err != nil {
+			return err
+		}
+		b.writes(";\n\n")
+	}
 	if err := g.writeFuncSignature(b, n, wfsCDecl); err != nil {
 		return err
 	}
-	b.writes(";\n\n")
+	b.writes(";\n")
+	if guard != "" {
+		b.printf("#endif  // defined(%s)\n", guard)
+	}
+	b.writes("\n")
 	return nil
 }
 
@@ -184,7 +238,29 @@ func (g *gen) writeFuncImpl(b *buffer, n *a.Func) error {
 	k := g.funks[n.QQID()]
 
 	b.printf("// -------- func %s.%s\n\n", g.pkgName, n.QQID().Str(g.tm))
-	if err := g.writeFuncSignature(b, n, wfsCDecl); err != nil {
+
+	wfs := uint32(wfsCDecl)
+	if n.Choosy() {
+		// The choosy func dispatches, via a function pointer, to either the
+		// "choosy_default" implementation (the func body) or to a cpu_arch
+		// func picked by a choose statement.
+		if err := g.writeFuncSignature(b, n, wfsCDecl); err != nil {
+			return err
+		}
+		b.printf("{\nreturn (*self->private_impl.choosy_%s)(self", n.FuncName().Str(g.tm))
+		for _, o := range n.In().Fields() {
+			b.printf(", %s%s", aPrefix, o.AsField().Name().Str(g.tm))
+		}
+		b.writes(");\n}\n\n")
+		wfs = wfsCChoosyDefaultDecl
+	}
+
+	guard := cpuArchCGuard(n.CPUArch())
+	if guard != "" {
+		b.printf("#if defined(%s)\n", guard)
+		b.printf("WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(\"%s\")\n", cpuArchCTarget(n.CPUArch()))
+	}
+	if err := g.writeFuncSignature(b, n, wfs); err != nil {
 		return err
 	}
 	b.writes("{\n")
@@ -203,7 +279,11 @@ func (g *gen) writeFuncImpl(b *buffer, n *a.Func) error {
 	}
 
 	b.writex(k.bEpilogue)
-	b.writes("}\n\n")
+	b.writes("}\n")
+	if guard != "" {
+		b.printf("#endif  // defined(%s)\n", guard)
+	}
+	b.writes("\n")
 	return nil
 }
 
@@ -57,6 +57,8 @@ func (g *gen) writeStatement(b *buffer, n *a.Node, depth uint32) error {
 	case a.KAssign:
 		n := n.AsAssign()
 		return g.writeStatementAssign(b, n.Operator(), n.LHS(), n.RHS(), depth)
+	case a.KChoose:
+		return g.writeStatementChoose(b, n.AsChoose(), depth)
 	case a.KIOBind:
 		return g.writeStatementIOBind(b, n.AsIOBind(), depth)
 	case a.KIf:
@@ -75,6 +77,24 @@ func (g *gen) writeStatement(b *buffer, n *a.Node, depth uint32) error {
 	return fmt.Errorf("unrecognized ast.Kind (%s) for writeStatement", n.Kind())
 }
 
+func (g *gen) writeStatementChoose(b *buffer, n *a.Choose, depth uint32) error {
+	recv := g.currFunk.astFunc.Receiver()
+	name := n.Name().Str(g.tm)
+	b.printf("self->private_impl.choosy_%s = (\n", name)
+	for _, o := range n.Args() {
+		f := g.findFunc(t.QQID{recv[0], recv[1], o.AsExpr().Ident()})
+		if f == nil {
+			return fmt.Errorf("internal error: no such choose argument %q", o.AsExpr().Ident().Str(g.tm))
+		}
+		guard := cpuArchCGuard(f.CPUArch())
+		b.printf("#if defined(%s)\n", guard)
+		b.printf("%s() ? &%s :\n", cpuArchCHave(f.CPUArch()), g.funcCName(f))
+		b.printf("#endif\n")
+	}
+	b.printf("self->private_impl.choosy_%s);\n", name)
+	return nil
+}
+
 func (g *gen) writeStatementAssign(b *buffer, op t.ID, lhs *a.Expr, rhs *a.Expr, depth uint32) error {
 	if depth > a.MaxExprDepth {
 		return fmt.Errorf("expression recursion depth too large")
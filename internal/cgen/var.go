@@ -279,7 +279,11 @@ func (g *gen) writeVars(b *buffer, f *funk, inStructDecl bool) error {
 
 		name := n.Name().Str(g.tm)
 
-		if typ.IsIOType() {
+		if typ.Eq(typeExprX86SSE42Utility) {
+			// The utility type is a placeholder receiver for the
+			// make_m128i_etc methods. It has no C representation.
+			continue
+		} else if typ.IsIOType() {
 			b.printf("wuffs_base__io_buffer %s%s = wuffs_base__empty_io_buffer();\n", uPrefix, name)
 		} else if typ.IsTokenType() {
 			return fmt.Errorf("TODO: support token_{reader,writer} typed variables")
@@ -40,6 +40,7 @@ const (
 	KArg
 	KAssert
 	KAssign
+	KChoose
 	KConst
 	KExpr
 	KField
@@ -71,6 +72,7 @@ var kindStrings = [...]string{
 	KArg:      "KArg",
 	KAssert:   "KAssert",
 	KAssign:   "KAssign",
+	KChoose:   "KChoose",
 	KConst:    "KConst",
 	KExpr:     "KExpr",
 	KField:    "KField",
@@ -103,6 +105,8 @@ const (
 	FlagsSubExprHasEffect = Flags(0x00002000)
 	FlagsRetsError        = Flags(0x00004000)
 	FlagsPrivateData      = Flags(0x00008000)
+	FlagsChoosy           = Flags(0x00010000)
+	FlagsCPUArchX86SSE42  = Flags(0x00020000)
 )
 
 func (f Flags) AsEffect() Effect { return Effect(f) }
@@ -159,6 +163,7 @@ type Node struct {
 	// Arg           .             .             name          Arg
 	// Assert        keyword       .             lit(reason)   Assert
 	// Assign        operator      .             .             Assign
+	// Choose        .             .             name          Choose
 	// Const         .             pkg           name          Const
 	// Expr          operator      pkg           literal/ident Expr
 	// Field         .             .             name          Field
@@ -197,6 +202,7 @@ func (n *Node) SetMType(x *TypeExpr)           { n.mType = x }
 func (n *Node) AsArg() *Arg           { return (*Arg)(n) }
 func (n *Node) AsAssert() *Assert     { return (*Assert)(n) }
 func (n *Node) AsAssign() *Assign     { return (*Assign)(n) }
+func (n *Node) AsChoose() *Choose     { return (*Choose)(n) }
 func (n *Node) AsConst() *Const       { return (*Const)(n) }
 func (n *Node) AsExpr() *Expr         { return (*Expr)(n) }
 func (n *Node) AsField() *Field       { return (*Field)(n) }
@@ -467,6 +473,23 @@ func NewAssign(operator t.ID, lhs *Expr, rhs *Expr) *Assign {
 	}
 }
 
+// Choose is "choose ID2 = [List2]":
+//  - ID2:   name
+//  - List2: <Expr> implementations
+type Choose Node
+
+func (n *Choose) AsNode() *Node { return (*Node)(n) }
+func (n *Choose) Name() t.ID    { return n.id2 }
+func (n *Choose) Args() []*Node { return n.list2 }
+
+func NewChoose(name t.ID, args []*Node) *Choose {
+	return &Choose{
+		kind:  KChoose,
+		id2:   name,
+		list2: args,
+	}
+}
+
 // Var is "var ID2 LHS":
 //  - ID2:   name
 //  - LHS:   <TypeExpr>
@@ -737,6 +760,18 @@ func (n *TypeExpr) IsIdeal() bool {
 	return n.id0 == 0 && n.id1 == t.IDBase && n.id2 == t.IDQIdeal
 }
 
+// IsCPUArchType returns whether n is (or contains, e.g. as an array element
+// type) a type like x86_m128i that is only usable in cpu_arch funcs.
+func (n *TypeExpr) IsCPUArchType() bool {
+	for ; n != nil; n = n.Inner() {
+		if n.id0 == 0 && n.id1 == t.IDBase &&
+			(n.id2 == t.IDX86SSE42Utility || n.id2 == t.IDX86M128I) {
+			return true
+		}
+	}
+	return false
+}
+
 func (n *TypeExpr) IsIOType() bool {
 	return n.id0 == 0 && n.id1 == t.IDBase &&
 		(n.id2 == t.IDIOReader || n.id2 == t.IDIOWriter)
@@ -839,6 +874,8 @@ const MaxBodyDepth = 255
 
 // Func is "func ID2.ID0(LHS)(RHS) { List2 }":
 //  - FlagsPublic      is "pub" vs "pri"
+//  - FlagsChoosy      is whether the func is "choosy"
+//  - FlagsCPUArchEtc  is whether the func is "choose cpu_arch >= etc"
 //  - ID0:   funcName
 //  - ID1:   <0|receiverPkg> (set by calling SetPackage)
 //  - ID2:   <0|receiverName>
@@ -851,6 +888,7 @@ type Func Node
 func (n *Func) AsNode() *Node    { return (*Node)(n) }
 func (n *Func) Effect() Effect   { return Effect(n.flags) }
 func (n *Func) Public() bool     { return n.flags&FlagsPublic != 0 }
+func (n *Func) Choosy() bool     { return n.flags&FlagsChoosy != 0 }
 func (n *Func) Filename() string { return n.filename }
 func (n *Func) Line() uint32     { return n.line }
 func (n *Func) QQID() t.QQID     { return t.QQID{n.id1, n.id2, n.id0} }
@@ -861,6 +899,15 @@ func (n *Func) Out() *TypeExpr   { return n.rhs.AsTypeExpr() }
 func (n *Func) Asserts() []*Node { return n.list1 }
 func (n *Func) Body() []*Node    { return n.list2 }
 
+// CPUArch returns the minimum CPU architecture (e.g. t.IDX86SSE42) that the
+// func requires, or zero if it is portable.
+func (n *Func) CPUArch() t.ID {
+	if n.flags&FlagsCPUArchX86SSE42 != 0 {
+		return t.IDX86SSE42
+	}
+	return 0
+}
+
 func (n *Func) BodyEndsWithReturn() bool {
 	if len(n.list2) == 0 {
 		return false
@@ -100,6 +100,9 @@ var Types = []string{
 	"pixel_swizzler",
 
 	"decode_frame_options",
+
+	"x86_sse42_utility",
+	"x86_m128i",
 }
 
 var Funcs = []string{
@@ -170,6 +173,11 @@ var Funcs = []string{
 	"range_ii_u64.intersect(r: range_ii_u64) range_ii_u64",
 	"range_ii_u64.unite(r: range_ii_u64) range_ii_u64",
 
+	"rect_ie_u32.get_min_incl_x() u32",
+	"rect_ie_u32.get_min_incl_y() u32",
+	"rect_ie_u32.get_max_excl_x() u32",
+	"rect_ie_u32.get_max_excl_y() u32",
+
 	// ---- status
 
 	// TODO: should we add is_complete?
@@ -329,6 +337,15 @@ var Funcs = []string{
 	// For now, that's all implicitly checked (i.e. hard coded).
 	"io_writer.copy_n32_from_history_fast!(n: u32, distance: u32) u32",
 
+	// TODO: this should have explicit pre-conditions:
+	//  - (n + 8) <= this.available()
+	//  - distance > 0
+	//  - distance <= this.since_mark().length()
+	// For now, that's all implicitly checked (i.e. hard coded). The first one
+	// is checked against n's upper bound, not n itself, as this method can
+	// write up to 8 bytes past the n bytes it copies.
+	"io_writer.copy_n32_from_history_8_byte_chunks_fast!(n: u32, distance: u32) u32",
+
 	// ---- token_writer
 
 	"token_writer.write_simple_token_fast!(" +
@@ -337,6 +354,11 @@ var Funcs = []string{
 
 	"token_writer.available() u64",
 
+	// ---- decode_frame_options
+
+	"decode_frame_options.dst_clip_rect() rect_ie_u32",
+	"decode_frame_options.scale_log2() u32[..= 3]",
+
 	// ---- frame_config
 	// Duration's upper bound is the maximum possible i64 value.
 
@@ -372,6 +394,39 @@ var Funcs = []string{
 		"src_pixfmt: pixel_format, src_palette: slice u8, blend: pixel_blend) status",
 	"pixel_swizzler.swizzle_interleaved!(" +
 		"dst: slice u8, dst_palette: slice u8, src: slice u8) u64",
+	"pixel_swizzler.swizzle_interleaved_subsampled!(" +
+		"dst: slice u8, dst_palette: slice u8, src: slice u8, x_step: u32[..= 8]) u64",
+
+	// ---- x86_sse42_utility
+
+	"x86_sse42_utility.make_m128i_multiple_u32(a00: u32, a01: u32, a02: u32, a03: u32) x86_m128i",
+	"x86_sse42_utility.make_m128i_multiple_u64(a00: u64, a01: u64) x86_m128i",
+	"x86_sse42_utility.make_m128i_multiple_u8(" +
+		"a00: u8, a01: u8, a02: u8, a03: u8, a04: u8, a05: u8, a06: u8, a07: u8, " +
+		"a08: u8, a09: u8, a10: u8, a11: u8, a12: u8, a13: u8, a14: u8, a15: u8) x86_m128i",
+	"x86_sse42_utility.make_m128i_repeat_u16(a: u16) x86_m128i",
+	"x86_sse42_utility.make_m128i_repeat_u8(a: u8) x86_m128i",
+	"x86_sse42_utility.make_m128i_single_u32(a: u32) x86_m128i",
+	"x86_sse42_utility.make_m128i_slice128(a: slice u8) x86_m128i",
+	"x86_sse42_utility.make_m128i_zeroes() x86_m128i",
+
+	// ---- x86_m128i
+	// The method names are the C intrinsic names. The receiver is the
+	// intrinsic's first argument and any imm8 argument must be a constant.
+
+	"x86_m128i._mm_add_epi32(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_and_si128(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_clmulepi64_si128(b: x86_m128i, imm8: u32[..= 0xFF]) x86_m128i",
+	"x86_m128i._mm_cvtsi128_si32() u32",
+	"x86_m128i._mm_extract_epi32(imm8: u32[..= 3]) u32",
+	"x86_m128i._mm_madd_epi16(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_maddubs_epi16(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_or_si128(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_sad_epu8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_shuffle_epi32(imm8: u32[..= 0xFF]) x86_m128i",
+	"x86_m128i._mm_slli_epi32(imm8: u32[..= 31]) x86_m128i",
+	"x86_m128i._mm_srli_si128(imm8: u32[..= 15]) x86_m128i",
+	"x86_m128i._mm_xor_si128(b: x86_m128i) x86_m128i",
 }
 
 var Interfaces = []string{
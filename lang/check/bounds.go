@@ -244,6 +244,9 @@ func (q *checker) bcheckStatement(n *a.Node) error {
 			return err
 		}
 
+	case a.KChoose:
+		// No-op.
+
 	case a.KIOBind:
 		n := n.AsIOBind()
 		if _, err := q.bcheckExpr(n.IO(), 0); err != nil {
@@ -1011,6 +1014,21 @@ func (q *checker) bcheckExprCallSpecialCases(n *a.Expr, depth uint32) (bounds, e
 			}
 		}
 
+	} else if recvTyp.Eq(typeExprX86M128I) {
+		for _, o := range n.Args() {
+			o := o.AsArg()
+			if (o.Name().Str(q.tm) == "imm8") && (o.Value().ConstValue() == nil) {
+				return bounds{}, fmt.Errorf("check: %s imm8 is not a constant value", method.Str(q.tm))
+			}
+		}
+
+	} else if recvTyp.Eq(typeExprX86SSE42Utility) {
+		if method == t.IDMakeM128ISlice128 {
+			if err := q.canMakeM128ISlice128(n.Args()[0].AsArg().Value()); err != nil {
+				return bounds{}, err
+			}
+		}
+
 	} else if recvTyp.IsIOTokenType() {
 		advance, update := (*big.Int)(nil), false
 
@@ -1020,7 +1038,12 @@ func (q *checker) bcheckExprCallSpecialCases(n *a.Expr, depth uint32) (bounds, e
 			}
 
 		} else if method == t.IDCopyN32FromHistoryFast {
-			if err := q.canCopyN32FromHistoryFast(recv, n.Args()); err != nil {
+			if err := q.canCopyN32FromHistoryFast(recv, n.Args(), depth, false); err != nil {
+				return bounds{}, err
+			}
+
+		} else if method == t.IDCopyN32FromHistory8ByteChunksFast {
+			if err := q.canCopyN32FromHistoryFast(recv, n.Args(), depth, true); err != nil {
 				return bounds{}, err
 			}
 
@@ -1077,6 +1100,42 @@ func (q *checker) bcheckExprCallSpecialCases(n *a.Expr, depth uint32) (bounds, e
 	return bounds{}, errNotASpecialCase
 }
 
+// canMakeM128ISlice128 checks that the slice s has length at least 16, as the
+// 128-bit load reads 16 bytes. Either s is a constant-bounded sub-slice like
+// "x[16 .. 32]" or there is a fact like "s.length() == 16" or "s.length() >=
+// 64" (or another constant at least 16).
+func (q *checker) canMakeM128ISlice128(s *a.Expr) error {
+	if s.Operator() == t.IDDotDot {
+		if j := s.RHS().AsExpr(); j != nil {
+			icv := zero
+			if i := s.MHS().AsExpr(); i != nil {
+				icv = i.ConstValue()
+			}
+			if jcv := j.ConstValue(); (icv != nil) && (jcv != nil) {
+				if n := big.NewInt(0).Sub(jcv, icv); n.Cmp(sixteen) >= 0 {
+					return nil
+				}
+			}
+		}
+	} else {
+		length := makeSliceLength(s)
+		for _, x := range q.facts {
+			if op := x.Operator(); (op != t.IDXBinaryEqEq) && (op != t.IDXBinaryGreaterEq) &&
+				(op != t.IDXBinaryGreaterThan) {
+				continue
+			}
+			if !x.LHS().AsExpr().Eq(length) {
+				continue
+			}
+			if cv := x.RHS().AsExpr().ConstValue(); (cv != nil) && (cv.Cmp(sixteen) >= 0) {
+				return nil
+			}
+		}
+	}
+	return fmt.Errorf("check: could not prove make_m128i_slice128 pre-condition: %s.length() >= 16",
+		s.Str(q.tm))
+}
+
 func (q *checker) canUndoByte(recv *a.Expr) error {
 	for _, x := range q.facts {
 		if x.Operator() != t.IDOpenParen || len(x.Args()) != 0 {
@@ -1100,11 +1159,16 @@ func (q *checker) canUndoByte(recv *a.Expr) error {
 	return fmt.Errorf("check: could not prove %s.can_undo_byte()", recv.Str(q.tm))
 }
 
-func (q *checker) canCopyN32FromHistoryFast(recv *a.Expr, args []*a.Node) error {
+func (q *checker) canCopyN32FromHistoryFast(recv *a.Expr, args []*a.Node, depth uint32, eightByteChunks bool) error {
 	// As per cgen's io-private.h, there are three pre-conditions:
 	//  - n <= this.available()
 	//  - distance > 0
 	//  - distance <= this.history_available()
+	//
+	// For the 8_byte_chunks variant, which can write up to 8 bytes past the n
+	// bytes copied, the first pre-condition is instead:
+	//  - (nMax + 8) <= this.available()
+	// where nMax is n's upper bound.
 
 	if len(args) != 2 {
 		return fmt.Errorf("check: internal error: inconsistent copy_n_from_history_fast arguments")
@@ -1112,36 +1176,50 @@ func (q *checker) canCopyN32FromHistoryFast(recv *a.Expr, args []*a.Node) error
 	n := args[0].AsArg().Value()
 	distance := args[1].AsArg().Value()
 
-	// Check "n <= this.available()".
-check0:
-	for {
-		for _, x := range q.facts {
-			if x.Operator() != t.IDXBinaryLessEq {
-				continue
-			}
+	if eightByteChunks {
+		// Check "(nMax + 8) <= this.available()".
+		nb, err := q.bcheckExpr(n, depth)
+		if err != nil {
+			return err
+		}
+		advance := big.NewInt(0).Add(nb[1], eight)
+		if ok, err := q.optimizeIOMethodAdvance(recv, advance, false); err != nil {
+			return err
+		} else if !ok {
+			return fmt.Errorf("check: could not prove %s.available() >= %v", recv.Str(q.tm), advance)
+		}
+	} else {
+		// Check "n <= this.available()".
+	check0:
+		for {
+			for _, x := range q.facts {
+				if x.Operator() != t.IDXBinaryLessEq {
+					continue
+				}
 
-			// Check that the LHS is "n as base.u64".
-			lhs := x.LHS().AsExpr()
-			if lhs.Operator() != t.IDXBinaryAs {
-				continue
-			}
-			llhs, lrhs := lhs.LHS().AsExpr(), lhs.RHS().AsTypeExpr()
-			if !llhs.Eq(n) || !lrhs.Eq(typeExprU64) {
-				continue
-			}
+				// Check that the LHS is "n as base.u64".
+				lhs := x.LHS().AsExpr()
+				if lhs.Operator() != t.IDXBinaryAs {
+					continue
+				}
+				llhs, lrhs := lhs.LHS().AsExpr(), lhs.RHS().AsTypeExpr()
+				if !llhs.Eq(n) || !lrhs.Eq(typeExprU64) {
+					continue
+				}
 
-			// Check that the RHS is "recv.available()".
-			y, method, yArgs := splitReceiverMethodArgs(x.RHS().AsExpr())
-			if method != t.IDAvailable || len(yArgs) != 0 {
-				continue
-			}
-			if !y.Eq(recv) {
-				continue
-			}
+				// Check that the RHS is "recv.available()".
+				y, method, yArgs := splitReceiverMethodArgs(x.RHS().AsExpr())
+				if method != t.IDAvailable || len(yArgs) != 0 {
+					continue
+				}
+				if !y.Eq(recv) {
+					continue
+				}
 
-			break check0
+				break check0
+			}
+			return fmt.Errorf("check: could not prove n <= %s.available()", recv.Str(q.tm))
 		}
-		return fmt.Errorf("check: could not prove n <= %s.available()", recv.Str(q.tm))
 	}
 
 	// Check "distance > 0".
@@ -429,6 +429,16 @@ func (c *Checker) checkStructFields(node *a.Node) error {
 			Line:     n.Line(),
 		}
 	}
+	for _, o := range n.Fields() {
+		if o := o.AsField(); o.XType().IsCPUArchType() {
+			return &Error{
+				Err: fmt.Errorf("check: CPU-specific type %q not allowed for field %q in struct %s",
+					o.XType().Str(c.tm), o.Name().Str(c.tm), n.QID().Str(c.tm)),
+				Filename: n.Filename(),
+				Line:     n.Line(),
+			}
+		}
+	}
 	return nil
 }
 
@@ -536,6 +546,14 @@ func (c *Checker) checkFuncSignature(node *a.Node) error {
 		return nil
 	}
 
+	if err := c.checkFuncChooseFlags(n); err != nil {
+		return &Error{
+			Err:      err,
+			Filename: n.Filename(),
+			Line:     n.Line(),
+		}
+	}
+
 	iQID := n.In().QID()
 	inTyp := a.NewTypeExpr(0, iQID[0], iQID[1], nil, nil, nil)
 	inTyp.AsNode().SetMBounds(bounds{zero, zero})
@@ -568,6 +586,40 @@ func (c *Checker) checkFuncSignature(node *a.Node) error {
 	return nil
 }
 
+func (c *Checker) checkFuncChooseFlags(n *a.Func) error {
+	if n.Choosy() || (n.CPUArch() != 0) {
+		if n.Receiver()[1] == 0 {
+			return fmt.Errorf("check: choosy or cpu_arch func %s is not a method", n.QQID().Str(c.tm))
+		}
+		if n.Public() {
+			return fmt.Errorf("check: choosy or cpu_arch func %s is public", n.QQID().Str(c.tm))
+		}
+		if n.Effect().Coroutine() {
+			return fmt.Errorf("check: choosy or cpu_arch func %s is a coroutine", n.QQID().Str(c.tm))
+		}
+	}
+	if n.Choosy() {
+		if s := c.structs[n.Receiver()]; (s == nil) || !s.Classy() {
+			return fmt.Errorf("check: choosy func %s does not have a classy receiver", n.QQID().Str(c.tm))
+		}
+	}
+	if n.Choosy() && (n.CPUArch() != 0) {
+		return fmt.Errorf("check: func %s is both choosy and cpu_arch", n.QQID().Str(c.tm))
+	}
+
+	// CPU-specific types like x86_m128i can only be local variables, so that
+	// they never appear in a cpu_arch func's signature or in any struct.
+	for _, o := range n.In().Fields() {
+		if o.AsField().XType().IsCPUArchType() {
+			return fmt.Errorf("check: func %s has a CPU-specific in-param type", n.QQID().Str(c.tm))
+		}
+	}
+	if out := n.Out(); (out != nil) && out.IsCPUArchType() {
+		return fmt.Errorf("check: func %s has a CPU-specific out-param type", n.QQID().Str(c.tm))
+	}
+	return nil
+}
+
 func (c *Checker) checkFuncContract(node *a.Node) error {
 	n := node.AsFunc()
 	if len(n.Asserts()) == 0 {
@@ -38,6 +38,10 @@ func (q *checker) tcheckVars(block []*a.Node) error {
 		if err := q.tcheckTypeExpr(o.XType(), 0); err != nil {
 			return err
 		}
+		if o.XType().IsCPUArchType() && (q.astFunc.CPUArch() == 0) {
+			return fmt.Errorf("check: var %q has CPU-specific type %q but %s is not a cpu_arch func",
+				name.Str(q.tm), o.XType().Str(q.tm), q.astFunc.QQID().Str(q.tm))
+		}
 		q.localVars[name] = o.XType()
 	}
 	return nil
@@ -86,6 +90,11 @@ func (q *checker) tcheckStatement(n *a.Node) error {
 		}
 		return nil
 
+	case a.KChoose:
+		if err := q.tcheckChoose(n.AsChoose()); err != nil {
+			return err
+		}
+
 	case a.KIOBind:
 		n := n.AsIOBind()
 		if err := q.tcheckExpr(n.IO(), 0); err != nil {
@@ -192,6 +201,62 @@ func (q *checker) tcheckStatement(n *a.Node) error {
 	return nil
 }
 
+func (q *checker) tcheckChoose(n *a.Choose) error {
+	recv := q.astFunc.Receiver()
+	if recv[1] == 0 {
+		return fmt.Errorf("check: choose statement in non-method %s", q.astFunc.QQID().Str(q.tm))
+	}
+	if !q.astFunc.Effect().Impure() {
+		return fmt.Errorf("check: choose statement in pure func %s", q.astFunc.QQID().Str(q.tm))
+	}
+	f := q.c.funcs[t.QQID{recv[0], recv[1], n.Name()}]
+	if (f == nil) || !f.Choosy() {
+		return fmt.Errorf("check: choose target %q is not a choosy method of %q",
+			n.Name().Str(q.tm), recv.Str(q.tm))
+	}
+	for _, o := range n.Args() {
+		o := o.AsExpr()
+		g := q.c.funcs[t.QQID{recv[0], recv[1], o.Ident()}]
+		if g == nil {
+			return fmt.Errorf("check: choose argument %q is not a method of %q",
+				o.Ident().Str(q.tm), recv.Str(q.tm))
+		}
+		if g.CPUArch() == 0 {
+			return fmt.Errorf("check: choose argument %q is not a cpu_arch method", o.Ident().Str(q.tm))
+		}
+		if !sameFuncSignature(f, g) {
+			return fmt.Errorf("check: choose argument %q does not have the same signature as %q",
+				o.Ident().Str(q.tm), n.Name().Str(q.tm))
+		}
+		recvTyp := a.NewTypeExpr(0, recv[0], recv[1], nil, nil, nil)
+		o.SetMBounds(bounds{zero, zero})
+		o.SetMType(a.NewTypeExpr(t.IDFunc, 0, o.Ident(), recvTyp.AsNode(), nil, nil))
+	}
+	return nil
+}
+
+func sameFuncSignature(f *a.Func, g *a.Func) bool {
+	if (f.Effect() != g.Effect()) || (f.Public() != g.Public()) {
+		return false
+	}
+	if fOut, gOut := f.Out(), g.Out(); (fOut == nil) != (gOut == nil) {
+		return false
+	} else if (fOut != nil) && !fOut.Eq(gOut) {
+		return false
+	}
+	fIn, gIn := f.In().Fields(), g.In().Fields()
+	if len(fIn) != len(gIn) {
+		return false
+	}
+	for i := range fIn {
+		fi, gi := fIn[i].AsField(), gIn[i].AsField()
+		if (fi.Name() != gi.Name()) || !fi.XType().Eq(gi.XType()) {
+			return false
+		}
+	}
+	return true
+}
+
 func (q *checker) tcheckAssert(n *a.Assert) error {
 	cond := n.Condition()
 	if err := q.tcheckExpr(cond, 0); err != nil {
@@ -500,6 +565,10 @@ func (q *checker) tcheckExprCall(n *a.Expr, depth uint32) error {
 	if err != nil {
 		return err
 	}
+	if (f.CPUArch() != 0) && (q.astFunc.CPUArch() < f.CPUArch()) {
+		return fmt.Errorf("check: cannot call cpu_arch func %q from %s",
+			f.QQID().Str(q.tm), q.astFunc.QQID().Str(q.tm))
+	}
 	if ne, fe := n.Effect(), f.Effect(); ne != fe {
 		return fmt.Errorf("check: %q has effect %q but %q has effect %q",
 			n.Str(q.tm), ne, f.QQID().Str(q.tm), fe)
@@ -193,7 +193,7 @@ func (p *parser) parseTopLevelDecl() (*a.Node, error) {
 				return nil, err
 			}
 			out := (*a.TypeExpr)(nil)
-			if p.peek1() != t.IDOpenCurly {
+			if x := p.peek1(); (x != t.IDOpenCurly) && (x != t.IDComma) {
 				out, err = p.parseTypeExpr()
 				if err != nil {
 					return nil, err
@@ -202,6 +202,11 @@ func (p *parser) parseTopLevelDecl() (*a.Node, error) {
 			asserts := []*a.Node(nil)
 			if p.peek1() == t.IDComma {
 				p.src = p.src[1:]
+				f, err := p.parseFuncChooseFlags()
+				if err != nil {
+					return nil, err
+				}
+				flags |= f
 				asserts, err = p.parseList(t.IDOpenCurly, (*parser).parseAssertNode)
 				if err != nil {
 					return nil, err
@@ -337,6 +342,54 @@ func (p *parser) parseIdent() (t.ID, error) {
 	return x.ID, nil
 }
 
+// parseFuncChooseFlags parses the optional "choosy," and "choose cpu_arch >=
+// etc," parts of a func signature that precede its asserts.
+func (p *parser) parseFuncChooseFlags() (a.Flags, error) {
+	flags := a.Flags(0)
+	if p.peek1() == t.IDChoosy {
+		p.src = p.src[1:]
+		flags |= a.FlagsChoosy
+		if err := p.expectComma(); err != nil {
+			return 0, err
+		}
+	}
+
+	if p.peek1() == t.IDChoose {
+		p.src = p.src[1:]
+		if x := p.peek1(); x != t.IDCPUArch {
+			got := p.tm.ByID(x)
+			return 0, fmt.Errorf(`parse: expected "cpu_arch", got %q at %s:%d`, got, p.filename, p.line())
+		}
+		p.src = p.src[1:]
+		if x := p.peek1(); x != t.IDGreaterEq {
+			got := p.tm.ByID(x)
+			return 0, fmt.Errorf(`parse: expected ">=", got %q at %s:%d`, got, p.filename, p.line())
+		}
+		p.src = p.src[1:]
+		switch x := p.peek1(); x {
+		case t.IDX86SSE42:
+			flags |= a.FlagsCPUArchX86SSE42
+		default:
+			got := p.tm.ByID(x)
+			return 0, fmt.Errorf(`parse: unsupported cpu_arch %q at %s:%d`, got, p.filename, p.line())
+		}
+		p.src = p.src[1:]
+		if err := p.expectComma(); err != nil {
+			return 0, err
+		}
+	}
+	return flags, nil
+}
+
+func (p *parser) expectComma() error {
+	if x := p.peek1(); x != t.IDComma {
+		got := p.tm.ByID(x)
+		return fmt.Errorf(`parse: expected ",", got %q at %s:%d`, got, p.filename, p.line())
+	}
+	p.src = p.src[1:]
+	return nil
+}
+
 func (p *parser) parseList(stop t.ID, parseElem func(*parser) (*a.Node, error)) ([]*a.Node, error) {
 	if stop == t.IDCloseParen {
 		if x := p.peek1(); x != t.IDOpenParen {
@@ -747,6 +800,9 @@ func (p *parser) parseStatement1() (*a.Node, error) {
 		n.SetJumpTarget(loop)
 		return n.AsNode(), nil
 
+	case t.IDChoose:
+		return p.parseChooseNode()
+
 	case t.IDIOBind, t.IDIOLimit:
 		return p.parseIOBindNode()
 
@@ -932,6 +988,40 @@ func (p *parser) parseAsserts() ([]*a.Node, error) {
 	return asserts, nil
 }
 
+func (p *parser) parseChooseNode() (*a.Node, error) {
+	p.src = p.src[1:]
+	name, err := p.parseIdent()
+	if err != nil {
+		return nil, err
+	}
+	if x := p.peek1(); x != t.IDEq {
+		got := p.tm.ByID(x)
+		return nil, fmt.Errorf(`parse: expected "=", got %q at %s:%d`, got, p.filename, p.line())
+	}
+	p.src = p.src[1:]
+	if x := p.peek1(); x != t.IDOpenBracket {
+		got := p.tm.ByID(x)
+		return nil, fmt.Errorf(`parse: expected "[", got %q at %s:%d`, got, p.filename, p.line())
+	}
+	p.src = p.src[1:]
+	args, err := p.parseList(t.IDCloseBracket, (*parser).parseChooseArgNode)
+	if err != nil {
+		return nil, err
+	}
+	if len(args) == 0 {
+		return nil, fmt.Errorf(`parse: empty choose list at %s:%d`, p.filename, p.line())
+	}
+	return a.NewChoose(name, args).AsNode(), nil
+}
+
+func (p *parser) parseChooseArgNode() (*a.Node, error) {
+	name, err := p.parseIdent()
+	if err != nil {
+		return nil, err
+	}
+	return a.NewExpr(0, 0, 0, name, nil, nil, nil, nil).AsNode(), nil
+}
+
 func (p *parser) parseIOBindNode() (*a.Node, error) {
 	keyword := p.peek1()
 	p.src = p.src[1:]
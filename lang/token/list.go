@@ -397,6 +397,7 @@ const (
 	IDVia        = ID(0xC5)
 	IDWhile      = ID(0xC6)
 	IDYield      = ID(0xC7)
+	IDChoose     = ID(0xC8)
 )
 
 const (
@@ -501,6 +502,14 @@ const (
 
 	IDDecodeFrameOptions = ID(0x158)
 
+	IDChoosy          = ID(0x15A)
+	IDCPUArch         = ID(0x15B)
+	IDX86SSE42        = ID(0x15C)
+	IDX86SSE42Utility = ID(0x15D)
+	IDX86M128I        = ID(0x15E)
+
+	IDMakeM128ISlice128 = ID(0x15F)
+
 	IDCanUndoByte      = ID(0x160)
 	IDCountSince       = ID(0x161)
 	IDHistoryAvailable = ID(0x162)
@@ -522,6 +531,8 @@ const (
 	IDCopyN32FromReader      = ID(0x173)
 	IDCopyN32FromSlice       = ID(0x174)
 
+	IDCopyN32FromHistory8ByteChunksFast = ID(0x175)
+
 	// -------- 0x180 block.
 
 	IDUndoByte = ID(0x180)
@@ -760,6 +771,7 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDVia:        "via",
 	IDWhile:      "while",
 	IDYield:      "yield",
+	IDChoose:     "choose",
 
 	IDArray: "array",
 	IDNptr:  "nptr",
@@ -861,6 +873,14 @@ var builtInsByID = [nBuiltInIDs]string{
 
 	IDDecodeFrameOptions: "decode_frame_options",
 
+	IDChoosy:          "choosy",
+	IDCPUArch:         "cpu_arch",
+	IDX86SSE42:        "x86_sse42",
+	IDX86SSE42Utility: "x86_sse42_utility",
+	IDX86M128I:        "x86_m128i",
+
+	IDMakeM128ISlice128: "make_m128i_slice128",
+
 	IDCanUndoByte:      "can_undo_byte",
 	IDCountSince:       "count_since",
 	IDHistoryAvailable: "history_available",
@@ -882,6 +902,8 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDCopyN32FromReader:      "copy_n32_from_reader",
 	IDCopyN32FromSlice:       "copy_n32_from_slice",
 
+	IDCopyN32FromHistory8ByteChunksFast: "copy_n32_from_history_8_byte_chunks_fast",
+
 	// -------- 0x180 block.
 
 	IDUndoByte: "undo_byte",
@@ -107,6 +107,32 @@ extern "C" {
 #define WUFFS_BASE__WARN_UNUSED_RESULT
 #endif
 
+// --------
+
+// Define WUFFS_CONFIG__AVOID_CPU_ARCH to avoid any code tied to a specific CPU
+// architecture, such as SSE SIMD for the x86 CPU family.
+#if defined(WUFFS_CONFIG__AVOID_CPU_ARCH)
+// No-op.
+#else
+// Clang also defines "__GNUC__".
+#if defined(__GNUC__) && defined(__x86_64__)
+#define WUFFS_BASE__CPU_ARCH__X86_64
+#endif
+#endif
+
+// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET marks a function as being compiled for a
+// specific CPU feature set (such as "pclmul,popcnt,sse4.2"), even if the rest
+// of the program is not. Such functions are only called after a run-time check
+// that the CPU supports those features.
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+#include <immintrin.h>
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg) __attribute__((target(arg)))
+#else
+#define WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET(arg)
+#endif
+
+// --------
+
 // Flags for wuffs_foo__bar__initialize functions.
 
 #define WUFFS_INITIALIZE__DEFAULT_OPTIONS ((uint32_t)0x00000000)
@@ -2115,6 +2141,34 @@ wuffs_base__make_slice_token(wuffs_base__token* ptr, size_t len) {
   return ret;
 }
 
+// wuffs_base__slice_token__source_positions fills a side table of absolute
+// source positions, for callers (such as indexers that later want to seek
+// straight to a JSON value) that would otherwise each keep their own running
+// sum of token lengths.
+//
+// A token stream's tokens are contiguous: each token starts where the previous
+// one ended. Given pos, the source position of tokens.ptr[0], it sets
+// dst.ptr[i] to the source position of tokens.ptr[i], for each i less than
+// both dst.len and tokens.len. It returns the source position just after the
+// last token processed.
+//
+// A typical pos is the wuffs_base__io_buffer__reader_io_position of the source
+// buffer before the first decode_tokens call. Passing each return value as the
+// next call's pos then keeps the positions correct across multiple
+// decode_tokens calls, even as the source and token buffers are compacted.
+static inline uint64_t  //
+wuffs_base__slice_token__source_positions(wuffs_base__slice_u64 dst,
+                                          wuffs_base__slice_token tokens,
+                                          uint64_t pos) {
+  size_t n = (dst.len < tokens.len) ? dst.len : tokens.len;
+  size_t i;
+  for (i = 0; i < n; i++) {
+    dst.ptr[i] = pos;
+    pos += wuffs_base__token__length(&tokens.ptr[i]);
+  }
+  return pos;
+}
+
 // --------
 
 // wuffs_base__token_buffer_meta is the metadata for a
@@ -2366,6 +2420,40 @@ wuffs_base__malloc_slice_u64(void* (*malloc_func)(size_t), uint64_t num_u64) {
 // byte order: its value is always 0xAARRGGBB, regardless of endianness.
 typedef uint32_t wuffs_base__color_u32_argb_premul;
 
+static inline uint16_t  //
+wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(
+    wuffs_base__color_u32_argb_premul c) {
+  uint32_t r5 = 0xF800 & (c >> 8);
+  uint32_t g6 = 0x07E0 & (c >> 5);
+  uint32_t b5 = 0x001F & (c >> 3);
+  return (uint16_t)(r5 | g6 | b5);
+}
+
+static inline wuffs_base__color_u32_argb_premul  //
+wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(uint16_t rgb_565) {
+  uint32_t b5 = 0x1F & (rgb_565 >> 0);
+  uint32_t b = (b5 << 3) | (b5 >> 2);
+  uint32_t g6 = 0x3F & (rgb_565 >> 5);
+  uint32_t g = (g6 << 2) | (g6 >> 4);
+  uint32_t r5 = 0x1F & (rgb_565 >> 11);
+  uint32_t r = (r5 << 3) | (r5 >> 2);
+  return 0xFF000000 | (r << 16) | (g << 8) | (b << 0);
+}
+
+// wuffs_base__color_u32_argb_premul__as__color_u8_gray returns the luma (the
+// gray level) of c, using the JFIF (ITU-R BT.601) weights of 0.299, 0.587 and
+// 0.114 for red, green and blue. The alpha of c is ignored.
+static inline uint8_t  //
+wuffs_base__color_u32_argb_premul__as__color_u8_gray(
+    wuffs_base__color_u32_argb_premul c) {
+  // Work in 16-bit color. The weights sum to 0x10000 (65536).
+  uint32_t cr = 0x101 * (0xFF & (c >> 16));
+  uint32_t cg = 0x101 * (0xFF & (c >> 8));
+  uint32_t cb = 0x101 * (0xFF & (c >> 0));
+  uint32_t weighted_average = (19595 * cr) + (38470 * cg) + (7471 * cb) + 32768;
+  return (uint8_t)(weighted_average >> 24);
+}
+
 // --------
 
 typedef uint8_t wuffs_base__pixel_blend;
@@ -3474,20 +3562,136 @@ wuffs_base__pixel_buffer::set_color_u32_at(
 
 // --------
 
+// wuffs_base__decode_frame_options holds optional arguments to an image
+// decoder's decode_frame method. Passing a NULL pointer is equivalent to
+// passing a wuffs_base__null_decode_frame_options() value.
 typedef struct {
   // Do not access the private_impl's fields directly. There is no API/ABI
   // compatibility or safety guarantee if you do so.
   struct {
-    uint8_t TODO;
+    wuffs_base__rect_ie_u32 dst_clip_rect;
+    bool has_dst_clip_rect;
+    uint32_t scale_log2;
   } private_impl;
 
 #ifdef __cplusplus
+  inline wuffs_base__rect_ie_u32 dst_clip_rect() const;
+  inline uint32_t scale_denominator() const;
+  inline void set_dst_clip_rect(wuffs_base__rect_ie_u32 r);
+  inline void set_scale_denominator(uint32_t d);
 #endif  // __cplusplus
 
 } wuffs_base__decode_frame_options;
 
+static inline wuffs_base__decode_frame_options  //
+wuffs_base__null_decode_frame_options() {
+  wuffs_base__decode_frame_options ret;
+  ret.private_impl.dst_clip_rect = wuffs_base__make_rect_ie_u32(0, 0, 0, 0);
+  ret.private_impl.has_dst_clip_rect = false;
+  ret.private_impl.scale_log2 = 0;
+  return ret;
+}
+
+// wuffs_base__decode_frame_options__dst_clip_rect returns the region of
+// interest, in the destination pixel buffer's coordinate space. decode_frame
+// does not write any pixels outside of it, and image decoders can skip the
+// work (such as swizzling or, for some formats, reading) for the source
+// pixels that map to outside of it.
+//
+// If set_dst_clip_rect was never called (or o is NULL), it returns the entire
+// (0, 0) to (0xFFFFFFFF, 0xFFFFFFFF) plane, so that nothing is clipped.
+static inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options__dst_clip_rect(
+    const wuffs_base__decode_frame_options* o) {
+  if (o && o->private_impl.has_dst_clip_rect) {
+    return o->private_impl.dst_clip_rect;
+  }
+  return wuffs_base__make_rect_ie_u32(0, 0, 0xFFFFFFFF, 0xFFFFFFFF);
+}
+
+static inline void  //
+wuffs_base__decode_frame_options__set_dst_clip_rect(
+    wuffs_base__decode_frame_options* o,
+    wuffs_base__rect_ie_u32 r) {
+  if (o) {
+    o->private_impl.dst_clip_rect = r;
+    o->private_impl.has_dst_clip_rect = true;
+  }
+}
+
+// wuffs_base__decode_frame_options__scale_denominator returns the factor, 1,
+// 2, 4 or 8, by which decode_frame shrinks the frame in each dimension. A
+// source image of width W and height H is decoded to a destination of width
+// ((W + d - 1) / d) and height ((H + d - 1) / d), where d is the denominator.
+// Image decoders subsample: the source pixel at (x * d, y * d) becomes the
+// destination pixel at (x, y) and the other source pixels are skipped.
+//
+// The dst_clip_rect, frame_dirty_rect and the pixel buffer passed to
+// decode_frame are all in the destination's (scaled) coordinate space. The
+// image_config and frame_config bounds are not scaled.
+//
+// If set_scale_denominator was never called (or o is NULL), it returns 1.
+static inline uint32_t  //
+wuffs_base__decode_frame_options__scale_denominator(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? (((uint32_t)1) << (o->private_impl.scale_log2 & 3)) : 1;
+}
+
+// wuffs_base__decode_frame_options__scale_log2 returns the base-2 logarithm of
+// the scale_denominator: 0, 1, 2 or 3. Wuffs code relies on that range, so it
+// is enforced here even if the private_impl field was set directly.
+static inline uint32_t  //
+wuffs_base__decode_frame_options__scale_log2(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? (o->private_impl.scale_log2 & 3) : 0;
+}
+
+// wuffs_base__decode_frame_options__set_scale_denominator sets the scale
+// denominator. Valid values are 1, 2, 4 and 8. Other values are treated as 1.
+static inline void  //
+wuffs_base__decode_frame_options__set_scale_denominator(
+    wuffs_base__decode_frame_options* o,
+    uint32_t d) {
+  if (o) {
+    switch (d) {
+      case 2:
+        o->private_impl.scale_log2 = 1;
+        break;
+      case 4:
+        o->private_impl.scale_log2 = 2;
+        break;
+      case 8:
+        o->private_impl.scale_log2 = 3;
+        break;
+      default:
+        o->private_impl.scale_log2 = 0;
+        break;
+    }
+  }
+}
+
 #ifdef __cplusplus
 
+inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options::dst_clip_rect() const {
+  return wuffs_base__decode_frame_options__dst_clip_rect(this);
+}
+
+inline uint32_t  //
+wuffs_base__decode_frame_options::scale_denominator() const {
+  return wuffs_base__decode_frame_options__scale_denominator(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_dst_clip_rect(wuffs_base__rect_ie_u32 r) {
+  wuffs_base__decode_frame_options__set_dst_clip_rect(this, r);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_scale_denominator(uint32_t d) {
+  wuffs_base__decode_frame_options__set_scale_denominator(this, d);
+}
+
 #endif  // __cplusplus
 
 // --------
@@ -3503,6 +3707,14 @@ typedef struct {
   // compatibility or safety guarantee if you do so.
   struct {
     wuffs_base__pixel_swizzler__func func;
+
+    // When func is NULL but src_pixfmt_repr is non-zero, swizzling falls
+    // back to a slower, generic, one-pixel-at-a-time implementation that
+    // uses these three fields. A successful prepare always sets them, as
+    // swizzle_interleaved_subsampled also needs the pixel sizes.
+    uint32_t dst_pixfmt_repr;
+    uint32_t src_pixfmt_repr;
+    wuffs_base__pixel_blend blend;
   } private_impl;
 
 #ifdef __cplusplus
@@ -3514,6 +3726,11 @@ typedef struct {
   inline uint64_t swizzle_interleaved(wuffs_base__slice_u8 dst,
                                       wuffs_base__slice_u8 dst_palette,
                                       wuffs_base__slice_u8 src) const;
+  inline uint64_t swizzle_interleaved_subsampled(
+      wuffs_base__slice_u8 dst,
+      wuffs_base__slice_u8 dst_palette,
+      wuffs_base__slice_u8 src,
+      uint32_t x_step) const;
 #endif  // __cplusplus
 
 } wuffs_base__pixel_swizzler;
@@ -3533,6 +3750,22 @@ wuffs_base__pixel_swizzler__swizzle_interleaved(
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src);
 
+// wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled is like
+// wuffs_base__pixel_swizzler__swizzle_interleaved but only converts every
+// x_step'th source pixel: the source pixel (i * x_step) becomes the
+// destination pixel i. It returns the number of source pixels consumed, which
+// includes the skipped ones. It is at most (x_step * the number of
+// destination pixels written), and the src slice's length limits it too.
+//
+// An x_step of 0 or 1 is equivalent to calling swizzle_interleaved.
+uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t x_step);
+
 #ifdef __cplusplus
 
 inline wuffs_base__status  //
@@ -3554,6 +3787,16 @@ wuffs_base__pixel_swizzler::swizzle_interleaved(
                                                          src);
 }
 
+uint64_t  //
+wuffs_base__pixel_swizzler::swizzle_interleaved_subsampled(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t x_step) const {
+  return wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+      this, dst, dst_palette, src, x_step);
+}
+
 #endif  // __cplusplus
 
 // ---------------- String Conversions
@@ -3596,6 +3839,86 @@ wuffs_base__parse_number_i64(wuffs_base__slice_u8 s);
 wuffs_base__result_u64  //
 wuffs_base__parse_number_u64(wuffs_base__slice_u8 s);
 
+// --------
+
+// WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL is the maximum number of bytes that
+// wuffs_base__render_number_i64 writes: the 20 bytes of
+// "-9223372036854775808".
+#define WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL 20
+
+// WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL is the maximum number of bytes that
+// wuffs_base__render_number_u64 writes: the 21 bytes of
+// "+18446744073709551615", including the optional leading '+'.
+#define WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL 21
+
+// Options (bitwise or'ed together) for the wuffs_base__render_number_xxx
+// functions. The XXX options apply to both integer and floating point. The
+// FXX options apply only to floating point.
+
+#define WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS ((uint32_t)0x00000000)
+
+// WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT means to render to the right side
+// (higher indexes) of the destination slice, leaving any untouched bytes on
+// the left side (lower indexes). The default is vice versa: rendering on the
+// left with slack on the right.
+#define WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT ((uint32_t)0x00000100)
+
+// WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN means to render the leading
+// "+" for non-negative numbers: "+0" and "+12.3" instead of "0" and "12.3".
+#define WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN ((uint32_t)0x00000200)
+
+// WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA means to render
+// one-and-a-half as "1,5" instead of "1.5".
+#define WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA \
+  ((uint32_t)0x00001000)
+
+// WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ETC means whether to never
+// (EXPONENT_ABSENT, equivalent to printf's "%f") or to always
+// (EXPONENT_PRESENT, equivalent to printf's "%e") render a floating point
+// number as "1.23e+05" instead of "123000".
+//
+// Having both bits set is the same as having neither bit set, where the
+// notation used depends on whether the exponent is sufficiently large: "0.5"
+// is preferred over "5e-01" but "5e-09" is preferred over "0.000000005".
+#define WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT ((uint32_t)0x00002000)
+#define WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT ((uint32_t)0x00004000)
+
+// WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION means to render the
+// smallest number of digits so that parsing the resultant string will recover
+// the same double-precision floating point number.
+//
+// For example, double-precision cannot represent 0.3 exactly, but parsing
+// "0.3" will return the closest double-precision number, and so rendering
+// with this option will give "0.3" instead of "0.299999999999999988898".
+#define WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION \
+  ((uint32_t)0x00008000)
+
+// wuffs_base__render_number_i64 writes the decimal encoding of x to dst and
+// returns the number of bytes written. If dst is shorter than the entire
+// encoding, it returns 0 (and no bytes are written).
+//
+// dst will never be too short if its length is at least 20, also known as
+// WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL.
+//
+// It is similar to the C standard library's snprintf with "%" PRIi64, but it
+// does not write a terminating NUL byte and is not affected by i18n / l10n
+// settings such as environment variables.
+size_t  //
+wuffs_base__render_number_i64(wuffs_base__slice_u8 dst,
+                              int64_t x,
+                              uint32_t options);
+
+// wuffs_base__render_number_u64 writes the decimal encoding of x to dst and
+// returns the number of bytes written. If dst is shorter than the entire
+// encoding, it returns 0 (and no bytes are written).
+//
+// dst will never be too short if its length is at least 21, also known as
+// WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL.
+size_t  //
+wuffs_base__render_number_u64(wuffs_base__slice_u8 dst,
+                              uint64_t x,
+                              uint32_t options);
+
 // ---------------- IEEE 754 Floating Point
 
 // wuffs_base__parse_number_f64 parses the floating point number in s. For
@@ -3633,6 +3956,45 @@ wuffs_base__parse_number_u64(wuffs_base__slice_u8 s);
 wuffs_base__result_f64  //
 wuffs_base__parse_number_f64(wuffs_base__slice_u8 s);
 
+// wuffs_base__render_number_f64 writes the decimal encoding of x to dst and
+// returns the number of bytes written. If dst is shorter than the entire
+// encoding, it returns 0 (and no bytes are written).
+//
+// For those familiar with C's printf or Go's fmt.Printf functions:
+//  - "%e" means the WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT option.
+//  - "%f" means the WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT  option.
+//  - "%g" means neither or both bits are set.
+//
+// The precision argument controls the number of digits rendered, excluding
+// the exponent (the "e+05" in "1.23e+05"):
+//  - for "%e" and "%f" it is the number of digits after the decimal separator,
+//  - for "%g" it is the number of significant digits (and trailing zeroes are
+//    removed).
+//
+// A precision of 6 gives the same output as printf's defaults. A precision
+// greater than 4095 is equivalent to 4095. Digits after the first 500
+// significant digits (which only matter for very large precisions) are
+// rendered as '0'.
+//
+// The precision argument is ignored when the
+// WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION option is set. This is
+// similar to Go's strconv.FormatFloat with a negative precision, but there is
+// no corresponding feature in C's printf. With that option, "%g" uses the
+// exponent notation when the decimal exponent is less than -6 or at least
+// 21, like JavaScript's Number.prototype.toString.
+//
+// Extreme values of x will be rendered as "NaN", "Inf" (or "+Inf" if the
+// WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN option is set) or "-Inf".
+//
+// Like wuffs_base__render_number_i64, it does not write a terminating NUL
+// byte and is not affected by i18n / l10n settings such as environment
+// variables.
+size_t  //
+wuffs_base__render_number_f64(wuffs_base__slice_u8 dst,
+                              double x,
+                              uint32_t precision,
+                              uint32_t options);
+
 // wuffs_base__ieee_754_bit_representation__etc converts between a double
 // precision numerical value and its IEEE 754 64-bit representation (1 sign
 // bit, 11 exponent bits, 52 explicit significand bits).
@@ -4287,10 +4649,18 @@ wuffs_adler32__hasher__set_quirk_enabled(wuffs_adler32__hasher* self,
                                          uint32_t a_quirk,
                                          bool a_enabled);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_adler32__hasher__restart(wuffs_adler32__hasher* self);
+
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
 wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
                                   wuffs_base__slice_u8 a_x);
 
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_adler32__hasher__combine_u32(wuffs_adler32__hasher* self,
+                                   uint32_t a_other,
+                                   uint64_t a_other_length);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4316,6 +4686,8 @@ struct wuffs_adler32__hasher__struct {
 
     uint32_t f_state;
     bool f_started;
+    wuffs_base__empty_struct (*choosy_up)(wuffs_adler32__hasher* self,
+                                          wuffs_base__slice_u8 a_x);
 
   } private_impl;
 
@@ -4383,11 +4755,21 @@ struct wuffs_adler32__hasher__struct {
     return wuffs_adler32__hasher__set_quirk_enabled(this, a_quirk, a_enabled);
   }
 
+  inline wuffs_base__empty_struct  //
+  restart() {
+    return wuffs_adler32__hasher__restart(this);
+  }
+
   inline uint32_t  //
   update_u32(wuffs_base__slice_u8 a_x) {
     return wuffs_adler32__hasher__update_u32(this, a_x);
   }
 
+  inline uint32_t  //
+  combine_u32(uint32_t a_other, uint64_t a_other_length) {
+    return wuffs_adler32__hasher__combine_u32(this, a_other, a_other_length);
+  }
+
 #endif  // __cplusplus
 
 };  // struct wuffs_adler32__hasher__struct
@@ -4558,9 +4940,16 @@ struct wuffs_bmp__decoder__struct {
     uint32_t f_dst_y;
     uint32_t f_dst_y_end;
     uint32_t f_dst_y_inc;
+    uint32_t f_scale_log2;
+    uint32_t f_clip_rect_x0;
+    uint32_t f_clip_rect_y0;
+    uint32_t f_clip_rect_x1;
+    uint32_t f_clip_rect_y1;
+    uint64_t f_row_lead_skip;
+    uint64_t f_row_trail_skip;
+    uint64_t f_pending_skip;
     uint8_t f_stash[4];
     uint8_t f_num_stashed;
-    uint8_t f_pending_pad;
     wuffs_base__pixel_swizzler f_swizzler;
 
     uint32_t p_decode_image_config[1];
@@ -4790,10 +5179,18 @@ wuffs_crc32__ieee_hasher__set_quirk_enabled(wuffs_crc32__ieee_hasher* self,
                                             uint32_t a_quirk,
                                             bool a_enabled);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__restart(wuffs_crc32__ieee_hasher* self);
+
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
 wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
                                      wuffs_base__slice_u8 a_x);
 
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__ieee_hasher__combine_u32(wuffs_crc32__ieee_hasher* self,
+                                      uint32_t a_other,
+                                      uint64_t a_other_length);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4818,6 +5215,8 @@ struct wuffs_crc32__ieee_hasher__struct {
     wuffs_base__vtable null_vtable;
 
     uint32_t f_state;
+    wuffs_base__empty_struct (*choosy_up)(wuffs_crc32__ieee_hasher* self,
+                                          wuffs_base__slice_u8 a_x);
 
   } private_impl;
 
@@ -4887,11 +5286,21 @@ struct wuffs_crc32__ieee_hasher__struct {
                                                        a_enabled);
   }
 
+  inline wuffs_base__empty_struct  //
+  restart() {
+    return wuffs_crc32__ieee_hasher__restart(this);
+  }
+
   inline uint32_t  //
   update_u32(wuffs_base__slice_u8 a_x) {
     return wuffs_crc32__ieee_hasher__update_u32(this, a_x);
   }
 
+  inline uint32_t  //
+  combine_u32(uint32_t a_other, uint64_t a_other_length) {
+    return wuffs_crc32__ieee_hasher__combine_u32(this, a_other, a_other_length);
+  }
+
 #endif  // __cplusplus
 
 };  // struct wuffs_crc32__ieee_hasher__struct
@@ -4926,10 +5335,18 @@ extern const char* wuffs_deflate__error__no_huffman_codes;
 
 #define WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
 
+#define WUFFS_DEFLATE__QUIRK_CONTIGUOUS_DST 867177472
+
+#define WUFFS_DEFLATE__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_DEFLATE__ENCODER_DEFAULT_LEVEL 6
+
 // ---------------- Struct Declarations
 
 typedef struct wuffs_deflate__decoder__struct wuffs_deflate__decoder;
 
+typedef struct wuffs_deflate__encoder__struct wuffs_deflate__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -4947,6 +5364,15 @@ wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
 size_t  //
 sizeof__wuffs_deflate__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_deflate__encoder();
+
 // ---------------- Allocs
 
 // These functions allocate and initialize Wuffs structs. They return NULL if
@@ -4963,6 +5389,14 @@ wuffs_deflate__decoder__alloc_as__wuffs_base__io_transformer() {
   return (wuffs_base__io_transformer*)(wuffs_deflate__decoder__alloc());
 }
 
+wuffs_deflate__encoder*  //
+wuffs_deflate__encoder__alloc();
+
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__encoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_deflate__encoder__alloc());
+}
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -4971,6 +5405,12 @@ wuffs_deflate__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
@@ -4982,6 +5422,19 @@ wuffs_deflate__decoder__set_quirk_enabled(wuffs_deflate__decoder* self,
                                           uint32_t a_quirk,
                                           bool a_enabled);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__prime(wuffs_deflate__decoder* self,
+                              uint32_t a_bits,
+                              uint32_t a_n_bits);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_src_bit_position(
+    const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_dst_position(
+    const wuffs_deflate__decoder* self);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
 wuffs_deflate__decoder__workbuf_len(const wuffs_deflate__decoder* self);
 
@@ -4991,6 +5444,24 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
                                      wuffs_base__io_buffer* a_src,
                                      wuffs_base__slice_u8 a_workbuf);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_quirk_enabled(wuffs_deflate__encoder* self,
+                                          uint32_t a_quirk,
+                                          bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self,
+                                  uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -5019,6 +5490,9 @@ struct wuffs_deflate__decoder__struct {
     uint32_t f_history_index;
     uint32_t f_n_huffs_bits[2];
     bool f_end_of_block;
+    uint64_t f_block_start_src_bit_pos;
+    uint64_t f_block_start_dst_pos;
+    bool f_quirks[1];
 
     uint32_t p_transform_io[1];
     uint32_t p_decode_blocks[1];
@@ -5028,7 +5502,7 @@ struct wuffs_deflate__decoder__struct {
   } private_impl;
 
   struct {
-    uint32_t f_huffs[2][1024];
+    uint32_t f_huffs[2][2048];
     uint8_t f_history[33025];
     uint8_t f_code_lengths[320];
 
@@ -5139,6 +5613,21 @@ struct wuffs_deflate__decoder__struct {
     return wuffs_deflate__decoder__set_quirk_enabled(this, a_quirk, a_enabled);
   }
 
+  inline wuffs_base__empty_struct  //
+  prime(uint32_t a_bits, uint32_t a_n_bits) {
+    return wuffs_deflate__decoder__prime(this, a_bits, a_n_bits);
+  }
+
+  inline uint64_t  //
+  block_start_src_bit_position() const {
+    return wuffs_deflate__decoder__block_start_src_bit_position(this);
+  }
+
+  inline uint64_t  //
+  block_start_dst_position() const {
+    return wuffs_deflate__decoder__block_start_dst_position(this);
+  }
+
   inline wuffs_base__range_ii_u64  //
   workbuf_len() const {
     return wuffs_deflate__decoder__workbuf_len(this);
@@ -5155,46 +5644,207 @@ struct wuffs_deflate__decoder__struct {
 
 };  // struct wuffs_deflate__decoder__struct
 
-#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
-
-#ifdef __cplusplus
-}  // extern "C"
-#endif
+struct wuffs_deflate__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
 
-#ifdef __cplusplus
-extern "C" {
-#endif
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
 
-// ---------------- Status Codes
+    uint32_t f_set_level_arg;
+    uint32_t f_level;
+    uint32_t f_good_length;
+    uint32_t f_max_lazy;
+    uint32_t f_nice_length;
+    uint32_t f_max_chain;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_strstart;
+    uint32_t f_w_end;
+    uint32_t f_match_length;
+    uint32_t f_match_distance;
+    bool f_match_available;
+    uint32_t f_n_syms;
+    uint32_t f_block_len;
+    uint32_t f_hlit_minus_257;
+    uint32_t f_hdist_minus_1;
+    uint32_t f_hclen_minus_4;
+    uint32_t f_n_cl_syms;
 
-extern const char* wuffs_lzw__error__bad_code;
+    uint32_t p_transform_io[1];
+    uint32_t p_write_bits[1];
+    uint32_t p_write_block[1];
+    uint32_t p_write_syms[1];
+  } private_impl;
 
-// ---------------- Public Consts
+  struct {
+    uint8_t f_window[65808];
+    uint16_t f_head[32768];
+    uint16_t f_prev[32768];
+    uint32_t f_syms[16384];
+    uint32_t f_freqs[512];
+    uint8_t f_lens[512];
+    uint16_t f_codes[512];
+    uint16_t f_cl_syms[320];
+    uint32_t f_h_keys[512];
+    uint32_t f_h_depths[512];
+    uint32_t f_h_counts[16];
+    uint32_t f_h_next_codes[16];
 
-#define WUFFS_LZW__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+    struct {
+      uint64_t scratch;
+    } s_write_bits[1];
+    struct {
+      uint32_t v_block_end;
+      uint32_t v_block_start;
+      uint32_t v_type;
+      uint32_t v_header;
+      uint32_t v_i;
+      uint32_t v_x;
+      uint64_t scratch;
+    } s_write_block[1];
+    struct {
+      uint64_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_i;
+      uint32_t v_x;
+      uint64_t scratch;
+    } s_write_syms[1];
+  } private_data;
 
-// ---------------- Struct Declarations
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_deflate__encoder, decltype(&free)>;
 
-typedef struct wuffs_lzw__decoder__struct wuffs_lzw__decoder;
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
 
-// ---------------- Public Initializer Prototypes
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_deflate__encoder__alloc(), &free);
+  }
 
-// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
-// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
-//
-// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
-// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for initialize_flags.
+  static inline wuffs_base__io_transformer::unique_ptr  //
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_deflate__encoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // __cplusplus >= 201103L
 
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
-                               size_t sizeof_star_self,
-                               uint64_t wuffs_version,
-                               uint32_t initialize_flags);
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__encoder__struct() = delete;
+  wuffs_deflate__encoder__struct(const wuffs_deflate__encoder__struct&) =
+      delete;
+  wuffs_deflate__encoder__struct& operator=(
+      const wuffs_deflate__encoder__struct&) = delete;
 
-size_t  //
-sizeof__wuffs_lzw__decoder();
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
 
-// ---------------- Allocs
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_deflate__encoder__initialize(this, sizeof_star_self,
+                                              wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_deflate__encoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_level) {
+    return wuffs_deflate__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_deflate__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_deflate__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Status Codes
+
+extern const char* wuffs_lzw__error__bad_code;
+
+// ---------------- Public Consts
+
+#define WUFFS_LZW__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_lzw__decoder__struct wuffs_lzw__decoder;
+
+// ---------------- Public Initializer Prototypes
+
+// For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
+// etc)" should be called before any other "wuffs_foo__bar__xxx(self, etc)".
+//
+// Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
+// Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for initialize_flags.
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_lzw__decoder();
+
+// ---------------- Allocs
 
 // These functions allocate and initialize Wuffs structs. They return NULL if
 // memory allocation fails. If they return non-NULL, there is no need to call
@@ -5914,6 +6564,11 @@ struct wuffs_gif__decoder__struct {
     uint32_t f_dst_x;
     uint32_t f_dst_y;
     uint32_t f_dirty_max_excl_y;
+    uint32_t f_scale_log2;
+    uint32_t f_clip_rect_x0;
+    uint32_t f_clip_rect_y0;
+    uint32_t f_clip_rect_x1;
+    uint32_t f_clip_rect_y1;
     uint64_t f_compressed_ri;
     uint64_t f_compressed_wi;
     wuffs_base__pixel_swizzler f_swizzler;
@@ -6150,10 +6805,16 @@ extern const char* wuffs_gzip__error__bad_header;
 
 #define WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
 
+#define WUFFS_GZIP__QUIRK_MULTIPLE_MEMBERS 1066916864
+
+#define WUFFS_GZIP__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
 // ---------------- Struct Declarations
 
 typedef struct wuffs_gzip__decoder__struct wuffs_gzip__decoder;
 
+typedef struct wuffs_gzip__encoder__struct wuffs_gzip__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -6171,6 +6832,15 @@ wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
 size_t  //
 sizeof__wuffs_gzip__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__encoder__initialize(wuffs_gzip__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_gzip__encoder();
+
 // ---------------- Allocs
 
 // These functions allocate and initialize Wuffs structs. They return NULL if
@@ -6187,6 +6857,14 @@ wuffs_gzip__decoder__alloc_as__wuffs_base__io_transformer() {
   return (wuffs_base__io_transformer*)(wuffs_gzip__decoder__alloc());
 }
 
+wuffs_gzip__encoder*  //
+wuffs_gzip__encoder__alloc();
+
+static inline wuffs_base__io_transformer*  //
+wuffs_gzip__encoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_gzip__encoder__alloc());
+}
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -6195,6 +6873,12 @@ wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_gzip__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_gzip__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
@@ -6214,6 +6898,23 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
                                   wuffs_base__io_buffer* a_src,
                                   wuffs_base__slice_u8 a_workbuf);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_quirk_enabled(wuffs_gzip__encoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_level(wuffs_gzip__encoder* self, uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__encoder__workbuf_len(const wuffs_gzip__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__encoder__transform_io(wuffs_gzip__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -6237,6 +6938,7 @@ struct wuffs_gzip__decoder__struct {
     wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
     wuffs_base__vtable null_vtable;
 
+    bool f_quirks[1];
     bool f_ignore_checksum;
 
     uint32_t p_transform_io[1];
@@ -6340,6 +7042,122 @@ struct wuffs_gzip__decoder__struct {
 
 };  // struct wuffs_gzip__decoder__struct
 
+struct wuffs_gzip__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_level_plus_1;
+
+    uint32_t p_transform_io[1];
+  } private_impl;
+
+  struct {
+    wuffs_crc32__ieee_hasher f_checksum;
+    wuffs_deflate__encoder f_flate;
+
+    struct {
+      uint8_t v_xfl;
+      uint32_t v_checksum_got;
+      uint32_t v_src_length;
+      uint64_t scratch;
+    } s_transform_io[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_gzip__encoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_gzip__encoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr  //
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_gzip__encoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // __cplusplus >= 201103L
+
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gzip__encoder__struct() = delete;
+  wuffs_gzip__encoder__struct(const wuffs_gzip__encoder__struct&) = delete;
+  wuffs_gzip__encoder__struct& operator=(const wuffs_gzip__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_gzip__encoder__initialize(this, sizeof_star_self,
+                                           wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_gzip__encoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_level) {
+    return wuffs_gzip__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_gzip__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_gzip__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_gzip__encoder__struct
+
 #endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
 #ifdef __cplusplus
@@ -6744,6 +7562,11 @@ struct wuffs_wbmp__decoder__struct {
     uint32_t f_height;
     uint8_t f_call_sequence;
     uint64_t f_frame_config_io_position;
+    uint32_t f_scale_log2;
+    uint32_t f_clip_rect_x0;
+    uint32_t f_clip_rect_y0;
+    uint32_t f_clip_rect_x1;
+    uint32_t f_clip_rect_y1;
     wuffs_base__pixel_swizzler f_swizzler;
 
     uint32_t p_decode_image_config[1];
@@ -6758,10 +7581,14 @@ struct wuffs_wbmp__decoder__struct {
       uint32_t v_x32;
     } s_decode_image_config[1];
     struct {
+      uint64_t v_dst_bytes_per_pixel;
+      uint32_t v_scale_mask;
+      uint64_t v_bytes_per_row;
       uint32_t v_dst_x;
       uint32_t v_dst_y;
       uint8_t v_src[1];
       uint8_t v_c;
+      uint64_t scratch;
     } s_decode_frame[1];
     struct {
       uint64_t scratch;
@@ -6929,12 +7756,18 @@ extern const char* wuffs_zlib__error__incorrect_dictionary;
 
 // ---------------- Public Consts
 
+#define WUFFS_ZLIB__QUIRK_MULTIPLE_STREAMS 2113790976
+
 #define WUFFS_ZLIB__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
 
+#define WUFFS_ZLIB__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
 // ---------------- Struct Declarations
 
 typedef struct wuffs_zlib__decoder__struct wuffs_zlib__decoder;
 
+typedef struct wuffs_zlib__encoder__struct wuffs_zlib__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -6952,6 +7785,15 @@ wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
 size_t  //
 sizeof__wuffs_zlib__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_zlib__encoder__initialize(wuffs_zlib__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_zlib__encoder();
+
 // ---------------- Allocs
 
 // These functions allocate and initialize Wuffs structs. They return NULL if
@@ -6968,6 +7810,14 @@ wuffs_zlib__decoder__alloc_as__wuffs_base__io_transformer() {
   return (wuffs_base__io_transformer*)(wuffs_zlib__decoder__alloc());
 }
 
+wuffs_zlib__encoder*  //
+wuffs_zlib__encoder__alloc();
+
+static inline wuffs_base__io_transformer*  //
+wuffs_zlib__encoder__alloc_as__wuffs_base__io_transformer() {
+  return (wuffs_base__io_transformer*)(wuffs_zlib__encoder__alloc());
+}
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -6976,6 +7826,12 @@ wuffs_zlib__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_zlib__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_zlib__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
@@ -7002,6 +7858,23 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
                                   wuffs_base__io_buffer* a_src,
                                   wuffs_base__slice_u8 a_workbuf);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__encoder__set_quirk_enabled(wuffs_zlib__encoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__encoder__set_level(wuffs_zlib__encoder* self, uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_zlib__encoder__workbuf_len(const wuffs_zlib__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_zlib__encoder__transform_io(wuffs_zlib__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -7029,6 +7902,7 @@ struct wuffs_zlib__decoder__struct {
     bool f_header_complete;
     bool f_got_dictionary;
     bool f_want_dictionary;
+    bool f_quirks[1];
     bool f_ignore_checksum;
     uint32_t f_dict_id_got;
     uint32_t f_dict_id_want;
@@ -7142,20 +8016,135 @@ struct wuffs_zlib__decoder__struct {
 
 };  // struct wuffs_zlib__decoder__struct
 
-#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+struct wuffs_zlib__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
 
-#ifdef __cplusplus
-}  // extern "C"
-#endif
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
 
-// WUFFS C HEADER ENDS HERE.
-#ifdef WUFFS_IMPLEMENTATION
+    uint32_t f_level_plus_1;
 
-#ifdef __cplusplus
-extern "C" {
-#endif
+    uint32_t p_transform_io[1];
+  } private_impl;
 
-static inline wuffs_base__empty_struct  //
+  struct {
+    wuffs_adler32__hasher f_checksum;
+    wuffs_deflate__encoder f_flate;
+
+    struct {
+      uint32_t v_level;
+      uint32_t v_checksum_got;
+      uint64_t scratch;
+    } s_transform_io[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if __cplusplus >= 201103L
+  using unique_ptr = std::unique_ptr<wuffs_zlib__encoder, decltype(&free)>;
+
+  // On failure, the alloc_etc functions return nullptr. They don't throw.
+
+  static inline unique_ptr  //
+  alloc() {
+    return unique_ptr(wuffs_zlib__encoder__alloc(), &free);
+  }
+
+  static inline wuffs_base__io_transformer::unique_ptr  //
+  alloc_as__wuffs_base__io_transformer() {
+    return wuffs_base__io_transformer::unique_ptr(
+        wuffs_zlib__encoder__alloc_as__wuffs_base__io_transformer(), &free);
+  }
+#endif  // __cplusplus >= 201103L
+
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_zlib__encoder__struct() = delete;
+  wuffs_zlib__encoder__struct(const wuffs_zlib__encoder__struct&) = delete;
+  wuffs_zlib__encoder__struct& operator=(const wuffs_zlib__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_zlib__encoder__initialize(this, sizeof_star_self,
+                                           wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_quirk_enabled(uint32_t a_quirk, bool a_enabled) {
+    return wuffs_zlib__encoder__set_quirk_enabled(this, a_quirk, a_enabled);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_level) {
+    return wuffs_zlib__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_zlib__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_zlib__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_zlib__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+// WUFFS C HEADER ENDS HERE.
+#ifdef WUFFS_IMPLEMENTATION
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline wuffs_base__empty_struct  //
 wuffs_base__ignore_status(wuffs_base__status z) {
   return wuffs_base__make_empty_struct();
 }
@@ -7214,6 +8203,43 @@ wuffs_base__ignore_status(wuffs_base__status z) {
 #define WUFFS_BASE__UNLIKELY(expr) (expr)
 #endif
 
+// ---------------- CPU Architecture
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__cpu_arch__have_x86_sse42 returns whether the CPU supports the
+// PCLMUL, POPCNT, SSE4.2 (and implied SSE4.1 and SSSE3) instructions. Functions
+// marked with the WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+// attribute can only be called when this returns true.
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_sse42() {
+#if defined(__PCLMUL__) && defined(__POPCNT__) && defined(__SSE4_2__)
+  // The compiler already assumes that the CPU has these features.
+  return true;
+#else
+  // __builtin_cpu_supports reads CPUID results that the compiler's run-time
+  // library caches at program start-up. Executing the CPUID instruction here
+  // instead can be surprisingly slow, especially under virtualization.
+  return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("popcnt") &&
+         __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+// wuffs_base__cpu_arch__have_x86_avx2 returns whether the CPU supports the
+// AVX2 instructions. Functions marked with the
+// WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("avx2") attribute can only be called when
+// this returns true.
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_avx2() {
+#if defined(__AVX2__)
+  return true;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- Numeric Types
 
 extern const uint8_t wuffs_base__low_bits_mask__u8[9];
@@ -7360,6 +8386,26 @@ wuffs_base__range_ie_u64__get_max_excl(const wuffs_base__range_ie_u64* r) {
   return r->max_excl;
 }
 
+static inline uint32_t  //
+wuffs_base__rect_ie_u32__get_min_incl_x(const wuffs_base__rect_ie_u32* r) {
+  return r->min_incl_x;
+}
+
+static inline uint32_t  //
+wuffs_base__rect_ie_u32__get_min_incl_y(const wuffs_base__rect_ie_u32* r) {
+  return r->min_incl_y;
+}
+
+static inline uint32_t  //
+wuffs_base__rect_ie_u32__get_max_excl_x(const wuffs_base__rect_ie_u32* r) {
+  return r->max_excl_x;
+}
+
+static inline uint32_t  //
+wuffs_base__rect_ie_u32__get_max_excl_y(const wuffs_base__rect_ie_u32* r) {
+  return r->max_excl_y;
+}
+
   // ---------------- Ranges and Rects (Utility)
 
 #define wuffs_base__utility__empty_range_ii_u32 wuffs_base__empty_range_ii_u32
@@ -7420,10 +8466,9 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
   // argument, and the cgen can look if that argument is the constant
   // expression '3'.
   //
-  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.
-  //
-  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method
-  // that copies 8 bytes at a time, possibly writing more than length bytes?
+  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, and the
+  // _8_byte_chunks_fast variant after that, which copies 8 bytes at a time,
+  // possibly writing more than length bytes.
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -7463,6 +8508,73 @@ wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
   return length;
 }
 
+// wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast is like the
+// wuffs_base__io_writer__copy_n32_from_history_fast function above, but copies
+// 8 bytes at a time, so it can write up to 8 bytes more than the length bytes
+// it copies. Those excess bytes are not part of the output (*ptr_iop_w is
+// only advanced by length) and will be overwritten by later writes. The
+// caller needs to prove that:
+//  - distance >  0
+//  - distance <= (*ptr_iop_w - io1_w)
+//  - (length + 8) <= (io2_w - *ptr_iop_w)
+//
+// A distance of at least 8 means that each 8 byte chunk's source is entirely
+// before its destination. Distances of 1, 2 and 4 (runs of a repeated byte or
+// pattern) broadcast that pattern to 8 bytes and store it repeatedly. Other
+// distances copy one byte at a time.
+static inline uint32_t  //
+wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(
+    uint8_t** ptr_iop_w,
+    uint8_t* io1_w,
+    uint8_t* io2_w,
+    uint32_t length,
+    uint32_t distance) {
+  uint8_t* p = *ptr_iop_w;
+  uint8_t* q = p - distance;
+  uint32_t n = length;
+  if (distance >= 8) {
+    while (true) {
+      memcpy(p, q, 8);
+      if (n <= 8) {
+        break;
+      }
+      p += 8;
+      q += 8;
+      n -= 8;
+    }
+  } else if ((distance == 1) || (distance == 2) || (distance == 4)) {
+    uint64_t x;
+    if (distance == 1) {
+      x = 0x0101010101010101 * ((uint64_t)(q[0]));
+    } else if (distance == 2) {
+      x = 0x0001000100010001 *
+          ((uint64_t)(wuffs_base__load_u16le__no_bounds_check(q)));
+    } else {
+      x = 0x0000000100000001 *
+          ((uint64_t)(wuffs_base__load_u32le__no_bounds_check(q)));
+    }
+    while (true) {
+      wuffs_base__store_u64le__no_bounds_check(p, x);
+      if (n <= 8) {
+        break;
+      }
+      p += 8;
+      n -= 8;
+    }
+  } else {
+    for (; n >= 3; n -= 3) {
+      *p++ = *q++;
+      *p++ = *q++;
+      *p++ = *q++;
+    }
+    for (; n; n--) {
+      *p++ = *q++;
+    }
+  }
+  *ptr_iop_w += length;
+  return length;
+}
+
 static inline uint32_t  //
 wuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,
                                             uint8_t* io2_w,
@@ -8397,6 +9509,42 @@ wuffs_base__composite_premul_nonpremul_u32_axxx(uint32_t dst_premul,
   return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);
 }
 
+static inline uint32_t  //
+wuffs_base__composite_premul_premul_u32_axxx(uint32_t dst_premul,
+                                             uint32_t src_premul) {
+  // Convert from 8-bit color to 16-bit color.
+  uint32_t sa = 0x101 * (0xFF & (src_premul >> 24));
+  uint32_t sr = 0x101 * (0xFF & (src_premul >> 16));
+  uint32_t sg = 0x101 * (0xFF & (src_premul >> 8));
+  uint32_t sb = 0x101 * (0xFF & (src_premul >> 0));
+  uint32_t da = 0x101 * (0xFF & (dst_premul >> 24));
+  uint32_t dr = 0x101 * (0xFF & (dst_premul >> 16));
+  uint32_t dg = 0x101 * (0xFF & (dst_premul >> 8));
+  uint32_t db = 0x101 * (0xFF & (dst_premul >> 0));
+
+  // Calculate the inverse of the src-alpha: how much of the dst to keep.
+  uint32_t ia = 0xFFFF - sa;
+
+  // Composite src (premul) over dst (premul).
+  da = sa + ((da * ia) / 0xFFFF);
+  dr = sr + ((dr * ia) / 0xFFFF);
+  dg = sg + ((dg * ia) / 0xFFFF);
+  db = sb + ((db * ia) / 0xFFFF);
+
+  // Valid premul colors are no greater than their alpha, so these sums are
+  // at most 0xFFFF, but clamp them in case the src or dst is invalid.
+  dr = (dr < 0xFFFF) ? dr : 0xFFFF;
+  dg = (dg < 0xFFFF) ? dg : 0xFFFF;
+  db = (db < 0xFFFF) ? db : 0xFFFF;
+
+  // Convert from 16-bit color to 8-bit color and combine the components.
+  da >>= 8;
+  dr >>= 8;
+  dg >>= 8;
+  db >>= 8;
+  return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);
+}
+
 static inline uint32_t  //
 wuffs_base__premul_u32_axxx(uint32_t nonpremul) {
   // Multiplying by 0x101 (twice, once for alpha and once for color) converts
@@ -8441,6 +9589,27 @@ wuffs_base__nonpremul_u32_axxx(uint32_t premul) {
   return (a << 24) | (r << 16) | (g << 8) | (b << 0);
 }
 
+// wuffs_base__pixel_swizzler__convert_transparency converts the 0xAARRGGBB
+// color c from the src transparency to the dst transparency, where those are
+// the "(repr >> 24) & 7" bits of a wuffs_base__pixel_format. Binary alpha is
+// treated as premultiplied alpha. Opaque and X-padded dsts keep the color as
+// is, as the alpha will be dropped.
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__convert_transparency(uint32_t c,
+                                                 uint32_t dst_transparency,
+                                                 uint32_t src_transparency) {
+  if (src_transparency == 5) {
+    if (dst_transparency >= 6) {
+      return wuffs_base__premul_u32_axxx(c);
+    }
+  } else if (src_transparency >= 6) {
+    if (dst_transparency == 5) {
+      return wuffs_base__nonpremul_u32_axxx(c);
+    }
+  }
+  return c;
+}
+
 wuffs_base__color_u32_argb_premul  //
 wuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_buffer* pb,
                                        uint32_t x,
@@ -8484,17 +9653,9 @@ wuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_buffer* pb,
                                                   (4 * ((size_t)row[x]))));
     }
 
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565: {
-      uint16_t bgr =
-          wuffs_base__load_u16le__no_bounds_check(row + (2 * ((size_t)x)));
-      uint32_t b5 = 0x1F & (bgr >> 0);
-      uint32_t b = (b5 << 3) | (b5 >> 2);
-      uint32_t g6 = 0x3F & (bgr >> 5);
-      uint32_t g = (g6 << 2) | (g6 >> 4);
-      uint32_t r5 = 0x1F & (bgr >> 11);
-      uint32_t r = (r5 << 3) | (r5 >> 2);
-      return 0xFF000000 | (r << 16) | (g << 8) | (b << 0);
-    }
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      return wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
+          wuffs_base__load_u16le__no_bounds_check(row + (2 * ((size_t)x))));
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       return 0xFF000000 |
              wuffs_base__load_u24le__no_bounds_check(row + (3 * ((size_t)x)));
@@ -8561,15 +9722,11 @@ wuffs_base__pixel_buffer__set_color_u32_at(
 
       // Common formats above. Rarer formats below.
 
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565: {
-      uint32_t b5 = 0x1F & (color >> (8 - 5));
-      uint32_t g6 = 0x3F & (color >> (16 - 6));
-      uint32_t r5 = 0x1F & (color >> (24 - 5));
-      uint32_t bgr565 = (b5 << 0) | (g6 << 5) | (r5 << 11);
-      wuffs_base__store_u16le__no_bounds_check(row + (2 * ((size_t)x)),
-                                               (uint16_t)bgr565);
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      wuffs_base__store_u16le__no_bounds_check(
+          row + (2 * ((size_t)x)),
+          wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(color));
       break;
-    }
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
       wuffs_base__store_u24le__no_bounds_check(row + (3 * ((size_t)x)), color);
       break;
@@ -8659,97 +9816,358 @@ wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over(
   return len;
 }
 
-static uint64_t  //
-wuffs_base__pixel_swizzler__copy_1_1(wuffs_base__slice_u8 dst,
-                                     wuffs_base__slice_u8 dst_palette,
-                                     wuffs_base__slice_u8 src) {
-  return wuffs_base__slice_u8__copy_from_slice(dst, src);
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42 maps each 16-bit
+// lane y, the sum of products of 8-bit values with y <= (0xFF * 0xFF), to the
+// 8-bit value that the scalar code's 16-bit color math produces. Widening the
+// 8-bit inputs (multiplying by 0x101), dividing by 0xFFFF and then shifting
+// right by 8 works out to exactly ((y * 0x101) / 0xFF00), which is also
+// exactly (y + ((y * 0x0202) >> 16)) >> 8 for all such y. The sum fits in 16
+// bits.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static inline __m128i  //
+wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(__m128i y) {
+  __m128i q = _mm_mulhi_epu16(y, _mm_set1_epi16(0x0202));
+  return _mm_srli_epi16(_mm_add_epi16(y, q), 8);
 }
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__copy_4_4(wuffs_base__slice_u8 dst,
-                                     wuffs_base__slice_u8 dst_palette,
-                                     wuffs_base__slice_u8 src) {
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
   size_t dst_len4 = dst.len / 4;
   size_t src_len4 = src.len / 4;
   size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
-  if (len > 0) {
-    memmove(dst.ptr, src.ptr, len * 4);
-  }
-  return len;
-}
-
-static uint64_t  //
-wuffs_base__pixel_swizzler__xx__index__src(wuffs_base__slice_u8 dst,
-                                           wuffs_base__slice_u8 dst_palette,
-                                           wuffs_base__slice_u8 src) {
-  if (dst_palette.len != 1024) {
-    return 0;
-  }
-  size_t dst_len2 = dst.len / 2;
-  size_t len = dst_len2 < src.len ? dst_len2 : src.len;
   uint8_t* d = dst.ptr;
   uint8_t* s = src.ptr;
   size_t n = len;
 
-  const size_t loop_unroll_count = 4;
-
-  while (n >= loop_unroll_count) {
-    wuffs_base__store_u16le__no_bounds_check(
-        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(
-                         dst_palette.ptr + ((size_t)s[0] * 4)));
-    wuffs_base__store_u16le__no_bounds_check(
-        d + (1 * 2), wuffs_base__load_u16le__no_bounds_check(
-                         dst_palette.ptr + ((size_t)s[1] * 4)));
-    wuffs_base__store_u16le__no_bounds_check(
-        d + (2 * 2), wuffs_base__load_u16le__no_bounds_check(
-                         dst_palette.ptr + ((size_t)s[2] * 4)));
-    wuffs_base__store_u16le__no_bounds_check(
-        d + (3 * 2), wuffs_base__load_u16le__no_bounds_check(
-                         dst_palette.ptr + ((size_t)s[3] * 4)));
-
-    s += loop_unroll_count * 1;
-    d += loop_unroll_count * 2;
-    n -= loop_unroll_count;
+  // Each color channel is multiplied by its pixel's alpha. The alpha channel
+  // is multiplied by 0xFF, which the scale down maps back to itself.
+  const __m128i z = _mm_setzero_si128();
+  const __m128i alpha_lanes = _mm_setr_epi16(0, 0, 0, 0xFF, 0, 0, 0, 0xFF);
+  const __m128i shuffle_lo =
+      _mm_setr_epi8(3, -128, 3, -128, 3, -128, -128, -128, 7, -128, 7, -128, 7,
+                    -128, -128, -128);
+  const __m128i shuffle_hi =
+      _mm_setr_epi8(11, -128, 11, -128, 11, -128, -128, -128, 15, -128, 15,
+                    -128, 15, -128, -128, -128);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i a_lo = _mm_or_si128(_mm_shuffle_epi8(x, shuffle_lo), alpha_lanes);
+    __m128i a_hi = _mm_or_si128(_mm_shuffle_epi8(x, shuffle_hi), alpha_lanes);
+    __m128i y_lo = _mm_mullo_epi16(_mm_unpacklo_epi8(x, z), a_lo);
+    __m128i y_hi = _mm_mullo_epi16(_mm_unpackhi_epi8(x, z), a_hi);
+    _mm_storeu_si128(
+        (__m128i*)(void*)d,
+        _mm_packus_epi16(
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_lo),
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_hi)));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
   }
 
   while (n >= 1) {
-    wuffs_base__store_u16le__no_bounds_check(
-        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(
-                         dst_palette.ptr + ((size_t)s[0] * 4)));
+    uint32_t s0 = wuffs_base__premul_u32_axxx(
+        wuffs_base__load_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);
 
-    s += 1 * 1;
-    d += 1 * 2;
+    s += 1 * 4;
+    d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__xxx__index__src(wuffs_base__slice_u8 dst,
-                                            wuffs_base__slice_u8 dst_palette,
-                                            wuffs_base__slice_u8 src) {
-  if (dst_palette.len != 1024) {
-    return 0;
-  }
-  size_t dst_len3 = dst.len / 3;
-  size_t len = dst_len3 < src.len ? dst_len3 : src.len;
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
   uint8_t* d = dst.ptr;
   uint8_t* s = src.ptr;
   size_t n = len;
 
-  const size_t loop_unroll_count = 4;
+  // Each dst channel becomes (s * sa) + (d * (0xFF - sa)), scaled down, where
+  // the src alpha channel's s is replaced by 0xFF. This matches the scalar
+  // wuffs_base__composite_premul_nonpremul_u32_axxx.
+  const __m128i z = _mm_setzero_si128();
+  const __m128i ff = _mm_set1_epi16(0xFF);
+  const __m128i alpha_bytes = _mm_set1_epi32((int32_t)0xFF000000);
+  const __m128i shuffle_lo = _mm_setr_epi8(3, -128, 3, -128, 3, -128, 3, -128,
+                                           7, -128, 7, -128, 7, -128, 7, -128);
+  const __m128i shuffle_hi =
+      _mm_setr_epi8(11, -128, 11, -128, 11, -128, 11, -128, 15, -128, 15, -128,
+                    15, -128, 15, -128);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m128i w = _mm_lddqu_si128((const __m128i*)(const void*)d);
+    __m128i sa_lo = _mm_shuffle_epi8(x, shuffle_lo);
+    __m128i sa_hi = _mm_shuffle_epi8(x, shuffle_hi);
+    x = _mm_or_si128(x, alpha_bytes);
+    __m128i y_lo = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpacklo_epi8(x, z), sa_lo),
+        _mm_mullo_epi16(_mm_unpacklo_epi8(w, z), _mm_sub_epi16(ff, sa_lo)));
+    __m128i y_hi = _mm_add_epi16(
+        _mm_mullo_epi16(_mm_unpackhi_epi8(x, z), sa_hi),
+        _mm_mullo_epi16(_mm_unpackhi_epi8(w, z), _mm_sub_epi16(ff, sa_hi)));
+    _mm_storeu_si128(
+        (__m128i*)(void*)d,
+        _mm_packus_epi16(
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_lo),
+            wuffs_base__pixel_swizzler__u16x8_scale_down__x86_sse42(y_hi)));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
 
-  // The comparison in the while condition is ">", not ">=", because with ">=",
-  // the last 4-byte store could write past the end of the dst slice.
-  //
-  // Each 4-byte store writes one too many bytes, but a subsequent store will
-  // overwrite that with the correct byte. There is always another store,
-  // whether a 4-byte store in this loop or a 1-byte store in the next loop.
-  while (n > loop_unroll_count) {
-    wuffs_base__store_u32le__no_bounds_check(
-        d + (0 * 3), wuffs_base__load_u32le__no_bounds_check(
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__load_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__store_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__copy_1_1(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 dst_palette,
+                                     wuffs_base__slice_u8 src) {
+  return wuffs_base__slice_u8__copy_from_slice(dst, src);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__copy_2_2(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 dst_palette,
+                                     wuffs_base__slice_u8 src) {
+  size_t dst_len2 = dst.len / 2;
+  size_t src_len2 = src.len / 2;
+  size_t len = dst_len2 < src_len2 ? dst_len2 : src_len2;
+  if (len > 0) {
+    memmove(dst.ptr, src.ptr, len * 2);
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__copy_3_3(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 dst_palette,
+                                     wuffs_base__slice_u8 src) {
+  size_t dst_len3 = dst.len / 3;
+  size_t src_len3 = src.len / 3;
+  size_t len = dst_len3 < src_len3 ? dst_len3 : src_len3;
+  if (len > 0) {
+    memmove(dst.ptr, src.ptr, len * 3);
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__copy_4_4(wuffs_base__slice_u8 dst,
+                                     wuffs_base__slice_u8 dst_palette,
+                                     wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
+  if (len > 0) {
+    memmove(dst.ptr, src.ptr, len * 4);
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgb_bgr(wuffs_base__slice_u8 dst,
+                                         wuffs_base__slice_u8 dst_palette,
+                                         wuffs_base__slice_u8 src) {
+  size_t dst_len3 = dst.len / 3;
+  size_t src_len3 = src.len / 3;
+  size_t len = dst_len3 < src_len3 ? dst_len3 : src_len3;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+
+    s += 1 * 3;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx(wuffs_base__slice_u8 dst,
+                                           wuffs_base__slice_u8 dst_palette,
+                                           wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    uint8_t b3 = s[3];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = b3;
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len4 = src.len / 4;
+  size_t len = dst_len4 < src_len4 ? dst_len4 : src_len4;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  const __m128i shuffle =
+      _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+  while (n >= 4) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)d, _mm_shuffle_epi8(x, shuffle));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    uint8_t b3 = s[3];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = b3;
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__xx__index__src(wuffs_base__slice_u8 dst,
+                                           wuffs_base__slice_u8 dst_palette,
+                                           wuffs_base__slice_u8 src) {
+  if (dst_palette.len != 1024) {
+    return 0;
+  }
+  size_t dst_len2 = dst.len / 2;
+  size_t len = dst_len2 < src.len ? dst_len2 : src.len;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  const size_t loop_unroll_count = 4;
+
+  while (n >= loop_unroll_count) {
+    wuffs_base__store_u16le__no_bounds_check(
+        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(
+                         dst_palette.ptr + ((size_t)s[0] * 4)));
+    wuffs_base__store_u16le__no_bounds_check(
+        d + (1 * 2), wuffs_base__load_u16le__no_bounds_check(
+                         dst_palette.ptr + ((size_t)s[1] * 4)));
+    wuffs_base__store_u16le__no_bounds_check(
+        d + (2 * 2), wuffs_base__load_u16le__no_bounds_check(
+                         dst_palette.ptr + ((size_t)s[2] * 4)));
+    wuffs_base__store_u16le__no_bounds_check(
+        d + (3 * 2), wuffs_base__load_u16le__no_bounds_check(
+                         dst_palette.ptr + ((size_t)s[3] * 4)));
+
+    s += loop_unroll_count * 1;
+    d += loop_unroll_count * 2;
+    n -= loop_unroll_count;
+  }
+
+  while (n >= 1) {
+    wuffs_base__store_u16le__no_bounds_check(
+        d + (0 * 2), wuffs_base__load_u16le__no_bounds_check(
+                         dst_palette.ptr + ((size_t)s[0] * 4)));
+
+    s += 1 * 1;
+    d += 1 * 2;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxx__index__src(wuffs_base__slice_u8 dst,
+                                            wuffs_base__slice_u8 dst_palette,
+                                            wuffs_base__slice_u8 src) {
+  if (dst_palette.len != 1024) {
+    return 0;
+  }
+  size_t dst_len3 = dst.len / 3;
+  size_t len = dst_len3 < src.len ? dst_len3 : src.len;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  const size_t loop_unroll_count = 4;
+
+  // The comparison in the while condition is ">", not ">=", because with ">=",
+  // the last 4-byte store could write past the end of the dst slice.
+  //
+  // Each 4-byte store writes one too many bytes, but a subsequent store will
+  // overwrite that with the correct byte. There is always another store,
+  // whether a 4-byte store in this loop or a 1-byte store in the next loop.
+  while (n > loop_unroll_count) {
+    wuffs_base__store_u32le__no_bounds_check(
+        d + (0 * 3), wuffs_base__load_u32le__no_bounds_check(
                          dst_palette.ptr + ((size_t)s[0] * 4)));
     wuffs_base__store_u32le__no_bounds_check(
         d + (1 * 3), wuffs_base__load_u32le__no_bounds_check(
@@ -8801,22 +10219,22 @@ wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(
     uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[0] * 4));
     if (s0) {
-      wuffs_base__store_u24le__no_bounds_check(d + (0 * 4), s0);
+      wuffs_base__store_u24le__no_bounds_check(d + (0 * 3), s0);
     }
     uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[1] * 4));
     if (s1) {
-      wuffs_base__store_u24le__no_bounds_check(d + (1 * 4), s1);
+      wuffs_base__store_u24le__no_bounds_check(d + (1 * 3), s1);
     }
     uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[2] * 4));
     if (s2) {
-      wuffs_base__store_u24le__no_bounds_check(d + (2 * 4), s2);
+      wuffs_base__store_u24le__no_bounds_check(d + (2 * 3), s2);
     }
     uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[3] * 4));
     if (s3) {
-      wuffs_base__store_u24le__no_bounds_check(d + (3 * 4), s3);
+      wuffs_base__store_u24le__no_bounds_check(d + (3 * 3), s3);
     }
 
     s += loop_unroll_count * 1;
@@ -8828,7 +10246,7 @@ wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(
     uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[0] * 4));
     if (s0) {
-      wuffs_base__store_u24le__no_bounds_check(d + (0 * 4), s0);
+      wuffs_base__store_u24le__no_bounds_check(d + (0 * 3), s0);
     }
 
     s += 1 * 1;
@@ -8839,6 +10257,30 @@ wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over(
   return len;
 }
 
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxx__y(wuffs_base__slice_u8 dst,
+                                   wuffs_base__slice_u8 dst_palette,
+                                   wuffs_base__slice_u8 src) {
+  size_t dst_len3 = dst.len / 3;
+  size_t len = dst_len3 < src.len ? dst_len3 : src.len;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    d[0] = s0;
+    d[1] = s0;
+    d[2] = s0;
+
+    s += 1 * 1;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__xxxx__index__src(wuffs_base__slice_u8 dst,
                                              wuffs_base__slice_u8 dst_palette,
@@ -8886,8 +10328,10 @@ wuffs_base__pixel_swizzler__xxxx__index__src(wuffs_base__slice_u8 dst,
   return len;
 }
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("avx2")
 static uint64_t  //
-wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over(
+wuffs_base__pixel_swizzler__xxxx__index__src__x86_avx2(
     wuffs_base__slice_u8 dst,
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src) {
@@ -8900,37 +10344,78 @@ wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over(
   uint8_t* s = src.ptr;
   size_t n = len;
 
-  const size_t loop_unroll_count = 4;
+  const int* palette = (const int*)(const void*)(dst_palette.ptr);
 
-  while (n >= loop_unroll_count) {
-    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
-                                                          ((size_t)s[0] * 4));
-    if (s0) {
-      wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);
-    }
-    uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
-                                                          ((size_t)s[1] * 4));
-    if (s1) {
-      wuffs_base__store_u32le__no_bounds_check(d + (1 * 4), s1);
-    }
-    uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
-                                                          ((size_t)s[2] * 4));
-    if (s2) {
-      wuffs_base__store_u32le__no_bounds_check(d + (2 * 4), s2);
-    }
-    uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
-                                                          ((size_t)s[3] * 4));
-    if (s3) {
-      wuffs_base__store_u32le__no_bounds_check(d + (3 * 4), s3);
-    }
+  while (n >= 8) {
+    __m256i indexes =
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(const void*)s));
+    _mm256_storeu_si256((__m256i*)(void*)d,
+                        _mm256_i32gather_epi32(palette, indexes, 4));
 
-    s += loop_unroll_count * 1;
-    d += loop_unroll_count * 4;
-    n -= loop_unroll_count;
+    s += 8 * 1;
+    d += 8 * 4;
+    n -= 8;
   }
 
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
+    wuffs_base__store_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__load_u32le__no_bounds_check(
+                         dst_palette.ptr + ((size_t)s[0] * 4)));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  if (dst_palette.len != 1024) {
+    return 0;
+  }
+  size_t dst_len4 = dst.len / 4;
+  size_t len = dst_len4 < src.len ? dst_len4 : src.len;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  const size_t loop_unroll_count = 4;
+
+  while (n >= loop_unroll_count) {
+    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
+                                                          ((size_t)s[0] * 4));
+    if (s0) {
+      wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);
+    }
+    uint32_t s1 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
+                                                          ((size_t)s[1] * 4));
+    if (s1) {
+      wuffs_base__store_u32le__no_bounds_check(d + (1 * 4), s1);
+    }
+    uint32_t s2 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
+                                                          ((size_t)s[2] * 4));
+    if (s2) {
+      wuffs_base__store_u32le__no_bounds_check(d + (2 * 4), s2);
+    }
+    uint32_t s3 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
+                                                          ((size_t)s[3] * 4));
+    if (s3) {
+      wuffs_base__store_u32le__no_bounds_check(d + (3 * 4), s3);
+    }
+
+    s += loop_unroll_count * 1;
+    d += loop_unroll_count * 4;
+    n -= loop_unroll_count;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__load_u32le__no_bounds_check(dst_palette.ptr +
                                                           ((size_t)s[0] * 4));
     if (s0) {
       wuffs_base__store_u32le__no_bounds_check(d + (0 * 4), s0);
@@ -8970,6 +10455,51 @@ wuffs_base__pixel_swizzler__xxxx__xxx(wuffs_base__slice_u8 dst,
   return len;
 }
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__xxx__x86_sse42(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src) {
+  size_t dst_len4 = dst.len / 4;
+  size_t src_len3 = src.len / 3;
+  size_t len = dst_len4 < src_len3 ? dst_len4 : src_len3;
+  uint8_t* d = dst.ptr;
+  uint8_t* s = src.ptr;
+  size_t n = len;
+
+  const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8,
+                                        -128, 9, 10, 11, -128);
+  const __m128i alpha_bytes = _mm_set1_epi32((int32_t)0xFF000000);
+
+  // Each iteration loads 16 src bytes but only uses 12 of them (4 pixels). The
+  // loop condition is "n >= 6", not "n >= 4", so that the load stays within
+  // the src slice.
+  while (n >= 6) {
+    __m128i x = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)d,
+                     _mm_or_si128(_mm_shuffle_epi8(x, shuffle), alpha_bytes));
+
+    s += 4 * 3;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    wuffs_base__store_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s + (0 * 3)));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 static uint64_t  //
 wuffs_base__pixel_swizzler__xxxx__y(wuffs_base__slice_u8 dst,
                                     wuffs_base__slice_u8 dst_palette,
@@ -8996,52 +10526,261 @@ wuffs_base__pixel_swizzler__xxxx__y(wuffs_base__slice_u8 dst,
 
 // --------
 
-static uint64_t  //
-wuffs_base__pixel_swizzler__squash_bgr_565_888(wuffs_base__slice_u8 dst,
-                                               wuffs_base__slice_u8 src) {
-  size_t len4 = (dst.len < src.len ? dst.len : src.len) / 4;
-  uint8_t* d = dst.ptr;
-  uint8_t* s = src.ptr;
+// wuffs_base__pixel_swizzler__convert_palette converts the 256 entries of
+// src_palette, in one of the INDEXED__BGRA_* formats, to dst_palette entries
+// suitable for dst_repr. Each 4-byte dst entry holds a 4-byte color in the
+// dst's BGR or RGB order, keeping the alpha byte even for 3-byte or X-padded
+// dst formats, or for BGR_565, a 2-byte color followed by 2 zero bytes.
+//
+// It returns false if dst_repr is not an indexed, BGR_565, BGR[A|X]_* or
+// RGB[A|X]_* format.
+static bool  //
+wuffs_base__pixel_swizzler__convert_palette(wuffs_base__slice_u8 dst_palette,
+                                            uint32_t dst_repr,
+                                            wuffs_base__slice_u8 src_palette,
+                                            uint32_t src_repr) {
+  if ((dst_palette.len != 1024) || (src_palette.len != 1024)) {
+    return false;
+  }
+  bool swap = false;
+  switch (dst_repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      swap = true;
+      break;
+    default:
+      return false;
+  }
 
-  size_t n = len4;
-  while (n--) {
-    uint32_t argb = wuffs_base__load_u32le__no_bounds_check(s);
-    uint32_t b5 = 0x1F & (argb >> (8 - 5));
-    uint32_t g6 = 0x3F & (argb >> (16 - 6));
-    uint32_t r5 = 0x1F & (argb >> (24 - 5));
-    wuffs_base__store_u32le__no_bounds_check(
-        d, (b5 << 0) | (g6 << 5) | (r5 << 11));
-    s += 4;
-    d += 4;
+  uint32_t dst_transparency = 0x07 & (dst_repr >> 24);
+  uint32_t src_transparency = 0x07 & (src_repr >> 24);
+  size_t i;
+  for (i = 0; i < 1024; i += 4) {
+    uint32_t c = wuffs_base__load_u32le__no_bounds_check(src_palette.ptr + i);
+    c = wuffs_base__pixel_swizzler__convert_transparency(c, dst_transparency,
+                                                         src_transparency);
+    if (dst_repr == WUFFS_BASE__PIXEL_FORMAT__BGR_565) {
+      c = wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(c);
+    } else if (swap) {
+      c = wuffs_base__swap_u32_argb_abgr(c);
+    }
+    wuffs_base__store_u32le__no_bounds_check(dst_palette.ptr + i, c);
+  }
+  return true;
+}
+
+// --------
+
+// The generic swizzler converts one pixel at a time, via a 0xAARRGGBB
+// intermediate value. It is slower than the specialized swizzlers above, but
+// it converts between any two of the Y, INDEXED__BGRA_*, BGR_565, BGR[A|X]_*
+// and RGB[A|X]_* pixel formats (except that the dst cannot be indexed), and
+// wuffs_base__pixel_swizzler__prepare falls back to it when there is no
+// specialized swizzler.
+//
+// As both a src and a dst, binary alpha is treated as premultiplied alpha.
+// With the SRC blend, converting to a dst without alpha (such as BGR or BGRX)
+// drops the alpha but otherwise keeps the color as is, like the copy_4_4
+// swizzler does for BGRA_NONPREMUL to BGRX.
+
+static bool  //
+wuffs_base__pixel_swizzler__generic__accepts(uint32_t repr) {
+  switch (repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      return true;
+  }
+  return false;
+}
+
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__generic__load(uint32_t repr,
+                                          uint8_t* s,
+                                          uint8_t* palette) {
+  switch (repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      return 0xFF000000 | (0x00010101 * ((uint32_t)(s[0])));
+
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+      return wuffs_base__load_u32le__no_bounds_check(palette +
+                                                     (4 * ((size_t)s[0])));
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      return wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
+          wuffs_base__load_u16le__no_bounds_check(s));
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      return 0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s);
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+      return 0xFF000000 | wuffs_base__load_u32le__no_bounds_check(s);
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      return wuffs_base__load_u32le__no_bounds_check(s);
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      return wuffs_base__swap_u32_argb_abgr(
+          0xFF000000 | wuffs_base__load_u24le__no_bounds_check(s));
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+      return wuffs_base__swap_u32_argb_abgr(
+          0xFF000000 | wuffs_base__load_u32le__no_bounds_check(s));
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      return wuffs_base__swap_u32_argb_abgr(
+          wuffs_base__load_u32le__no_bounds_check(s));
+  }
+  return 0;
+}
+
+static inline void  //
+wuffs_base__pixel_swizzler__generic__store(uint32_t repr,
+                                           uint8_t* d,
+                                           uint32_t c) {
+  switch (repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      d[0] = wuffs_base__color_u32_argb_premul__as__color_u8_gray(c);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      wuffs_base__store_u16le__no_bounds_check(
+          d, wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(c));
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      wuffs_base__store_u24le__no_bounds_check(d, c);
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      wuffs_base__store_u32le__no_bounds_check(d, c);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      wuffs_base__store_u24le__no_bounds_check(
+          d, wuffs_base__swap_u32_argb_abgr(c));
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      wuffs_base__store_u32le__no_bounds_check(
+          d, wuffs_base__swap_u32_argb_abgr(c));
+      break;
   }
-  return len4 * 4;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__swap_rgbx_bgrx(wuffs_base__slice_u8 dst,
-                                           wuffs_base__slice_u8 src) {
-  size_t len4 = (dst.len < src.len ? dst.len : src.len) / 4;
+wuffs_base__pixel_swizzler__generic(const wuffs_base__pixel_swizzler* p,
+                                    wuffs_base__slice_u8 dst,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__slice_u8 src) {
+  wuffs_base__pixel_format dst_format =
+      wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);
+  wuffs_base__pixel_format src_format =
+      wuffs_base__make_pixel_format(p->private_impl.src_pixfmt_repr);
+  if (wuffs_base__pixel_format__is_indexed(&src_format) &&
+      (dst_palette.len != 1024)) {
+    return 0;
+  }
+  size_t dst_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&dst_format) / 8;
+  size_t src_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&src_format) / 8;
+  size_t dst_len = dst.len / dst_bytes_per_pixel;
+  size_t src_len = src.len / src_bytes_per_pixel;
+  size_t len = dst_len < src_len ? dst_len : src_len;
   uint8_t* d = dst.ptr;
   uint8_t* s = src.ptr;
+  size_t n = len;
 
-  size_t n = len4;
-  while (n--) {
-    uint8_t b0 = s[0];
-    uint8_t b1 = s[1];
-    uint8_t b2 = s[2];
-    uint8_t b3 = s[3];
-    d[0] = b2;
-    d[1] = b1;
-    d[2] = b0;
-    d[3] = b3;
-    s += 4;
-    d += 4;
+  uint32_t dst_transparency = 0x07 & (dst_format.repr >> 24);
+  uint32_t src_transparency = 0x07 & (src_format.repr >> 24);
+  bool src_over =
+      (p->private_impl.blend == WUFFS_BASE__PIXEL_BLEND__SRC_OVER) &&
+      (src_transparency >= 5);
+
+  while (n >= 1) {
+    uint32_t c = wuffs_base__pixel_swizzler__generic__load(src_format.repr, s,
+                                                           dst_palette.ptr);
+    uint32_t sa = c >> 24;
+    if (!src_over || (sa == 0xFF)) {
+      c = wuffs_base__pixel_swizzler__convert_transparency(c, dst_transparency,
+                                                           src_transparency);
+      wuffs_base__pixel_swizzler__generic__store(dst_format.repr, d, c);
+    } else if (sa != 0x00) {
+      // Composite src over dst in premultiplied alpha. A fully transparent src
+      // pixel leaves the dst as is, without a lossy premul round trip.
+      uint32_t d0 =
+          wuffs_base__pixel_swizzler__generic__load(dst_format.repr, d, NULL);
+      if (dst_transparency == 5) {
+        d0 = wuffs_base__premul_u32_axxx(d0);
+      }
+      if (src_transparency == 5) {
+        c = wuffs_base__composite_premul_nonpremul_u32_axxx(d0, c);
+      } else {
+        c = wuffs_base__composite_premul_premul_u32_axxx(d0, c);
+      }
+      if (dst_transparency == 5) {
+        c = wuffs_base__nonpremul_u32_axxx(c);
+      }
+      wuffs_base__pixel_swizzler__generic__store(dst_format.repr, d, c);
+    }
+
+    s += 1 * src_bytes_per_pixel;
+    d += 1 * dst_bytes_per_pixel;
+    n -= 1;
   }
-  return len4 * 4;
+
+  return len;
 }
 
 // --------
 
+// wuffs_base__pixel_swizzler__mirror_bgr_rgb returns the pixel format with
+// the BGR and RGB channel orders swapped (e.g. RGBX for BGRX). The specialized
+// swizzlers do not depend on the channel order, only on whether the src and
+// dst orders match, so an RGB-order src can re-use the prepare__bgr* function
+// for the corresponding BGR-order src, if passed a mirrored dst format. A
+// mirrored INDEXED__BGRA_* or BGR_565 format is not a valid format.
+static inline wuffs_base__pixel_format  //
+wuffs_base__pixel_swizzler__mirror_bgr_rgb(wuffs_base__pixel_format f) {
+  switch (f.repr >> 28) {
+    case 0x4:
+      return wuffs_base__make_pixel_format(f.repr + 0x10000000);
+    case 0x5:
+      return wuffs_base__make_pixel_format(f.repr - 0x10000000);
+  }
+  return f;
+}
+
 static wuffs_base__pixel_swizzler__func  //
 wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
                                        wuffs_base__pixel_format dst_format,
@@ -9049,14 +10788,12 @@ wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
                                        wuffs_base__slice_u8 src_palette,
                                        wuffs_base__pixel_blend blend) {
   switch (dst_format.repr) {
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      // TODO.
-      break;
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      return wuffs_base__pixel_swizzler__copy_1_1;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      // TODO.
-      break;
+      return wuffs_base__pixel_swizzler__xxx__y;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
@@ -9072,20 +10809,24 @@ wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
 }
 
 static wuffs_base__pixel_swizzler__func  //
-wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
+wuffs_base__pixel_swizzler__prepare__indexed(
     wuffs_base__pixel_swizzler* p,
     wuffs_base__pixel_format dst_format,
     wuffs_base__slice_u8 dst_palette,
+    wuffs_base__pixel_format src_format,
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
+  if (!wuffs_base__pixel_swizzler__convert_palette(
+          dst_palette, dst_format.repr, src_palette, src_format.repr)) {
+    return NULL;
+  }
+  bool binary =
+      src_format.repr == WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY;
+
   switch (dst_format.repr) {
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
-      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
-          1024) {
-        return NULL;
-      }
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__copy_1_1;
@@ -9093,10 +10834,6 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
       return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      if (wuffs_base__pixel_swizzler__squash_bgr_565_888(dst_palette,
-                                                         src_palette) != 1024) {
-        return NULL;
-      }
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__xx__index__src;
@@ -9104,58 +10841,39 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
       return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
-      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
-          1024) {
-        return NULL;
-      }
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__xxx__index__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
+          if (binary) {
+            return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
+          }
+          break;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
-      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
-          1024) {
-        return NULL;
-      }
-      switch (blend) {
-        case WUFFS_BASE__PIXEL_BLEND__SRC:
-          return wuffs_base__pixel_swizzler__xxxx__index__src;
-        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
-      }
-      return NULL;
-
-    case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(dst_palette,
-                                                     src_palette) != 1024) {
-        return NULL;
-      }
-      switch (blend) {
-        case WUFFS_BASE__PIXEL_BLEND__SRC:
-          return wuffs_base__pixel_swizzler__xxx__index__src;
-        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxx__index_binary_alpha__src_over;
-      }
-      return NULL;
-
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
-      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(dst_palette,
-                                                     src_palette) != 1024) {
-        return NULL;
-      }
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__xxxx__index__src__x86_avx2;
+          }
+#endif
           return wuffs_base__pixel_swizzler__xxxx__index__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
-          return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
+          if (binary) {
+            return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
+          }
+          break;
       }
       return NULL;
   }
@@ -9163,33 +10881,63 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
 }
 
 static wuffs_base__pixel_swizzler__func  //
-wuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,
+wuffs_base__pixel_swizzler__prepare__bgr_565(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_format,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend) {
+  switch (dst_format.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      return wuffs_base__pixel_swizzler__copy_2_2;
+  }
+  return NULL;
+}
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,
                                          wuffs_base__pixel_format dst_format,
                                          wuffs_base__slice_u8 dst_palette,
                                          wuffs_base__slice_u8 src_palette,
                                          wuffs_base__pixel_blend blend) {
   switch (dst_format.repr) {
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      // TODO.
-      break;
-
     case WUFFS_BASE__PIXEL_FORMAT__BGR:
-    case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      // TODO.
-      break;
+      return wuffs_base__pixel_swizzler__copy_3_3;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__xxxx__xxx__x86_sse42;
+      }
+#endif
       return wuffs_base__pixel_swizzler__xxxx__xxx;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      return wuffs_base__pixel_swizzler__swap_rgb_bgr;
+  }
+  return NULL;
+}
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__bgrx(wuffs_base__pixel_swizzler* p,
+                                          wuffs_base__pixel_format dst_format,
+                                          wuffs_base__slice_u8 dst_palette,
+                                          wuffs_base__slice_u8 src_palette,
+                                          wuffs_base__pixel_blend blend) {
+  switch (dst_format.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+      return wuffs_base__pixel_swizzler__copy_4_4;
+
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
-      // TODO.
-      break;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_sse42()) {
+        return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
+      }
+#endif
+      return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
   }
   return NULL;
 }
@@ -9202,15 +10950,6 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
     wuffs_base__slice_u8 src_palette,
     wuffs_base__pixel_blend blend) {
   switch (dst_format.repr) {
-    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
-      // TODO.
-      break;
-
-    case WUFFS_BASE__PIXEL_FORMAT__BGR:
-    case WUFFS_BASE__PIXEL_FORMAT__RGB:
-      // TODO.
-      break;
-
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
@@ -9220,28 +10959,110 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
       return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_sse42;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+      }
+      return NULL;
+  }
+  return NULL;
+}
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__bgra_premul(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_format,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend) {
+  switch (dst_format.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
-      // TODO.
-      break;
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__copy_4_4;
+      }
+      return NULL;
 
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
-    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
-      // TODO.
-      break;
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_sse42()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
+      }
+      return NULL;
   }
   return NULL;
 }
 
+static bool  //
+wuffs_base__pixel_swizzler__prepare__generic(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_format,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__pixel_format src_format,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend) {
+  if (!wuffs_base__pixel_swizzler__generic__accepts(dst_format.repr) ||
+      !wuffs_base__pixel_swizzler__generic__accepts(src_format.repr) ||
+      wuffs_base__pixel_format__is_indexed(&dst_format)) {
+    return false;
+  }
+  switch (blend) {
+    case WUFFS_BASE__PIXEL_BLEND__SRC:
+    case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+      break;
+    default:
+      return false;
+  }
+
+  // The generic swizzler looks up an indexed src's colors in the dst_palette,
+  // holding an unconverted copy of the src_palette.
+  if (wuffs_base__pixel_format__is_indexed(&src_format) &&
+      (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
+       1024)) {
+    return false;
+  }
+
+  p->private_impl.dst_pixfmt_repr = dst_format.repr;
+  p->private_impl.src_pixfmt_repr = src_format.repr;
+  p->private_impl.blend = blend;
+  return true;
+}
+
 // --------
 
 wuffs_base__status  //
@@ -9254,8 +11075,12 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
   if (!p) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
+  p->private_impl.func = NULL;
+  p->private_impl.dst_pixfmt_repr = 0;
+  p->private_impl.src_pixfmt_repr = 0;
+  p->private_impl.blend = 0;
 
-  // TODO: support many more formats.
+  // TODO: support planar formats.
 
   wuffs_base__pixel_swizzler__func func = NULL;
 
@@ -9265,8 +11090,15 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
                                                     src_palette, blend);
       break;
 
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
-      func = wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
+      func = wuffs_base__pixel_swizzler__prepare__indexed(
+          p, dst_format, dst_palette, src_format, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGR_565:
+      func = wuffs_base__pixel_swizzler__prepare__bgr_565(
           p, dst_format, dst_palette, src_palette, blend);
       break;
 
@@ -9275,15 +11107,59 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
           p, dst_format, dst_palette, src_palette, blend);
       break;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+      func = wuffs_base__pixel_swizzler__prepare__bgrx(
+          p, dst_format, dst_palette, src_palette, blend);
+      break;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
           p, dst_format, dst_palette, src_palette, blend);
       break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+      func = wuffs_base__pixel_swizzler__prepare__bgra_premul(
+          p, dst_format, dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      func = wuffs_base__pixel_swizzler__prepare__bgr(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+      func = wuffs_base__pixel_swizzler__prepare__bgrx(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+      func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
+      func = wuffs_base__pixel_swizzler__prepare__bgra_premul(
+          p, wuffs_base__pixel_swizzler__mirror_bgr_rgb(dst_format),
+          dst_palette, src_palette, blend);
+      break;
   }
 
-  p->private_impl.func = func;
-  return wuffs_base__make_status(
-      func ? NULL : wuffs_base__error__unsupported_pixel_swizzler_option);
+  if (func) {
+    p->private_impl.func = func;
+    p->private_impl.dst_pixfmt_repr = dst_format.repr;
+    p->private_impl.src_pixfmt_repr = src_format.repr;
+    p->private_impl.blend = blend;
+  } else if (!wuffs_base__pixel_swizzler__prepare__generic(
+                 p, dst_format, dst_palette, src_format, src_palette, blend)) {
+    return wuffs_base__make_status(
+        wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  return wuffs_base__make_status(NULL);
 }
 
 uint64_t  //
@@ -9292,12 +11168,84 @@ wuffs_base__pixel_swizzler__swizzle_interleaved(
     wuffs_base__slice_u8 dst,
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src) {
-  if (p && p->private_impl.func) {
-    return (*p->private_impl.func)(dst, dst_palette, src);
+  if (p) {
+    if (p->private_impl.func) {
+      return (*p->private_impl.func)(dst, dst_palette, src);
+    } else if (p->private_impl.src_pixfmt_repr) {
+      return wuffs_base__pixel_swizzler__generic(p, dst, dst_palette, src);
+    }
   }
   return 0;
 }
 
+uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__slice_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__slice_u8 src,
+    uint32_t x_step) {
+  if (x_step <= 1) {
+    return wuffs_base__pixel_swizzler__swizzle_interleaved(p, dst, dst_palette,
+                                                           src);
+  } else if (!p || !p->private_impl.src_pixfmt_repr) {
+    return 0;
+  }
+  wuffs_base__pixel_format dst_format =
+      wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);
+  wuffs_base__pixel_format src_format =
+      wuffs_base__make_pixel_format(p->private_impl.src_pixfmt_repr);
+  size_t dst_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&dst_format) / 8;
+  size_t src_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&src_format) / 8;
+  if ((dst_bytes_per_pixel == 0) || (src_bytes_per_pixel == 0) ||
+      (src_bytes_per_pixel > 8)) {
+    return 0;
+  }
+  size_t src_stride = src_bytes_per_pixel * x_step;
+  size_t src_len = src.len / src_bytes_per_pixel;
+  uint8_t* s = src.ptr;
+
+  // Gather the kept source pixels into a contiguous buffer, a batch at a
+  // time, and swizzle each batch with the regular (non-subsampled) func.
+  uint8_t batch[1024];
+  const size_t batch_cap = sizeof(batch) / src_bytes_per_pixel;
+
+  uint64_t num_src_consumed = 0;
+  while (num_src_consumed < src_len) {
+    size_t n = ((src_len - num_src_consumed) + (x_step - 1)) / x_step;
+    if (n > batch_cap) {
+      n = batch_cap;
+    }
+    size_t i;
+    for (i = 0; i < n; i++) {
+      memcpy(batch + (i * src_bytes_per_pixel), s + (i * src_stride),
+             src_bytes_per_pixel);
+    }
+
+    uint64_t num_dst_written = wuffs_base__pixel_swizzler__swizzle_interleaved(
+        p, dst, dst_palette,
+        wuffs_base__make_slice_u8(batch, n * src_bytes_per_pixel));
+    if (num_dst_written == 0) {
+      break;
+    }
+    uint64_t m = num_dst_written * x_step;
+    if (m > (src_len - num_src_consumed)) {
+      m = src_len - num_src_consumed;
+    }
+    num_src_consumed += m;
+    if (num_dst_written < n) {
+      break;
+    }
+
+    dst.ptr += n * dst_bytes_per_pixel;
+    dst.len -= n * dst_bytes_per_pixel;
+    s += n * src_stride;
+  }
+  return num_src_consumed;
+}
+
 // ---------------- String Conversions
 
 // wuffs_base__parse_number__foo_digits entries are 0x00 for invalid digits,
@@ -9583,6 +11531,96 @@ fail_out_of_bounds:
   } while (0);
 }
 
+// --------
+
+// wuffs_base__render_number__two_digits holds the ASCII encodings of "00",
+// "01", "02", ..., "99". Looking up two digits at a time halves the number of
+// (relatively slow) 64-bit divisions compared to one digit at a time.
+static const uint8_t wuffs_base__render_number__two_digits[200] = {
+    '0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0',
+    '7', '0', '8', '0', '9', '1', '0', '1', '1', '1', '2', '1', '3', '1', '4',
+    '1', '5', '1', '6', '1', '7', '1', '8', '1', '9', '2', '0', '2', '1', '2',
+    '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+    '3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3',
+    '7', '3', '8', '3', '9', '4', '0', '4', '1', '4', '2', '4', '3', '4', '4',
+    '4', '5', '4', '6', '4', '7', '4', '8', '4', '9', '5', '0', '5', '1', '5',
+    '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+    '6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6',
+    '7', '6', '8', '6', '9', '7', '0', '7', '1', '7', '2', '7', '3', '7', '4',
+    '7', '5', '7', '6', '7', '7', '7', '8', '7', '9', '8', '0', '8', '1', '8',
+    '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+    '9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9',
+    '7', '9', '8', '9', '9',
+};
+
+static size_t  //
+wuffs_base__private_implementation__render_number_u64(wuffs_base__slice_u8 dst,
+                                                      uint64_t x,
+                                                      uint32_t options,
+                                                      bool neg) {
+  uint8_t buf[WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];
+  uint8_t* ptr = &buf[0] + sizeof(buf);
+
+  // Write the digits right to left, two at a time.
+  while (x >= 100) {
+    size_t index = ((size_t)(x % 100)) * 2;
+    x /= 100;
+    ptr -= 2;
+    ptr[0] = wuffs_base__render_number__two_digits[index + 0];
+    ptr[1] = wuffs_base__render_number__two_digits[index + 1];
+  }
+  if (x >= 10) {
+    size_t index = ((size_t)x) * 2;
+    ptr -= 2;
+    ptr[0] = wuffs_base__render_number__two_digits[index + 0];
+    ptr[1] = wuffs_base__render_number__two_digits[index + 1];
+  } else {
+    ptr -= 1;
+    ptr[0] = (uint8_t)('0' + x);
+  }
+
+  if (neg) {
+    ptr -= 1;
+    ptr[0] = '-';
+  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+    ptr -= 1;
+    ptr[0] = '+';
+  }
+
+  size_t n = (size_t)((&buf[0] + sizeof(buf)) - ptr);
+  if (n > dst.len) {
+    return 0;
+  }
+  memcpy(dst.ptr + ((options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                        ? (dst.len - n)
+                        : 0),
+         ptr, n);
+  return n;
+}
+
+size_t  //
+wuffs_base__render_number_i64(wuffs_base__slice_u8 dst,
+                              int64_t x,
+                              uint32_t options) {
+  uint64_t u = (uint64_t)x;
+  bool neg = x < 0;
+  if (neg) {
+    // Negate in uint64_t arithmetic, so that INT64_MIN is not undefined
+    // behavior.
+    u = 1 + ~u;
+  }
+  return wuffs_base__private_implementation__render_number_u64(dst, u, options,
+                                                               neg);
+}
+
+size_t  //
+wuffs_base__render_number_u64(wuffs_base__slice_u8 dst,
+                              uint64_t x,
+                              uint32_t options) {
+  return wuffs_base__private_implementation__render_number_u64(dst, x, options,
+                                                               false);
+}
+
   // ---------------- IEEE 754 Floating Point
 
 #define WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__DECIMAL_POINT__RANGE 1023
@@ -10146,6 +12184,238 @@ wuffs_base__private_implementation__high_prec_dec__small_rshift(
   wuffs_base__private_implementation__high_prec_dec__trim(h);
 }
 
+// wuffs_base__private_implementation__high_prec_dec__shift multiplies h by
+// (2 ** shift), where shift may be negative and need not be "a small shift".
+//
+// The preconditions are the same as for the small_xshift functions, except
+// that shift may be zero or large. The caller is responsible for keeping
+// h->decimal_point "not extreme" throughout, which holds for any double.
+static void  //
+wuffs_base__private_implementation__high_prec_dec__shift(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t shift) {
+  while (shift > +WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL) {
+    wuffs_base__private_implementation__high_prec_dec__small_lshift(
+        h, WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL);
+    shift -= WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;
+  }
+  while (shift < -WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL) {
+    wuffs_base__private_implementation__high_prec_dec__small_rshift(
+        h, WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL);
+    shift += WUFFS_BASE__PRIVATE_IMPLEMENTATION__HPD__SHIFT__MAX_INCL;
+  }
+  if (shift > 0) {
+    wuffs_base__private_implementation__high_prec_dec__small_lshift(
+        h, (uint32_t)(+shift));
+  } else if (shift < 0) {
+    wuffs_base__private_implementation__high_prec_dec__small_rshift(
+        h, (uint32_t)(-shift));
+  }
+}
+
+// wuffs_base__private_implementation__high_prec_dec__assign sets h to the
+// exact value of (x * (2 ** exp2)), negated if negative.
+static void  //
+wuffs_base__private_implementation__high_prec_dec__assign(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint64_t x,
+    int32_t exp2,
+    bool negative) {
+  uint8_t buf[20];
+  uint32_t n = 0;
+
+  // Set buf's digits, least significant first.
+  while (x > 0) {
+    uint64_t quo = x / 10;
+    buf[n++] = (uint8_t)(x - (10 * quo));
+    x = quo;
+  }
+
+  // Copy them to h, most significant first.
+  h->num_digits = n;
+  h->decimal_point = (int32_t)n;
+  h->negative = negative;
+  h->truncated = false;
+  uint32_t i = 0;
+  for (; i < n; i++) {
+    h->digits[i] = buf[n - 1 - i];
+  }
+  wuffs_base__private_implementation__high_prec_dec__trim(h);
+
+  wuffs_base__private_implementation__high_prec_dec__shift(h, exp2);
+}
+
+// --------
+
+// The wuffs_base__private_implementation__high_prec_dec__round_etc functions
+// round h's number to n digits, where n counts from the most significant digit
+// (h->digits[0]), not from the decimal point. They do nothing if n is
+// negative or if h already has n or fewer digits.
+//
+// round_down truncates, round_up rounds away from zero and round_nearest
+// rounds to nearest, ties to even (unless h->truncated, in which case an
+// apparent tie is really above halfway).
+
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_down(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t n) {
+  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {
+    return;
+  }
+  h->num_digits = (uint32_t)n;
+  wuffs_base__private_implementation__high_prec_dec__trim(h);
+}
+
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_up(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t n) {
+  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {
+    return;
+  }
+
+  for (n--; n >= 0; n--) {
+    if (h->digits[n] < 9) {
+      h->digits[n]++;
+      h->num_digits = (uint32_t)(n + 1);
+      return;
+    }
+  }
+
+  // The number is all 9s. Change to a single 1 and adjust the decimal point.
+  h->digits[0] = 1;
+  h->num_digits = 1;
+  h->decimal_point++;
+}
+
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_nearest(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t n) {
+  if ((n < 0) || (h->num_digits <= (uint32_t)n)) {
+    return;
+  }
+  bool up = h->digits[n] >= 5;
+  if ((h->digits[n] == 5) && ((uint32_t)(n + 1) == h->num_digits)) {
+    up = h->truncated ||  //
+         ((n > 0) && (1 & h->digits[n - 1]));
+  }
+
+  if (up) {
+    wuffs_base__private_implementation__high_prec_dec__round_up(h, n);
+  } else {
+    wuffs_base__private_implementation__high_prec_dec__round_down(h, n);
+  }
+}
+
+// wuffs_base__private_implementation__high_prec_dec__round_just_enough rounds
+// h, which must hold the exact value of (mantissa * (2 ** exp2)), to the
+// fewest digits that still parse back to the same double. mantissa includes
+// the implicit 1<<52 bit (for normal numbers) and exp2 is -1074 for subnormal
+// numbers, as well as the smallest normal exponent.
+//
+// This is the exact (but relatively slow) algorithm. It considers the
+// halfway points between h and its two neighboring doubles, as in
+// https://github.com/golang/go/blob/go1.15/src/strconv/ftoa.go roundShortest.
+static void  //
+wuffs_base__private_implementation__high_prec_dec__round_just_enough(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    int32_t exp2,
+    uint64_t mantissa) {
+  // The magic numbers 52 and -1074 are IEEE 754 double precision's mantissa
+  // bit count and minimum exponent.
+  if ((h->num_digits == 0) ||
+      // If the number's exponent is not the minimum, and its trailing zeroes
+      // (in decimal) outweigh its trailing (binary) fraction bits, then it is
+      // already as short as possible: every neighboring double differs by
+      // more than one unit in h's last place.
+      ((exp2 > -1074) &&
+       ((332 * (h->decimal_point - (int32_t)(h->num_digits))) >=
+        (100 * exp2)))) {
+    return;
+  }
+
+  // Compute upper, halfway between h's number and its successor.
+  wuffs_base__private_implementation__high_prec_dec upper;
+  wuffs_base__private_implementation__high_prec_dec__assign(
+      &upper, (mantissa << 1) + 1, exp2 - 1, false);
+
+  // Compute lower, halfway between h's number and its predecessor. A power of
+  // 2 (other than the minimum exponent's) is closer to its predecessor.
+  uint64_t l_mantissa = mantissa - 1;
+  int32_t l_exp2 = exp2;
+  if ((mantissa <= 0x10000000000000) && (exp2 > -1074)) {
+    l_mantissa = (mantissa << 1) - 1;
+    l_exp2 = exp2 - 1;
+  }
+  wuffs_base__private_implementation__high_prec_dec lower;
+  wuffs_base__private_implementation__high_prec_dec__assign(
+      &lower, (l_mantissa << 1) + 1, l_exp2 - 1, false);
+
+  // The upper and lower bounds are possible outputs only if the original
+  // mantissa is even, so that IEEE round-to-even would round to the original
+  // mantissa and not the neighbors.
+  bool inclusive = (mantissa & 1) == 0;
+
+  // As we walk the digits, upper_delta tracks whether rounding up would stay
+  // within the upper bound. 0 means that h and upper have had the same digits
+  // so far. 1 means that they differed by 1 on a previous digit and since
+  // then h has had only 9s and upper only 0s (so rounding up might land on
+  // the bound). 2 means that they differ by more than that.
+  uint8_t upper_delta = 0;
+
+  // Walk along until h has distinguished itself from both upper and lower.
+  // upper has the largest decimal_point, so iterate over its digits and start
+  // li and mi at (possibly) -1.
+  int32_t ui = 0;
+  for (;; ui++) {
+    int32_t mi = ui - upper.decimal_point + h->decimal_point;
+    if (mi >= ((int32_t)(h->num_digits))) {
+      break;
+    }
+    int32_t li = ui - upper.decimal_point + lower.decimal_point;
+    uint8_t l = ((li >= 0) && (li < ((int32_t)(lower.num_digits))))
+                    ? lower.digits[li]
+                    : 0;
+    uint8_t m = (mi >= 0) ? h->digits[mi] : 0;
+    uint8_t u = (ui < ((int32_t)(upper.num_digits))) ? upper.digits[ui] : 0;
+
+    // It's OK to round down (truncate) if lower has a different digit, or if
+    // lower is inclusive and is exactly the result of rounding down (i.e. we
+    // have reached lower's final digit).
+    bool ok_down = (l != m) ||  //
+                   (inclusive && ((li + 1) == ((int32_t)(lower.num_digits))));
+
+    if ((upper_delta == 0) && ((m + 1) < u)) {
+      upper_delta = 2;
+    } else if ((upper_delta == 0) && (m != u)) {
+      upper_delta = 1;
+    } else if ((upper_delta == 1) && ((m != 9) || (u != 0))) {
+      upper_delta = 2;
+    }
+
+    // It's OK to round up if upper has a different digit and either upper is
+    // inclusive or upper is bigger than the result of rounding up.
+    bool ok_up = (upper_delta > 0) &&   //
+                 (inclusive ||          //
+                  (upper_delta > 1) ||  //
+                  ((ui + 1) < ((int32_t)(upper.num_digits))));
+
+    if (ok_down && ok_up) {
+      wuffs_base__private_implementation__high_prec_dec__round_nearest(h,
+                                                                       mi + 1);
+      return;
+    } else if (ok_down) {
+      wuffs_base__private_implementation__high_prec_dec__round_down(h, mi + 1);
+      return;
+    } else if (ok_up) {
+      wuffs_base__private_implementation__high_prec_dec__round_up(h, mi + 1);
+      return;
+    }
+  }
+}
+
 // --------
 
 // The wuffs_base__private_implementation__etc_powers_of_10 tables were printed
@@ -10546,6 +12816,12 @@ wuffs_base__private_implementation__medium_prec_bin__parse_number_f64(
     if (subnormal_exp2 >= m->exp2) {
       surplus_bits += 1 + ((uint32_t)(subnormal_exp2 - m->exp2));
     }
+    // Far enough below the smallest subnormal, every mantissa bit is a
+    // surplus bit. Leave that (round to zero or to the smallest subnormal)
+    // to the HPD code, instead of shifting a uint64_t by 64 or more.
+    if (surplus_bits > 63) {
+      goto fail;
+    }
 
     uint64_t surplus_mask =
         (((uint64_t)1) << surplus_bits) - 1;  // e.g. 0x07FF.
@@ -10580,18 +12856,746 @@ fail:
 
 // --------
 
-wuffs_base__result_f64  //
-wuffs_base__parse_number_f64_special(wuffs_base__slice_u8 s,
-                                     const char* fallback_status_repr) {
-  do {
-    uint8_t* p = s.ptr;
-    uint8_t* q = s.ptr + s.len;
+// The wuffs_base__private_implementation__powers_of_10 table was printed by
+// script/print-eisel-lemire-powers-of-10.go. That script has an optional
+// -comments flag, whose output is not copied here, which prints further
+// detail.
+//
+// This table is used in
+// wuffs_base__private_implementation__parse_number_f64_eisel_lemire.
 
-    for (; (p < q) && (*p == '_'); p++) {
-    }
-    if (p >= q) {
-      goto fallback;
-    }
+// wuffs_base__private_implementation__powers_of_10 contains truncated
+// approximations to the powers of 10, ranging from 1e-307 to 1e+288 inclusive,
+// as 596 pairs of uint64_t values (a 128-bit mantissa).
+//
+// Each pair is the (lo, hi) halves of a normalized (the 1<<127 bit is set)
+// 128-bit mantissa. The implied base-2 exponent is not stored, since it can be
+// calculated from the base-10 exponent: see the "217706" comment below.
+//
+// For example, the pair for 1e-1, (0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC),
+// means:
+//   1e-1 ≈ 0xCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCCC * (2 ** -131)
+// Similarly, the pair for 1e+1, (0x0000000000000000, 0xA000000000000000),
+// means:
+//   1e+1 ≈ 0xA0000000000000000000000000000000 * (2 ** -124)  // Exact.
+static const uint64_t
+    wuffs_base__private_implementation__powers_of_10[596][2] = {
+        {0xA5D3B6D479F8E056, 0x8FD0C16206306BAB},
+        {0x8F48A4899877186C, 0xB3C4F1BA87BC8696},
+        {0x331ACDABFE94DE87, 0xE0B62E2929ABA83C},
+        {0x9FF0C08B7F1D0B14, 0x8C71DCD9BA0B4925},
+        {0x07ECF0AE5EE44DD9, 0xAF8E5410288E1B6F},
+        {0xC9E82CD9F69D6150, 0xDB71E91432B1A24A},
+        {0xBE311C083A225CD2, 0x892731AC9FAF056E},
+        {0x6DBD630A48AAF406, 0xAB70FE17C79AC6CA},
+        {0x092CBBCCDAD5B108, 0xD64D3D9DB981787D},
+        {0x25BBF56008C58EA5, 0x85F0468293F0EB4E},
+        {0xAF2AF2B80AF6F24E, 0xA76C582338ED2621},
+        {0x1AF5AF660DB4AEE1, 0xD1476E2C07286FAA},
+        {0x50D98D9FC890ED4D, 0x82CCA4DB847945CA},
+        {0xE50FF107BAB528A0, 0xA37FCE126597973C},
+        {0x1E53ED49A96272C8, 0xCC5FC196FEFD7D0C},
+        {0x25E8E89C13BB0F7A, 0xFF77B1FCBEBCDC4F},
+        {0x77B191618C54E9AC, 0x9FAACF3DF73609B1},
+        {0xD59DF5B9EF6A2417, 0xC795830D75038C1D},
+        {0x4B0573286B44AD1D, 0xF97AE3D0D2446F25},
+        {0x4EE367F9430AEC32, 0x9BECCE62836AC577},
+        {0x229C41F793CDA73F, 0xC2E801FB244576D5},
+        {0x6B43527578C1110F, 0xF3A20279ED56D48A},
+        {0x830A13896B78AAA9, 0x9845418C345644D6},
+        {0x23CC986BC656D553, 0xBE5691EF416BD60C},
+        {0x2CBFBE86B7EC8AA8, 0xEDEC366B11C6CB8F},
+        {0x7BF7D71432F3D6A9, 0x94B3A202EB1C3F39},
+        {0xDAF5CCD93FB0CC53, 0xB9E08A83A5E34F07},
+        {0xD1B3400F8F9CFF68, 0xE858AD248F5C22C9},
+        {0x23100809B9C21FA1, 0x91376C36D99995BE},
+        {0xABD40A0C2832A78A, 0xB58547448FFFFB2D},
+        {0x16C90C8F323F516C, 0xE2E69915B3FFF9F9},
+        {0xAE3DA7D97F6792E3, 0x8DD01FAD907FFC3B},
+        {0x99CD11CFDF41779C, 0xB1442798F49FFB4A},
+        {0x40405643D711D583, 0xDD95317F31C7FA1D},
+        {0x482835EA666B2572, 0x8A7D3EEF7F1CFC52},
+        {0xDA3243650005EECF, 0xAD1C8EAB5EE43B66},
+        {0x90BED43E40076A82, 0xD863B256369D4A40},
+        {0x5A7744A6E804A291, 0x873E4F75E2224E68},
+        {0x711515D0A205CB36, 0xA90DE3535AAAE202},
+        {0x0D5A5B44CA873E03, 0xD3515C2831559A83},
+        {0xE858790AFE9486C2, 0x8412D9991ED58091},
+        {0x626E974DBE39A872, 0xA5178FFF668AE0B6},
+        {0xFB0A3D212DC8128F, 0xCE5D73FF402D98E3},
+        {0x7CE66634BC9D0B99, 0x80FA687F881C7F8E},
+        {0x1C1FFFC1EBC44E80, 0xA139029F6A239F72},
+        {0xA327FFB266B56220, 0xC987434744AC874E},
+        {0x4BF1FF9F0062BAA8, 0xFBE9141915D7A922},
+        {0x6F773FC3603DB4A9, 0x9D71AC8FADA6C9B5},
+        {0xCB550FB4384D21D3, 0xC4CE17B399107C22},
+        {0x7E2A53A146606A48, 0xF6019DA07F549B2B},
+        {0x2EDA7444CBFC426D, 0x99C102844F94E0FB},
+        {0xFA911155FEFB5308, 0xC0314325637A1939},
+        {0x793555AB7EBA27CA, 0xF03D93EEBC589F88},
+        {0x4BC1558B2F3458DE, 0x96267C7535B763B5},
+        {0x9EB1AAEDFB016F16, 0xBBB01B9283253CA2},
+        {0x465E15A979C1CADC, 0xEA9C227723EE8BCB},
+        {0x0BFACD89EC191EC9, 0x92A1958A7675175F},
+        {0xCEF980EC671F667B, 0xB749FAED14125D36},
+        {0x82B7E12780E7401A, 0xE51C79A85916F484},
+        {0xD1B2ECB8B0908810, 0x8F31CC0937AE58D2},
+        {0x861FA7E6DCB4AA15, 0xB2FE3F0B8599EF07},
+        {0x67A791E093E1D49A, 0xDFBDCECE67006AC9},
+        {0xE0C8BB2C5C6D24E0, 0x8BD6A141006042BD},
+        {0x58FAE9F773886E18, 0xAECC49914078536D},
+        {0xAF39A475506A899E, 0xDA7F5BF590966848},
+        {0x6D8406C952429603, 0x888F99797A5E012D},
+        {0xC8E5087BA6D33B83, 0xAAB37FD7D8F58178},
+        {0xFB1E4A9A90880A64, 0xD5605FCDCF32E1D6},
+        {0x5CF2EEA09A55067F, 0x855C3BE0A17FCD26},
+        {0xF42FAA48C0EA481E, 0xA6B34AD8C9DFC06F},
+        {0xF13B94DAF124DA26, 0xD0601D8EFC57B08B},
+        {0x76C53D08D6B70858, 0x823C12795DB6CE57},
+        {0x54768C4B0C64CA6E, 0xA2CB1717B52481ED},
+        {0xA9942F5DCF7DFD09, 0xCB7DDCDDA26DA268},
+        {0xD3F93B35435D7C4C, 0xFE5D54150B090B02},
+        {0xC47BC5014A1A6DAF, 0x9EFA548D26E5A6E1},
+        {0x359AB6419CA1091B, 0xC6B8E9B0709F109A},
+        {0xC30163D203C94B62, 0xF867241C8CC6D4C0},
+        {0x79E0DE63425DCF1D, 0x9B407691D7FC44F8},
+        {0x985915FC12F542E4, 0xC21094364DFB5636},
+        {0x3E6F5B7B17B2939D, 0xF294B943E17A2BC4},
+        {0xA705992CEECF9C42, 0x979CF3CA6CEC5B5A},
+        {0x50C6FF782A838353, 0xBD8430BD08277231},
+        {0xA4F8BF5635246428, 0xECE53CEC4A314EBD},
+        {0x871B7795E136BE99, 0x940F4613AE5ED136},
+        {0x28E2557B59846E3F, 0xB913179899F68584},
+        {0x331AEADA2FE589CF, 0xE757DD7EC07426E5},
+        {0x3FF0D2C85DEF7621, 0x9096EA6F3848984F},
+        {0x0FED077A756B53A9, 0xB4BCA50B065ABE63},
+        {0xD3E8495912C62894, 0xE1EBCE4DC7F16DFB},
+        {0x64712DD7ABBBD95C, 0x8D3360F09CF6E4BD},
+        {0xBD8D794D96AACFB3, 0xB080392CC4349DEC},
+        {0xECF0D7A0FC5583A0, 0xDCA04777F541C567},
+        {0xF41686C49DB57244, 0x89E42CAAF9491B60},
+        {0x311C2875C522CED5, 0xAC5D37D5B79B6239},
+        {0x7D633293366B828B, 0xD77485CB25823AC7},
+        {0xAE5DFF9C02033197, 0x86A8D39EF77164BC},
+        {0xD9F57F830283FDFC, 0xA8530886B54DBDEB},
+        {0xD072DF63C324FD7B, 0xD267CAA862A12D66},
+        {0x4247CB9E59F71E6D, 0x8380DEA93DA4BC60},
+        {0x52D9BE85F074E608, 0xA46116538D0DEB78},
+        {0x67902E276C921F8B, 0xCD795BE870516656},
+        {0x00BA1CD8A3DB53B6, 0x806BD9714632DFF6},
+        {0x80E8A40ECCD228A4, 0xA086CFCD97BF97F3},
+        {0x6122CD128006B2CD, 0xC8A883C0FDAF7DF0},
+        {0x796B805720085F81, 0xFAD2A4B13D1B5D6C},
+        {0xCBE3303674053BB0, 0x9CC3A6EEC6311A63},
+        {0xBEDBFC4411068A9C, 0xC3F490AA77BD60FC},
+        {0xEE92FB5515482D44, 0xF4F1B4D515ACB93B},
+        {0x751BDD152D4D1C4A, 0x991711052D8BF3C5},
+        {0xD262D45A78A0635D, 0xBF5CD54678EEF0B6},
+        {0x86FB897116C87C34, 0xEF340A98172AACE4},
+        {0xD45D35E6AE3D4DA0, 0x9580869F0E7AAC0E},
+        {0x8974836059CCA109, 0xBAE0A846D2195712},
+        {0x2BD1A438703FC94B, 0xE998D258869FACD7},
+        {0x7B6306A34627DDCF, 0x91FF83775423CC06},
+        {0x1A3BC84C17B1D542, 0xB67F6455292CBF08},
+        {0x20CABA5F1D9E4A93, 0xE41F3D6A7377EECA},
+        {0x547EB47B7282EE9C, 0x8E938662882AF53E},
+        {0xE99E619A4F23AA43, 0xB23867FB2A35B28D},
+        {0x6405FA00E2EC94D4, 0xDEC681F9F4C31F31},
+        {0xDE83BC408DD3DD04, 0x8B3C113C38F9F37E},
+        {0x9624AB50B148D445, 0xAE0B158B4738705E},
+        {0x3BADD624DD9B0957, 0xD98DDAEE19068C76},
+        {0xE54CA5D70A80E5D6, 0x87F8A8D4CFA417C9},
+        {0x5E9FCF4CCD211F4C, 0xA9F6D30A038D1DBC},
+        {0x7647C3200069671F, 0xD47487CC8470652B},
+        {0x29ECD9F40041E073, 0x84C8D4DFD2C63F3B},
+        {0xF468107100525890, 0xA5FB0A17C777CF09},
+        {0x7182148D4066EEB4, 0xCF79CC9DB955C2CC},
+        {0xC6F14CD848405530, 0x81AC1FE293D599BF},
+        {0xB8ADA00E5A506A7C, 0xA21727DB38CB002F},
+        {0xA6D90811F0E4851C, 0xCA9CF1D206FDC03B},
+        {0x908F4A166D1DA663, 0xFD442E4688BD304A},
+        {0x9A598E4E043287FE, 0x9E4A9CEC15763E2E},
+        {0x40EFF1E1853F29FD, 0xC5DD44271AD3CDBA},
+        {0xD12BEE59E68EF47C, 0xF7549530E188C128},
+        {0x82BB74F8301958CE, 0x9A94DD3E8CF578B9},
+        {0xE36A52363C1FAF01, 0xC13A148E3032D6E7},
+        {0xDC44E6C3CB279AC1, 0xF18899B1BC3F8CA1},
+        {0x29AB103A5EF8C0B9, 0x96F5600F15A7B7E5},
+        {0x7415D448F6B6F0E7, 0xBCB2B812DB11A5DE},
+        {0x111B495B3464AD21, 0xEBDF661791D60F56},
+        {0xCAB10DD900BEEC34, 0x936B9FCEBB25C995},
+        {0x3D5D514F40EEA742, 0xB84687C269EF3BFB},
+        {0x0CB4A5A3112A5112, 0xE65829B3046B0AFA},
+        {0x47F0E785EABA72AB, 0x8FF71A0FE2C2E6DC},
+        {0x59ED216765690F56, 0xB3F4E093DB73A093},
+        {0x306869C13EC3532C, 0xE0F218B8D25088B8},
+        {0x1E414218C73A13FB, 0x8C974F7383725573},
+        {0xE5D1929EF90898FA, 0xAFBD2350644EEACF},
+        {0xDF45F746B74ABF39, 0xDBAC6C247D62A583},
+        {0x6B8BBA8C328EB783, 0x894BC396CE5DA772},
+        {0x066EA92F3F326564, 0xAB9EB47C81F5114F},
+        {0xC80A537B0EFEFEBD, 0xD686619BA27255A2},
+        {0xBD06742CE95F5F36, 0x8613FD0145877585},
+        {0x2C48113823B73704, 0xA798FC4196E952E7},
+        {0xF75A15862CA504C5, 0xD17F3B51FCA3A7A0},
+        {0x9A984D73DBE722FB, 0x82EF85133DE648C4},
+        {0xC13E60D0D2E0EBBA, 0xA3AB66580D5FDAF5},
+        {0x318DF905079926A8, 0xCC963FEE10B7D1B3},
+        {0xFDF17746497F7052, 0xFFBBCFE994E5C61F},
+        {0xFEB6EA8BEDEFA633, 0x9FD561F1FD0F9BD3},
+        {0xFE64A52EE96B8FC0, 0xC7CABA6E7C5382C8},
+        {0x3DFDCE7AA3C673B0, 0xF9BD690A1B68637B},
+        {0x06BEA10CA65C084E, 0x9C1661A651213E2D},
+        {0x486E494FCFF30A62, 0xC31BFA0FE5698DB8},
+        {0x5A89DBA3C3EFCCFA, 0xF3E2F893DEC3F126},
+        {0xF89629465A75E01C, 0x986DDB5C6B3A76B7},
+        {0xF6BBB397F1135823, 0xBE89523386091465},
+        {0x746AA07DED582E2C, 0xEE2BA6C0678B597F},
+        {0xA8C2A44EB4571CDC, 0x94DB483840B717EF},
+        {0x92F34D62616CE413, 0xBA121A4650E4DDEB},
+        {0x77B020BAF9C81D17, 0xE896A0D7E51E1566},
+        {0x0ACE1474DC1D122E, 0x915E2486EF32CD60},
+        {0x0D819992132456BA, 0xB5B5ADA8AAFF80B8},
+        {0x10E1FFF697ED6C69, 0xE3231912D5BF60E6},
+        {0xCA8D3FFA1EF463C1, 0x8DF5EFABC5979C8F},
+        {0xBD308FF8A6B17CB2, 0xB1736B96B6FD83B3},
+        {0xAC7CB3F6D05DDBDE, 0xDDD0467C64BCE4A0},
+        {0x6BCDF07A423AA96B, 0x8AA22C0DBEF60EE4},
+        {0x86C16C98D2C953C6, 0xAD4AB7112EB3929D},
+        {0xE871C7BF077BA8B7, 0xD89D64D57A607744},
+        {0x11471CD764AD4972, 0x87625F056C7C4A8B},
+        {0xD598E40D3DD89BCF, 0xA93AF6C6C79B5D2D},
+        {0x4AFF1D108D4EC2C3, 0xD389B47879823479},
+        {0xCEDF722A585139BA, 0x843610CB4BF160CB},
+        {0xC2974EB4EE658828, 0xA54394FE1EEDB8FE},
+        {0x733D226229FEEA32, 0xCE947A3DA6A9273E},
+        {0x0806357D5A3F525F, 0x811CCC668829B887},
+        {0xCA07C2DCB0CF26F7, 0xA163FF802A3426A8},
+        {0xFC89B393DD02F0B5, 0xC9BCFF6034C13052},
+        {0xBBAC2078D443ACE2, 0xFC2C3F3841F17C67},
+        {0xD54B944B84AA4C0D, 0x9D9BA7832936EDC0},
+        {0x0A9E795E65D4DF11, 0xC5029163F384A931},
+        {0x4D4617B5FF4A16D5, 0xF64335BCF065D37D},
+        {0x504BCED1BF8E4E45, 0x99EA0196163FA42E},
+        {0xE45EC2862F71E1D6, 0xC06481FB9BCF8D39},
+        {0x5D767327BB4E5A4C, 0xF07DA27A82C37088},
+        {0x3A6A07F8D510F86F, 0x964E858C91BA2655},
+        {0x890489F70A55368B, 0xBBE226EFB628AFEA},
+        {0x2B45AC74CCEA842E, 0xEADAB0ABA3B2DBE5},
+        {0x3B0B8BC90012929D, 0x92C8AE6B464FC96F},
+        {0x09CE6EBB40173744, 0xB77ADA0617E3BBCB},
+        {0xCC420A6A101D0515, 0xE55990879DDCAABD},
+        {0x9FA946824A12232D, 0x8F57FA54C2A9EAB6},
+        {0x47939822DC96ABF9, 0xB32DF8E9F3546564},
+        {0x59787E2B93BC56F7, 0xDFF9772470297EBD},
+        {0x57EB4EDB3C55B65A, 0x8BFBEA76C619EF36},
+        {0xEDE622920B6B23F1, 0xAEFAE51477A06B03},
+        {0xE95FAB368E45ECED, 0xDAB99E59958885C4},
+        {0x11DBCB0218EBB414, 0x88B402F7FD75539B},
+        {0xD652BDC29F26A119, 0xAAE103B5FCD2A881},
+        {0x4BE76D3346F0495F, 0xD59944A37C0752A2},
+        {0x6F70A4400C562DDB, 0x857FCAE62D8493A5},
+        {0xCB4CCD500F6BB952, 0xA6DFBD9FB8E5B88E},
+        {0x7E2000A41346A7A7, 0xD097AD07A71F26B2},
+        {0x8ED400668C0C28C8, 0x825ECC24C873782F},
+        {0x728900802F0F32FA, 0xA2F67F2DFA90563B},
+        {0x4F2B40A03AD2FFB9, 0xCBB41EF979346BCA},
+        {0xE2F610C84987BFA8, 0xFEA126B7D78186BC},
+        {0x0DD9CA7D2DF4D7C9, 0x9F24B832E6B0F436},
+        {0x91503D1C79720DBB, 0xC6EDE63FA05D3143},
+        {0x75A44C6397CE912A, 0xF8A95FCF88747D94},
+        {0xC986AFBE3EE11ABA, 0x9B69DBE1B548CE7C},
+        {0xFBE85BADCE996168, 0xC24452DA229B021B},
+        {0xFAE27299423FB9C3, 0xF2D56790AB41C2A2},
+        {0xDCCD879FC967D41A, 0x97C560BA6B0919A5},
+        {0x5400E987BBC1C920, 0xBDB6B8E905CB600F},
+        {0x290123E9AAB23B68, 0xED246723473E3813},
+        {0xF9A0B6720AAF6521, 0x9436C0760C86E30B},
+        {0xF808E40E8D5B3E69, 0xB94470938FA89BCE},
+        {0xB60B1D1230B20E04, 0xE7958CB87392C2C2},
+        {0xB1C6F22B5E6F48C2, 0x90BD77F3483BB9B9},
+        {0x1E38AEB6360B1AF3, 0xB4ECD5F01A4AA828},
+        {0x25C6DA63C38DE1B0, 0xE2280B6C20DD5232},
+        {0x579C487E5A38AD0E, 0x8D590723948A535F},
+        {0x2D835A9DF0C6D851, 0xB0AF48EC79ACE837},
+        {0xF8E431456CF88E65, 0xDCDB1B2798182244},
+        {0x1B8E9ECB641B58FF, 0x8A08F0F8BF0F156B},
+        {0xE272467E3D222F3F, 0xAC8B2D36EED2DAC5},
+        {0x5B0ED81DCC6ABB0F, 0xD7ADF884AA879177},
+        {0x98E947129FC2B4E9, 0x86CCBB52EA94BAEA},
+        {0x3F2398D747B36224, 0xA87FEA27A539E9A5},
+        {0x8EEC7F0D19A03AAD, 0xD29FE4B18E88640E},
+        {0x1953CF68300424AC, 0x83A3EEEEF9153E89},
+        {0x5FA8C3423C052DD7, 0xA48CEAAAB75A8E2B},
+        {0x3792F412CB06794D, 0xCDB02555653131B6},
+        {0xE2BBD88BBEE40BD0, 0x808E17555F3EBF11},
+        {0x5B6ACEAEAE9D0EC4, 0xA0B19D2AB70E6ED6},
+        {0xF245825A5A445275, 0xC8DE047564D20A8B},
+        {0xEED6E2F0F0D56712, 0xFB158592BE068D2E},
+        {0x55464DD69685606B, 0x9CED737BB6C4183D},
+        {0xAA97E14C3C26B886, 0xC428D05AA4751E4C},
+        {0xD53DD99F4B3066A8, 0xF53304714D9265DF},
+        {0xE546A8038EFE4029, 0x993FE2C6D07B7FAB},
+        {0xDE98520472BDD033, 0xBF8FDB78849A5F96},
+        {0x963E66858F6D4440, 0xEF73D256A5C0F77C},
+        {0xDDE7001379A44AA8, 0x95A8637627989AAD},
+        {0x5560C018580D5D52, 0xBB127C53B17EC159},
+        {0xAAB8F01E6E10B4A6, 0xE9D71B689DDE71AF},
+        {0xCAB3961304CA70E8, 0x9226712162AB070D},
+        {0x3D607B97C5FD0D22, 0xB6B00D69BB55C8D1},
+        {0x8CB89A7DB77C506A, 0xE45C10C42A2B3B05},
+        {0x77F3608E92ADB242, 0x8EB98A7A9A5B04E3},
+        {0x55F038B237591ED3, 0xB267ED1940F1C61C},
+        {0x6B6C46DEC52F6688, 0xDF01E85F912E37A3},
+        {0x2323AC4B3B3DA015, 0x8B61313BBABCE2C6},
+        {0xABEC975E0A0D081A, 0xAE397D8AA96C1B77},
+        {0x96E7BD358C904A21, 0xD9C7DCED53C72255},
+        {0x7E50D64177DA2E54, 0x881CEA14545C7575},
+        {0xDDE50BD1D5D0B9E9, 0xAA242499697392D2},
+        {0x955E4EC64B44E864, 0xD4AD2DBFC3D07787},
+        {0xBD5AF13BEF0B113E, 0x84EC3C97DA624AB4},
+        {0xECB1AD8AEACDD58E, 0xA6274BBDD0FADD61},
+        {0x67DE18EDA5814AF2, 0xCFB11EAD453994BA},
+        {0x80EACF948770CED7, 0x81CEB32C4B43FCF4},
+        {0xA1258379A94D028D, 0xA2425FF75E14FC31},
+        {0x096EE45813A04330, 0xCAD2F7F5359A3B3E},
+        {0x8BCA9D6E188853FC, 0xFD87B5F28300CA0D},
+        {0x775EA264CF55347D, 0x9E74D1B791E07E48},
+        {0x95364AFE032A819D, 0xC612062576589DDA},
+        {0x3A83DDBD83F52204, 0xF79687AED3EEC551},
+        {0xC4926A9672793542, 0x9ABE14CD44753B52},
+        {0x75B7053C0F178293, 0xC16D9A0095928A27},
+        {0x5324C68B12DD6338, 0xF1C90080BAF72CB1},
+        {0xD3F6FC16EBCA5E03, 0x971DA05074DA7BEE},
+        {0x88F4BB1CA6BCF584, 0xBCE5086492111AEA},
+        {0x2B31E9E3D06C32E5, 0xEC1E4A7DB69561A5},
+        {0x3AFF322E62439FCF, 0x9392EE8E921D5D07},
+        {0x09BEFEB9FAD487C2, 0xB877AA3236A4B449},
+        {0x4C2EBE687989A9B3, 0xE69594BEC44DE15B},
+        {0x0F9D37014BF60A10, 0x901D7CF73AB0ACD9},
+        {0x538484C19EF38C94, 0xB424DC35095CD80F},
+        {0x2865A5F206B06FB9, 0xE12E13424BB40E13},
+        {0xF93F87B7442E45D3, 0x8CBCCC096F5088CB},
+        {0xF78F69A51539D748, 0xAFEBFF0BCB24AAFE},
+        {0xB573440E5A884D1B, 0xDBE6FECEBDEDD5BE},
+        {0x31680A88F8953030, 0x89705F4136B4A597},
+        {0xFDC20D2B36BA7C3D, 0xABCC77118461CEFC},
+        {0x3D32907604691B4C, 0xD6BF94D5E57A42BC},
+        {0xA63F9A49C2C1B10F, 0x8637BD05AF6C69B5},
+        {0x0FCF80DC33721D53, 0xA7C5AC471B478423},
+        {0xD3C36113404EA4A8, 0xD1B71758E219652B},
+        {0x645A1CAC083126E9, 0x83126E978D4FDF3B},
+        {0x3D70A3D70A3D70A3, 0xA3D70A3D70A3D70A},
+        {0xCCCCCCCCCCCCCCCC, 0xCCCCCCCCCCCCCCCC},
+        {0x0000000000000000, 0x8000000000000000},
+        {0x0000000000000000, 0xA000000000000000},
+        {0x0000000000000000, 0xC800000000000000},
+        {0x0000000000000000, 0xFA00000000000000},
+        {0x0000000000000000, 0x9C40000000000000},
+        {0x0000000000000000, 0xC350000000000000},
+        {0x0000000000000000, 0xF424000000000000},
+        {0x0000000000000000, 0x9896800000000000},
+        {0x0000000000000000, 0xBEBC200000000000},
+        {0x0000000000000000, 0xEE6B280000000000},
+        {0x0000000000000000, 0x9502F90000000000},
+        {0x0000000000000000, 0xBA43B74000000000},
+        {0x0000000000000000, 0xE8D4A51000000000},
+        {0x0000000000000000, 0x9184E72A00000000},
+        {0x0000000000000000, 0xB5E620F480000000},
+        {0x0000000000000000, 0xE35FA931A0000000},
+        {0x0000000000000000, 0x8E1BC9BF04000000},
+        {0x0000000000000000, 0xB1A2BC2EC5000000},
+        {0x0000000000000000, 0xDE0B6B3A76400000},
+        {0x0000000000000000, 0x8AC7230489E80000},
+        {0x0000000000000000, 0xAD78EBC5AC620000},
+        {0x0000000000000000, 0xD8D726B7177A8000},
+        {0x0000000000000000, 0x878678326EAC9000},
+        {0x0000000000000000, 0xA968163F0A57B400},
+        {0x0000000000000000, 0xD3C21BCECCEDA100},
+        {0x0000000000000000, 0x84595161401484A0},
+        {0x0000000000000000, 0xA56FA5B99019A5C8},
+        {0x0000000000000000, 0xCECB8F27F4200F3A},
+        {0x4000000000000000, 0x813F3978F8940984},
+        {0x5000000000000000, 0xA18F07D736B90BE5},
+        {0xA400000000000000, 0xC9F2C9CD04674EDE},
+        {0x4D00000000000000, 0xFC6F7C4045812296},
+        {0xF020000000000000, 0x9DC5ADA82B70B59D},
+        {0x6C28000000000000, 0xC5371912364CE305},
+        {0xC732000000000000, 0xF684DF56C3E01BC6},
+        {0x3C7F400000000000, 0x9A130B963A6C115C},
+        {0x4B9F100000000000, 0xC097CE7BC90715B3},
+        {0x1E86D40000000000, 0xF0BDC21ABB48DB20},
+        {0x1314448000000000, 0x96769950B50D88F4},
+        {0x17D955A000000000, 0xBC143FA4E250EB31},
+        {0x5DCFAB0800000000, 0xEB194F8E1AE525FD},
+        {0x5AA1CAE500000000, 0x92EFD1B8D0CF37BE},
+        {0xF14A3D9E40000000, 0xB7ABC627050305AD},
+        {0x6D9CCD05D0000000, 0xE596B7B0C643C719},
+        {0xE4820023A2000000, 0x8F7E32CE7BEA5C6F},
+        {0xDDA2802C8A800000, 0xB35DBF821AE4F38B},
+        {0xD50B2037AD200000, 0xE0352F62A19E306E},
+        {0x4526F422CC340000, 0x8C213D9DA502DE45},
+        {0x9670B12B7F410000, 0xAF298D050E4395D6},
+        {0x3C0CDD765F114000, 0xDAF3F04651D47B4C},
+        {0xA5880A69FB6AC800, 0x88D8762BF324CD0F},
+        {0x8EEA0D047A457A00, 0xAB0E93B6EFEE0053},
+        {0x72A4904598D6D880, 0xD5D238A4ABE98068},
+        {0x47A6DA2B7F864750, 0x85A36366EB71F041},
+        {0x999090B65F67D924, 0xA70C3C40A64E6C51},
+        {0xFFF4B4E3F741CF6D, 0xD0CF4B50CFE20765},
+        {0xBFF8F10E7A8921A4, 0x82818F1281ED449F},
+        {0xAFF72D52192B6A0D, 0xA321F2D7226895C7},
+        {0x9BF4F8A69F764490, 0xCBEA6F8CEB02BB39},
+        {0x02F236D04753D5B4, 0xFEE50B7025C36A08},
+        {0x01D762422C946590, 0x9F4F2726179A2245},
+        {0x424D3AD2B7B97EF5, 0xC722F0EF9D80AAD6},
+        {0xD2E0898765A7DEB2, 0xF8EBAD2B84E0D58B},
+        {0x63CC55F49F88EB2F, 0x9B934C3B330C8577},
+        {0x3CBF6B71C76B25FB, 0xC2781F49FFCFA6D5},
+        {0x8BEF464E3945EF7A, 0xF316271C7FC3908A},
+        {0x97758BF0E3CBB5AC, 0x97EDD871CFDA3A56},
+        {0x3D52EEED1CBEA317, 0xBDE94E8E43D0C8EC},
+        {0x4CA7AAA863EE4BDD, 0xED63A231D4C4FB27},
+        {0x8FE8CAA93E74EF6A, 0x945E455F24FB1CF8},
+        {0xB3E2FD538E122B44, 0xB975D6B6EE39E436},
+        {0x60DBBCA87196B616, 0xE7D34C64A9C85D44},
+        {0xBC8955E946FE31CD, 0x90E40FBEEA1D3A4A},
+        {0x6BABAB6398BDBE41, 0xB51D13AEA4A488DD},
+        {0xC696963C7EED2DD1, 0xE264589A4DCDAB14},
+        {0xFC1E1DE5CF543CA2, 0x8D7EB76070A08AEC},
+        {0x3B25A55F43294BCB, 0xB0DE65388CC8ADA8},
+        {0x49EF0EB713F39EBE, 0xDD15FE86AFFAD912},
+        {0x6E3569326C784337, 0x8A2DBF142DFCC7AB},
+        {0x49C2C37F07965404, 0xACB92ED9397BF996},
+        {0xDC33745EC97BE906, 0xD7E77A8F87DAF7FB},
+        {0x69A028BB3DED71A3, 0x86F0AC99B4E8DAFD},
+        {0xC40832EA0D68CE0C, 0xA8ACD7C0222311BC},
+        {0xF50A3FA490C30190, 0xD2D80DB02AABD62B},
+        {0x792667C6DA79E0FA, 0x83C7088E1AAB65DB},
+        {0x577001B891185938, 0xA4B8CAB1A1563F52},
+        {0xED4C0226B55E6F86, 0xCDE6FD5E09ABCF26},
+        {0x544F8158315B05B4, 0x80B05E5AC60B6178},
+        {0x696361AE3DB1C721, 0xA0DC75F1778E39D6},
+        {0x03BC3A19CD1E38E9, 0xC913936DD571C84C},
+        {0x04AB48A04065C723, 0xFB5878494ACE3A5F},
+        {0x62EB0D64283F9C76, 0x9D174B2DCEC0E47B},
+        {0x3BA5D0BD324F8394, 0xC45D1DF942711D9A},
+        {0xCA8F44EC7EE36479, 0xF5746577930D6500},
+        {0x7E998B13CF4E1ECB, 0x9968BF6ABBE85F20},
+        {0x9E3FEDD8C321A67E, 0xBFC2EF456AE276E8},
+        {0xC5CFE94EF3EA101E, 0xEFB3AB16C59B14A2},
+        {0xBBA1F1D158724A12, 0x95D04AEE3B80ECE5},
+        {0x2A8A6E45AE8EDC97, 0xBB445DA9CA61281F},
+        {0xF52D09D71A3293BD, 0xEA1575143CF97226},
+        {0x593C2626705F9C56, 0x924D692CA61BE758},
+        {0x6F8B2FB00C77836C, 0xB6E0C377CFA2E12E},
+        {0x0B6DFB9C0F956447, 0xE498F455C38B997A},
+        {0x4724BD4189BD5EAC, 0x8EDF98B59A373FEC},
+        {0x58EDEC91EC2CB657, 0xB2977EE300C50FE7},
+        {0x2F2967B66737E3ED, 0xDF3D5E9BC0F653E1},
+        {0xBD79E0D20082EE74, 0x8B865B215899F46C},
+        {0xECD8590680A3AA11, 0xAE67F1E9AEC07187},
+        {0xE80E6F4820CC9495, 0xDA01EE641A708DE9},
+        {0x3109058D147FDCDD, 0x884134FE908658B2},
+        {0xBD4B46F0599FD415, 0xAA51823E34A7EEDE},
+        {0x6C9E18AC7007C91A, 0xD4E5E2CDC1D1EA96},
+        {0x03E2CF6BC604DDB0, 0x850FADC09923329E},
+        {0x84DB8346B786151C, 0xA6539930BF6BFF45},
+        {0xE612641865679A63, 0xCFE87F7CEF46FF16},
+        {0x4FCB7E8F3F60C07E, 0x81F14FAE158C5F6E},
+        {0xE3BE5E330F38F09D, 0xA26DA3999AEF7749},
+        {0x5CADF5BFD3072CC5, 0xCB090C8001AB551C},
+        {0x73D9732FC7C8F7F6, 0xFDCB4FA002162A63},
+        {0x2867E7FDDCDD9AFA, 0x9E9F11C4014DDA7E},
+        {0xB281E1FD541501B8, 0xC646D63501A1511D},
+        {0x1F225A7CA91A4226, 0xF7D88BC24209A565},
+        {0x3375788DE9B06958, 0x9AE757596946075F},
+        {0x0052D6B1641C83AE, 0xC1A12D2FC3978937},
+        {0xC0678C5DBD23A49A, 0xF209787BB47D6B84},
+        {0xF840B7BA963646E0, 0x9745EB4D50CE6332},
+        {0xB650E5A93BC3D898, 0xBD176620A501FBFF},
+        {0xA3E51F138AB4CEBE, 0xEC5D3FA8CE427AFF},
+        {0xC66F336C36B10137, 0x93BA47C980E98CDF},
+        {0xB80B0047445D4184, 0xB8A8D9BBE123F017},
+        {0xA60DC059157491E5, 0xE6D3102AD96CEC1D},
+        {0x87C89837AD68DB2F, 0x9043EA1AC7E41392},
+        {0x29BABE4598C311FB, 0xB454E4A179DD1877},
+        {0xF4296DD6FEF3D67A, 0xE16A1DC9D8545E94},
+        {0x1899E4A65F58660C, 0x8CE2529E2734BB1D},
+        {0x5EC05DCFF72E7F8F, 0xB01AE745B101E9E4},
+        {0x76707543F4FA1F73, 0xDC21A1171D42645D},
+        {0x6A06494A791C53A8, 0x899504AE72497EBA},
+        {0x0487DB9D17636892, 0xABFA45DA0EDBDE69},
+        {0x45A9D2845D3C42B6, 0xD6F8D7509292D603},
+        {0x0B8A2392BA45A9B2, 0x865B86925B9BC5C2},
+        {0x8E6CAC7768D7141E, 0xA7F26836F282B732},
+        {0x3207D795430CD926, 0xD1EF0244AF2364FF},
+        {0x7F44E6BD49E807B8, 0x8335616AED761F1F},
+        {0x5F16206C9C6209A6, 0xA402B9C5A8D3A6E7},
+        {0x36DBA887C37A8C0F, 0xCD036837130890A1},
+        {0xC2494954DA2C9789, 0x802221226BE55A64},
+        {0xF2DB9BAA10B7BD6C, 0xA02AA96B06DEB0FD},
+        {0x6F92829494E5ACC7, 0xC83553C5C8965D3D},
+        {0xCB772339BA1F17F9, 0xFA42A8B73ABBF48C},
+        {0xFF2A760414536EFB, 0x9C69A97284B578D7},
+        {0xFEF5138519684ABA, 0xC38413CF25E2D70D},
+        {0x7EB258665FC25D69, 0xF46518C2EF5B8CD1},
+        {0xEF2F773FFBD97A61, 0x98BF2F79D5993802},
+        {0xAAFB550FFACFD8FA, 0xBEEEFB584AFF8603},
+        {0x95BA2A53F983CF38, 0xEEAABA2E5DBF6784},
+        {0xDD945A747BF26183, 0x952AB45CFA97A0B2},
+        {0x94F971119AEEF9E4, 0xBA756174393D88DF},
+        {0x7A37CD5601AAB85D, 0xE912B9D1478CEB17},
+        {0xAC62E055C10AB33A, 0x91ABB422CCB812EE},
+        {0x577B986B314D6009, 0xB616A12B7FE617AA},
+        {0xED5A7E85FDA0B80B, 0xE39C49765FDF9D94},
+        {0x14588F13BE847307, 0x8E41ADE9FBEBC27D},
+        {0x596EB2D8AE258FC8, 0xB1D219647AE6B31C},
+        {0x6FCA5F8ED9AEF3BB, 0xDE469FBD99A05FE3},
+        {0x25DE7BB9480D5854, 0x8AEC23D680043BEE},
+        {0xAF561AA79A10AE6A, 0xADA72CCC20054AE9},
+        {0x1B2BA1518094DA04, 0xD910F7FF28069DA4},
+        {0x90FB44D2F05D0842, 0x87AA9AFF79042286},
+        {0x353A1607AC744A53, 0xA99541BF57452B28},
+        {0x42889B8997915CE8, 0xD3FA922F2D1675F2},
+        {0x69956135FEBADA11, 0x847C9B5D7C2E09B7},
+        {0x43FAB9837E699095, 0xA59BC234DB398C25},
+        {0x94F967E45E03F4BB, 0xCF02B2C21207EF2E},
+        {0x1D1BE0EEBAC278F5, 0x8161AFB94B44F57D},
+        {0x6462D92A69731732, 0xA1BA1BA79E1632DC},
+        {0x7D7B8F7503CFDCFE, 0xCA28A291859BBF93},
+        {0x5CDA735244C3D43E, 0xFCB2CB35E702AF78},
+        {0x3A0888136AFA64A7, 0x9DEFBF01B061ADAB},
+        {0x088AAA1845B8FDD0, 0xC56BAEC21C7A1916},
+        {0x8AAD549E57273D45, 0xF6C69A72A3989F5B},
+        {0x36AC54E2F678864B, 0x9A3C2087A63F6399},
+        {0x84576A1BB416A7DD, 0xC0CB28A98FCF3C7F},
+        {0x656D44A2A11C51D5, 0xF0FDF2D3F3C30B9F},
+        {0x9F644AE5A4B1B325, 0x969EB7C47859E743},
+        {0x873D5D9F0DDE1FEE, 0xBC4665B596706114},
+        {0xA90CB506D155A7EA, 0xEB57FF22FC0C7959},
+        {0x09A7F12442D588F2, 0x9316FF75DD87CBD8},
+        {0x0C11ED6D538AEB2F, 0xB7DCBF5354E9BECE},
+        {0x8F1668C8A86DA5FA, 0xE5D3EF282A242E81},
+        {0xF96E017D694487BC, 0x8FA475791A569D10},
+        {0x37C981DCC395A9AC, 0xB38D92D760EC4455},
+        {0x85BBE253F47B1417, 0xE070F78D3927556A},
+        {0x93956D7478CCEC8E, 0x8C469AB843B89562},
+        {0x387AC8D1970027B2, 0xAF58416654A6BABB},
+        {0x06997B05FCC0319E, 0xDB2E51BFE9D0696A},
+        {0x441FECE3BDF81F03, 0x88FCF317F22241E2},
+        {0xD527E81CAD7626C3, 0xAB3C2FDDEEAAD25A},
+        {0x8A71E223D8D3B074, 0xD60B3BD56A5586F1},
+        {0xF6872D5667844E49, 0x85C7056562757456},
+        {0xB428F8AC016561DB, 0xA738C6BEBB12D16C},
+        {0xE13336D701BEBA52, 0xD106F86E69D785C7},
+        {0xECC0024661173473, 0x82A45B450226B39C},
+        {0x27F002D7F95D0190, 0xA34D721642B06084},
+        {0x31EC038DF7B441F4, 0xCC20CE9BD35C78A5},
+        {0x7E67047175A15271, 0xFF290242C83396CE},
+        {0x0F0062C6E984D386, 0x9F79A169BD203E41},
+        {0x52C07B78A3E60868, 0xC75809C42C684DD1},
+        {0xA7709A56CCDF8A82, 0xF92E0C3537826145},
+        {0x88A66076400BB691, 0x9BBCC7A142B17CCB},
+        {0x6ACFF893D00EA435, 0xC2ABF989935DDBFE},
+        {0x0583F6B8C4124D43, 0xF356F7EBF83552FE},
+        {0xC3727A337A8B704A, 0x98165AF37B2153DE},
+        {0x744F18C0592E4C5C, 0xBE1BF1B059E9A8D6},
+        {0x1162DEF06F79DF73, 0xEDA2EE1C7064130C},
+        {0x8ADDCB5645AC2BA8, 0x9485D4D1C63E8BE7},
+        {0x6D953E2BD7173692, 0xB9A74A0637CE2EE1},
+        {0xC8FA8DB6CCDD0437, 0xE8111C87C5C1BA99},
+        {0x1D9C9892400A22A2, 0x910AB1D4DB9914A0},
+        {0x2503BEB6D00CAB4B, 0xB54D5E4A127F59C8},
+        {0x2E44AE64840FD61D, 0xE2A0B5DC971F303A},
+        {0x5CEAECFED289E5D2, 0x8DA471A9DE737E24},
+        {0x7425A83E872C5F47, 0xB10D8E1456105DAD},
+        {0xD12F124E28F77719, 0xDD50F1996B947518},
+        {0x82BD6B70D99AAA6F, 0x8A5296FFE33CC92F},
+        {0x636CC64D1001550B, 0xACE73CBFDC0BFB7B},
+        {0x3C47F7E05401AA4E, 0xD8210BEFD30EFA5A},
+        {0x65ACFAEC34810A71, 0x8714A775E3E95C78},
+        {0x7F1839A741A14D0D, 0xA8D9D1535CE3B396},
+        {0x1EDE48111209A050, 0xD31045A8341CA07C},
+        {0x934AED0AAB460432, 0x83EA2B892091E44D},
+        {0xF81DA84D5617853F, 0xA4E4B66B68B65D60},
+        {0x36251260AB9D668E, 0xCE1DE40642E3F4B9},
+        {0xC1D72B7C6B426019, 0x80D2AE83E9CE78F3},
+        {0xB24CF65B8612F81F, 0xA1075A24E4421730},
+        {0xDEE033F26797B627, 0xC94930AE1D529CFC},
+        {0x169840EF017DA3B1, 0xFB9B7CD9A4A7443C},
+        {0x8E1F289560EE864E, 0x9D412E0806E88AA5},
+        {0xF1A6F2BAB92A27E2, 0xC491798A08A2AD4E},
+        {0xAE10AF696774B1DB, 0xF5B5D7EC8ACB58A2},
+        {0xACCA6DA1E0A8EF29, 0x9991A6F3D6BF1765},
+        {0x17FD090A58D32AF3, 0xBFF610B0CC6EDD3F},
+        {0xDDFC4B4CEF07F5B0, 0xEFF394DCFF8A948E},
+        {0x4ABDAF101564F98E, 0x95F83D0A1FB69CD9},
+        {0x9D6D1AD41ABE37F1, 0xBB764C4CA7A4440F},
+        {0x84C86189216DC5ED, 0xEA53DF5FD18D5513},
+        {0x32FD3CF5B4E49BB4, 0x92746B9BE2F8552C},
+        {0x3FBC8C33221DC2A1, 0xB7118682DBB66A77},
+        {0x0FABAF3FEAA5334A, 0xE4D5E82392A40515},
+        {0x29CB4D87F2A7400E, 0x8F05B1163BA6832D},
+        {0x743E20E9EF511012, 0xB2C71D5BCA9023F8},
+        {0x914DA9246B255416, 0xDF78E4B2BD342CF6},
+        {0x1AD089B6C2F7548E, 0x8BAB8EEFB6409C1A},
+        {0xA184AC2473B529B1, 0xAE9672ABA3D0C320},
+        {0xC9E5D72D90A2741E, 0xDA3C0F568CC4F3E8},
+        {0x7E2FA67C7A658892, 0x8865899617FB1871},
+        {0xDDBB901B98FEEAB7, 0xAA7EEBFB9DF9DE8D},
+        {0x552A74227F3EA565, 0xD51EA6FA85785631},
+        {0xD53A88958F87275F, 0x8533285C936B35DE},
+        {0x8A892ABAF368F137, 0xA67FF273B8460356},
+        {0x2D2B7569B0432D85, 0xD01FEF10A657842C},
+        {0x9C3B29620E29FC73, 0x8213F56A67F6B29B},
+        {0x8349F3BA91B47B8F, 0xA298F2C501F45F42},
+        {0x241C70A936219A73, 0xCB3F2F7642717713},
+        {0xED238CD383AA0110, 0xFE0EFB53D30DD4D7},
+        {0xF4363804324A40AA, 0x9EC95D1463E8A506},
+        {0xB143C6053EDCD0D5, 0xC67BB4597CE2CE48},
+        {0xDD94B7868E94050A, 0xF81AA16FDC1B81DA},
+        {0xCA7CF2B4191C8326, 0x9B10A4E5E9913128},
+        {0xFD1C2F611F63A3F0, 0xC1D4CE1F63F57D72},
+        {0xBC633B39673C8CEC, 0xF24A01A73CF2DCCF},
+        {0xD5BE0503E085D813, 0x976E41088617CA01},
+        {0x4B2D8644D8A74E18, 0xBD49D14AA79DBC82},
+        {0xDDF8E7D60ED1219E, 0xEC9C459D51852BA2},
+        {0xCABB90E5C942B503, 0x93E1AB8252F33B45},
+        {0x3D6A751F3B936243, 0xB8DA1662E7B00A17},
+        {0x0CC512670A783AD4, 0xE7109BFBA19C0C9D},
+        {0x27FB2B80668B24C5, 0x906A617D450187E2},
+        {0xB1F9F660802DEDF6, 0xB484F9DC9641E9DA},
+        {0x5E7873F8A0396973, 0xE1A63853BBD26451},
+        {0xDB0B487B6423E1E8, 0x8D07E33455637EB2},
+        {0x91CE1A9A3D2CDA62, 0xB049DC016ABC5E5F},
+        {0x7641A140CC7810FB, 0xDC5C5301C56B75F7},
+        {0xA9E904C87FCB0A9D, 0x89B9B3E11B6329BA},
+        {0x546345FA9FBDCD44, 0xAC2820D9623BF429},
+        {0xA97C177947AD4095, 0xD732290FBACAF133},
+        {0x49ED8EABCCCC485D, 0x867F59A9D4BED6C0},
+        {0x5C68F256BFFF5A74, 0xA81F301449EE8C70},
+        {0x73832EEC6FFF3111, 0xD226FC195C6A2F8C},
+};
+
+// wuffs_base__private_implementation__parse_number_f64_eisel_lemire returns
+// the closest double-precision float64 to (man * (10 ** exp10)), as IEEE 754
+// bits, or -1 if it cannot determine that result unambiguously.
+//
+// This is the algorithm from Daniel Lemire, "Number Parsing at a Gigabyte per
+// Second" (https://arxiv.org/abs/2101.11408), which builds on an idea by
+// Michael Eisel. It multiplies the 64-bit man by a 64-bit (or, if that isn't
+// precise enough, 128-bit) approximation to (10 ** exp10) and gives up (for a
+// slower, arbitrary precision fallback) if the truncated product lies too
+// close to a rounding boundary. In practice, it very rarely gives up.
+//
+// The returned value never has its sign bit set.
+//
+// Preconditions:
+//  - man is non-zero.
+//  - exp10 is in the range -307 ..= 288, the same range (from 1e-307 to
+//    1e+288) as wuffs_base__private_implementation__powers_of_10.
+//
+// The range of exp10 means that, for any uint64_t man, the result is a normal
+// (not subnormal, not infinite) float64, ignoring rounding at the very ends.
+static int64_t  //
+wuffs_base__private_implementation__parse_number_f64_eisel_lemire(
+    uint64_t man,
+    int32_t exp10) {
+  // The table entry is already normalized. Normalize man too.
+  const uint64_t* po10 =
+      &wuffs_base__private_implementation__powers_of_10[exp10 + 307][0];
+  uint32_t clz = wuffs_base__count_leading_zeroes_u64(man);
+  man <<= clz;
+
+  // Estimate the result's biased base-2 exponent. ((217706 * exp10) >> 16) is
+  // floor(log2(10 ** exp10)) over the table's range (confirmed by the script
+  // that printed the table). 1087 is 1023 + 64: the f64 exponent bias plus
+  // the width of man. This estimate is refined by -1 (below), depending on
+  // the high bit of the product.
+  uint64_t ret_exp2 =
+      ((uint64_t)(((217706 * exp10) >> 16) + 1087)) - ((uint64_t)clz);
+
+  // Multiply by the high 64 bits of the table entry. Both factors have their
+  // high bit set, so the 128-bit product x is at least (1 << 126) and x_hi has
+  // either 0 or 1 leading zeroes.
+  wuffs_base__multiply_u64__output x = wuffs_base__multiply_u64(man, po10[1]);
+  uint64_t x_hi = x.hi;
+  uint64_t x_lo = x.lo;
+
+  // The table entry was truncated, so x is a lower bound. The upper bound adds
+  // up to man to x_lo. We keep at most the top 55 bits of x_hi, so unless the
+  // low 9 bits of x_hi are all on and that addition carries, the lower bound
+  // gives the same answer as the upper bound.
+  if (((x_hi & 0x1FF) == 0x1FF) && ((x_lo + man) < man)) {
+    // Refine, using the low 64 bits of the table entry too. y is man times
+    // those low bits, and merged is the high 128 bits of the 192-bit product
+    // of man and the full 128-bit table entry.
+    wuffs_base__multiply_u64__output y = wuffs_base__multiply_u64(man, po10[0]);
+    uint64_t merged_hi = x_hi;
+    uint64_t merged_lo = x_lo + y.hi;
+    if (merged_lo < x_lo) {
+      merged_hi++;
+    }
+
+    // merged is still a lower bound. If its upper bound could still carry
+    // into the bits we keep, give up instead of going to even more precision.
+    if (((merged_hi & 0x1FF) == 0x1FF) && ((merged_lo + 1) == 0) &&
+        ((y.lo + man) < man)) {
+      return -1;
+    }
+
+    x_hi = merged_hi;
+    x_lo = merged_lo;
+  }
+
+  // Shift x_hi right by 9 or 10 bits (depending on its high bit) so that
+  // ret_mantissa has exactly 54 bits: 53 for a float64 plus 1 rounding bit.
+  uint64_t msb = x_hi >> 63;
+  uint64_t ret_mantissa = x_hi >> (msb + 9);
+  ret_exp2 -= 1 ^ msb;
+
+  // IEEE 754 rounds to nearest, ties to even. If x is exactly halfway between
+  // two float64 values (the dropped bits are "1000...000"), give up instead of
+  // deciding which way the tie breaks. For simplicity, this check treats the
+  // low 73 bits as dropped, regardless of msb.
+  if ((x_lo == 0) && ((x_hi & 0x1FF) == 0) && ((ret_mantissa & 3) == 1)) {
+    return -1;
+  }
+
+  // Round to nearest, from 54 to 53 bits. If that overflows to 54 bits
+  // again, shift once more.
+  ret_mantissa += ret_mantissa & 1;
+  ret_mantissa >>= 1;
+  if ((ret_mantissa >> 53) > 0) {
+    ret_mantissa >>= 1;
+    ret_exp2++;
+  }
+
+  // Give up on subnormal or infinite results. ret_exp2 is unsigned, so this
+  // rejects both 0 and 0x7FF (and anything wrapped around).
+  if ((ret_exp2 - 1) >= (0x7FF - 1)) {
+    return -1;
+  }
+
+  // Drop the implicit mantissa bit, pack the bits and return.
+  return (int64_t)((ret_mantissa & 0x000FFFFFFFFFFFFF) | (ret_exp2 << 52));
+}
+
+// --------
+
+wuffs_base__result_f64  //
+wuffs_base__parse_number_f64_special(wuffs_base__slice_u8 s,
+                                     const char* fallback_status_repr) {
+  do {
+    uint8_t* p = s.ptr;
+    uint8_t* q = s.ptr + s.len;
+
+    for (; (p < q) && (*p == '_'); p++) {
+    }
+    if (p >= q) {
+      goto fallback;
+    }
 
     // Parse sign.
     bool negative = false;
@@ -10681,8 +13685,13 @@ fallback:
   } while (0);
 }
 
-wuffs_base__result_f64  //
-wuffs_base__parse_number_f64(wuffs_base__slice_u8 s) {
+// wuffs_base__private_implementation__parse_number_f64_slow handles the
+// general case of wuffs_base__parse_number_f64: any number of digits, '_'
+// separators, a leading '+', a ',' decimal separator and extreme exponents.
+// It converts via an HPD, trying an MPB approximation first.
+static wuffs_base__result_f64  //
+wuffs_base__private_implementation__parse_number_f64_slow(
+    wuffs_base__slice_u8 s) {
   wuffs_base__private_implementation__medium_prec_bin m;
   wuffs_base__private_implementation__high_prec_dec h;
 
@@ -10832,6 +13841,639 @@ infinity:
   } while (0);
 }
 
+wuffs_base__result_f64  //
+wuffs_base__parse_number_f64(wuffs_base__slice_u8 s) {
+  // Try a fast path for the common case: "-ddd.dddE±ddd" with no '_' or '+'.
+  // Such a number is approximately (man * (10 ** exp10)), where man is a
+  // uint64_t holding the first 19 significant digits and exp10 is an int32_t,
+  // and can usually be converted without an HPD. Anything else (including
+  // invalid input) falls back to the slow path, which gives the same result,
+  // just slower.
+  do {
+    uint8_t* p = s.ptr;
+    uint8_t* q = s.ptr + s.len;
+
+    bool negative = (p < q) && (*p == '-');
+    p += negative ? 1 : 0;
+
+    // truncated is whether any non-zero digits after the first 19 significant
+    // digits were dropped: the exact value is strictly between (man * (10 **
+    // exp10)) and ((man + 1) * (10 ** exp10)).
+    uint64_t man = 0;
+    int32_t exp10 = 0;
+    uint32_t num_significant_digits = 0;
+    bool truncated = false;
+
+    // Parse the integral digits. A leading '0' must be the only one.
+    if ((p >= q) || (*p < '0') || ('9' < *p)) {
+      break;
+    } else if (*p == '0') {
+      p++;
+      if ((p < q) && ('0' <= *p) && (*p <= '9')) {
+        break;
+      }
+    } else {
+      uint8_t* integral = p;
+      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {
+        if (num_significant_digits < 19) {
+          man = (10 * man) + ((uint64_t)(*p - '0'));
+          num_significant_digits++;
+        } else {
+          exp10++;
+          truncated |= *p != '0';
+        }
+      }
+      if ((p - integral) >= 0x10000) {
+        goto slow;
+      }
+    }
+
+    // Parse the fractional digits, if any.
+    if ((p < q) && (*p == '.')) {
+      p++;
+      if ((p >= q) || (*p < '0') || ('9' < *p)) {
+        break;
+      }
+      uint8_t* fraction = p;
+      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {
+        if (num_significant_digits < 19) {
+          man = (10 * man) + ((uint64_t)(*p - '0'));
+          num_significant_digits += (man != 0) ? 1 : 0;
+          exp10--;
+        } else {
+          truncated |= *p != '0';
+        }
+      }
+      if ((p - fraction) >= 0x10000) {
+        goto slow;
+      }
+    }
+
+    // Parse the explicit exponent, if any. 0x10000 is far beyond any f64.
+    if ((p < q) && ((*p == 'E') || (*p == 'e'))) {
+      p++;
+      bool exp_negative = (p < q) && (*p == '-');
+      p += ((p < q) && ((*p == '-') || (*p == '+'))) ? 1 : 0;
+      if ((p >= q) || (*p < '0') || ('9' < *p)) {
+        break;
+      }
+      int32_t exp = 0;
+      for (; (p < q) && ('0' <= *p) && (*p <= '9'); p++) {
+        if (exp >= 0x10000) {
+          goto slow;
+        }
+        exp = (10 * exp) + ((int32_t)(*p - '0'));
+      }
+      exp10 += exp_negative ? -exp : +exp;
+    }
+
+    if (p != q) {
+      break;
+    }
+
+    uint64_t bits = negative ? 0x8000000000000000 : 0;
+    if (man == 0) {
+      wuffs_base__result_f64 ret;
+      ret.status.repr = NULL;
+      ret.value = wuffs_base__ieee_754_bit_representation__to_f64(bits);
+      return ret;
+    }
+
+    if (!truncated) {
+      // Converting a uint64_t to a double is correctly rounded (even when
+      // half-way between two float64 values, which Eisel-Lemire gives up on).
+      // If man and (10 ** exp10) are both exactly representable as a float64,
+      // a single float64 multiply or divide is too.
+      double d = (double)man;
+      if (exp10 != 0) {
+        if (((man >> 53) != 0) || (exp10 < -22) || (22 < exp10)) {
+          goto eisel_lemire;
+        } else if (exp10 > 0) {
+          d *= wuffs_base__private_implementation__f64_powers_of_10[+exp10];
+        } else {
+          d /= wuffs_base__private_implementation__f64_powers_of_10[-exp10];
+        }
+      }
+      wuffs_base__result_f64 ret;
+      ret.status.repr = NULL;
+      ret.value = negative ? -d : +d;
+      return ret;
+    }
+
+  eisel_lemire:
+    if ((-307 <= exp10) && (exp10 <= 288)) {
+      int64_t r =
+          wuffs_base__private_implementation__parse_number_f64_eisel_lemire(
+              man, exp10);
+      // If truncated, the exact value is between man and (man + 1). It
+      // converts to r only if (man + 1) also converts to r.
+      if (truncated && (r >= 0) &&
+          (r !=
+           wuffs_base__private_implementation__parse_number_f64_eisel_lemire(
+               man + 1, exp10))) {
+        r = -1;
+      }
+      if (r >= 0) {
+        wuffs_base__result_f64 ret;
+        ret.status.repr = NULL;
+        ret.value = wuffs_base__ieee_754_bit_representation__to_f64(
+            ((uint64_t)r) | bits);
+        return ret;
+      }
+    }
+  } while (0);
+
+slow:
+  return wuffs_base__private_implementation__parse_number_f64_slow(s);
+}
+
+// --------
+
+// wuffs_base__private_implementation__render_number_f64_grisu3_round_weed
+// adjusts the last of the num_digits digits (which are in the range [0 ..= 9],
+// not ['0' ..= '9']) so that the number they represent is as close as possible
+// to the exact value, and then returns whether that is provably the closest
+// shortest representation. If not, the caller should fall back to a slower,
+// exact algorithm.
+//
+// All of the uint64_t arguments are scaled so that one unit in the last
+// digit's place (ten_kappa) and the uncertainty of the approximations (unit)
+// are in the same fixed point representation. distance_too_high_w is the
+// distance from the (imprecise) upper bound to the (imprecise) value.
+static bool  //
+wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(
+    uint8_t* digits,
+    uint32_t num_digits,
+    uint64_t distance_too_high_w,
+    uint64_t unsafe_interval,
+    uint64_t rest,
+    uint64_t ten_kappa,
+    uint64_t unit) {
+  uint64_t small_distance = distance_too_high_w - unit;
+  uint64_t big_distance = distance_too_high_w + unit;
+
+  // Decrement the last digit while that brings us closer to small_distance
+  // (the closest possible location of the exact value) and stays within the
+  // unsafe interval.
+  while ((rest < small_distance) &&                  //
+         ((unsafe_interval - rest) >= ten_kappa) &&  //
+         (((rest + ten_kappa) < small_distance) ||
+          ((small_distance - rest) >= (rest + ten_kappa - small_distance)))) {
+    digits[num_digits - 1]--;
+    rest += ten_kappa;
+  }
+
+  // If decrementing once more would also bring us closer to big_distance (the
+  // farthest possible location of the exact value) then we cannot know which
+  // of the two candidates is the closest.
+  if ((rest < big_distance) &&                    //
+      ((unsafe_interval - rest) >= ten_kappa) &&  //
+      (((rest + ten_kappa) < big_distance) ||
+       ((big_distance - rest) > (rest + ten_kappa - big_distance)))) {
+    return false;
+  }
+
+  // The candidate must be safely inside the interval, accounting for the
+  // imprecision (of up to 2 units) in the approximations on both sides.
+  return ((2 * unit) <= rest) && (rest <= (unsafe_interval - (4 * unit)));
+}
+
+// wuffs_base__private_implementation__render_number_f64_grisu3 sets h to the
+// shortest decimal that parses back to the double (mantissa * (2 ** exp2)),
+// where mantissa is non-zero and includes the implicit 1<<52 bit for normal
+// numbers. Among equally short decimals it picks the closest one.
+//
+// It returns false (leaving h in an unspecified state) if it cannot guarantee
+// that, which happens for about 0.5% of all doubles. The caller should then
+// fall back to wuffs_base__private_implementation__high_prec_dec__assign and
+// wuffs_base__private_implementation__high_prec_dec__round_just_enough.
+//
+// This is the Grisu3 algorithm from Loitsch, "Printing Floating-Point Numbers
+// Quickly and Accurately with Integers" (see the medium_prec_bin type above),
+// as implemented in https://github.com/google/double-conversion's
+// fast-dtoa.cc. It re-uses the big_powers_of_10 table, which is exactly the
+// cached powers table from that paper.
+static bool  //
+wuffs_base__private_implementation__render_number_f64_grisu3(
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint64_t mantissa,
+    int32_t exp2) {
+  // The boundaries m_minus and m_plus are halfway between the number and its
+  // two neighbors. A power of 2 (other than the minimum exponent's) is closer
+  // to its predecessor than to its successor. Both boundaries have the same
+  // exp2 as the normalized w.
+  wuffs_base__private_implementation__medium_prec_bin m_plus;
+  m_plus.mantissa = (mantissa << 1) + 1;
+  m_plus.exp2 = exp2 - 1;
+  wuffs_base__private_implementation__medium_prec_bin__normalize(&m_plus);
+
+  wuffs_base__private_implementation__medium_prec_bin m_minus;
+  if ((mantissa == 0x10000000000000) && (exp2 > -1074)) {
+    m_minus.mantissa = (mantissa << 2) - 1;
+    m_minus.exp2 = exp2 - 2;
+  } else {
+    m_minus.mantissa = (mantissa << 1) - 1;
+    m_minus.exp2 = exp2 - 1;
+  }
+  m_minus.mantissa <<= (uint32_t)(m_minus.exp2 - m_plus.exp2);
+  m_minus.exp2 = m_plus.exp2;
+
+  wuffs_base__private_implementation__medium_prec_bin w;
+  w.mantissa = mantissa;
+  w.exp2 = exp2;
+  wuffs_base__private_implementation__medium_prec_bin__normalize(&w);
+
+  // Pick the cached power of 10, 1e(k) ≈ p_mantissa * (2 ** p_exp2), such
+  // that multiplying w by it gives an exp2 in the range [-60 ..= -32]. The
+  // multiplication adds 64 to the exponent sum, so we want p_exp2 in the
+  // range [min_p_exp2 ..= (min_p_exp2 + 28)]. The cached powers step by about
+  // 26.6 (8 * log2(10)), so there is at least one.
+  //
+  // Since p_mantissa's high bit is set, 1e(k) is roughly 2 ** (p_exp2 + 63).
+  // 78913 / (1 << 18) is approximately log10(2).
+  int32_t min_p_exp2 = -124 - w.exp2;
+  int32_t k = ((min_p_exp2 + 63) * 78913) >> 18;
+  int32_t i = (k + 348 + 7) / 8;
+  if (i < 0) {
+    i = 0;
+  } else if (i > 86) {
+    i = 86;
+  }
+  const uint32_t* p = &wuffs_base__private_implementation__big_powers_of_10[0];
+  while ((i > 0) && (((int32_t)(p[(3 * i) - 1])) >= min_p_exp2)) {
+    i--;
+  }
+  while ((i < 86) && (((int32_t)(p[(3 * i) + 2])) < min_p_exp2)) {
+    i++;
+  }
+  int32_t p_exp2 = (int32_t)(p[(3 * i) + 2]);
+  if ((p_exp2 < min_p_exp2) || ((min_p_exp2 + 28) < p_exp2)) {
+    return false;
+  }
+  int32_t p_exp10 = -348 + (8 * i);
+
+  // Scale. The MPB multiplication's preconditions say that its argument is
+  // normalized, but m_minus (merely aligned to m_plus) does not need the
+  // extra precision: the error bound below is still at most 1 unit.
+  p = &wuffs_base__private_implementation__big_powers_of_10[3 * i];
+  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&w, p);
+  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&m_plus, p);
+  wuffs_base__private_implementation__medium_prec_bin__mul_pow_10(&m_minus, p);
+
+  // The scaled values are approximations, each within 1 unit of the exact
+  // value. too_low and too_high are guaranteed to lie outside of the interval
+  // we want. unsafe_interval is the interval between them, and the exact
+  // boundaries are somewhere near its ends.
+  uint64_t unit = 1;
+  uint64_t too_low = m_minus.mantissa - unit;
+  uint64_t too_high = m_plus.mantissa + unit;
+  uint64_t unsafe_interval = too_high - too_low;
+
+  // Split too_high into integral and fractional parts, where "one" is
+  // (1 << shift). shift is in the range [32 ..= 60], so that integrals fits in
+  // a uint32_t and multiplying fractionals by 10 cannot overflow.
+  uint32_t shift = (uint32_t)(-w.exp2);
+  uint64_t one = ((uint64_t)1) << shift;
+  uint32_t integrals = (uint32_t)(too_high >> shift);
+  uint64_t fractionals = too_high & (one - 1);
+
+  // Find divisor, the largest power of 10 that is <= integrals, and kappa,
+  // one more than that power's exponent.
+  static const uint32_t powers[10] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+  };
+  int32_t kappa = 0;
+  while ((kappa < 10) && (integrals >= powers[kappa])) {
+    kappa++;
+  }
+  uint32_t divisor = (kappa > 0) ? powers[kappa - 1] : 0;
+
+  // Generate digits from the integral part, stopping as soon as the
+  // remainder is inside the unsafe interval.
+  uint32_t n = 0;
+  while (kappa > 0) {
+    uint32_t digit = integrals / divisor;
+    h->digits[n++] = (uint8_t)digit;
+    integrals -= digit * divisor;
+    kappa--;
+    uint64_t rest = (((uint64_t)integrals) << shift) + fractionals;
+    if (rest < unsafe_interval) {
+      if (!wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(
+              &h->digits[0], n, too_high - w.mantissa, unsafe_interval, rest,
+              ((uint64_t)divisor) << shift, unit)) {
+        return false;
+      }
+      goto done;
+    }
+    divisor /= 10;
+  }
+
+  // Generate digits from the fractional part. A double never needs more than
+  // 17 digits, so give up (instead of looping forever) if something went
+  // wrong.
+  while (n < 20) {
+    fractionals *= 10;
+    unit *= 10;
+    unsafe_interval *= 10;
+    h->digits[n++] = (uint8_t)(fractionals >> shift);
+    fractionals &= one - 1;
+    kappa--;
+    if (fractionals < unsafe_interval) {
+      if (!wuffs_base__private_implementation__render_number_f64_grisu3_round_weed(
+              &h->digits[0], n, (too_high - w.mantissa) * unit, unsafe_interval,
+              fractionals, one, unit)) {
+        return false;
+      }
+      goto done;
+    }
+  }
+  return false;
+
+done:
+  h->num_digits = n;
+  h->decimal_point = ((int32_t)n) + kappa - p_exp10;
+  h->negative = false;
+  h->truncated = false;
+  wuffs_base__private_implementation__high_prec_dec__trim(h);
+  return true;
+}
+
+// --------
+
+static size_t  //
+wuffs_base__private_implementation__render_inf_nan(wuffs_base__slice_u8 dst,
+                                                   const char* s,
+                                                   size_t n,
+                                                   uint32_t options) {
+  if (n > dst.len) {
+    return 0;
+  }
+  memcpy(dst.ptr + ((options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                        ? (dst.len - n)
+                        : 0),
+         s, n);
+  return n;
+}
+
+static size_t  //
+wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint32_t precision,
+    uint32_t options) {
+  size_t n = (h->negative ||
+              (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN))
+                 ? 1
+                 : 0;
+  if (h->decimal_point <= 0) {
+    n += 1;
+  } else {
+    n += (size_t)(h->decimal_point);
+  }
+  if (precision > 0) {
+    n += precision + 1;  // +1 for the '.'.
+  }
+
+  // Don't modify dst if the formatted number won't fit.
+  if (n > dst.len) {
+    return 0;
+  }
+
+  // Align-left or align-right.
+  uint8_t* ptr = (options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                     ? &dst.ptr[dst.len - n]
+                     : &dst.ptr[0];
+
+  // Leading "±".
+  if (h->negative) {
+    *ptr++ = '-';
+  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+    *ptr++ = '+';
+  }
+
+  // Integral digits.
+  if (h->decimal_point <= 0) {
+    *ptr++ = '0';
+  } else {
+    uint32_t m =
+        wuffs_base__u32__min(h->num_digits, (uint32_t)(h->decimal_point));
+    uint32_t i = 0;
+    for (; i < m; i++) {
+      *ptr++ = (uint8_t)('0' | h->digits[i]);
+    }
+    for (; i < (uint32_t)(h->decimal_point); i++) {
+      *ptr++ = '0';
+    }
+  }
+
+  // Separator and then fractional digits.
+  if (precision > 0) {
+    *ptr++ =
+        (options & WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA)
+            ? ','
+            : '.';
+    uint32_t i = 0;
+    for (; i < precision; i++) {
+      int32_t j = h->decimal_point + ((int32_t)i);
+      *ptr++ = (uint8_t)('0' | (((0 <= j) && (j < ((int32_t)(h->num_digits))))
+                                    ? h->digits[j]
+                                    : 0));
+    }
+  }
+
+  return n;
+}
+
+static size_t  //
+wuffs_base__private_implementation__high_prec_dec__render_exponent_present(
+    wuffs_base__slice_u8 dst,
+    wuffs_base__private_implementation__high_prec_dec* h,
+    uint32_t precision,
+    uint32_t options) {
+  int32_t exp = 0;
+  if (h->num_digits > 0) {
+    exp = h->decimal_point - 1;
+  }
+  bool negative_exp = exp < 0;
+  if (negative_exp) {
+    exp = -exp;
+  }
+
+  size_t n = (h->negative ||
+              (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN))
+                 ? 4
+                 : 3;  // Minimum 3 bytes: first digit and then "e±".
+  if (precision > 0) {
+    n += precision + 1;  // +1 for the '.'.
+  }
+  n += (exp < 100) ? 2 : 3;
+
+  // Don't modify dst if the formatted number won't fit.
+  if (n > dst.len) {
+    return 0;
+  }
+
+  // Align-left or align-right.
+  uint8_t* ptr = (options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT)
+                     ? &dst.ptr[dst.len - n]
+                     : &dst.ptr[0];
+
+  // Leading "±".
+  if (h->negative) {
+    *ptr++ = '-';
+  } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+    *ptr++ = '+';
+  }
+
+  // Integral digit.
+  if (h->num_digits > 0) {
+    *ptr++ = (uint8_t)('0' | h->digits[0]);
+  } else {
+    *ptr++ = '0';
+  }
+
+  // Separator and then fractional digits.
+  if (precision > 0) {
+    *ptr++ =
+        (options & WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA)
+            ? ','
+            : '.';
+    uint32_t i = 1;
+    uint32_t j = wuffs_base__u32__min(h->num_digits, precision + 1);
+    for (; i < j; i++) {
+      *ptr++ = (uint8_t)('0' | h->digits[i]);
+    }
+    for (; i <= precision; i++) {
+      *ptr++ = '0';
+    }
+  }
+
+  // Exponent: "e±" and then 2 or 3 digits.
+  *ptr++ = 'e';
+  *ptr++ = negative_exp ? '-' : '+';
+  if (exp >= 100) {
+    *ptr++ = (uint8_t)('0' + (exp / 100));
+    exp %= 100;
+  }
+  ptr[0] = wuffs_base__render_number__two_digits[(2 * exp) + 0];
+  ptr[1] = wuffs_base__render_number__two_digits[(2 * exp) + 1];
+
+  return n;
+}
+
+size_t  //
+wuffs_base__render_number_f64(wuffs_base__slice_u8 dst,
+                              double x,
+                              uint32_t precision,
+                              uint32_t options) {
+  // Decompose x (64 bits) into negativity (1 bit), base-2 exponent (11 bits
+  // with a -1023 bias) and mantissa (52 bits).
+  uint64_t bits = wuffs_base__ieee_754_bit_representation__from_f64(x);
+  bool neg = (bits >> 63) != 0;
+  int32_t exp2 = ((int32_t)(bits >> 52)) & 0x7FF;
+  uint64_t man = bits & 0x000FFFFFFFFFFFFFul;
+
+  // Apply the exponent bias and set the implicit top bit of the mantissa,
+  // unless x is subnormal. Also take care of Inf and NaN.
+  if (exp2 == 0x7FF) {
+    if (man != 0) {
+      return wuffs_base__private_implementation__render_inf_nan(dst, "NaN", 3,
+                                                                options);
+    } else if (neg) {
+      return wuffs_base__private_implementation__render_inf_nan(dst, "-Inf", 4,
+                                                                options);
+    } else if (options & WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN) {
+      return wuffs_base__private_implementation__render_inf_nan(dst, "+Inf", 4,
+                                                                options);
+    }
+    return wuffs_base__private_implementation__render_inf_nan(dst, "Inf", 3,
+                                                              options);
+  } else if (exp2 == 0) {
+    exp2 = -1074;
+  } else {
+    exp2 -= 1075;
+    man |= 0x0010000000000000ul;
+  }
+
+  // Convert from binary to decimal. x is now exactly (man * (2 ** exp2)).
+  wuffs_base__private_implementation__high_prec_dec h;
+  if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+    if (man == 0) {
+      wuffs_base__private_implementation__high_prec_dec__assign(&h, 0, 0,
+                                                                false);
+    } else if (!wuffs_base__private_implementation__render_number_f64_grisu3(
+                   &h, man, exp2)) {
+      wuffs_base__private_implementation__high_prec_dec__assign(&h, man, exp2,
+                                                                false);
+      wuffs_base__private_implementation__high_prec_dec__round_just_enough(
+          &h, exp2, man);
+    }
+  } else {
+    wuffs_base__private_implementation__high_prec_dec__assign(&h, man, exp2,
+                                                              false);
+    if (precision > 4095) {
+      precision = 4095;
+    }
+  }
+  h.negative = neg;
+
+  // Round and render, either explicitly with or without an exponent (like
+  // printf's "%e" or "%f"), or choosing whichever is appropriate ("%g").
+  int32_t nd = (int32_t)(h.num_digits);
+  switch (options & (WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT |
+                     WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT)) {
+    case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT:
+      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+        precision =
+            (nd > h.decimal_point) ? ((uint32_t)(nd - h.decimal_point)) : 0;
+      } else {
+        wuffs_base__private_implementation__high_prec_dec__round_nearest(
+            &h, h.decimal_point + ((int32_t)precision));
+      }
+      return wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(
+          dst, &h, precision, options);
+
+    case WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT:
+      if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+        precision = (nd > 0) ? ((uint32_t)(nd - 1)) : 0;
+      } else {
+        wuffs_base__private_implementation__high_prec_dec__round_nearest(
+            &h, 1 + ((int32_t)precision));
+      }
+      return wuffs_base__private_implementation__high_prec_dec__render_exponent_present(
+          dst, &h, precision, options);
+  }
+
+  // Like "%g", use the exponent notation only if the exponent is outside the
+  // range [e_min ..= e_max). For just enough precision, e_min and e_max are
+  // JavaScript's Number.prototype.toString thresholds.
+  int32_t e_min = -4;
+  int32_t e_max = 21;
+  if (options & WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION) {
+    e_min = -6;
+  } else {
+    if (precision == 0) {
+      precision = 1;
+    }
+    e_max = (int32_t)precision;
+    wuffs_base__private_implementation__high_prec_dec__round_nearest(
+        &h, (int32_t)precision);
+  }
+
+  // Rounding might have changed the number of digits or the exponent. Either
+  // way, like "%g", there are no trailing zeroes.
+  nd = (int32_t)(h.num_digits);
+  int32_t e = (nd > 0) ? (h.decimal_point - 1) : 0;
+  if ((e < e_min) || (e_max <= e)) {
+    precision = (nd > 0) ? ((uint32_t)(nd - 1)) : 0;
+    return wuffs_base__private_implementation__high_prec_dec__render_exponent_present(
+        dst, &h, precision, options);
+  }
+  precision = (nd > h.decimal_point) ? ((uint32_t)(nd - h.decimal_point)) : 0;
+  return wuffs_base__private_implementation__high_prec_dec__render_exponent_absent(
+      dst, &h, precision, options);
+}
+
 // ---------------- Hexadecimal
 
 size_t  //
@@ -11071,6 +14713,20 @@ wuffs_base__ascii__longest_valid_prefix(wuffs_base__slice_u8 s) {
 
 // ---------------- Private Function Prototypes
 
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up__choosy_default(wuffs_adler32__hasher* self,
+                                          wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up(wuffs_adler32__hasher* self,
+                          wuffs_base__slice_u8 a_x);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up_x86_sse42(wuffs_adler32__hasher* self,
+                                    wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- VTables
 
 const wuffs_base__hasher_u32__func_ptrs
@@ -11123,6 +14779,7 @@ wuffs_adler32__hasher__initialize(wuffs_adler32__hasher* self,
     }
   }
 
+  self->private_impl.choosy_up = &wuffs_adler32__hasher__up__choosy_default;
   self->private_impl.magic = WUFFS_BASE__MAGIC;
   self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
       wuffs_base__hasher_u32__vtable_name;
@@ -11164,6 +14821,22 @@ wuffs_adler32__hasher__set_quirk_enabled(wuffs_adler32__hasher* self,
   return wuffs_base__make_empty_struct();
 }
 
+// -------- func adler32.hasher.restart
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_adler32__hasher__restart(wuffs_adler32__hasher* self) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_started = false;
+  self->private_impl.f_state = 0;
+  return wuffs_base__make_empty_struct();
+}
+
 // -------- func adler32.hasher.update_u32
 
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
@@ -11176,15 +14849,77 @@ wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
     return 0;
   }
 
+  if (!self->private_impl.f_started) {
+    self->private_impl.f_started = true;
+    self->private_impl.f_state = 1;
+    self->private_impl.choosy_up = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+        wuffs_base__cpu_arch__have_x86_sse42()
+            ? &wuffs_adler32__hasher__up_x86_sse42
+            :
+#endif
+            self->private_impl.choosy_up);
+  }
+  wuffs_adler32__hasher__up(self, a_x);
+  return self->private_impl.f_state;
+}
+
+// -------- func adler32.hasher.combine_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_adler32__hasher__combine_u32(wuffs_adler32__hasher* self,
+                                   uint32_t a_other,
+                                   uint64_t a_other_length) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint32_t v_r = 0;
   uint32_t v_s1 = 0;
   uint32_t v_s2 = 0;
-  wuffs_base__slice_u8 v_remaining = {0};
-  wuffs_base__slice_u8 v_p = {0};
 
   if (!self->private_impl.f_started) {
     self->private_impl.f_started = true;
     self->private_impl.f_state = 1;
+    self->private_impl.choosy_up = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+        wuffs_base__cpu_arch__have_x86_sse42()
+            ? &wuffs_adler32__hasher__up_x86_sse42
+            :
+#endif
+            self->private_impl.choosy_up);
   }
+  v_r = ((uint32_t)((a_other_length % 65521)));
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((v_r * v_s1) % 65521);
+  v_s1 = ((v_s1 + ((a_other)&0xFFFF) + 65520) % 65521);
+  v_s2 = (((v_s2 + ((self->private_impl.f_state) >> (32 - (16))) +
+            ((a_other) >> (32 - (16))) + 65521) -
+           v_r) %
+          65521);
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return self->private_impl.f_state;
+}
+
+// -------- func adler32.hasher.up
+
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up(wuffs_adler32__hasher* self,
+                          wuffs_base__slice_u8 a_x) {
+  return (*self->private_impl.choosy_up)(self, a_x);
+}
+
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up__choosy_default(wuffs_adler32__hasher* self,
+                                          wuffs_base__slice_u8 a_x) {
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  wuffs_base__slice_u8 v_remaining = {0};
+  wuffs_base__slice_u8 v_p = {0};
+
   v_s1 = ((self->private_impl.f_state) & 0xFFFF);
   v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
   while (((uint64_t)(a_x.len)) > 0) {
@@ -11237,29 +14972,123 @@ wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
     a_x = v_remaining;
   }
   self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
-  return self->private_impl.f_state;
+  return wuffs_base__make_empty_struct();
 }
 
-#endif  // !defined(WUFFS_CONFIG__MODULES) ||
-        // defined(WUFFS_CONFIG__MODULE__ADLER32)
-
-#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__BMP)
-
-// ---------------- Status Codes Implementations
-
-const char* wuffs_bmp__error__bad_header = "#bmp: bad header";
-const char* wuffs_bmp__error__unsupported_bmp_file =
-    "#bmp: unsupported BMP file";
-const char* wuffs_bmp__error__internal_error_inconsistent_swizzle_count =
-    "#bmp: internal error: inconsistent swizzle count";
-
-// ---------------- Private Consts
-
-// ---------------- Private Initializer Prototypes
-
-// ---------------- Private Function Prototypes
+// -------- func adler32.hasher.up_x86_sse42
 
-static wuffs_base__status  //
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct  //
+wuffs_adler32__hasher__up_x86_sse42(wuffs_adler32__hasher* self,
+                                    wuffs_base__slice_u8 a_x) {
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+  wuffs_base__slice_u8 v_remaining = {0};
+  wuffs_base__slice_u8 v_p = {0};
+  __m128i v_zeroes = {0};
+  __m128i v_ones = {0};
+  __m128i v_weights__left = {0};
+  __m128i v_weights_right = {0};
+  __m128i v_q__left = {0};
+  __m128i v_q_right = {0};
+  __m128i v_v1 = {0};
+  __m128i v_v2 = {0};
+  __m128i v_v2j = {0};
+  __m128i v_v2k = {0};
+  uint32_t v_num_iterate_bytes = 0;
+
+  v_zeroes = _mm_set1_epi16((int16_t)(0));
+  v_ones = _mm_set1_epi16((int16_t)(1));
+  v_weights__left =
+      _mm_set_epi8((int8_t)(17), (int8_t)(18), (int8_t)(19), (int8_t)(20),
+                   (int8_t)(21), (int8_t)(22), (int8_t)(23), (int8_t)(24),
+                   (int8_t)(25), (int8_t)(26), (int8_t)(27), (int8_t)(28),
+                   (int8_t)(29), (int8_t)(30), (int8_t)(31), (int8_t)(32));
+  v_weights_right =
+      _mm_set_epi8((int8_t)(1), (int8_t)(2), (int8_t)(3), (int8_t)(4),
+                   (int8_t)(5), (int8_t)(6), (int8_t)(7), (int8_t)(8),
+                   (int8_t)(9), (int8_t)(10), (int8_t)(11), (int8_t)(12),
+                   (int8_t)(13), (int8_t)(14), (int8_t)(15), (int8_t)(16));
+  v_s1 = ((self->private_impl.f_state) & 0xFFFF);
+  v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
+  while (((uint64_t)(a_x.len)) > 0) {
+    v_remaining = wuffs_base__slice_u8__subslice_j(a_x, 0);
+    if (((uint64_t)(a_x.len)) > 5536) {
+      v_remaining = wuffs_base__slice_u8__subslice_i(a_x, 5536);
+      a_x = wuffs_base__slice_u8__subslice_j(a_x, 5536);
+    }
+    v_num_iterate_bytes = ((uint32_t)((((uint64_t)(a_x.len)) & 4294967264)));
+    v_s2 += (v_s1 * v_num_iterate_bytes);
+    v_v1 = _mm_setzero_si128();
+    v_v2j = _mm_setzero_si128();
+    v_v2k = _mm_setzero_si128();
+    while (((uint64_t)(a_x.len)) >= 32) {
+      v_q__left = _mm_lddqu_si128((
+          const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_j(a_x, 16)
+                                           .ptr));
+      v_q_right = _mm_lddqu_si128(
+          (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                            a_x, 16, 32)
+                                            .ptr));
+      v_v2j = _mm_add_epi32(v_v2j, v_v1);
+      v_v1 = _mm_add_epi32(v_v1, _mm_sad_epu8(v_q__left, v_zeroes));
+      v_v1 = _mm_add_epi32(v_v1, _mm_sad_epu8(v_q_right, v_zeroes));
+      v_v2k = _mm_add_epi32(
+          v_v2k, _mm_madd_epi16(_mm_maddubs_epi16(v_q__left, v_weights__left),
+                                v_ones));
+      v_v2k = _mm_add_epi32(
+          v_v2k, _mm_madd_epi16(_mm_maddubs_epi16(v_q_right, v_weights_right),
+                                v_ones));
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 32);
+    }
+    v_v1 = _mm_add_epi32(v_v1, _mm_shuffle_epi32(v_v1, 177));
+    v_v1 = _mm_add_epi32(v_v1, _mm_shuffle_epi32(v_v1, 78));
+    v_s1 += ((uint32_t)(_mm_cvtsi128_si32(v_v1)));
+    v_v2 = _mm_add_epi32(v_v2k, _mm_slli_epi32(v_v2j, 5));
+    v_v2 = _mm_add_epi32(v_v2, _mm_shuffle_epi32(v_v2, 177));
+    v_v2 = _mm_add_epi32(v_v2, _mm_shuffle_epi32(v_v2, 78));
+    v_s2 += ((uint32_t)(_mm_cvtsi128_si32(v_v2)));
+    {
+      wuffs_base__slice_u8 i_slice_p = a_x;
+      v_p = i_slice_p;
+      v_p.len = 1;
+      uint8_t* i_end0_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
+      while (v_p.ptr < i_end0_p) {
+        v_s1 += ((uint32_t)(v_p.ptr[0]));
+        v_s2 += v_s1;
+        v_p.ptr += 1;
+      }
+    }
+    v_s1 %= 65521;
+    v_s2 %= 65521;
+    a_x = v_remaining;
+  }
+  self->private_impl.f_state = (((v_s2 & 65535) << 16) | (v_s1 & 65535));
+  return wuffs_base__make_empty_struct();
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__ADLER32)
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__BMP)
+
+// ---------------- Status Codes Implementations
+
+const char* wuffs_bmp__error__bad_header = "#bmp: bad header";
+const char* wuffs_bmp__error__unsupported_bmp_file =
+    "#bmp: unsupported BMP file";
+const char* wuffs_bmp__error__internal_error_inconsistent_swizzle_count =
+    "#bmp: internal error: inconsistent swizzle count";
+
+// ---------------- Private Consts
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status  //
 wuffs_bmp__decoder__swizzle(wuffs_bmp__decoder* self,
                             wuffs_base__pixel_buffer* a_dst,
                             wuffs_base__slice_u8 a_src);
@@ -11736,6 +15565,8 @@ wuffs_bmp__decoder__decode_image_config(wuffs_bmp__decoder* self,
     self->private_impl.f_bytes_total =
         (self->private_impl.f_bytes_per_row *
          ((uint64_t)(self->private_impl.f_height)));
+    self->private_impl.f_clip_rect_x1 = self->private_impl.f_width;
+    self->private_impl.f_clip_rect_y1 = self->private_impl.f_height;
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
       uint32_t t_7;
@@ -12112,6 +15943,8 @@ wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__rect_ie_u32 v_clip = {0};
+  uint64_t v_src_bytes_per_pixel = 0;
   uint64_t v_bytes_remaining = 0;
   uint64_t v_n = 0;
   wuffs_base__slice_u8 v_src = {0};
@@ -12151,6 +15984,31 @@ wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
       status = wuffs_base__make_status(wuffs_base__note__end_of_data);
       goto ok;
     }
+    self->private_impl.f_scale_log2 = 0;
+    if (a_opts != NULL) {
+      v_clip = wuffs_base__decode_frame_options__dst_clip_rect(a_opts);
+      self->private_impl.f_scale_log2 =
+          wuffs_base__decode_frame_options__scale_log2(a_opts);
+    } else {
+      v_clip =
+          wuffs_base__utility__make_rect_ie_u32(0, 0, 4294967295, 4294967295);
+    }
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_width)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_height)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_clip_rect_x1)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_clip_rect_y1)))));
     self->private_data.s_decode_frame[0].scratch = self->private_impl.f_padding;
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
     if (self->private_data.s_decode_frame[0].scratch >
@@ -12162,17 +16020,49 @@ wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
       goto suspend;
     }
     iop_a_src += self->private_data.s_decode_frame[0].scratch;
-    if ((self->private_impl.f_width > 0) && (self->private_impl.f_height > 0)) {
-      self->private_impl.f_dst_x = 0;
+    if ((self->private_impl.f_clip_rect_x0 <
+         self->private_impl.f_clip_rect_x1) &&
+        (self->private_impl.f_clip_rect_y0 <
+         self->private_impl.f_clip_rect_y1)) {
       if (self->private_impl.f_top_down) {
-        self->private_impl.f_dst_y = 0;
-        self->private_impl.f_dst_y_end = self->private_impl.f_height;
+        self->private_impl.f_dst_y = self->private_impl.f_clip_rect_y0;
+        self->private_impl.f_dst_y_end = self->private_impl.f_clip_rect_y1;
         self->private_impl.f_dst_y_inc = 1;
+        v_n = ((uint64_t)(self->private_impl.f_clip_rect_y0));
       } else {
-        self->private_impl.f_dst_y = (self->private_impl.f_height - 1);
-        self->private_impl.f_dst_y_end = 4294967295;
+        self->private_impl.f_dst_y = (self->private_impl.f_clip_rect_y1 - 1);
+        self->private_impl.f_dst_y_end =
+            (self->private_impl.f_clip_rect_y0 - 1);
         self->private_impl.f_dst_y_inc = 4294967295;
+        v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+            self->private_impl.f_height, self->private_impl.f_clip_rect_y1)));
       }
+      self->private_data.s_decode_frame[0].scratch =
+          (self->private_impl.f_bytes_per_row * v_n);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (self->private_data.s_decode_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_frame[0].scratch;
+      v_src_bytes_per_pixel =
+          ((uint64_t)((self->private_impl.f_bits_per_pixel / 8)));
+      self->private_impl.f_row_lead_skip =
+          (((uint64_t)(self->private_impl.f_clip_rect_x0)) *
+           v_src_bytes_per_pixel);
+      self->private_impl.f_row_trail_skip =
+          ((((uint64_t)(wuffs_base__u32__sat_sub(
+                self->private_impl.f_width,
+                self->private_impl.f_clip_rect_x1))) *
+            v_src_bytes_per_pixel) +
+           ((uint64_t)(self->private_impl.f_pad_per_row)));
+      self->private_impl.f_dst_x = self->private_impl.f_clip_rect_x0;
+      self->private_impl.f_pending_skip = self->private_impl.f_row_lead_skip;
+      self->private_impl.f_num_stashed = 0;
       v_status = wuffs_base__pixel_swizzler__prepare(
           &self->private_impl.f_swizzler,
           wuffs_base__pixel_buffer__pixel_format(a_dst),
@@ -12189,7 +16079,10 @@ wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
         }
         goto ok;
       }
-      v_bytes_remaining = self->private_impl.f_bytes_total;
+      v_bytes_remaining = (self->private_impl.f_bytes_per_row *
+                           ((uint64_t)(wuffs_base__u32__sat_sub(
+                               self->private_impl.f_clip_rect_y1,
+                               self->private_impl.f_clip_rect_y0))));
       while (true) {
         v_n = ((uint64_t)(io2_a_src - iop_a_src));
         if (v_bytes_remaining >= v_n) {
@@ -12204,7 +16097,7 @@ wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
           goto label__0__break;
         } else if (wuffs_base__status__is_suspension(&v_status)) {
           status = v_status;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
         } else {
           status = v_status;
           if (wuffs_base__status__is_error(&status)) {
@@ -12218,6 +16111,37 @@ wuffs_bmp__decoder__decode_frame(wuffs_bmp__decoder* self,
         }
       }
     label__0__break:;
+      if (self->private_impl.f_top_down) {
+        v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+            self->private_impl.f_height, self->private_impl.f_clip_rect_y1)));
+      } else {
+        v_n = ((uint64_t)(self->private_impl.f_clip_rect_y0));
+      }
+      self->private_data.s_decode_frame[0].scratch =
+          (self->private_impl.f_bytes_per_row * v_n);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_decode_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_frame[0].scratch;
+    } else {
+      self->private_data.s_decode_frame[0].scratch =
+          self->private_impl.f_bytes_total;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (self->private_data.s_decode_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_decode_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_decode_frame[0].scratch;
     }
     self->private_impl.f_call_sequence = 3;
 
@@ -12258,8 +16182,10 @@ wuffs_bmp__decoder__swizzle(wuffs_bmp__decoder* self,
   uint64_t v_dst_bytes_per_pixel = 0;
   uint64_t v_dst_bytes_per_row = 0;
   uint8_t v_src_bytes_per_pixel = 0;
+  uint32_t v_scale_mask = 0;
   wuffs_base__table_u8 v_tab = {0};
   wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
   uint64_t v_i = 0;
   uint64_t v_n = 0;
 
@@ -12270,24 +16196,23 @@ wuffs_bmp__decoder__swizzle(wuffs_bmp__decoder* self,
     return wuffs_base__make_status(wuffs_base__error__unsupported_option);
   }
   v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
-  v_dst_bytes_per_row =
-      (((uint64_t)(self->private_impl.f_width)) * v_dst_bytes_per_pixel);
+  v_scale_mask = ((((uint32_t)(1)) << self->private_impl.f_scale_log2) - 1);
+  v_dst_bytes_per_row = (((((uint64_t)(self->private_impl.f_clip_rect_x1)) +
+                           ((uint64_t)(v_scale_mask))) >>
+                          self->private_impl.f_scale_log2) *
+                         v_dst_bytes_per_pixel);
   v_src_bytes_per_pixel =
       ((uint8_t)((self->private_impl.f_bits_per_pixel / 8)));
   v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
-  while (self->private_impl.f_pending_pad > 0) {
-    if (((uint64_t)(a_src.len)) <= 0) {
+  if (self->private_impl.f_pending_skip > 0) {
+    v_n = self->private_impl.f_pending_skip;
+    if (v_n <= ((uint64_t)(a_src.len))) {
+      a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
+      self->private_impl.f_pending_skip = 0;
+    } else {
+      self->private_impl.f_pending_skip = (v_n - ((uint64_t)(a_src.len)));
       return wuffs_base__make_status(wuffs_base__suspension__short_read);
     }
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-    self->private_impl.f_pending_pad -= 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-    a_src = wuffs_base__slice_u8__subslice_i(a_src, 1);
   }
   if (self->private_impl.f_num_stashed != 0) {
     while (self->private_impl.f_num_stashed < v_src_bytes_per_pixel) {
@@ -12306,62 +16231,118 @@ wuffs_bmp__decoder__swizzle(wuffs_bmp__decoder* self,
 #endif
       a_src = wuffs_base__slice_u8__subslice_i(a_src, 1);
     }
-    v_dst = wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
-    if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
-      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
-    }
-    v_i = (((uint64_t)(self->private_impl.f_dst_x)) * v_dst_bytes_per_pixel);
-    if (v_i < ((uint64_t)(v_dst.len))) {
-      wuffs_base__pixel_swizzler__swizzle_interleaved(
-          &self->private_impl.f_swizzler,
-          wuffs_base__slice_u8__subslice_i(v_dst, v_i),
-          wuffs_base__utility__empty_slice_u8(),
-          wuffs_base__slice_u8__subslice_j(
-              wuffs_base__make_slice_u8(self->private_impl.f_stash, 4),
-              self->private_impl.f_num_stashed));
-      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x, 1);
-    }
+    if (((self->private_impl.f_dst_x & v_scale_mask) == 0) &&
+        ((self->private_impl.f_dst_y & v_scale_mask) == 0)) {
+      v_dst = wuffs_base__table_u8__row(
+          v_tab,
+          (self->private_impl.f_dst_y >> self->private_impl.f_scale_log2));
+      if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
+        v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
+      }
+      v_i = (((uint64_t)((self->private_impl.f_dst_x >>
+                          self->private_impl.f_scale_log2))) *
+             v_dst_bytes_per_pixel);
+      if (v_i < ((uint64_t)(v_dst.len))) {
+        wuffs_base__pixel_swizzler__swizzle_interleaved(
+            &self->private_impl.f_swizzler,
+            wuffs_base__slice_u8__subslice_i(v_dst, v_i),
+            wuffs_base__utility__empty_slice_u8(),
+            wuffs_base__slice_u8__subslice_j(
+                wuffs_base__make_slice_u8(self->private_impl.f_stash, 4),
+                self->private_impl.f_num_stashed));
+      }
+    }
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x, 1);
     self->private_impl.f_num_stashed = 0;
   }
+label__0__continue:;
   while (true) {
-    if (self->private_impl.f_dst_x == self->private_impl.f_width) {
-      self->private_impl.f_dst_x = 0;
+    if (self->private_impl.f_dst_x >= self->private_impl.f_clip_rect_x1) {
+      self->private_impl.f_dst_x = self->private_impl.f_clip_rect_x0;
       self->private_impl.f_dst_y += self->private_impl.f_dst_y_inc;
-      if (self->private_impl.f_pad_per_row != 0) {
-        v_n = ((uint64_t)(self->private_impl.f_pad_per_row));
-        if (v_n <= ((uint64_t)(a_src.len))) {
-          a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
-        } else {
-          self->private_impl.f_pending_pad =
-              ((uint8_t)(((v_n - ((uint64_t)(a_src.len))) & 3)));
-          return wuffs_base__make_status(wuffs_base__suspension__short_read);
-        }
+      v_n = self->private_impl.f_row_trail_skip;
+      if (self->private_impl.f_dst_y != self->private_impl.f_dst_y_end) {
+        v_n += self->private_impl.f_row_lead_skip;
+      }
+      if (v_n <= ((uint64_t)(a_src.len))) {
+        a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
+      } else {
+        self->private_impl.f_pending_skip = (v_n - ((uint64_t)(a_src.len)));
+        return wuffs_base__make_status(wuffs_base__suspension__short_read);
       }
     }
     if (self->private_impl.f_dst_y == self->private_impl.f_dst_y_end) {
       goto label__0__break;
     }
-    v_dst = wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
+    v_dst = wuffs_base__table_u8__row(
+        v_tab, (self->private_impl.f_dst_y >> self->private_impl.f_scale_log2));
     if (v_dst_bytes_per_row < ((uint64_t)(v_dst.len))) {
       v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_dst_bytes_per_row);
     }
-    v_i = (((uint64_t)(self->private_impl.f_dst_x)) * v_dst_bytes_per_pixel);
-    if (v_i < ((uint64_t)(v_dst.len))) {
-      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
-          &self->private_impl.f_swizzler,
-          wuffs_base__slice_u8__subslice_i(v_dst, v_i),
-          wuffs_base__utility__empty_slice_u8(), a_src);
+    v_i = (((uint64_t)((self->private_impl.f_dst_x >>
+                        self->private_impl.f_scale_log2))) *
+           v_dst_bytes_per_pixel);
+    if (v_i <= ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
+    } else {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
+    }
+    if (((self->private_impl.f_dst_y & v_scale_mask) != 0) ||
+        (((uint64_t)(v_dst.len)) < v_dst_bytes_per_pixel)) {
+      v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+          self->private_impl.f_clip_rect_x1, self->private_impl.f_dst_x)));
+    } else if ((self->private_impl.f_dst_x & v_scale_mask) != 0) {
+      v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+          wuffs_base__u32__sat_add((self->private_impl.f_dst_x | v_scale_mask),
+                                   1),
+          self->private_impl.f_dst_x)));
+      v_n = wuffs_base__u64__min(
+          v_n,
+          ((uint64_t)(wuffs_base__u32__sat_sub(
+              self->private_impl.f_clip_rect_x1, self->private_impl.f_dst_x))));
+    } else {
+      v_n = 0;
+    }
+    if (v_n > 0) {
       wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
                                         ((uint32_t)((v_n & 4294967295))));
       v_n = ((v_n & 4294967295) * ((uint64_t)(v_src_bytes_per_pixel)));
       if (v_n <= ((uint64_t)(a_src.len))) {
         a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
       } else {
-        return wuffs_base__make_status(
-            wuffs_bmp__error__internal_error_inconsistent_swizzle_count);
+        self->private_impl.f_pending_skip = (v_n - ((uint64_t)(a_src.len)));
+        return wuffs_base__make_status(wuffs_base__suspension__short_read);
       }
+      goto label__0__continue;
+    }
+    v_src = a_src;
+    v_n =
+        (((uint64_t)(wuffs_base__u32__sat_sub(self->private_impl.f_clip_rect_x1,
+                                              self->private_impl.f_dst_x))) *
+         ((uint64_t)(v_src_bytes_per_pixel)));
+    if (v_n < ((uint64_t)(v_src.len))) {
+      v_src = wuffs_base__slice_u8__subslice_j(v_src, v_n);
+    }
+    v_n = wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
+        &self->private_impl.f_swizzler, v_dst,
+        wuffs_base__utility__empty_slice_u8(), v_src, (v_scale_mask + 1));
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
+                                      ((uint32_t)((v_n & 4294967295))));
+    v_n = ((v_n & 4294967295) * ((uint64_t)(v_src_bytes_per_pixel)));
+    if (v_n <= ((uint64_t)(a_src.len))) {
+      a_src = wuffs_base__slice_u8__subslice_i(a_src, v_n);
+    } else {
+      return wuffs_base__make_status(
+          wuffs_bmp__error__internal_error_inconsistent_swizzle_count);
     }
-    if (self->private_impl.f_dst_x < self->private_impl.f_width) {
+    if (self->private_impl.f_dst_x < self->private_impl.f_clip_rect_x1) {
+      if (((uint64_t)(a_src.len)) >= ((uint64_t)(v_src_bytes_per_pixel))) {
+        if (v_n == 0) {
+          return wuffs_base__make_status(
+              wuffs_bmp__error__internal_error_inconsistent_swizzle_count);
+        }
+        goto label__0__continue;
+      }
       while ((self->private_impl.f_num_stashed < v_src_bytes_per_pixel) &&
              (((uint64_t)(a_src.len)) > 0)) {
         self->private_impl.f_stash[self->private_impl.f_num_stashed] =
@@ -12501,8 +16482,26 @@ wuffs_bmp__decoder__frame_dirty_rect(const wuffs_bmp__decoder* self) {
     return wuffs_base__utility__empty_rect_ie_u32();
   }
 
-  return wuffs_base__utility__make_rect_ie_u32(0, 0, self->private_impl.f_width,
-                                               self->private_impl.f_height);
+  uint64_t v_scale_mask = 0;
+
+  v_scale_mask = ((((uint64_t)(1)) << self->private_impl.f_scale_log2) - 1);
+  return wuffs_base__utility__make_rect_ie_u32(
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_x0)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_y0)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_x1)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_y1)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))));
 }
 
 // -------- func bmp.decoder.metadata_chunk_length
@@ -13514,10 +17513,40 @@ static const uint32_t                 //
         },
 };
 
+static const uint32_t           //
+    WUFFS_CRC32__X2N_TABLE[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1073741824, 536870912,  134217728,  8388608,    32768,      3988292384,
+        2984685714, 2691310871, 3982654894, 2295415911, 3619421802, 3963911953,
+        2390663536, 1680310286, 1296546528, 167662735,  2206543119, 808857370,
+        2069535939, 838779241,  2683044394, 1821240772, 366380877,  1608415822,
+        3134787127, 776888047,  1319870996, 2829349568, 1117427358, 344797226,
+        3289097936, 3303156796,
+};
+
 // ---------------- Private Initializer Prototypes
 
 // ---------------- Private Function Prototypes
 
+static uint32_t  //
+wuffs_crc32__ieee_hasher__multiply_mod_p(const wuffs_crc32__ieee_hasher* self,
+                                         uint32_t a_a,
+                                         uint32_t a_b);
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up__choosy_default(wuffs_crc32__ieee_hasher* self,
+                                             wuffs_base__slice_u8 a_x);
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up(wuffs_crc32__ieee_hasher* self,
+                             wuffs_base__slice_u8 a_x);
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up_x86_sse42(wuffs_crc32__ieee_hasher* self,
+                                       wuffs_base__slice_u8 a_x);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
 // ---------------- VTables
 
 const wuffs_base__hasher_u32__func_ptrs
@@ -13570,6 +17599,7 @@ wuffs_crc32__ieee_hasher__initialize(wuffs_crc32__ieee_hasher* self,
     }
   }
 
+  self->private_impl.choosy_up = &wuffs_crc32__ieee_hasher__up__choosy_default;
   self->private_impl.magic = WUFFS_BASE__MAGIC;
   self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
       wuffs_base__hasher_u32__vtable_name;
@@ -13611,6 +17641,21 @@ wuffs_crc32__ieee_hasher__set_quirk_enabled(wuffs_crc32__ieee_hasher* self,
   return wuffs_base__make_empty_struct();
 }
 
+// -------- func crc32.ieee_hasher.restart
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__restart(wuffs_crc32__ieee_hasher* self) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_state = 0;
+  return wuffs_base__make_empty_struct();
+}
+
 // -------- func crc32.ieee_hasher.update_u32
 
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
@@ -13623,6 +17668,99 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
     return 0;
   }
 
+  if (self->private_impl.f_state == 0) {
+    self->private_impl.choosy_up = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+        wuffs_base__cpu_arch__have_x86_sse42()
+            ? &wuffs_crc32__ieee_hasher__up_x86_sse42
+            :
+#endif
+            self->private_impl.choosy_up);
+  }
+  wuffs_crc32__ieee_hasher__up(self, a_x);
+  return self->private_impl.f_state;
+}
+
+// -------- func crc32.ieee_hasher.combine_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__ieee_hasher__combine_u32(wuffs_crc32__ieee_hasher* self,
+                                      uint32_t a_other,
+                                      uint64_t a_other_length) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint32_t v_p = 0;
+  uint64_t v_n = 0;
+  uint32_t v_k = 0;
+
+  if (self->private_impl.f_state == 0) {
+    self->private_impl.choosy_up = (
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+        wuffs_base__cpu_arch__have_x86_sse42()
+            ? &wuffs_crc32__ieee_hasher__up_x86_sse42
+            :
+#endif
+            self->private_impl.choosy_up);
+  }
+  v_p = 2147483648;
+  v_n = a_other_length;
+  v_k = 3;
+  while (v_n > 0) {
+    if ((v_n & 1) != 0) {
+      v_p = wuffs_crc32__ieee_hasher__multiply_mod_p(
+          self, WUFFS_CRC32__X2N_TABLE[(v_k & 31)], v_p);
+    }
+    v_n >>= 1;
+    v_k += 1;
+  }
+  self->private_impl.f_state = (wuffs_crc32__ieee_hasher__multiply_mod_p(
+                                    self, v_p, self->private_impl.f_state) ^
+                                a_other);
+  return self->private_impl.f_state;
+}
+
+// -------- func crc32.ieee_hasher.multiply_mod_p
+
+static uint32_t  //
+wuffs_crc32__ieee_hasher__multiply_mod_p(const wuffs_crc32__ieee_hasher* self,
+                                         uint32_t a_a,
+                                         uint32_t a_b) {
+  uint32_t v_m = 0;
+  uint32_t v_p = 0;
+  uint32_t v_q = 0;
+
+  v_m = 2147483648;
+  v_q = a_b;
+  while (v_m > 0) {
+    if ((a_a & v_m) != 0) {
+      v_p ^= v_q;
+    }
+    if ((v_q & 1) != 0) {
+      v_q = ((v_q >> 1) ^ 3988292384);
+    } else {
+      v_q >>= 1;
+    }
+    v_m >>= 1;
+  }
+  return v_p;
+}
+
+// -------- func crc32.ieee_hasher.up
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up(wuffs_crc32__ieee_hasher* self,
+                             wuffs_base__slice_u8 a_x) {
+  return (*self->private_impl.choosy_up)(self, a_x);
+}
+
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up__choosy_default(wuffs_crc32__ieee_hasher* self,
+                                             wuffs_base__slice_u8 a_x) {
   uint32_t v_s = 0;
   wuffs_base__slice_u8 v_p = {0};
 
@@ -13708,8 +17846,134 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
     }
   }
   self->private_impl.f_state = (4294967295 ^ v_s);
-  return self->private_impl.f_state;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func crc32.ieee_hasher.up_x86_sse42
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
+static wuffs_base__empty_struct  //
+wuffs_crc32__ieee_hasher__up_x86_sse42(wuffs_crc32__ieee_hasher* self,
+                                       wuffs_base__slice_u8 a_x) {
+  uint32_t v_s = 0;
+  wuffs_base__slice_u8 v_p = {0};
+  __m128i v_k = {0};
+  __m128i v_x0 = {0};
+  __m128i v_x1 = {0};
+  __m128i v_x2 = {0};
+  __m128i v_x3 = {0};
+  __m128i v_y0 = {0};
+  __m128i v_y1 = {0};
+  __m128i v_y2 = {0};
+  __m128i v_y3 = {0};
+
+  v_s = (4294967295 ^ self->private_impl.f_state);
+  if (((uint64_t)(a_x.len)) >= 64) {
+    v_x0 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(a_x, 0,
+                                                                        16)
+                                          .ptr));
+    v_x1 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(a_x, 16,
+                                                                        32)
+                                          .ptr));
+    v_x2 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(a_x, 32,
+                                                                        48)
+                                          .ptr));
+    v_x3 = _mm_lddqu_si128(
+        (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(a_x, 48,
+                                                                        64)
+                                          .ptr));
+    v_x0 = _mm_xor_si128(v_x0, _mm_cvtsi32_si128((int32_t)(v_s)));
+    a_x = wuffs_base__slice_u8__subslice_i(a_x, 64);
+    v_k = _mm_set_epi64x((int64_t)(7631803798), (int64_t)(5708721108));
+    while (((uint64_t)(a_x.len)) >= 64) {
+      v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+      v_y1 = _mm_clmulepi64_si128(v_x1, v_k, 0);
+      v_y2 = _mm_clmulepi64_si128(v_x2, v_k, 0);
+      v_y3 = _mm_clmulepi64_si128(v_x3, v_k, 0);
+      v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+      v_x1 = _mm_clmulepi64_si128(v_x1, v_k, 17);
+      v_x2 = _mm_clmulepi64_si128(v_x2, v_k, 17);
+      v_x3 = _mm_clmulepi64_si128(v_x3, v_k, 17);
+      v_x0 = _mm_xor_si128(
+          _mm_xor_si128(v_x0, v_y0),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 0, 16)
+                                                .ptr)));
+      v_x1 = _mm_xor_si128(
+          _mm_xor_si128(v_x1, v_y1),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 16, 32)
+                                                .ptr)));
+      v_x2 = _mm_xor_si128(
+          _mm_xor_si128(v_x2, v_y2),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 32, 48)
+                                                .ptr)));
+      v_x3 = _mm_xor_si128(
+          _mm_xor_si128(v_x3, v_y3),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 48, 64)
+                                                .ptr)));
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 64);
+    }
+    v_k = _mm_set_epi64x((int64_t)(3433693342), (int64_t)(6259578832));
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+    v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+    v_x0 = _mm_xor_si128(_mm_xor_si128(v_x0, v_x1), v_y0);
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+    v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+    v_x0 = _mm_xor_si128(_mm_xor_si128(v_x0, v_x2), v_y0);
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+    v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+    v_x0 = _mm_xor_si128(_mm_xor_si128(v_x0, v_x3), v_y0);
+    while (((uint64_t)(a_x.len)) >= 16) {
+      v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 0);
+      v_x0 = _mm_clmulepi64_si128(v_x0, v_k, 17);
+      v_x0 = _mm_xor_si128(
+          _mm_xor_si128(v_x0, v_y0),
+          _mm_lddqu_si128(
+              (const __m128i*)(const void*)(wuffs_base__slice_u8__subslice_ij(
+                                                a_x, 0, 16)
+                                                .ptr)));
+      a_x = wuffs_base__slice_u8__subslice_i(a_x, 16);
+    }
+    v_y0 = _mm_clmulepi64_si128(v_x0, v_k, 16);
+    v_y1 = _mm_set_epi32((int32_t)(0), (int32_t)(4294967295), (int32_t)(0),
+                         (int32_t)(4294967295));
+    v_x0 = _mm_xor_si128(_mm_srli_si128(v_x0, 8), v_y0);
+    v_k = _mm_set_epi64x((int64_t)(0), (int64_t)(5969371428));
+    v_y0 = _mm_srli_si128(v_x0, 4);
+    v_x0 = _mm_xor_si128(
+        _mm_clmulepi64_si128(_mm_and_si128(v_x0, v_y1), v_k, 0), v_y0);
+    v_k = _mm_set_epi64x((int64_t)(8439010881), (int64_t)(7976584769));
+    v_y0 = _mm_clmulepi64_si128(_mm_and_si128(v_x0, v_y1), v_k, 16);
+    v_y0 = _mm_clmulepi64_si128(_mm_and_si128(v_y0, v_y1), v_k, 0);
+    v_s = ((uint32_t)(_mm_extract_epi32(_mm_xor_si128(v_x0, v_y0), 1)));
+  }
+  {
+    wuffs_base__slice_u8 i_slice_p = a_x;
+    v_p = i_slice_p;
+    v_p.len = 1;
+    uint8_t* i_end0_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
+    while (v_p.ptr < i_end0_p) {
+      v_s =
+          (WUFFS_CRC32__IEEE_TABLE[0][(((uint8_t)((v_s & 255))) ^ v_p.ptr[0])] ^
+           (v_s >> 8));
+      v_p.ptr += 1;
+    }
+  }
+  self->private_impl.f_state = (4294967295 ^ v_s);
+  return wuffs_base__make_empty_struct();
 }
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
         // defined(WUFFS_CONFIG__MODULE__CRC32)
@@ -13751,6 +18015,8 @@ const char* wuffs_deflate__error__internal_error_inconsistent_distance =
     "#deflate: internal error: inconsistent distance";
 const char* wuffs_deflate__error__internal_error_inconsistent_n_bits =
     "#deflate: internal error: inconsistent n_bits";
+const char* wuffs_deflate__error__internal_error_inconsistent_encoder_state =
+    "#deflate: internal error: inconsistent encoder state";
 
 // ---------------- Private Consts
 
@@ -13806,9 +18072,128 @@ static const uint32_t                       //
         134217728,  134217728,
 };
 
-#define WUFFS_DEFLATE__HUFFS_TABLE_SIZE 1024
+#define WUFFS_DEFLATE__HUFFS_TABLE_SIZE 2048
+
+#define WUFFS_DEFLATE__HUFFS_TABLE_MASK 2047
+
+#define WUFFS_DEFLATE__QUIRKS_BASE 867177472
+
+#define WUFFS_DEFLATE__QUIRKS_COUNT 1
+
+#define WUFFS_DEFLATE__SYMS_SIZE 16384
+
+#define WUFFS_DEFLATE__MIN_LOOKAHEAD 262
+
+#define WUFFS_DEFLATE__SLIDE_THRESHOLD 65274
+
+#define WUFFS_DEFLATE__TOO_FAR 4096
+
+static const uint32_t                      //
+    WUFFS_DEFLATE__LEVEL_GOOD_LENGTHS[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 4, 8, 8, 8, 32, 32,
+};
+
+static const uint32_t                  //
+    WUFFS_DEFLATE__LEVEL_MAX_LAZY[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 16, 258, 4, 16, 16, 32, 128, 258,
+};
+
+static const uint32_t                      //
+    WUFFS_DEFLATE__LEVEL_NICE_LENGTHS[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 16, 32, 128, 128, 258, 258,
+};
+
+static const uint32_t                    //
+    WUFFS_DEFLATE__LEVEL_MAX_CHAINS[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 16, 32, 128, 256, 1024, 4096,
+};
+
+static const uint8_t                  //
+    WUFFS_DEFLATE__LENGTH_CODES[256]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  5,  6,  7,  8,  8,  9,  9,  10, 10, 11, 11, 12, 12,
+        12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16,
+        16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18,
+        18, 18, 19, 19, 19, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20,
+        20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+        21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+        22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+        23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 28,
+};
+
+static const uint8_t                         //
+    WUFFS_DEFLATE__LENGTH_BASES_MINUS_3[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  5,  6,  7,   8,   10,  12,  14,  16,  20, 24, 28,
+        32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 255, 0,  0,  0,
+};
+
+static const uint8_t                  //
+    WUFFS_DEFLATE__LENGTH_EXTRAS[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0, 0, 0, 0,
+};
+
+static const uint8_t                    //
+    WUFFS_DEFLATE__DISTANCE_CODES[512]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  4,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,  8,  8,
+        8,  8,  8,  8,  8,  8,  9,  9,  9,  9,  9,  9,  9,  9,  10, 10, 10, 10,
+        10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 0,  0,  16, 17, 18, 18, 19, 19, 20, 20, 20, 20, 21, 21,
+        21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29,
+};
+
+static const uint16_t                          //
+    WUFFS_DEFLATE__DISTANCE_BASES_MINUS_1[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,    1,    2,    3,    4,    6,     8,     12,    16,  24,   32,
+        48,   64,   96,   128,  192,  256,   384,   512,   768, 1024, 1536,
+        2048, 3072, 4096, 6144, 8192, 12288, 16384, 24576, 0,   0,
+};
 
-#define WUFFS_DEFLATE__HUFFS_TABLE_MASK 1023
+static const uint8_t                    //
+    WUFFS_DEFLATE__DISTANCE_EXTRAS[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,  6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 0, 0,
+};
 
 // ---------------- Private Initializer Prototypes
 
@@ -13838,6 +18223,9 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
                                   uint32_t a_n_codes1,
                                   uint32_t a_base_symbol);
 
+static wuffs_base__empty_struct  //
+wuffs_deflate__decoder__init_double_literals(wuffs_deflate__decoder* self);
+
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
@@ -13848,22 +18236,120 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
                                             wuffs_base__io_buffer* a_src);
 
-// ---------------- VTables
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__start_stream(wuffs_deflate__encoder* self);
 
-const wuffs_base__io_transformer__func_ptrs
-    wuffs_deflate__decoder__func_ptrs_for__wuffs_base__io_transformer = {
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_deflate__decoder__set_quirk_enabled),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__slice_u8))(
-            &wuffs_deflate__decoder__transform_io),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_deflate__decoder__workbuf_len),
-};
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide(wuffs_deflate__encoder* self);
 
-// ---------------- Initializer Implementations
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__fill(wuffs_deflate__encoder* self,
+                             wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_literal(wuffs_deflate__encoder* self,
+                                    uint8_t a_lit);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_match(wuffs_deflate__encoder* self,
+                                  uint32_t a_length,
+                                  uint32_t a_distance);
+
+static uint32_t  //
+wuffs_deflate__encoder__count_matching(wuffs_deflate__encoder* self,
+                                       uint32_t a_a,
+                                       uint32_t a_b,
+                                       uint32_t a_max);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_none(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_fast(wuffs_deflate__encoder* self,
+                                      bool a_flush);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_lazy(wuffs_deflate__encoder* self,
+                                      bool a_flush);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_pos,
+                                      uint32_t a_cand,
+                                      uint32_t a_max,
+                                      uint32_t a_prev_length);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst,
+                                   uint32_t a_x,
+                                   uint32_t a_n);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_syms(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst);
+
+static uint32_t  //
+wuffs_deflate__encoder__choose_block_type(wuffs_deflate__encoder* self,
+                                          bool a_stored_ok);
+
+static uint32_t  //
+wuffs_deflate__encoder__lit_dist_len(const wuffs_deflate__encoder* self,
+                                     uint32_t a_k);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_cl_syms(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_cl_sym(wuffs_deflate__encoder* self,
+                                   uint32_t a_sym,
+                                   uint32_t a_extra);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_offset,
+                                      uint32_t a_n,
+                                      uint32_t a_max_len);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_offset,
+                                     uint32_t a_n);
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_deflate__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_deflate__decoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_deflate__decoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_deflate__decoder__workbuf_len),
+};
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_deflate__encoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_deflate__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_deflate__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
 
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
 wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
@@ -13935,6 +18421,76 @@ sizeof__wuffs_deflate__decoder() {
   return sizeof(wuffs_deflate__decoder);
 }
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_deflate__encoder*  //
+wuffs_deflate__encoder__alloc() {
+  wuffs_deflate__encoder* x =
+      (wuffs_deflate__encoder*)(calloc(sizeof(wuffs_deflate__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_deflate__encoder__initialize(x, sizeof(wuffs_deflate__encoder),
+                                         WUFFS_VERSION,
+                                         WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_deflate__encoder() {
+  return sizeof(wuffs_deflate__encoder);
+}
+
 // ---------------- Function Implementations
 
 // -------- func deflate.decoder.add_history
@@ -14001,9 +18557,77 @@ WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
 wuffs_deflate__decoder__set_quirk_enabled(wuffs_deflate__decoder* self,
                                           uint32_t a_quirk,
                                           bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_quirk >= 867177472) {
+    a_quirk -= 867177472;
+    if (a_quirk < 1) {
+      self->private_impl.f_quirks[a_quirk] = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.prime
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__prime(wuffs_deflate__decoder* self,
+                              uint32_t a_bits,
+                              uint32_t a_n_bits) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_n_bits > 7) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_bits =
+      ((a_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(a_n_bits));
+  self->private_impl.f_n_bits = a_n_bits;
   return wuffs_base__make_empty_struct();
 }
 
+// -------- func deflate.decoder.block_start_src_bit_position
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_src_bit_position(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_block_start_src_bit_pos;
+}
+
+// -------- func deflate.decoder.block_start_dst_position
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__block_start_dst_position(
+    const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_block_start_dst_pos;
+}
+
 // -------- func deflate.decoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
@@ -14083,6 +18707,11 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
         v_status = t_0;
       }
       if (!wuffs_base__status__is_suspension(&v_status)) {
+        if (wuffs_base__status__is_ok(&v_status)) {
+          self->private_impl.f_bits = 0;
+          self->private_impl.f_n_bits = 0;
+          self->private_impl.f_history_index = 0;
+        }
         status = v_status;
         if (wuffs_base__status__is_error(&status)) {
           goto exit;
@@ -14093,9 +18722,11 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
         }
         goto ok;
       }
-      wuffs_deflate__decoder__add_history(
-          self, wuffs_base__io__since(
-                    v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
+      if (!self->private_impl.f_quirks[0]) {
+        wuffs_deflate__decoder__add_history(
+            self, wuffs_base__io__since(
+                      v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
+      }
       status = v_status;
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
     }
@@ -14138,6 +18769,19 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
   uint32_t v_type = 0;
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
 
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -14158,6 +18802,13 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
 
   label__outer__continue:;
     while (v_final == 0) {
+      self->private_impl.f_block_start_src_bit_pos =
+          ((wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))) *
+            8) -
+           ((uint64_t)(self->private_impl.f_n_bits)));
+      self->private_impl.f_block_start_dst_pos = wuffs_base__u64__sat_add(
+          a_dst->meta.pos, ((uint64_t)(iop_a_dst - io0_a_dst)));
       while (self->private_impl.f_n_bits < 3) {
         {
           WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
@@ -14177,12 +18828,18 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
       self->private_impl.f_bits >>= 3;
       self->private_impl.f_n_bits -= 3;
       if (v_type == 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
         status =
             wuffs_deflate__decoder__decode_uncompressed(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
@@ -14221,11 +18878,17 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
       }
       self->private_impl.f_end_of_block = false;
       while (true) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
         v_status =
             wuffs_deflate__decoder__decode_huffman_fast(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
@@ -14236,12 +18899,18 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
         if (self->private_impl.f_end_of_block) {
           goto label__outer__continue;
         }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
         status =
             wuffs_deflate__decoder__decode_huffman_slow(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
@@ -14268,6 +18937,9 @@ suspend:
 
   goto exit;
 exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
@@ -14664,6 +19336,7 @@ wuffs_deflate__decoder__init_dynamic_huffman(wuffs_deflate__decoder* self,
       status = v_status;
       goto exit;
     }
+    wuffs_deflate__decoder__init_double_literals(self);
     v_status = wuffs_deflate__decoder__init_huff(self, 1, v_n_lit,
                                                  (v_n_lit + v_n_dist), 0);
     if (wuffs_base__status__is_error(&v_status)) {
@@ -14847,10 +19520,10 @@ label__0__break:;
     v_max_cl -= 1;
   }
 label__1__break:;
-  if (v_max_cl <= 9) {
+  if (v_max_cl <= 10) {
     self->private_impl.f_n_huffs_bits[a_which] = v_max_cl;
   } else {
-    self->private_impl.f_n_huffs_bits[a_which] = 9;
+    self->private_impl.f_n_huffs_bits[a_which] = 10;
   }
   v_i = 0;
   if ((v_n_symbols != ((uint32_t)(v_offsets[v_max_cl]))) ||
@@ -14862,8 +19535,8 @@ label__1__break:;
     return wuffs_base__make_status(
         wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
   }
-  v_initial_high_bits = 512;
-  if (v_max_cl < 9) {
+  v_initial_high_bits = 1024;
+  if (v_max_cl < 10) {
     v_initial_high_bits = (((uint32_t)(1)) << v_max_cl);
   }
   v_prev_cl = ((uint32_t)((self->private_data.f_code_lengths[(
@@ -14871,7 +19544,7 @@ label__1__break:;
                            15)));
   v_prev_redirect_key = 4294967295;
   v_top = 0;
-  v_next_top = 512;
+  v_next_top = 1024;
   v_code = 0;
   v_key = 0;
   v_value = 0;
@@ -14892,9 +19565,9 @@ label__1__break:;
     }
     v_prev_cl = v_cl;
     v_key = v_code;
-    if (v_cl > 9) {
-      v_cl -= 9;
-      v_redirect_key = ((v_key >> v_cl) & 511);
+    if (v_cl > 10) {
+      v_cl -= 10;
+      v_redirect_key = ((v_key >> v_cl) & 1023);
       v_key = ((v_key)&WUFFS_BASE__LOW_BITS_MASK__U32(v_cl));
       if (v_prev_redirect_key != v_redirect_key) {
         v_prev_redirect_key = v_redirect_key;
@@ -14913,26 +19586,27 @@ label__1__break:;
           v_j += 1;
         }
       label__2__break:;
-        if ((v_j <= 9) || (15 < v_j)) {
+        if ((v_j <= 10) || (15 < v_j)) {
           return wuffs_base__make_status(
               wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
         }
-        v_j -= 9;
+        v_j -= 10;
         v_initial_high_bits = (((uint32_t)(1)) << v_j);
         v_top = v_next_top;
-        if ((v_top + (((uint32_t)(1)) << v_j)) > 1024) {
+        if ((v_top + (((uint32_t)(1)) << v_j)) > 2048) {
           return wuffs_base__make_status(
               wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
         }
         v_next_top = (v_top + (((uint32_t)(1)) << v_j));
         v_redirect_key =
-            (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_redirect_key >> 1)])) |
-             ((v_redirect_key & 1) << 8));
+            (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_redirect_key >> 2)])) |
+             (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_redirect_key & 3)]))
+              << 2));
         self->private_data.f_huffs[a_which][v_redirect_key] =
-            (268435465 | (v_top << 8) | (v_j << 4));
+            (268435466 | (v_top << 8) | (v_j << 4));
       }
     }
-    if ((v_key >= 512) || (v_counts[v_prev_cl] <= 0)) {
+    if ((v_key >= 1024) || (v_counts[v_prev_cl] <= 0)) {
       return wuffs_base__make_status(
           wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
     }
@@ -14944,9 +19618,10 @@ label__1__break:;
 #if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
-    v_reversed_key = (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_key >> 1)])) |
-                      ((v_key & 1) << 8));
-    v_reversed_key >>= (9 - v_cl);
+    v_reversed_key =
+        (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_key >> 2)])) |
+         (((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_key & 3)])) << 2));
+    v_reversed_key >>= (10 - v_cl);
     v_symbol = ((uint32_t)(v_symbols[v_i]));
     if (v_symbol == 256) {
       v_value = (536870912 | v_cl);
@@ -14967,12 +19642,12 @@ label__1__break:;
     v_delta = (((uint32_t)(1)) << v_cl);
     while (v_high_bits >= v_delta) {
       v_high_bits -= v_delta;
-      if ((v_top + ((v_high_bits | v_reversed_key) & 511)) >= 1024) {
+      if ((v_top + ((v_high_bits | v_reversed_key) & 1023)) >= 2048) {
         return wuffs_base__make_status(
             wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
       }
       self->private_data
-          .f_huffs[a_which][(v_top + ((v_high_bits | v_reversed_key) & 511))] =
+          .f_huffs[a_which][(v_top + ((v_high_bits | v_reversed_key) & 1023))] =
           v_value;
     }
     v_i += 1;
@@ -14989,6 +19664,55 @@ label__3__break:;
   return wuffs_base__make_status(NULL);
 }
 
+// -------- func deflate.decoder.init_double_literals
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__decoder__init_double_literals(wuffs_deflate__decoder* self) {
+  uint32_t v_n_bits = 0;
+  uint32_t v_mask = 0;
+  uint32_t v_i = 0;
+  uint32_t v_first = 0;
+  uint32_t v_second = 0;
+  uint32_t v_n0 = 0;
+  uint32_t v_n1 = 0;
+
+  v_n_bits = self->private_impl.f_n_huffs_bits[0];
+  v_mask = ((((uint32_t)(1)) << v_n_bits) - 1);
+  if (v_n_bits < 10) {
+    v_i = (v_mask + 1);
+    while (v_i < 1024) {
+      self->private_data.f_huffs[0][v_i] =
+          self->private_data.f_huffs[0][(v_i & v_mask)];
+      v_i += 1;
+    }
+    v_n_bits = 10;
+    v_mask = 1023;
+    self->private_impl.f_n_huffs_bits[0] = 10;
+  }
+  v_i = (v_mask + 1);
+label__0__continue:;
+  while (v_i > 0) {
+    v_i -= 1;
+    v_first = self->private_data.f_huffs[0][v_i];
+    if ((v_first >> 24) != 128) {
+      goto label__0__continue;
+    }
+    v_n0 = (v_first & 15);
+    v_second = self->private_data.f_huffs[0][((v_i >> v_n0) & v_mask)];
+    if ((v_second >> 24) != 128) {
+      goto label__0__continue;
+    }
+    v_n1 = (v_second & 15);
+    if ((v_n0 + v_n1) > v_n_bits) {
+      goto label__0__continue;
+    }
+    self->private_data.f_huffs[0][v_i] =
+        ((v_first & 2147548928) | ((v_second & 65280) << 8) | (v_n0 << 4) |
+         (v_n0 + v_n1));
+  }
+  return wuffs_base__make_empty_struct();
+}
+
 // -------- func deflate.decoder.decode_huffman_fast
 
 static wuffs_base__status  //
@@ -14997,12 +19721,12 @@ wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_bits = 0;
+  uint64_t v_bits = 0;
   uint32_t v_n_bits = 0;
   uint32_t v_table_entry = 0;
   uint32_t v_table_entry_n_bits = 0;
-  uint32_t v_lmask = 0;
-  uint32_t v_dmask = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
   uint32_t v_redir_top = 0;
   uint32_t v_redir_mask = 0;
   uint32_t v_length = 0;
@@ -15040,56 +19764,60 @@ wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
         wuffs_deflate__error__internal_error_inconsistent_n_bits);
     goto exit;
   }
-  v_bits = self->private_impl.f_bits;
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
   v_n_bits = self->private_impl.f_n_bits;
-  v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
-  v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
 label__loop__continue:;
-  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 258) &&
-         (((uint64_t)(io2_a_src - iop_a_src)) >= 12)) {
-    if (v_n_bits < 15) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-    } else {
-    }
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 266) &&
+         (((uint64_t)(io2_a_src - iop_a_src)) >= 8)) {
+    v_bits |=
+        (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << (v_n_bits & 63));
+    (iop_a_src += ((63 - (v_n_bits & 63)) >> 3),
+     wuffs_base__make_empty_struct());
+    v_n_bits = ((v_n_bits & 63) | 56);
     v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
     v_table_entry_n_bits = (v_table_entry & 15);
     v_bits >>= v_table_entry_n_bits;
     v_n_bits -= v_table_entry_n_bits;
     if ((v_table_entry >> 31) != 0) {
-      (wuffs_base__store_u8be__no_bounds_check(
-           iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
-       iop_a_dst += 1, wuffs_base__make_empty_struct());
+      if ((v_table_entry & 240) == 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+      } else {
+        (wuffs_base__store_u16le__no_bounds_check(
+             iop_a_dst, ((uint16_t)(((v_table_entry >> 8) & 65535)))),
+         iop_a_dst += 2, wuffs_base__make_empty_struct());
+      }
+      v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+      if (((v_table_entry >> 31) == 0) ||
+          (((uint64_t)(io2_a_dst - iop_a_dst)) < 2)) {
+        goto label__loop__continue;
+      }
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry & 240) == 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+      } else {
+        (wuffs_base__store_u16le__no_bounds_check(
+             iop_a_dst, ((uint16_t)(((v_table_entry >> 8) & 65535)))),
+         iop_a_dst += 2, wuffs_base__make_empty_struct());
+      }
       goto label__loop__continue;
     } else if ((v_table_entry >> 30) != 0) {
     } else if ((v_table_entry >> 29) != 0) {
       self->private_impl.f_end_of_block = true;
       goto label__loop__break;
     } else if ((v_table_entry >> 28) != 0) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
       v_redir_top = ((v_table_entry >> 8) & 65535);
       v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-      v_table_entry =
-          self->private_data
-              .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+      v_table_entry = self->private_data.f_huffs[0][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          2047)];
       v_table_entry_n_bits = (v_table_entry & 15);
       v_bits >>= v_table_entry_n_bits;
       v_n_bits -= v_table_entry_n_bits;
@@ -15126,66 +19854,27 @@ label__loop__continue:;
     v_length = (((v_table_entry >> 8) & 255) + 3);
     v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
     if (v_table_entry_n_bits > 0) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
-      v_length =
-          (((v_length + 253 +
-             ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
-            255) +
-           3);
+      v_length = (((v_length + 253 +
+                    ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                        v_table_entry_n_bits))))) &
+                   255) +
+                  3);
       v_bits >>= v_table_entry_n_bits;
       v_n_bits -= v_table_entry_n_bits;
-    } else {
-    }
-    if (v_n_bits < 15) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-    } else {
     }
     v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
     v_table_entry_n_bits = (v_table_entry & 15);
     v_bits >>= v_table_entry_n_bits;
     v_n_bits -= v_table_entry_n_bits;
     if ((v_table_entry >> 28) == 1) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
       v_redir_top = ((v_table_entry >> 8) & 65535);
       v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-      v_table_entry =
-          self->private_data
-              .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+      v_table_entry = self->private_data.f_huffs[1][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          2047)];
       v_table_entry_n_bits = (v_table_entry & 15);
       v_bits >>= v_table_entry_n_bits;
       v_n_bits -= v_table_entry_n_bits;
-    } else {
     }
     if ((v_table_entry >> 24) != 64) {
       if ((v_table_entry >> 24) == 8) {
@@ -15199,19 +19888,9 @@ label__loop__continue:;
     }
     v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
     v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
-    if (v_n_bits < v_table_entry_n_bits) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-    }
     v_dist_minus_1 =
-        ((v_dist_minus_1 +
-          ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
+        ((v_dist_minus_1 + ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                               v_table_entry_n_bits))))) &
          32767);
     v_bits >>= v_table_entry_n_bits;
     v_n_bits -= v_table_entry_n_bits;
@@ -15248,7 +19927,7 @@ label__loop__continue:;
           goto exit;
         }
       }
-      wuffs_base__io_writer__copy_n32_from_history_fast(
+      wuffs_base__io_writer__copy_n32_from_history_8_byte_chunks_fast(
           &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
       goto label__0__break;
     }
@@ -15265,7 +19944,8 @@ label__loop__break:;
       goto exit;
     }
   }
-  self->private_impl.f_bits = (v_bits & ((((uint32_t)(1)) << v_n_bits) - 1));
+  self->private_impl.f_bits =
+      ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
   self->private_impl.f_n_bits = v_n_bits;
   if ((self->private_impl.f_n_bits >= 8) ||
       ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
@@ -15371,6 +20051,10 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
     while (!(self->private_impl.p_decode_huffman_slow[0] != 0)) {
       while (true) {
         v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+        if (((v_table_entry >> 31) != 0) && ((v_table_entry & 240) != 0)) {
+          v_table_entry =
+              ((v_table_entry & 2147548928) | ((v_table_entry >> 4) & 15));
+        }
         v_table_entry_n_bits = (v_table_entry & 15);
         if (v_n_bits >= v_table_entry_n_bits) {
           v_bits >>= v_table_entry_n_bits;
@@ -15412,7 +20096,7 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
         while (true) {
           v_table_entry =
               self->private_data
-                  .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+                  .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 2047)];
           v_table_entry_n_bits = (v_table_entry & 15);
           if (v_n_bits >= v_table_entry_n_bits) {
             v_bits >>= v_table_entry_n_bits;
@@ -15524,7 +20208,7 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
         while (true) {
           v_table_entry =
               self->private_data
-                  .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+                  .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 2047)];
           v_table_entry_n_bits = (v_table_entry & 15);
           if (v_n_bits >= v_table_entry_n_bits) {
             v_bits >>= v_table_entry_n_bits;
@@ -15704,152 +20388,39 @@ exit:
   return status;
 }
 
-#endif  // !defined(WUFFS_CONFIG__MODULES) ||
-        // defined(WUFFS_CONFIG__MODULE__DEFLATE)
-
-#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
-
-// ---------------- Status Codes Implementations
-
-const char* wuffs_lzw__error__bad_code = "#lzw: bad code";
-const char* wuffs_lzw__error__internal_error_inconsistent_i_o =
-    "#lzw: internal error: inconsistent I/O";
-
-// ---------------- Private Consts
-
-// ---------------- Private Initializer Prototypes
-
-// ---------------- Private Function Prototypes
-
-static wuffs_base__empty_struct  //
-wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
-                              wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
-                             wuffs_base__io_buffer* a_dst);
-
-// ---------------- VTables
-
-const wuffs_base__io_transformer__func_ptrs
-    wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer = {
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_lzw__decoder__set_quirk_enabled),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__slice_u8))(
-            &wuffs_lzw__decoder__transform_io),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_lzw__decoder__workbuf_len),
-};
-
-// ---------------- Initializer Implementations
-
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
-                               size_t sizeof_star_self,
-                               uint64_t wuffs_version,
-                               uint32_t initialize_flags) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
-  }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
-  }
-
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-    if (self->private_impl.magic != 0) {
-      return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
-    }
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
-    } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
-    }
-  }
-
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
-}
-
-wuffs_lzw__decoder*  //
-wuffs_lzw__decoder__alloc() {
-  wuffs_lzw__decoder* x =
-      (wuffs_lzw__decoder*)(calloc(sizeof(wuffs_lzw__decoder), 1));
-  if (!x) {
-    return NULL;
-  }
-  if (wuffs_lzw__decoder__initialize(x, sizeof(wuffs_lzw__decoder),
-                                     WUFFS_VERSION,
-                                     WUFFS_INITIALIZE__ALREADY_ZEROED)
-          .repr) {
-    free(x);
-    return NULL;
-  }
-  return x;
-}
-
-size_t  //
-sizeof__wuffs_lzw__decoder() {
-  return sizeof(wuffs_lzw__decoder);
-}
-
-// ---------------- Function Implementations
-
-// -------- func lzw.decoder.set_quirk_enabled
+// -------- func deflate.encoder.set_quirk_enabled
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_lzw__decoder__set_quirk_enabled(wuffs_lzw__decoder* self,
-                                      uint32_t a_quirk,
-                                      bool a_enabled) {
+wuffs_deflate__encoder__set_quirk_enabled(wuffs_deflate__encoder* self,
+                                          uint32_t a_quirk,
+                                          bool a_enabled) {
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func lzw.decoder.set_literal_width
+// -------- func deflate.encoder.set_level
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_lzw__decoder__set_literal_width(wuffs_lzw__decoder* self, uint32_t a_lw) {
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self,
+                                  uint32_t a_level) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
   if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
     return wuffs_base__make_empty_struct();
   }
-  if (a_lw > 8) {
+  if (a_level > 9) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_empty_struct();
   }
 
-  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
+  self->private_impl.f_set_level_arg = (a_level + 1);
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func lzw.decoder.workbuf_len
+// -------- func deflate.encoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self) {
   if (!self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
@@ -15861,13 +20432,13 @@ wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
   return wuffs_base__utility__make_range_ii_u64(0, 0);
 }
 
-// -------- func lzw.decoder.transform_io
+// -------- func deflate.encoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
-                                 wuffs_base__io_buffer* a_dst,
-                                 wuffs_base__io_buffer* a_src,
-                                 wuffs_base__slice_u8 a_workbuf) {
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -15890,60 +20461,66 @@ wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_i = 0;
+  bool v_flush = false;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
 
   uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_literal_width = 8;
-    if (self->private_impl.f_set_literal_width_arg > 0) {
-      self->private_impl.f_literal_width =
-          (self->private_impl.f_set_literal_width_arg - 1);
-    }
-    self->private_impl.f_clear_code =
-        (((uint32_t)(1)) << self->private_impl.f_literal_width);
-    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
-    self->private_impl.f_save_code = self->private_impl.f_end_code;
-    self->private_impl.f_prev_code = self->private_impl.f_end_code;
-    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
-    self->private_impl.f_bits = 0;
-    self->private_impl.f_n_bits = 0;
-    self->private_impl.f_output_ri = 0;
-    self->private_impl.f_output_wi = 0;
-    v_i = 0;
-    while (v_i < self->private_impl.f_clear_code) {
-      self->private_data.f_lm1s[v_i] = 0;
-      self->private_data.f_suffixes[v_i][0] = ((uint8_t)(v_i));
-      v_i += 1;
-    }
-  label__0__continue:;
+    wuffs_deflate__encoder__start_stream(self);
     while (true) {
-      wuffs_lzw__decoder__read_from(self, a_src);
-      if (self->private_impl.f_output_wi > 0) {
+      if (self->private_impl.f_strstart >= 65274) {
+        wuffs_deflate__encoder__slide(self);
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      wuffs_deflate__encoder__fill(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      v_flush = ((a_src && a_src->meta.closed) &&
+                 (((uint64_t)(io2_a_src - iop_a_src)) == 0));
+      if (self->private_impl.f_level == 0) {
+        wuffs_deflate__encoder__compress_none(self);
+      } else if (self->private_impl.f_level <= 3) {
+        wuffs_deflate__encoder__compress_fast(self, v_flush);
+      } else {
+        wuffs_deflate__encoder__compress_lazy(self, v_flush);
+      }
+      if (self->private_impl.f_n_syms >= 16384) {
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status = wuffs_lzw__decoder__write_to(self, a_dst);
+        status = wuffs_deflate__encoder__write_block(self, a_dst, false);
         if (status.repr) {
           goto suspend;
         }
-      }
-      if (self->private_impl.f_read_from_return_value == 0) {
-        goto label__0__break;
-      } else if (self->private_impl.f_read_from_return_value == 1) {
-        goto label__0__continue;
-      } else if (self->private_impl.f_read_from_return_value == 2) {
+      } else if (v_flush &&
+                 (self->private_impl.f_strstart >=
+                  self->private_impl.f_w_end) &&
+                 !self->private_impl.f_match_available) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__write_block(self, a_dst, true);
+        if (status.repr) {
+          goto suspend;
+        }
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if (self->private_impl.f_w_end < 65536) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
-      } else if (self->private_impl.f_read_from_return_value == 3) {
-        status = wuffs_base__make_status(wuffs_lzw__error__bad_code);
-        goto exit;
-      } else {
-        status = wuffs_base__make_status(
-            wuffs_lzw__error__internal_error_inconsistent_i_o);
-        goto exit;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
       }
     }
-  label__0__break:;
 
     goto ok;
   ok:
@@ -15960,32 +20537,93 @@ suspend:
 
   goto exit;
 exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
   if (wuffs_base__status__is_error(&status)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
   return status;
 }
 
-// -------- func lzw.decoder.read_from
+// -------- func deflate.encoder.start_stream
 
 static wuffs_base__empty_struct  //
-wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
-                              wuffs_base__io_buffer* a_src) {
-  uint32_t v_clear_code = 0;
-  uint32_t v_end_code = 0;
-  uint32_t v_save_code = 0;
-  uint32_t v_prev_code = 0;
-  uint32_t v_width = 0;
-  uint32_t v_bits = 0;
-  uint32_t v_n_bits = 0;
-  uint32_t v_output_wi = 0;
-  uint32_t v_code = 0;
-  uint32_t v_c = 0;
-  uint32_t v_o = 0;
-  uint32_t v_steps = 0;
-  uint8_t v_first_byte = 0;
-  uint16_t v_lm1_b = 0;
-  uint16_t v_lm1_a = 0;
+wuffs_deflate__encoder__start_stream(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  self->private_impl.f_level = 6;
+  if (self->private_impl.f_set_level_arg > 0) {
+    self->private_impl.f_level = (self->private_impl.f_set_level_arg - 1);
+  }
+  self->private_impl.f_good_length =
+      WUFFS_DEFLATE__LEVEL_GOOD_LENGTHS[self->private_impl.f_level];
+  self->private_impl.f_max_lazy =
+      WUFFS_DEFLATE__LEVEL_MAX_LAZY[self->private_impl.f_level];
+  self->private_impl.f_nice_length =
+      WUFFS_DEFLATE__LEVEL_NICE_LENGTHS[self->private_impl.f_level];
+  self->private_impl.f_max_chain =
+      WUFFS_DEFLATE__LEVEL_MAX_CHAINS[self->private_impl.f_level];
+  self->private_impl.f_bits = 0;
+  self->private_impl.f_n_bits = 0;
+  self->private_impl.f_strstart = 0;
+  self->private_impl.f_w_end = 0;
+  self->private_impl.f_match_length = 0;
+  self->private_impl.f_match_distance = 0;
+  self->private_impl.f_match_available = false;
+  self->private_impl.f_n_syms = 0;
+  self->private_impl.f_block_len = 0;
+  v_i = 0;
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 512) {
+    self->private_data.f_freqs[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.slide
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  if ((self->private_impl.f_strstart < 32768) ||
+      (self->private_impl.f_w_end < 32768)) {
+    return wuffs_base__make_empty_struct();
+  }
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_j(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65808), 32768),
+      wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65808), 32768,
+          self->private_impl.f_w_end));
+  self->private_impl.f_strstart -= 32768;
+  self->private_impl.f_w_end -= 32768;
+  v_i = 0;
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] =
+        wuffs_base__u16__sat_sub(self->private_data.f_head[v_i], 32768);
+    self->private_data.f_prev[v_i] =
+        wuffs_base__u16__sat_sub(self->private_data.f_prev[v_i], 32768);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.fill
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__fill(wuffs_deflate__encoder* self,
+                             wuffs_base__io_buffer* a_src) {
+  uint64_t v_room = 0;
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15998,177 +20636,448 @@ wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  v_clear_code = self->private_impl.f_clear_code;
-  v_end_code = self->private_impl.f_end_code;
-  v_save_code = self->private_impl.f_save_code;
-  v_prev_code = self->private_impl.f_prev_code;
-  v_width = self->private_impl.f_width;
-  v_bits = self->private_impl.f_bits;
-  v_n_bits = self->private_impl.f_n_bits;
-  v_output_wi = self->private_impl.f_output_wi;
-  while (true) {
-    if (v_n_bits < v_width) {
-      if (((uint64_t)(io2_a_src - iop_a_src)) >= 4) {
-        v_bits |=
-            (wuffs_base__load_u32le__no_bounds_check(iop_a_src) << v_n_bits);
-        (iop_a_src += ((31 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
-        v_n_bits |= 24;
-      } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        self->private_impl.f_read_from_return_value = 2;
-        goto label__0__break;
-      } else {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        if (v_n_bits >= v_width) {
-        } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          self->private_impl.f_read_from_return_value = 2;
-          goto label__0__break;
-        } else {
-          v_bits |=
-              (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-               << v_n_bits);
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
-          v_n_bits += 8;
-          if (v_n_bits < v_width) {
-            self->private_impl.f_read_from_return_value = 4;
-            goto label__0__break;
-          }
-        }
-      }
+  v_room = ((uint64_t)((65536 - self->private_impl.f_w_end)));
+  v_s = wuffs_base__io_reader__take(
+      &iop_a_src, io2_a_src,
+      wuffs_base__u64__min(v_room, ((uint64_t)(io2_a_src - iop_a_src))));
+  v_n = wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65808),
+          self->private_impl.f_w_end, 65536),
+      v_s);
+  v_n += ((uint64_t)(self->private_impl.f_w_end));
+  self->private_impl.f_w_end = ((uint32_t)(wuffs_base__u64__min(v_n, 65536)));
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_literal
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_literal(wuffs_deflate__encoder* self,
+                                    uint8_t a_lit) {
+  self->private_data.f_syms[(self->private_impl.f_n_syms & 16383)] =
+      ((uint32_t)(a_lit));
+  self->private_data.f_freqs[a_lit] += 1;
+  if (self->private_impl.f_n_syms < 16384) {
+    self->private_impl.f_n_syms += 1;
+  }
+  self->private_impl.f_block_len += 1;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.add_match
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_match(wuffs_deflate__encoder* self,
+                                  uint32_t a_length,
+                                  uint32_t a_distance) {
+  uint32_t v_l = 0;
+  uint32_t v_d = 0;
+
+  v_l = wuffs_base__u32__sat_sub(a_length, 3);
+  v_d = wuffs_base__u32__sat_sub(a_distance, 1);
+  self->private_data.f_syms[(self->private_impl.f_n_syms & 16383)] =
+      (2147483648 | (v_d << 8) | v_l);
+  self->private_data
+      .f_freqs[(257 + ((uint32_t)(WUFFS_DEFLATE__LENGTH_CODES[v_l])))] += 1;
+  if (v_d < 256) {
+    self->private_data
+        .f_freqs[(288 + ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[v_d])))] += 1;
+  } else {
+    self->private_data.f_freqs[(
+        288 +
+        ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[(256 + (v_d >> 7))])))] += 1;
+  }
+  if (self->private_impl.f_n_syms < 16384) {
+    self->private_impl.f_n_syms += 1;
+  }
+  self->private_impl.f_block_len += a_length;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.count_matching
+
+static uint32_t  //
+wuffs_deflate__encoder__count_matching(wuffs_deflate__encoder* self,
+                                       uint32_t a_a,
+                                       uint32_t a_b,
+                                       uint32_t a_max) {
+  uint32_t v_n = 0;
+  uint32_t v_m = 0;
+
+  v_m = wuffs_base__u32__sat_sub(a_max, 3);
+  while (v_n < v_m) {
+    if ((((uint32_t)(self->private_data.f_window[(a_a + v_n)])) |
+         (((uint32_t)(self->private_data.f_window[(a_a + v_n + 1)])) << 8) |
+         (((uint32_t)(self->private_data.f_window[(a_a + v_n + 2)])) << 16) |
+         (((uint32_t)(self->private_data.f_window[(a_a + v_n + 3)])) << 24)) !=
+        (((uint32_t)(self->private_data.f_window[(a_b + v_n)])) |
+         (((uint32_t)(self->private_data.f_window[(a_b + v_n + 1)])) << 8) |
+         (((uint32_t)(self->private_data.f_window[(a_b + v_n + 2)])) << 16) |
+         (((uint32_t)(self->private_data.f_window[(a_b + v_n + 3)])) << 24))) {
+      goto label__0__break;
     }
-    v_code = ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_width));
-    v_bits >>= v_width;
-    v_n_bits -= v_width;
-    if (v_code < v_clear_code) {
-      self->private_data.f_output[v_output_wi] = ((uint8_t)(v_code));
-      v_output_wi = ((v_output_wi + 1) & 8191);
-      if (v_save_code <= 4095) {
-        v_lm1_a = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
-        self->private_data.f_lm1s[v_save_code] = v_lm1_a;
-        if ((v_lm1_a % 8) != 0) {
-          self->private_impl.f_prefixes[v_save_code] =
-              self->private_impl.f_prefixes[v_prev_code];
-          memcpy(self->private_data.f_suffixes[v_save_code],
-                 self->private_data.f_suffixes[v_prev_code],
-                 sizeof(self->private_data.f_suffixes[v_save_code]));
-          self->private_data.f_suffixes[v_save_code][(v_lm1_a % 8)] =
-              ((uint8_t)(v_code));
-        } else {
-          self->private_impl.f_prefixes[v_save_code] =
-              ((uint16_t)(v_prev_code));
-          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_code));
-        }
-        v_save_code += 1;
-        if (v_width < 12) {
-          v_width += (1 & (v_save_code >> v_width));
+    v_n += 4;
+  }
+label__0__break:;
+  while (v_n < a_max) {
+    if (self->private_data.f_window[(a_a + v_n)] !=
+        self->private_data.f_window[(a_b + v_n)]) {
+      goto label__1__break;
+    }
+    v_n += 1;
+  }
+label__1__break:;
+  return v_n;
+}
+
+// -------- func deflate.encoder.compress_none
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_none(wuffs_deflate__encoder* self) {
+  uint32_t v_pos = 0;
+
+  while ((self->private_impl.f_strstart < self->private_impl.f_w_end) &&
+         (self->private_impl.f_n_syms < 16384)) {
+    v_pos = (self->private_impl.f_strstart & 65535);
+    wuffs_deflate__encoder__add_literal(self,
+                                        self->private_data.f_window[v_pos]);
+    self->private_impl.f_strstart = (v_pos + 1);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.compress_fast
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_fast(wuffs_deflate__encoder* self,
+                                      bool a_flush) {
+  uint32_t v_lookahead = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_x = 0;
+  uint32_t v_h = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_dist = 0;
+  uint32_t v_max = 0;
+  uint32_t v_length = 0;
+  uint32_t v_q = 0;
+  uint32_t v_q_end = 0;
+
+label__0__continue:;
+  while ((self->private_impl.f_strstart < self->private_impl.f_w_end) &&
+         (self->private_impl.f_n_syms < 16384)) {
+    v_lookahead = (self->private_impl.f_w_end - self->private_impl.f_strstart);
+    if ((v_lookahead < 262) && !a_flush) {
+      goto label__0__break;
+    }
+    v_pos = (self->private_impl.f_strstart & 65535);
+    if (v_lookahead < 4) {
+      wuffs_deflate__encoder__add_literal(self,
+                                          self->private_data.f_window[v_pos]);
+      self->private_impl.f_strstart = (v_pos + 1);
+      goto label__0__continue;
+    }
+    v_x = (((uint32_t)(self->private_data.f_window[v_pos])) |
+           (((uint32_t)(self->private_data.f_window[(v_pos + 1)])) << 8) |
+           (((uint32_t)(self->private_data.f_window[(v_pos + 2)])) << 16) |
+           (((uint32_t)(self->private_data.f_window[(v_pos + 3)])) << 24));
+    v_h = ((v_x * 506832829) >> 17);
+    v_cand = ((uint32_t)(self->private_data.f_head[v_h]));
+    self->private_data.f_head[v_h] = ((uint16_t)(v_pos));
+    v_length = 0;
+    v_dist = (v_pos - v_cand);
+    if ((v_cand < v_pos) && (v_dist <= 32768)) {
+      v_max = wuffs_base__u32__min(v_lookahead, 258);
+      v_length =
+          wuffs_deflate__encoder__count_matching(self, v_cand, v_pos, v_max);
+    }
+    if (v_length < 4) {
+      wuffs_deflate__encoder__add_literal(self,
+                                          self->private_data.f_window[v_pos]);
+      self->private_impl.f_strstart = (v_pos + 1);
+      goto label__0__continue;
+    }
+    wuffs_deflate__encoder__add_match(self, v_length,
+                                      wuffs_base__u32__min(v_dist, 32768));
+    if (v_length <= self->private_impl.f_max_lazy) {
+      v_q = v_pos;
+      v_q_end = (v_pos + v_length);
+      while ((v_q + 1) < v_q_end) {
+        if (v_q >= 65535) {
+          goto label__1__break;
         }
-        v_prev_code = v_code;
-      }
-    } else if (v_code <= v_end_code) {
-      if (v_code == v_end_code) {
-        self->private_impl.f_read_from_return_value = 0;
-        goto label__0__break;
-      }
-      v_save_code = v_end_code;
-      v_prev_code = v_end_code;
-      v_width = (self->private_impl.f_literal_width + 1);
-    } else if (v_code <= v_save_code) {
-      v_c = v_code;
-      if (v_code == v_save_code) {
-        v_c = v_prev_code;
-      }
-      v_o = ((v_output_wi +
-              (((uint32_t)(self->private_data.f_lm1s[v_c])) & 4294967288)) &
-             8191);
-      v_output_wi =
-          ((v_output_wi + 1 + ((uint32_t)(self->private_data.f_lm1s[v_c]))) &
-           8191);
-      v_steps = (((uint32_t)(self->private_data.f_lm1s[v_c])) >> 3);
-      while (true) {
-        memcpy((self->private_data.f_output) + (v_o),
-               (self->private_data.f_suffixes[v_c]), 8);
-        if (v_steps <= 0) {
+        v_q += 1;
+        if ((v_q + 3) >= self->private_impl.f_w_end) {
           goto label__1__break;
         }
-        v_steps -= 1;
-        v_o = ((v_o - 8) & 8191);
-        v_c = ((uint32_t)(self->private_impl.f_prefixes[v_c]));
+        v_x = (((uint32_t)(self->private_data.f_window[v_q])) |
+               (((uint32_t)(self->private_data.f_window[(v_q + 1)])) << 8) |
+               (((uint32_t)(self->private_data.f_window[(v_q + 2)])) << 16) |
+               (((uint32_t)(self->private_data.f_window[(v_q + 3)])) << 24));
+        self->private_data.f_head[((v_x * 506832829) >> 17)] =
+            ((uint16_t)(v_q));
       }
     label__1__break:;
-      v_first_byte = self->private_data.f_suffixes[v_c][0];
-      if (v_code == v_save_code) {
-        self->private_data.f_output[v_output_wi] = v_first_byte;
-        v_output_wi = ((v_output_wi + 1) & 8191);
-      }
-      if (v_save_code <= 4095) {
-        v_lm1_b = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
-        self->private_data.f_lm1s[v_save_code] = v_lm1_b;
-        if ((v_lm1_b % 8) != 0) {
-          self->private_impl.f_prefixes[v_save_code] =
-              self->private_impl.f_prefixes[v_prev_code];
-          memcpy(self->private_data.f_suffixes[v_save_code],
-                 self->private_data.f_suffixes[v_prev_code],
-                 sizeof(self->private_data.f_suffixes[v_save_code]));
-          self->private_data.f_suffixes[v_save_code][(v_lm1_b % 8)] =
-              v_first_byte;
-        } else {
-          self->private_impl.f_prefixes[v_save_code] =
-              ((uint16_t)(v_prev_code));
-          self->private_data.f_suffixes[v_save_code][0] =
-              ((uint8_t)(v_first_byte));
+    }
+    v_q_end = (v_pos + v_length);
+    self->private_impl.f_strstart = wuffs_base__u32__min(v_q_end, 65536);
+  }
+label__0__break:;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.compress_lazy
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__compress_lazy(wuffs_deflate__encoder* self,
+                                      bool a_flush) {
+  uint32_t v_lookahead = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_h = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_dist = 0;
+  uint32_t v_prev_length = 0;
+  uint32_t v_prev_dist = 0;
+  uint32_t v_max = 0;
+  uint32_t v_q = 0;
+  uint32_t v_q_end = 0;
+
+  while ((self->private_impl.f_strstart < self->private_impl.f_w_end) &&
+         (self->private_impl.f_n_syms < 16384)) {
+    v_lookahead = (self->private_impl.f_w_end - self->private_impl.f_strstart);
+    if ((v_lookahead < 262) && !a_flush) {
+      goto label__0__break;
+    }
+    v_pos = (self->private_impl.f_strstart & 65535);
+    v_cand = 0;
+    if (v_lookahead >= 3) {
+      v_h = (((((uint32_t)(self->private_data.f_window[v_pos])) |
+               (((uint32_t)(self->private_data.f_window[(v_pos + 1)])) << 8) |
+               (((uint32_t)(self->private_data.f_window[(v_pos + 2)])) << 16)) *
+              506832829) >>
+             17);
+      v_cand = ((uint32_t)(self->private_data.f_head[v_h]));
+      self->private_data.f_prev[(v_pos & 32767)] = ((uint16_t)(v_cand));
+      self->private_data.f_head[v_h] = ((uint16_t)(v_pos));
+    }
+    v_prev_length = self->private_impl.f_match_length;
+    v_prev_dist = self->private_impl.f_match_distance;
+    self->private_impl.f_match_length = 0;
+    v_dist = (v_pos - v_cand);
+    if ((v_lookahead >= 3) && (v_prev_length < self->private_impl.f_max_lazy) &&
+        (v_cand < v_pos) && (v_dist <= 32768)) {
+      v_max = wuffs_base__u32__min(v_lookahead, 258);
+      wuffs_deflate__encoder__longest_match(self, v_pos, v_cand, v_max,
+                                            v_prev_length);
+      if ((self->private_impl.f_match_length == 3) &&
+          (self->private_impl.f_match_distance > 4096)) {
+        self->private_impl.f_match_length = 0;
+      }
+    }
+    if ((v_prev_length >= 3) &&
+        (self->private_impl.f_match_length <= v_prev_length) &&
+        (v_prev_dist > 0)) {
+      wuffs_deflate__encoder__add_match(self, v_prev_length, v_prev_dist);
+      v_q = v_pos;
+      v_q_end = ((v_pos + v_prev_length) - 1);
+      while ((v_q + 1) < v_q_end) {
+        if (v_q >= 65535) {
+          goto label__1__break;
         }
-        v_save_code += 1;
-        if (v_width < 12) {
-          v_width += (1 & (v_save_code >> v_width));
+        v_q += 1;
+        if ((v_q + 2) >= self->private_impl.f_w_end) {
+          goto label__1__break;
         }
-        v_prev_code = v_code;
+        v_h = (((((uint32_t)(self->private_data.f_window[v_q])) |
+                 (((uint32_t)(self->private_data.f_window[(v_q + 1)])) << 8) |
+                 (((uint32_t)(self->private_data.f_window[(v_q + 2)])) << 16)) *
+                506832829) >>
+               17);
+        self->private_data.f_prev[(v_q & 32767)] =
+            self->private_data.f_head[v_h];
+        self->private_data.f_head[v_h] = ((uint16_t)(v_q));
       }
+    label__1__break:;
+      self->private_impl.f_match_available = false;
+      self->private_impl.f_match_length = 0;
+      v_q_end = ((v_pos + v_prev_length) - 1);
+      self->private_impl.f_strstart = wuffs_base__u32__min(v_q_end, 65536);
+    } else if (self->private_impl.f_match_available) {
+      if (v_pos > 0) {
+        wuffs_deflate__encoder__add_literal(
+            self, self->private_data.f_window[(v_pos - 1)]);
+      }
+      self->private_impl.f_strstart = (v_pos + 1);
     } else {
-      self->private_impl.f_read_from_return_value = 3;
+      self->private_impl.f_match_available = true;
+      self->private_impl.f_strstart = (v_pos + 1);
+    }
+  }
+label__0__break:;
+  if (a_flush && self->private_impl.f_match_available &&
+      (self->private_impl.f_strstart >= self->private_impl.f_w_end) &&
+      (self->private_impl.f_n_syms < 16384) &&
+      (self->private_impl.f_strstart > 0)) {
+    wuffs_deflate__encoder__add_literal(
+        self, self->private_data
+                  .f_window[((self->private_impl.f_strstart - 1) & 65535)]);
+    self->private_impl.f_match_available = false;
+    self->private_impl.f_match_length = 0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.longest_match
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_pos,
+                                      uint32_t a_cand,
+                                      uint32_t a_max,
+                                      uint32_t a_prev_length) {
+  uint32_t v_chain = 0;
+  uint32_t v_limit = 0;
+  uint32_t v_nice = 0;
+  uint32_t v_best_len = 0;
+  uint32_t v_cur = 0;
+  uint32_t v_next = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist = 0;
+
+  v_chain = self->private_impl.f_max_chain;
+  if (a_prev_length >= self->private_impl.f_good_length) {
+    v_chain >>= 2;
+  }
+  v_limit = wuffs_base__u32__sat_sub(a_pos, 32768);
+  v_nice = wuffs_base__u32__min(self->private_impl.f_nice_length, a_max);
+  v_best_len = wuffs_base__u32__max(a_prev_length, 2);
+  v_cur = a_cand;
+  while (v_chain > 0) {
+    v_chain -= 1;
+    if ((v_best_len >= a_max) || (v_cur >= a_pos)) {
       goto label__0__break;
     }
-    if (v_output_wi > 4095) {
-      self->private_impl.f_read_from_return_value = 1;
+    if ((self->private_data.f_window[(v_cur + v_best_len)] ==
+         self->private_data.f_window[(a_pos + v_best_len)]) &&
+        (self->private_data.f_window[v_cur] ==
+         self->private_data.f_window[a_pos])) {
+      v_length =
+          wuffs_deflate__encoder__count_matching(self, v_cur, a_pos, a_max);
+      if (v_length > v_best_len) {
+        v_best_len = v_length;
+        self->private_impl.f_match_length = v_length;
+        v_dist = (a_pos - v_cur);
+        self->private_impl.f_match_distance =
+            wuffs_base__u32__min(v_dist, 32768);
+        if (v_length >= v_nice) {
+          goto label__0__break;
+        }
+      }
+    }
+    v_next = ((uint32_t)(self->private_data.f_prev[(v_cur & 32767)]));
+    if ((v_next >= v_cur) || (v_next <= v_limit)) {
       goto label__0__break;
     }
+    v_cur = v_next;
   }
 label__0__break:;
-  if (self->private_impl.f_read_from_return_value != 2) {
-    while (v_n_bits >= 8) {
-      v_n_bits -= 8;
-      if (iop_a_src > io1_a_src) {
-        (iop_a_src--, wuffs_base__make_empty_struct());
-      } else {
-        self->private_impl.f_read_from_return_value = 4;
-        goto label__2__break;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.write_bits
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst,
+                                   uint32_t a_x,
+                                   uint32_t a_n) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_bits[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_write_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
       }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
     }
-  label__2__break:;
+    self->private_impl.f_bits |=
+        (((uint64_t)((a_x & 65535))) << (self->private_impl.f_n_bits & 63));
+    self->private_impl.f_n_bits = ((self->private_impl.f_n_bits & 7) + a_n);
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_write_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_bits[0] = 0;
+    goto exit;
   }
-  self->private_impl.f_save_code = v_save_code;
-  self->private_impl.f_prev_code = v_prev_code;
-  self->private_impl.f_width = v_width;
-  self->private_impl.f_bits = v_bits;
-  self->private_impl.f_n_bits = v_n_bits;
-  self->private_impl.f_output_wi = v_output_wi;
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_bits[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
-  return wuffs_base__make_empty_struct();
+  return status;
 }
 
-// -------- func lzw.decoder.write_to
+// -------- func deflate.encoder.write_block
 
 static wuffs_base__status  //
-wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
-                             wuffs_base__io_buffer* a_dst) {
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_block_end = 0;
+  uint32_t v_block_start = 0;
+  bool v_stored_ok = false;
+  uint32_t v_type = 0;
+  uint32_t v_header = 0;
+  uint32_t v_i = 0;
+  uint32_t v_x = 0;
   uint64_t v_n = 0;
 
   uint8_t* iop_a_dst = NULL;
@@ -16185,43 +21094,294 @@ wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
     }
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
+  uint32_t coro_susp_point = self->private_impl.p_write_block[0];
+  if (coro_susp_point) {
+    v_block_end = self->private_data.s_write_block[0].v_block_end;
+    v_block_start = self->private_data.s_write_block[0].v_block_start;
+    v_type = self->private_data.s_write_block[0].v_type;
+    v_header = self->private_data.s_write_block[0].v_header;
+    v_i = self->private_data.s_write_block[0].v_i;
+    v_x = self->private_data.s_write_block[0].v_x;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (self->private_impl.f_output_wi > 0) {
-      if (self->private_impl.f_output_ri > self->private_impl.f_output_wi) {
-        status = wuffs_base__make_status(
-            wuffs_lzw__error__internal_error_inconsistent_i_o);
-        goto exit;
+    v_block_end = self->private_impl.f_strstart;
+    if (self->private_impl.f_match_available) {
+      wuffs_base__u32__sat_sub_indirect(&v_block_end, 1);
+    }
+    v_block_start = (v_block_end - self->private_impl.f_block_len);
+    v_stored_ok = ((self->private_impl.f_block_len <= 65535) &&
+                   (self->private_impl.f_block_len <= v_block_end));
+    self->private_data.f_freqs[256] = 1;
+    v_type = wuffs_deflate__encoder__choose_block_type(self, v_stored_ok);
+    v_header = 0;
+    if (a_final) {
+      v_header = 1;
+    }
+    if (v_type == 0) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
       }
-      v_s = wuffs_base__slice_u8__subslice_ij(
-          wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
-          self->private_impl.f_output_ri, self->private_impl.f_output_wi);
-      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst, v_s);
-      if (v_n == ((uint64_t)(v_s.len))) {
-        self->private_impl.f_output_ri = 0;
-        self->private_impl.f_output_wi = 0;
-        status = wuffs_base__make_status(NULL);
-        goto ok;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_deflate__encoder__write_bits(self, a_dst, v_header, 3);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
       }
-      self->private_impl.f_output_ri =
-          ((self->private_impl.f_output_ri + ((uint32_t)((v_n & 4294967295)))) &
-           8191);
-      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      if (status.repr) {
+        goto suspend;
+      }
+      if (self->private_impl.f_n_bits > 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, 0, (8 - (self->private_impl.f_n_bits & 7)));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, (self->private_impl.f_block_len & 65535), 16);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, (65535 ^ (self->private_impl.f_block_len & 65535)), 16);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      while (v_block_start < v_block_end) {
+        if (v_block_end > 65536) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+          goto exit;
+        }
+        v_n = wuffs_base__io_writer__copy_from_slice(
+            &iop_a_dst, io2_a_dst,
+            wuffs_base__slice_u8__subslice_ij(
+                wuffs_base__make_slice_u8(self->private_data.f_window, 65808),
+                v_block_start, v_block_end));
+        v_block_start += ((uint32_t)((v_n & 65535)));
+        if (v_block_start < v_block_end) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+        }
+      }
+    } else {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, (v_header | (v_type << 1)), 3);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (v_type == 2) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, self->private_impl.f_hlit_minus_257, 5);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, self->private_impl.f_hdist_minus_1, 5);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, self->private_impl.f_hclen_minus_4, 4);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        v_i = 0;
+        while (v_i < (self->private_impl.f_hclen_minus_4 + 4)) {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+          status = wuffs_deflate__encoder__write_bits(
+              self, a_dst,
+              ((uint32_t)((
+                  self->private_data.f_lens[(
+                      320 + ((uint32_t)(WUFFS_DEFLATE__CODE_ORDER[v_i])))] &
+                  7))),
+              3);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          v_i += 1;
+        }
+        v_i = 0;
+        while (v_i < self->private_impl.f_n_cl_syms) {
+          v_x = ((uint32_t)(self->private_data.f_cl_syms[v_i]));
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+          status = wuffs_deflate__encoder__write_bits(
+              self, a_dst,
+              ((uint32_t)(self->private_data.f_codes[(320 + (v_x & 31))])),
+              ((uint32_t)((self->private_data.f_lens[(320 + (v_x & 31))] &
+                           15))));
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+          if ((v_x & 31) == 16) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+            status =
+                wuffs_deflate__encoder__write_bits(self, a_dst, (v_x >> 5), 2);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          } else if ((v_x & 31) == 17) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+            status =
+                wuffs_deflate__encoder__write_bits(self, a_dst, (v_x >> 5), 3);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          } else if ((v_x & 31) == 18) {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+            status =
+                wuffs_deflate__encoder__write_bits(self, a_dst, (v_x >> 5), 7);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+          v_i += 1;
+        }
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+      status = wuffs_deflate__encoder__write_syms(self, a_dst);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    if (a_final) {
+      if (self->private_impl.f_n_bits > 0) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, 0, (8 - (self->private_impl.f_n_bits & 7)));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      while (self->private_impl.f_n_bits > 0) {
+        self->private_data.s_write_block[0].scratch =
+            ((uint8_t)((self->private_impl.f_bits & 255)));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_block[0].scratch));
+        self->private_impl.f_bits >>= 8;
+        wuffs_base__u32__sat_sub_indirect(&self->private_impl.f_n_bits, 8);
+      }
+    }
+    self->private_impl.f_n_syms = 0;
+    self->private_impl.f_block_len = 0;
+    v_i = 0;
+    while (v_i < 512) {
+      self->private_data.f_freqs[v_i] = 0;
+      v_i += 1;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_write_to[0] = 0;
+    self->private_impl.p_write_block[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_write_to[0] =
+  self->private_impl.p_write_block[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_block[0].v_block_end = v_block_end;
+  self->private_data.s_write_block[0].v_block_start = v_block_start;
+  self->private_data.s_write_block[0].v_type = v_type;
+  self->private_data.s_write_block[0].v_header = v_header;
+  self->private_data.s_write_block[0].v_i = v_i;
+  self->private_data.s_write_block[0].v_x = v_x;
 
   goto exit;
 exit:
@@ -16232,279 +21392,653 @@ exit:
   return status;
 }
 
-// -------- func lzw.decoder.flush
+// -------- func deflate.encoder.write_syms
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
-wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self) {
-  if (!self) {
-    return wuffs_base__make_slice_u8(NULL, 0);
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_syms(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_i = 0;
+  uint32_t v_x = 0;
+  uint32_t v_l = 0;
+  uint32_t v_c = 0;
+  uint32_t v_d = 0;
+  uint32_t v_dc = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_slice_u8(NULL, 0);
+
+  uint32_t coro_susp_point = self->private_impl.p_write_syms[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_write_syms[0].v_bits;
+    v_n_bits = self->private_data.s_write_syms[0].v_n_bits;
+    v_i = self->private_data.s_write_syms[0].v_i;
+    v_x = self->private_data.s_write_syms[0].v_x;
   }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-  wuffs_base__slice_u8 v_s = {0};
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+  label__0__continue:;
+    while (v_i < self->private_impl.f_n_syms) {
+      v_x = self->private_data.f_syms[v_i];
+      v_i += 1;
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) >= 8) {
+        if ((v_n_bits & 63) >= 32) {
+          (wuffs_base__store_u32le__no_bounds_check(
+               iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+           iop_a_dst += 4, wuffs_base__make_empty_struct());
+          v_bits >>= 32;
+          v_n_bits = ((v_n_bits & 63) - 32);
+        }
+      } else {
+        while (v_n_bits >= 8) {
+          self->private_data.s_write_syms[0].scratch =
+              ((uint8_t)((v_bits & 255)));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (iop_a_dst == io2_a_dst) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            goto suspend;
+          }
+          *iop_a_dst++ =
+              ((uint8_t)(self->private_data.s_write_syms[0].scratch));
+          v_bits >>= 8;
+          v_n_bits -= 8;
+        }
+      }
+      if ((v_x >> 31) == 0) {
+        v_bits |= (((uint64_t)(self->private_data.f_codes[(v_x & 255)]))
+                   << (v_n_bits & 63));
+        v_n_bits += ((uint32_t)((self->private_data.f_lens[(v_x & 255)] & 15)));
+        goto label__0__continue;
+      }
+      v_l = (v_x & 255);
+      v_c = ((uint32_t)(WUFFS_DEFLATE__LENGTH_CODES[v_l]));
+      v_bits |= (((uint64_t)(self->private_data.f_codes[(257 + v_c)]))
+                 << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)((self->private_data.f_lens[(257 + v_c)] & 15)));
+      v_bits |=
+          (((uint64_t)((
+               v_l - ((uint32_t)(WUFFS_DEFLATE__LENGTH_BASES_MINUS_3[v_c])))))
+           << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)(WUFFS_DEFLATE__LENGTH_EXTRAS[v_c]));
+      if (((v_n_bits & 63) >= 32) &&
+          (((uint64_t)(io2_a_dst - iop_a_dst)) >= 4)) {
+        (wuffs_base__store_u32le__no_bounds_check(
+             iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+         iop_a_dst += 4, wuffs_base__make_empty_struct());
+        v_bits >>= 32;
+        v_n_bits = ((v_n_bits & 63) - 32);
+      }
+      v_d = ((v_x >> 8) & 32767);
+      if (v_d < 256) {
+        v_dc = ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[v_d]));
+      } else {
+        v_dc = ((uint32_t)(WUFFS_DEFLATE__DISTANCE_CODES[(256 + (v_d >> 7))]));
+      }
+      v_bits |= (((uint64_t)(self->private_data.f_codes[(288 + v_dc)]))
+                 << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)((self->private_data.f_lens[(288 + v_dc)] & 15)));
+      v_bits |=
+          (((uint64_t)((
+               v_d -
+               ((uint32_t)(WUFFS_DEFLATE__DISTANCE_BASES_MINUS_1[v_dc])))))
+           << (v_n_bits & 63));
+      v_n_bits += ((uint32_t)(WUFFS_DEFLATE__DISTANCE_EXTRAS[v_dc]));
+    }
+    while (v_n_bits >= 8) {
+      self->private_data.s_write_syms[0].scratch = ((uint8_t)((v_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_syms[0].scratch));
+      v_bits >>= 8;
+      v_n_bits -= 8;
+    }
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_deflate__encoder__write_bits(
+        self, a_dst, ((uint32_t)(self->private_data.f_codes[256])),
+        ((uint32_t)((self->private_data.f_lens[256] & 15))));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
 
-  if (self->private_impl.f_output_ri <= self->private_impl.f_output_wi) {
-    v_s = wuffs_base__slice_u8__subslice_ij(
-        wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
-        self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+    goto ok;
+  ok:
+    self->private_impl.p_write_syms[0] = 0;
+    goto exit;
   }
-  self->private_impl.f_output_ri = 0;
-  self->private_impl.f_output_wi = 0;
-  return v_s;
-}
 
-#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
-
-#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+  goto suspend;
+suspend:
+  self->private_impl.p_write_syms[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_syms[0].v_bits = v_bits;
+  self->private_data.s_write_syms[0].v_n_bits = v_n_bits;
+  self->private_data.s_write_syms[0].v_i = v_i;
+  self->private_data.s_write_syms[0].v_x = v_x;
 
-// ---------------- Status Codes Implementations
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
 
-const char* wuffs_gif__error__bad_block = "#gif: bad block";
-const char* wuffs_gif__error__bad_extension_label = "#gif: bad extension label";
-const char* wuffs_gif__error__bad_frame_size = "#gif: bad frame size";
-const char* wuffs_gif__error__bad_graphic_control = "#gif: bad graphic control";
-const char* wuffs_gif__error__bad_header = "#gif: bad header";
-const char* wuffs_gif__error__bad_literal_width = "#gif: bad literal width";
-const char* wuffs_gif__error__bad_palette = "#gif: bad palette";
-const char* wuffs_gif__error__internal_error_inconsistent_ri_wi =
-    "#gif: internal error: inconsistent ri/wi";
+  return status;
+}
 
-// ---------------- Private Consts
+// -------- func deflate.encoder.choose_block_type
 
-static const uint32_t              //
-    WUFFS_GIF__INTERLACE_START[5]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        4294967295, 1, 2, 4, 0,
-};
+static uint32_t  //
+wuffs_deflate__encoder__choose_block_type(wuffs_deflate__encoder* self,
+                                          bool a_stored_ok) {
+  uint64_t v_dynamic_cost = 0;
+  uint64_t v_fixed_cost = 0;
+  uint64_t v_stored_cost = 0;
+  uint32_t v_i = 0;
+  uint64_t v_f = 0;
+  uint32_t v_x = 0;
 
-static const uint8_t               //
-    WUFFS_GIF__INTERLACE_DELTA[5]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        1, 2, 4, 8, 8,
-};
+  if (self->private_impl.f_level == 0) {
+    if (a_stored_ok) {
+      return 0;
+    }
+  }
+  wuffs_deflate__encoder__build_huffman(self, 0, 288, 15);
+  wuffs_deflate__encoder__build_huffman(self, 288, 32, 15);
+  wuffs_deflate__encoder__build_cl_syms(self);
+  wuffs_deflate__encoder__build_huffman(self, 320, 19, 7);
+  self->private_impl.f_hclen_minus_4 = 15;
+  while (self->private_impl.f_hclen_minus_4 > 0) {
+    if (self->private_data
+            .f_lens[(320 + ((uint32_t)(WUFFS_DEFLATE__CODE_ORDER[(
+                               self->private_impl.f_hclen_minus_4 + 3)])))] !=
+        0) {
+      goto label__0__break;
+    }
+    self->private_impl.f_hclen_minus_4 -= 1;
+  }
+label__0__break:;
+  v_dynamic_cost =
+      (17 + (3 * ((uint64_t)((self->private_impl.f_hclen_minus_4 + 4)))));
+  v_fixed_cost = 3;
+  v_i = 0;
+  while (v_i < self->private_impl.f_n_cl_syms) {
+    v_x = (((uint32_t)(self->private_data.f_cl_syms[v_i])) & 31);
+    v_dynamic_cost += ((uint64_t)(self->private_data.f_lens[(320 + v_x)]));
+    if (v_x == 16) {
+      v_dynamic_cost += 2;
+    } else if (v_x == 17) {
+      v_dynamic_cost += 3;
+    } else if (v_x == 18) {
+      v_dynamic_cost += 7;
+    }
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 288) {
+    v_f = ((uint64_t)(self->private_data.f_freqs[v_i]));
+    v_dynamic_cost += (v_f * ((uint64_t)(self->private_data.f_lens[v_i])));
+    if (v_i < 144) {
+      v_fixed_cost += (v_f * 8);
+    } else if (v_i < 256) {
+      v_fixed_cost += (v_f * 9);
+    } else if (v_i < 280) {
+      v_fixed_cost += (v_f * 7);
+    } else {
+      v_fixed_cost += (v_f * 8);
+    }
+    if (v_i >= 257) {
+      v_f = (v_f *
+             ((uint64_t)(WUFFS_DEFLATE__LENGTH_EXTRAS[((v_i - 257) & 31)])));
+      v_dynamic_cost += v_f;
+      v_fixed_cost += v_f;
+    }
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 32) {
+    v_f = ((uint64_t)(self->private_data.f_freqs[(288 + v_i)]));
+    v_dynamic_cost +=
+        (v_f * (((uint64_t)(self->private_data.f_lens[(288 + v_i)])) +
+                ((uint64_t)(WUFFS_DEFLATE__DISTANCE_EXTRAS[v_i]))));
+    v_fixed_cost +=
+        (v_f * (5 + ((uint64_t)(WUFFS_DEFLATE__DISTANCE_EXTRAS[v_i]))));
+    v_i += 1;
+  }
+  if (a_stored_ok) {
+    v_stored_cost = (42 + (8 * ((uint64_t)(self->private_impl.f_block_len))));
+    if ((v_stored_cost <= v_dynamic_cost) && (v_stored_cost <= v_fixed_cost)) {
+      return 0;
+    }
+  }
+  if (v_dynamic_cost < v_fixed_cost) {
+    return 2;
+  }
+  v_i = 0;
+  while (v_i < 144) {
+    self->private_data.f_lens[v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 256) {
+    self->private_data.f_lens[v_i] = 9;
+    v_i += 1;
+  }
+  while (v_i < 280) {
+    self->private_data.f_lens[v_i] = 7;
+    v_i += 1;
+  }
+  while (v_i < 288) {
+    self->private_data.f_lens[v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 320) {
+    self->private_data.f_lens[v_i] = 5;
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__assign_codes(self, 0, 288);
+  wuffs_deflate__encoder__assign_codes(self, 288, 32);
+  return 1;
+}
 
-static const uint8_t               //
-    WUFFS_GIF__INTERLACE_COUNT[5]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        0, 1, 2, 4, 8,
-};
+// -------- func deflate.encoder.lit_dist_len
 
-static const uint8_t              //
-    WUFFS_GIF__ANIMEXTS1DOT0[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        65, 78, 73, 77, 69, 88, 84, 83, 49, 46, 48,
-};
+static uint32_t  //
+wuffs_deflate__encoder__lit_dist_len(const wuffs_deflate__encoder* self,
+                                     uint32_t a_k) {
+  if (a_k < (self->private_impl.f_hlit_minus_257 + 257)) {
+    return ((uint32_t)((self->private_data.f_lens[(a_k & 511)] & 15)));
+  }
+  return ((uint32_t)((
+      self->private_data
+          .f_lens[(((a_k + 31) - self->private_impl.f_hlit_minus_257) & 511)] &
+      15)));
+}
 
-static const uint8_t              //
-    WUFFS_GIF__NETSCAPE2DOT0[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        78, 69, 84, 83, 67, 65, 80, 69, 50, 46, 48,
-};
+// -------- func deflate.encoder.build_cl_syms
 
-static const uint8_t            //
-    WUFFS_GIF__ICCRGBG1012[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        73, 67, 67, 82, 71, 66, 71, 49, 48, 49, 50,
-};
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_cl_syms(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+  uint32_t v_total = 0;
+  uint32_t v_k = 0;
+  uint32_t v_v = 0;
+  uint32_t v_run = 0;
+  uint32_t v_r = 0;
+  uint32_t v_step = 0;
+  uint32_t v_t = 0;
+
+  self->private_impl.f_hlit_minus_257 = 29;
+  while (self->private_impl.f_hlit_minus_257 > 0) {
+    if (self->private_data
+            .f_lens[(256 + self->private_impl.f_hlit_minus_257)] != 0) {
+      goto label__0__break;
+    }
+    self->private_impl.f_hlit_minus_257 -= 1;
+  }
+label__0__break:;
+  self->private_impl.f_hdist_minus_1 = 29;
+  while (self->private_impl.f_hdist_minus_1 > 0) {
+    if (self->private_data.f_lens[(288 + self->private_impl.f_hdist_minus_1)] !=
+        0) {
+      goto label__1__break;
+    }
+    self->private_impl.f_hdist_minus_1 -= 1;
+  }
+label__1__break:;
+  v_i = 0;
+  while (v_i < 19) {
+    self->private_data.f_freqs[(320 + v_i)] = 0;
+    v_i += 1;
+  }
+  self->private_impl.f_n_cl_syms = 0;
+  v_total = (self->private_impl.f_hlit_minus_257 + 257 +
+             self->private_impl.f_hdist_minus_1 + 1);
+  v_k = 0;
+  while (v_k < v_total) {
+    v_v = wuffs_deflate__encoder__lit_dist_len(self, v_k);
+    v_run = 1;
+    while (((v_k + v_run) < v_total) && (v_run < 138)) {
+      if (wuffs_deflate__encoder__lit_dist_len(self, (v_k + v_run)) != v_v) {
+        goto label__2__break;
+      }
+      v_run += 1;
+    }
+  label__2__break:;
+    if ((v_v == 0) && (v_run >= 3)) {
+      if (v_run <= 10) {
+        wuffs_deflate__encoder__add_cl_sym(self, 17, (v_run - 3));
+      } else {
+        wuffs_deflate__encoder__add_cl_sym(self, 18, (v_run - 11));
+      }
+      v_step = v_run;
+    } else if (v_run >= 4) {
+      wuffs_deflate__encoder__add_cl_sym(self, v_v, 0);
+      v_r = (v_run - 1);
+      v_r = wuffs_base__u32__min(v_r, 6);
+      wuffs_deflate__encoder__add_cl_sym(self, 16, (v_r - 3));
+      v_step = (1 + v_r);
+    } else {
+      wuffs_deflate__encoder__add_cl_sym(self, v_v, 0);
+      v_step = 1;
+    }
+    v_t = (v_k + v_step);
+    v_k = wuffs_base__u32__min(v_t, 320);
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-static const uint8_t           //
-    WUFFS_GIF__XMPDATAXMP[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        88, 77, 80, 32, 68, 97, 116, 97, 88, 77, 80,
-};
+// -------- func deflate.encoder.add_cl_sym
 
-#define WUFFS_GIF__QUIRKS_BASE 1041635328
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__add_cl_sym(wuffs_deflate__encoder* self,
+                                   uint32_t a_sym,
+                                   uint32_t a_extra) {
+  if (self->private_impl.f_n_cl_syms < 320) {
+    self->private_data.f_cl_syms[self->private_impl.f_n_cl_syms] =
+        ((uint16_t)(((a_extra << 5) | a_sym)));
+    self->private_impl.f_n_cl_syms += 1;
+  }
+  self->private_data.f_freqs[(320 + a_sym)] += 1;
+  return wuffs_base__make_empty_struct();
+}
 
-#define WUFFS_GIF__QUIRKS_COUNT 7
+// -------- func deflate.encoder.build_huffman
 
-// ---------------- Private Initializer Prototypes
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_offset,
+                                      uint32_t a_n,
+                                      uint32_t a_max_len) {
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_m = 0;
+  uint32_t v_key = 0;
+  uint32_t v_root = 0;
+  uint32_t v_leaf = 0;
+  uint32_t v_next = 0;
+  uint32_t v_avbl = 0;
+  uint32_t v_used = 0;
+  uint32_t v_depth = 0;
+  uint32_t v_total = 0;
+  uint32_t v_len = 0;
+  uint8_t v_len_u8 = 0;
+  uint32_t v_c = 0;
 
-// ---------------- Private Function Prototypes
+  v_i = 0;
+  while (v_i < a_n) {
+    self->private_data.f_lens[((a_offset + v_i) & 511)] = 0;
+    if (self->private_data.f_freqs[((a_offset + v_i) & 511)] != 0) {
+      v_m += 1;
+    }
+    v_i += 1;
+  }
+  if (v_m < 2) {
+    if (self->private_data.f_freqs[a_offset] == 0) {
+      self->private_data.f_freqs[a_offset] = 1;
+    }
+    if (self->private_data.f_freqs[(a_offset + 1)] == 0) {
+      self->private_data.f_freqs[(a_offset + 1)] = 1;
+    }
+  }
+  v_m = 0;
+  v_i = 0;
+  while (v_i < a_n) {
+    v_key = self->private_data.f_freqs[((a_offset + v_i) & 511)];
+    if (v_key != 0) {
+      v_key = ((wuffs_base__u32__min(v_key, 8388607) << 9) | v_i);
+      v_j = v_m;
+      while (v_j > 0) {
+        if (self->private_data.f_h_keys[((v_j - 1) & 511)] <= v_key) {
+          goto label__0__break;
+        }
+        self->private_data.f_h_keys[(v_j & 511)] =
+            self->private_data.f_h_keys[((v_j - 1) & 511)];
+        v_j -= 1;
+      }
+    label__0__break:;
+      self->private_data.f_h_keys[(v_j & 511)] = v_key;
+      v_m += 1;
+    }
+    v_i += 1;
+  }
+  if (v_m < 2) {
+    return wuffs_base__make_empty_struct();
+  }
+  v_i = 0;
+  while (v_i < v_m) {
+    self->private_data.f_h_depths[(v_i & 511)] =
+        (self->private_data.f_h_keys[(v_i & 511)] >> 9);
+    v_i += 1;
+  }
+  self->private_data.f_h_depths[0] += self->private_data.f_h_depths[1];
+  v_root = 0;
+  v_leaf = 2;
+  v_next = 1;
+  while (v_next < (v_m - 1)) {
+    if ((v_leaf >= v_m) || (self->private_data.f_h_depths[(v_root & 511)] <
+                            self->private_data.f_h_depths[(v_leaf & 511)])) {
+      self->private_data.f_h_depths[(v_next & 511)] =
+          self->private_data.f_h_depths[(v_root & 511)];
+      self->private_data.f_h_depths[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_h_depths[(v_next & 511)] =
+          self->private_data.f_h_depths[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    if ((v_leaf >= v_m) || ((v_root < v_next) &&
+                            (self->private_data.f_h_depths[(v_root & 511)] <
+                             self->private_data.f_h_depths[(v_leaf & 511)]))) {
+      self->private_data.f_h_depths[(v_next & 511)] +=
+          self->private_data.f_h_depths[(v_root & 511)];
+      self->private_data.f_h_depths[(v_root & 511)] = v_next;
+      v_root += 1;
+    } else {
+      self->private_data.f_h_depths[(v_next & 511)] +=
+          self->private_data.f_h_depths[(v_leaf & 511)];
+      v_leaf += 1;
+    }
+    v_next += 1;
+  }
+  v_next = (v_m - 2);
+  self->private_data.f_h_depths[(v_next & 511)] = 0;
+  while (v_next > 0) {
+    v_next -= 1;
+    self->private_data.f_h_depths[(v_next & 511)] =
+        (self->private_data.f_h_depths[(
+             self->private_data.f_h_depths[(v_next & 511)] & 511)] +
+         1);
+  }
+  v_avbl = 1;
+  v_used = 0;
+  v_depth = 0;
+  v_root = (v_m - 1);
+  v_next = v_m;
+  while ((v_avbl > 0) && (v_depth < 32)) {
+    while ((v_root > 0) &&
+           (self->private_data.f_h_depths[((v_root - 1) & 511)] == v_depth)) {
+      v_used += 1;
+      v_root -= 1;
+    }
+    while ((v_avbl > v_used) && (v_next > 0)) {
+      v_next -= 1;
+      self->private_data.f_h_depths[(v_next & 511)] = v_depth;
+      v_avbl -= 1;
+    }
+    v_avbl = (v_used * 2);
+    v_depth += 1;
+    v_used = 0;
+  }
+  v_i = 0;
+  while (v_i < 16) {
+    self->private_data.f_h_counts[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < v_m) {
+    self->private_data.f_h_counts[wuffs_base__u32__min(
+        self->private_data.f_h_depths[(v_i & 511)], a_max_len)] += 1;
+    v_i += 1;
+  }
+  v_total = 0;
+  v_i = a_max_len;
+  while (v_i > 0) {
+    v_total +=
+        (self->private_data.f_h_counts[(v_i & 15)] << ((a_max_len - v_i) & 31));
+    v_i -= 1;
+  }
+  while (v_total > (((uint32_t)(1)) << a_max_len)) {
+    self->private_data.f_h_counts[a_max_len] -= 1;
+    v_i = (a_max_len - 1);
+    while (v_i > 0) {
+      if (self->private_data.f_h_counts[(v_i & 15)] != 0) {
+        self->private_data.f_h_counts[(v_i & 15)] -= 1;
+        self->private_data.f_h_counts[((v_i + 1) & 15)] += 2;
+        goto label__1__break;
+      }
+      v_i -= 1;
+    }
+  label__1__break:;
+    v_total -= 1;
+  }
+  v_j = 0;
+  v_len = a_max_len;
+  while (v_len > 0) {
+    v_c = self->private_data.f_h_counts[v_len];
+    v_len_u8 = ((uint8_t)(v_len));
+    v_len -= 1;
+    while (v_c > 0) {
+      self->private_data.f_lens[(
+          (a_offset + (self->private_data.f_h_keys[(v_j & 511)] & 511)) &
+          511)] = v_len_u8;
+      v_j += 1;
+      v_c -= 1;
+    }
+  }
+  wuffs_deflate__encoder__assign_codes(self, a_offset, a_n);
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src);
+// -------- func deflate.encoder.assign_codes
 
 static wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self);
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_offset,
+                                     uint32_t a_n) {
+  uint32_t v_i = 0;
+  uint32_t v_code = 0;
+  uint32_t v_len = 0;
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_up_to_id_part1(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
-                                         wuffs_base__io_buffer* a_src);
+  v_i = 0;
+  while (v_i < 16) {
+    self->private_data.f_h_counts[v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n) {
+    self->private_data.f_h_counts[(
+        self->private_data.f_lens[((a_offset + v_i) & 511)] & 15)] += 1;
+    v_i += 1;
+  }
+  self->private_data.f_h_counts[0] = 0;
+  v_code = 0;
+  v_i = 1;
+  while (v_i < 16) {
+    v_code = ((v_code + self->private_data.f_h_counts[((v_i - 1) & 15)]) << 1);
+    self->private_data.f_h_next_codes[v_i] = v_code;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n) {
+    v_len = ((
+        uint32_t)((self->private_data.f_lens[((a_offset + v_i) & 511)] & 15)));
+    if (v_len != 0) {
+      v_code = self->private_data.f_h_next_codes[v_len];
+      self->private_data.f_h_next_codes[v_len] = (v_code + 1);
+      v_code = ((((uint32_t)(WUFFS_DEFLATE__REVERSE8[(v_code & 255)])) << 8) |
+                ((uint32_t)(WUFFS_DEFLATE__REVERSE8[((v_code >> 8) & 255)])));
+      self->private_data.f_codes[((a_offset + v_i) & 511)] =
+          ((uint16_t)(((v_code >> (16 - v_len)) & 65535)));
+    }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src);
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__DEFLATE)
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
-                                            wuffs_base__io_buffer* a_src);
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
-                                       wuffs_base__io_buffer* a_src);
+// ---------------- Status Codes Implementations
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+const char* wuffs_lzw__error__bad_code = "#lzw: bad code";
+const char* wuffs_lzw__error__internal_error_inconsistent_i_o =
+    "#lzw: internal error: inconsistent I/O";
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+// ---------------- Private Consts
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
-                                           wuffs_base__io_buffer* a_src);
+// ---------------- Private Initializer Prototypes
 
-static wuffs_base__status  //
-wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src);
+// ---------------- Private Function Prototypes
 
 static wuffs_base__empty_struct  //
-wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
-                                          wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
-                                  wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
-                                     wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
-                                wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
+wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
                               wuffs_base__io_buffer* a_src);
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
-                                    wuffs_base__io_buffer* a_src);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__pixel_blend a_blend);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__slice_u8 a_workbuf);
-
-static wuffs_base__status  //
-wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
-                                         wuffs_base__pixel_buffer* a_pb,
-                                         wuffs_base__slice_u8 a_src);
+wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
+                             wuffs_base__io_buffer* a_dst);
 
 // ---------------- VTables
 
-const wuffs_base__image_decoder__func_ptrs
-    wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder = {
-        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__ack_metadata_chunk),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__pixel_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__pixel_blend,
-                               wuffs_base__slice_u8,
-                               wuffs_base__decode_frame_options*))(
-            &wuffs_gif__config_decoder__decode_frame),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__frame_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__decode_frame_config),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__image_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__decode_image_config),
-        (wuffs_base__rect_ie_u32(*)(const void*))(
-            &wuffs_gif__config_decoder__frame_dirty_rect),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__metadata_chunk_length),
-        (uint32_t(*)(const void*))(&wuffs_gif__config_decoder__metadata_fourcc),
-        (uint32_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_animation_loops),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_decoded_frame_configs),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_decoded_frames),
-        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
-            &wuffs_gif__config_decoder__restart_frame),
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__config_decoder__set_quirk_enabled),
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer = {
         (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__config_decoder__set_report_metadata),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_gif__config_decoder__workbuf_len),
-};
-
-const wuffs_base__image_decoder__func_ptrs
-    wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder = {
-        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__ack_metadata_chunk),
+            &wuffs_lzw__decoder__set_quirk_enabled),
         (wuffs_base__status(*)(void*,
-                               wuffs_base__pixel_buffer*,
                                wuffs_base__io_buffer*,
-                               wuffs_base__pixel_blend,
-                               wuffs_base__slice_u8,
-                               wuffs_base__decode_frame_options*))(
-            &wuffs_gif__decoder__decode_frame),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__frame_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__decode_frame_config),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__image_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__decode_image_config),
-        (wuffs_base__rect_ie_u32(*)(const void*))(
-            &wuffs_gif__decoder__frame_dirty_rect),
-        (uint64_t(*)(const void*))(&wuffs_gif__decoder__metadata_chunk_length),
-        (uint32_t(*)(const void*))(&wuffs_gif__decoder__metadata_fourcc),
-        (uint32_t(*)(const void*))(&wuffs_gif__decoder__num_animation_loops),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__decoder__num_decoded_frame_configs),
-        (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frames),
-        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
-            &wuffs_gif__decoder__restart_frame),
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__decoder__set_quirk_enabled),
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__decoder__set_report_metadata),
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_lzw__decoder__transform_io),
         (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_gif__decoder__workbuf_len),
+            &wuffs_lzw__decoder__workbuf_len),
 };
 
 // ---------------- Initializer Implementations
 
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
-                                      size_t sizeof_star_self,
-                                      uint64_t wuffs_version,
-                                      uint32_t initialize_flags) {
+wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -16541,23 +22075,23 @@ wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
   }
 
   self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
-      wuffs_base__image_decoder__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
-      (const void*)(&wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder);
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer);
   return wuffs_base__make_status(NULL);
 }
 
-wuffs_gif__config_decoder*  //
-wuffs_gif__config_decoder__alloc() {
-  wuffs_gif__config_decoder* x = (wuffs_gif__config_decoder*)(calloc(
-      sizeof(wuffs_gif__config_decoder), 1));
+wuffs_lzw__decoder*  //
+wuffs_lzw__decoder__alloc() {
+  wuffs_lzw__decoder* x =
+      (wuffs_lzw__decoder*)(calloc(sizeof(wuffs_lzw__decoder), 1));
   if (!x) {
     return NULL;
   }
-  if (wuffs_gif__config_decoder__initialize(
-          x, sizeof(wuffs_gif__config_decoder), WUFFS_VERSION,
-          WUFFS_INITIALIZE__ALREADY_ZEROED)
+  if (wuffs_lzw__decoder__initialize(x, sizeof(wuffs_lzw__decoder),
+                                     WUFFS_VERSION,
+                                     WUFFS_INITIALIZE__ALREADY_ZEROED)
           .repr) {
     free(x);
     return NULL;
@@ -16566,118 +22100,62 @@ wuffs_gif__config_decoder__alloc() {
 }
 
 size_t  //
-sizeof__wuffs_gif__config_decoder() {
-  return sizeof(wuffs_gif__config_decoder);
+sizeof__wuffs_lzw__decoder() {
+  return sizeof(wuffs_lzw__decoder);
 }
 
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
-                               size_t sizeof_star_self,
-                               uint64_t wuffs_version,
-                               uint32_t initialize_flags) {
+// ---------------- Function Implementations
+
+// -------- func lzw.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__decoder__set_quirk_enabled(wuffs_lzw__decoder* self,
+                                      uint32_t a_quirk,
+                                      bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.decoder.set_literal_width
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__decoder__set_literal_width(wuffs_lzw__decoder* self, uint32_t a_lw) {
   if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+    return wuffs_base__make_empty_struct();
   }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  if (a_lw > 8) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
   }
 
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-    if (self->private_impl.magic != 0) {
-      return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
-    }
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
-    } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
-    }
-  }
-
-  {
-    wuffs_base__status z = wuffs_lzw__decoder__initialize(
-        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
-  }
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
-      wuffs_base__image_decoder__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
-      (const void*)(&wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder);
-  return wuffs_base__make_status(NULL);
-}
-
-wuffs_gif__decoder*  //
-wuffs_gif__decoder__alloc() {
-  wuffs_gif__decoder* x =
-      (wuffs_gif__decoder*)(calloc(sizeof(wuffs_gif__decoder), 1));
-  if (!x) {
-    return NULL;
-  }
-  if (wuffs_gif__decoder__initialize(x, sizeof(wuffs_gif__decoder),
-                                     WUFFS_VERSION,
-                                     WUFFS_INITIALIZE__ALREADY_ZEROED)
-          .repr) {
-    free(x);
-    return NULL;
-  }
-  return x;
-}
-
-size_t  //
-sizeof__wuffs_gif__decoder() {
-  return sizeof(wuffs_gif__decoder);
+  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
+  return wuffs_base__make_empty_struct();
 }
 
-// ---------------- Function Implementations
-
-// -------- func gif.config_decoder.set_quirk_enabled
+// -------- func lzw.decoder.workbuf_len
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__set_quirk_enabled(wuffs_gif__config_decoder* self,
-                                             uint32_t a_quirk,
-                                             bool a_enabled) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
   if (!self) {
-    return wuffs_base__make_empty_struct();
+    return wuffs_base__utility__empty_range_ii_u64();
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  if ((self->private_impl.f_call_sequence == 0) && (a_quirk >= 1041635328)) {
-    a_quirk -= 1041635328;
-    if (a_quirk < 7) {
-      self->private_impl.f_quirks[a_quirk] = a_enabled;
-    }
-  }
-  return wuffs_base__make_empty_struct();
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
 }
 
-// -------- func gif.config_decoder.decode_image_config
+// -------- func lzw.decoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
-                                               wuffs_base__image_config* a_dst,
-                                               wuffs_base__io_buffer* a_src) {
+wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__slice_u8 a_workbuf) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -16687,7 +22165,7 @@ wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
             ? wuffs_base__error__disabled_by_previous_error
             : wuffs_base__error__initialize_not_called);
   }
-  if (!a_src) {
+  if (!a_dst || !a_src) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
@@ -16700,63 +22178,70 @@ wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  bool v_ffio = false;
+  uint32_t v_i = 0;
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence == 0) {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__config_decoder__decode_header(self, a_src);
-      if (status.repr) {
-        goto suspend;
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__config_decoder__decode_lsd(self, a_src);
-      if (status.repr) {
-        goto suspend;
-      }
-    } else if (self->private_impl.f_call_sequence != 2) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
-    if (status.repr) {
-      goto suspend;
-    }
-    v_ffio = !self->private_impl.f_gc_has_transparent_index;
-    if (!self->private_impl.f_quirks[2]) {
-      v_ffio =
-          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
-           (self->private_impl.f_frame_rect_y0 == 0) &&
-           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
-           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
-    } else if (v_ffio) {
-      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    self->private_impl.f_literal_width = 8;
+    if (self->private_impl.f_set_literal_width_arg > 0) {
+      self->private_impl.f_literal_width =
+          (self->private_impl.f_set_literal_width_arg - 1);
     }
-    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
-      self->private_impl.f_background_color_u32_argb_premul =
-          self->private_impl.f_black_color_u32_argb_premul;
+    self->private_impl.f_clear_code =
+        (((uint32_t)(1)) << self->private_impl.f_literal_width);
+    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
+    self->private_impl.f_save_code = self->private_impl.f_end_code;
+    self->private_impl.f_prev_code = self->private_impl.f_end_code;
+    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
+    self->private_impl.f_bits = 0;
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_output_ri = 0;
+    self->private_impl.f_output_wi = 0;
+    v_i = 0;
+    while (v_i < self->private_impl.f_clear_code) {
+      self->private_data.f_lm1s[v_i] = 0;
+      self->private_data.f_suffixes[v_i][0] = ((uint8_t)(v_i));
+      v_i += 1;
     }
-    if (a_dst != NULL) {
-      wuffs_base__image_config__set(
-          a_dst, 1191444488, 0, self->private_impl.f_width,
-          self->private_impl.f_height,
-          self->private_impl.f_frame_config_io_position, v_ffio);
+  label__0__continue:;
+    while (true) {
+      wuffs_lzw__decoder__read_from(self, a_src);
+      if (self->private_impl.f_output_wi > 0) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_lzw__decoder__write_to(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      if (self->private_impl.f_read_from_return_value == 0) {
+        goto label__0__break;
+      } else if (self->private_impl.f_read_from_return_value == 1) {
+        goto label__0__continue;
+      } else if (self->private_impl.f_read_from_return_value == 2) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      } else if (self->private_impl.f_read_from_return_value == 3) {
+        status = wuffs_base__make_status(wuffs_lzw__error__bad_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
     }
-    self->private_impl.f_call_sequence = 3;
+  label__0__break:;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_image_config[0] = 0;
+    self->private_impl.p_transform_io[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_image_config[0] =
+  self->private_impl.p_transform_io[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 1 : 0;
@@ -16769,53 +22254,26 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.set_report_metadata
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__set_report_metadata(wuffs_gif__config_decoder* self,
-                                               uint32_t a_fourcc,
-                                               bool a_report) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
-  }
-
-  if (a_fourcc == 1229144912) {
-    self->private_impl.f_report_metadata_iccp = a_report;
-  } else if (a_fourcc == 1481461792) {
-    self->private_impl.f_report_metadata_xmp = a_report;
-  }
-  return wuffs_base__make_empty_struct();
-}
-
-// -------- func gif.config_decoder.ack_metadata_chunk
+// -------- func lzw.decoder.read_from
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
-                                              wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 2)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+static wuffs_base__empty_struct  //
+wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
+                              wuffs_base__io_buffer* a_src) {
+  uint32_t v_clear_code = 0;
+  uint32_t v_end_code = 0;
+  uint32_t v_save_code = 0;
+  uint32_t v_prev_code = 0;
+  uint32_t v_width = 0;
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_output_wi = 0;
+  uint32_t v_code = 0;
+  uint32_t v_c = 0;
+  uint32_t v_o = 0;
+  uint32_t v_steps = 0;
+  uint8_t v_first_byte = 0;
+  uint16_t v_lm1_b = 0;
+  uint16_t v_lm1_a = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16828,656 +22286,824 @@ wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    if (self->private_impl.f_call_sequence != 1) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    if (wuffs_base__u64__sat_add(a_src->meta.pos,
-                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
-        self->private_impl.f_metadata_io_position) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
-      goto exit;
+  v_clear_code = self->private_impl.f_clear_code;
+  v_end_code = self->private_impl.f_end_code;
+  v_save_code = self->private_impl.f_save_code;
+  v_prev_code = self->private_impl.f_prev_code;
+  v_width = self->private_impl.f_width;
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = self->private_impl.f_n_bits;
+  v_output_wi = self->private_impl.f_output_wi;
+  while (true) {
+    if (v_n_bits < v_width) {
+      if (((uint64_t)(io2_a_src - iop_a_src)) >= 4) {
+        v_bits |=
+            (wuffs_base__load_u32le__no_bounds_check(iop_a_src) << v_n_bits);
+        (iop_a_src += ((31 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+        v_n_bits |= 24;
+      } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        self->private_impl.f_read_from_return_value = 2;
+        goto label__0__break;
+      } else {
+        v_bits |=
+            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+             << v_n_bits);
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        v_n_bits += 8;
+        if (v_n_bits >= v_width) {
+        } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          self->private_impl.f_read_from_return_value = 2;
+          goto label__0__break;
+        } else {
+          v_bits |=
+              (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+               << v_n_bits);
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+          v_n_bits += 8;
+          if (v_n_bits < v_width) {
+            self->private_impl.f_read_from_return_value = 4;
+            goto label__0__break;
+          }
+        }
+      }
     }
-    if (self->private_impl.f_metadata_chunk_length_value > 0) {
-      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    v_code = ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_width));
+    v_bits >>= v_width;
+    v_n_bits -= v_width;
+    if (v_code < v_clear_code) {
+      self->private_data.f_output[v_output_wi] = ((uint8_t)(v_code));
+      v_output_wi = ((v_output_wi + 1) & 8191);
+      if (v_save_code <= 4095) {
+        v_lm1_a = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_a;
+        if ((v_lm1_a % 8) != 0) {
+          self->private_impl.f_prefixes[v_save_code] =
+              self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],
+                 self->private_data.f_suffixes[v_prev_code],
+                 sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_a % 8)] =
+              ((uint8_t)(v_code));
+        } else {
+          self->private_impl.f_prefixes[v_save_code] =
+              ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_code));
+        }
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & (v_save_code >> v_width));
+        }
+        v_prev_code = v_code;
       }
-      self->private_impl.f_metadata_chunk_length_value =
-          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-      if (self->private_impl.f_metadata_chunk_length_value > 0) {
-        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
+    } else if (v_code <= v_end_code) {
+      if (v_code == v_end_code) {
+        self->private_impl.f_read_from_return_value = 0;
+        goto label__0__break;
+      }
+      v_save_code = v_end_code;
+      v_prev_code = v_end_code;
+      v_width = (self->private_impl.f_literal_width + 1);
+    } else if (v_code <= v_save_code) {
+      v_c = v_code;
+      if (v_code == v_save_code) {
+        v_c = v_prev_code;
+      }
+      v_o = ((v_output_wi +
+              (((uint32_t)(self->private_data.f_lm1s[v_c])) & 4294967288)) &
+             8191);
+      v_output_wi =
+          ((v_output_wi + 1 + ((uint32_t)(self->private_data.f_lm1s[v_c]))) &
+           8191);
+      v_steps = (((uint32_t)(self->private_data.f_lm1s[v_c])) >> 3);
+      while (true) {
+        memcpy((self->private_data.f_output) + (v_o),
+               (self->private_data.f_suffixes[v_c]), 8);
+        if (v_steps <= 0) {
+          goto label__1__break;
+        }
+        v_steps -= 1;
+        v_o = ((v_o - 8) & 8191);
+        v_c = ((uint32_t)(self->private_impl.f_prefixes[v_c]));
+      }
+    label__1__break:;
+      v_first_byte = self->private_data.f_suffixes[v_c][0];
+      if (v_code == v_save_code) {
+        self->private_data.f_output[v_output_wi] = v_first_byte;
+        v_output_wi = ((v_output_wi + 1) & 8191);
+      }
+      if (v_save_code <= 4095) {
+        v_lm1_b = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_b;
+        if ((v_lm1_b % 8) != 0) {
+          self->private_impl.f_prefixes[v_save_code] =
+              self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],
+                 self->private_data.f_suffixes[v_prev_code],
+                 sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_b % 8)] =
+              v_first_byte;
         } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
+          self->private_impl.f_prefixes[v_save_code] =
+              ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] =
+              ((uint8_t)(v_first_byte));
         }
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & (v_save_code >> v_width));
+        }
+        v_prev_code = v_code;
+      }
+    } else {
+      self->private_impl.f_read_from_return_value = 3;
+      goto label__0__break;
+    }
+    if (v_output_wi > 4095) {
+      self->private_impl.f_read_from_return_value = 1;
+      goto label__0__break;
+    }
+  }
+label__0__break:;
+  if (self->private_impl.f_read_from_return_value != 2) {
+    while (v_n_bits >= 8) {
+      v_n_bits -= 8;
+      if (iop_a_src > io1_a_src) {
+        (iop_a_src--, wuffs_base__make_empty_struct());
+      } else {
+        self->private_impl.f_read_from_return_value = 4;
+        goto label__2__break;
+      }
+    }
+  label__2__break:;
+  }
+  self->private_impl.f_save_code = v_save_code;
+  self->private_impl.f_prev_code = v_prev_code;
+  self->private_impl.f_width = v_width;
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  self->private_impl.f_output_wi = v_output_wi;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.decoder.write_to
+
+static wuffs_base__status  //
+wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
+                             wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_output_wi > 0) {
+      if (self->private_impl.f_output_ri > self->private_impl.f_output_wi) {
+        status = wuffs_base__make_status(
+            wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+      v_s = wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
+          self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst, v_s);
+      if (v_n == ((uint64_t)(v_s.len))) {
+        self->private_impl.f_output_ri = 0;
+        self->private_impl.f_output_wi = 0;
+        status = wuffs_base__make_status(NULL);
         goto ok;
       }
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
+      self->private_impl.f_output_ri =
+          ((self->private_impl.f_output_ri + ((uint32_t)((v_n & 4294967295)))) &
+           8191);
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
     }
-    self->private_impl.f_call_sequence = 2;
-    self->private_impl.f_metadata_fourcc_value = 0;
-    self->private_impl.f_metadata_io_position = 0;
-    status = wuffs_base__make_status(NULL);
-    goto ok;
+
     goto ok;
   ok:
-    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    self->private_impl.p_write_to[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_ack_metadata_chunk[0] =
+  self->private_impl.p_write_to[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 2 : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.config_decoder.metadata_fourcc
+// -------- func lzw.decoder.flush
 
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__config_decoder__metadata_fourcc(
-    const wuffs_gif__config_decoder* self) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
+wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self) {
   if (!self) {
-    return 0;
+    return wuffs_base__make_slice_u8(NULL, 0);
   }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_slice_u8(NULL, 0);
   }
 
-  return self->private_impl.f_metadata_fourcc_value;
+  wuffs_base__slice_u8 v_s = {0};
+
+  if (self->private_impl.f_output_ri <= self->private_impl.f_output_wi) {
+    v_s = wuffs_base__slice_u8__subslice_ij(
+        wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
+        self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+  }
+  self->private_impl.f_output_ri = 0;
+  self->private_impl.f_output_wi = 0;
+  return v_s;
 }
 
-// -------- func gif.config_decoder.metadata_chunk_length
+#endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__metadata_chunk_length(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
 
-  return self->private_impl.f_metadata_chunk_length_value;
-}
+// ---------------- Status Codes Implementations
 
-// -------- func gif.config_decoder.num_animation_loops
+const char* wuffs_gif__error__bad_block = "#gif: bad block";
+const char* wuffs_gif__error__bad_extension_label = "#gif: bad extension label";
+const char* wuffs_gif__error__bad_frame_size = "#gif: bad frame size";
+const char* wuffs_gif__error__bad_graphic_control = "#gif: bad graphic control";
+const char* wuffs_gif__error__bad_header = "#gif: bad header";
+const char* wuffs_gif__error__bad_literal_width = "#gif: bad literal width";
+const char* wuffs_gif__error__bad_palette = "#gif: bad palette";
+const char* wuffs_gif__error__internal_error_inconsistent_ri_wi =
+    "#gif: internal error: inconsistent ri/wi";
 
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__config_decoder__num_animation_loops(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
+// ---------------- Private Consts
 
-  if (self->private_impl.f_seen_num_loops) {
-    return self->private_impl.f_num_loops;
-  }
-  return 1;
-}
+static const uint32_t              //
+    WUFFS_GIF__INTERLACE_START[5]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        4294967295, 1, 2, 4, 0,
+};
 
-// -------- func gif.config_decoder.num_decoded_frame_configs
+static const uint8_t               //
+    WUFFS_GIF__INTERLACE_DELTA[5]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1, 2, 4, 8, 8,
+};
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__num_decoded_frame_configs(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
+static const uint8_t               //
+    WUFFS_GIF__INTERLACE_COUNT[5]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 1, 2, 4, 8,
+};
 
-  return self->private_impl.f_num_decoded_frame_configs_value;
-}
+static const uint8_t              //
+    WUFFS_GIF__ANIMEXTS1DOT0[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        65, 78, 73, 77, 69, 88, 84, 83, 49, 46, 48,
+};
 
-// -------- func gif.config_decoder.num_decoded_frames
+static const uint8_t              //
+    WUFFS_GIF__NETSCAPE2DOT0[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        78, 69, 84, 83, 67, 65, 80, 69, 50, 46, 48,
+};
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__num_decoded_frames(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
+static const uint8_t            //
+    WUFFS_GIF__ICCRGBG1012[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        73, 67, 67, 82, 71, 66, 71, 49, 48, 49, 50,
+};
 
-  return self->private_impl.f_num_decoded_frames_value;
-}
+static const uint8_t           //
+    WUFFS_GIF__XMPDATAXMP[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        88, 77, 80, 32, 68, 97, 116, 97, 88, 77, 80,
+};
 
-// -------- func gif.config_decoder.frame_dirty_rect
+#define WUFFS_GIF__QUIRKS_BASE 1041635328
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
-wuffs_gif__config_decoder__frame_dirty_rect(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
+#define WUFFS_GIF__QUIRKS_COUNT 7
 
-  return wuffs_base__utility__empty_rect_ie_u32();
-}
+// ---------------- Private Initializer Prototypes
 
-// -------- func gif.config_decoder.workbuf_len
+// ---------------- Private Function Prototypes
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gif__config_decoder__workbuf_len(const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_range_ii_u64();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_range_ii_u64();
-  }
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src);
 
-  return wuffs_base__utility__empty_range_ii_u64();
-}
+static wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self);
 
-// -------- func gif.config_decoder.restart_frame
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_up_to_id_part1(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__io_buffer* a_src);
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__restart_frame(wuffs_gif__config_decoder* self,
-                                         uint64_t a_index,
-                                         uint64_t a_io_position) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
+                                         wuffs_base__io_buffer* a_src);
 
-  if (self->private_impl.f_call_sequence == 0) {
-    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-  }
-  self->private_impl.f_delayed_num_decoded_frames = false;
-  self->private_impl.f_end_of_data = false;
-  self->private_impl.f_restarted = true;
-  self->private_impl.f_frame_config_io_position = a_io_position;
-  self->private_impl.f_num_decoded_frame_configs_value = a_index;
-  self->private_impl.f_num_decoded_frames_value = a_index;
-  wuffs_gif__config_decoder__reset_gc(self);
-  return wuffs_base__make_status(NULL);
-}
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src);
 
-// -------- func gif.config_decoder.decode_frame_config
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
+                                            wuffs_base__io_buffer* a_src);
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
-                                               wuffs_base__frame_config* a_dst,
-                                               wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 3)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
+                                       wuffs_base__io_buffer* a_src);
 
-  uint32_t v_background_color = 0;
-  uint8_t v_flags = 0;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src);
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src);
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
-  if (coro_susp_point) {
-    v_background_color =
-        self->private_data.s_decode_frame_config[0].v_background_color;
-  }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
+                                           wuffs_base__io_buffer* a_src);
 
-    self->private_impl.f_ignore_metadata = true;
-    if (!self->private_impl.f_end_of_data) {
-      if (self->private_impl.f_call_sequence == 0) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status =
-            wuffs_gif__config_decoder__decode_image_config(self, NULL, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (self->private_impl.f_call_sequence != 3) {
-        if (self->private_impl.f_call_sequence == 4) {
-          if (a_src) {
-            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-          }
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          status = wuffs_gif__config_decoder__skip_frame(self, a_src);
-          if (a_src) {
-            iop_a_src = a_src->data.ptr + a_src->meta.ri;
-          }
-          if (status.repr) {
-            goto suspend;
-          }
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      }
-    }
-    if (self->private_impl.f_end_of_data) {
-      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
-      goto ok;
-    }
-    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
-    if (!self->private_impl.f_gc_has_transparent_index) {
-      v_background_color =
-          self->private_impl.f_background_color_u32_argb_premul;
-      if (self->private_impl.f_quirks[1] &&
-          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
-        }
-        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
-        if ((v_flags & 128) != 0) {
-          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
-        }
-      }
-    }
-    if (a_dst != NULL) {
-      wuffs_base__frame_config__update(
-          a_dst,
-          wuffs_base__utility__make_rect_ie_u32(
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                                   self->private_impl.f_height),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
-                                   self->private_impl.f_height)),
-          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
-          self->private_impl.f_num_decoded_frame_configs_value,
-          self->private_impl.f_frame_config_io_position,
-          self->private_impl.f_gc_disposal,
-          !self->private_impl.f_gc_has_transparent_index, false,
-          v_background_color);
-    }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frame_configs_value, 1);
-    self->private_impl.f_call_sequence = 4;
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_frame_config[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_frame_config[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 3 : 0;
-  self->private_data.s_decode_frame_config[0].v_background_color =
-      v_background_color;
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src);
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
+static wuffs_base__empty_struct  //
+wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self);
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
-  return status;
-}
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
+                                          wuffs_base__io_buffer* a_src);
 
-// -------- func gif.config_decoder.skip_frame
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
+                                  wuffs_base__io_buffer* a_src);
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src);
 
-  uint8_t v_flags = 0;
-  uint8_t v_lw = 0;
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
+                                     wuffs_base__io_buffer* a_src);
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
+                                wuffs_base__io_buffer* a_src);
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src);
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
-    }
-    if ((v_flags & 128) != 0) {
-      self->private_data.s_skip_frame[0].scratch =
-          (((uint32_t)(3)) << (1 + (v_flags & 7)));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_frame[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_frame[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_skip_frame[0].scratch;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_1 = *iop_a_src++;
-      v_lw = t_1;
-    }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
-      goto exit;
-    }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
-    }
-    if (status.repr) {
-      goto suspend;
-    }
-    if (self->private_impl.f_quirks[0]) {
-      self->private_impl.f_delayed_num_decoded_frames = true;
-    } else {
-      wuffs_base__u64__sat_add_indirect(
-          &self->private_impl.f_num_decoded_frames_value, 1);
-    }
-    wuffs_gif__config_decoder__reset_gc(self);
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src);
 
-    goto ok;
-  ok:
-    self->private_impl.p_skip_frame[0] = 0;
-    goto exit;
-  }
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
+                                    wuffs_base__io_buffer* a_src);
 
-  goto suspend;
-suspend:
-  self->private_impl.p_skip_frame[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__pixel_blend a_blend);
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__slice_u8 a_workbuf);
 
-  return status;
-}
+static wuffs_base__status  //
+wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
+                                         wuffs_base__pixel_buffer* a_pb,
+                                         wuffs_base__slice_u8 a_src);
 
-// -------- func gif.config_decoder.decode_frame
+// ---------------- VTables
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_frame(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__pixel_buffer* a_dst,
-    wuffs_base__io_buffer* a_src,
-    wuffs_base__pixel_blend a_blend,
-    wuffs_base__slice_u8 a_workbuf,
-    wuffs_base__decode_frame_options* a_opts) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_dst || !a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 4)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
+const wuffs_base__image_decoder__func_ptrs
+    wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder = {
+        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__ack_metadata_chunk),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__pixel_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__pixel_blend,
+                               wuffs_base__slice_u8,
+                               wuffs_base__decode_frame_options*))(
+            &wuffs_gif__config_decoder__decode_frame),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__frame_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__decode_frame_config),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__image_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__decode_image_config),
+        (wuffs_base__rect_ie_u32(*)(const void*))(
+            &wuffs_gif__config_decoder__frame_dirty_rect),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__metadata_chunk_length),
+        (uint32_t(*)(const void*))(&wuffs_gif__config_decoder__metadata_fourcc),
+        (uint32_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_animation_loops),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_decoded_frame_configs),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_decoded_frames),
+        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
+            &wuffs_gif__config_decoder__restart_frame),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__config_decoder__set_quirk_enabled),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__config_decoder__set_report_metadata),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gif__config_decoder__workbuf_len),
+};
+
+const wuffs_base__image_decoder__func_ptrs
+    wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__ack_metadata_chunk),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__pixel_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__pixel_blend,
+                               wuffs_base__slice_u8,
+                               wuffs_base__decode_frame_options*))(
+            &wuffs_gif__decoder__decode_frame),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__frame_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__decode_frame_config),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__image_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__decode_image_config),
+        (wuffs_base__rect_ie_u32(*)(const void*))(
+            &wuffs_gif__decoder__frame_dirty_rect),
+        (uint64_t(*)(const void*))(&wuffs_gif__decoder__metadata_chunk_length),
+        (uint32_t(*)(const void*))(&wuffs_gif__decoder__metadata_fourcc),
+        (uint32_t(*)(const void*))(&wuffs_gif__decoder__num_animation_loops),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__decoder__num_decoded_frame_configs),
+        (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frames),
+        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
+            &wuffs_gif__decoder__restart_frame),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__decoder__set_quirk_enabled),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__decoder__set_report_metadata),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gif__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
+                                      size_t sizeof_star_self,
+                                      uint64_t wuffs_version,
+                                      uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
   }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  status = wuffs_base__make_status(wuffs_base__error__unsupported_method);
-  goto exit;
-  goto ok;
-ok:
-  goto exit;
-exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
   }
-  return status;
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
 }
 
-// -------- func gif.config_decoder.reset_gc
+wuffs_gif__config_decoder*  //
+wuffs_gif__config_decoder__alloc() {
+  wuffs_gif__config_decoder* x = (wuffs_gif__config_decoder*)(calloc(
+      sizeof(wuffs_gif__config_decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gif__config_decoder__initialize(
+          x, sizeof(wuffs_gif__config_decoder), WUFFS_VERSION,
+          WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
 
-static wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self) {
-  self->private_impl.f_call_sequence = 5;
-  self->private_impl.f_gc_has_transparent_index = false;
-  self->private_impl.f_gc_transparent_index = 0;
-  self->private_impl.f_gc_disposal = 0;
-  self->private_impl.f_gc_duration = 0;
-  return wuffs_base__make_empty_struct();
+size_t  //
+sizeof__wuffs_gif__config_decoder() {
+  return sizeof(wuffs_gif__config_decoder);
 }
 
-// -------- func gif.config_decoder.decode_up_to_id_part1
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_up_to_id_part1(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
 
-  uint8_t v_block_type = 0;
+  {
+    wuffs_base__status z = wuffs_lzw__decoder__initialize(
+        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+wuffs_gif__decoder*  //
+wuffs_gif__decoder__alloc() {
+  wuffs_gif__decoder* x =
+      (wuffs_gif__decoder*)(calloc(sizeof(wuffs_gif__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gif__decoder__initialize(x, sizeof(wuffs_gif__decoder),
+                                     WUFFS_VERSION,
+                                     WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
   }
+  return x;
+}
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+size_t  //
+sizeof__wuffs_gif__decoder() {
+  return sizeof(wuffs_gif__decoder);
+}
 
-    if (!self->private_impl.f_restarted) {
-      if (self->private_impl.f_call_sequence != 2) {
-        self->private_impl.f_frame_config_io_position =
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src)));
-      }
-    } else if (self->private_impl.f_frame_config_io_position !=
-               wuffs_base__u64__sat_add(a_src->meta.pos,
-                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
-      goto exit;
-    } else {
-      self->private_impl.f_restarted = false;
+// ---------------- Function Implementations
+
+// -------- func gif.config_decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__set_quirk_enabled(wuffs_gif__config_decoder* self,
+                                             uint32_t a_quirk,
+                                             bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if ((self->private_impl.f_call_sequence == 0) && (a_quirk >= 1041635328)) {
+    a_quirk -= 1041635328;
+    if (a_quirk < 7) {
+      self->private_impl.f_quirks[a_quirk] = a_enabled;
     }
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_type = t_0;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.config_decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
+                                               wuffs_base__image_config* a_dst,
+                                               wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  bool v_ffio = false;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__config_decoder__decode_header(self, a_src);
+      if (status.repr) {
+        goto suspend;
       }
-      if (v_block_type == 33) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        status = wuffs_gif__config_decoder__decode_extension(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (v_block_type == 44) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__config_decoder__decode_id_part0(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-        goto label__0__break;
-      } else if (v_block_type == 59) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        self->private_impl.f_end_of_data = true;
-        goto label__0__break;
-      } else {
-        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
-        goto exit;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__config_decoder__decode_lsd(self, a_src);
+      if (status.repr) {
+        goto suspend;
       }
+    } else if (self->private_impl.f_call_sequence != 2) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
     }
-  label__0__break:;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_ffio = !self->private_impl.f_gc_has_transparent_index;
+    if (!self->private_impl.f_quirks[2]) {
+      v_ffio =
+          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
+           (self->private_impl.f_frame_rect_y0 == 0) &&
+           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
+           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
+    } else if (v_ffio) {
+      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    }
+    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
+      self->private_impl.f_background_color_u32_argb_premul =
+          self->private_impl.f_black_color_u32_argb_premul;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst, 1191444488, 0, self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position, v_ffio);
+    }
+    self->private_impl.f_call_sequence = 3;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    self->private_impl.p_decode_image_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_up_to_id_part1[0] =
+  self->private_impl.p_decode_image_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
-
   return status;
 }
 
-// -------- func gif.config_decoder.decode_header
+// -------- func gif.config_decoder.set_report_metadata
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
-                                         wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__set_report_metadata(wuffs_gif__config_decoder* self,
+                                               uint32_t a_fourcc,
+                                               bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
 
-  uint8_t v_c[6] = {0};
-  uint32_t v_i = 0;
+  if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1481461792) {
+    self->private_impl.f_report_metadata_xmp = a_report;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.config_decoder.ack_metadata_chunk
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
+                                              wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17490,44 +23116,59 @@ wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
-  if (coro_susp_point) {
-    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
-    v_i = self->private_data.s_decode_header[0].v_i;
-  }
+  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (v_i < 6) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_c[v_i] = t_0;
-      }
-      v_i += 1;
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
     }
-    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
-        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+    if (wuffs_base__u64__sat_add(a_src->meta.pos,
+                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
+        self->private_impl.f_metadata_io_position) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
       goto exit;
     }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_header[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_header[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
-  self->private_data.s_decode_header[0].v_i = v_i;
+    if (self->private_impl.f_metadata_chunk_length_value > 0) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+      self->private_impl.f_metadata_chunk_length_value =
+          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+      if (self->private_impl.f_metadata_chunk_length_value > 0) {
+        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      (iop_a_src += 1, wuffs_base__make_empty_struct());
+    }
+    self->private_impl.f_call_sequence = 2;
+    self->private_impl.f_metadata_fourcc_value = 0;
+    self->private_impl.f_metadata_io_position = 0;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
+    goto ok;
+  ok:
+    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_ack_metadata_chunk[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
 
   goto exit;
 exit:
@@ -17535,22 +23176,185 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.config_decoder.decode_lsd
+// -------- func gif.config_decoder.metadata_fourcc
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src) {
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__config_decoder__metadata_fourcc(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_fourcc_value;
+}
+
+// -------- func gif.config_decoder.metadata_chunk_length
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__metadata_chunk_length(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_chunk_length_value;
+}
+
+// -------- func gif.config_decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__config_decoder__num_animation_loops(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_seen_num_loops) {
+    return self->private_impl.f_num_loops;
+  }
+  return 1;
+}
+
+// -------- func gif.config_decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__num_decoded_frame_configs(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frame_configs_value;
+}
+
+// -------- func gif.config_decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__num_decoded_frames(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frames_value;
+}
+
+// -------- func gif.config_decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_gif__config_decoder__frame_dirty_rect(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  return wuffs_base__utility__empty_rect_ie_u32();
+}
+
+// -------- func gif.config_decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gif__config_decoder__workbuf_len(const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__empty_range_ii_u64();
+}
+
+// -------- func gif.config_decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__restart_frame(wuffs_gif__config_decoder* self,
+                                         uint64_t a_index,
+                                         uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  self->private_impl.f_delayed_num_decoded_frames = false;
+  self->private_impl.f_end_of_data = false;
+  self->private_impl.f_restarted = true;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  self->private_impl.f_num_decoded_frame_configs_value = a_index;
+  self->private_impl.f_num_decoded_frames_value = a_index;
+  wuffs_gif__config_decoder__reset_gc(self);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.config_decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
+                                               wuffs_base__frame_config* a_dst,
+                                               wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint32_t v_background_color = 0;
   uint8_t v_flags = 0;
-  uint8_t v_background_color_index = 0;
-  uint32_t v_num_palette_entries = 0;
-  uint32_t v_i = 0;
-  uint32_t v_j = 0;
-  uint32_t v_argb = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17563,191 +23367,113 @@ wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
   if (coro_susp_point) {
-    v_flags = self->private_data.s_decode_lsd[0].v_flags;
-    v_background_color_index =
-        self->private_data.s_decode_lsd[0].v_background_color_index;
-    v_num_palette_entries =
-        self->private_data.s_decode_lsd[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_lsd[0].v_i;
+    v_background_color =
+        self->private_data.s_decode_frame_config[0].v_background_color;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+    self->private_impl.f_ignore_metadata = true;
+    if (!self->private_impl.f_end_of_data) {
+      if (self->private_impl.f_call_sequence == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-      }
-      self->private_impl.f_width = t_0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status =
+            wuffs_gif__config_decoder__decode_image_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (self->private_impl.f_call_sequence != 3) {
+        if (self->private_impl.f_call_sequence == 4) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
           }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          status = wuffs_gif__config_decoder__skip_frame(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
           }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
         }
       }
-      self->private_impl.f_height = t_1;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_2 = *iop_a_src++;
-      v_flags = t_2;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_3 = *iop_a_src++;
-      v_background_color_index = t_3;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-      goto suspend;
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
     }
-    iop_a_src++;
-    v_i = 0;
-    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
-    if (self->private_impl.f_has_global_palette) {
-      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
-      while (v_i < v_num_palette_entries) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
-            iop_a_src += 3;
-          } else {
-            self->private_data.s_decode_lsd[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
-              if (num_bits_4 == 16) {
-                t_4 = ((uint32_t)(*scratch >> 40));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4));
-            }
-          }
-          v_argb = t_4;
+    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+    if (!self->private_impl.f_gc_has_transparent_index) {
+      v_background_color =
+          self->private_impl.f_background_color_u32_argb_premul;
+      if (self->private_impl.f_quirks[1] &&
+          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
         }
-        v_argb |= 4278190080;
-        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
-            ((uint8_t)(((v_argb >> 0) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
-            ((uint8_t)(((v_argb >> 8) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
-            ((uint8_t)(((v_argb >> 16) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
-            ((uint8_t)(((v_argb >> 24) & 255)));
-        v_i += 1;
-      }
-      if (self->private_impl.f_quirks[2]) {
-        if ((v_background_color_index != 0) &&
-            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
-          v_j = (4 * ((uint32_t)(v_background_color_index)));
-          self->private_impl.f_background_color_u32_argb_premul =
-              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
-                << 0) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
-                << 8) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
-                << 16) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
-                << 24));
-        } else {
-          self->private_impl.f_background_color_u32_argb_premul = 77;
+        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
+        if ((v_flags & 128) != 0) {
+          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
         }
       }
     }
-    while (v_i < 256) {
-      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
-      v_i += 1;
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__update(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                   self->private_impl.f_height),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                   self->private_impl.f_height)),
+          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
+          self->private_impl.f_num_decoded_frame_configs_value,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_gc_disposal,
+          !self->private_impl.f_gc_has_transparent_index, false,
+          v_background_color);
     }
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_lsd[0] = 0;
+    self->private_impl.p_decode_frame_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_lsd[0] =
+  self->private_impl.p_decode_frame_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_lsd[0].v_flags = v_flags;
-  self->private_data.s_decode_lsd[0].v_background_color_index =
-      v_background_color_index;
-  self->private_data.s_decode_lsd[0].v_num_palette_entries =
-      v_num_palette_entries;
-  self->private_data.s_decode_lsd[0].v_i = v_i;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame_config[0].v_background_color =
+      v_background_color;
 
   goto exit;
 exit:
@@ -17755,17 +23481,21 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.config_decoder.decode_extension
+// -------- func gif.config_decoder.skip_frame
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
-                                            wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_label = 0;
+  uint8_t v_flags = 0;
+  uint8_t v_lw = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17778,7 +23508,7 @@ wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
@@ -17789,36 +23519,34 @@ wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
         goto suspend;
       }
       uint8_t t_0 = *iop_a_src++;
-      v_label = t_0;
+      v_flags = t_0;
     }
-    if (v_label == 249) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
+    if ((v_flags & 128) != 0) {
+      self->private_data.s_skip_frame[0].scratch =
+          (((uint32_t)(3)) << (1 + (v_flags & 7)));
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__config_decoder__decode_gc(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
+      if (self->private_data.s_skip_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
-    } else if (v_label == 255) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    }
+    {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      status = wuffs_gif__config_decoder__decode_ae(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
+      uint8_t t_1 = *iop_a_src++;
+      v_lw = t_1;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
     }
     if (a_src) {
       a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
@@ -17831,16 +23559,23 @@ wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
     if (status.repr) {
       goto suspend;
     }
+    if (self->private_impl.f_quirks[0]) {
+      self->private_impl.f_delayed_num_decoded_frames = true;
+    } else {
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_num_decoded_frames_value, 1);
+    }
+    wuffs_gif__config_decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_decode_extension[0] = 0;
+    self->private_impl.p_skip_frame[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_extension[0] =
+  self->private_impl.p_skip_frame[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -17852,14 +23587,71 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.skip_blocks
+// -------- func gif.config_decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_frame(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  status = wuffs_base__make_status(wuffs_base__error__unsupported_method);
+  goto exit;
+  goto ok;
+ok:
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.config_decoder.reset_gc
+
+static wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self) {
+  self->private_impl.f_call_sequence = 5;
+  self->private_impl.f_gc_has_transparent_index = false;
+  self->private_impl.f_gc_transparent_index = 0;
+  self->private_impl.f_gc_disposal = 0;
+  self->private_impl.f_gc_duration = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.config_decoder.decode_up_to_id_part1
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
-                                       wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_up_to_id_part1(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_size = 0;
+  uint8_t v_block_type = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17872,10 +23664,24 @@ wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
+    if (!self->private_impl.f_restarted) {
+      if (self->private_impl.f_call_sequence != 2) {
+        self->private_impl.f_frame_config_io_position =
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src)));
+      }
+    } else if (self->private_impl.f_frame_config_io_position !=
+               wuffs_base__u64__sat_add(a_src->meta.pos,
+                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+      goto exit;
+    } else {
+      self->private_impl.f_restarted = false;
+    }
     while (true) {
       {
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
@@ -17884,34 +23690,62 @@ wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
           goto suspend;
         }
         uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
+        v_block_type = t_0;
       }
-      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_blocks[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_blocks[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      if (v_block_type == 33) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_gif__config_decoder__decode_extension(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_block_type == 44) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__config_decoder__decode_id_part0(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__break;
+      } else if (v_block_type == 59) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        self->private_impl.f_end_of_data = true;
+        goto label__0__break;
+      } else {
+        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
+        goto exit;
       }
-      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
     }
+  label__0__break:;
 
     goto ok;
   ok:
-    self->private_impl.p_skip_blocks[0] = 0;
+    self->private_impl.p_decode_up_to_id_part1[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_blocks[0] =
+  self->private_impl.p_decode_up_to_id_part1[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -17923,19 +23757,15 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_ae
+// -------- func gif.config_decoder.decode_header
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
+                                         wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
-  uint8_t v_block_size = 0;
-  bool v_is_animexts = false;
-  bool v_is_netscape = false;
-  bool v_is_iccp = false;
-  bool v_is_xmp = false;
+  uint8_t v_c[6] = {0};
+  uint32_t v_i = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17948,18 +23778,15 @@ wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
   if (coro_susp_point) {
-    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
-    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
-    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
-    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
-    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
+    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
+    v_i = self->private_data.s_decode_header[0].v_i;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (true) {
+    while (v_i < 6) {
       {
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
         if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
@@ -17967,214 +23794,28 @@ wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
           goto suspend;
         }
         uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
-      }
-      if (v_block_size != 11) {
-        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        if (self->private_data.s_decode_ae[0].scratch >
-            ((uint64_t)(io2_a_src - iop_a_src))) {
-          self->private_data.s_decode_ae[0].scratch -=
-              ((uint64_t)(io2_a_src - iop_a_src));
-          iop_a_src = io2_a_src;
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        iop_a_src += self->private_data.s_decode_ae[0].scratch;
-        goto label__goto_done__break;
-      }
-      v_is_animexts = true;
-      v_is_netscape = true;
-      v_is_iccp = true;
-      v_is_xmp = true;
-      v_block_size = 0;
-      while (v_block_size < 11) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_1 = *iop_a_src++;
-          v_c = t_1;
-        }
-        v_is_animexts =
-            (v_is_animexts && (v_c == WUFFS_GIF__ANIMEXTS1DOT0[v_block_size]));
-        v_is_netscape =
-            (v_is_netscape && (v_c == WUFFS_GIF__NETSCAPE2DOT0[v_block_size]));
-        v_is_iccp =
-            (v_is_iccp && (v_c == WUFFS_GIF__ICCRGBG1012[v_block_size]));
-        v_is_xmp = (v_is_xmp && (v_c == WUFFS_GIF__XMPDATAXMP[v_block_size]));
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        v_block_size += 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
+        v_c[v_i] = t_0;
       }
-      if (v_is_animexts || v_is_netscape) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_2 = *iop_a_src++;
-          v_block_size = t_2;
-        }
-        if (v_block_size != 3) {
-          self->private_data.s_decode_ae[0].scratch =
-              ((uint32_t)(v_block_size));
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__goto_done__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_3 = *iop_a_src++;
-          v_c = t_3;
-        }
-        if (v_c != 1) {
-          self->private_data.s_decode_ae[0].scratch = 2;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__goto_done__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-            iop_a_src += 2;
-          } else {
-            self->private_data.s_decode_ae[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
-              *scratch <<= 8;
-              *scratch >>= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-              if (num_bits_4 == 8) {
-                t_4 = ((uint32_t)(*scratch));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4)) << 56;
-            }
-          }
-          self->private_impl.f_num_loops = t_4;
-        }
-        self->private_impl.f_seen_num_loops = true;
-        if ((0 < self->private_impl.f_num_loops) &&
-            (self->private_impl.f_num_loops <= 65535)) {
-          self->private_impl.f_num_loops += 1;
-        }
-      } else if (self->private_impl.f_ignore_metadata) {
-      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        self->private_impl.f_metadata_fourcc_value = 1229144912;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
-      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        if (self->private_impl.f_metadata_chunk_length_value > 0) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
-        }
-        self->private_impl.f_metadata_fourcc_value = 1481461792;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
-      }
-      goto label__goto_done__break;
-    }
-  label__goto_done__break:;
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
-    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      v_i += 1;
     }
-    if (status.repr) {
-      goto suspend;
+    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
+        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+      goto exit;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_ae[0] = 0;
+    self->private_impl.p_decode_header[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_ae[0] =
+  self->private_impl.p_decode_header[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
-  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
-  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
-  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
-  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
+  self->private_data.s_decode_header[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -18185,16 +23826,19 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_gc
+// -------- func gif.config_decoder.decode_lsd
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
   uint8_t v_flags = 0;
-  uint16_t v_gc_duration_centiseconds = 0;
+  uint8_t v_background_color_index = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_argb = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18207,49 +23851,56 @@ wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  if (coro_susp_point) {
+    v_flags = self->private_data.s_decode_lsd[0].v_flags;
+    v_background_color_index =
+        self->private_data.s_decode_lsd[0].v_background_color_index;
+    v_num_palette_entries =
+        self->private_data.s_decode_lsd[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_lsd[0].v_i;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
-    }
-    if (v_c != 4) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_flags = t_1;
-    }
-    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
-    v_flags = ((v_flags >> 2) & 7);
-    if (v_flags == 2) {
-      self->private_impl.f_gc_disposal = 1;
-    } else if ((v_flags == 3) || (v_flags == 4)) {
-      self->private_impl.f_gc_disposal = 2;
-    } else {
-      self->private_impl.f_gc_disposal = 0;
+      self->private_impl.f_width = t_0;
     }
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint16_t t_2;
+      uint32_t t_1;
       if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
         iop_a_src += 2;
       } else {
-        self->private_data.s_decode_gc[0].scratch = 0;
+        self->private_data.s_decode_lsd[0].scratch = 0;
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
         while (true) {
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
@@ -18257,31 +23908,29 @@ wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
           *scratch <<= 8;
           *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint16_t)(*scratch));
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
             break;
           }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
         }
       }
-      v_gc_duration_centiseconds = t_2;
+      self->private_impl.f_height = t_1;
     }
-    self->private_impl.f_gc_duration =
-        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
       if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      uint8_t t_3 = *iop_a_src++;
-      self->private_impl.f_gc_transparent_index = t_3;
+      uint8_t t_2 = *iop_a_src++;
+      v_flags = t_2;
     }
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
@@ -18289,24 +23938,104 @@ wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      uint8_t t_4 = *iop_a_src++;
-      v_c = t_4;
+      uint8_t t_3 = *iop_a_src++;
+      v_background_color_index = t_3;
     }
-    if (v_c != 0) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
     }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_gc[0] = 0;
+    iop_a_src++;
+    v_i = 0;
+    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
+    if (self->private_impl.f_has_global_palette) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_lsd[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+              if (num_bits_4 == 16) {
+                t_4 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4));
+            }
+          }
+          v_argb = t_4;
+        }
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
+            ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
+            ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
+            ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
+            ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      if (self->private_impl.f_quirks[2]) {
+        if ((v_background_color_index != 0) &&
+            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
+          v_j = (4 * ((uint32_t)(v_background_color_index)));
+          self->private_impl.f_background_color_u32_argb_premul =
+              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
+                << 0) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
+                << 8) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
+                << 16) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
+                << 24));
+        } else {
+          self->private_impl.f_background_color_u32_argb_premul = 77;
+        }
+      }
+    }
+    while (v_i < 256) {
+      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
+      v_i += 1;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_lsd[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_gc[0] =
+  self->private_impl.p_decode_lsd[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_lsd[0].v_flags = v_flags;
+  self->private_data.s_decode_lsd[0].v_background_color_index =
+      v_background_color_index;
+  self->private_data.s_decode_lsd[0].v_num_palette_entries =
+      v_num_palette_entries;
+  self->private_data.s_decode_lsd[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -18317,13 +24046,15 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_id_part0
+// -------- func gif.config_decoder.decode_extension
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
-                                           wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
+                                            wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_label = 0;
+
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18335,149 +24066,69 @@ wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
-        }
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
-      self->private_impl.f_frame_rect_x0 = t_0;
+      uint8_t t_0 = *iop_a_src++;
+      v_label = t_0;
     }
-    {
+    if (v_label == 249) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__config_decoder__decode_gc(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    } else if (v_label == 255) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
-        }
+      status = wuffs_gif__config_decoder__decode_ae(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
       }
-      self->private_impl.f_frame_rect_y0 = t_1;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      uint32_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
-        }
+      if (status.repr) {
+        goto suspend;
       }
-      self->private_impl.f_frame_rect_x1 = t_2;
+      status = wuffs_base__make_status(NULL);
+      goto ok;
     }
-    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-      uint32_t t_3;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
-          if (num_bits_3 == 8) {
-            t_3 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_3 += 8;
-          *scratch |= ((uint64_t)(num_bits_3)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y1 = t_3;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
     }
-    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
-    if ((self->private_impl.f_call_sequence == 0) &&
-        !self->private_impl.f_quirks[4]) {
-      self->private_impl.f_width = wuffs_base__u32__max(
-          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
-      self->private_impl.f_height = wuffs_base__u32__max(
-          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_id_part0[0] = 0;
+    self->private_impl.p_decode_extension[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_id_part0[0] =
+  self->private_impl.p_decode_extension[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -18489,173 +24140,91 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.set_quirk_enabled
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__decoder__set_quirk_enabled(wuffs_gif__decoder* self,
-                                      uint32_t a_quirk,
-                                      bool a_enabled) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
-  }
+// -------- func gif.config_decoder.skip_blocks
 
-  if ((self->private_impl.f_call_sequence == 0) && (a_quirk >= 1041635328)) {
-    a_quirk -= 1041635328;
-    if (a_quirk < 7) {
-      self->private_impl.f_quirks[a_quirk] = a_enabled;
-    }
-  }
-  return wuffs_base__make_empty_struct();
-}
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
+                                       wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-// -------- func gif.decoder.decode_image_config
+  uint8_t v_block_size = 0;
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
-                                        wuffs_base__image_config* a_dst,
-                                        wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 1)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
   }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  bool v_ffio = false;
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence == 0) {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__decoder__decode_header(self, a_src);
-      if (status.repr) {
-        goto suspend;
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
       }
+      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__decoder__decode_lsd(self, a_src);
-      if (status.repr) {
+      if (self->private_data.s_skip_blocks[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_blocks[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-    } else if (self->private_impl.f_call_sequence != 2) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
-    if (status.repr) {
-      goto suspend;
-    }
-    v_ffio = !self->private_impl.f_gc_has_transparent_index;
-    if (!self->private_impl.f_quirks[2]) {
-      v_ffio =
-          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
-           (self->private_impl.f_frame_rect_y0 == 0) &&
-           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
-           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
-    } else if (v_ffio) {
-      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
-    }
-    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
-      self->private_impl.f_background_color_u32_argb_premul =
-          self->private_impl.f_black_color_u32_argb_premul;
-    }
-    if (a_dst != NULL) {
-      wuffs_base__image_config__set(
-          a_dst, 1191444488, 0, self->private_impl.f_width,
-          self->private_impl.f_height,
-          self->private_impl.f_frame_config_io_position, v_ffio);
+      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
     }
-    self->private_impl.f_call_sequence = 3;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_image_config[0] = 0;
+    self->private_impl.p_skip_blocks[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_image_config[0] =
+  self->private_impl.p_skip_blocks[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 1 : 0;
 
   goto exit;
 exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
-  return status;
-}
-
-// -------- func gif.decoder.set_report_metadata
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__decoder__set_report_metadata(wuffs_gif__decoder* self,
-                                        uint32_t a_fourcc,
-                                        bool a_report) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (a_fourcc == 1229144912) {
-    self->private_impl.f_report_metadata_iccp = a_report;
-  } else if (a_fourcc == 1481461792) {
-    self->private_impl.f_report_metadata_xmp = a_report;
-  }
-  return wuffs_base__make_empty_struct();
+  return status;
 }
 
-// -------- func gif.decoder.ack_metadata_chunk
+// -------- func gif.config_decoder.decode_ae
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
-                                       wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 2)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_c = 0;
+  uint8_t v_block_size = 0;
+  bool v_is_animexts = false;
+  bool v_is_netscape = false;
+  bool v_is_iccp = false;
+  bool v_is_xmp = false;
+
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18667,248 +24236,382 @@ wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
+  if (coro_susp_point) {
+    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
+    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
+    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
+    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
+    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence != 1) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    if (wuffs_base__u64__sat_add(a_src->meta.pos,
-                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
-        self->private_impl.f_metadata_io_position) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
-      goto exit;
-    }
-    if (self->private_impl.f_metadata_chunk_length_value > 0) {
-      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
-      }
-      self->private_impl.f_metadata_chunk_length_value =
-          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-      if (self->private_impl.f_metadata_chunk_length_value > 0) {
-        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
         }
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
         goto ok;
       }
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-    }
-    self->private_impl.f_call_sequence = 2;
-    self->private_impl.f_metadata_fourcc_value = 0;
-    self->private_impl.f_metadata_io_position = 0;
-    status = wuffs_base__make_status(NULL);
-    goto ok;
-    goto ok;
-  ok:
-    self->private_impl.p_ack_metadata_chunk[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_ack_metadata_chunk[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 2 : 0;
-
+      if (v_block_size != 11) {
+        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (self->private_data.s_decode_ae[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_ae[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_ae[0].scratch;
+        goto label__goto_done__break;
+      }
+      v_is_animexts = true;
+      v_is_netscape = true;
+      v_is_iccp = true;
+      v_is_xmp = true;
+      v_block_size = 0;
+      while (v_block_size < 11) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_1 = *iop_a_src++;
+          v_c = t_1;
+        }
+        v_is_animexts =
+            (v_is_animexts && (v_c == WUFFS_GIF__ANIMEXTS1DOT0[v_block_size]));
+        v_is_netscape =
+            (v_is_netscape && (v_c == WUFFS_GIF__NETSCAPE2DOT0[v_block_size]));
+        v_is_iccp =
+            (v_is_iccp && (v_c == WUFFS_GIF__ICCRGBG1012[v_block_size]));
+        v_is_xmp = (v_is_xmp && (v_c == WUFFS_GIF__XMPDATAXMP[v_block_size]));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        v_block_size += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      }
+      if (v_is_animexts || v_is_netscape) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          v_block_size = t_2;
+        }
+        if (v_block_size != 3) {
+          self->private_data.s_decode_ae[0].scratch =
+              ((uint32_t)(v_block_size));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_3 = *iop_a_src++;
+          v_c = t_3;
+        }
+        if (v_c != 1) {
+          self->private_data.s_decode_ae[0].scratch = 2;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__goto_done__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_decode_ae[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          self->private_impl.f_num_loops = t_4;
+        }
+        self->private_impl.f_seen_num_loops = true;
+        if ((0 < self->private_impl.f_num_loops) &&
+            (self->private_impl.f_num_loops <= 65535)) {
+          self->private_impl.f_num_loops += 1;
+        }
+      } else if (self->private_impl.f_ignore_metadata) {
+      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+        }
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        self->private_impl.f_metadata_fourcc_value = 1229144912;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+        }
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        if (self->private_impl.f_metadata_chunk_length_value > 0) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_fourcc_value = 1481461792;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      goto label__goto_done__break;
+    }
+  label__goto_done__break:;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_ae[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_ae[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
+  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
+  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
+  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
+  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+
   goto exit;
 exit:
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.decoder.metadata_fourcc
-
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__decoder__metadata_fourcc(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
+// -------- func gif.config_decoder.decode_gc
 
-  return self->private_impl.f_metadata_fourcc_value;
-}
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-// -------- func gif.decoder.metadata_chunk_length
+  uint8_t v_c = 0;
+  uint8_t v_flags = 0;
+  uint16_t v_gc_duration_centiseconds = 0;
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__metadata_chunk_length(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  return self->private_impl.f_metadata_chunk_length_value;
-}
-
-// -------- func gif.decoder.num_animation_loops
+  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__decoder__num_animation_loops(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  if (self->private_impl.f_seen_num_loops) {
-    return self->private_impl.f_num_loops;
-  }
-  return 1;
-}
-
-// -------- func gif.decoder.num_decoded_frame_configs
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__num_decoded_frame_configs(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_num_decoded_frame_configs_value;
-}
-
-// -------- func gif.decoder.num_decoded_frames
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__num_decoded_frames(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_num_decoded_frames_value;
-}
-
-// -------- func gif.decoder.frame_dirty_rect
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
-wuffs_gif__decoder__frame_dirty_rect(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
-
-  return wuffs_base__utility__make_rect_ie_u32(
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                           self->private_impl.f_width),
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                           self->private_impl.f_height),
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                           self->private_impl.f_width),
-      wuffs_base__u32__min(self->private_impl.f_dirty_max_excl_y,
-                           self->private_impl.f_height));
-}
-
-// -------- func gif.decoder.workbuf_len
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if (v_c != 4) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_flags = t_1;
+    }
+    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
+    v_flags = ((v_flags >> 2) & 7);
+    if (v_flags == 2) {
+      self->private_impl.f_gc_disposal = 1;
+    } else if ((v_flags == 3) || (v_flags == 4)) {
+      self->private_impl.f_gc_disposal = 2;
+    } else {
+      self->private_impl.f_gc_disposal = 0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint16_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_gc[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint16_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      v_gc_duration_centiseconds = t_2;
+    }
+    self->private_impl.f_gc_duration =
+        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      self->private_impl.f_gc_transparent_index = t_3;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_4 = *iop_a_src++;
+      v_c = t_4;
+    }
+    if (v_c != 0) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gif__decoder__workbuf_len(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_range_ii_u64();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_range_ii_u64();
+    goto ok;
+  ok:
+    self->private_impl.p_decode_gc[0] = 0;
+    goto exit;
   }
 
-  return wuffs_base__utility__make_range_ii_u64(0, 0);
-}
-
-// -------- func gif.decoder.restart_frame
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_gc[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__restart_frame(wuffs_gif__decoder* self,
-                                  uint64_t a_index,
-                                  uint64_t a_io_position) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (self->private_impl.f_call_sequence == 0) {
-    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-  }
-  self->private_impl.f_delayed_num_decoded_frames = false;
-  self->private_impl.f_end_of_data = false;
-  self->private_impl.f_restarted = true;
-  self->private_impl.f_frame_config_io_position = a_io_position;
-  self->private_impl.f_num_decoded_frame_configs_value = a_index;
-  self->private_impl.f_num_decoded_frames_value = a_index;
-  wuffs_gif__decoder__reset_gc(self);
-  return wuffs_base__make_status(NULL);
+  return status;
 }
 
-// -------- func gif.decoder.decode_frame_config
+// -------- func gif.config_decoder.decode_id_part0
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
-                                        wuffs_base__frame_config* a_dst,
-                                        wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 3)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
+                                           wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_background_color = 0;
-  uint8_t v_flags = 0;
-
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18920,113 +24623,150 @@ wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
-  if (coro_susp_point) {
-    v_background_color =
-        self->private_data.s_decode_frame_config[0].v_background_color;
-  }
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_ignore_metadata = true;
-    self->private_impl.f_dirty_max_excl_y = 0;
-    if (!self->private_impl.f_end_of_data) {
-      if (self->private_impl.f_call_sequence == 0) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status = wuffs_gif__decoder__decode_image_config(self, NULL, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (self->private_impl.f_call_sequence != 3) {
-        if (self->private_impl.f_call_sequence == 4) {
-          if (a_src) {
-            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-          }
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          status = wuffs_gif__decoder__skip_frame(self, a_src);
-          if (a_src) {
-            iop_a_src = a_src->data.ptr + a_src->meta.ri;
-          }
-          if (status.repr) {
-            goto suspend;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
         }
       }
+      self->private_impl.f_frame_rect_x0 = t_0;
     }
-    if (self->private_impl.f_end_of_data) {
-      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
-      goto ok;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_y0 = t_1;
     }
-    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
-    if (!self->private_impl.f_gc_has_transparent_index) {
-      v_background_color =
-          self->private_impl.f_background_color_u32_argb_premul;
-      if (self->private_impl.f_quirks[1] &&
-          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
         }
-        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
-        if ((v_flags & 128) != 0) {
-          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+      }
+      self->private_impl.f_frame_rect_x1 = t_2;
+    }
+    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+          if (num_bits_3 == 8) {
+            t_3 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3)) << 56;
         }
       }
+      self->private_impl.f_frame_rect_y1 = t_3;
     }
-    if (a_dst != NULL) {
-      wuffs_base__frame_config__update(
-          a_dst,
-          wuffs_base__utility__make_rect_ie_u32(
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                                   self->private_impl.f_height),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
-                                   self->private_impl.f_height)),
-          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
-          self->private_impl.f_num_decoded_frame_configs_value,
-          self->private_impl.f_frame_config_io_position,
-          self->private_impl.f_gc_disposal,
-          !self->private_impl.f_gc_has_transparent_index, false,
-          v_background_color);
+    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
+    if ((self->private_impl.f_call_sequence == 0) &&
+        !self->private_impl.f_quirks[4]) {
+      self->private_impl.f_width = wuffs_base__u32__max(
+          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
+      self->private_impl.f_height = wuffs_base__u32__max(
+          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
     }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frame_configs_value, 1);
-    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_frame_config[0] = 0;
+    self->private_impl.p_decode_id_part0[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame_config[0] =
+  self->private_impl.p_decode_id_part0[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 3 : 0;
-  self->private_data.s_decode_frame_config[0].v_background_color =
-      v_background_color;
 
   goto exit;
 exit:
@@ -19034,121 +24774,154 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.decoder.skip_frame
+// -------- func gif.decoder.set_quirk_enabled
 
-static wuffs_base__status  //
-wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__decoder__set_quirk_enabled(wuffs_gif__decoder* self,
+                                      uint32_t a_quirk,
+                                      bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
 
-  uint8_t v_flags = 0;
-  uint8_t v_lw = 0;
+  if ((self->private_impl.f_call_sequence == 0) && (a_quirk >= 1041635328)) {
+    a_quirk -= 1041635328;
+    if (a_quirk < 7) {
+      self->private_impl.f_quirks[a_quirk] = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+// -------- func gif.decoder.decode_image_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
+                                        wuffs_base__image_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
   }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  bool v_ffio = false;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
+    if (self->private_impl.f_call_sequence == 0) {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__decoder__decode_header(self, a_src);
+      if (status.repr) {
         goto suspend;
       }
-      uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
-    }
-    if ((v_flags & 128) != 0) {
-      self->private_data.s_skip_frame[0].scratch =
-          (((uint32_t)(3)) << (1 + (v_flags & 7)));
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_frame[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_frame[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_skip_frame[0].scratch;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__decoder__decode_lsd(self, a_src);
+      if (status.repr) {
         goto suspend;
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_lw = t_1;
-    }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+    } else if (self->private_impl.f_call_sequence != 2) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
       goto exit;
     }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
-    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
     if (status.repr) {
       goto suspend;
     }
-    if (self->private_impl.f_quirks[0]) {
-      self->private_impl.f_delayed_num_decoded_frames = true;
-    } else {
-      wuffs_base__u64__sat_add_indirect(
-          &self->private_impl.f_num_decoded_frames_value, 1);
+    v_ffio = !self->private_impl.f_gc_has_transparent_index;
+    if (!self->private_impl.f_quirks[2]) {
+      v_ffio =
+          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
+           (self->private_impl.f_frame_rect_y0 == 0) &&
+           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
+           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
+    } else if (v_ffio) {
+      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
     }
-    wuffs_gif__decoder__reset_gc(self);
+    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
+      self->private_impl.f_background_color_u32_argb_premul =
+          self->private_impl.f_black_color_u32_argb_premul;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst, 1191444488, 0, self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position, v_ffio);
+    }
+    self->private_impl.f_call_sequence = 3;
 
     goto ok;
   ok:
-    self->private_impl.p_skip_frame[0] = 0;
+    self->private_impl.p_decode_image_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_frame[0] =
+  self->private_impl.p_decode_image_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
-
   return status;
 }
 
-// -------- func gif.decoder.decode_frame
+// -------- func gif.decoder.set_report_metadata
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__decoder__set_report_metadata(wuffs_gif__decoder* self,
+                                        uint32_t a_fourcc,
+                                        bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1481461792) {
+    self->private_impl.f_report_metadata_xmp = a_report;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.ack_metadata_chunk
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
-                                 wuffs_base__pixel_buffer* a_dst,
-                                 wuffs_base__io_buffer* a_src,
-                                 wuffs_base__pixel_blend a_blend,
-                                 wuffs_base__slice_u8 a_workbuf,
-                                 wuffs_base__decode_frame_options* a_opts) {
+wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
+                                       wuffs_base__io_buffer* a_src) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -19158,12 +24931,12 @@ wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
             ? wuffs_base__error__disabled_by_previous_error
             : wuffs_base__error__initialize_not_called);
   }
-  if (!a_dst || !a_src) {
+  if (!a_src) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 4)) {
+      (self->private_impl.active_coroutine != 2)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(
         wuffs_base__error__interleaved_coroutine_calls);
@@ -19171,176 +24944,396 @@ wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_ignore_metadata = true;
-    if (self->private_impl.f_call_sequence != 4) {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
-      if (status.repr) {
-        goto suspend;
-      }
-    }
-    if (self->private_impl.f_quirks[5] &&
-        ((self->private_impl.f_frame_rect_x0 ==
-          self->private_impl.f_frame_rect_x1) ||
-         (self->private_impl.f_frame_rect_y0 ==
-          self->private_impl.f_frame_rect_y1))) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
       goto exit;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-    status = wuffs_gif__decoder__decode_id_part1(self, a_dst, a_src, a_blend);
-    if (status.repr) {
-      goto suspend;
+    if (wuffs_base__u64__sat_add(a_src->meta.pos,
+                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
+        self->private_impl.f_metadata_io_position) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+      goto exit;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__decoder__decode_id_part2(self, a_dst, a_src, a_workbuf);
-    if (status.repr) {
-      goto suspend;
+    if (self->private_impl.f_metadata_chunk_length_value > 0) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+      self->private_impl.f_metadata_chunk_length_value =
+          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+      if (self->private_impl.f_metadata_chunk_length_value > 0) {
+        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      (iop_a_src += 1, wuffs_base__make_empty_struct());
     }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frames_value, 1);
-    wuffs_gif__decoder__reset_gc(self);
-
+    self->private_impl.f_call_sequence = 2;
+    self->private_impl.f_metadata_fourcc_value = 0;
+    self->private_impl.f_metadata_io_position = 0;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
     goto ok;
   ok:
-    self->private_impl.p_decode_frame[0] = 0;
+    self->private_impl.p_ack_metadata_chunk[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame[0] =
+  self->private_impl.p_ack_metadata_chunk[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 4 : 0;
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
 
   goto exit;
 exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
   if (wuffs_base__status__is_error(&status)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
   return status;
 }
 
-// -------- func gif.decoder.reset_gc
+// -------- func gif.decoder.metadata_fourcc
 
-static wuffs_base__empty_struct  //
-wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self) {
-  self->private_impl.f_call_sequence = 5;
-  self->private_impl.f_gc_has_transparent_index = false;
-  self->private_impl.f_gc_transparent_index = 0;
-  self->private_impl.f_gc_disposal = 0;
-  self->private_impl.f_gc_duration = 0;
-  return wuffs_base__make_empty_struct();
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__decoder__metadata_fourcc(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_fourcc_value;
 }
 
-// -------- func gif.decoder.decode_up_to_id_part1
+// -------- func gif.decoder.metadata_chunk_length
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
-                                          wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__metadata_chunk_length(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
 
-  uint8_t v_block_type = 0;
+  return self->private_impl.f_metadata_chunk_length_value;
+}
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+// -------- func gif.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__decoder__num_animation_loops(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+  if (self->private_impl.f_seen_num_loops) {
+    return self->private_impl.f_num_loops;
+  }
+  return 1;
+}
 
-    if (!self->private_impl.f_restarted) {
-      if (self->private_impl.f_call_sequence != 2) {
-        self->private_impl.f_frame_config_io_position =
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src)));
-      }
-    } else if (self->private_impl.f_frame_config_io_position !=
-               wuffs_base__u64__sat_add(a_src->meta.pos,
-                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
-      goto exit;
-    } else {
-      self->private_impl.f_restarted = false;
-    }
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_type = t_0;
-      }
-      if (v_block_type == 33) {
+// -------- func gif.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__num_decoded_frame_configs(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frame_configs_value;
+}
+
+// -------- func gif.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__num_decoded_frames(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frames_value;
+}
+
+// -------- func gif.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_gif__decoder__frame_dirty_rect(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  uint64_t v_scale_mask = 0;
+  uint64_t v_x0 = 0;
+  uint64_t v_y0 = 0;
+  uint64_t v_x1 = 0;
+  uint64_t v_y1 = 0;
+
+  v_x0 = ((uint64_t)(wuffs_base__u32__min(
+      wuffs_base__u32__max(self->private_impl.f_frame_rect_x0,
+                           self->private_impl.f_clip_rect_x0),
+      self->private_impl.f_clip_rect_x1)));
+  v_y0 = ((uint64_t)(wuffs_base__u32__min(
+      wuffs_base__u32__max(self->private_impl.f_frame_rect_y0,
+                           self->private_impl.f_clip_rect_y0),
+      self->private_impl.f_clip_rect_y1)));
+  v_x1 = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                          self->private_impl.f_clip_rect_x1)));
+  v_y1 = ((uint64_t)(wuffs_base__u32__min(self->private_impl.f_dirty_max_excl_y,
+                                          self->private_impl.f_clip_rect_y1)));
+  v_scale_mask = ((((uint64_t)(1)) << self->private_impl.f_scale_log2) - 1);
+  return wuffs_base__utility__make_rect_ie_u32(
+      ((uint32_t)((((v_x0 + v_scale_mask) >> self->private_impl.f_scale_log2) &
+                   4294967295))),
+      ((uint32_t)((((v_y0 + v_scale_mask) >> self->private_impl.f_scale_log2) &
+                   4294967295))),
+      ((uint32_t)((((v_x1 + v_scale_mask) >> self->private_impl.f_scale_log2) &
+                   4294967295))),
+      ((uint32_t)((((v_y1 + v_scale_mask) >> self->private_impl.f_scale_log2) &
+                   4294967295))));
+}
+
+// -------- func gif.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gif__decoder__workbuf_len(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func gif.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__restart_frame(wuffs_gif__decoder* self,
+                                  uint64_t a_index,
+                                  uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  self->private_impl.f_delayed_num_decoded_frames = false;
+  self->private_impl.f_end_of_data = false;
+  self->private_impl.f_restarted = true;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  self->private_impl.f_num_decoded_frame_configs_value = a_index;
+  self->private_impl.f_num_decoded_frames_value = a_index;
+  wuffs_gif__decoder__reset_gc(self);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
+                                        wuffs_base__frame_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_background_color = 0;
+  uint8_t v_flags = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  if (coro_susp_point) {
+    v_background_color =
+        self->private_data.s_decode_frame_config[0].v_background_color;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_ignore_metadata = true;
+    self->private_impl.f_dirty_max_excl_y = 0;
+    if (!self->private_impl.f_end_of_data) {
+      if (self->private_impl.f_call_sequence == 0) {
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        status = wuffs_gif__decoder__decode_extension(self, a_src);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_gif__decoder__decode_image_config(self, NULL, a_src);
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
         if (status.repr) {
           goto suspend;
         }
-      } else if (v_block_type == 44) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
+      } else if (self->private_impl.f_call_sequence != 3) {
+        if (self->private_impl.f_call_sequence == 4) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          status = wuffs_gif__decoder__skip_frame(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
         }
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__decoder__decode_id_part0(self, a_src);
+        status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
         if (status.repr) {
           goto suspend;
         }
-        goto label__0__break;
-      } else if (v_block_type == 59) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
+      }
+    }
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
+    }
+    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+    if (!self->private_impl.f_gc_has_transparent_index) {
+      v_background_color =
+          self->private_impl.f_background_color_u32_argb_premul;
+      if (self->private_impl.f_quirks[1] &&
+          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        }
+        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
+        if ((v_flags & 128) != 0) {
+          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
         }
-        self->private_impl.f_end_of_data = true;
-        goto label__0__break;
-      } else {
-        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
-        goto exit;
       }
     }
-  label__0__break:;
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__update(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                   self->private_impl.f_height),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                   self->private_impl.f_height)),
+          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
+          self->private_impl.f_num_decoded_frame_configs_value,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_gc_disposal,
+          !self->private_impl.f_gc_has_transparent_index, false,
+          v_background_color);
+    }
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    self->private_impl.p_decode_frame_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_up_to_id_part1[0] =
+  self->private_impl.p_decode_frame_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame_config[0].v_background_color =
+      v_background_color;
 
   goto exit;
 exit:
@@ -19348,18 +25341,21 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.decoder.decode_header
+// -------- func gif.decoder.skip_frame
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
-                                  wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c[6] = {0};
-  uint32_t v_i = 0;
+  uint8_t v_flags = 0;
+  uint8_t v_lw = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -19372,44 +25368,75 @@ wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
-  if (coro_susp_point) {
-    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
-    v_i = self->private_data.s_decode_header[0].v_i;
-  }
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (v_i < 6) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_c[v_i] = t_0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
-      v_i += 1;
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
     }
-    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
-        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+    if ((v_flags & 128) != 0) {
+      self->private_data.s_skip_frame[0].scratch =
+          (((uint32_t)(3)) << (1 + (v_flags & 7)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_lw = t_1;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
       goto exit;
     }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_quirks[0]) {
+      self->private_impl.f_delayed_num_decoded_frames = true;
+    } else {
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_num_decoded_frames_value, 1);
+    }
+    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_decode_header[0] = 0;
+    self->private_impl.p_skip_frame[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_header[0] =
+  self->private_impl.p_skip_frame[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
-  self->private_data.s_decode_header[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -19420,19 +25447,140 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_lsd
+// -------- func gif.decoder.decode_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
+                                 wuffs_base__pixel_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__pixel_blend a_blend,
+                                 wuffs_base__slice_u8 a_workbuf,
+                                 wuffs_base__decode_frame_options* a_opts) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 4)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__rect_ie_u32 v_clip = {0};
+  uint64_t v_n = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_ignore_metadata = true;
+    if (self->private_impl.f_call_sequence != 4) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    if (self->private_impl.f_quirks[5] &&
+        ((self->private_impl.f_frame_rect_x0 ==
+          self->private_impl.f_frame_rect_x1) ||
+         (self->private_impl.f_frame_rect_y0 ==
+          self->private_impl.f_frame_rect_y1))) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+      goto exit;
+    }
+    self->private_impl.f_scale_log2 = 0;
+    if (a_opts != NULL) {
+      v_clip = wuffs_base__decode_frame_options__dst_clip_rect(a_opts);
+      self->private_impl.f_scale_log2 =
+          wuffs_base__decode_frame_options__scale_log2(a_opts);
+    } else {
+      v_clip =
+          wuffs_base__utility__make_rect_ie_u32(0, 0, 4294967295, 4294967295);
+    }
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_width)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_height)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_width)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_height)))));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_gif__decoder__decode_id_part1(self, a_dst, a_src, a_blend);
+    if (status.repr) {
+      goto suspend;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_id_part2(self, a_dst, a_src, a_workbuf);
+    if (status.repr) {
+      goto suspend;
+    }
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frames_value, 1);
+    wuffs_gif__decoder__reset_gc(self);
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_frame[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 4 : 0;
+
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.reset_gc
+
+static wuffs_base__empty_struct  //
+wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self) {
+  self->private_impl.f_call_sequence = 5;
+  self->private_impl.f_gc_has_transparent_index = false;
+  self->private_impl.f_gc_transparent_index = 0;
+  self->private_impl.f_gc_disposal = 0;
+  self->private_impl.f_gc_duration = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.decoder.decode_up_to_id_part1
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
+                                          wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_flags = 0;
-  uint8_t v_background_color_index = 0;
-  uint32_t v_num_palette_entries = 0;
-  uint32_t v_i = 0;
-  uint32_t v_j = 0;
-  uint32_t v_argb = 0;
+  uint8_t v_block_type = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -19445,58 +25593,245 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
-  if (coro_susp_point) {
-    v_flags = self->private_data.s_decode_lsd[0].v_flags;
-    v_background_color_index =
-        self->private_data.s_decode_lsd[0].v_background_color_index;
-    v_num_palette_entries =
-        self->private_data.s_decode_lsd[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_lsd[0].v_i;
-  }
+  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
-        }
+    if (!self->private_impl.f_restarted) {
+      if (self->private_impl.f_call_sequence != 2) {
+        self->private_impl.f_frame_config_io_position =
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src)));
       }
-      self->private_impl.f_width = t_0;
+    } else if (self->private_impl.f_frame_config_io_position !=
+               wuffs_base__u64__sat_add(a_src->meta.pos,
+                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
+      goto exit;
+    } else {
+      self->private_impl.f_restarted = false;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_type = t_0;
+      }
+      if (v_block_type == 33) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_gif__decoder__decode_extension(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_block_type == 44) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__decoder__decode_id_part0(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__break;
+      } else if (v_block_type == 59) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        self->private_impl.f_end_of_data = true;
+        goto label__0__break;
+      } else {
+        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
+        goto exit;
+      }
+    }
+  label__0__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_up_to_id_part1[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_header
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
+                                  wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c[6] = {0};
+  uint32_t v_i = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  if (coro_susp_point) {
+    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
+    v_i = self->private_data.s_decode_header[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (v_i < 6) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c[v_i] = t_0;
+      }
+      v_i += 1;
+    }
+    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
+        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+      goto exit;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_header[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_header[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
+  self->private_data.s_decode_header[0].v_i = v_i;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.decoder.decode_lsd
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_flags = 0;
+  uint8_t v_background_color_index = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_argb = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  if (coro_susp_point) {
+    v_flags = self->private_data.s_decode_lsd[0].v_flags;
+    v_background_color_index =
+        self->private_data.s_decode_lsd[0].v_background_color_index;
+    v_num_palette_entries =
+        self->private_data.s_decode_lsd[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_lsd[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_width = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
             status =
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
@@ -20834,6 +27169,7 @@ wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
   uint32_t v_replicate_y1 = 0;
   wuffs_base__slice_u8 v_replicate_dst = {0};
   wuffs_base__slice_u8 v_replicate_src = {0};
+  uint32_t v_scale_mask = 0;
 
   v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_pb);
   v_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt);
@@ -20841,7 +27177,10 @@ wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
     return wuffs_base__make_status(wuffs_base__error__unsupported_option);
   }
   v_bytes_per_pixel = (v_bits_per_pixel >> 3);
-  v_width_in_bytes = (((uint64_t)(self->private_impl.f_width)) *
+  v_scale_mask = ((((uint32_t)(1)) << self->private_impl.f_scale_log2) - 1);
+  v_width_in_bytes = (((((uint64_t)(self->private_impl.f_clip_rect_x1)) +
+                        ((uint64_t)(v_scale_mask))) >>
+                       self->private_impl.f_scale_log2) *
                       ((uint64_t)(v_bytes_per_pixel)));
   v_tab = wuffs_base__pixel_buffer__plane(a_pb, 0);
 label__0__continue:;
@@ -20853,26 +27192,39 @@ label__0__continue:;
       }
       return wuffs_base__make_status(wuffs_base__error__too_much_data);
     }
-    v_dst = wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
-    if (self->private_impl.f_dst_y >= self->private_impl.f_height) {
+    v_dst = wuffs_base__table_u8__row(
+        v_tab, (self->private_impl.f_dst_y >> self->private_impl.f_scale_log2));
+    if ((self->private_impl.f_dst_y < self->private_impl.f_clip_rect_y0) ||
+        (self->private_impl.f_dst_y >= self->private_impl.f_clip_rect_y1) ||
+        ((self->private_impl.f_dst_y & v_scale_mask) != 0)) {
       v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
     } else if (v_width_in_bytes < ((uint64_t)(v_dst.len))) {
       v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_width_in_bytes);
     }
-    v_i = (((uint64_t)(self->private_impl.f_dst_x)) *
+    v_i = (((uint64_t)((self->private_impl.f_dst_x >>
+                        self->private_impl.f_scale_log2))) *
            ((uint64_t)(v_bytes_per_pixel)));
-    if (v_i < ((uint64_t)(v_dst.len))) {
-      v_j = (((uint64_t)(self->private_impl.f_frame_rect_x1)) *
+    if ((self->private_impl.f_clip_rect_x0 <= self->private_impl.f_dst_x) &&
+        ((self->private_impl.f_dst_x & v_scale_mask) == 0) &&
+        (v_i < ((uint64_t)(v_dst.len)))) {
+      v_j = (((((uint64_t)(self->private_impl.f_frame_rect_x1)) +
+               ((uint64_t)(v_scale_mask))) >>
+              self->private_impl.f_scale_log2) *
              ((uint64_t)(v_bytes_per_pixel)));
       if ((v_i <= v_j) && (v_j <= ((uint64_t)(v_dst.len)))) {
         v_dst = wuffs_base__slice_u8__subslice_ij(v_dst, v_i, v_j);
       } else {
         v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
       }
-      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
+      v_n = ((uint64_t)(wuffs_base__u32__sat_sub(
+          self->private_impl.f_frame_rect_x1, self->private_impl.f_dst_x)));
+      if (v_n < ((uint64_t)(v_src.len))) {
+        v_src = wuffs_base__slice_u8__subslice_j(v_src, v_n);
+      }
+      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved_subsampled(
           &self->private_impl.f_swizzler, v_dst,
           wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024),
-          v_src);
+          v_src, (v_scale_mask + 1));
       wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
       wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
                                         ((uint32_t)((v_n & 4294967295))));
@@ -20888,25 +27240,52 @@ label__0__continue:;
       }
       if ((self->private_impl.f_num_decoded_frames_value == 0) &&
           !self->private_impl.f_gc_has_transparent_index &&
-          (self->private_impl.f_interlace > 1)) {
-        v_replicate_src =
-            wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
-        v_replicate_y0 =
-            wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1);
+          (self->private_impl.f_interlace > 1) &&
+          (self->private_impl.f_clip_rect_y0 <= self->private_impl.f_dst_y) &&
+          (self->private_impl.f_dst_y < self->private_impl.f_clip_rect_y1) &&
+          ((self->private_impl.f_dst_y & v_scale_mask) == 0)) {
+        v_i = (((((uint64_t)(self->private_impl.f_clip_rect_x0)) +
+                 ((uint64_t)(v_scale_mask))) >>
+                self->private_impl.f_scale_log2) *
+               ((uint64_t)(v_bytes_per_pixel)));
+        v_replicate_src = wuffs_base__table_u8__row(
+            v_tab,
+            (self->private_impl.f_dst_y >> self->private_impl.f_scale_log2));
+        if (v_width_in_bytes < ((uint64_t)(v_replicate_src.len))) {
+          v_replicate_src = wuffs_base__slice_u8__subslice_j(v_replicate_src,
+                                                             v_width_in_bytes);
+        }
+        if (v_i < ((uint64_t)(v_replicate_src.len))) {
+          v_replicate_src =
+              wuffs_base__slice_u8__subslice_i(v_replicate_src, v_i);
+        } else {
+          v_replicate_src =
+              wuffs_base__slice_u8__subslice_j(v_replicate_src, 0);
+        }
         v_replicate_y1 = wuffs_base__u32__sat_add(
             self->private_impl.f_dst_y,
             ((uint32_t)(
                 WUFFS_GIF__INTERLACE_COUNT[self->private_impl.f_interlace])));
         v_replicate_y1 = wuffs_base__u32__min(
             v_replicate_y1, self->private_impl.f_frame_rect_y1);
+        v_replicate_y1 = wuffs_base__u32__min(
+            v_replicate_y1, self->private_impl.f_clip_rect_y1);
+        self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
+            self->private_impl.f_dirty_max_excl_y, v_replicate_y1);
+        v_replicate_y0 = wuffs_base__u32__sat_add(
+            (self->private_impl.f_dst_y >> self->private_impl.f_scale_log2), 1);
+        v_replicate_y1 =
+            (wuffs_base__u32__sat_add(v_replicate_y1, v_scale_mask) >>
+             self->private_impl.f_scale_log2);
         while (v_replicate_y0 < v_replicate_y1) {
           v_replicate_dst = wuffs_base__table_u8__row(v_tab, v_replicate_y0);
-          wuffs_base__slice_u8__copy_from_slice(v_replicate_dst,
-                                                v_replicate_src);
+          if (v_i < ((uint64_t)(v_replicate_dst.len))) {
+            wuffs_base__slice_u8__copy_from_slice(
+                wuffs_base__slice_u8__subslice_i(v_replicate_dst, v_i),
+                v_replicate_src);
+          }
           v_replicate_y0 += 1;
         }
-        self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
-            self->private_impl.f_dirty_max_excl_y, v_replicate_y1);
       }
       wuffs_base__u32__sat_add_indirect(
           &self->private_impl.f_dst_y,
@@ -20937,6 +27316,19 @@ label__0__continue:;
     }
     v_n = ((uint64_t)(
         (self->private_impl.f_frame_rect_x1 - self->private_impl.f_dst_x)));
+    if (((uint64_t)(v_dst.len)) > 0) {
+      if (self->private_impl.f_clip_rect_x0 > self->private_impl.f_dst_x) {
+        v_n = wuffs_base__u64__min(
+            v_n, ((uint64_t)((self->private_impl.f_clip_rect_x0 -
+                              self->private_impl.f_dst_x))));
+      } else if ((self->private_impl.f_dst_x & v_scale_mask) != 0) {
+        v_n = wuffs_base__u64__min(
+            v_n, ((uint64_t)(wuffs_base__u32__sat_sub(
+                     wuffs_base__u32__sat_add(
+                         (self->private_impl.f_dst_x | v_scale_mask), 1),
+                     self->private_impl.f_dst_x))));
+      }
+    }
     v_n = wuffs_base__u64__min(v_n, (((uint64_t)(a_src.len)) - v_src_ri));
     wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
     wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
@@ -20964,11 +27356,6 @@ label__0__continue:;
       }
       goto label__0__continue;
     }
-    if (v_src_ri != ((uint64_t)(a_src.len))) {
-      return wuffs_base__make_status(
-          wuffs_gif__error__internal_error_inconsistent_ri_wi);
-    }
-    goto label__0__break;
   }
 label__0__break:;
   return wuffs_base__make_status(NULL);
@@ -20988,6 +27375,10 @@ const char* wuffs_gzip__error__bad_header = "#gzip: bad header";
 
 // ---------------- Private Consts
 
+#define WUFFS_GZIP__QUIRKS_BASE 1066916864
+
+#define WUFFS_GZIP__QUIRKS_COUNT 1
+
 // ---------------- Private Initializer Prototypes
 
 // ---------------- Private Function Prototypes
@@ -21007,124 +27398,667 @@ const wuffs_base__io_transformer__func_ptrs
             &wuffs_gzip__decoder__workbuf_len),
 };
 
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_gzip__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gzip__encoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_gzip__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gzip__encoder__workbuf_len),
+};
+
 // ---------------- Initializer Implementations
 
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
-                                size_t sizeof_star_self,
-                                uint64_t wuffs_version,
-                                uint32_t initialize_flags) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
-  }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_gzip__decoder*  //
+wuffs_gzip__decoder__alloc() {
+  wuffs_gzip__decoder* x =
+      (wuffs_gzip__decoder*)(calloc(sizeof(wuffs_gzip__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gzip__decoder__initialize(x, sizeof(wuffs_gzip__decoder),
+                                      WUFFS_VERSION,
+                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_gzip__decoder() {
+  return sizeof(wuffs_gzip__decoder);
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gzip__encoder__initialize(wuffs_gzip__encoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__encoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_gzip__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_gzip__encoder*  //
+wuffs_gzip__encoder__alloc() {
+  wuffs_gzip__encoder* x =
+      (wuffs_gzip__encoder*)(calloc(sizeof(wuffs_gzip__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_gzip__encoder__initialize(x, sizeof(wuffs_gzip__encoder),
+                                      WUFFS_VERSION,
+                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_gzip__encoder() {
+  return sizeof(wuffs_gzip__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func gzip.decoder.set_ignore_checksum
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_ignore_checksum = a_ic;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_quirk_enabled(wuffs_gzip__decoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  uint32_t v_q = 0;
+
+  if (a_quirk >= 1066916864) {
+    v_q = (a_quirk - 1066916864);
+    if (v_q < 1) {
+      self->private_impl.f_quirks[v_q] = a_enabled;
+      return wuffs_base__make_empty_struct();
+    }
+  }
+  wuffs_deflate__decoder__set_quirk_enabled(&self->private_data.f_flate,
+                                            a_quirk, a_enabled);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(1, 1);
+}
+
+// -------- func gzip.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_c = 0;
+  uint8_t v_flags = 0;
+  uint16_t v_xlen = 0;
+  uint64_t v_mark = 0;
+  uint32_t v_checksum_got = 0;
+  uint32_t v_decoded_length_got = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_want = 0;
+  uint32_t v_decoded_length_want = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_flags = self->private_data.s_transform_io[0].v_flags;
+    v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
+    v_decoded_length_got =
+        self->private_data.s_transform_io[0].v_decoded_length_got;
+    v_checksum_want = self->private_data.s_transform_io[0].v_checksum_want;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
+      }
+      if (v_c != 31) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_1 = *iop_a_src++;
+        v_c = t_1;
+      }
+      if (v_c != 139) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_2 = *iop_a_src++;
+        v_c = t_2;
+      }
+      if (v_c != 8) {
+        status =
+            wuffs_base__make_status(wuffs_gzip__error__bad_compression_method);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_3 = *iop_a_src++;
+        v_flags = t_3;
+      }
+      self->private_data.s_transform_io[0].scratch = 6;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_transform_io[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_transform_io[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_transform_io[0].scratch;
+      if ((v_flags & 4) != 0) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          uint16_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_transform_io[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint16_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          v_xlen = t_4;
+        }
+        self->private_data.s_transform_io[0].scratch = ((uint32_t)(v_xlen));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
+      }
+      if ((v_flags & 8) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_5 = *iop_a_src++;
+            v_c = t_5;
+          }
+          if (v_c == 0) {
+            goto label__0__break;
+          }
+        }
+      label__0__break:;
+      }
+      if ((v_flags & 16) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_6 = *iop_a_src++;
+            v_c = t_6;
+          }
+          if (v_c == 0) {
+            goto label__1__break;
+          }
+        }
+      label__1__break:;
+      }
+      if ((v_flags & 2) != 0) {
+        self->private_data.s_transform_io[0].scratch = 2;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
+      }
+      if ((v_flags & 224) != 0) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_encoding_flags);
+        goto exit;
+      }
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+        {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          wuffs_base__status t_7 = wuffs_deflate__decoder__transform_io(
+              &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          v_status = t_7;
+        }
+        if (!self->private_impl.f_ignore_checksum) {
+          v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
+              &self->private_data.f_checksum,
+              wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                    io0_a_dst));
+          v_decoded_length_got +=
+              ((uint32_t)((wuffs_base__io__count_since(
+                               v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))) &
+                           4294967295)));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__2__break;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(12);
+      }
+    label__2__break:;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+        uint32_t t_8;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_8 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
+            if (num_bits_8 == 24) {
+              t_8 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_8 += 8;
+            *scratch |= ((uint64_t)(num_bits_8)) << 56;
+          }
+        }
+        v_checksum_want = t_8;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+        uint32_t t_9;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_9 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_9 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_9;
+            if (num_bits_9 == 24) {
+              t_9 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_9 += 8;
+            *scratch |= ((uint64_t)(num_bits_9)) << 56;
+          }
+        }
+        v_decoded_length_want = t_9;
+      }
+      if (!self->private_impl.f_ignore_checksum &&
+          ((v_checksum_got != v_checksum_want) ||
+           (v_decoded_length_got != v_decoded_length_want))) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
+        goto exit;
+      }
+      v_decoded_length_got = 0;
+      wuffs_crc32__ieee_hasher__restart(&self->private_data.f_checksum);
+      if (!self->private_impl.f_quirks[0]) {
+        goto label__3__break;
+      }
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(NULL);
+          goto ok;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(17);
+      }
+    }
+  label__3__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
   }
 
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-    if (self->private_impl.magic != 0) {
-      return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
-    }
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
-    } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
-    }
-  }
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_flags = v_flags;
+  self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
+  self->private_data.s_transform_io[0].v_decoded_length_got =
+      v_decoded_length_got;
+  self->private_data.s_transform_io[0].v_checksum_want = v_checksum_want;
 
-  {
-    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
-        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
-  {
-    wuffs_base__status z = wuffs_deflate__decoder__initialize(
-        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
-}
 
-wuffs_gzip__decoder*  //
-wuffs_gzip__decoder__alloc() {
-  wuffs_gzip__decoder* x =
-      (wuffs_gzip__decoder*)(calloc(sizeof(wuffs_gzip__decoder), 1));
-  if (!x) {
-    return NULL;
-  }
-  if (wuffs_gzip__decoder__initialize(x, sizeof(wuffs_gzip__decoder),
-                                      WUFFS_VERSION,
-                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
-          .repr) {
-    free(x);
-    return NULL;
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
-  return x;
+  return status;
 }
 
-size_t  //
-sizeof__wuffs_gzip__decoder() {
-  return sizeof(wuffs_gzip__decoder);
-}
+// -------- func gzip.encoder.set_quirk_enabled
 
-// ---------------- Function Implementations
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__encoder__set_quirk_enabled(wuffs_gzip__encoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled) {
+  return wuffs_base__make_empty_struct();
+}
 
-// -------- func gzip.decoder.set_ignore_checksum
+// -------- func gzip.encoder.set_level
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic) {
+wuffs_gzip__encoder__set_level(wuffs_gzip__encoder* self, uint32_t a_level) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
   if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
     return wuffs_base__make_empty_struct();
   }
+  if (a_level > 9) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
 
-  self->private_impl.f_ignore_checksum = a_ic;
-  return wuffs_base__make_empty_struct();
-}
-
-// -------- func gzip.decoder.set_quirk_enabled
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gzip__decoder__set_quirk_enabled(wuffs_gzip__decoder* self,
-                                       uint32_t a_quirk,
-                                       bool a_enabled) {
+  self->private_impl.f_level_plus_1 = (a_level + 1);
+  wuffs_deflate__encoder__set_level(&self->private_data.f_flate, a_level);
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func gzip.decoder.workbuf_len
+// -------- func gzip.encoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self) {
+wuffs_gzip__encoder__workbuf_len(const wuffs_gzip__encoder* self) {
   if (!self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
@@ -21133,13 +28067,13 @@ wuffs_gzip__decoder__workbuf_len(const wuffs_gzip__decoder* self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  return wuffs_base__utility__make_range_ii_u64(1, 1);
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
 }
 
-// -------- func gzip.decoder.transform_io
+// -------- func gzip.encoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
+wuffs_gzip__encoder__transform_io(wuffs_gzip__encoder* self,
                                   wuffs_base__io_buffer* a_dst,
                                   wuffs_base__io_buffer* a_src,
                                   wuffs_base__slice_u8 a_workbuf) {
@@ -21165,15 +28099,11 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
-  uint8_t v_flags = 0;
-  uint16_t v_xlen = 0;
+  uint8_t v_xfl = 0;
   uint64_t v_mark = 0;
-  uint32_t v_checksum_got = 0;
-  uint32_t v_decoded_length_got = 0;
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
-  uint32_t v_checksum_want = 0;
-  uint32_t v_decoded_length_want = 0;
+  uint32_t v_checksum_got = 0;
+  uint32_t v_src_length = 0;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -21201,173 +28131,91 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
 
   uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   if (coro_susp_point) {
-    v_flags = self->private_data.s_transform_io[0].v_flags;
+    v_xfl = self->private_data.s_transform_io[0].v_xfl;
     v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
-    v_decoded_length_got =
-        self->private_data.s_transform_io[0].v_decoded_length_got;
-    v_checksum_want = self->private_data.s_transform_io[0].v_checksum_want;
+    v_src_length = self->private_data.s_transform_io[0].v_src_length;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
-    }
-    if (v_c != 31) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_1 = *iop_a_src++;
-      v_c = t_1;
+    v_xfl = 0;
+    if (self->private_impl.f_level_plus_1 == 10) {
+      v_xfl = 2;
+    } else if (self->private_impl.f_level_plus_1 == 2) {
+      v_xfl = 4;
     }
-    if (v_c != 139) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
-      goto exit;
+    self->private_data.s_transform_io[0].scratch = 31;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_2 = *iop_a_src++;
-      v_c = t_2;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 139;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    if (v_c != 8) {
-      status =
-          wuffs_base__make_status(wuffs_gzip__error__bad_compression_method);
-      goto exit;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 8;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_3 = *iop_a_src++;
-      v_flags = t_3;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    self->private_data.s_transform_io[0].scratch = 6;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-    if (self->private_data.s_transform_io[0].scratch >
-        ((uint64_t)(io2_a_src - iop_a_src))) {
-      self->private_data.s_transform_io[0].scratch -=
-          ((uint64_t)(io2_a_src - iop_a_src));
-      iop_a_src = io2_a_src;
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
       goto suspend;
     }
-    iop_a_src += self->private_data.s_transform_io[0].scratch;
-    if ((v_flags & 4) != 0) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        uint16_t t_4;
-        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-          t_4 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
-          iop_a_src += 2;
-        } else {
-          self->private_data.s_transform_io[0].scratch = 0;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-          while (true) {
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-            uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
-            *scratch <<= 8;
-            *scratch >>= 8;
-            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-            if (num_bits_4 == 8) {
-              t_4 = ((uint16_t)(*scratch));
-              break;
-            }
-            num_bits_4 += 8;
-            *scratch |= ((uint64_t)(num_bits_4)) << 56;
-          }
-        }
-        v_xlen = t_4;
-      }
-      self->private_data.s_transform_io[0].scratch = ((uint32_t)(v_xlen));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-      if (self->private_data.s_transform_io[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_transform_io[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_transform_io[0].scratch;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    if ((v_flags & 8) != 0) {
-      while (true) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_5 = *iop_a_src++;
-          v_c = t_5;
-        }
-        if (v_c == 0) {
-          goto label__0__break;
-        }
-      }
-    label__0__break:;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    if ((v_flags & 16) != 0) {
-      while (true) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_6 = *iop_a_src++;
-          v_c = t_6;
-        }
-        if (v_c == 0) {
-          goto label__1__break;
-        }
-      }
-    label__1__break:;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    if ((v_flags & 2) != 0) {
-      self->private_data.s_transform_io[0].scratch = 2;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
-      if (self->private_data.s_transform_io[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_transform_io[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_transform_io[0].scratch;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = v_xfl;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    if ((v_flags & 224) != 0) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_encoding_flags);
-      goto exit;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch = 255;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
     while (true) {
-      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      v_mark = ((uint64_t)(iop_a_src - io0_a_src));
       {
         if (a_dst) {
           a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
@@ -21375,7 +28223,7 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        wuffs_base__status t_7 = wuffs_deflate__decoder__transform_io(
+        wuffs_base__status t_0 = wuffs_deflate__encoder__transform_io(
             &self->private_data.f_flate, a_dst, a_src, a_workbuf);
         if (a_dst) {
           iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
@@ -21383,91 +28231,87 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
-        v_status = t_7;
-      }
-      if (!self->private_impl.f_ignore_checksum) {
-        v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
-            &self->private_data.f_checksum,
-            wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
-                                  io0_a_dst));
-        v_decoded_length_got +=
-            ((uint32_t)((wuffs_base__io__count_since(
-                             v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))) &
-                         4294967295)));
+        v_status = t_0;
       }
+      v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
+          &self->private_data.f_checksum,
+          wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_src - io0_a_src)),
+                                io0_a_src));
+      v_src_length +=
+          ((uint32_t)((wuffs_base__io__count_since(
+                           v_mark, ((uint64_t)(iop_a_src - io0_a_src))) &
+                       4294967295)));
       if (wuffs_base__status__is_ok(&v_status)) {
-        goto label__2__break;
+        goto label__0__break;
       }
       status = v_status;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(12);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
     }
-  label__2__break:;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
-      uint32_t t_8;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_8 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
-          if (num_bits_8 == 24) {
-            t_8 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_8 += 8;
-          *scratch |= ((uint64_t)(num_bits_8)) << 56;
-        }
-      }
-      v_checksum_want = t_8;
+  label__0__break:;
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)((v_checksum_got & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
-      uint32_t t_9;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_9 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_9 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_9;
-          if (num_bits_9 == 24) {
-            t_9 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_9 += 8;
-          *scratch |= ((uint64_t)(num_bits_9)) << 56;
-        }
-      }
-      v_decoded_length_want = t_9;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 8) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    if (!self->private_impl.f_ignore_checksum &&
-        ((v_checksum_got != v_checksum_want) ||
-         (v_decoded_length_got != v_decoded_length_want))) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
-      goto exit;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 16) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 24) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)((v_src_length & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_src_length >> 8) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_src_length >> 16) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_src_length >> 24) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(19);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
 
     goto ok;
   ok:
@@ -21481,11 +28325,9 @@ suspend:
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 1 : 0;
-  self->private_data.s_transform_io[0].v_flags = v_flags;
+  self->private_data.s_transform_io[0].v_xfl = v_xfl;
   self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
-  self->private_data.s_transform_io[0].v_decoded_length_got =
-      v_decoded_length_got;
-  self->private_data.s_transform_io[0].v_checksum_want = v_checksum_want;
+  self->private_data.s_transform_io[0].v_src_length = v_src_length;
 
   goto exit;
 exit:
@@ -21871,6 +28713,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
   uint32_t v_stack_bit = 0;
   uint32_t v_match = 0;
   uint32_t v_c4 = 0;
+  uint64_t v_c8 = 0;
   uint8_t v_c = 0;
   uint8_t v_backslash = 0;
   uint8_t v_char = 0;
@@ -21991,6 +28834,16 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
             goto label__outer__continue;
           }
           v_whitespace_length += 1;
+          while ((v_whitespace_length <= 65526) &&
+                 (((uint64_t)(io2_a_src - iop_a_src)) > 8)) {
+            if (wuffs_base__load_u64le__no_bounds_check(iop_a_src) !=
+                2314885530818453536) {
+              goto label__0__break;
+            }
+            (iop_a_src += 8, wuffs_base__make_empty_struct());
+            v_whitespace_length += 8;
+          }
+        label__0__break:;
         }
       label__ws__break:;
         if (v_whitespace_length > 0) {
@@ -22045,13 +28898,36 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
                 v_string_length = 0;
                 goto label__string_loop_outer__continue;
               }
+              while (((uint64_t)(io2_a_src - iop_a_src)) > 8) {
+                v_c8 = wuffs_base__load_u64le__no_bounds_check(iop_a_src);
+                if (0 != (9259542123273814144u &
+                          ((v_c8 - 2314885530818453536) |
+                           ((v_c8 ^ 2459565876494606882) - 72340172838076673) |
+                           ((v_c8 ^ 6655295901103053916) - 72340172838076673) |
+                           v_c8))) {
+                  goto label__1__break;
+                }
+                if (v_string_length > 65523) {
+                  *iop_a_dst++ = wuffs_base__make_token(
+                      (((uint64_t)(4194337))
+                       << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
+                      (((uint64_t)(1)) << WUFFS_BASE__TOKEN__CONTINUED__SHIFT) |
+                      (((uint64_t)(v_string_length))
+                       << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
+                  v_string_length = 0;
+                  goto label__string_loop_outer__continue;
+                }
+                (iop_a_src += 8, wuffs_base__make_empty_struct());
+                v_string_length += 8;
+              }
+            label__1__break:;
               while (((uint64_t)(io2_a_src - iop_a_src)) > 4) {
                 v_c4 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
                 if (0 != (WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 0))] |
                           WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 8))] |
                           WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 16))] |
                           WUFFS_JSON__LUT_CHARS[(255 & (v_c4 >> 24))])) {
-                  goto label__0__break;
+                  goto label__2__break;
                 }
                 (iop_a_src += 4, wuffs_base__make_empty_struct());
                 if (v_string_length > 65527) {
@@ -22066,7 +28942,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
                 }
                 v_string_length += 4;
               }
-            label__0__break:;
+            label__2__break:;
               v_c = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
               v_char = WUFFS_JSON__LUT_CHARS[v_c];
               if (v_char == 0) {
@@ -22383,12 +29259,12 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
                     v_backslash_x_ok &= v_c;
                     if ((v_backslash_x_ok == 0) ||
                         ((v_backslash_x_string & 65535) != 30812)) {
-                      goto label__1__break;
+                      goto label__3__break;
                     }
                     (iop_a_src += 4, wuffs_base__make_empty_struct());
                     v_backslash_x_length += 4;
                   }
-                label__1__break:;
+                label__3__break:;
                   if (v_backslash_x_length == 0) {
                     status = wuffs_base__make_status(
                         wuffs_json__error__bad_backslash_escape);
@@ -22630,7 +29506,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
             }
           }
         label__string_loop_outer__break:;
-        label__2__continue:;
+        label__4__continue:;
           while (true) {
             if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
               if (a_src && a_src->meta.closed) {
@@ -22640,22 +29516,22 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
               status =
                   wuffs_base__make_status(wuffs_base__suspension__short_read);
               WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(14);
-              goto label__2__continue;
+              goto label__4__continue;
             }
             if (((uint64_t)(io2_a_dst - iop_a_dst)) <= 0) {
               status =
                   wuffs_base__make_status(wuffs_base__suspension__short_write);
               WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(15);
-              goto label__2__continue;
+              goto label__4__continue;
             }
             (iop_a_src += 1, wuffs_base__make_empty_struct());
             *iop_a_dst++ = wuffs_base__make_token(
                 (((uint64_t)(4194323))
                  << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
                 (((uint64_t)(1)) << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
-            goto label__2__break;
+            goto label__4__break;
           }
-        label__2__break:;
+        label__4__break:;
           if (0 == (v_expect & (((uint32_t)(1)) << 4))) {
             v_expect = 4104;
             goto label__outer__continue;
@@ -22708,7 +29584,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
                    << WUFFS_BASE__TOKEN__VALUE_MINOR__SHIFT) |
                   (((uint64_t)(v_number_length))
                    << WUFFS_BASE__TOKEN__LENGTH__SHIFT));
-              goto label__3__break;
+              goto label__5__break;
             }
             while (v_number_length > 0) {
               v_number_length -= 1;
@@ -22740,7 +29616,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
                 if (status.repr) {
                   goto suspend;
                 }
-                goto label__3__break;
+                goto label__5__break;
               }
               status = wuffs_base__make_status(wuffs_json__error__bad_input);
               goto exit;
@@ -22759,7 +29635,7 @@ wuffs_json__decoder__decode_tokens(wuffs_json__decoder* self,
               }
             }
           }
-        label__3__break:;
+        label__5__break:;
           goto label__goto_parsed_a_leaf_value__break;
         } else if (v_class == 5) {
           v_vminor = 2113553;
@@ -24054,6 +30930,8 @@ wuffs_wbmp__decoder__decode_image_config(wuffs_wbmp__decoder* self,
     }
     self->private_impl.f_frame_config_io_position = wuffs_base__u64__sat_add(
         a_src->meta.pos, ((uint64_t)(iop_a_src - io0_a_src)));
+    self->private_impl.f_clip_rect_x1 = self->private_impl.f_width;
+    self->private_impl.f_clip_rect_y1 = self->private_impl.f_height;
     if (a_dst != NULL) {
       wuffs_base__image_config__set(
           a_dst, 1191444488, 0, self->private_impl.f_width,
@@ -24237,12 +31115,20 @@ wuffs_wbmp__decoder__decode_frame(wuffs_wbmp__decoder* self,
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__rect_ie_u32 v_clip = {0};
+  wuffs_base__pixel_format v_dst_pixfmt = {0};
+  uint32_t v_dst_bits_per_pixel = 0;
+  uint64_t v_dst_bytes_per_pixel = 0;
+  uint32_t v_scale_mask = 0;
+  uint64_t v_bytes_per_row = 0;
+  uint64_t v_n = 0;
   uint32_t v_dst_x = 0;
   uint32_t v_dst_y = 0;
   wuffs_base__table_u8 v_tab = {0};
   wuffs_base__slice_u8 v_dst = {0};
   uint8_t v_src[1] = {0};
   uint8_t v_c = 0;
+  uint64_t v_i = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -24257,6 +31143,10 @@ wuffs_wbmp__decoder__decode_frame(wuffs_wbmp__decoder* self,
 
   uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
   if (coro_susp_point) {
+    v_dst_bytes_per_pixel =
+        self->private_data.s_decode_frame[0].v_dst_bytes_per_pixel;
+    v_scale_mask = self->private_data.s_decode_frame[0].v_scale_mask;
+    v_bytes_per_row = self->private_data.s_decode_frame[0].v_bytes_per_row;
     v_dst_x = self->private_data.s_decode_frame[0].v_dst_x;
     v_dst_y = self->private_data.s_decode_frame[0].v_dst_y;
     memcpy(v_src, self->private_data.s_decode_frame[0].v_src, sizeof(v_src));
@@ -24299,15 +31189,65 @@ wuffs_wbmp__decoder__decode_frame(wuffs_wbmp__decoder* self,
       }
       goto ok;
     }
+    v_dst_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_dst);
+    v_dst_bits_per_pixel =
+        wuffs_base__pixel_format__bits_per_pixel(&v_dst_pixfmt);
+    if ((v_dst_bits_per_pixel & 7) != 0) {
+      status = wuffs_base__make_status(wuffs_base__error__unsupported_option);
+      goto exit;
+    }
+    v_dst_bytes_per_pixel = ((uint64_t)((v_dst_bits_per_pixel / 8)));
+    self->private_impl.f_scale_log2 = 0;
+    if (a_opts != NULL) {
+      v_clip = wuffs_base__decode_frame_options__dst_clip_rect(a_opts);
+      self->private_impl.f_scale_log2 =
+          wuffs_base__decode_frame_options__scale_log2(a_opts);
+    } else {
+      v_clip =
+          wuffs_base__utility__make_rect_ie_u32(0, 0, 4294967295, 4294967295);
+    }
+    v_scale_mask = ((((uint32_t)(1)) << self->private_impl.f_scale_log2) - 1);
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_width)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_max_excl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y1 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_height)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_x(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_x0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_clip_rect_x1)))));
+    v_n = (((uint64_t)(wuffs_base__rect_ie_u32__get_min_incl_y(&v_clip)))
+           << self->private_impl.f_scale_log2);
+    self->private_impl.f_clip_rect_y0 = ((uint32_t)(wuffs_base__u64__min(
+        v_n, ((uint64_t)(self->private_impl.f_clip_rect_y1)))));
+    v_bytes_per_row = ((((uint64_t)(self->private_impl.f_width)) + 7) / 8);
+    if (self->private_impl.f_clip_rect_x0 >=
+        self->private_impl.f_clip_rect_x1) {
+      self->private_impl.f_clip_rect_y0 = self->private_impl.f_clip_rect_y1;
+    }
+    self->private_data.s_decode_frame[0].scratch =
+        (v_bytes_per_row * ((uint64_t)(self->private_impl.f_clip_rect_y0)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (self->private_data.s_decode_frame[0].scratch >
+        ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_decode_frame[0].scratch -=
+          ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_decode_frame[0].scratch;
+    v_dst_y = self->private_impl.f_clip_rect_y0;
     if (self->private_impl.f_width > 0) {
-      v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
-      while (v_dst_y < self->private_impl.f_height) {
-        v_dst = wuffs_base__table_u8__row(v_tab, v_dst_y);
+      while (v_dst_y < self->private_impl.f_clip_rect_y1) {
         v_dst_x = 0;
         while (v_dst_x < self->private_impl.f_width) {
           if ((v_dst_x & 7) == 0) {
             {
-              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
               if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
                 status =
                     wuffs_base__make_status(wuffs_base__suspension__short_read);
@@ -24323,18 +31263,41 @@ wuffs_wbmp__decoder__decode_frame(wuffs_wbmp__decoder* self,
             v_src[0] = 255;
           }
           v_c = ((uint8_t)(((((uint32_t)(v_c)) << 1) & 255)));
-          wuffs_base__pixel_swizzler__swizzle_interleaved(
-              &self->private_impl.f_swizzler, v_dst,
-              wuffs_base__utility__empty_slice_u8(),
-              wuffs_base__make_slice_u8(v_src, 1));
-          if (((uint64_t)(v_dst.len)) >= 4) {
-            v_dst = wuffs_base__slice_u8__subslice_i(v_dst, 4);
+          if ((((v_dst_x | v_dst_y) & v_scale_mask) == 0) &&
+              (self->private_impl.f_clip_rect_x0 <= v_dst_x) &&
+              (v_dst_x < self->private_impl.f_clip_rect_x1)) {
+            v_tab = wuffs_base__pixel_buffer__plane(a_dst, 0);
+            v_dst = wuffs_base__table_u8__row(
+                v_tab, (v_dst_y >> self->private_impl.f_scale_log2));
+            v_i = (((uint64_t)((v_dst_x >> self->private_impl.f_scale_log2))) *
+                   v_dst_bytes_per_pixel);
+            if (v_i < ((uint64_t)(v_dst.len))) {
+              wuffs_base__pixel_swizzler__swizzle_interleaved(
+                  &self->private_impl.f_swizzler,
+                  wuffs_base__slice_u8__subslice_i(v_dst, v_i),
+                  wuffs_base__utility__empty_slice_u8(),
+                  wuffs_base__make_slice_u8(v_src, 1));
+            }
           }
           v_dst_x += 1;
         }
         v_dst_y += 1;
       }
     }
+    self->private_data.s_decode_frame[0].scratch =
+        (v_bytes_per_row *
+         ((uint64_t)(wuffs_base__u32__sat_sub(
+             self->private_impl.f_height, self->private_impl.f_clip_rect_y1))));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    if (self->private_data.s_decode_frame[0].scratch >
+        ((uint64_t)(io2_a_src - iop_a_src))) {
+      self->private_data.s_decode_frame[0].scratch -=
+          ((uint64_t)(io2_a_src - iop_a_src));
+      iop_a_src = io2_a_src;
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src += self->private_data.s_decode_frame[0].scratch;
     self->private_impl.f_call_sequence = 3;
 
     goto ok;
@@ -24349,6 +31312,10 @@ suspend:
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame[0].v_dst_bytes_per_pixel =
+      v_dst_bytes_per_pixel;
+  self->private_data.s_decode_frame[0].v_scale_mask = v_scale_mask;
+  self->private_data.s_decode_frame[0].v_bytes_per_row = v_bytes_per_row;
   self->private_data.s_decode_frame[0].v_dst_x = v_dst_x;
   self->private_data.s_decode_frame[0].v_dst_y = v_dst_y;
   memcpy(self->private_data.s_decode_frame[0].v_src, v_src, sizeof(v_src));
@@ -24478,8 +31445,26 @@ wuffs_wbmp__decoder__frame_dirty_rect(const wuffs_wbmp__decoder* self) {
     return wuffs_base__utility__empty_rect_ie_u32();
   }
 
-  return wuffs_base__utility__make_rect_ie_u32(0, 0, self->private_impl.f_width,
-                                               self->private_impl.f_height);
+  uint64_t v_scale_mask = 0;
+
+  v_scale_mask = ((((uint64_t)(1)) << self->private_impl.f_scale_log2) - 1);
+  return wuffs_base__utility__make_rect_ie_u32(
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_x0)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_y0)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_x1)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))),
+      ((uint32_t)((
+          ((((uint64_t)(self->private_impl.f_clip_rect_y1)) + v_scale_mask) >>
+           self->private_impl.f_scale_log2) &
+          4294967295))));
 }
 
 // -------- func wbmp.decoder.metadata_chunk_length
@@ -24635,6 +31620,16 @@ const char* wuffs_zlib__error__incorrect_dictionary =
 
 // ---------------- Private Consts
 
+#define WUFFS_ZLIB__QUIRKS_BASE 2113790976
+
+#define WUFFS_ZLIB__QUIRKS_COUNT 1
+
+static const uint8_t           //
+    WUFFS_ZLIB__FLG_BYTES[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1, 1, 94, 94, 94, 94, 156, 218, 218, 218,
+};
+
 // ---------------- Private Initializer Prototypes
 
 // ---------------- Private Function Prototypes
@@ -24654,10 +31649,118 @@ const wuffs_base__io_transformer__func_ptrs
             &wuffs_zlib__decoder__workbuf_len),
 };
 
-// ---------------- Initializer Implementations
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_zlib__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_zlib__encoder__set_quirk_enabled),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_zlib__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_zlib__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
+                                size_t sizeof_star_self,
+                                uint64_t wuffs_version,
+                                uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_dict_id_hasher,
+        sizeof(self->private_data.f_dict_id_hasher), WUFFS_VERSION,
+        initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_zlib__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_zlib__decoder*  //
+wuffs_zlib__decoder__alloc() {
+  wuffs_zlib__decoder* x =
+      (wuffs_zlib__decoder*)(calloc(sizeof(wuffs_zlib__decoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_zlib__decoder__initialize(x, sizeof(wuffs_zlib__decoder),
+                                      WUFFS_VERSION,
+                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_zlib__decoder() {
+  return sizeof(wuffs_zlib__decoder);
+}
 
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
+wuffs_zlib__encoder__initialize(wuffs_zlib__encoder* self,
                                 size_t sizeof_star_self,
                                 uint64_t wuffs_version,
                                 uint32_t initialize_flags) {
@@ -24705,120 +31808,456 @@ wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
     }
   }
   {
-    wuffs_base__status z = wuffs_adler32__hasher__initialize(
-        &self->private_data.f_dict_id_hasher,
-        sizeof(self->private_data.f_dict_id_hasher), WUFFS_VERSION,
-        initialize_flags);
-    if (z.repr) {
-      return z;
-    }
-  }
-  {
-    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+    wuffs_base__status z = wuffs_deflate__encoder__initialize(
         &self->private_data.f_flate, sizeof(self->private_data.f_flate),
         WUFFS_VERSION, initialize_flags);
     if (z.repr) {
       return z;
     }
-  }
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_zlib__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
-}
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_zlib__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+wuffs_zlib__encoder*  //
+wuffs_zlib__encoder__alloc() {
+  wuffs_zlib__encoder* x =
+      (wuffs_zlib__encoder*)(calloc(sizeof(wuffs_zlib__encoder), 1));
+  if (!x) {
+    return NULL;
+  }
+  if (wuffs_zlib__encoder__initialize(x, sizeof(wuffs_zlib__encoder),
+                                      WUFFS_VERSION,
+                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
+          .repr) {
+    free(x);
+    return NULL;
+  }
+  return x;
+}
+
+size_t  //
+sizeof__wuffs_zlib__encoder() {
+  return sizeof(wuffs_zlib__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func zlib.decoder.dictionary_id
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_zlib__decoder__dictionary_id(const wuffs_zlib__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_dict_id_want;
+}
+
+// -------- func zlib.decoder.add_dictionary
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
+                                    wuffs_base__slice_u8 a_dict) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (self->private_impl.f_header_complete) {
+    self->private_impl.f_bad_call_sequence = true;
+  } else {
+    self->private_impl.f_dict_id_got = wuffs_adler32__hasher__update_u32(
+        &self->private_data.f_dict_id_hasher, a_dict);
+    wuffs_deflate__decoder__add_history(&self->private_data.f_flate, a_dict);
+  }
+  self->private_impl.f_got_dictionary = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.set_ignore_checksum
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_ignore_checksum(wuffs_zlib__decoder* self, bool a_ic) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_ignore_checksum = a_ic;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_quirk_enabled(wuffs_zlib__decoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  uint32_t v_q = 0;
+
+  if (a_quirk >= 2113790976) {
+    v_q = (a_quirk - 2113790976);
+    if (v_q < 1) {
+      self->private_impl.f_quirks[v_q] = a_enabled;
+      return wuffs_base__make_empty_struct();
+    }
+  }
+  wuffs_deflate__decoder__set_quirk_enabled(&self->private_data.f_flate,
+                                            a_quirk, a_enabled);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_zlib__decoder__workbuf_len(const wuffs_zlib__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(1, 1);
+}
+
+// -------- func zlib.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  wuffs_base__io_buffer* a_src,
+                                  wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint16_t v_x = 0;
+  uint32_t v_checksum_got = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_want = 0;
+  uint64_t v_mark = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+    v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (true) {
+      if (self->private_impl.f_bad_call_sequence) {
+        status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+        goto exit;
+      } else if (!self->private_impl.f_want_dictionary) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          uint16_t t_0;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_0 = wuffs_base__load_u16be__no_bounds_check(iop_a_src);
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_transform_io[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+              uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+              if (num_bits_0 == 8) {
+                t_0 = ((uint16_t)(*scratch >> 48));
+                break;
+              }
+              num_bits_0 += 8;
+              *scratch |= ((uint64_t)(num_bits_0));
+            }
+          }
+          v_x = t_0;
+        }
+        if (((v_x >> 8) & 15) != 8) {
+          status = wuffs_base__make_status(
+              wuffs_zlib__error__bad_compression_method);
+          goto exit;
+        }
+        if ((v_x >> 12) > 7) {
+          status = wuffs_base__make_status(
+              wuffs_zlib__error__bad_compression_window_size);
+          goto exit;
+        }
+        if ((v_x % 31) != 0) {
+          status = wuffs_base__make_status(wuffs_zlib__error__bad_parity_check);
+          goto exit;
+        }
+        self->private_impl.f_want_dictionary = ((v_x & 32) != 0);
+        if (self->private_impl.f_want_dictionary) {
+          self->private_impl.f_dict_id_got = 1;
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            uint32_t t_1;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+              t_1 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
+              iop_a_src += 4;
+            } else {
+              self->private_data.s_transform_io[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(
+                      wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch =
+                    &self->private_data.s_transform_io[0].scratch;
+                uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+                *scratch >>= 8;
+                *scratch <<= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+                if (num_bits_1 == 24) {
+                  t_1 = ((uint32_t)(*scratch >> 32));
+                  break;
+                }
+                num_bits_1 += 8;
+                *scratch |= ((uint64_t)(num_bits_1));
+              }
+            }
+            self->private_impl.f_dict_id_want = t_1;
+          }
+          status =
+              wuffs_base__make_status(wuffs_zlib__note__dictionary_required);
+          goto ok;
+        } else if (self->private_impl.f_got_dictionary) {
+          status =
+              wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
+          goto exit;
+        }
+      } else if (self->private_impl.f_dict_id_got !=
+                 self->private_impl.f_dict_id_want) {
+        if (self->private_impl.f_got_dictionary) {
+          status =
+              wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
+          goto exit;
+        }
+        status = wuffs_base__make_status(wuffs_zlib__note__dictionary_required);
+        goto ok;
+      }
+      self->private_impl.f_header_complete = true;
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+        {
+          if (a_dst) {
+            a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+          }
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          wuffs_base__status t_2 = wuffs_deflate__decoder__transform_io(
+              &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+          if (a_dst) {
+            iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+          }
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          v_status = t_2;
+        }
+        if (!self->private_impl.f_ignore_checksum) {
+          v_checksum_got = wuffs_adler32__hasher__update_u32(
+              &self->private_data.f_checksum,
+              wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                    io0_a_dst));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__0__break;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+      }
+    label__0__break:;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        uint32_t t_3;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_3 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_3 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_3);
+            if (num_bits_3 == 24) {
+              t_3 = ((uint32_t)(*scratch >> 32));
+              break;
+            }
+            num_bits_3 += 8;
+            *scratch |= ((uint64_t)(num_bits_3));
+          }
+        }
+        v_checksum_want = t_3;
+      }
+      if (!self->private_impl.f_ignore_checksum &&
+          (v_checksum_got != v_checksum_want)) {
+        status = wuffs_base__make_status(wuffs_zlib__error__bad_checksum);
+        goto exit;
+      }
+      self->private_impl.f_header_complete = false;
+      self->private_impl.f_got_dictionary = false;
+      self->private_impl.f_want_dictionary = false;
+      wuffs_adler32__hasher__restart(&self->private_data.f_checksum);
+      wuffs_adler32__hasher__restart(&self->private_data.f_dict_id_hasher);
+      if (!self->private_impl.f_quirks[0]) {
+        goto label__1__break;
+      }
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if (a_src && a_src->meta.closed) {
+          status = wuffs_base__make_status(NULL);
+          goto ok;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(8);
+      }
+    }
+  label__1__break:;
 
-wuffs_zlib__decoder*  //
-wuffs_zlib__decoder__alloc() {
-  wuffs_zlib__decoder* x =
-      (wuffs_zlib__decoder*)(calloc(sizeof(wuffs_zlib__decoder), 1));
-  if (!x) {
-    return NULL;
-  }
-  if (wuffs_zlib__decoder__initialize(x, sizeof(wuffs_zlib__decoder),
-                                      WUFFS_VERSION,
-                                      WUFFS_INITIALIZE__ALREADY_ZEROED)
-          .repr) {
-    free(x);
-    return NULL;
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
   }
-  return x;
-}
-
-size_t  //
-sizeof__wuffs_zlib__decoder() {
-  return sizeof(wuffs_zlib__decoder);
-}
-
-// ---------------- Function Implementations
 
-// -------- func zlib.decoder.dictionary_id
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
 
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_zlib__decoder__dictionary_id(const wuffs_zlib__decoder* self) {
-  if (!self) {
-    return 0;
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  return self->private_impl.f_dict_id_want;
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
 }
 
-// -------- func zlib.decoder.add_dictionary
+// -------- func zlib.encoder.set_quirk_enabled
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
-                                    wuffs_base__slice_u8 a_dict) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
-  }
-
-  if (self->private_impl.f_header_complete) {
-    self->private_impl.f_bad_call_sequence = true;
-  } else {
-    self->private_impl.f_dict_id_got = wuffs_adler32__hasher__update_u32(
-        &self->private_data.f_dict_id_hasher, a_dict);
-    wuffs_deflate__decoder__add_history(&self->private_data.f_flate, a_dict);
-  }
-  self->private_impl.f_got_dictionary = true;
+wuffs_zlib__encoder__set_quirk_enabled(wuffs_zlib__encoder* self,
+                                       uint32_t a_quirk,
+                                       bool a_enabled) {
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func zlib.decoder.set_ignore_checksum
+// -------- func zlib.encoder.set_level
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_zlib__decoder__set_ignore_checksum(wuffs_zlib__decoder* self, bool a_ic) {
+wuffs_zlib__encoder__set_level(wuffs_zlib__encoder* self, uint32_t a_level) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
   if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
     return wuffs_base__make_empty_struct();
   }
+  if (a_level > 9) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
 
-  self->private_impl.f_ignore_checksum = a_ic;
-  return wuffs_base__make_empty_struct();
-}
-
-// -------- func zlib.decoder.set_quirk_enabled
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_zlib__decoder__set_quirk_enabled(wuffs_zlib__decoder* self,
-                                       uint32_t a_quirk,
-                                       bool a_enabled) {
+  self->private_impl.f_level_plus_1 = (a_level + 1);
+  wuffs_deflate__encoder__set_level(&self->private_data.f_flate, a_level);
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func zlib.decoder.workbuf_len
+// -------- func zlib.encoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_zlib__decoder__workbuf_len(const wuffs_zlib__decoder* self) {
+wuffs_zlib__encoder__workbuf_len(const wuffs_zlib__encoder* self) {
   if (!self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
@@ -24827,13 +32266,13 @@ wuffs_zlib__decoder__workbuf_len(const wuffs_zlib__decoder* self) {
     return wuffs_base__utility__empty_range_ii_u64();
   }
 
-  return wuffs_base__utility__make_range_ii_u64(1, 1);
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
 }
 
-// -------- func zlib.decoder.transform_io
+// -------- func zlib.encoder.transform_io
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
+wuffs_zlib__encoder__transform_io(wuffs_zlib__encoder* self,
                                   wuffs_base__io_buffer* a_dst,
                                   wuffs_base__io_buffer* a_src,
                                   wuffs_base__slice_u8 a_workbuf) {
@@ -24859,11 +32298,10 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint16_t v_x = 0;
-  uint32_t v_checksum_got = 0;
-  wuffs_base__status v_status = wuffs_base__make_status(NULL);
-  uint32_t v_checksum_want = 0;
+  uint32_t v_level = 0;
   uint64_t v_mark = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_checksum_got = 0;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -24891,112 +32329,33 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
 
   uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   if (coro_susp_point) {
+    v_level = self->private_data.s_transform_io[0].v_level;
     v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_bad_call_sequence) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    } else if (!self->private_impl.f_want_dictionary) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        uint16_t t_0;
-        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-          t_0 = wuffs_base__load_u16be__no_bounds_check(iop_a_src);
-          iop_a_src += 2;
-        } else {
-          self->private_data.s_transform_io[0].scratch = 0;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          while (true) {
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-            uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
-            *scratch >>= 8;
-            *scratch <<= 8;
-            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
-            if (num_bits_0 == 8) {
-              t_0 = ((uint16_t)(*scratch >> 48));
-              break;
-            }
-            num_bits_0 += 8;
-            *scratch |= ((uint64_t)(num_bits_0));
-          }
-        }
-        v_x = t_0;
-      }
-      if (((v_x >> 8) & 15) != 8) {
-        status =
-            wuffs_base__make_status(wuffs_zlib__error__bad_compression_method);
-        goto exit;
-      }
-      if ((v_x >> 12) > 7) {
-        status = wuffs_base__make_status(
-            wuffs_zlib__error__bad_compression_window_size);
-        goto exit;
-      }
-      if ((v_x % 31) != 0) {
-        status = wuffs_base__make_status(wuffs_zlib__error__bad_parity_check);
-        goto exit;
-      }
-      self->private_impl.f_want_dictionary = ((v_x & 32) != 0);
-      if (self->private_impl.f_want_dictionary) {
-        self->private_impl.f_dict_id_got = 1;
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-          uint32_t t_1;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-            t_1 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
-            iop_a_src += 4;
-          } else {
-            self->private_data.s_transform_io[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
-              if (num_bits_1 == 24) {
-                t_1 = ((uint32_t)(*scratch >> 32));
-                break;
-              }
-              num_bits_1 += 8;
-              *scratch |= ((uint64_t)(num_bits_1));
-            }
-          }
-          self->private_impl.f_dict_id_want = t_1;
-        }
-        status = wuffs_base__make_status(wuffs_zlib__note__dictionary_required);
-        goto ok;
-      } else if (self->private_impl.f_got_dictionary) {
-        status =
-            wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
-        goto exit;
-      }
-    } else if (self->private_impl.f_dict_id_got !=
-               self->private_impl.f_dict_id_want) {
-      if (self->private_impl.f_got_dictionary) {
-        status =
-            wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
-        goto exit;
-      }
-      status = wuffs_base__make_status(wuffs_zlib__note__dictionary_required);
-      goto ok;
+    v_level = 6;
+    if (self->private_impl.f_level_plus_1 > 0) {
+      v_level = (self->private_impl.f_level_plus_1 - 1);
+    }
+    self->private_data.s_transform_io[0].scratch = 120;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        WUFFS_ZLIB__FLG_BYTES[v_level];
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    self->private_impl.f_header_complete = true;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
     while (true) {
-      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      v_mark = ((uint64_t)(iop_a_src - io0_a_src));
       {
         if (a_dst) {
           a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
@@ -25004,7 +32363,7 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        wuffs_base__status t_2 = wuffs_deflate__decoder__transform_io(
+        wuffs_base__status t_0 = wuffs_deflate__encoder__transform_io(
             &self->private_data.f_flate, a_dst, a_src, a_workbuf);
         if (a_dst) {
           iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
@@ -25012,56 +32371,51 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
         }
-        v_status = t_2;
-      }
-      if (!self->private_impl.f_ignore_checksum) {
-        v_checksum_got = wuffs_adler32__hasher__update_u32(
-            &self->private_data.f_checksum,
-            wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
-                                  io0_a_dst));
+        v_status = t_0;
       }
+      v_checksum_got = wuffs_adler32__hasher__update_u32(
+          &self->private_data.f_checksum,
+          wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_src - io0_a_src)),
+                                io0_a_src));
       if (wuffs_base__status__is_ok(&v_status)) {
         goto label__0__break;
       }
       status = v_status;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
     }
   label__0__break:;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      uint32_t t_3;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_3 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_3 = ((uint32_t)(*scratch & 0xFF));
-          *scratch >>= 8;
-          *scratch <<= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_3);
-          if (num_bits_3 == 24) {
-            t_3 = ((uint32_t)(*scratch >> 32));
-            break;
-          }
-          num_bits_3 += 8;
-          *scratch |= ((uint64_t)(num_bits_3));
-        }
-      }
-      v_checksum_want = t_3;
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 24) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    if (!self->private_impl.f_ignore_checksum &&
-        (v_checksum_got != v_checksum_want)) {
-      status = wuffs_base__make_status(wuffs_zlib__error__bad_checksum);
-      goto exit;
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 16) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)(((v_checksum_got >> 8) & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+    self->private_data.s_transform_io[0].scratch =
+        ((uint8_t)((v_checksum_got & 255)));
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
 
     goto ok;
   ok:
@@ -25075,6 +32429,7 @@ suspend:
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_transform_io[0].v_level = v_level;
   self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
 
   goto exit;
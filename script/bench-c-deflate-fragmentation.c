@@ -240,6 +240,10 @@ decode_once(bool frag_dst, bool frag_idat) {
   if (!wuffs_base__status__is_ok(&status)) {
     return wuffs_base__status__message(&status);
   }
+  // Every dst fragment extends the same g_dst_buffer_array, so that there's
+  // no need to copy to the decoder's history buffer when suspending.
+  wuffs_zlib__decoder__set_quirk_enabled(
+      &dec, WUFFS_DEFLATE__QUIRK_CONTIGUOUS_DST, true);
 
   wuffs_base__io_buffer dst = ((wuffs_base__io_buffer){
       .data = ((wuffs_base__slice_u8){
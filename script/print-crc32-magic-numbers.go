@@ -58,5 +58,31 @@ func main1() error {
 			}
 		}
 	}
+
+	// X2N_TABLE[n] is x**(2**n) modulo the (bit-reflected) IEEE polynomial.
+	// See "Combining Checksums" in std/crc32/README.md.
+	fmt.Println()
+	x2n := uint32(0x40000000)
+	for n := 0; n < 32; n++ {
+		fmt.Printf("0x%08X,", x2n)
+		if n&7 == 7 {
+			fmt.Println()
+		}
+		x2n = multiplyModP(x2n, x2n)
+	}
 	return nil
 }
+
+func multiplyModP(a uint32, b uint32) (p uint32) {
+	for m := uint32(0x80000000); m != 0; m >>= 1 {
+		if a&m != 0 {
+			p ^= b
+		}
+		if b&1 != 0 {
+			b = (b >> 1) ^ crc32.IEEE
+		} else {
+			b >>= 1
+		}
+	}
+	return p
+}
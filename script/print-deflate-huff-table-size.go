@@ -92,7 +92,9 @@ package main
 //
 // See test/data/artificial/deflate-huffman-primlen-9.deflate* for an actual
 // example of valid Deflate-formatted data that exercises these worst-case code
-// lengths (for a primary table length of 9 bits).
+// lengths (for a primary table length of 9 bits). The std/deflate decoder now
+// uses a primary table length of 10 bits, exercised by the similar
+// test/data/artificial/deflate-huffman-primlen-10.deflate* files.
 //
 // Hypothetically, suppose that we used a primLen of 13 for the Distance table.
 // Here is a code length assignment that produces 20 secondary table entries:
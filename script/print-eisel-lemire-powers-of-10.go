@@ -0,0 +1,122 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// +build ignore
+
+package main
+
+// print-eisel-lemire-powers-of-10.go prints the
+// wuffs_base__private_implementation__powers_of_10 table, used by the
+// Eisel-Lemire algorithm in wuffs_base__parse_number_f64.
+//
+// Usage: go run print-eisel-lemire-powers-of-10.go -comments
+//
+// It also checks that, for every exponent e in the table's range, the linear
+// approximation ((217706 * e) >> 16) equals floor(log2(10 ** e)).
+
+import (
+	"flag"
+	"fmt"
+	"math/big"
+	"os"
+)
+
+var (
+	comments = flag.Bool("comments", false, "whether to print comments")
+)
+
+func main() {
+	if err := main1(); err != nil {
+		os.Stderr.WriteString(err.Error() + "\n")
+		os.Exit(1)
+	}
+}
+
+const (
+	minExp10 = -307
+	maxExp10 = +288
+)
+
+func main1() error {
+	flag.Parse()
+
+	fmt.Printf("static const uint64_t "+
+		"wuffs_base__private_implementation__powers_of_10[%d][2] = {\n",
+		1+maxExp10-minExp10)
+	for e := minExp10; e <= maxExp10; e++ {
+		if err := do(e); err != nil {
+			return err
+		}
+	}
+	fmt.Printf("};\n")
+
+	return nil
+}
+
+var (
+	one    = big.NewInt(1)
+	ten    = big.NewInt(10)
+	two128 = big.NewInt(0).Lsh(one, 128)
+	mask64 = big.NewInt(0).Sub(big.NewInt(0).Lsh(one, 64), one)
+)
+
+// N is large enough so that (1<<N) is bigger than 1e307, and so that
+// ((1<<N) / 1e307) still has more than 128 bits.
+const N = 2048
+
+func do(e int) error {
+	z := big.NewInt(0).Lsh(one, N)
+	if e >= 0 {
+		exp := big.NewInt(0).Exp(ten, big.NewInt(int64(+e)), nil)
+		z.Mul(z, exp)
+	} else {
+		exp := big.NewInt(0).Exp(ten, big.NewInt(int64(-e)), nil)
+		z.Div(z, exp)
+	}
+
+	// Truncate (round down), instead of rounding to nearest, so that each
+	// table entry is a lower bound on the exact power of 10. The C code
+	// relies on this when deciding whether its result is unambiguous.
+	n := int32(-N)
+	for z.Cmp(two128) >= 0 {
+		z.Rsh(z, 1)
+		n++
+	}
+	if z.BitLen() != 128 {
+		return fmt.Errorf("1e%d: invalid bit length %d", e, z.BitLen())
+	}
+
+	// log2 is floor(log2(10 ** e)), as the table entry is normalized to have
+	// 128 bits and its high bit is 1<<127.
+	log2 := n + 127
+	if approx := (217706 * int32(e)) >> 16; approx != log2 {
+		return fmt.Errorf("1e%d: linear approximation %d does not match %d",
+			e, approx, log2)
+	}
+
+	lo := big.NewInt(0).And(z, mask64)
+	hi := big.NewInt(0).Rsh(z, 64)
+	fmt.Printf("    {0x%016X, 0x%016X},", lo, hi)
+	if *comments {
+		fmt.Printf("  // 1e%-04d ≈ (0x%032X ", e, z)
+		if n >= 0 {
+			fmt.Printf("<< %4d)", +n)
+		} else {
+			fmt.Printf(">> %4d)", -n)
+		}
+	}
+
+	fmt.Println()
+	return nil
+}
@@ -0,0 +1,95 @@
+#!/bin/bash -eu
+# Copyright 2020 The Wuffs Authors.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# ----------------
+
+# This script checks example/jsonindex's answers to JSON Pointer queries. Each
+# test case builds an index for a small JSON document and then checks that a
+# query prints the expected value, or that it fails with "no match".
+
+jsonindex=${JSONINDEX:-gen/bin/example-jsonindex}
+if [ ! "$(command -v $jsonindex)" ]; then
+  if [ ${JSONINDEX:-} ]; then
+    echo "Could not run \$JSONINDEX ($jsonindex)."
+  else
+    echo "Could not run the default jsonindex (gen/bin/example-jsonindex)."
+    echo "Run \"./build-example.sh example/jsonindex\" from the Wuffs root directory."
+  fi
+  exit 1
+fi
+
+tmpdir=$(mktemp -d)
+trap "rm -rf $tmpdir" EXIT
+
+num_fail=0
+num_ok=0
+num_total=0
+
+# ----
+
+# test1 takes a JSON document, a query and the wanted output. An empty wanted
+# output means that the query should not match.
+test1() {
+  set +e
+
+  printf '%s' "$1" > $tmpdir/t.json
+  local have=
+  if $jsonindex build $tmpdir/t.json $tmpdir/t.idx 2>/dev/null; then
+    have=$($jsonindex -query="$2" query $tmpdir/t.json $tmpdir/t.idx 2>&1)
+  fi
+  if [ -z "$3" ] && [ "$have" = "main: no match for query" ]; then
+    have=
+  fi
+
+  if [ "$have" = "$3" ]; then
+    echo "ok      $1 $2"
+    ((num_ok++))
+  else
+    echo "fail    $1 $2: have \"$have\", want \"$3\""
+    ((num_fail++))
+  fi
+  ((num_total++))
+
+  set -e
+}
+
+# ----
+
+test1 '{"a":[10,{"b":true}]}'  ''       '{"a":[10,{"b":true}]}'
+test1 '{"a":[10,{"b":true}]}'  '/a'     '[10,{"b":true}]'
+test1 '{"a":[10,{"b":true}]}'  '/a/0'   '10'
+test1 '{"a":[10,{"b":true}]}'  '/a/1/b' 'true'
+test1 '{"a":[10,{"b":true}]}'  '/a/2'   ''
+test1 '{"a":[10,{"b":true}]}'  '/b'     ''
+test1 '{"~":1,"/":2,"~1":3}'   '/~0'    '1'
+test1 '{"~":1,"/":2,"~1":3}'   '/~1'    '2'
+test1 '{"~":1,"/":2,"~1":3}'   '/~01'   '3'
+test1 '{"\u0041":"ok"}'        '/A'     '"ok"'
+test1 '{"a":1,"a":[2]}'        '/a'     '[2]'
+test1 '{"a":1,"a":2}'          '/a'     '1'
+test1 '"top"'                  ''       '"top"'
+
+# A string value must not be mistaken for the key that follows it.
+test1 '{"a":"b","b":1}'        '/b'     '1'
+test1 '{"a":"b","b":[1]}'      '/b'     '[1]'
+test1 '{"x":"y","z":2}'        '/y'     ''
+test1 '{"x":"y","z":2}'        '/z'     '2'
+test1 '[{"a":"b","b":"c"}]'    '/0/b'   '"c"'
+test1 '{"a":{"c":"b"},"b":3}'  '/b'     '3'
+
+echo "$num_fail fail, $num_ok ok, $num_total total"
+if [ $num_fail -ne 0 ]; then
+  exit 1
+fi
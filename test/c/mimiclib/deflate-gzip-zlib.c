@@ -101,6 +101,24 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
   return "miniz does not implement zlib dictionaries";
 }
 
+const char*  //
+mimic_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return "miniz_tinfl.c does not implement encoding";
+}
+
+const char*  //
+mimic_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return "miniz_tinfl.c does not implement encoding";
+}
+
 #else  // WUFFS_MIMICLIB_USE_MINIZ_INSTEAD_OF_ZLIB
 #include "zlib.h"
 
@@ -299,4 +317,107 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
                                         UINT64_MAX, zlib_flavor_zlib);
 }
 
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     int level) {
+  const char* ret = NULL;
+  if (dst->data.len > UINT_MAX) {
+    ret = "dst length is too large";
+    goto cleanup0;
+  }
+  if (src->data.len > UINT_MAX) {
+    ret = "src length is too large";
+    goto cleanup0;
+  }
+
+  // A negative window_bits means raw deflate, without a zlib wrapper. 8 is
+  // zlib's default mem_level.
+  z_stream z = {0};
+  int di2_err = deflateInit2(&z, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  if (di2_err != Z_OK) {
+    ret = "deflateInit2 failed";
+    goto cleanup0;
+  }
+
+  while (true) {
+    // Compressing stops at the end of src, so it has to be closed.
+    if (!src->meta.closed && (src->meta.ri == src->meta.wi)) {
+      ret = "src is not closed";
+      goto cleanup1;
+    }
+
+    z.next_in = src->data.ptr + src->meta.ri;
+    z.avail_in = src->meta.wi - src->meta.ri;
+    if (z.avail_in > rlimit) {
+      z.avail_in = rlimit;
+    }
+    uInt initial_avail_in = z.avail_in;
+    bool finish =
+        src->meta.closed && (z.avail_in == (src->meta.wi - src->meta.ri));
+
+    z.next_out = dst->data.ptr + dst->meta.wi;
+    z.avail_out = dst->data.len - dst->meta.wi;
+    if (z.avail_out > wlimit) {
+      z.avail_out = wlimit;
+    }
+    uInt initial_avail_out = z.avail_out;
+
+    int d_err = deflate(&z, finish ? Z_FINISH : Z_NO_FLUSH);
+
+    if (initial_avail_in < z.avail_in) {
+      ret = "inconsistent avail_in";
+      goto cleanup1;
+    }
+    src->meta.ri += initial_avail_in - z.avail_in;
+
+    if (initial_avail_out < z.avail_out) {
+      ret = "inconsistent avail_out";
+      goto cleanup1;
+    }
+    dst->meta.wi += initial_avail_out - z.avail_out;
+
+    if (d_err == Z_STREAM_END) {
+      break;
+    } else if (d_err == Z_BUF_ERROR) {
+      if (z.avail_out == 0) {
+        ret = "deflate failed (dst is full)";
+        goto cleanup1;
+      }
+    } else if (d_err != Z_OK) {
+      ret = "deflate failed";
+      goto cleanup1;
+    }
+  }
+
+cleanup1:;
+  int de_err = deflateEnd(&z);
+  if ((de_err != Z_OK) && (de_err != Z_DATA_ERROR) && !ret) {
+    ret = "deflateEnd failed";
+  }
+
+cleanup0:;
+  return ret;
+}
+
+const char*  //
+mimic_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, wlimit, rlimit, 1);
+}
+
+const char*  //
+mimic_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, wlimit, rlimit, 6);
+}
+
 #endif  // WUFFS_MIMICLIB_USE_MINIZ_INSTEAD_OF_ZLIB
@@ -79,6 +79,16 @@ golden_test g_adler32_pi_gt = {
 
 // ---------------- Adler32 Tests
 
+// force_portable_implementation makes h skip the run-time CPU feature check,
+// the first time that update_u32 is called, so that it always uses the
+// portable (not SIMD) implementation.
+void  //
+force_portable_implementation(wuffs_adler32__hasher* h) {
+  h->private_impl.f_started = true;
+  h->private_impl.f_state = 1;
+  h->private_impl.choosy_up = &wuffs_adler32__hasher__up__choosy_default;
+}
+
 const char*  //
 test_wuffs_adler32_interface() {
   CHECK_FOCUS(__func__);
@@ -92,6 +102,58 @@ test_wuffs_adler32_interface() {
       "test/data/hat.lossy.webp", 0, SIZE_MAX, 0xF1BB258D);
 }
 
+const char*  //
+test_wuffs_adler32_combine() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/pi.txt"));
+  wuffs_base__slice_u8 whole = ((wuffs_base__slice_u8){
+      .ptr = src.data.ptr,
+      .len = src.meta.wi,
+  });
+
+  wuffs_adler32__hasher checksum;
+  CHECK_STATUS("initialize",
+               wuffs_adler32__hasher__initialize(
+                   &checksum, sizeof checksum, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  uint32_t want = wuffs_adler32__hasher__update_u32(&checksum, whole);
+
+  // 65521 and 65522 exercise the "other_length modulo 65521" code path.
+  size_t splits[] = {0, 1, 2, 3, 16, 100, 5552, 65521, 65522, 99999, SIZE_MAX};
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(splits); tc++) {
+    size_t split = wuffs_base__u64__min(splits[tc], whole.len);
+    wuffs_base__slice_u8 other = wuffs_base__slice_u8__subslice_i(whole, split);
+
+    CHECK_STATUS("initialize",
+                 wuffs_adler32__hasher__initialize(
+                     &checksum, sizeof checksum, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint32_t other_checksum =
+        wuffs_adler32__hasher__update_u32(&checksum, other);
+
+    CHECK_STATUS("initialize",
+                 wuffs_adler32__hasher__initialize(
+                     &checksum, sizeof checksum, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    if (split > 0) {
+      wuffs_adler32__hasher__update_u32(
+          &checksum, wuffs_base__slice_u8__subslice_j(whole, split));
+    }
+    uint32_t have = wuffs_adler32__hasher__combine_u32(
+        &checksum, other_checksum, other.len);
+    if (have != want) {
+      RETURN_FAIL("tc=%d, split=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                  tc, split, have, want);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_adler32_golden() {
   CHECK_FOCUS(__func__);
@@ -228,16 +290,62 @@ test_wuffs_adler32_pi() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_adler32_portable_vs_simd() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/pi.txt"));
+
+  // The lengths exercise the SIMD code's 32 byte steps and the 5536 or 5552
+  // byte chunks (between taking modulo 65521) of both implementations.
+  size_t lengths[] = {
+      0,    1,    15,   16,    17,    31,    32,    33,    63,
+      64,   65,   100,  1000,  5535,  5536,  5537,  5551,  5552,
+      5553, 5567, 5568, 11072, 11104, 11105, 65536, 99999, SIZE_MAX,
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(lengths); tc++) {
+    wuffs_base__slice_u8 data = ((wuffs_base__slice_u8){
+        .ptr = src.data.ptr,
+        .len = wuffs_base__u64__min(lengths[tc], src.meta.wi),
+    });
+
+    uint32_t have[2] = {0};
+    int j;
+    for (j = 0; j < 2; j++) {
+      wuffs_adler32__hasher checksum;
+      CHECK_STATUS("initialize",
+                   wuffs_adler32__hasher__initialize(
+                       &checksum, sizeof checksum, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      if (j > 0) {
+        force_portable_implementation(&checksum);
+      }
+      have[j] = wuffs_adler32__hasher__update_u32(&checksum, data);
+    }
+
+    if (have[0] != have[1]) {
+      RETURN_FAIL("tc=%d, len=%zu: default 0x%08" PRIX32
+                  ", portable 0x%08" PRIX32,
+                  tc, data.len, have[0], have[1]);
+    }
+  }
+  return NULL;
+}
+
 // ---------------- Adler32 Benches
 
 uint32_t g_wuffs_adler32_unused_u32;
 
 const char*  //
-wuffs_bench_adler32(wuffs_base__io_buffer* dst,
-                    wuffs_base__io_buffer* src,
-                    uint32_t wuffs_initialize_flags,
-                    uint64_t wlimit,
-                    uint64_t rlimit) {
+do_wuffs_bench_adler32(wuffs_base__io_buffer* src,
+                       uint32_t wuffs_initialize_flags,
+                       uint64_t rlimit,
+                       bool portable) {
   uint64_t len = src->meta.wi - src->meta.ri;
   if (rlimit) {
     len = wuffs_base__u64__min(len, rlimit);
@@ -246,6 +354,9 @@ wuffs_bench_adler32(wuffs_base__io_buffer* dst,
   CHECK_STATUS("initialize", wuffs_adler32__hasher__initialize(
                                  &checksum, sizeof checksum, WUFFS_VERSION,
                                  wuffs_initialize_flags));
+  if (portable) {
+    force_portable_implementation(&checksum);
+  }
   g_wuffs_adler32_unused_u32 = wuffs_adler32__hasher__update_u32(
       &checksum, ((wuffs_base__slice_u8){
                      .ptr = src->data.ptr + src->meta.ri,
@@ -255,6 +366,24 @@ wuffs_bench_adler32(wuffs_base__io_buffer* dst,
   return NULL;
 }
 
+const char*  //
+wuffs_bench_adler32(wuffs_base__io_buffer* dst,
+                    wuffs_base__io_buffer* src,
+                    uint32_t wuffs_initialize_flags,
+                    uint64_t wlimit,
+                    uint64_t rlimit) {
+  return do_wuffs_bench_adler32(src, wuffs_initialize_flags, rlimit, false);
+}
+
+const char*  //
+wuffs_bench_adler32_portable(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return do_wuffs_bench_adler32(src, wuffs_initialize_flags, rlimit, true);
+}
+
 const char*  //
 bench_wuffs_adler32_10k() {
   CHECK_FOCUS(__func__);
@@ -273,6 +402,24 @@ bench_wuffs_adler32_100k() {
       &g_adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_wuffs_adler32_portable_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_adler32_portable,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_adler32_midsummer_gt, UINT64_MAX, UINT64_MAX, 1500);
+}
+
+const char*  //
+bench_wuffs_adler32_portable_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_adler32_portable,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -301,9 +448,11 @@ bench_mimic_adler32_100k() {
 
 proc g_tests[] = {
 
+    test_wuffs_adler32_combine,
     test_wuffs_adler32_golden,
     test_wuffs_adler32_interface,
     test_wuffs_adler32_pi,
+    test_wuffs_adler32_portable_vs_simd,
 
     NULL,
 };
@@ -312,6 +461,8 @@ proc g_benches[] = {
 
     bench_wuffs_adler32_10k,
     bench_wuffs_adler32_100k,
+    bench_wuffs_adler32_portable_10k,
+    bench_wuffs_adler32_portable_100k,
 
 #ifdef WUFFS_MIMIC
 
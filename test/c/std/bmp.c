@@ -67,6 +67,81 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 // No mimic library.
 #endif
 
+// ---------------- Parallel BMP Decoding
+
+#define BMP_MAX_THREADS 8
+
+typedef struct {
+  wuffs_base__slice_u8 data;
+  wuffs_base__pixel_buffer* pixbuf;
+  wuffs_base__rect_ie_u32 band;
+  const char* status_repr;
+} bmp_band_thread_arg;
+
+void*  //
+bmp_band_thread_func(void* arg) {
+  bmp_band_thread_arg* a = (bmp_band_thread_arg*)(arg);
+  wuffs_base__io_buffer src = wuffs_base__slice_u8__reader(a->data, true);
+
+  // Each band is decoded by its own decoder. Clipping to the band means that
+  // the decoder skips, without reading, the other bands' rows.
+  wuffs_bmp__decoder dec;
+  wuffs_base__status status = wuffs_bmp__decoder__initialize(
+      &dec, sizeof dec, WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (wuffs_base__status__is_ok(&status)) {
+    status = wuffs_bmp__decoder__decode_image_config(&dec, NULL, &src);
+  }
+  if (wuffs_base__status__is_ok(&status)) {
+    wuffs_base__decode_frame_options opts =
+        wuffs_base__null_decode_frame_options();
+    wuffs_base__decode_frame_options__set_dst_clip_rect(&opts, a->band);
+    status = wuffs_bmp__decoder__decode_frame(
+        &dec, a->pixbuf, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+        wuffs_base__empty_slice_u8(), &opts);
+  }
+  a->status_repr = status.repr;
+  return NULL;
+}
+
+// do_bmp_decode_in_parallel decodes the BMP image in data, which must hold the
+// whole file, into pb. It splits pb into num_threads row bands and decodes
+// each band independently (on separate threads, if available). Uncompressed
+// BMP rows are at fixed offsets, so each band's decoder can skip straight to
+// its first row. The bands are disjoint, so the threads never write to the
+// same pixels.
+const char*  //
+do_bmp_decode_in_parallel(wuffs_base__slice_u8 data,
+                          wuffs_base__pixel_buffer* pb,
+                          size_t num_threads) {
+  if ((num_threads == 0) || (num_threads > WUFFS_TESTLIB_MAX_THREADS)) {
+    return "do_bmp_decode_in_parallel: bad num_threads";
+  }
+  bmp_band_thread_arg args[WUFFS_TESTLIB_MAX_THREADS];
+  wuffs_base__rect_ie_u32 bounds =
+      wuffs_base__pixel_config__bounds(&pb->pixcfg);
+  uint64_t height = bounds.max_excl_y;
+  size_t i;
+  for (i = 0; i < num_threads; i++) {
+    args[i].data = data;
+    args[i].pixbuf = pb;
+    args[i].band = wuffs_base__make_rect_ie_u32(
+        0, (uint32_t)((height * i) / num_threads), bounds.max_excl_x,
+        (uint32_t)((height * (i + 1)) / num_threads));
+    args[i].status_repr = NULL;
+  }
+
+  CHECK_STRING(run_in_parallel(&bmp_band_thread_func, args, sizeof(args[0]),
+                               num_threads));
+
+  for (i = 0; i < num_threads; i++) {
+    if (args[i].status_repr) {
+      return args[i].status_repr;
+    }
+  }
+  return NULL;
+}
+
 // ---------------- BMP Tests
 
 const char*  //
@@ -112,6 +187,290 @@ test_wuffs_bmp_decode_frame_config() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_bmp_decode_with_options(const char* filename,
+                                      bool top_down,
+                                      uint64_t rlimit,
+                                      wuffs_base__rect_ie_u32 clip,
+                                      uint32_t scale_denominator) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  if (top_down) {
+    // Convert the bottom-up BMP file to top-down: negate the height and
+    // reverse the order of the rows.
+    if (src.meta.wi < 54) {
+      RETURN_FAIL("file is too short");
+    }
+    uint8_t* p = src.data.ptr;
+    uint32_t offset = wuffs_base__load_u32le__no_bounds_check(p + 10);
+    uint32_t width = wuffs_base__load_u32le__no_bounds_check(p + 18);
+    uint32_t height = wuffs_base__load_u32le__no_bounds_check(p + 22);
+    uint32_t bpp = wuffs_base__load_u16le__no_bounds_check(p + 28);
+    size_t stride = ((((size_t)width) * bpp + 31) / 32) * 4;
+    uint8_t tmp[4096];
+    if ((height >= 0x8000) || (stride > sizeof(tmp)) ||
+        (offset + (stride * height) > src.meta.wi)) {
+      RETURN_FAIL("unexpected bottom-up BMP file");
+    }
+    wuffs_base__store_u32le__no_bounds_check(p + 22, 0 - height);
+    uint32_t y;
+    for (y = 0; y < (height / 2); y++) {
+      uint8_t* r0 = p + offset + (stride * y);
+      uint8_t* r1 = p + offset + (stride * (height - 1 - y));
+      memcpy(tmp, r0, stride);
+      memcpy(r0, r1, stride);
+      memcpy(r1, tmp, stride);
+    }
+  }
+
+  // Decode the whole image to g_have_array_u8 and the clipped and scaled
+  // image, in rlimit-sized chunks, to g_pixel_array_u8.
+  wuffs_base__rect_ie_u32 bounds = ((wuffs_base__rect_ie_u32){});
+  wuffs_base__pixel_buffer pbs[2];
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_dst_clip_rect(&opts, clip);
+  wuffs_base__decode_frame_options__set_scale_denominator(&opts,
+                                                          scale_denominator);
+  uint32_t d = wuffs_base__decode_frame_options__scale_denominator(&opts);
+  wuffs_base__rect_ie_u32 scaled_bounds = ((wuffs_base__rect_ie_u32){});
+  int i;
+  for (i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_bmp__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_bmp__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_bmp__decoder__decode_image_config(&dec, &ic, &src));
+    bounds = wuffs_base__pixel_config__bounds(&ic.pixcfg);
+    scaled_bounds = wuffs_base__make_rect_ie_u32(
+        0, 0, (bounds.max_excl_x + d - 1) / d, (bounds.max_excl_y + d - 1) / d);
+    wuffs_base__rect_ie_u32 r = (i == 0) ? bounds : scaled_bounds;
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, r.max_excl_x, r.max_excl_y);
+    wuffs_base__slice_u8 pixbuf = (i == 0) ? g_have_slice_u8 : g_pixel_slice_u8;
+    uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if (n > pixbuf.len) {
+      RETURN_FAIL("pixbuf_len too large");
+    }
+    memset(pixbuf.ptr, 0xA5, n);
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pbs[i], &ic.pixcfg, pixbuf));
+
+    if (i == 0) {
+      CHECK_STATUS("decode_frame #0",
+                   wuffs_bmp__decoder__decode_frame(
+                       &dec, &pbs[i], &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                       g_work_slice_u8, NULL));
+      continue;
+    }
+
+    while (true) {
+      wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+      size_t old_ri = src.meta.ri;
+
+      wuffs_base__status status = wuffs_bmp__decoder__decode_frame(
+          &dec, &pbs[i], &limited_src, WUFFS_BASE__PIXEL_BLEND__SRC,
+          g_work_slice_u8, &opts);
+      src.meta.ri += limited_src.meta.ri;
+
+      if (wuffs_base__status__is_ok(&status)) {
+        break;
+      } else if (status.repr != wuffs_base__suspension__short_read) {
+        RETURN_FAIL("decode_frame #1: have \"%s\", want \"%s\"", status.repr,
+                    wuffs_base__suspension__short_read);
+      } else if (src.meta.ri <= old_ri) {
+        RETURN_FAIL("no progress was made");
+      }
+    }
+
+    wuffs_base__rect_ie_u32 have_dirty =
+        wuffs_bmp__decoder__frame_dirty_rect(&dec);
+    wuffs_base__rect_ie_u32 want_dirty =
+        wuffs_base__rect_ie_u32__intersect(&scaled_bounds, clip);
+    if (!wuffs_base__rect_ie_u32__equals(&have_dirty, want_dirty)) {
+      RETURN_FAIL("frame_dirty_rect: have (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 "), want (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 ")",
+                  have_dirty.min_incl_x, have_dirty.min_incl_y,
+                  have_dirty.max_excl_x, have_dirty.max_excl_y,
+                  want_dirty.min_incl_x, want_dirty.min_incl_y,
+                  want_dirty.max_excl_x, want_dirty.max_excl_y);
+    }
+  }
+
+  // Pixels inside the clip rectangle should match the (subsampled) whole-image
+  // decode. Pixels outside of it should be untouched.
+  uint32_t y;
+  for (y = 0; y < scaled_bounds.max_excl_y; y++) {
+    uint32_t x;
+    for (x = 0; x < scaled_bounds.max_excl_x; x++) {
+      wuffs_base__color_u32_argb_premul have =
+          wuffs_base__pixel_buffer__color_u32_at(&pbs[1], x, y);
+      wuffs_base__color_u32_argb_premul want =
+          wuffs_base__rect_ie_u32__contains(&clip, x, y)
+              ? wuffs_base__pixel_buffer__color_u32_at(&pbs[0], x * d, y * d)
+              : 0xA5A5A5A5;
+      if (have != want) {
+        RETURN_FAIL("pixel at (%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    x, y, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_bmp_decode_dst_clip_rect() {
+  CHECK_FOCUS(__func__);
+  const struct {
+    const char* filename;
+    wuffs_base__rect_ie_u32 clip;
+  } tcs[] = {
+      {"test/data/hibiscus.primitive.bmp", {3, 5, 309, 441}},
+      {"test/data/hippopotamus.bmp", {0, 0, 36, 28}},
+      {"test/data/hippopotamus.bmp", {7, 11, 19, 13}},
+      {"test/data/hippopotamus.bmp", {30, 20, 1000, 1000}},
+      {"test/data/hippopotamus.bmp", {40, 0, 50, 10}},
+      {"test/data/hippopotamus.bmp", {5, 5, 5, 9}},
+  };
+  const uint64_t rlimits[] = {1, 7, UINT64_MAX};
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    int td;
+    for (td = 0; td < 2; td++) {
+      size_t r;
+      for (r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); r++) {
+        const char* status = do_test_wuffs_bmp_decode_with_options(
+            tcs[tc].filename, td, rlimits[r], tcs[tc].clip, 1);
+        if (status) {
+          // status may point to g_fail_msg, which RETURN_FAIL overwrites.
+          char msg[256];
+          snprintf(msg, sizeof(msg), "%s", status);
+          RETURN_FAIL("tc=%zu, top_down=%d, rlimit=%" PRIu64 ": %s", tc, td,
+                      rlimits[r], msg);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_bmp_decode_in_parallel() {
+  CHECK_FOCUS(__func__);
+  const char* filenames[] = {
+      "test/data/harvesters.bmp",
+      "test/data/hibiscus.primitive.bmp",
+      "test/data/hippopotamus.bmp",
+  };
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[tc]));
+    wuffs_base__slice_u8 data =
+        wuffs_base__make_slice_u8(src.data.ptr, src.meta.wi);
+
+    wuffs_bmp__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_bmp__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_bmp__decoder__decode_image_config(&dec, &ic, &src));
+    wuffs_base__pixel_config__set(&ic.pixcfg,
+                                  WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+                                  wuffs_base__pixel_config__width(&ic.pixcfg),
+                                  wuffs_base__pixel_config__height(&ic.pixcfg));
+    uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if ((n > g_have_slice_u8.len) || (n > g_pixel_slice_u8.len)) {
+      RETURN_FAIL("tc=%zu: pixbuf_len too large", tc);
+    }
+
+    // Decode single-threaded to g_have_array_u8.
+    wuffs_base__pixel_buffer want_pb;
+    memset(g_have_slice_u8.ptr, 0xA5, n);
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &want_pb, &ic.pixcfg, g_have_slice_u8));
+    CHECK_STRING(do_bmp_decode_in_parallel(data, &want_pb, 1));
+
+    // Decode multi-threaded to g_pixel_array_u8.
+    size_t num_threads;
+    for (num_threads = 2; num_threads <= BMP_MAX_THREADS; num_threads++) {
+      wuffs_base__pixel_buffer have_pb;
+      memset(g_pixel_slice_u8.ptr, 0xA5, n);
+      CHECK_STATUS("set_from_slice",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &have_pb, &ic.pixcfg, g_pixel_slice_u8));
+      const char* status =
+          do_bmp_decode_in_parallel(data, &have_pb, num_threads);
+      if (status) {
+        RETURN_FAIL("tc=%zu, num_threads=%zu: %s", tc, num_threads, status);
+      }
+      if (memcmp(g_have_slice_u8.ptr, g_pixel_slice_u8.ptr, n)) {
+        RETURN_FAIL("tc=%zu, num_threads=%zu: pixels differ", tc, num_threads);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_bmp_decode_scale_denominator() {
+  CHECK_FOCUS(__func__);
+  const struct {
+    const char* filename;
+    wuffs_base__rect_ie_u32 clip;
+  } tcs[] = {
+      {"test/data/hibiscus.primitive.bmp", {0, 0, 1000, 1000}},
+      {"test/data/hibiscus.primitive.bmp", {3, 5, 37, 41}},
+      {"test/data/hippopotamus.bmp", {0, 0, 1000, 1000}},
+      {"test/data/hippopotamus.bmp", {1, 2, 3, 3}},
+      {"test/data/hippopotamus.bmp", {2, 0, 9, 5}},
+  };
+  const uint32_t scale_denominators[] = {2, 4, 8};
+  const uint64_t rlimits[] = {1, 7, UINT64_MAX};
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    size_t s;
+    for (s = 0; s < WUFFS_TESTLIB_ARRAY_SIZE(scale_denominators); s++) {
+      int td;
+      for (td = 0; td < 2; td++) {
+        size_t r;
+        for (r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); r++) {
+          const char* status = do_test_wuffs_bmp_decode_with_options(
+              tcs[tc].filename, td, rlimits[r], tcs[tc].clip,
+              scale_denominators[s]);
+          if (status) {
+            // status may point to g_fail_msg, which RETURN_FAIL overwrites.
+            char msg[256];
+            snprintf(msg, sizeof(msg), "%s", status);
+            RETURN_FAIL("tc=%zu, d=%" PRIu32 ", top_down=%d, rlimit=%" PRIu64
+                        ": %s",
+                        tc, scale_denominators[s], td, rlimits[r], msg);
+          }
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -122,7 +481,50 @@ test_wuffs_bmp_decode_frame_config() {
 
   // ---------------- BMP Benches
 
-  // No BMP benches.
+const char*  //
+do_bench_bmp_decode_in_parallel(const char* filename, uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+  wuffs_base__slice_u8 data =
+      wuffs_base__make_slice_u8(src.data.ptr, src.meta.wi);
+
+  wuffs_bmp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_bmp__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_bmp__decoder__decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_config__set(&ic.pixcfg,
+                                WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+                                wuffs_base__pixel_config__width(&ic.pixcfg),
+                                wuffs_base__pixel_config__height(&ic.pixcfg));
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+  wuffs_base__pixel_buffer pb;
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    CHECK_STRING(do_bmp_decode_in_parallel(data, &pb, g_flags.threads));
+    n_bytes += n;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_bmp_decode_1000k_parallel() {
+  CHECK_FOCUS(__func__);
+  return do_bench_bmp_decode_in_parallel("test/data/harvesters.bmp", 3);
+}
 
   // ---------------- Mimic Benches
 
@@ -136,8 +538,11 @@ test_wuffs_bmp_decode_frame_config() {
 
 proc g_tests[] = {
 
+    test_wuffs_bmp_decode_dst_clip_rect,
     test_wuffs_bmp_decode_frame_config,
+    test_wuffs_bmp_decode_in_parallel,
     test_wuffs_bmp_decode_interface,
+    test_wuffs_bmp_decode_scale_denominator,
 
 #ifdef WUFFS_MIMIC
 
@@ -150,7 +555,7 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
-// No BMP benches.
+    bench_wuffs_bmp_decode_1000k_parallel,
 
 #ifdef WUFFS_MIMIC
 
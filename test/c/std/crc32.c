@@ -77,6 +77,74 @@ golden_test g_crc32_pi_gt = {
     .src_filename = "test/data/pi.txt",
 };
 
+golden_test g_crc32_harvesters_gt = {
+    .src_filename = "test/data/harvesters.bmp",
+};
+
+// ---------------- Parallel Hashing
+
+#define CRC32_MAX_THREADS 16
+
+typedef struct {
+  wuffs_base__slice_u8 data;
+  uint32_t wuffs_initialize_flags;
+  uint32_t checksum;
+  const char* status_repr;
+} crc32_ieee_thread_arg;
+
+void*  //
+crc32_ieee_thread_func(void* arg) {
+  crc32_ieee_thread_arg* a = (crc32_ieee_thread_arg*)(arg);
+  wuffs_crc32__ieee_hasher checksum;
+  wuffs_base__status status = wuffs_crc32__ieee_hasher__initialize(
+      &checksum, sizeof checksum, WUFFS_VERSION, a->wuffs_initialize_flags);
+  a->status_repr = status.repr;
+  if (wuffs_base__status__is_ok(&status)) {
+    a->checksum = wuffs_crc32__ieee_hasher__update_u32(&checksum, a->data);
+  }
+  return NULL;
+}
+
+// do_crc32_ieee_in_parallel splits data into num_threads parts, hashes each
+// part independently (on separate threads, if available) and then combines
+// those checksums into the checksum of the whole data.
+const char*  //
+do_crc32_ieee_in_parallel(wuffs_base__slice_u8 data,
+                          uint32_t wuffs_initialize_flags,
+                          size_t num_threads,
+                          uint32_t* checksum_out) {
+  if ((num_threads == 0) || (num_threads > WUFFS_TESTLIB_MAX_THREADS)) {
+    return "do_crc32_ieee_in_parallel: bad num_threads";
+  }
+  crc32_ieee_thread_arg args[WUFFS_TESTLIB_MAX_THREADS];
+  size_t part_len = data.len / num_threads;
+  size_t i;
+  for (i = 0; i < num_threads; i++) {
+    args[i].data = wuffs_base__slice_u8__subslice_ij(
+        data, i * part_len,
+        (i + 1 < num_threads) ? ((i + 1) * part_len) : data.len);
+    args[i].wuffs_initialize_flags = wuffs_initialize_flags;
+    args[i].checksum = 0;
+    args[i].status_repr = NULL;
+  }
+
+  CHECK_STRING(run_in_parallel(&crc32_ieee_thread_func, args, sizeof(args[0]),
+                               num_threads));
+
+  wuffs_crc32__ieee_hasher checksum;
+  CHECK_STATUS("initialize", wuffs_crc32__ieee_hasher__initialize(
+                                 &checksum, sizeof checksum, WUFFS_VERSION,
+                                 wuffs_initialize_flags));
+  for (i = 0; i < num_threads; i++) {
+    if (args[i].status_repr) {
+      return args[i].status_repr;
+    }
+    *checksum_out = wuffs_crc32__ieee_hasher__combine_u32(
+        &checksum, args[i].checksum, args[i].data.len);
+  }
+  return NULL;
+}
+
 // ---------------- CRC32 Tests
 
 const char*  //
@@ -92,6 +160,80 @@ test_wuffs_crc32_ieee_interface() {
       "test/data/hat.lossy.webp", 0, SIZE_MAX, 0x89F53B4E);
 }
 
+const char*  //
+test_wuffs_crc32_ieee_combine() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/pi.txt"));
+  wuffs_base__slice_u8 whole = ((wuffs_base__slice_u8){
+      .ptr = src.data.ptr,
+      .len = src.meta.wi,
+  });
+
+  wuffs_crc32__ieee_hasher checksum;
+  CHECK_STATUS("initialize",
+               wuffs_crc32__ieee_hasher__initialize(
+                   &checksum, sizeof checksum, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  uint32_t want = wuffs_crc32__ieee_hasher__update_u32(&checksum, whole);
+
+  size_t splits[] = {0, 1, 2, 3, 16, 100, 4095, 65536, 99999, SIZE_MAX};
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(splits); tc++) {
+    size_t split = wuffs_base__u64__min(splits[tc], whole.len);
+    wuffs_base__slice_u8 other = wuffs_base__slice_u8__subslice_i(whole, split);
+
+    CHECK_STATUS("initialize",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &checksum, sizeof checksum, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint32_t other_checksum =
+        wuffs_crc32__ieee_hasher__update_u32(&checksum, other);
+
+    CHECK_STATUS("initialize",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &checksum, sizeof checksum, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint32_t prefix_checksum = wuffs_crc32__ieee_hasher__update_u32(
+        &checksum, wuffs_base__slice_u8__subslice_j(whole, split));
+    uint32_t have = wuffs_crc32__ieee_hasher__combine_u32(
+        &checksum, other_checksum, other.len);
+    if (have != want) {
+      RETURN_FAIL("tc=%d, split=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                  tc, split, have, want);
+    }
+
+    // combine_u32 can also be a fresh hasher's first call.
+    CHECK_STATUS("initialize",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &checksum, sizeof checksum, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_crc32__ieee_hasher__combine_u32(&checksum, prefix_checksum, split);
+    have = wuffs_crc32__ieee_hasher__update_u32(&checksum, other);
+    if (have != want) {
+      RETURN_FAIL("tc=%d, split=%zu: combine first: have 0x%08" PRIX32
+                  ", want 0x%08" PRIX32,
+                  tc, split, have, want);
+    }
+  }
+
+  size_t num_threads;
+  for (num_threads = 1; num_threads <= CRC32_MAX_THREADS; num_threads++) {
+    uint32_t have = 0;
+    CHECK_STRING(do_crc32_ieee_in_parallel(
+        whole, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+        num_threads, &have));
+    if (have != want) {
+      RETURN_FAIL("num_threads=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                  num_threads, have, want);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_crc32_ieee_golden() {
   CHECK_FOCUS(__func__);
@@ -292,6 +434,26 @@ wuffs_bench_crc32_ieee(wuffs_base__io_buffer* dst,
   return NULL;
 }
 
+const char*  //
+wuffs_bench_crc32_ieee_parallel(wuffs_base__io_buffer* dst,
+                                wuffs_base__io_buffer* src,
+                                uint32_t wuffs_initialize_flags,
+                                uint64_t wlimit,
+                                uint64_t rlimit) {
+  uint64_t len = src->meta.wi - src->meta.ri;
+  if (rlimit) {
+    len = wuffs_base__u64__min(len, rlimit);
+  }
+  CHECK_STRING(do_crc32_ieee_in_parallel(
+      ((wuffs_base__slice_u8){
+          .ptr = src->data.ptr + src->meta.ri,
+          .len = len,
+      }),
+      wuffs_initialize_flags, g_flags.threads, &g_wuffs_crc32_unused_u32));
+  src->meta.ri += len;
+  return NULL;
+}
+
 const char*  //
 bench_wuffs_crc32_ieee_10k() {
   CHECK_FOCUS(__func__);
@@ -310,6 +472,24 @@ bench_wuffs_crc32_ieee_100k() {
       &g_crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_wuffs_crc32_ieee_3000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_crc32_ieee,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_crc32_harvesters_gt, UINT64_MAX, UINT64_MAX, 5);
+}
+
+const char*  //
+bench_wuffs_crc32_ieee_3000k_parallel() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_crc32_ieee_parallel,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_crc32_harvesters_gt, UINT64_MAX, UINT64_MAX, 5);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -329,6 +509,14 @@ bench_mimic_crc32_ieee_100k() {
                              &g_crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_mimic_crc32_ieee_3000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_bench_crc32_ieee, 0, tcounter_src,
+                             &g_crc32_harvesters_gt, UINT64_MAX, UINT64_MAX,
+                             5);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -338,6 +526,7 @@ bench_mimic_crc32_ieee_100k() {
 
 proc g_tests[] = {
 
+    test_wuffs_crc32_ieee_combine,
     test_wuffs_crc32_ieee_golden,
     test_wuffs_crc32_ieee_interface,
     test_wuffs_crc32_ieee_pi,
@@ -355,11 +544,14 @@ proc g_benches[] = {
 
     bench_wuffs_crc32_ieee_10k,
     bench_wuffs_crc32_ieee_100k,
+    bench_wuffs_crc32_ieee_3000k,
+    bench_wuffs_crc32_ieee_3000k_parallel,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_crc32_ieee_10k,
     bench_mimic_crc32_ieee_100k,
+    bench_mimic_crc32_ieee_3000k,
 
 #endif  // WUFFS_MIMIC
 
@@ -167,6 +167,431 @@ test_basic_sub_struct_initializer() {
   return NULL;
 }
 
+// ---------------- Pixel Swizzler Tests
+
+// These pixel swizzler tests and benches are for the base package's code, not
+// the std/gif code. As for the basic tests, putting them here is as good as
+// any other place.
+
+uint32_t g_pixel_swizzler_rng_state = 1;
+
+uint8_t  //
+pixel_swizzler_rng_u8() {
+  // Xorshift32 from Marsaglia, "Xorshift RNGs".
+  uint32_t x = g_pixel_swizzler_rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  g_pixel_swizzler_rng_state = x;
+  return (uint8_t)(x >> 24);
+}
+
+// do_test_wuffs_pixel_swizzler checks that the swizzler chosen by
+// wuffs_base__pixel_swizzler__prepare, which might use SIMD instructions,
+// produces exactly what the scalar reference_func produces, for a variety of
+// row lengths and pointer alignments.
+//
+// The first row has 65536 pixels whose first and last channels (e.g. blue and
+// alpha) take every combination of 8-bit values.
+const char*  //
+do_test_wuffs_pixel_swizzler(uint32_t dst_pixfmt_repr,
+                             uint32_t dst_bytes_per_pixel,
+                             uint32_t src_pixfmt_repr,
+                             uint32_t src_bytes_per_pixel,
+                             wuffs_base__pixel_blend blend,
+                             wuffs_base__pixel_swizzler__func reference_func) {
+  uint8_t src_palette_array[1024];
+  uint8_t dst_palette_array[1024];
+  size_t i;
+  for (i = 0; i < 1024; i++) {
+    src_palette_array[i] = pixel_swizzler_rng_u8();
+  }
+
+  wuffs_base__pixel_swizzler swizzler;
+  CHECK_STATUS("prepare",
+               wuffs_base__pixel_swizzler__prepare(
+                   &swizzler, wuffs_base__make_pixel_format(dst_pixfmt_repr),
+                   wuffs_base__make_slice_u8(dst_palette_array, 1024),
+                   wuffs_base__make_pixel_format(src_pixfmt_repr),
+                   wuffs_base__make_slice_u8(src_palette_array, 1024), blend));
+  wuffs_base__slice_u8 dst_palette =
+      wuffs_base__make_slice_u8(dst_palette_array, 1024);
+
+  int row;
+  for (row = -1; row < 256; row++) {
+    size_t width = (row < 0) ? 65536 : ((size_t)row / 4);
+    size_t offset = (row < 0) ? 0 : ((size_t)row % 4);
+    size_t src_len = width * src_bytes_per_pixel;
+    size_t dst_len = width * dst_bytes_per_pixel;
+
+    uint8_t* src = g_src_array_u8 + offset;
+    for (i = 0; i < src_len; i++) {
+      src[i] = pixel_swizzler_rng_u8();
+    }
+    if ((row < 0) && (src_bytes_per_pixel > 1)) {
+      for (i = 0; i < width; i++) {
+        src[(i * src_bytes_per_pixel) + 0] = (uint8_t)(i >> 0);
+        src[(i * src_bytes_per_pixel) + src_bytes_per_pixel - 1] =
+            (uint8_t)(i >> 8);
+      }
+    }
+
+    uint8_t* have = g_have_array_u8 + offset;
+    uint8_t* want = g_want_array_u8 + offset;
+    for (i = 0; i < dst_len; i++) {
+      have[i] = pixel_swizzler_rng_u8();
+      want[i] = have[i];
+    }
+
+    uint64_t have_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
+        &swizzler, wuffs_base__make_slice_u8(have, dst_len), dst_palette,
+        wuffs_base__make_slice_u8(src, src_len));
+    uint64_t want_n =
+        (*reference_func)(wuffs_base__make_slice_u8(want, dst_len), dst_palette,
+                          wuffs_base__make_slice_u8(src, src_len));
+    if (have_n != want_n) {
+      RETURN_FAIL("row %d: num pixels: have %" PRIu64 ", want %" PRIu64, row,
+                  have_n, want_n);
+    }
+    for (i = 0; i < dst_len; i++) {
+      if (have[i] != want[i]) {
+        RETURN_FAIL("row %d: byte %zu: have 0x%02X, want 0x%02X", row, i,
+                    have[i], want[i]);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_bgr_to_bgrx() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRX, 4, WUFFS_BASE__PIXEL_FORMAT__BGR, 3,
+      WUFFS_BASE__PIXEL_BLEND__SRC, wuffs_base__pixel_swizzler__xxxx__xxx);
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 4,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 4, WUFFS_BASE__PIXEL_BLEND__SRC,
+      wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src);
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 4,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 4,
+      WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+      wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over);
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_bgra_nonpremul_to_rgba_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL, 4,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 4, WUFFS_BASE__PIXEL_BLEND__SRC,
+      wuffs_base__pixel_swizzler__swap_rgbx_bgrx);
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_indexed_to_bgra_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 4,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY, 1,
+      WUFFS_BASE__PIXEL_BLEND__SRC,
+      wuffs_base__pixel_swizzler__xxxx__index__src);
+}
+
+// do_test_wuffs_pixel_swizzler_vs_generic checks that
+// wuffs_base__pixel_swizzler__prepare either succeeds or fails, depending on
+// whether converting between the two pixel formats is supported. If it
+// succeeds, and the dst format is not indexed, it also checks that the
+// swizzler chosen by prepare (specialized or not) produces exactly what the
+// generic, one-pixel-at-a-time, swizzler produces.
+const char*  //
+do_test_wuffs_pixel_swizzler_vs_generic(uint32_t dst_pixfmt_repr,
+                                        uint32_t src_pixfmt_repr,
+                                        wuffs_base__pixel_blend blend) {
+  wuffs_base__pixel_format dst_pixfmt =
+      wuffs_base__make_pixel_format(dst_pixfmt_repr);
+  wuffs_base__pixel_format src_pixfmt =
+      wuffs_base__make_pixel_format(src_pixfmt_repr);
+  size_t dst_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&dst_pixfmt) / 8;
+  size_t src_bytes_per_pixel =
+      wuffs_base__pixel_format__bits_per_pixel(&src_pixfmt) / 8;
+  bool src_binary = ((src_pixfmt_repr >> 24) & 7) == 7;
+
+  // Binary alpha colors are either fully opaque or all zeroes.
+  uint8_t src_palette_array[1024];
+  size_t i;
+  for (i = 0; i < 1024; i += 4) {
+    src_palette_array[i + 0] = pixel_swizzler_rng_u8();
+    src_palette_array[i + 1] = pixel_swizzler_rng_u8();
+    src_palette_array[i + 2] = pixel_swizzler_rng_u8();
+    src_palette_array[i + 3] = pixel_swizzler_rng_u8();
+    if (!src_binary) {
+      continue;
+    } else if (src_palette_array[i + 3] & 1) {
+      memset(src_palette_array + i, 0x00, 4);
+    } else {
+      src_palette_array[i + 3] = 0xFF;
+    }
+  }
+  wuffs_base__slice_u8 src_palette =
+      wuffs_base__make_slice_u8(src_palette_array, 1024);
+
+  uint8_t have_palette_array[1024] = {0};
+  wuffs_base__slice_u8 have_palette =
+      wuffs_base__make_slice_u8(have_palette_array, 1024);
+  wuffs_base__pixel_swizzler have_swizzler;
+  wuffs_base__status status = wuffs_base__pixel_swizzler__prepare(
+      &have_swizzler, dst_pixfmt, have_palette, src_pixfmt, src_palette, blend);
+
+  // The only unsupported combinations are quantizing to an indexed dst, or
+  // blending (not just copying) onto an indexed dst.
+  bool want_ok = !wuffs_base__pixel_format__is_indexed(&dst_pixfmt) ||
+                 (wuffs_base__pixel_format__is_indexed(&src_pixfmt) &&
+                  (blend == WUFFS_BASE__PIXEL_BLEND__SRC));
+  if (want_ok != !status.repr) {
+    RETURN_FAIL("dst 0x%08" PRIX32 ", src 0x%08" PRIX32
+                ", blend %d: prepare: have \"%s\", want %s",
+                dst_pixfmt_repr, src_pixfmt_repr, (int)blend, status.repr,
+                want_ok ? "ok" : "an error");
+  } else if (!want_ok || wuffs_base__pixel_format__is_indexed(&dst_pixfmt)) {
+    return NULL;
+  }
+
+  // Force the generic swizzler. It looks up indexed src colors in an
+  // unconverted copy of the src palette.
+  uint8_t want_palette_array[1024];
+  memcpy(want_palette_array, src_palette_array, 1024);
+  wuffs_base__slice_u8 want_palette =
+      wuffs_base__make_slice_u8(want_palette_array, 1024);
+  wuffs_base__pixel_swizzler want_swizzler;
+  memset(&want_swizzler, 0, sizeof(want_swizzler));
+  want_swizzler.private_impl.dst_pixfmt_repr = dst_pixfmt_repr;
+  want_swizzler.private_impl.src_pixfmt_repr = src_pixfmt_repr;
+  want_swizzler.private_impl.blend = blend;
+
+  // The X in BGRX or RGBX is "don't care". Some swizzlers copy it from the
+  // src and some set it to 0xFF.
+  size_t ignore_x =
+      (((dst_pixfmt_repr >> 24) & 7) == 1) ? (dst_bytes_per_pixel - 1) : 99;
+
+  int row;
+  for (row = 0; row < 256; row++) {
+    size_t width = (size_t)row / 4;
+    size_t offset = (size_t)row % 4;
+    size_t src_len = width * src_bytes_per_pixel;
+    size_t dst_len = width * dst_bytes_per_pixel;
+
+    uint8_t* src = g_src_array_u8 + offset;
+    for (i = 0; i < src_len; i++) {
+      src[i] = pixel_swizzler_rng_u8();
+    }
+    if (src_binary && (src_bytes_per_pixel == 4)) {
+      for (i = 0; i < src_len; i += 4) {
+        if (src[i + 3] & 1) {
+          memset(src + i, 0x00, 4);
+        } else {
+          src[i + 3] = 0xFF;
+        }
+      }
+    }
+
+    uint8_t* have = g_have_array_u8 + offset;
+    uint8_t* want = g_want_array_u8 + offset;
+    for (i = 0; i < dst_len; i++) {
+      have[i] = pixel_swizzler_rng_u8();
+      want[i] = have[i];
+    }
+
+    uint64_t have_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
+        &have_swizzler, wuffs_base__make_slice_u8(have, dst_len), have_palette,
+        wuffs_base__make_slice_u8(src, src_len));
+    uint64_t want_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
+        &want_swizzler, wuffs_base__make_slice_u8(want, dst_len), want_palette,
+        wuffs_base__make_slice_u8(src, src_len));
+    if ((have_n != want_n) || (have_n != width)) {
+      RETURN_FAIL(
+          "dst 0x%08" PRIX32 ", src 0x%08" PRIX32
+          ", blend %d, row %d: num pixels: have %" PRIu64 ", want %" PRIu64,
+          dst_pixfmt_repr, src_pixfmt_repr, (int)blend, row, have_n, want_n);
+    }
+    for (i = 0; i < dst_len; i++) {
+      if ((have[i] != want[i]) && ((i % dst_bytes_per_pixel) != ignore_x)) {
+        RETURN_FAIL("dst 0x%08" PRIX32 ", src 0x%08" PRIX32
+                    ", blend %d, row %d: byte %zu: have 0x%02X, want 0x%02X",
+                    dst_pixfmt_repr, src_pixfmt_repr, (int)blend, row, i,
+                    have[i], want[i]);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_matrix() {
+  CHECK_FOCUS(__func__);
+
+  const uint32_t reprs[] = {
+      WUFFS_BASE__PIXEL_FORMAT__Y,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+      WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+      WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__PIXEL_FORMAT__BGRX,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY,
+      WUFFS_BASE__PIXEL_FORMAT__RGB,
+      WUFFS_BASE__PIXEL_FORMAT__RGBX,
+      WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY,
+  };
+  const size_t num_reprs = WUFFS_TESTLIB_ARRAY_SIZE(reprs);
+
+  size_t d;
+  for (d = 0; d < num_reprs; d++) {
+    size_t s;
+    for (s = 0; s < num_reprs; s++) {
+      CHECK_STRING(do_test_wuffs_pixel_swizzler_vs_generic(
+          reprs[d], reprs[s], WUFFS_BASE__PIXEL_BLEND__SRC));
+      CHECK_STRING(do_test_wuffs_pixel_swizzler_vs_generic(
+          reprs[d], reprs[s], WUFFS_BASE__PIXEL_BLEND__SRC_OVER));
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_single_pixels() {
+  CHECK_FOCUS(__func__);
+
+  // Each pixel is given as the bytes in memory order, little-endian packed
+  // into a uint32_t.
+  struct {
+    uint32_t dst_pixfmt_repr;
+    uint32_t src_pixfmt_repr;
+    wuffs_base__pixel_blend blend;
+    uint32_t src_pixel;
+    uint32_t dst_pixel_before;
+    uint32_t want_dst_pixel;
+  } test_cases[] = {
+      {
+          // Pure red's luma.
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__Y,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGR,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .src_pixel = 0xFF0000,
+          .dst_pixel_before = 0x00,
+          .want_dst_pixel = 0x4C,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__Y,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGB,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .src_pixel = 0x563412,
+          .dst_pixel_before = 0x00,
+          .want_dst_pixel = 0x2D,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGB,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .src_pixel = 0x0000FF,
+          .dst_pixel_before = 0x0000,
+          .want_dst_pixel = 0xF800,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__Y,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .src_pixel = 0x80,
+          .dst_pixel_before = 0x0000,
+          .want_dst_pixel = 0x8410,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .src_pixel = 0xF800,
+          .dst_pixel_before = 0x00000000,
+          .want_dst_pixel = 0xFF0000FF,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .src_pixel = 0xFF332211,
+          .dst_pixel_before = 0x00000000,
+          .want_dst_pixel = 0xFF112233,
+      },
+      {
+          // A fully transparent src leaves a nonpremul dst unchanged.
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .src_pixel = 0x00FFFFFF,
+          .dst_pixel_before = 0x03020100,
+          .want_dst_pixel = 0x03020100,
+      },
+      {
+          // Half-opaque gray over opaque white.
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRX,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .src_pixel = 0x80404040,
+          .dst_pixel_before = 0xFFFFFFFF,
+          .want_dst_pixel = 0xFFBFBFBF,
+      },
+  };
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__pixel_format dst_pixfmt =
+        wuffs_base__make_pixel_format(test_cases[tc].dst_pixfmt_repr);
+    wuffs_base__pixel_format src_pixfmt =
+        wuffs_base__make_pixel_format(test_cases[tc].src_pixfmt_repr);
+    size_t dst_len = wuffs_base__pixel_format__bits_per_pixel(&dst_pixfmt) / 8;
+    size_t src_len = wuffs_base__pixel_format__bits_per_pixel(&src_pixfmt) / 8;
+
+    uint8_t dst[4];
+    uint8_t src[4];
+    wuffs_base__store_u32le__no_bounds_check(dst,
+                                             test_cases[tc].dst_pixel_before);
+    wuffs_base__store_u32le__no_bounds_check(src, test_cases[tc].src_pixel);
+
+    wuffs_base__pixel_swizzler swizzler;
+    CHECK_STATUS(
+        "prepare",
+        wuffs_base__pixel_swizzler__prepare(
+            &swizzler, dst_pixfmt, wuffs_base__empty_slice_u8(), src_pixfmt,
+            wuffs_base__empty_slice_u8(), test_cases[tc].blend));
+    wuffs_base__pixel_swizzler__swizzle_interleaved(
+        &swizzler, wuffs_base__make_slice_u8(dst, dst_len),
+        wuffs_base__empty_slice_u8(), wuffs_base__make_slice_u8(src, src_len));
+
+    uint32_t have = wuffs_base__load_u32le__no_bounds_check(dst) &
+                    (0xFFFFFFFF >> (8 * (4 - dst_len)));
+    if (have != test_cases[tc].want_dst_pixel) {
+      RETURN_FAIL("tc=%zu: have 0x%08" PRIX32 ", want 0x%08" PRIX32, tc, have,
+                  test_cases[tc].want_dst_pixel);
+    }
+  }
+  return NULL;
+}
+
 // ---------------- GIF Tests
 
 const char*  //
@@ -746,6 +1171,199 @@ test_wuffs_gif_decode_delay_num_frames_decoded() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_gif_decode_with_options(const char* filename,
+                                      uint64_t rlimit,
+                                      wuffs_base__rect_ie_u32 clip,
+                                      uint32_t scale_denominator) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  // Decode the whole first frame to g_have_array_u8 and the clipped and
+  // scaled first frame, in rlimit-sized chunks, to g_pixel_array_u8.
+  wuffs_base__rect_ie_u32 bounds = ((wuffs_base__rect_ie_u32){});
+  wuffs_base__rect_ie_u32 full_dirty = ((wuffs_base__rect_ie_u32){});
+  wuffs_base__pixel_buffer pbs[2];
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_dst_clip_rect(&opts, clip);
+  wuffs_base__decode_frame_options__set_scale_denominator(&opts,
+                                                          scale_denominator);
+  uint32_t d = wuffs_base__decode_frame_options__scale_denominator(&opts);
+  wuffs_base__rect_ie_u32 scaled_bounds = ((wuffs_base__rect_ie_u32){});
+  int i;
+  for (i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_gif__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_gif__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_gif__decoder__decode_image_config(&dec, &ic, &src));
+    bounds = wuffs_base__pixel_config__bounds(&ic.pixcfg);
+    scaled_bounds = wuffs_base__make_rect_ie_u32(
+        0, 0, (bounds.max_excl_x + d - 1) / d, (bounds.max_excl_y + d - 1) / d);
+    wuffs_base__rect_ie_u32 r = (i == 0) ? bounds : scaled_bounds;
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, r.max_excl_x, r.max_excl_y);
+    wuffs_base__slice_u8 pixbuf = (i == 0) ? g_have_slice_u8 : g_pixel_slice_u8;
+    uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if (n > pixbuf.len) {
+      RETURN_FAIL("pixbuf_len too large");
+    }
+    memset(pixbuf.ptr, 0xA5, n);
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pbs[i], &ic.pixcfg, pixbuf));
+
+    if (i == 0) {
+      CHECK_STATUS("decode_frame #0",
+                   wuffs_gif__decoder__decode_frame(
+                       &dec, &pbs[i], &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                       g_work_slice_u8, NULL));
+      full_dirty = wuffs_gif__decoder__frame_dirty_rect(&dec);
+      continue;
+    }
+
+    while (true) {
+      wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+      size_t old_ri = src.meta.ri;
+
+      wuffs_base__status status = wuffs_gif__decoder__decode_frame(
+          &dec, &pbs[i], &limited_src, WUFFS_BASE__PIXEL_BLEND__SRC,
+          g_work_slice_u8, &opts);
+      src.meta.ri += limited_src.meta.ri;
+
+      if (wuffs_base__status__is_ok(&status)) {
+        break;
+      } else if (status.repr != wuffs_base__suspension__short_read) {
+        RETURN_FAIL("decode_frame #1: have \"%s\", want \"%s\"", status.repr,
+                    wuffs_base__suspension__short_read);
+      } else if (src.meta.ri <= old_ri) {
+        RETURN_FAIL("no progress was made");
+      }
+    }
+
+    wuffs_base__rect_ie_u32 have_dirty =
+        wuffs_gif__decoder__frame_dirty_rect(&dec);
+    wuffs_base__rect_ie_u32 want_dirty =
+        wuffs_base__make_rect_ie_u32((full_dirty.min_incl_x + d - 1) / d,
+                                     (full_dirty.min_incl_y + d - 1) / d,
+                                     (full_dirty.max_excl_x + d - 1) / d,
+                                     (full_dirty.max_excl_y + d - 1) / d);
+    want_dirty = wuffs_base__rect_ie_u32__intersect(&want_dirty, clip);
+    if (!wuffs_base__rect_ie_u32__equals(&have_dirty, want_dirty)) {
+      RETURN_FAIL("frame_dirty_rect: have (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 "), want (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 ")",
+                  have_dirty.min_incl_x, have_dirty.min_incl_y,
+                  have_dirty.max_excl_x, have_dirty.max_excl_y,
+                  want_dirty.min_incl_x, want_dirty.min_incl_y,
+                  want_dirty.max_excl_x, want_dirty.max_excl_y);
+    }
+  }
+
+  // Pixels inside the clip rectangle should match the (subsampled) whole-frame
+  // decode. Pixels outside of it should be untouched.
+  uint32_t y;
+  for (y = 0; y < scaled_bounds.max_excl_y; y++) {
+    uint32_t x;
+    for (x = 0; x < scaled_bounds.max_excl_x; x++) {
+      wuffs_base__color_u32_argb_premul have =
+          wuffs_base__pixel_buffer__color_u32_at(&pbs[1], x, y);
+      wuffs_base__color_u32_argb_premul want =
+          wuffs_base__rect_ie_u32__contains(&clip, x, y)
+              ? wuffs_base__pixel_buffer__color_u32_at(&pbs[0], x * d, y * d)
+              : 0xA5A5A5A5;
+      if (have != want) {
+        RETURN_FAIL("pixel at (%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    x, y, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_decode_dst_clip_rect() {
+  CHECK_FOCUS(__func__);
+  const struct {
+    const char* filename;
+    wuffs_base__rect_ie_u32 clip;
+  } tcs[] = {
+      {"test/data/artificial/gif-small-frame-interlaced.gif", {1, 1, 4, 3}},
+      {"test/data/bricks-dither.gif", {3, 5, 157, 119}},
+      {"test/data/hippopotamus.interlaced.gif", {0, 0, 36, 28}},
+      {"test/data/hippopotamus.interlaced.gif", {7, 11, 19, 13}},
+      {"test/data/hippopotamus.interlaced.gif", {30, 3, 1000, 1000}},
+      {"test/data/hippopotamus.interlaced.gif", {40, 0, 50, 10}},
+      {"test/data/hippopotamus.regular.gif", {5, 5, 5, 9}},
+      {"test/data/hippopotamus.regular.gif", {9, 2, 33, 27}},
+  };
+  const uint64_t rlimits[] = {1, 7, UINT64_MAX};
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    size_t r;
+    for (r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); r++) {
+      const char* status = do_test_wuffs_gif_decode_with_options(
+          tcs[tc].filename, rlimits[r], tcs[tc].clip, 1);
+      if (status) {
+        // status may point to g_fail_msg, which RETURN_FAIL overwrites.
+        char msg[256];
+        snprintf(msg, sizeof(msg), "%s", status);
+        RETURN_FAIL("tc=%zu, rlimit=%" PRIu64 ": %s", tc, rlimits[r], msg);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_decode_scale_denominator() {
+  CHECK_FOCUS(__func__);
+  const struct {
+    const char* filename;
+    wuffs_base__rect_ie_u32 clip;
+  } tcs[] = {
+      {"test/data/artificial/gif-small-frame-interlaced.gif",
+       {0, 0, 1000, 1000}},
+      {"test/data/bricks-dither.gif", {0, 0, 1000, 1000}},
+      {"test/data/bricks-dither.gif", {3, 5, 37, 41}},
+      {"test/data/hippopotamus.interlaced.gif", {0, 0, 1000, 1000}},
+      {"test/data/hippopotamus.interlaced.gif", {1, 2, 3, 3}},
+      {"test/data/hippopotamus.regular.gif", {0, 0, 1000, 1000}},
+      {"test/data/hippopotamus.regular.gif", {2, 0, 9, 5}},
+  };
+  const uint32_t scale_denominators[] = {2, 4, 8};
+  const uint64_t rlimits[] = {1, 7, UINT64_MAX};
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    size_t s;
+    for (s = 0; s < WUFFS_TESTLIB_ARRAY_SIZE(scale_denominators); s++) {
+      size_t r;
+      for (r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); r++) {
+        const char* status = do_test_wuffs_gif_decode_with_options(
+            tcs[tc].filename, rlimits[r], tcs[tc].clip, scale_denominators[s]);
+        if (status) {
+          // status may point to g_fail_msg, which RETURN_FAIL overwrites.
+          char msg[256];
+          snprintf(msg, sizeof(msg), "%s", status);
+          RETURN_FAIL("tc=%zu, d=%" PRIu32 ", rlimit=%" PRIu64 ": %s", tc,
+                      scale_denominators[s], rlimits[r], msg);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_gif_decode_empty_palette() {
   CHECK_FOCUS(__func__);
@@ -2115,6 +2733,103 @@ test_mimic_gif_decode_pjw_thumbnail() {
 
 #endif  // WUFFS_MIMIC
 
+// ---------------- Pixel Swizzler Benches
+
+const char*  //
+do_bench_wuffs_pixel_swizzler(uint32_t dst_pixfmt_repr,
+                              uint32_t dst_bytes_per_pixel,
+                              uint32_t src_pixfmt_repr,
+                              uint32_t src_bytes_per_pixel,
+                              wuffs_base__pixel_blend blend,
+                              uint64_t iters_unscaled) {
+  const size_t width = 4096;
+  size_t src_len = width * src_bytes_per_pixel;
+  size_t dst_len = width * dst_bytes_per_pixel;
+
+  uint8_t src_palette_array[1024];
+  uint8_t dst_palette_array[1024];
+  size_t i;
+  for (i = 0; i < 1024; i++) {
+    src_palette_array[i] = pixel_swizzler_rng_u8();
+  }
+  for (i = 0; i < src_len; i++) {
+    g_src_array_u8[i] = pixel_swizzler_rng_u8();
+  }
+  for (i = 0; i < dst_len; i++) {
+    g_have_array_u8[i] = pixel_swizzler_rng_u8();
+  }
+
+  wuffs_base__pixel_swizzler swizzler;
+  CHECK_STATUS("prepare",
+               wuffs_base__pixel_swizzler__prepare(
+                   &swizzler, wuffs_base__make_pixel_format(dst_pixfmt_repr),
+                   wuffs_base__make_slice_u8(dst_palette_array, 1024),
+                   wuffs_base__make_pixel_format(src_pixfmt_repr),
+                   wuffs_base__make_slice_u8(src_palette_array, 1024), blend));
+  wuffs_base__slice_u8 dst =
+      wuffs_base__make_slice_u8(g_have_array_u8, dst_len);
+  wuffs_base__slice_u8 dst_palette =
+      wuffs_base__make_slice_u8(dst_palette_array, 1024);
+  wuffs_base__slice_u8 src = wuffs_base__make_slice_u8(g_src_array_u8, src_len);
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    uint64_t n = wuffs_base__pixel_swizzler__swizzle_interleaved(
+        &swizzler, dst, dst_palette, src);
+    if (n != width) {
+      RETURN_FAIL("num pixels: have %" PRIu64 ", want %zu", n, width);
+    }
+    n_bytes += dst_len;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgr_to_bgrx() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRX, 4,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGR, 3,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 4,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       4, WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL, 4,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       4, WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+                                       1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_to_rgba_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+                                       4,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       4, WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_indexed_to_bgra_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 4,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY, 1,
+      WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
 // ---------------- GIF Benches
 
 const char*  //
@@ -2375,6 +3090,7 @@ proc g_tests[] = {
     test_wuffs_gif_decode_animated_small,
     test_wuffs_gif_decode_background_color,
     test_wuffs_gif_decode_delay_num_frames_decoded,
+    test_wuffs_gif_decode_dst_clip_rect,
     test_wuffs_gif_decode_empty_palette,
     test_wuffs_gif_decode_first_frame_is_opaque,
     test_wuffs_gif_decode_frame_out_of_bounds,
@@ -2400,6 +3116,7 @@ proc g_tests[] = {
     test_wuffs_gif_decode_pixfmt_bgra_nonpremul,
     test_wuffs_gif_decode_pixfmt_rgb,
     test_wuffs_gif_decode_pixfmt_rgba_nonpremul,
+    test_wuffs_gif_decode_scale_denominator,
     test_wuffs_gif_decode_zero_width_frame,
     test_wuffs_gif_frame_dirty_rect,
     test_wuffs_gif_num_decoded_frame_configs,
@@ -2408,6 +3125,13 @@ proc g_tests[] = {
     test_wuffs_gif_io_position_two_chunks,
     test_wuffs_gif_small_frame_interlaced,
     test_wuffs_gif_sizeof,
+    test_wuffs_pixel_swizzler_bgr_to_bgrx,
+    test_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src,
+    test_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src_over,
+    test_wuffs_pixel_swizzler_bgra_nonpremul_to_rgba_nonpremul,
+    test_wuffs_pixel_swizzler_indexed_to_bgra_nonpremul,
+    test_wuffs_pixel_swizzler_matrix,
+    test_wuffs_pixel_swizzler_single_pixels,
 
 #ifdef WUFFS_MIMIC
 
@@ -2443,6 +3167,11 @@ proc g_benches[] = {
     bench_wuffs_gif_decode_1000k_full_init,
     bench_wuffs_gif_decode_1000k_part_init,
     bench_wuffs_gif_decode_anim_screencap,
+    bench_wuffs_pixel_swizzler_bgr_to_bgrx,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_to_bgra_premul_src_over,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_to_rgba_nonpremul,
+    bench_wuffs_pixel_swizzler_indexed_to_bgra_nonpremul,
 
 #ifdef WUFFS_MIMIC
 
@@ -610,13 +610,21 @@ test_wuffs_strconv_parse_number_f64() {
       {.want = 0x0000000000000000, .str = "+0.0"},
       {.want = 0x0000000000000000, .str = "0"},
       {.want = 0x0000000000000000, .str = "0e0"},
+      {.want = 0x0000000000000000, .str = "1e-330"},
       {.want = 0x0000000000000000, .str = "1e-332"},
       {.want = 0x0000000000000001, .str = "4.9406564584124654e-324"},
       {.want = 0x000FFFFFFFFFFFFF, .str = "2.2250738585072009E-308"},
+      {.want = 0x000FFFFFFFFFFFFF, .str = "2.2250738585072011e-308"},
       {.want = 0x0010000000000000, .str = "2.2250738585072014E-308"},
+      {.want = 0x001FFFFFFFFFFFFF, .str = "4.4501477170144023e-308"},
+      {.want = 0x0031FA182C40C60D, .str = "1e-307"},
+      {.want = 0x369C2DF8DA5B6CA8, .str = "1.234e-45"},
       {.want = 0x369C314ABE948EB1,
        .str = "0.0000000000000000000000000000000000000000000012345678900000"},
+      {.want = 0x3B92E3B40A0E9B4F, .str = "0.000000000000000000001"},
+      {.want = 0x3E70000000000000, .str = "5.9604644775390625e-8"},
       {.want = 0x3F88000000000000, .str = "0.01171875"},
+      {.want = 0x3FB999999999999A, .str = "0.1"},
       {.want = 0x3FD0000000000000, .str = ".25"},
       {.want = 0x3FD3333333333333,
        .str = "0.2999999999999999888977697537484345957636833190917968750000"},
@@ -649,6 +657,7 @@ test_wuffs_strconv_parse_number_f64() {
       {.want = 0x4038000000000000, .str = "2400_00000_00000.00000_e-_1_2"},
       {.want = 0x40FE240C9FCB0C02, .str = "123456.789012"},
       {.want = 0x4202A05F20000000, .str = "1e10"},
+      {.want = 0x42A0624DD2F1A9FC, .str = "9007199254740993e-3"},
       {.want = 0x4330000000000000, .str = "4503599627370496"},  // 1 << 52.
       {.want = 0x4330000000000000, .str = "4503599627370496.5"},
       {.want = 0x4330000000000001, .str = "4503599627370497"},
@@ -660,11 +669,20 @@ test_wuffs_strconv_parse_number_f64() {
       {.want = 0x4340000000000002, .str = "9007199254740995"},
       {.want = 0x4340000000000002, .str = "9007199254740996"},
       {.want = 0x4340000000000002, .str = "9_007__199_254__740_996"},
+      {.want = 0x4370000000000000, .str = "7.2057594037927933e+16"},
+      {.want = 0x43E158E460913D00, .str = "9999999999999999999"},
       {.want = 0x4415AF1D78B58C40, .str = "1e20"},
+      {.want = 0x441AC53A7E04BCDA, .str = "123456789012345678901"},
+      {.want = 0x44B52D02C7E14AF6, .str = "1e23"},
       {.want = 0x46293E5939A08CEA, .str = "1e30"},
       {.want = 0x54B249AD2594C37D, .str = "+1E+100"},
       {.want = 0x54B249AD2594C37D, .str = "+_1_E_+_1_0_0_"},
+      {.want = 0x7BBA44DF832B8D46, .str = "1e288"},
+      {.want = 0x7BF06B0BB1FB384C, .str = "1e289"},
+      {.want = 0x7FE0000000000000, .str = "8.98846567431158e307"},
       {.want = 0x7FEFFFFFFFFFFFFF, .str = "1.7976931348623157e308"},
+      {.want = 0x7FEFFFFFFFFFFFFF, .str = "1.7976931348623158e308"},
+      {.want = 0x7FF0000000000000, .str = "1.7976931348623159e308"},
       {.want = 0x7FF0000000000000, .str = "1.8e308"},
       {.want = 0x7FF0000000000000, .str = "1e+316"},
       {.want = 0x7FF0000000000000, .str = "1e999"},
@@ -674,6 +692,8 @@ test_wuffs_strconv_parse_number_f64() {
       {.want = 0x7FFFFFFFFFFFFFFF, .str = "_+_NaN_"},
       {.want = 0x7FFFFFFFFFFFFFFF, .str = "nan"},
       {.want = 0x8000000000000000, .str = "-0.000e0"},
+      {.want = 0x81B01297D23AB683, .str = "-1.5e-300"},
+      {.want = 0xBFF4000000000000, .str = "-12.5e-1"},
       {.want = 0xC008000000000000, .str = "-3"},
       {.want = 0xFFF0000000000000, .str = "-2e308"},
       {.want = 0xFFF0000000000000, .str = "-inf"},
@@ -685,11 +705,14 @@ test_wuffs_strconv_parse_number_f64() {
 
       {.want = fail, .str = " 0"},
       {.want = fail, .str = ""},
+      {.want = fail, .str = "-"},
       {.want = fail, .str = "."},
       {.want = fail, .str = "00"},
       {.want = fail, .str = "001.2"},
       {.want = fail, .str = "06.44"},
       {.want = fail, .str = "0644"},
+      {.want = fail, .str = "0x10"},
+      {.want = fail, .str = "1.2.3"},
       {.want = fail, .str = "1234 67.8e9"},
       {.want = fail, .str = "2,345,678"},  // Two ','s.
       {.want = fail, .str = "2.345,678"},  // One '.' and one ','.
@@ -697,6 +720,7 @@ test_wuffs_strconv_parse_number_f64() {
       {.want = fail, .str = "7 .9"},
       {.want = fail, .str = "7e"},
       {.want = fail, .str = "7e-"},
+      {.want = fail, .str = "7e+"},
       {.want = fail, .str = "7e-+1"},
       {.want = fail, .str = "7e++1"},
       {.want = fail, .str = "NAN "},
@@ -723,6 +747,57 @@ test_wuffs_strconv_parse_number_f64() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_strconv_parse_number_f64_vs_strtod() {
+  CHECK_FOCUS(__func__);
+
+  // Compare against the C library's strtod, which is correctly rounded (at
+  // least for glibc), on pseudo-random inputs. These cover the exact float64
+  // fast path, the Eisel-Lemire fast path and the slow path's fallbacks.
+  uint64_t x = 0x0123456789ABCDEF;  // xorshift64 state.
+  char str[64];
+  int i;
+  for (i = 0; i < 300000; i++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    switch (i % 3) {
+      case 0:  // A random finite float64, with 15, 16 or 17 digits.
+        if (((x >> 52) & 0x7FF) == 0x7FF) {
+          continue;
+        }
+        snprintf(str, sizeof(str), "%.*g", 15 + (int)((x >> 8) % 3),
+                 wuffs_base__ieee_754_bit_representation__to_f64(x));
+        break;
+      case 1:  // Up to 20 random digits and a random exponent.
+        snprintf(str, sizeof(str), "%" PRIu64 "e%d", x >> (x & 63),
+                 ((int)((x >> 16) % 700)) - 350);
+        break;
+      default:  // 20 or more digits, which are always the slow path.
+        snprintf(str, sizeof(str), "%.*e", 19 + (int)((x >> 8) % 8),
+                 wuffs_base__ieee_754_bit_representation__to_f64(
+                     x & 0x7FEFFFFFFFFFFFFF));
+        break;
+    }
+
+    uint64_t want =
+        wuffs_base__ieee_754_bit_representation__from_f64(strtod(str, NULL));
+    wuffs_base__result_f64 r = wuffs_base__parse_number_f64(
+        wuffs_base__make_slice_u8((void*)str, strlen(str)));
+    if (r.status.repr) {
+      RETURN_FAIL("\"%s\": %s", str, r.status.repr);
+    }
+    uint64_t have = wuffs_base__ieee_754_bit_representation__from_f64(r.value);
+    if (have != want) {
+      RETURN_FAIL("\"%s\": have 0x%" PRIX64 ", want 0x%" PRIX64, str, have,
+                  want);
+    }
+  }
+
+  return NULL;
+}
+
 const char*  //
 test_wuffs_strconv_parse_number_i64() {
   CHECK_FOCUS(__func__);
@@ -858,6 +933,334 @@ test_wuffs_strconv_parse_number_u64() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_strconv_render_number_f64() {
+  CHECK_FOCUS(__func__);
+
+  const uint32_t e = WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT;
+  const uint32_t f = WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT;
+  const uint32_t j = WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION;
+
+  struct {
+    uint64_t x;
+    uint32_t precision;
+    uint32_t options;
+    const char* want;
+  } test_cases[] = {
+      {.x = 0x0000000000000000, .precision = 0, .options = j, .want = "0"},
+      {.x = 0x0000000000000000,
+       .precision = 2,
+       .options = e,
+       .want = "0.00e+00"},
+      {.x = 0x0000000000000000, .precision = 2, .options = f, .want = "0.00"},
+      {.x = 0x0000000000000001, .precision = 0, .options = j, .want = "5e-324"},
+      {.x = 0x0000000000000001,
+       .precision = 3,
+       .options = e,
+       .want = "4.941e-324"},
+      {.x = 0x0010000000000000,
+       .precision = 0,
+       .options = j,
+       .want = "2.2250738585072014e-308"},
+      {.x = 0x3EB0C6F7A0B5ED8D,
+       .precision = 0,
+       .options = j,
+       .want = "0.000001"},
+      {.x = 0x3E7AD7F29ABCAF48, .precision = 0, .options = j, .want = "1e-07"},
+      {.x = 0x3FB999999999999A, .precision = 0, .options = j, .want = "0.1"},
+      {.x = 0x3FB999999999999A,
+       .precision = 20,
+       .options = f,
+       .want = "0.10000000000000000555"},
+      {.x = 0x3FD3333333333333, .precision = 0, .options = j, .want = "0.3"},
+      {.x = 0x3FD3333333333334,
+       .precision = 0,
+       .options = j,
+       .want = "0.30000000000000004"},
+      {.x = 0x3FE0000000000000, .precision = 0, .options = f, .want = "0"},
+      {.x = 0x3FF8000000000000, .precision = 0, .options = f, .want = "2"},
+      {.x = 0x3FF8000000000000,
+       .precision = 2,
+       .options =
+           f | WUFFS_BASE__RENDER_NUMBER_FXX__DECIMAL_SEPARATOR_IS_A_COMMA,
+       .want = "1,50"},
+      {.x = 0x4004000000000000, .precision = 0, .options = f, .want = "2"},
+      {.x = 0x400921FB54442D18,
+       .precision = 0,
+       .options = j,
+       .want = "3.141592653589793"},
+      {.x = 0x400921FB54442D18, .precision = 0, .options = 0, .want = "3"},
+      {.x = 0x400921FB54442D18, .precision = 4, .options = 0, .want = "3.142"},
+      {.x = 0x400921FB54442D18,
+       .precision = 4,
+       .options = e,
+       .want = "3.1416e+00"},
+      {.x = 0x400921FB54442D18,
+       .precision = 0,
+       .options = e | j,
+       .want = "3.141592653589793e+00"},
+      {.x = 0x4023FAE147AE147B, .precision = 1, .options = f, .want = "10.0"},
+      {.x = 0x40FE240C9FCB0C02,
+       .precision = 0,
+       .options = j,
+       .want = "123456.789012"},
+      {.x = 0x40FE240C9FCB0C02, .precision = 6, .options = 0, .want = "123457"},
+      {.x = 0x40FE240C9FCB0C02,
+       .precision = 5,
+       .options = 0,
+       .want = "1.2346e+05"},
+      {.x = 0x4340000000000000,
+       .precision = 0,
+       .options = j,
+       .want = "9007199254740992"},
+      {.x = 0x4415AF1D78B58C40,
+       .precision = 0,
+       .options = j,
+       .want = "100000000000000000000"},
+      {.x = 0x441AC53A7E04BCDA,
+       .precision = 0,
+       .options = j,
+       .want = "123456789012345680000"},
+      {.x = 0x444B1AE4D6E2EF50, .precision = 0, .options = j, .want = "1e+21"},
+      {.x = 0x44B52D02C7E14AF6, .precision = 0, .options = j, .want = "1e+23"},
+      {.x = 0x44B52D02C7E14AF6,
+       .precision = 0,
+       .options = f | j,
+       .want = "100000000000000000000000"},
+      {.x = 0x44B52D02C7E14AF6,
+       .precision = 0,
+       .options = f,
+       .want = "99999999999999991611392"},
+      {.x = 0x7FEFFFFFFFFFFFFF,
+       .precision = 0,
+       .options = j,
+       .want = "1.7976931348623157e+308"},
+      {.x = 0x7FF0000000000000, .precision = 0, .options = 0, .want = "Inf"},
+      {.x = 0x7FF0000000000000,
+       .precision = 0,
+       .options = WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN,
+       .want = "+Inf"},
+      {.x = 0x7FFFFFFFFFFFFFFF, .precision = 0, .options = 0, .want = "NaN"},
+      {.x = 0x8000000000000000, .precision = 0, .options = j, .want = "-0"},
+      {.x = 0xBFF8000000000000,
+       .precision = 3,
+       .options = e,
+       .want = "-1.500e+00"},
+      {.x = 0xFFF0000000000000, .precision = 0, .options = 0, .want = "-Inf"},
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    uint8_t buf[64];
+    size_t n = wuffs_base__render_number_f64(
+        wuffs_base__make_slice_u8(&buf[0], sizeof buf),
+        wuffs_base__ieee_754_bit_representation__to_f64(test_cases[tc].x),
+        test_cases[tc].precision, test_cases[tc].options);
+    size_t want_len = strlen(test_cases[tc].want);
+    if ((n != want_len) || memcmp(&buf[0], test_cases[tc].want, n)) {
+      RETURN_FAIL("0x%" PRIX64 ", %" PRIu32 ", 0x%" PRIX32
+                  ": have \"%.*s\", want \"%s\"",
+                  test_cases[tc].x, test_cases[tc].precision,
+                  test_cases[tc].options, (int)n, buf, test_cases[tc].want);
+    }
+
+    // A dst one byte too short should write nothing.
+    if (want_len > 0) {
+      memset(&buf[0], 0xFF, sizeof buf);
+      n = wuffs_base__render_number_f64(
+          wuffs_base__make_slice_u8(&buf[0], want_len - 1),
+          wuffs_base__ieee_754_bit_representation__to_f64(test_cases[tc].x),
+          test_cases[tc].precision, test_cases[tc].options);
+      if ((n != 0) || (buf[0] != 0xFF)) {
+        RETURN_FAIL("0x%" PRIX64 ": dst too short: have %zu bytes written",
+                    test_cases[tc].x, n);
+      }
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_strconv_render_number_f64_vs_snprintf() {
+  CHECK_FOCUS(__func__);
+
+  // Compare the fixed precision modes against the C library's snprintf, which
+  // is exact (at least for glibc), on pseudo-random inputs. For the just
+  // enough precision mode, check that the output parses back to the same
+  // float64 and that no shorter "%.*e" output would have done.
+  const char* formats[3] = {"%.*e", "%.*f", "%.*g"};
+  const uint32_t options[3] = {
+      WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT,
+      WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT,
+      WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS,
+  };
+  uint64_t x = 0x0123456789ABCDEF;  // xorshift64 state.
+  char have[512];
+  char want[512];
+  int i;
+  for (i = 0; i < 100000; i++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    if (((x >> 52) & 0x7FF) == 0x7FF) {
+      continue;
+    }
+    double d = wuffs_base__ieee_754_bit_representation__to_f64(x);
+    int precision = (int)((x >> 8) % 25);
+
+    int k;
+    for (k = 0; k < 3; k++) {
+      size_t n = wuffs_base__render_number_f64(
+          wuffs_base__make_slice_u8((void*)have, sizeof have), d,
+          (uint32_t)precision, options[k]);
+      snprintf(want, sizeof want, formats[k], precision, d);
+      if ((n != strlen(want)) || memcmp(have, want, n)) {
+        RETURN_FAIL("0x%" PRIX64 ", \"%s\": have \"%.*s\", want \"%s\"", x,
+                    formats[k], (int)n, have, want);
+      }
+    }
+
+    size_t n = wuffs_base__render_number_f64(
+        wuffs_base__make_slice_u8((void*)have, sizeof have), d, 0,
+        WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_PRESENT |
+            WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION);
+    wuffs_base__result_f64 r =
+        wuffs_base__parse_number_f64(wuffs_base__make_slice_u8((void*)have, n));
+    if (r.status.repr ||
+        (wuffs_base__ieee_754_bit_representation__from_f64(r.value) != x)) {
+      RETURN_FAIL("0x%" PRIX64 ": \"%.*s\" does not round-trip", x, (int)n,
+                  have);
+    }
+    size_t have_digits = 0;
+    size_t m;
+    for (m = 0; (m < n) && (have[m] != 'e'); m++) {
+      have_digits += ('0' <= have[m]) && (have[m] <= '9');
+    }
+    if (have_digits > 1) {
+      snprintf(want, sizeof want, "%.*e", (int)have_digits - 2, d);
+      if (strtod(want, NULL) == d) {
+        RETURN_FAIL("0x%" PRIX64 ": \"%.*s\" is longer than \"%s\"", x, (int)n,
+                    have, want);
+      }
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_strconv_render_number_i64() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    int64_t x;
+    uint32_t options;
+    const char* want;
+  } test_cases[] = {
+      {.x = +0x0000000000000000, .options = 0, .want = "0"},
+      {.x = +0x0000000000000000,
+       .options = WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN,
+       .want = "+0"},
+      {.x = +0x0000000000000009, .options = 0, .want = "9"},
+      {.x = +0x000000000000000A, .options = 0, .want = "10"},
+      {.x = +0x0000000000000063, .options = 0, .want = "99"},
+      {.x = +0x0000000000000064, .options = 0, .want = "100"},
+      {.x = +0x000000000000012C,
+       .options = WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN,
+       .want = "+300"},
+      {.x = +0x7FFFFFFFFFFFFFFF, .options = 0, .want = "9223372036854775807"},
+      {.x = -0x0000000000000001, .options = 0, .want = "-1"},
+      {.x = -0x00000000000000AB,
+       .options = WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN,
+       .want = "-171"},
+      {.x = -0x7FFFFFFFFFFFFFFF, .options = 0, .want = "-9223372036854775807"},
+      {.x = -0x7FFFFFFFFFFFFFFF - 1,
+       .options = 0,
+       .want = "-9223372036854775808"},
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    uint8_t buf[WUFFS_BASE__I64__BYTE_LENGTH__MAX_INCL];
+    size_t n = wuffs_base__render_number_i64(
+        wuffs_base__make_slice_u8(&buf[0], sizeof buf), test_cases[tc].x,
+        test_cases[tc].options);
+    if ((n != strlen(test_cases[tc].want)) ||
+        memcmp(&buf[0], test_cases[tc].want, n)) {
+      RETURN_FAIL("0x%" PRIX64 ": have \"%.*s\", want \"%s\"",
+                  (uint64_t)(test_cases[tc].x), (int)n, buf,
+                  test_cases[tc].want);
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_strconv_render_number_u64() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    uint64_t x;
+    uint32_t options;
+    const char* want;
+  } test_cases[] = {
+      {.x = 0x0000000000000000, .options = 0, .want = "0"},
+      {.x = 0x000000000000007B, .options = 0, .want = "123"},
+      {.x = 0x000000000000007B,
+       .options = WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT,
+       .want = "123"},
+      {.x = 0x00000000FFFFFFFF, .options = 0, .want = "4294967295"},
+      {.x = 0x0000000100000000, .options = 0, .want = "4294967296"},
+      {.x = 0xFFFFFFFFFFFFFFFF, .options = 0, .want = "18446744073709551615"},
+      {.x = 0xFFFFFFFFFFFFFFFF,
+       .options = WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT |
+                  WUFFS_BASE__RENDER_NUMBER_XXX__LEADING_PLUS_SIGN,
+       .want = "+18446744073709551615"},
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    uint8_t buf[24];
+    memset(&buf[0], '_', sizeof buf);
+    size_t n = wuffs_base__render_number_u64(
+        wuffs_base__make_slice_u8(&buf[0], sizeof buf), test_cases[tc].x,
+        test_cases[tc].options);
+
+    // Find where the number was rendered. The rest of buf should be
+    // untouched.
+    size_t i = 0;
+    if (test_cases[tc].options & WUFFS_BASE__RENDER_NUMBER_XXX__ALIGN_RIGHT) {
+      i = sizeof buf - n;
+    }
+    if ((n != strlen(test_cases[tc].want)) ||
+        memcmp(&buf[i], test_cases[tc].want, n)) {
+      RETURN_FAIL("0x%" PRIX64 ": have \"%.*s\", want \"%s\"", test_cases[tc].x,
+                  (int)n, &buf[i], test_cases[tc].want);
+    }
+    size_t j;
+    for (j = 0; j < sizeof buf; j++) {
+      if (((j < i) || ((i + n) <= j)) && (buf[j] != '_')) {
+        RETURN_FAIL("0x%" PRIX64 ": buf[%zu] was overwritten", test_cases[tc].x,
+                    j);
+      }
+    }
+
+    // A dst one byte too short should write nothing.
+    memset(&buf[0], '_', sizeof buf);
+    n = wuffs_base__render_number_u64(
+        wuffs_base__make_slice_u8(&buf[0], strlen(test_cases[tc].want) - 1),
+        test_cases[tc].x, test_cases[tc].options);
+    if ((n != 0) || (buf[0] != '_')) {
+      RETURN_FAIL("0x%" PRIX64 ": dst too short: have %zu bytes written",
+                  test_cases[tc].x, n);
+    }
+  }
+
+  return NULL;
+}
+
 const char*  //
 test_wuffs_strconv_utf_8_next() {
   CHECK_FOCUS(__func__);
@@ -982,6 +1385,10 @@ golden_test g_json_github_tags_gt = {
     .src_filename = "test/data/github-tags.json",
 };
 
+golden_test g_json_json_things_formatted_gt = {
+    .src_filename = "test/data/json-things.formatted.json",
+};
+
 golden_test g_json_json_things_unformatted_gt = {
     .want_filename = "test/data/json-things.unformatted.tokens",
     .src_filename = "test/data/json-things.unformatted.json",
@@ -996,6 +1403,111 @@ golden_test g_json_nobel_prizes_gt = {
     .src_filename = "test/data/nobel-prizes.json",
 };
 
+golden_test g_json_nobel_prizes_lines_gt = {
+    .src_filename = "test/data/nobel-prizes.jsonl",
+};
+
+// ---------------- Parallel JSON Lines Decoding
+
+#define JSON_LINES_MAX_THREADS 8
+
+typedef struct {
+  wuffs_base__slice_u8 data;
+  wuffs_base__slice_token tokens;
+  uint32_t wuffs_initialize_flags;
+  size_t num_records;
+  size_t num_tokens;
+  const char* status_repr;
+} json_lines_thread_arg;
+
+void*  //
+json_lines_thread_func(void* arg) {
+  json_lines_thread_arg* a = (json_lines_thread_arg*)(arg);
+  wuffs_base__io_buffer src = wuffs_base__slice_u8__reader(a->data, true);
+  wuffs_base__token_buffer tok = wuffs_base__slice_token__writer(a->tokens);
+
+  // Each line is a separate top-level JSON value, decoded by a freshly
+  // initialized decoder. The QUIRK_ALLOW_TRAILING_NEW_LINE quirk consumes the
+  // '\n' that ends the line.
+  while (src.meta.ri < src.meta.wi) {
+    wuffs_json__decoder dec;
+    wuffs_base__status status = wuffs_json__decoder__initialize(
+        &dec, sizeof dec, WUFFS_VERSION, a->wuffs_initialize_flags);
+    if (wuffs_base__status__is_ok(&status)) {
+      wuffs_json__decoder__set_quirk_enabled(
+          &dec, WUFFS_JSON__QUIRK_ALLOW_TRAILING_NEW_LINE, true);
+      status = wuffs_json__decoder__decode_tokens(&dec, &tok, &src,
+                                                  wuffs_base__empty_slice_u8());
+    }
+    if (!wuffs_base__status__is_ok(&status)) {
+      a->status_repr = status.repr;
+      return NULL;
+    }
+    a->num_records++;
+  }
+  a->num_tokens = tok.meta.wi;
+  return NULL;
+}
+
+// do_json_decode_lines_in_parallel decodes JSON Lines (also known as NDJSON)
+// data, one top-level JSON value per line. It splits data into num_threads
+// parts (at line boundaries), decodes each part independently (on separate
+// threads, if available) into a separate region of tokens and then moves
+// those regions together, so that the first *num_tokens_out elements of
+// tokens are the same as for a single-threaded decoding.
+const char*  //
+do_json_decode_lines_in_parallel(wuffs_base__slice_u8 data,
+                                 uint32_t wuffs_initialize_flags,
+                                 size_t num_threads,
+                                 wuffs_base__slice_token tokens,
+                                 size_t* num_records_out,
+                                 size_t* num_tokens_out) {
+  if ((num_threads == 0) || (num_threads > WUFFS_TESTLIB_MAX_THREADS)) {
+    return "do_json_decode_lines_in_parallel: bad num_threads";
+  }
+  json_lines_thread_arg args[WUFFS_TESTLIB_MAX_THREADS];
+  size_t part_len = data.len / num_threads;
+  size_t region_len = tokens.len / num_threads;
+  size_t i;
+  size_t j = 0;
+  for (i = 0; i < num_threads; i++) {
+    // Extend each part to end just after a '\n'.
+    size_t k = (i + 1 < num_threads) ? ((i + 1) * part_len) : data.len;
+    if (k < j) {
+      k = j;
+    }
+    while ((j < k) && (k < data.len) && (data.ptr[k - 1] != '\n')) {
+      k++;
+    }
+    args[i].data = wuffs_base__slice_u8__subslice_ij(data, j, k);
+    args[i].tokens =
+        wuffs_base__make_slice_token(tokens.ptr + (i * region_len), region_len);
+    args[i].wuffs_initialize_flags = wuffs_initialize_flags;
+    args[i].num_records = 0;
+    args[i].num_tokens = 0;
+    args[i].status_repr = NULL;
+    j = k;
+  }
+
+  CHECK_STRING(run_in_parallel(&json_lines_thread_func, args, sizeof(args[0]),
+                               num_threads));
+
+  *num_records_out = 0;
+  *num_tokens_out = 0;
+  for (i = 0; i < num_threads; i++) {
+    if (args[i].status_repr) {
+      return args[i].status_repr;
+    }
+    if (args[i].tokens.ptr != (tokens.ptr + *num_tokens_out)) {
+      memmove(tokens.ptr + *num_tokens_out, args[i].tokens.ptr,
+              args[i].num_tokens * sizeof(wuffs_base__token));
+    }
+    *num_records_out += args[i].num_records;
+    *num_tokens_out += args[i].num_tokens;
+  }
+  return NULL;
+}
+
 // ---------------- JSON Tests
 
 const char*  //
@@ -1133,6 +1645,66 @@ test_wuffs_json_decode_end_of_data() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_json_decode_lines_in_parallel() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, g_json_nobel_prizes_lines_gt.src_filename));
+  wuffs_base__slice_u8 data =
+      wuffs_base__make_slice_u8(src.data.ptr, src.meta.wi);
+
+  size_t want_num_records = 0;
+  size_t i;
+  for (i = 0; i < data.len; i++) {
+    want_num_records += (data.ptr[i] == '\n') ? 1 : 0;
+  }
+
+  size_t want_num_tokens = 0;
+  size_t num_records = 0;
+  CHECK_STRING(do_json_decode_lines_in_parallel(
+      data, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, 1,
+      g_want_slice_token, &num_records, &want_num_tokens));
+  if (num_records != want_num_records) {
+    RETURN_FAIL("num_records: have %zu, want %zu", num_records,
+                want_num_records);
+  }
+  uint64_t total_length = 0;
+  for (i = 0; i < want_num_tokens; i++) {
+    total_length += wuffs_base__token__length(&g_want_slice_token.ptr[i]);
+  }
+  if (total_length != data.len) {
+    RETURN_FAIL("total_length: have %" PRIu64 ", want %zu", total_length,
+                data.len);
+  }
+
+  size_t num_threads;
+  for (num_threads = 2; num_threads <= JSON_LINES_MAX_THREADS; num_threads++) {
+    size_t have_num_tokens = 0;
+    CHECK_STRING(do_json_decode_lines_in_parallel(
+        data, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+        num_threads, g_have_slice_token, &num_records, &have_num_tokens));
+    if (num_records != want_num_records) {
+      RETURN_FAIL("num_threads=%zu: num_records: have %zu, want %zu",
+                  num_threads, num_records, want_num_records);
+    } else if (have_num_tokens != want_num_tokens) {
+      RETURN_FAIL("num_threads=%zu: num_tokens: have %zu, want %zu",
+                  num_threads, have_num_tokens, want_num_tokens);
+    }
+    for (i = 0; i < want_num_tokens; i++) {
+      if (g_have_slice_token.ptr[i].repr != g_want_slice_token.ptr[i].repr) {
+        RETURN_FAIL("num_threads=%zu: token #%zu: have 0x%" PRIX64
+                    ", want 0x%" PRIX64,
+                    num_threads, i, g_have_slice_token.ptr[i].repr,
+                    g_want_slice_token.ptr[i].repr);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_json_decode_long_numbers() {
   CHECK_FOCUS(__func__);
@@ -2204,6 +2776,110 @@ test_wuffs_json_decode_unicode4_escapes() {
 // The JSON specification doesn't give a maximum byte length for a number, but
 // implementations are permitted to impose one. Wuffs' implementation imposes
 // WUFFS_JSON__DECODER_NUMBER_LENGTH_MAX_INCL.
+const char*  //
+test_wuffs_json_decode_source_positions() {
+  CHECK_FOCUS(__func__);
+
+  // Read the whole file into full, then feed it to the decoder in small
+  // chunks, with a small token buffer, so that both the src and tok buffers
+  // are compacted many times.
+  wuffs_base__io_buffer full = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&full, g_json_australian_abc_gt.src_filename));
+
+  wuffs_json__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_json__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  uint64_t positions[50];
+  wuffs_base__token_buffer tok = wuffs_base__slice_token__writer(
+      wuffs_base__make_slice_token(g_have_slice_token.ptr, 50));
+  wuffs_base__io_buffer src = wuffs_base__slice_u8__writer(
+      wuffs_base__make_slice_u8(g_want_slice_u8.ptr, 1000));
+
+  uint64_t pos = wuffs_base__io_buffer__reader_io_position(&src);
+  bool prev_continued = false;
+  int num_checked = 0;
+  while (true) {
+    size_t old_wi = tok.meta.wi;
+    wuffs_base__status status =
+        wuffs_json__decoder__decode_tokens(&dec, &tok, &src, g_work_slice_u8);
+
+    wuffs_base__slice_token new_tokens = wuffs_base__make_slice_token(
+        tok.data.ptr + old_wi, tok.meta.wi - old_wi);
+    pos = wuffs_base__slice_token__source_positions(
+        wuffs_base__make_slice_u64(&positions[0], 50), new_tokens, pos);
+
+    // Check that each structure, string or number token starts at a plausible
+    // byte in the original file.
+    size_t i;
+    for (i = 0; i < new_tokens.len; i++) {
+      wuffs_base__token* t = &new_tokens.ptr[i];
+      if (positions[i] >= full.meta.wi) {
+        RETURN_FAIL("position %" PRIu64 " is out of bounds", positions[i]);
+      }
+      uint8_t c = full.data.ptr[positions[i]];
+      const char* want = NULL;
+      switch (wuffs_base__token__value_base_category(t)) {
+        case WUFFS_BASE__TOKEN__VBC__STRUCTURE:
+          want = "[]{}";
+          break;
+        case WUFFS_BASE__TOKEN__VBC__STRING:
+          want = prev_continued ? NULL : "\"";
+          break;
+        case WUFFS_BASE__TOKEN__VBC__NUMBER:
+          want = "-0123456789";
+          break;
+      }
+      if (want) {
+        if (!strchr(want, c)) {
+          RETURN_FAIL("position %" PRIu64 ": have '%c', want one of \"%s\"",
+                      positions[i], c, want);
+        }
+        num_checked++;
+      }
+      prev_continued = wuffs_base__token__continued(t);
+    }
+
+    if (status.repr == NULL) {
+      break;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      if (pos != wuffs_base__io_buffer__reader_io_position(&src)) {
+        RETURN_FAIL("short read: have position %" PRIu64 ", want %" PRIu64, pos,
+                    wuffs_base__io_buffer__reader_io_position(&src));
+      }
+      wuffs_base__io_buffer__compact(&src);
+      uint64_t n = wuffs_base__u64__min(
+          full.meta.wi - wuffs_base__io_buffer__writer_io_position(&src),
+          src.data.len - src.meta.wi);
+      memcpy(src.data.ptr + src.meta.wi,
+             full.data.ptr + wuffs_base__io_buffer__writer_io_position(&src),
+             n);
+      src.meta.wi += n;
+      src.meta.closed =
+          wuffs_base__io_buffer__writer_io_position(&src) == full.meta.wi;
+    } else if (status.repr == wuffs_base__suspension__short_write) {
+      tok.meta.ri = tok.meta.wi;
+      wuffs_base__token_buffer__compact(&tok);
+    } else {
+      RETURN_FAIL("decode_tokens: \"%s\"", status.repr);
+    }
+  }
+
+  // The decoder stops after the top-level value, without consuming the file's
+  // trailing new line.
+  if (pos != wuffs_base__io_buffer__reader_io_position(&src)) {
+    RETURN_FAIL("final position: have %" PRIu64 ", want %" PRIu64, pos,
+                wuffs_base__io_buffer__reader_io_position(&src));
+  } else if (num_checked < 1000) {
+    RETURN_FAIL("num_checked: have %d, want >= 1000", num_checked);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_json_decode_src_io_buffer_length() {
   CHECK_FOCUS(__func__);
@@ -2370,6 +3046,174 @@ test_wuffs_json_decode_string() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_json_decode_string_special_bytes() {
+  CHECK_FOCUS(__func__);
+
+  const char* bad_ccc = wuffs_json__error__bad_c0_control_code;
+  const char* bad_utf = wuffs_json__error__bad_utf_8;
+
+  // Put special bytes at every offset within the 8 (and 4) bytes at a time
+  // fast paths.
+  struct {
+    const char* want_status_repr;
+    const char* special;
+    size_t special_len;
+  } test_cases[] = {
+      {.want_status_repr = NULL, .special = "", .special_len = 0},
+      {.want_status_repr = NULL, .special = "\\n", .special_len = 2},
+      {.want_status_repr = NULL, .special = "\x7F", .special_len = 1},
+      {.want_status_repr = NULL, .special = "\xC2\x80", .special_len = 2},
+      {.want_status_repr = bad_ccc, .special = "\x00", .special_len = 1},
+      {.want_status_repr = bad_ccc, .special = "\x1F", .special_len = 1},
+      {.want_status_repr = bad_utf, .special = "\x80", .special_len = 1},
+      {.want_status_repr = bad_utf, .special = "\xFF", .special_len = 1},
+  };
+
+  const size_t suffix_lens[] = {0, 1, 7, 8, 9, 17};
+
+  wuffs_json__decoder dec;
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    size_t prefix_len;
+    for (prefix_len = 0; prefix_len < 40; prefix_len++) {
+      int s;
+      for (s = 0; s < WUFFS_TESTLIB_ARRAY_SIZE(suffix_lens); s++) {
+        uint8_t str[64];
+        size_t n = 0;
+        str[n++] = '"';
+        memset(str + n, 'a', prefix_len);
+        n += prefix_len;
+        memcpy(str + n, test_cases[tc].special, test_cases[tc].special_len);
+        n += test_cases[tc].special_len;
+        memset(str + n, 'a', suffix_lens[s]);
+        n += suffix_lens[s];
+        str[n++] = '"';
+
+        CHECK_STATUS("initialize",
+                     wuffs_json__decoder__initialize(
+                         &dec, sizeof dec, WUFFS_VERSION,
+                         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+        wuffs_base__token_buffer tok =
+            wuffs_base__slice_token__writer(g_have_slice_token);
+        wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(str, n, true);
+        wuffs_base__status have_status = wuffs_json__decoder__decode_tokens(
+            &dec, &tok, &src, g_work_slice_u8);
+
+        uint64_t total_length = 0;
+        size_t i;
+        for (i = tok.meta.ri; i < tok.meta.wi; i++) {
+          wuffs_base__token* t = &tok.data.ptr[i];
+          total_length = wuffs_base__u64__sat_add(
+              total_length, wuffs_base__token__length(t));
+        }
+
+        if (have_status.repr != test_cases[tc].want_status_repr) {
+          RETURN_FAIL("tc=%d, prefix_len=%zu, suffix_len=%zu: have \"%s\", "
+                      "want \"%s\"",
+                      tc, prefix_len, suffix_lens[s], have_status.repr,
+                      test_cases[tc].want_status_repr);
+        }
+
+        if (total_length != src.meta.ri) {
+          RETURN_FAIL("tc=%d, prefix_len=%zu, suffix_len=%zu: total length: "
+                      "have %" PRIu64 ", want %" PRIu64,
+                      tc, prefix_len, suffix_lens[s], total_length,
+                      src.meta.ri);
+        } else if (!have_status.repr && (total_length != n)) {
+          RETURN_FAIL("tc=%d, prefix_len=%zu, suffix_len=%zu: total length: "
+                      "have %" PRIu64 ", want %zu",
+                      tc, prefix_len, suffix_lens[s], total_length, n);
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_json_decode_whitespace() {
+  CHECK_FOCUS(__func__);
+
+  // Exercise the 8 spaces at a time fast path: runs of various lengths, mixed
+  // with other whitespace, straddling src buffer boundaries and longer than
+  // the maximum token length.
+  const char* patterns[] = {" ", "\t", "\n   ", "        \t", "\r\n\n  "};
+  const size_t lengths[] = {0, 1, 7, 8, 9, 15, 16, 17, 63, 65533, 65534,
+                            65535, 65536, 65543, 200000};
+  const size_t limits[] = {1, 7, 8, 4096, SIZE_MAX};
+
+  wuffs_json__decoder dec;
+  int p;
+  for (p = 0; p < WUFFS_TESTLIB_ARRAY_SIZE(patterns); p++) {
+    size_t pattern_len = strlen(patterns[p]);
+    int l;
+    for (l = 0; l < WUFFS_TESTLIB_ARRAY_SIZE(lengths); l++) {
+      size_t n = 0;
+      while (n < lengths[l]) {
+        g_src_array_u8[n] = patterns[p][n % pattern_len];
+        n++;
+      }
+      g_src_array_u8[n++] = '[';
+      g_src_array_u8[n++] = ']';
+
+      int q;
+      for (q = 0; q < WUFFS_TESTLIB_ARRAY_SIZE(limits); q++) {
+        CHECK_STATUS("initialize",
+                     wuffs_json__decoder__initialize(
+                         &dec, sizeof dec, WUFFS_VERSION,
+                         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+        wuffs_base__token_buffer tok =
+            wuffs_base__slice_token__writer(g_have_slice_token);
+        wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+            .data = g_src_slice_u8,
+            .meta = wuffs_base__empty_io_buffer_meta(),
+        });
+        src.meta.wi = n;
+
+        uint64_t total_length = 0;
+        while (true) {
+          size_t wi = src.meta.wi;
+          if (limits[q] < (wi - src.meta.ri)) {
+            src.meta.wi = src.meta.ri + limits[q];
+          }
+          src.meta.closed = src.meta.wi == n;
+
+          wuffs_base__status have_status = wuffs_json__decoder__decode_tokens(
+              &dec, &tok, &src, g_work_slice_u8);
+          src.meta.wi = wi;
+
+          for (; tok.meta.ri < tok.meta.wi; tok.meta.ri++) {
+            wuffs_base__token* t = &tok.data.ptr[tok.meta.ri];
+            total_length = wuffs_base__u64__sat_add(
+                total_length, wuffs_base__token__length(t));
+          }
+          tok.meta.ri = 0;
+          tok.meta.wi = 0;
+
+          if (have_status.repr == NULL) {
+            break;
+          } else if ((have_status.repr != wuffs_base__suspension__short_read) &&
+                     (have_status.repr != wuffs_base__suspension__short_write)) {
+            RETURN_FAIL("p=%d, l=%d, q=%d: %s", p, l, q, have_status.repr);
+          }
+        }
+
+        if (total_length != n) {
+          RETURN_FAIL("p=%d, l=%d, q=%d: total length: have %" PRIu64
+                      ", want %zu",
+                      p, l, q, total_length, n);
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -2396,6 +3240,52 @@ do_bench_wuffs_strconv_parse_number_f64(const char* str,
   return NULL;
 }
 
+// do_bench_wuffs_strconv_parse_number_f64_file parses, as a float64, every
+// number in a JSON file. Tokenizing the JSON happens once, outside of the
+// timed loop.
+const char*  //
+do_bench_wuffs_strconv_parse_number_f64_file(golden_test* gt,
+                                             uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, gt->src_filename));
+
+  wuffs_json__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_json__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__token_buffer tok =
+      wuffs_base__slice_token__writer(g_have_slice_token);
+  CHECK_STATUS("decode_tokens", wuffs_json__decoder__decode_tokens(
+                                    &dec, &tok, &src, g_work_slice_u8));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    uint8_t* ptr = src.data.ptr;
+    size_t j;
+    for (j = tok.meta.ri; j < tok.meta.wi; j++) {
+      wuffs_base__token* t = &tok.data.ptr[j];
+      size_t len = wuffs_base__token__length(t);
+      if (wuffs_base__token__value_base_category(t) ==
+          WUFFS_BASE__TOKEN__VBC__NUMBER) {
+        CHECK_STATUS("", wuffs_base__parse_number_f64(
+                             wuffs_base__make_slice_u8(ptr, len))
+                             .status);
+        n_bytes += len;
+      }
+      ptr += len;
+    }
+  }
+  bench_finish(iters, n_bytes);
+
+  return NULL;
+}
+
 const char*  //
 bench_wuffs_strconv_parse_number_f64_1_lsh53_add0() {
   CHECK_FOCUS(__func__);
@@ -2410,6 +3300,23 @@ bench_wuffs_strconv_parse_number_f64_1_lsh53_add1() {
   return do_bench_wuffs_strconv_parse_number_f64("9007199254740993", 1000);
 }
 
+const char*  //
+bench_wuffs_strconv_parse_number_f64_26k_numbers() {
+  CHECK_FOCUS(__func__);
+  // The numbers in australian-abc-local-stations.json are mostly latitude and
+  // longitude coordinates, like GeoJSON.
+  return do_bench_wuffs_strconv_parse_number_f64_file(&g_json_australian_abc_gt,
+                                                      1000);
+}
+
+const char*  //
+bench_wuffs_strconv_parse_number_f64_pi_17_digits() {
+  CHECK_FOCUS(__func__);
+  // 17 significant digits is what printf's "%.17g" produces, and too many for
+  // a float64 multiply or divide to be exact.
+  return do_bench_wuffs_strconv_parse_number_f64("3.1415926535897932", 1000);
+}
+
 const char*  //
 bench_wuffs_strconv_parse_number_f64_pi_long() {
   CHECK_FOCUS(__func__);
@@ -2423,6 +3330,90 @@ bench_wuffs_strconv_parse_number_f64_pi_short() {
   return do_bench_wuffs_strconv_parse_number_f64("3.14159", 1000);
 }
 
+const char*  //
+do_bench_wuffs_strconv_render_number_f64(double x,
+                                         uint32_t precision,
+                                         uint32_t options,
+                                         uint64_t iters_unscaled) {
+  uint8_t buf[64];
+  wuffs_base__slice_u8 dst = wuffs_base__make_slice_u8(&buf[0], sizeof buf);
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    size_t n = wuffs_base__render_number_f64(dst, x, precision, options);
+    if (n == 0) {
+      RETURN_FAIL("render_number_f64 wrote nothing");
+    }
+    n_bytes += n;
+  }
+  bench_finish(iters, n_bytes);
+
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_strconv_render_number_f64_1e23_just_enough() {
+  CHECK_FOCUS(__func__);
+  // 1e23 is a classic example of a float64 that is not exactly representable
+  // and whose shortest representation ("1e+23") is much shorter than its
+  // "%.17g" representation ("9.9999999999999992e+22").
+  return do_bench_wuffs_strconv_render_number_f64(
+      1e23, 0, WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION, 1000);
+}
+
+const char*  //
+bench_wuffs_strconv_render_number_f64_pi_exponent_absent_6() {
+  CHECK_FOCUS(__func__);
+  // This is the equivalent of printf's "%f".
+  return do_bench_wuffs_strconv_render_number_f64(
+      3.141592653589793, 6, WUFFS_BASE__RENDER_NUMBER_FXX__EXPONENT_ABSENT,
+      1000);
+}
+
+const char*  //
+bench_wuffs_strconv_render_number_f64_pi_just_enough() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_strconv_render_number_f64(
+      3.141592653589793, 0,
+      WUFFS_BASE__RENDER_NUMBER_FXX__JUST_ENOUGH_PRECISION, 1000);
+}
+
+const char*  //
+do_bench_wuffs_strconv_render_number_u64(uint64_t x,
+                                         uint64_t iters_unscaled) {
+  uint8_t buf[WUFFS_BASE__U64__BYTE_LENGTH__MAX_INCL];
+  wuffs_base__slice_u8 dst = wuffs_base__make_slice_u8(&buf[0], sizeof buf);
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    // Vary x a little, so that the compiler can't hoist the work out of the
+    // loop.
+    n_bytes += wuffs_base__render_number_u64(
+        dst, x ^ (i & 1), WUFFS_BASE__RENDER_NUMBER_XXX__DEFAULT_OPTIONS);
+  }
+  bench_finish(iters, n_bytes);
+
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_strconv_render_number_u64_max() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_strconv_render_number_u64(0xFFFFFFFFFFFFFFFF, 1000);
+}
+
+const char*  //
+bench_wuffs_strconv_render_number_u64_small() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_strconv_render_number_u64(1234, 1000);
+}
+
 // ---------------- JSON Benches
 
 const char*  //
@@ -2457,6 +3448,53 @@ bench_wuffs_json_decode_217k_stringy() {
       tcounter_src, &g_json_nobel_prizes_gt, UINT64_MAX, UINT64_MAX, 25);
 }
 
+const char*  //
+wuffs_bench_json_decode_lines(wuffs_base__io_buffer* dst,
+                              wuffs_base__io_buffer* src,
+                              uint32_t wuffs_initialize_flags,
+                              uint64_t wlimit,
+                              uint64_t rlimit) {
+  uint64_t len = src->meta.wi - src->meta.ri;
+  if (rlimit) {
+    len = wuffs_base__u64__min(len, rlimit);
+  }
+  size_t num_records = 0;
+  size_t num_tokens = 0;
+  CHECK_STRING(do_json_decode_lines_in_parallel(
+      wuffs_base__make_slice_u8(src->data.ptr + src->meta.ri, len),
+      wuffs_initialize_flags, g_flags.threads, g_have_slice_token,
+      &num_records, &num_tokens));
+  src->meta.ri += len;
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_json_decode_217k_lines_parallel() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_json_decode_lines,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_json_nobel_prizes_lines_gt, UINT64_MAX, UINT64_MAX, 25);
+}
+
+const char*  //
+bench_wuffs_json_decode_things_formatted() {
+  CHECK_FOCUS(__func__);
+  return do_bench_token_decoder(
+      wuffs_json_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_json_json_things_formatted_gt, UINT64_MAX, UINT64_MAX,
+      50000);
+}
+
+const char*  //
+bench_wuffs_json_decode_things_unformatted() {
+  CHECK_FOCUS(__func__);
+  return do_bench_token_decoder(
+      wuffs_json_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_json_json_things_unformatted_gt, UINT64_MAX, UINT64_MAX,
+      50000);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -2479,12 +3517,18 @@ proc g_tests[] = {
     test_wuffs_strconv_hpd_shift,
     test_wuffs_strconv_mpb_assign_from_hpd,
     test_wuffs_strconv_parse_number_f64,
+    test_wuffs_strconv_parse_number_f64_vs_strtod,
     test_wuffs_strconv_parse_number_i64,
     test_wuffs_strconv_parse_number_u64,
+    test_wuffs_strconv_render_number_f64,
+    test_wuffs_strconv_render_number_f64_vs_snprintf,
+    test_wuffs_strconv_render_number_i64,
+    test_wuffs_strconv_render_number_u64,
     test_wuffs_strconv_utf_8_next,
 
     test_wuffs_json_decode_end_of_data,
     test_wuffs_json_decode_interface,
+    test_wuffs_json_decode_lines_in_parallel,
     test_wuffs_json_decode_long_numbers,
     test_wuffs_json_decode_prior_valid_utf_8,
     test_wuffs_json_decode_quirk_allow_backslash_etc,
@@ -2495,9 +3539,12 @@ proc g_tests[] = {
     test_wuffs_json_decode_quirk_allow_leading_etc,
     test_wuffs_json_decode_quirk_allow_trailing_etc,
     test_wuffs_json_decode_quirk_replace_invalid_unicode,
+    test_wuffs_json_decode_source_positions,
     test_wuffs_json_decode_src_io_buffer_length,
     test_wuffs_json_decode_string,
+    test_wuffs_json_decode_string_special_bytes,
     test_wuffs_json_decode_unicode4_escapes,
+    test_wuffs_json_decode_whitespace,
 
 #ifdef WUFFS_MIMIC
 
@@ -2512,13 +3559,23 @@ proc g_benches[] = {
 
     bench_wuffs_strconv_parse_number_f64_1_lsh53_add0,
     bench_wuffs_strconv_parse_number_f64_1_lsh53_add1,
+    bench_wuffs_strconv_parse_number_f64_26k_numbers,
+    bench_wuffs_strconv_parse_number_f64_pi_17_digits,
     bench_wuffs_strconv_parse_number_f64_pi_long,
     bench_wuffs_strconv_parse_number_f64_pi_short,
+    bench_wuffs_strconv_render_number_f64_1e23_just_enough,
+    bench_wuffs_strconv_render_number_f64_pi_exponent_absent_6,
+    bench_wuffs_strconv_render_number_f64_pi_just_enough,
+    bench_wuffs_strconv_render_number_u64_max,
+    bench_wuffs_strconv_render_number_u64_small,
 
     bench_wuffs_json_decode_1k,
     bench_wuffs_json_decode_21k_formatted,
     bench_wuffs_json_decode_26k_compact,
+    bench_wuffs_json_decode_217k_lines_parallel,
     bench_wuffs_json_decode_217k_stringy,
+    bench_wuffs_json_decode_things_formatted,
+    bench_wuffs_json_decode_things_unformatted,
 
 #ifdef WUFFS_MIMIC
 
@@ -144,6 +144,190 @@ test_wuffs_wbmp_decode_image_config() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_wbmp_decode_with_options(const char* filename,
+                                       uint64_t rlimit,
+                                       wuffs_base__rect_ie_u32 clip,
+                                       uint32_t scale_denominator) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  // Decode the whole image to g_have_array_u8 and the clipped and scaled
+  // image, in rlimit-sized chunks, to g_pixel_array_u8.
+  wuffs_base__pixel_buffer pbs[2];
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_dst_clip_rect(&opts, clip);
+  wuffs_base__decode_frame_options__set_scale_denominator(&opts,
+                                                          scale_denominator);
+  uint32_t d = wuffs_base__decode_frame_options__scale_denominator(&opts);
+  wuffs_base__rect_ie_u32 scaled_bounds = ((wuffs_base__rect_ie_u32){});
+  int i;
+  for (i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_wbmp__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_wbmp__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_wbmp__decoder__decode_image_config(&dec, &ic, &src));
+    wuffs_base__rect_ie_u32 bounds =
+        wuffs_base__pixel_config__bounds(&ic.pixcfg);
+    scaled_bounds = wuffs_base__make_rect_ie_u32(
+        0, 0, (bounds.max_excl_x + d - 1) / d, (bounds.max_excl_y + d - 1) / d);
+    wuffs_base__rect_ie_u32 r = (i == 0) ? bounds : scaled_bounds;
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, r.max_excl_x, r.max_excl_y);
+    wuffs_base__slice_u8 pixbuf = (i == 0) ? g_have_slice_u8 : g_pixel_slice_u8;
+    uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if (n > pixbuf.len) {
+      RETURN_FAIL("pixbuf_len too large");
+    }
+    memset(pixbuf.ptr, 0xA5, n);
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pbs[i], &ic.pixcfg, pixbuf));
+
+    if (i == 0) {
+      CHECK_STATUS("decode_frame #0",
+                   wuffs_wbmp__decoder__decode_frame(
+                       &dec, &pbs[i], &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                       g_work_slice_u8, NULL));
+      continue;
+    }
+
+    while (true) {
+      wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+      size_t old_ri = src.meta.ri;
+
+      wuffs_base__status status = wuffs_wbmp__decoder__decode_frame(
+          &dec, &pbs[i], &limited_src, WUFFS_BASE__PIXEL_BLEND__SRC,
+          g_work_slice_u8, &opts);
+      src.meta.ri += limited_src.meta.ri;
+
+      if (wuffs_base__status__is_ok(&status)) {
+        break;
+      } else if (status.repr != wuffs_base__suspension__short_read) {
+        RETURN_FAIL("decode_frame #1: have \"%s\", want \"%s\"", status.repr,
+                    wuffs_base__suspension__short_read);
+      } else if (src.meta.ri <= old_ri) {
+        RETURN_FAIL("no progress was made");
+      }
+    }
+
+    wuffs_base__rect_ie_u32 have_dirty =
+        wuffs_wbmp__decoder__frame_dirty_rect(&dec);
+    wuffs_base__rect_ie_u32 want_dirty =
+        wuffs_base__rect_ie_u32__intersect(&scaled_bounds, clip);
+    if (!wuffs_base__rect_ie_u32__equals(&have_dirty, want_dirty)) {
+      RETURN_FAIL("frame_dirty_rect: have (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 "), want (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 ")",
+                  have_dirty.min_incl_x, have_dirty.min_incl_y,
+                  have_dirty.max_excl_x, have_dirty.max_excl_y,
+                  want_dirty.min_incl_x, want_dirty.min_incl_y,
+                  want_dirty.max_excl_x, want_dirty.max_excl_y);
+    }
+    if (src.meta.ri != src.meta.wi) {
+      RETURN_FAIL("src.meta.ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+    }
+  }
+
+  // Pixels inside the clip rectangle should match the (subsampled) whole-image
+  // decode. Pixels outside of it should be untouched.
+  uint32_t y;
+  for (y = 0; y < scaled_bounds.max_excl_y; y++) {
+    uint32_t x;
+    for (x = 0; x < scaled_bounds.max_excl_x; x++) {
+      wuffs_base__color_u32_argb_premul have =
+          wuffs_base__pixel_buffer__color_u32_at(&pbs[1], x, y);
+      wuffs_base__color_u32_argb_premul want =
+          wuffs_base__rect_ie_u32__contains(&clip, x, y)
+              ? wuffs_base__pixel_buffer__color_u32_at(&pbs[0], x * d, y * d)
+              : 0xA5A5A5A5;
+      if (have != want) {
+        RETURN_FAIL("pixel at (%" PRIu32 ", %" PRIu32 "): have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    x, y, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_wbmp_decode_dst_clip_rect() {
+  CHECK_FOCUS(__func__);
+  const struct {
+    const char* filename;
+    wuffs_base__rect_ie_u32 clip;
+  } tcs[] = {
+      {"test/data/bricks-nodither.wbmp", {3, 5, 157, 111}},
+      {"test/data/hat.wbmp", {0, 0, 2, 2}},
+      {"test/data/hat.wbmp", {7, 11, 19, 13}},
+      {"test/data/hat.wbmp", {80, 100, 1000, 1000}},
+      {"test/data/hat.wbmp", {100, 0, 110, 10}},
+      {"test/data/hat.wbmp", {5, 5, 5, 9}},
+  };
+  const uint64_t rlimits[] = {1, 7, UINT64_MAX};
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    size_t r;
+    for (r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); r++) {
+      const char* status = do_test_wuffs_wbmp_decode_with_options(
+          tcs[tc].filename, rlimits[r], tcs[tc].clip, 1);
+      if (status) {
+        // status may point to g_fail_msg, which RETURN_FAIL overwrites.
+        char msg[256];
+        snprintf(msg, sizeof(msg), "%s", status);
+        RETURN_FAIL("tc=%zu, rlimit=%" PRIu64 ": %s", tc, rlimits[r], msg);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_wbmp_decode_scale_denominator() {
+  CHECK_FOCUS(__func__);
+  const struct {
+    const char* filename;
+    wuffs_base__rect_ie_u32 clip;
+  } tcs[] = {
+      {"test/data/bricks-nodither.wbmp", {0, 0, 1000, 1000}},
+      {"test/data/hat.wbmp", {0, 0, 1000, 1000}},
+      {"test/data/hat.wbmp", {1, 2, 9, 5}},
+      {"test/data/muybridge-frame-000.wbmp", {0, 0, 1000, 1000}},
+  };
+  const uint32_t scale_denominators[] = {2, 4, 8};
+  const uint64_t rlimits[] = {1, 7, UINT64_MAX};
+
+  size_t tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    size_t s;
+    for (s = 0; s < WUFFS_TESTLIB_ARRAY_SIZE(scale_denominators); s++) {
+      size_t r;
+      for (r = 0; r < WUFFS_TESTLIB_ARRAY_SIZE(rlimits); r++) {
+        const char* status = do_test_wuffs_wbmp_decode_with_options(
+            tcs[tc].filename, rlimits[r], tcs[tc].clip, scale_denominators[s]);
+        if (status) {
+          // status may point to g_fail_msg, which RETURN_FAIL overwrites.
+          char msg[256];
+          snprintf(msg, sizeof(msg), "%s", status);
+          RETURN_FAIL("tc=%zu, d=%" PRIu32 ", rlimit=%" PRIu64 ": %s", tc,
+                      scale_denominators[s], rlimits[r], msg);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -168,9 +352,11 @@ test_wuffs_wbmp_decode_image_config() {
 
 proc g_tests[] = {
 
+    test_wuffs_wbmp_decode_dst_clip_rect,
     test_wuffs_wbmp_decode_frame_config,
     test_wuffs_wbmp_decode_image_config,
     test_wuffs_wbmp_decode_interface,
+    test_wuffs_wbmp_decode_scale_denominator,
 
 #ifdef WUFFS_MIMIC
 
@@ -240,6 +240,12 @@ test_wuffs_zlib_decode_pi() {
                             UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_zlib_decode_pi_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_zlib_decode, &g_zlib_pi_gt, 61, 59);
+}
+
 const char*  //
 test_wuffs_zlib_decode_sheep() {
   CHECK_FOCUS(__func__);
@@ -287,6 +293,257 @@ test_wuffs_zlib_decode_sheep() {
   return check_io_buffers_equal("", &have, &want);
 }
 
+const char*  //
+test_wuffs_zlib_decode_sheep_twice() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  int i;
+  for (i = 0; i < 2; i++) {
+    if (g_zlib_sheep_src_len > (src.data.len - src.meta.wi)) {
+      RETURN_FAIL("src buffer is too small");
+    }
+    memcpy(src.data.ptr + src.meta.wi, g_zlib_sheep_src_ptr,
+           g_zlib_sheep_src_len);
+    src.meta.wi += g_zlib_sheep_src_len;
+  }
+  src.meta.closed = true;
+
+  wuffs_zlib__decoder dec;
+  CHECK_STATUS("initialize", wuffs_zlib__decoder__initialize(
+                                 &dec, sizeof dec, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  wuffs_zlib__decoder__set_quirk_enabled(
+      &dec, WUFFS_ZLIB__QUIRK_MULTIPLE_STREAMS, true);
+
+  // Each of the two streams needs the dictionary.
+  for (i = 0; i < 2; i++) {
+    wuffs_base__status status =
+        wuffs_zlib__decoder__transform_io(&dec, &have, &src, g_work_slice_u8);
+    if (status.repr != wuffs_zlib__note__dictionary_required) {
+      RETURN_FAIL("i=%d: transform_io (before dict): have \"%s\", want \"%s\"",
+                  i, status.repr, wuffs_zlib__note__dictionary_required);
+    }
+    wuffs_zlib__decoder__add_dictionary(
+        &dec, ((wuffs_base__slice_u8){
+                  .ptr = ((uint8_t*)(g_zlib_sheep_dict_ptr)),
+                  .len = g_zlib_sheep_dict_len,
+              }));
+  }
+
+  CHECK_STATUS(
+      "transform_io (after dict)",
+      wuffs_zlib__decoder__transform_io(&dec, &have, &src, g_work_slice_u8));
+
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  for (i = 0; i < 2; i++) {
+    memcpy(want.data.ptr + want.meta.wi, g_zlib_sheep_want_ptr,
+           g_zlib_sheep_want_len);
+    want.meta.wi += g_zlib_sheep_want_len;
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+do_test_wuffs_zlib_decode_streams(bool quirk,
+                                  uint64_t wlimit,
+                                  uint64_t rlimit) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  // Concatenate three zlib streams (and their decodings), recording where
+  // each stream ends.
+  const char* filenames[3] = {"test/data/midsummer.txt", "test/data/pi.txt",
+                              "test/data/midsummer.txt"};
+  uint64_t stream_ends[3] = {0};
+  int i;
+  for (i = 0; i < 3; i++) {
+    char zlib_filename[64];
+    snprintf(zlib_filename, sizeof zlib_filename, "%s.zlib", filenames[i]);
+    CHECK_STRING(read_file(&src, zlib_filename));
+    CHECK_STRING(read_file(&want, filenames[i]));
+    src.meta.closed = false;
+    want.meta.closed = false;
+    stream_ends[i] = src.meta.wi;
+  }
+  src.meta.closed = true;
+
+  wuffs_zlib__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_zlib__decoder__set_quirk_enabled(
+      &dec, WUFFS_ZLIB__QUIRK_MULTIPLE_STREAMS, quirk);
+
+  int num_oks = 0;
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(have, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+
+    wuffs_base__status status = wuffs_zlib__decoder__transform_io(
+        &dec, &limited_dst, &limited_src, g_work_slice_u8);
+
+    have.meta.wi += limited_dst.meta.wi;
+    src.meta.ri += limited_src.meta.ri;
+
+    if ((status.repr == wuffs_base__suspension__short_write) ||
+        (status.repr == wuffs_base__suspension__short_read)) {
+      continue;
+    }
+    CHECK_STATUS("transform_io", status);
+
+    // Without the quirk, each ok status marks the end of a stream.
+    if (quirk) {
+      num_oks = 3;
+    } else if (src.meta.ri != stream_ends[num_oks]) {
+      RETURN_FAIL("stream #%d: src.meta.ri: have %" PRIu64 ", want %" PRIu64,
+                  num_oks, (uint64_t)(src.meta.ri), stream_ends[num_oks]);
+    } else {
+      num_oks++;
+    }
+    if (src.meta.ri == src.meta.wi) {
+      break;
+    } else if (num_oks >= 3) {
+      RETURN_FAIL("src was not fully consumed");
+    }
+  }
+  if (num_oks != 3) {
+    RETURN_FAIL("num_oks: have %d, want 3", num_oks);
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_zlib_decode_streams_with_quirk() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_zlib_decode_streams(true, UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_zlib_decode_streams_with_quirk_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_zlib_decode_streams(true, 61, 59);
+}
+
+const char*  //
+test_wuffs_zlib_decode_streams_without_quirk() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_zlib_decode_streams(false, UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_zlib_decode_streams_without_quirk_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_zlib_decode_streams(false, 61, 59);
+}
+
+const char*  //
+do_test_wuffs_zlib_encode_round_trip(
+    const char* (*decode_func)(wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               uint32_t,
+                               uint64_t,
+                               uint64_t),
+    const char* filename,
+    uint32_t num_copies,
+    uint32_t level,
+    uint64_t wlimit,
+    uint64_t rlimit) {
+  wuffs_zlib__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__encoder__initialize(&enc, sizeof enc, WUFFS_VERSION,
+                                              0));
+  wuffs_zlib__encoder__set_level(&enc, level);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+  // Repeating the file contents gives a larger src, e.g. about 800 KB for
+  // eight copies of pi.txt.
+  size_t n = src.meta.wi;
+  uint32_t i;
+  for (i = 1; i < num_copies; i++) {
+    if (n > (src.data.len - src.meta.wi)) {
+      RETURN_FAIL("num_copies: src buffer is too small");
+    }
+    memcpy(src.data.ptr + src.meta.wi, src.data.ptr, n);
+    src.meta.wi += n;
+  }
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(want, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+
+    wuffs_base__status status = wuffs_zlib__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+
+    want.meta.wi += limited_dst.meta.wi;
+    src.meta.ri += limited_src.meta.ri;
+
+    if ((status.repr == wuffs_base__suspension__short_write) ||
+        (status.repr == wuffs_base__suspension__short_read)) {
+      continue;
+    }
+    CHECK_STATUS("transform_io", status);
+    break;
+  }
+  want.meta.closed = true;
+
+  // Decoding checks the zlib checksum.
+  CHECK_STRING(decode_func(&have, &want, 0, UINT64_MAX, UINT64_MAX));
+  src.meta.ri = 0;
+  return check_io_buffers_equal("", &have, &src);
+}
+
+const char*  //
+test_wuffs_zlib_encode_midsummer() {
+  CHECK_FOCUS(__func__);
+  uint32_t level;
+  for (level = 0; level <= 9; level++) {
+    const char* z = do_test_wuffs_zlib_encode_round_trip(
+        wuffs_zlib_decode, "test/data/midsummer.txt", 1, level, UINT64_MAX,
+        UINT64_MAX);
+    if (z) {
+      RETURN_FAIL("level %" PRIu32 ": %s", level, z);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_zlib_encode_pi_eight_copies() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_zlib_encode_round_trip(
+      wuffs_zlib_decode, "test/data/pi.txt", 8, 6, UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_zlib_encode_pi_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_zlib_encode_round_trip(
+      wuffs_zlib_decode, "test/data/pi.txt", 1, 6, 41, 43);
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -326,6 +583,15 @@ test_mimic_zlib_decode_sheep() {
   return check_io_buffers_equal("", &have, &want);
 }
 
+
+const char*  //
+test_mimic_zlib_decode_wuffs_encoded() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_zlib_encode_round_trip(
+      mimic_zlib_decode, "test/data/midsummer.txt", 1, 6, UINT64_MAX,
+      UINT64_MAX);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Zlib Benches
@@ -377,13 +643,23 @@ proc g_tests[] = {
     test_wuffs_zlib_decode_interface,
     test_wuffs_zlib_decode_midsummer,
     test_wuffs_zlib_decode_pi,
+    test_wuffs_zlib_decode_pi_many_small_writes_reads,
     test_wuffs_zlib_decode_sheep,
+    test_wuffs_zlib_decode_sheep_twice,
+    test_wuffs_zlib_decode_streams_with_quirk,
+    test_wuffs_zlib_decode_streams_with_quirk_many_small_writes_reads,
+    test_wuffs_zlib_decode_streams_without_quirk,
+    test_wuffs_zlib_decode_streams_without_quirk_many_small_writes_reads,
+    test_wuffs_zlib_encode_midsummer,
+    test_wuffs_zlib_encode_pi_eight_copies,
+    test_wuffs_zlib_encode_pi_many_small_writes_reads,
 
 #ifdef WUFFS_MIMIC
 
     test_mimic_zlib_decode_midsummer,
     test_mimic_zlib_decode_pi,
     test_mimic_zlib_decode_sheep,
+    test_mimic_zlib_decode_wuffs_encoded,
 
 #endif  // WUFFS_MIMIC
 
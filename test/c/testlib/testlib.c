@@ -20,10 +20,17 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define WUFFS_TESTLIB_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
 #define IO_BUFFER_ARRAY_SIZE (64 * 1024 * 1024)
 #define PIXEL_BUFFER_ARRAY_SIZE (64 * 1024 * 1024)
 #define TOKEN_BUFFER_ARRAY_SIZE (128 * 1024)
 
+#define WUFFS_TESTLIB_MAX_THREADS 64
+
 #define WUFFS_TESTLIB_ARRAY_SIZE(a) (sizeof(a) / sizeof(a[0]))
 
 uint8_t g_have_array_u8[IO_BUFFER_ARRAY_SIZE];
@@ -115,12 +122,14 @@ struct {
   const char* focus;
   uint64_t iterscale;
   int reps;
+  size_t threads;
 } g_flags = {0};
 
 const char*  //
 parse_flags(int argc, char** argv) {
   g_flags.iterscale = 100;
   g_flags.reps = 5;
+  g_flags.threads = 4;
 
   int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
   for (; c < argc; c++) {
@@ -186,6 +195,23 @@ parse_flags(int argc, char** argv) {
       continue;
     }
 
+    if (!strncmp(arg, "threads=", 8)) {
+      arg += 8;
+      if (!*arg) {
+        return "missing -threads=N value";
+      }
+      char* end = NULL;
+      long int n = strtol(arg, &end, 10);
+      if (*end) {
+        return "invalid -threads=N value";
+      }
+      if ((n < 1) || (WUFFS_TESTLIB_MAX_THREADS < n)) {
+        return "out-of-range -threads=N value";
+      }
+      g_flags.threads = n;
+      continue;
+    }
+
     return "unrecognized flag argument";
   }
 
@@ -430,8 +456,11 @@ test_main(int argc, char** argv, proc* tests, proc* benches) {
       continue;
     }
     if (g_flags.bench) {
-      printf("# %d benchmarks, 1+%d reps per benchmark, iterscale=%d\n",
-             g_tests_run, g_flags.reps, (int)(g_flags.iterscale));
+      printf(
+          "# %d benchmarks, 1+%d reps per benchmark, iterscale=%d, "
+          "threads=%d\n",
+          g_tests_run, g_flags.reps, (int)(g_flags.iterscale),
+          (int)(g_flags.threads));
     } else {
       printf("%-16s%-8sPASS (%d tests)\n", g_proc_package_name, g_cc,
              g_tests_run);
@@ -517,6 +546,43 @@ make_limited_token_writer(wuffs_base__token_buffer b, uint64_t limit) {
   return ret;
 }
 
+// run_in_parallel calls thread_func once for each of the num_threads elements
+// of the args array, each element being arg_size bytes long. Each call runs on
+// its own thread, if threads are available, or else the calls run one after
+// the other.
+const char*  //
+run_in_parallel(void* (*thread_func)(void*),
+                void* args,
+                size_t arg_size,
+                size_t num_threads) {
+  if (num_threads > WUFFS_TESTLIB_MAX_THREADS) {
+    return "run_in_parallel: too many threads";
+  }
+  size_t i;
+
+#ifdef WUFFS_TESTLIB_HAVE_PTHREADS
+  pthread_t threads[WUFFS_TESTLIB_MAX_THREADS];
+  for (i = 0; i < num_threads; i++) {
+    if (pthread_create(&threads[i], NULL, thread_func,
+                       ((uint8_t*)args) + (i * arg_size))) {
+      while (i > 0) {
+        pthread_join(threads[--i], NULL);
+      }
+      return "run_in_parallel: pthread_create failed";
+    }
+  }
+  for (i = 0; i < num_threads; i++) {
+    pthread_join(threads[i], NULL);
+  }
+#else
+  for (i = 0; i < num_threads; i++) {
+    thread_func(((uint8_t*)args) + (i * arg_size));
+  }
+#endif
+
+  return NULL;
+}
+
 // TODO: we shouldn't need to pass the rect. Instead, pass a subset pixbuf.
 const char*  //
 copy_to_io_buffer_from_pixel_buffer(wuffs_base__io_buffer* dst,